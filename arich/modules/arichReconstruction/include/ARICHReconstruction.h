@@ -24,6 +24,8 @@
 
 
 #include <TVector3.h>
+#include <TRotation.h>
+#include <vector>
 
 namespace Belle2 {
   /** Internal ARICH track reconstruction
@@ -79,6 +81,20 @@ namespace Belle2 {
     //! correct mean emission point z position
     void correctEmissionPoint(int tileID, double r);
 
+    //! Stages of likelihood2 for which the execution time is measured
+    enum EStage {
+      c_ExpectedPhotons = 0, /**< expected number of photons per hypothesis */
+      c_HitLoop = 1,         /**< expected number of photons in hit pixels */
+      c_Likelihood = 2,      /**< likelihood construction */
+      c_NumStages = 3        /**< number of stages */
+    };
+
+    //! Returns execution time of a stage of likelihood2 summed over all tracks [ms]
+    double getStageTime(EStage stage) const {return m_stageTimes[stage];}
+
+    //! Returns number of tracks for which the likelihood was computed
+    unsigned getNumTracks() const {return m_numTracks;}
+
   private:
 
     static const int c_noOfHypotheses = Const::ChargedStable::c_SetSize; /**< Number of hypotheses to loop over */
@@ -95,6 +111,8 @@ namespace Belle2 {
 
     std::vector<TVector3> m_mirrorPoints; /**< vector of points on all mirror plates */
     std::vector<TVector3> m_mirrorNorms;  /**< vector of nomal vectors of all mirror plates */
+    std::vector<TRotation> m_mirrorRotations; /**< transformations to the frames of all mirror plates */
+    std::vector<double> m_mirrorPhis; /**< azimuthal angles of normal vectors of all mirror plates */
 
     double m_trackPosRes; /**< track position resolution (from tracking) */
     double m_trackAngRes; /**< track direction resolution (from tracking) */
@@ -110,6 +128,10 @@ namespace Belle2 {
     int m_storePhot; /**< set to 1 to store individual reconstructed photon information */
     double m_tilePars[124][2] = {0};
 
+    std::vector<double> m_expectedInHits; /**< expected number of photons in hit pixels (index = hypothesis * number of hits + hit) */
+    double m_stageTimes[c_NumStages] = {0}; /**< execution times of likelihood2 stages [ms] */
+    unsigned m_numTracks = 0; /**< number of tracks for which the likelihood was computed */
+
     //! Returns 1 if vector "a" lies on "copyno"-th detector active surface of detector and 0 else.
     int InsideDetector(TVector3 a, int copyno);
     //! Returns the hit virtual position, assuming that it was reflected from mirror.
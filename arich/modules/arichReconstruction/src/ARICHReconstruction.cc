@@ -21,6 +21,7 @@
 #include <framework/gearbox/Const.h>
 
 #include <vector>
+#include <chrono>
 #include <TRotation.h>
 #include <TRandom3.h>
 
@@ -85,9 +86,13 @@ namespace Belle2 {
     if (m_mirrAlign.hasChanged()) {
       m_mirrorNorms.clear();
       m_mirrorPoints.clear();
+      m_mirrorRotations.clear();
+      m_mirrorPhis.clear();
       for (unsigned i = 1; i < m_arichgp->getMirrors().getNMirrors() + 1; i++) {
         m_mirrorNorms.push_back(getMirrorNorm(i));
         m_mirrorPoints.push_back(getMirrorPoint(i));
+        m_mirrorRotations.push_back(TransformToFixed(m_mirrorNorms.back()));
+        m_mirrorPhis.push_back(m_mirrorNorms.back().XYvector().Phi());
       }
     }
 
@@ -230,9 +235,8 @@ namespace Belle2 {
   bool ARICHReconstruction::HitsMirror(const TVector3& pos, const TVector3& dir, int mirrorID)
   {
 
-    TVector3 mirnorm = m_mirrorNorms[mirrorID - 1];
     TVector3 mirpoint = m_mirrorPoints[mirrorID - 1];
-    TRotation rot = TransformToFixed(mirnorm);
+    const TRotation& rot = m_mirrorRotations[mirrorID - 1];
     TVector3 dirTr = rot * dir;
     if (dirTr.Z() < 0) return 0; // comes from outter side
     TVector3 posTr =  rot * (pos - mirpoint);
@@ -355,6 +359,7 @@ namespace Belle2 {
     double  nSig_wo_accInt[c_noOfHypotheses][c_noOfAerogels] = { {0.0} }; // expected no. of signal photons, without geometrical acceptance, integrated over phi
     double  esigi[c_noOfHypotheses] = {0.0}; // expected number of signal photons in hit pixel
     double  thetaCh[c_noOfHypotheses][c_noOfAerogels] = { {0.0} }; // expected Cherenkov angle
+    std::vector<double> bkgPars[c_noOfHypotheses]; // parameters of background PDF (beta, number of hits in window)
 
     // read some geometry parameters
     double padSize = m_arichgp->getHAPDGeometry().getPadSize();
@@ -382,6 +387,12 @@ namespace Belle2 {
     double r = arichTrack.getPosition().XYvector().Mod();
     if (tileID > 0) correctEmissionPoint(tileID, r);
 
+    auto startTime = std::chrono::steady_clock::now();
+
+    // transformations between track and global system, the same for all photons of the track
+    const TRotation toGlobal = TransformFromFixed(edir);
+    const TRotation toTrack = TransformToFixed(edir);
+
     //------------------------------------------------------
     // Calculate number of expected detected photons (emmited x geometrical acceptance).
     // -----------------------------------------------------
@@ -423,7 +434,7 @@ namespace Belle2 {
           for (unsigned int iPhoton = 0; iPhoton < genPhot; iPhoton++) {
             double fi = 2 * M_PI * iPhoton / float(genPhot); // uniformly distributed in phi
             TVector3 adirf = setThetaPhi(thetaCh[iHyp][iAerogel], fi); // photon direction in track system
-            adirf =  TransformFromFixed(edir) * adirf;  // photon direction in global system
+            adirf = toGlobal * adirf;  // photon direction in global system
             int ifi = int (fi * 20 / 2. / M_PI); // phi bin
             // track photon from emission point to the detector plane
             TVector3 dposition = FastTracking(adirf, epoint, &m_refractiveInd[iAerogel], &m_zaero[iAerogel], m_nAerogelLayers - iAerogel, 1);
@@ -455,8 +466,8 @@ namespace Belle2 {
       }
 
       // get number of expected background photons in ring (integrated from 0.1 to 0.5 rad)
-      std::vector<double> bkgPars = {momentum / sqrt(p_mass[iHyp]*p_mass[iHyp] + momentum * momentum), double(arichTrack.hitsWindow())};
-      nBgr[iHyp] = m_recPars->getExpectedBackgroundHits(bkgPars);
+      bkgPars[iHyp] = {momentum / sqrt(p_mass[iHyp]*p_mass[iHyp] + momentum * momentum), double(arichTrack.hitsWindow())};
+      nBgr[iHyp] = m_recPars->getExpectedBackgroundHits(bkgPars[iHyp]);
 
     }  // for (int iHyp=0;iHyp < c_noOfHypotheses; iHyp++ )
     //#####################################################
@@ -481,6 +492,27 @@ namespace Belle2 {
       refl = 3;
     }
 
+    // quantities needed for every hit which depend only on the track and on the hypothesis
+    TVector3 trackAtAerogel[c_noOfAerogels]; // track position at aerogel layer exit
+    TVector3 meanEmissionPoint[c_noOfAerogels]; // mean photon emission point in aerogel layer
+    double sinThetaCh[c_noOfHypotheses][c_noOfAerogels] = { {0.0} };
+    double cosThetaCh[c_noOfHypotheses][c_noOfAerogels] = { {0.0} };
+    for (unsigned int iAerogel = 0; iAerogel < m_nAerogelLayers; iAerogel++) {
+      trackAtAerogel[iAerogel] = getTrackPositionAtZ(arichTrack, m_zaero[iAerogel]);
+      meanEmissionPoint[iAerogel] = getTrackMeanEmissionPosition(arichTrack, iAerogel);
+      for (int iHyp = 0; iHyp < c_noOfHypotheses; iHyp++) {
+        sinThetaCh[iHyp][iAerogel] = sin(thetaCh[iHyp][iAerogel]);
+        cosThetaCh[iHyp][iAerogel] = cos(thetaCh[iHyp][iAerogel]);
+      }
+    }
+
+    // expected number of photons in hit pixels (index = iHyp * nPhotonHits + iHit), filled for hits with background added
+    m_expectedInHits.resize(c_noOfHypotheses * nPhotonHits);
+    unsigned nAccepted = 0;
+
+    auto hitsTime = std::chrono::steady_clock::now();
+    m_stageTimes[c_ExpectedPhotons] += std::chrono::duration<double, std::milli>(hitsTime - startTime).count();
+
     // loop over all detected photon hits
 
     for (unsigned int iPhoton = 0; iPhoton < nPhotonHits; iPhoton++) {
@@ -489,6 +521,8 @@ namespace Belle2 {
       int modID = h->getModule();
       int channel = h->getChannel();
       TVector3 hitpos = m_arichgp->getMasterVolume().pointToLocal(h->getPosition());
+      // pad orientation
+      double modphi =  m_arichgp->getDetectorPlane().getSlotPhi(modID);
       bool bkgAdded = false;
       int nfoo = nDetPhotons;
       for (int iHyp = 0; iHyp < c_noOfHypotheses; iHyp++) { esigi[iHyp] = 0; ebgri[iHyp] = 0;}
@@ -519,22 +553,21 @@ namespace Belle2 {
         // loop over all aerogel layers
         for (unsigned int iAerogel = 0; iAerogel < m_nAerogelLayers; iAerogel++) {
 
-          TVector3 initialrf = getTrackPositionAtZ(arichTrack, m_zaero[iAerogel]);
-          TVector3 epoint = getTrackMeanEmissionPosition(arichTrack, iAerogel);
-          TVector3 edirr  = arichTrack.getDirection();
+          TVector3 initialrf = trackAtAerogel[iAerogel];
+          const TVector3& epoint = meanEmissionPoint[iAerogel];
           TVector3 photonDirection; // calculated photon direction
 
           if (CherenkovPhoton(epoint, virthitpos, initialrf, photonDirection, &m_refractiveInd[iAerogel], &m_zaero[iAerogel],
                               m_nAerogelLayers - iAerogel, mirrors[mirr]) < 0) break;
 
-          TVector3 dirch = TransformToFixed(edirr) * photonDirection;
+          TVector3 dirch = toTrack * photonDirection;
           double fi_cer = dirch.Phi();
           double th_cer = dirch.Theta();
 
 
           th_cer_all[iAerogel] = th_cer;
           fi_cer_all[iAerogel] = fi_cer;
-          fi_cer_trk = dirch.XYvector().DeltaPhi(edirr.XYvector());
+          fi_cer_trk = dirch.XYvector().DeltaPhi(edir.XYvector());
 
           if (mirr == 0 && th_cer < 0.1) reflOK = false;
           // skip photons with irrelevantly large/small Cherenkov angle
@@ -546,21 +579,22 @@ namespace Belle2 {
           if (fi_cer < 0) fi_cer += 2 * M_PI;
           double fii = fi_cer;
           if (mirr > 0) {
-            double fi_mir = m_mirrorNorms[mirrors[mirr] - 1].XYvector().Phi();
+            double fi_mir = m_mirrorPhis[mirrors[mirr] - 1];
             fii = 2 * fi_mir - fi_cer - M_PI;
           }
 
+          int ifi = int (fi_cer * 20 / 2. / M_PI);
+          double cosFi = cos(fi_cer);
+          double sinFi = sin(fi_cer);
+          double pad_fi = fii - modphi;
 
           // loop over all particle hypotheses
           for (int iHyp = 0; iHyp < c_noOfHypotheses; iHyp++) {
 
             // track a photon from the mean emission point to the detector surface
-            TVector3  photonDirection1 = setThetaPhi(thetaCh[iHyp][iAerogel], fi_cer);  // particle system
-            photonDirection1 = TransformFromFixed(edirr) * photonDirection1;  // global system
-            int ifi = int (fi_cer * 20 / 2. / M_PI);
-            TVector3  photonAtAerogelExit = photonDirection1 * (m_thickness[iAerogel] / photonDirection1.z());
-            TVector3  trackAtAerogelExit = edirr * (m_thickness[iAerogel] / edirr.z());
-            TVector3  dtrackphoton = photonAtAerogelExit - trackAtAerogelExit;
+            TVector3  photonDirection1(cosFi * sinThetaCh[iHyp][iAerogel], sinFi * sinThetaCh[iHyp][iAerogel],
+                                       cosThetaCh[iHyp][iAerogel]);  // particle system
+            photonDirection1 = toGlobal * photonDirection1;  // global system
             TVector3 detector_position;
 
             detector_position = FastTracking(photonDirection1, epoint, &m_refractiveInd[iAerogel], &m_zaero[iAerogel],
@@ -572,10 +606,7 @@ namespace Belle2 {
 
             double   detector_sigma    = thcResolution * path / meanr.z();
             double wide_sigma = wideGaussSigma * path / meanr.z();
-            // calculate pad orientation and distance relative to that photon
-            double modphi =  m_arichgp->getDetectorPlane().getSlotPhi(modID);
-
-            double      pad_fi = fii - modphi;
+            // distance relative to that photon
             double      dx     = (detector_position - hitpos).Mag();
             double  dr = (track_at_detector - detector_position).Mag();
 
@@ -599,8 +630,7 @@ namespace Belle2 {
           // add background contribution if not yet (add only once)
           if (!bkgAdded) {
             for (int iHyp = 0; iHyp < c_noOfHypotheses; iHyp++) {
-              std::vector<double> pars = {momentum / sqrt(p_mass[iHyp]*p_mass[iHyp] + momentum * momentum), double(arichTrack.hitsWindow())};
-              ebgri[iHyp] += m_recPars->getBackgroundPerPad(th_cer_all[1], pars);
+              ebgri[iHyp] += m_recPars->getBackgroundPerPad(th_cer_all[1], bkgPars[iHyp]);
             }
             bkgAdded = true;
           }
@@ -637,17 +667,32 @@ namespace Belle2 {
 
       }// for (int mirr = 0; mirr < refl; mirr++)
 
-      //******************************************
-      // LIKELIHOOD construction
-      //*******************************************
-
-      for (int iHyp = 0; iHyp < c_noOfHypotheses; iHyp++) {
-        double expected = esigi[iHyp] + ebgri[iHyp];
-        if (bkgAdded) logL[iHyp] += expected + log(1 - exp(-expected));
+      // store expected number of photons in pixel for the likelihood construction
+      if (bkgAdded) {
+        for (int iHyp = 0; iHyp < c_noOfHypotheses; iHyp++) {
+          m_expectedInHits[iHyp * nPhotonHits + nAccepted] = esigi[iHyp] + ebgri[iHyp];
+        }
+        nAccepted++;
       }
 
     } // for (unsigned  int iPhoton=0; iPhoton< nPhotonHits; iPhoton++)
 
+    auto likelihoodTime = std::chrono::steady_clock::now();
+    m_stageTimes[c_HitLoop] += std::chrono::duration<double, std::milli>(likelihoodTime - hitsTime).count();
+
+    //******************************************
+    // LIKELIHOOD construction
+    //*******************************************
+
+    for (int iHyp = 0; iHyp < c_noOfHypotheses; iHyp++) {
+      const double* expected = m_expectedInHits.data() + iHyp * nPhotonHits;
+      double sum = logL[iHyp];
+      for (unsigned k = 0; k < nAccepted; k++) {
+        sum += expected[k] + log(1 - exp(-expected[k]));
+      }
+      logL[iHyp] = sum;
+    }
+
     //*********************************************
     // add constant term to the LIKELIHOOD function
     //*********************************************
@@ -672,6 +717,10 @@ namespace Belle2 {
     // set values of ARICHLikelihood
     arichLikelihood.setValues(flag, logL, nDetPhotons, exppho);
 
+    m_stageTimes[c_Likelihood] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                  likelihoodTime).count();
+    m_numTracks++;
+
     return 1;
   }
 
@@ -233,6 +233,11 @@ namespace Belle2 {
 
   void ARICHReconstructorModule::terminate()
   {
+    if (!m_ana || m_ana->getNumTracks() == 0) return;
+    B2RESULT("ARICHReconstructor: likelihood computed for " << m_ana->getNumTracks() << " tracks, mean time per track [ms]:"
+             << LogVar("expected photons", m_ana->getStageTime(ARICHReconstruction::c_ExpectedPhotons) / m_ana->getNumTracks())
+             << LogVar("hits", m_ana->getStageTime(ARICHReconstruction::c_HitLoop) / m_ana->getNumTracks())
+             << LogVar("likelihood", m_ana->getStageTime(ARICHReconstruction::c_Likelihood) / m_ana->getNumTracks()));
   }
 
   void ARICHReconstructorModule::printModuleParams()
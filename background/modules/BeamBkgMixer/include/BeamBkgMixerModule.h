@@ -10,10 +10,26 @@
 
 #include <framework/core/Module.h>
 #include <framework/datastore/StoreArray.h>
+#include <framework/datastore/StoreObjPtr.h>
 #include <simulation/background/BeamBGTypes.h>
 #include <framework/dataobjects/BackgroundMetaData.h>
+#include <framework/dataobjects/BackgroundInfo.h>
+
+// SimHits
+#include <pxd/dataobjects/PXDSimHit.h>
+#include <svd/dataobjects/SVDSimHit.h>
+#include <cdc/dataobjects/CDCSimHit.h>
+#include <top/dataobjects/TOPSimHit.h>
+#include <arich/dataobjects/ARICHSimHit.h>
+#include <ecl/dataobjects/ECLHit.h>
+#include <klm/dataobjects/bklm/BKLMSimHit.h>
+#include <klm/dataobjects/eklm/EKLMSimHit.h>
+#include <simulation/dataobjects/BeamBackHit.h>
+
 #include <string>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "TChain.h"
 #include "TClonesArray.h"
@@ -92,6 +108,130 @@ namespace Belle2 {
       {}
     };
 
+    /**
+     * Hits of one type of all events of a preloaded background sample.
+     * The hits are stored in one contiguous array, together with the index of the first hit
+     * of each event.
+     */
+    template<class HIT>
+    class PooledHits {
+
+    public:
+      /**
+       * default constructor
+       */
+      PooledHits(): m_first(1, 0) {}
+
+      /**
+       * Append the hits of the next event
+       * @param cloneArray hits of the event, can be a null pointer if there are none
+       */
+      void addEvent(const TClonesArray* cloneArray)
+      {
+        if (cloneArray) {
+          int numEntries = cloneArray->GetEntriesFast();
+          for (int i = 0; i < numEntries; i++) {
+            m_hits.push_back(*static_cast<const HIT*>(cloneArray->At(i)));
+          }
+        }
+        m_first.push_back(m_hits.size());
+      }
+
+      /**
+       * Returns the first hit of an event
+       */
+      const HIT* begin(unsigned event) const {return m_hits.data() + m_first[event];}
+
+      /**
+       * Returns the end of the hits of an event
+       */
+      const HIT* end(unsigned event) const {return m_hits.data() + m_first[event + 1];}
+
+      /**
+       * Returns the allocated memory in bytes
+       */
+      size_t getMemorySize() const
+      {
+        return m_hits.capacity() * sizeof(HIT) + m_first.capacity() * sizeof(unsigned);
+      }
+
+      /**
+       * Release the memory which is allocated but not used
+       */
+      void shrink()
+      {
+        m_hits.shrink_to_fit();
+        m_first.shrink_to_fit();
+      }
+
+    private:
+      std::vector<HIT> m_hits; /**< hits of all events */
+      std::vector<unsigned> m_first; /**< index of the first hit of each event, last element is the number of hits */
+    };
+
+    /**
+     * Background sample preloaded into memory.
+     * The pool is filled in initialize(), i.e. before the worker processes are forked in
+     * multiprocessing mode, and it is only read afterwards, so its memory pages stay shared
+     * between all processes.
+     */
+    struct BkgPool {
+      PooledHits<PXDSimHit> PXD; /**< PXD SimHits */
+      PooledHits<SVDSimHit> SVD; /**< SVD SimHits */
+      PooledHits<CDCSimHit> CDC; /**< CDC SimHits */
+      PooledHits<TOPSimHit> TOP; /**< TOP SimHits */
+      PooledHits<ARICHSimHit> ARICH; /**< ARICH SimHits */
+      PooledHits<ECLHit> ECL; /**< ECL SimHits */
+      PooledHits<BKLMSimHit> BKLM; /**< BKLM SimHits */
+      PooledHits<EKLMSimHit> EKLM; /**< EKLM SimHits */
+      PooledHits<BeamBackHit> BeamBackHits; /**< BeamBackHits */
+      unsigned numEvents = 0; /**< number of events in the pool */
+
+      /**
+       * Append an event
+       * @param hits input event buffer
+       */
+      void addEvent(const BkgHits& hits)
+      {
+        PXD.addEvent(hits.PXD);
+        SVD.addEvent(hits.SVD);
+        CDC.addEvent(hits.CDC);
+        TOP.addEvent(hits.TOP);
+        ARICH.addEvent(hits.ARICH);
+        ECL.addEvent(hits.ECL);
+        BKLM.addEvent(hits.BKLM);
+        EKLM.addEvent(hits.EKLM);
+        BeamBackHits.addEvent(hits.BeamBackHits);
+        numEvents++;
+      }
+
+      /**
+       * Returns the allocated memory in bytes
+       */
+      size_t getMemorySize() const
+      {
+        return PXD.getMemorySize() + SVD.getMemorySize() + CDC.getMemorySize() +
+               TOP.getMemorySize() + ARICH.getMemorySize() + ECL.getMemorySize() +
+               BKLM.getMemorySize() + EKLM.getMemorySize() + BeamBackHits.getMemorySize();
+      }
+
+      /**
+       * Release the memory which is allocated but not used
+       */
+      void shrink()
+      {
+        PXD.shrink();
+        SVD.shrink();
+        CDC.shrink();
+        TOP.shrink();
+        ARICH.shrink();
+        ECL.shrink();
+        BKLM.shrink();
+        EKLM.shrink();
+        BeamBackHits.shrink();
+      }
+    };
+
     /**
      * structure to hold samples of a particular background type
      */
@@ -103,6 +243,7 @@ namespace Belle2 {
       std::vector<std::string> fileNames;     /**< file names */
       BackgroundMetaData::EFileType fileType; /**< file type */
       std::unique_ptr<TChain> tree; /**< tree pointer */
+      std::unique_ptr<BkgPool> pool; /**< preloaded sample, if not null it is used instead of the tree */
       unsigned numFiles;       /**< number of files connected to TChain */
       unsigned numEvents;      /**< number of events (tree entries) in the sample */
       unsigned eventCount;     /**< current event (tree entry) */
@@ -114,7 +255,7 @@ namespace Belle2 {
        */
       BkgFiles(): tag(BackgroundMetaData::bg_none), realTime(0.0), scaleFactor(1.0),
         fileType(BackgroundMetaData::c_Usual),
-        tree(nullptr), numFiles(0), numEvents(0), eventCount(0), rate(0.0), index(0)
+        tree(nullptr), pool(nullptr), numFiles(0), numEvents(0), eventCount(0), rate(0.0), index(0)
       {}
       /**
        * usefull constructor
@@ -135,7 +276,7 @@ namespace Belle2 {
                unsigned indx = 0):
         tag(bkgTag), type(bkgType), realTime(time), scaleFactor(scaleFac),
         fileType(fileTyp),
-        tree(nullptr), numFiles(0), numEvents(0), eventCount(0), rate(0.0), index(indx)
+        tree(nullptr), pool(nullptr), numFiles(0), numEvents(0), eventCount(0), rate(0.0), index(indx)
       {
         fileNames.push_back(fileName);
       }
@@ -163,22 +304,64 @@ namespace Belle2 {
       int numEntries = cloneArray->GetEntriesFast();
       for (int i = 0; i < numEntries; i++) {
         SIMHIT* bkgSimHit = static_cast<SIMHIT*>(cloneArray->AddrAt(i));
-        SIMHIT* simHit = simHits.appendNew(*bkgSimHit);
-        simHit->shiftInTime(timeShift);
-        if (simHit->getBackgroundTag() == 0) // should be properly set at bkg simulation
-          simHit->setBackgroundTag(BackgroundMetaData::bg_other);
-        if (m_wrapAround) {
-          double time = simHit->getGlobalTime();
-          if (time > maxTime) {
-            double windowSize = maxTime - minTime;
-            double shift = int((time - minTime) / windowSize) * windowSize;
-            simHit->shiftInTime(-shift);
-          }
-        }
+        addSimHit(simHits, *bkgSimHit, timeShift, minTime, maxTime);
       }
 
     }
 
+    /**
+     * functions that add background SimHits of a preloaded event to those in the DataStore
+     * @param simHits a reference to DataStore SimHits
+     * @param pooledHits background SimHits of the preloaded sample
+     * @param event event number in the preloaded sample
+     * @param timeShift time shift to be applied to background SimHits
+     * @param minTime time window left edge
+     * @param maxTime time window right edge
+     */
+    template<class SIMHIT>
+    void addSimHits(StoreArray<SIMHIT>& simHits,
+                    const PooledHits<SIMHIT>& pooledHits,
+                    unsigned event,
+                    double timeShift,
+                    double minTime,
+                    double maxTime)
+    {
+      if (!simHits.isValid()) return;
+
+      for (const SIMHIT* bkgSimHit = pooledHits.begin(event); bkgSimHit != pooledHits.end(event); ++bkgSimHit) {
+        addSimHit(simHits, *bkgSimHit, timeShift, minTime, maxTime);
+      }
+    }
+
+    /**
+     * function that adds a background SimHit to those in the DataStore
+     * @param simHits a reference to DataStore SimHits
+     * @param bkgSimHit background SimHit
+     * @param timeShift time shift to be applied to background SimHit
+     * @param minTime time window left edge
+     * @param maxTime time window right edge
+     */
+    template<class SIMHIT>
+    void addSimHit(StoreArray<SIMHIT>& simHits,
+                   const SIMHIT& bkgSimHit,
+                   double timeShift,
+                   double minTime,
+                   double maxTime)
+    {
+      SIMHIT* simHit = simHits.appendNew(bkgSimHit);
+      simHit->shiftInTime(timeShift);
+      if (simHit->getBackgroundTag() == 0) // should be properly set at bkg simulation
+        simHit->setBackgroundTag(BackgroundMetaData::bg_other);
+      if (m_wrapAround) {
+        double time = simHit->getGlobalTime();
+        if (time > maxTime) {
+          double windowSize = maxTime - minTime;
+          double shift = int((time - minTime) / windowSize) * windowSize;
+          simHit->shiftInTime(-shift);
+        }
+      }
+    }
+
     /**
      * functions that add BeamBackHits to those in the DataStore
      * @param hits a reference to DataStore BeamBackHits
@@ -204,17 +387,53 @@ namespace Belle2 {
         HIT* bkgHit =  static_cast<HIT*>(cloneArray->AddrAt(i));
         //Only keep selected
         if (!keep[bkgHit->getSubDet()]) continue;
-        HIT* hit = hits.appendNew(*bkgHit);
-        hit->shiftInTime(timeShift);
-        //TODO: BeamBackHits does not have a setBackgroundTag so we do not
-        //check or set it
-        if (m_wrapAround) {
-          double time = hit->getTime();
-          if (time > maxTime) {
-            double windowSize = maxTime - minTime;
-            double shift = int((time - minTime) / windowSize) * windowSize;
-            hit->shiftInTime(-shift);
-          }
+        addBeamBackHit(hits, *bkgHit, timeShift, minTime, maxTime);
+      }
+    }
+
+    /**
+     * functions that add BeamBackHits of a preloaded event to those in the DataStore
+     * @param hits a reference to DataStore BeamBackHits
+     * @param pooledHits BeamBackHits of the preloaded sample
+     * @param event event number in the preloaded sample
+     * @param timeShift time shift to be applied to BeamBackHits
+     * @param minTime time window left edge
+     * @param maxTime time window right edge
+     */
+    template<class HIT>
+    void addBeamBackHits(StoreArray<HIT>& hits, const PooledHits<HIT>& pooledHits, unsigned event,
+                         double timeShift, double minTime, double maxTime)
+    {
+      bool keep[] = {false, m_PXD, m_SVD, m_CDC, m_ARICH, m_TOP, m_ECL, m_KLM, m_KLM};
+      if (!hits.isValid()) return;
+      for (const HIT* bkgHit = pooledHits.begin(event); bkgHit != pooledHits.end(event); ++bkgHit) {
+        if (!keep[bkgHit->getSubDet()]) continue;
+        addBeamBackHit(hits, *bkgHit, timeShift, minTime, maxTime);
+      }
+    }
+
+    /**
+     * function that adds a BeamBackHit to those in the DataStore
+     * @param hits a reference to DataStore BeamBackHits
+     * @param bkgHit background BeamBackHit
+     * @param timeShift time shift to be applied to BeamBackHit
+     * @param minTime time window left edge
+     * @param maxTime time window right edge
+     */
+    template<class HIT>
+    void addBeamBackHit(StoreArray<HIT>& hits, const HIT& bkgHit,
+                        double timeShift, double minTime, double maxTime)
+    {
+      HIT* hit = hits.appendNew(bkgHit);
+      hit->shiftInTime(timeShift);
+      //TODO: BeamBackHits does not have a setBackgroundTag so we do not
+      //check or set it
+      if (m_wrapAround) {
+        double time = hit->getTime();
+        if (time > maxTime) {
+          double windowSize = maxTime - minTime;
+          double shift = int((time - minTime) / windowSize) * windowSize;
+          hit->shiftInTime(-shift);
         }
       }
     }
@@ -250,6 +469,23 @@ namespace Belle2 {
      */
     bool acceptEvent(TClonesArray* cloneArrayECL);
 
+    /**
+     * Loads a background sample into memory. If the sample does not fit into the
+     * memory limit it is kept reading from the files.
+     * @param bkg background sample
+     * @param memorySize memory in bytes used by the samples loaded so far, is updated
+     * @return true if the sample was loaded
+     */
+    bool preloadSample(BkgFiles& bkg, size_t& memorySize);
+
+    /**
+     * Draws a random event of a preloaded background sample
+     * @param bkg background sample
+     * @param bkgInfo background info to count re-used samples
+     * @return event number in the preloaded sample
+     */
+    unsigned drawEvent(BkgFiles& bkg, StoreObjPtr<BackgroundInfo>& bkgInfo);
+
 
     std::vector<std::string> m_backgroundFiles; /**< names of beam background files */
     double m_overallScaleFactor; /**< overall scale factor */
@@ -264,6 +500,8 @@ namespace Belle2 {
     double m_maxTimePXD;  /**< maximal time shift of background event for PXD */
     double m_maxEdepECL;  /**< maximal allowed deposited energy in ECL */
     int m_cacheSize;  /**< file cache size in Mbytes */
+    bool m_preloadSamples;  /**< if true load background samples into memory */
+    int m_preloadMaxSize;  /**< maximal memory for preloaded samples in Mbytes */
 
     std::vector<BkgFiles> m_backgrounds;  /**< container for background samples */
     BkgHits m_simHits;         /**< input event buffer */
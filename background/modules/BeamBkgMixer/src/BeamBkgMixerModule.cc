@@ -21,20 +21,8 @@
 #include <framework/core/ModuleParam.templateDetails.h>
 #include <framework/logging/Logger.h>
 
-// SimHits
-#include <pxd/dataobjects/PXDSimHit.h>
-#include <svd/dataobjects/SVDSimHit.h>
-#include <cdc/dataobjects/CDCSimHit.h>
-#include <top/dataobjects/TOPSimHit.h>
-#include <arich/dataobjects/ARICHSimHit.h>
-#include <ecl/dataobjects/ECLHit.h>
-#include <klm/dataobjects/bklm/BKLMSimHit.h>
-#include <klm/dataobjects/eklm/EKLMSimHit.h>
-#include <simulation/dataobjects/BeamBackHit.h>
-
 // MetaData
 #include <framework/dataobjects/EventMetaData.h>
-#include <framework/dataobjects/BackgroundInfo.h>
 
 // Root
 #include <TFile.h>
@@ -103,6 +91,16 @@ namespace Belle2 {
 
     addParam("cacheSize", m_cacheSize,
              "file cache size in Mbytes. If negative, use root default", 0);
+
+    addParam("preloadSamples", m_preloadSamples,
+             "If true, load the background samples into memory at initialization "
+             "and draw the background events randomly from memory instead of reading "
+             "them sequentially from the files. In multiprocessing mode the samples "
+             "are loaded before the worker processes are started and are shared "
+             "between them", false);
+    addParam("preloadMaxSize", m_preloadMaxSize,
+             "maximal memory in Mbytes for preloaded samples; "
+             "samples exceeding it are read from the files", 4000);
   }
 
   BeamBkgMixerModule::~BeamBkgMixerModule()
@@ -282,6 +280,19 @@ namespace Belle2 {
              " rate=" << bkg.rate * 1000 << " MHz");
     }
 
+    // load samples into memory
+
+    if (m_preloadSamples) {
+      size_t memorySize = 0;
+      for (auto& bkg : m_backgrounds) {
+        if (preloadSample(bkg, memorySize)) {
+          B2INFO("BeamBkgMixer: " << bkg.type << " preloaded" <<
+                 " events=" << bkg.pool->numEvents <<
+                 " memory=" << bkg.pool->getMemorySize() / 1024 / 1024 << " MB");
+        }
+      }
+    }
+
 
     // SimHits registration
 
@@ -370,6 +381,23 @@ namespace Belle2 {
 
       for (int iev = 0; iev < nev; iev++) {
         double timeShift = gRandom->Rndm() * (m_maxTime - m_minTime) + m_minTime;
+
+        if (bkg.pool) {
+          unsigned event = drawEvent(bkg, bkgInfo);
+          const BkgPool& pool = *bkg.pool;
+          addSimHits(pxdSimHits, pool.PXD, event, timeShift, m_minTime, m_maxTime);
+          addSimHits(svdSimHits, pool.SVD, event, timeShift, m_minTime, m_maxTime);
+          addSimHits(cdcSimHits, pool.CDC, event, timeShift, m_minTime, m_maxTime);
+          addSimHits(topSimHits, pool.TOP, event, timeShift, m_minTime, m_maxTime);
+          addSimHits(arichSimHits, pool.ARICH, event, timeShift, m_minTime, m_maxTime);
+          addSimHits(eclHits, pool.ECL, event, timeShift, m_minTime, m_maxTime);
+          addSimHits(bklmSimHits, pool.BKLM, event, timeShift, m_minTime, m_maxTime);
+          addSimHits(eklmSimHits, pool.EKLM, event, timeShift, m_minTime, m_maxTime);
+          addBeamBackHits(beamBackHits, pool.BeamBackHits, event, timeShift,
+                          m_minTime, m_maxTime);
+          continue;
+        }
+
         bkg.tree->GetEntry(bkg.eventCount);
 
         if (acceptEvent(m_simHits.ECL)) {
@@ -419,16 +447,23 @@ namespace Belle2 {
       for (int iev = 0; iev < nev; iev++) {
         double timeShift = gRandom->Rndm() * (m_maxTimeECL - m_minTimeECL) + m_minTimeECL;
         if (timeShift > m_minTime and timeShift < m_maxTime) continue;
+        double minTime = m_minTimeECL;
+        double maxTime = m_maxTimeECL;
+        if (timeShift <= m_minTime) {
+          maxTime = m_minTime;
+        } else {
+          minTime = m_maxTime;
+        }
+
+        if (bkg.pool) {
+          unsigned event = drawEvent(bkg, bkgInfo);
+          addSimHits(eclHits, bkg.pool->ECL, event, timeShift, minTime, maxTime);
+          continue;
+        }
+
         bkg.tree->GetEntry(bkg.eventCount);
 
         if (acceptEvent(m_simHits.ECL)) {
-          double minTime = m_minTimeECL;
-          double maxTime = m_maxTimeECL;
-          if (timeShift <= m_minTime) {
-            maxTime = m_minTime;
-          } else {
-            minTime = m_maxTime;
-          }
           addSimHits(eclHits, m_simHits.ECL, timeShift, minTime, maxTime);
         } else {
           iev--;
@@ -467,8 +502,6 @@ namespace Belle2 {
       for (int iev = 0; iev < nev; iev++) {
         double timeShift = gRandom->Rndm() * (m_maxTimePXD - m_minTimePXD) + m_minTimePXD;
         if (timeShift > m_minTime and timeShift < m_maxTime) continue;
-        bkg.tree->GetEntry(bkg.eventCount);
-
         double minTime = m_minTimePXD;
         double maxTime = m_maxTimePXD;
         if (timeShift <= m_minTime) {
@@ -476,6 +509,14 @@ namespace Belle2 {
         } else {
           minTime = m_maxTime;
         }
+
+        if (bkg.pool) {
+          unsigned event = drawEvent(bkg, bkgInfo);
+          addSimHits(pxdSimHits, bkg.pool->PXD, event, timeShift, minTime, maxTime);
+          continue;
+        }
+
+        bkg.tree->GetEntry(bkg.eventCount);
         addSimHits(pxdSimHits, m_simHits.PXD, timeShift, minTime, maxTime);
 
         bkg.eventCount++;
@@ -511,6 +552,7 @@ namespace Belle2 {
 
     for (auto& bkg : m_backgrounds) {
       bkg.tree.reset();
+      bkg.pool.reset();
     }
 
   }
@@ -565,5 +607,71 @@ namespace Belle2 {
   }
 
 
+  bool BeamBkgMixerModule::preloadSample(BkgFiles& bkg, size_t& memorySize)
+  {
+    const size_t maxSize = size_t(m_preloadMaxSize) * 1024 * 1024;
+    std::unique_ptr<BkgPool> pool(new BkgPool());
+
+    for (unsigned entry = 0; entry < bkg.numEvents; entry++) {
+      bkg.tree->GetEntry(entry);
+
+      // the input buffer is shared by all samples: only take the hits this file type is used for
+      BkgHits hits;
+      if (bkg.fileType == BackgroundMetaData::c_Usual) {
+        hits = m_simHits;
+      } else if (bkg.fileType == BackgroundMetaData::c_ECL) {
+        hits.ECL = m_simHits.ECL;
+      } else if (bkg.fileType == BackgroundMetaData::c_PXD) {
+        hits.PXD = m_simHits.PXD;
+      }
+
+      // rejected events are dropped once here instead of being skipped at each use
+      if (!acceptEvent(hits.ECL)) {
+        std::string message = "BeamBkgMixer: event " + to_string(entry)
+                              + " of " + bkg.type + " rejected due to large energy deposit in ECL";
+        m_rejected[message] += 1;
+        continue;
+      }
+
+      pool->addEvent(hits);
+      if (memorySize + pool->getMemorySize() > maxSize) {
+        B2WARNING("BeamBkgMixer: " << bkg.type << " exceeds the memory limit for preloaded samples,"
+                  << " it will be read from the files"
+                  << LogVar("preloadMaxSize", m_preloadMaxSize));
+        return false;
+      }
+    }
+
+    if (pool->numEvents == 0) {
+      B2ERROR("BeamBkgMixer: all events of " << bkg.type << " are rejected");
+      return false;
+    }
+
+    pool->shrink();
+    memorySize += pool->getMemorySize();
+    bkg.pool = std::move(pool);
+    bkg.eventCount = 0;
+    // the tree is kept until terminate(): all trees share the addresses of the input buffer
+    return true;
+  }
+
+
+  unsigned BeamBkgMixerModule::drawEvent(BkgFiles& bkg, StoreObjPtr<BackgroundInfo>& bkgInfo)
+  {
+    unsigned event = gRandom->Integer(bkg.pool->numEvents);
+
+    // count as re-used each time as many events as in the sample have been drawn
+    bkg.eventCount++;
+    if (bkg.eventCount >= bkg.pool->numEvents) {
+      bkg.eventCount = 0;
+      std::string message = "BeamBkgMixer: events of " + bkg.type + " will be re-used";
+      m_reused[message] += 1;
+      if (m_reused[message] == 1) B2INFO(message);
+      bkgInfo->incrementReusedCounter(bkg.index);
+    }
+    return event;
+  }
+
+
 } // end Belle2 namespace
 
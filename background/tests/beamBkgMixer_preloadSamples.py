@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+
+"""
+Test the mixing of preloaded background samples with BeamBkgMixer.
+
+Two small background samples of different types are simulated first. They are
+mixed then reading them from the files, preloading them into memory and with a
+memory limit for the preloading that is too small, so the samples are read from
+the files again after the preloading failed. In all cases the mixed events have
+to contain background SimHits of both samples.
+"""
+
+import basf2
+from ROOT import Belle2
+import b2test_utils
+
+#: Background types of the simulated samples
+background_types = ["twoPhoton", "Coulomb_LER"]
+#: Number of mixed events
+number_of_events = 10
+
+
+class CheckBackgroundHits(basf2.Module):
+    """Count the mixed SVDSimHits per background tag and fail if a sample is missing"""
+
+    def __init__(self):
+        """Initialize the counters"""
+        super().__init__()
+        #: number of SimHits per background tag
+        self.hits = {}
+
+    def event(self):
+        """Count the background SimHits"""
+        for hit in Belle2.PyStoreArray("SVDSimHits"):
+            tag = hit.getBackgroundTag()
+            self.hits[tag] = self.hits.get(tag, 0) + 1
+
+    def terminate(self):
+        """Check that the SimHits of both samples are mixed"""
+        basf2.B2INFO(f"Background SimHits per tag: {self.hits}")
+        expected_tags = {Belle2.BackgroundMetaData.bg_twoPhoton, Belle2.BackgroundMetaData.bg_Coulomb_LER}
+        if set(self.hits) != expected_tags:
+            basf2.B2FATAL(f"Unexpected background tags of the mixed SimHits: {self.hits}")
+
+
+def create_background_file(background_type, seed):
+    """Simulate a small background sample with SVD SimHits only"""
+    basf2.set_random_seed(seed)
+    path = basf2.create_path()
+    path.add_module('EventInfoSetter', expList=[0], runList=[0], evtNumList=[50])
+    path.add_module('Gearbox')
+    path.add_module('Geometry', components=['MagneticField', 'SVD'])
+    path.add_module('ParticleGun')
+    path.add_module('FullSim')
+    path.add_module('BeamBkgTagSetter', backgroundType=background_type, realTime=1000.0)
+    path.add_module('RootOutput', outputFileName=f'{background_type}.root',
+                    branchNames=['BackgroundMetaData', 'SVDSimHits'])
+    with b2test_utils.show_only_errors():
+        assert 0 == b2test_utils.safe_process(path)
+
+
+def mix_background(**mixer_parameters):
+    """Mix both samples into empty events, the SimHits are checked by CheckBackgroundHits"""
+    basf2.set_random_seed("beamBkgMixer_preloadSamples")
+    path = basf2.create_path()
+    path.add_module('EventInfoSetter', expList=[0], runList=[0], evtNumList=[number_of_events])
+    path.add_module('Gearbox')
+    path.add_module('Geometry', components=['MagneticField', 'SVD'])
+    path.add_module('BeamBkgMixer', backgroundFiles=[f'{background_type}.root' for background_type in background_types],
+                    components=['SVD'], minTime=-150, maxTime=150, **mixer_parameters)
+    path.add_module(CheckBackgroundHits())
+    assert 0 == b2test_utils.safe_process(path), f"Mixing failed with {mixer_parameters}"
+
+
+if __name__ == "__main__":
+
+    with b2test_utils.clean_working_directory():
+
+        for seed, background_type in enumerate(background_types):
+            create_background_file(background_type, seed + 1)
+
+        mix_background(preloadSamples=False)
+        mix_background(preloadSamples=True)
+        mix_background(preloadSamples=True, preloadMaxSize=0)
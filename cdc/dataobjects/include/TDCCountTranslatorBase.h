@@ -12,6 +12,8 @@
 
 #include <TMath.h>
 
+#include <vector>
+
 namespace Belle2 {
   namespace CDC {
     /** Base class for translation of Drift Time into Drift Length.
@@ -52,6 +54,31 @@ namespace Belle2 {
                                     double theta = static_cast<double>(TMath::Pi() / 2.),
                                     unsigned short adcCount = 0) = 0;
 
+      /** Function for getting the drift length estimations of many hits at once.
+       *
+       *  All input vectors have one entry per hit, see getDriftLength() for their meaning.
+       *  The default implementation calls getDriftLength() for each hit; translators override it,
+       *  if they can process the hits more efficiently in one batch.
+       *
+       *  @param[out] driftLengths       Best estimation of closest distance between the track and the wire of each hit.
+       */
+      virtual void getDriftLengths(const std::vector<unsigned short>& tdcCounts,
+                                   const std::vector<WireID>& wireIDs,
+                                   const std::vector<double>& timeOfFlightEstimators,
+                                   const std::vector<bool>& ambiguityDiscriminators,
+                                   const std::vector<double>& zs,
+                                   const std::vector<double>& alphas,
+                                   const std::vector<double>& thetas,
+                                   const std::vector<unsigned short>& adcCounts,
+                                   std::vector<double>& driftLengths)
+      {
+        driftLengths.resize(tdcCounts.size());
+        for (std::size_t i = 0; i < tdcCounts.size(); ++i) {
+          driftLengths[i] = getDriftLength(tdcCounts[i], wireIDs[i], timeOfFlightEstimators[i], ambiguityDiscriminators[i], zs[i],
+                                           alphas[i], thetas[i], adcCounts[i]);
+        }
+      }
+
       /**
        * Get Drift time.
        * @param tdcCount              TDC count (ns).
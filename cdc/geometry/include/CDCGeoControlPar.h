@@ -605,6 +605,54 @@ namespace Belle2 {
         return m_mapperPhiAngle;
       }
 
+      /**
+       * Set switch for pre-tabulated xt-relations
+       */
+      void setXtLookupTable(bool input)
+      {
+        m_xtLookupTable = input;
+      }
+
+      /**
+       * Set time step (ns) of pre-tabulated xt-relations
+       */
+      void setXtLookupTableStep(double input)
+      {
+        m_xtLookupTableStep = input;
+      }
+
+      /**
+       * Set tolerance (cm) of pre-tabulated xt-relations w.r.t. the analytic ones
+       */
+      void setXtLookupTableTolerance(double input)
+      {
+        m_xtLookupTableTolerance = input;
+      }
+
+      /**
+       * Get switch for pre-tabulated xt-relations
+       */
+      bool getXtLookupTable() const
+      {
+        return m_xtLookupTable;
+      }
+
+      /**
+       * Get time step (ns) of pre-tabulated xt-relations
+       */
+      double getXtLookupTableStep() const
+      {
+        return m_xtLookupTableStep;
+      }
+
+      /**
+       * Get tolerance (cm) of pre-tabulated xt-relations w.r.t. the analytic ones
+       */
+      double getXtLookupTableTolerance() const
+      {
+        return m_xtLookupTableTolerance;
+      }
+
     private:
       /** Singleton class */
       CDCGeoControlPar();
@@ -641,6 +689,9 @@ namespace Belle2 {
       double m_addFudgeFactorForSigmaForMC = 1.; /**< Additional fudge factor for space resol. for MC */
       bool m_mapperGeometry = false;  /**< B-field mapper geometry flag. */
       double m_mapperPhiAngle = 16.7; /**< B-field mapper phi-angle (deg). */
+      bool m_xtLookupTable = false;  /**< Switch for pre-tabulated xt-relations. */
+      double m_xtLookupTableStep = 1.;  /**< Time step of pre-tabulated xt-relations (ns). */
+      double m_xtLookupTableTolerance = 1.e-4;  /**< Max. deviation of pre-tabulated xt-relations from analytic ones (cm). */
 
       std::string m_displacementFile = "displacement_v2.2.1.dat";  /**< Displacement file. */
       std::string m_alignmentFile = "alignment_v2.dat";  /**< Alignment file. */
@@ -27,6 +27,7 @@
 #include <cdc/dbobjects/CDCMisalignment.h>
 #include <cdc/dbobjects/CDCGeometry.h>
 #include <cdc/dbobjects/CDCEDepToADCConversions.h>
+#include <cdc/geometry/CDCXtLookupTable.h>
 
 #include <vector>
 #include <string>
@@ -944,6 +945,42 @@ namespace Belle2 {
 
       double getDriftTime(double dist, unsigned short layer, unsigned short lr, double alpha, double theta) const;
 
+      /**
+       * Return the drift lengths of many hits at once; all input vectors have one entry per hit.
+       * The (alpha, theta) points of each hit are determined only once for its min. drift time and drift length.
+       * @param[in] dts Drift times (ns).
+       * @param[in] layers Layer IDs.
+       * @param[in] lrs Left/Right flags.
+       * @param[in] alphas incident angles (in rphi plane) w.r.t. the cell (rad).
+       * @param[in] thetas incident angles (polar angle) (rad).
+       * @param[out] dists Drift lengths (cm), as getDriftLength() of each hit.
+       */
+      void getDriftLengths(const std::vector<double>& dts, const std::vector<unsigned short>& layers,
+                           const std::vector<unsigned short>& lrs, const std::vector<double>& alphas,
+                           const std::vector<double>& thetas, std::vector<double>& dists) const;
+
+      /**
+       * Return the drift times of many hits at once; all input vectors have one entry per hit.
+       * The (alpha, theta) points of each hit are determined only once for its min. drift time and the inversion of the xt-relation.
+       * @param[in] dists Drift lengths (cm).
+       * @param[in] layers Layer IDs.
+       * @param[in] lrs Left/Right flags.
+       * @param[in] alphas incident angles (in rphi plane) w.r.t. the cell (rad).
+       * @param[in] thetas incident angles (polar angle) (rad).
+       * @param[out] dts Drift times (ns), as getDriftTime() of each hit.
+       */
+      void getDriftTimes(const std::vector<double>& dists, const std::vector<unsigned short>& layers,
+                         const std::vector<unsigned short>& lrs, const std::vector<double>& alphas,
+                         const std::vector<double>& thetas, std::vector<double>& dts) const;
+
+      /**
+       * Return the pre-tabulated xt-relations; invalid if tabulation is switched off or failed the validation.
+       */
+      const CDCXtLookupTable& getXtLookupTable() const
+      {
+        return m_xtTable;
+      }
+
       /**
        * Return the basic resolution of drift length (cm). N.B. A fudge factor may be multiplied at the place where this is called; be careful.
        * @param dist Drift length (cm); negative dist is treated as |dist|.
@@ -1038,6 +1075,98 @@ namespace Belle2 {
        */
       void getClosestThetaPoints4Sgm(const double alpha, const double theta, double& wth, unsigned short points[2]) const;
 
+      /**
+       * Returns the four (lr, alpha, theta) points of the xt-relation and their weights for the input track incident angles.
+       * @param[in] lr Left/Right.
+       * @param[in] alpha incident angle (in rphi plane) w.r.t. the cell (rad).
+       * @param[in] theta incident angle (polar angle) (rad).
+       * @param[out] lrs Outgoing left/right of the four points.
+       * @param[out] alphaPoints Alpha points.
+       * @param[out] thetaPoints Theta points.
+       * @param[out] weights Weights of the four points.
+       */
+      void getXtCorners(unsigned short lr, double alpha, double theta, unsigned short lrs[4], unsigned short alphaPoints[4],
+                        unsigned short thetaPoints[4], double weights[4]) const;
+
+      /**
+       * Returns the min. drift time (ns) of an xt-relation, i.e. the time at which the drift length is zero.
+       * @param c Coefficients 0-5 of the xt-relation; interpolated in (alpha, theta) or those of a single point.
+       * @param layer Layer ID; only used in warnings.
+       * @param lr Left/Right; only used in warnings.
+       * @param alpha incident angle (in rphi plane) w.r.t. the cell (rad); only used in warnings.
+       * @param theta incident angle (polar angle) (rad); only used in warnings.
+       */
+      double getMinDriftTimeOfXt(const double c[6], unsigned short layer, unsigned short lr, double alpha, double theta) const;
+
+      /**
+       * Returns the min. drift time (ns) for the four points of the xt-relation from getXtCorners().
+       * @param layer Layer ID.
+       * @param lr Left/Right; only used in warnings.
+       * @param alpha incident angle (in rphi plane) w.r.t. the cell (rad); only used in warnings.
+       * @param theta incident angle (polar angle) (rad); only used in warnings.
+       * @param lrs Outgoing left/right of the four points.
+       * @param alphaPoints Alpha points.
+       * @param thetaPoints Theta points.
+       * @param weights Weights of the four points.
+       */
+      double getMinDriftTimeOfCorners(unsigned short layer, unsigned short lr, double alpha, double theta, const unsigned short lrs[4],
+                                      const unsigned short alphaPoints[4], const unsigned short thetaPoints[4],
+                                      const double weights[4]) const;
+
+      /**
+       * Returns the drift length (cm) for the four points of the xt-relation from getXtCorners(); negative for time < minTime.
+       * @param time Drift time (ns).
+       * @param minTime Min. drift time (ns).
+       * @param layer Layer ID.
+       * @param lrs Outgoing left/right of the four points.
+       * @param alphaPoints Alpha points.
+       * @param thetaPoints Theta points.
+       * @param weights Weights of the four points.
+       */
+      double getDriftLengthOfCorners(double time, double minTime, unsigned short layer, const unsigned short lrs[4],
+                                     const unsigned short alphaPoints[4], const unsigned short thetaPoints[4],
+                                     const double weights[4]) const;
+
+      /**
+       * Returns the drift time (ns) for the four points of the xt-relation from getXtCorners().
+       * @param dist Drift length (cm).
+       * @param layer Layer ID.
+       * @param lr Left/Right; only used in warnings.
+       * @param alpha incident angle (in rphi plane) w.r.t. the cell (rad); only used in warnings.
+       * @param theta incident angle (polar angle) (rad); only used in warnings.
+       * @param lrs Outgoing left/right of the four points.
+       * @param alphaPoints Alpha points.
+       * @param thetaPoints Theta points.
+       * @param weights Weights of the four points.
+       */
+      double getDriftTimeOfCorners(double dist, unsigned short layer, unsigned short lr, double alpha, double theta,
+                                   const unsigned short lrs[4], const unsigned short alphaPoints[4],
+                                   const unsigned short thetaPoints[4], const double weights[4]) const;
+
+      /**
+       * Returns the drift length of a single point of the xt-relation, i.e. w/o interpolation in (alpha, theta).
+       * @param time Drift time (ns).
+       * @param layer Layer ID.
+       * @param lr Outgoing left/right.
+       * @param alphaPoint Alpha point.
+       * @param thetaPoint Theta point.
+       */
+      double getXtOfPoint(double time, unsigned short layer, unsigned short lr, unsigned short alphaPoint,
+                          unsigned short thetaPoint) const;
+
+      /**
+       * Returns the index of a point of the xt-relation in the xt lookup table.
+       */
+      unsigned getXtTableNode(unsigned short layer, unsigned short lr, unsigned short alphaPoint, unsigned short thetaPoint) const
+      {
+        return ((layer * 2u + lr) * m_nAlphaPoints + alphaPoint) * m_nThetaPoints + thetaPoint;
+      }
+
+      /**
+       * Tabulate the xt-relations and validate the table against the analytic form.
+       */
+      void buildXtLookupTable();
+
       /**
        * Set the desizend wire parameters.
        * @param[in] layerID Layer ID
@@ -1144,6 +1273,7 @@ namespace Belle2 {
       float m_thetaPoints4Sgm[maxNThetaPoints]; /*!< theta sampling points for sigma (rad) */
 
       float m_XT[MAX_N_SLAYERS][2][maxNAlphaPoints][maxNThetaPoints][nXTParams];  /*!< XT-relation coefficients for each layer, Left/Right, entrance angle and polar angle.  */
+      CDCXtLookupTable m_xtTable; /*!< Pre-tabulated xt-relations. */
       float m_Sigma[MAX_N_SLAYERS][2][maxNAlphaPoints][maxNThetaPoints][nSigmaParams];      /*!< position resulution for each layer. */
       float m_propSpeedInv[MAX_N_SLAYERS];  /*!< Inverse of propagation speed of the sense wire. */
       float m_t0[MAX_N_SLAYERS][MAX_N_SCELLS] = {0};  /*!< t0 for each sense-wire (in nsec). */
@@ -0,0 +1,150 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace Belle2 {
+  namespace CDC {
+
+    /**
+     * Pre-tabulated xt-relations.
+     *
+     * The xt-relation of each node (layer, left/right, alpha point, theta point) is sampled on a common,
+     * equidistant grid in drift time, so that the drift length of a hit is obtained by linear interpolation
+     * in time and the usual weighted average over the four closest (alpha, theta) nodes.
+     * Beyond the end of the grid all nodes are required to be in the linear part of their xt-relation,
+     * which is continued exactly using the slope at the end of the grid.
+     * The samples of a node are contiguous in memory and the interpolation over the four nodes is
+     * branch free, so that it can be vectorized by the compiler.
+     */
+    class CDCXtLookupTable {
+
+    public:
+      /** Number of nodes entering the interpolation of one hit */
+      static constexpr unsigned c_nCorners = 4;
+
+      /**
+       * Fill the table.
+       * @param nNodes Number of nodes.
+       * @param tMin Lower edge of the time grid (ns).
+       * @param tMax Time (ns) above which the xt-relations of all nodes are linear.
+       * @param step Spacing of the time grid (ns).
+       * @param xt Analytic drift length (cm) of a node at a given time (ns).
+       */
+      void build(unsigned nNodes, double tMin, double tMax, double step,
+                 const std::function<double(unsigned, double)>& xt);
+
+      /**
+       * Compare the table to the analytic xt-relations in the middle of each time bin.
+       * @param xt Analytic drift length (cm) of a node at a given time (ns).
+       * @return Largest absolute deviation (cm).
+       */
+      double validate(const std::function<double(unsigned, double)>& xt) const;
+
+      /** Invalidate the table and release its memory */
+      void clear();
+
+      /** Returns true if the table has been filled */
+      bool isValid() const
+      {
+        return m_nSamples > 0;
+      }
+
+      /** Returns lower edge of the time grid (ns) */
+      double getMinTime() const
+      {
+        return m_tMin;
+      }
+
+      /** Returns spacing of the time grid (ns) */
+      double getStep() const
+      {
+        return m_step;
+      }
+
+      /** Returns number of time samples per node */
+      unsigned getNSamples() const
+      {
+        return m_nSamples;
+      }
+
+      /**
+       * Interpolated drift length of a hit (signed, as the analytic xt-relation).
+       * @param nodes The four nodes entering the interpolation.
+       * @param weights Weights of the four nodes.
+       * @param time Drift time (ns).
+       * @param[out] dist Drift length (cm).
+       * @return false if the time is below the grid; dist is not modified in that case.
+       */
+      bool getDriftLength(const unsigned nodes[c_nCorners], const double weights[c_nCorners], double time, double& dist) const;
+
+      /**
+       * Invert the interpolated xt-relation, assuming the absolute drift length to increase with time.
+       * @param nodes The four nodes entering the interpolation.
+       * @param weights Weights of the four nodes.
+       * @param dist Drift length (cm).
+       * @param minTime Time (ns) at which the drift length is zero, i.e. lower bound of the solution.
+       * @param maxTime Upper bound of the solution (ns).
+       * @param[out] time Drift time (ns).
+       * @return false if no solution is found within the range covered by the table.
+       */
+      bool getDriftTime(const unsigned nodes[c_nCorners], const double weights[c_nCorners], double dist, double minTime,
+                        double maxTime, double& time) const;
+
+    private:
+      /** Weighted sum of the samples of the four nodes at grid point i */
+      double getSample(const unsigned nodes[c_nCorners], const double weights[c_nCorners], unsigned i) const
+      {
+        double x = 0.;
+        for (unsigned k = 0; k < c_nCorners; ++k) {
+          x += weights[k] * m_samples[nodes[k] * m_nSamples + i];
+        }
+        return x;
+      }
+
+      /** Weighted and linearly interpolated samples of the four nodes between grid points i and i + 1 */
+      double interpolate(const unsigned nodes[c_nCorners], const double weights[c_nCorners], unsigned i, double frac) const
+      {
+        double x = 0.;
+        for (unsigned k = 0; k < c_nCorners; ++k) {
+          const float* samples = &m_samples[nodes[k] * m_nSamples + i];
+          x += weights[k] * ((1. - frac) * samples[0] + frac * samples[1]);
+        }
+        return x;
+      }
+
+      /** Weighted linear continuation of the four nodes beyond the grid */
+      double extrapolate(const unsigned nodes[c_nCorners], const double weights[c_nCorners], double time) const
+      {
+        const double dt = time - getMaxTime();
+        double x = 0.;
+        for (unsigned k = 0; k < c_nCorners; ++k) {
+          x += weights[k] * (m_samples[nodes[k] * m_nSamples + m_nSamples - 1] + m_tailSlopes[nodes[k]] * dt);
+        }
+        return x;
+      }
+
+      /** Time of the last grid point (ns) */
+      double getMaxTime() const
+      {
+        return m_tMin + (m_nSamples - 1) * m_step;
+      }
+
+      double m_tMin = 0.;  /**< Lower edge of the time grid (ns) */
+      double m_step = 1.;  /**< Spacing of the time grid (ns) */
+      double m_stepInv = 1.;  /**< Inverse spacing of the time grid (1/ns) */
+      unsigned m_nSamples = 0;  /**< Number of time samples per node */
+      std::vector<float> m_samples;  /**< Drift lengths (cm), m_nSamples consecutive values per node */
+      std::vector<float> m_tailSlopes;  /**< Drift velocity (cm/ns) of each node beyond the grid */
+    };
+
+  } // end of namespace CDC
+} // end of namespace Belle2
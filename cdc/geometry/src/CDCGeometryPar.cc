@@ -874,6 +874,7 @@ void CDCGeometryPar::newReadXT(const GearDir& gbxParams, const int mode)
     m_thetaPoints[i] *= degrad;
   }
 
+  buildXtLookupTable();
 }
 
 
@@ -1427,6 +1428,7 @@ void CDCGeometryPar::setXtRel()
     }
   }
 
+  buildXtLookupTable();
 }
 
 
@@ -2163,96 +2165,72 @@ double CDCGeometryPar::getDriftLength(const double time, const unsigned short iC
 {
   double dist = 0.;
 
-  //calculate min. drift time
-  double minTime = calculateMinTime ? getMinDriftTime(iCLayer, lr, alpha, theta) : inputMinTime;
-  double delta = time - minTime;
-
-  //convert incoming- to outgoing-lr
-  unsigned short lro = getOutgoingLR(lr, alpha);
-
-  //  std::cout << m_linearInterpolationOfXT << std::endl;
-  //  exit(-1);
   if (!m_linearInterpolationOfXT) {
     B2FATAL("linearInterpolationOfXT = false is not allowed now !");
   } else {
-    double wal(0.);
-    unsigned short ial[2] = {0};
-    unsigned short ilr[2] = {lro, lro};
-    getClosestAlphaPoints(alpha, wal, ial, ilr);
-    double wth(0.);
-    unsigned short ith[2] = {0};
-    getClosestThetaPoints(alpha, theta, wth, ith);
+    unsigned short jlr[4] = {0}, jal[4] = {0}, jth[4] = {0};
+    double w[4] = {0.};
+    getXtCorners(lr, alpha, theta, jlr, jal, jth, w);
 
-    unsigned short jal(0), jlr(0), jth(0);
-    double w = 0.;
+    //calculate min. drift time
+    double minTime = calculateMinTime ? getMinDriftTimeOfCorners(iCLayer, lr, alpha, theta, jlr, jal, jth, w) : inputMinTime;
+    dist = getDriftLengthOfCorners(time, minTime, iCLayer, jlr, jal, jth, w);
+  }
 
-    //use xt reversed at (x=0,t=tmin) for delta<0 ("negative drifttime")
-    double timep = delta < 0. ? minTime - delta : time;
+  return dist;
 
-    //    std::cout << "iCLayer,alpha,theta,lro= " << iCLayer <<" "<< (180./M_PI)*alpha <<" "<< (180./M_PI)*theta <<" "<< lro << std::endl;
+}
 
-    //compute linear interpolation (=weithed average over 4 points) in (alpha-theta) space
-    for (unsigned k = 0; k < 4; ++k) {
-      if (k == 0) {
-        jal = ial[0];
-        jlr = ilr[0];
-        jth = ith[0];
-        w = (1. - wal) * (1. - wth);
-      } else if (k == 1) {
-        jal = ial[0];
-        jlr = ilr[0];
-        jth = ith[1];
-        w = (1. - wal) * wth;
-      } else if (k == 2) {
-        jal = ial[1];
-        jlr = ilr[1];
-        jth = ith[0];
-        w = wal * (1. - wth);
-      } else if (k == 3) {
-        jal = ial[1];
-        jlr = ilr[1];
-        jth = ith[1];
-        w = wal * wth;
-      }
+double CDCGeometryPar::getDriftLengthOfCorners(const double time, const double minTime, const unsigned short iCLayer,
+                                               const unsigned short jlr[4], const unsigned short jal[4], const unsigned short jth[4],
+                                               const double w[4]) const
+{
+  double dist = 0.;
+  double delta = time - minTime;
 
-      //      std::cout << "k,w= " << k <<" "<< w << std::endl;
-      //      std::cout << "ial[0],[1],jal,wal= " << ial[0] <<" "<< ial[1] <<" "<< jal <<" "<< wal << std::endl;
-      //      std::cout << "ith[0],[1],jth,wth= " << ith[0] <<" "<< ith[1] <<" "<< jth <<" "<< wth << std::endl;
+  //use xt reversed at (x=0,t=tmin) for delta<0 ("negative drifttime")
+  double timep = delta < 0. ? minTime - delta : time;
 
-      /*
-      std::cout <<"iCLayer= " << iCLayer << std::endl;
-      std::cout <<"lr= " << lr << std::endl;
-      std::cout <<"jal,jth= " << jal <<" "<< jth << std::endl;
-      std::cout <<"wal,wth= " << wal <<" "<< wth << std::endl;
-      for (int i=0; i<9; ++i) {
-      std::cout <<"a= "<< i <<" "<< m_XT[iCLayer][lro][jal][jth][i] << std::endl;
-      }
-      */
-      double boundary = m_XT[iCLayer][jlr][jal][jth][6];
+  //use the pre-tabulated xt if available, the analytic one otherwise
+  bool tabulated = false;
+  if (m_xtTable.isValid()) {
+    unsigned nodes[4];
+    for (unsigned k = 0; k < 4; ++k) {
+      nodes[k] = getXtTableNode(iCLayer, jlr[k], jal[k], jth[k]);
+    }
+    tabulated = m_xtTable.getDriftLength(nodes, w, timep, dist);
+  }
 
-      if (timep < boundary) {
-        if (m_xtParamMode == 1) {
-          dist += w * ROOT::Math::Chebyshev5(timep, m_XT[iCLayer][jlr][jal][jth][0], m_XT[iCLayer][jlr][jal][jth][1],
-                                             m_XT[iCLayer][jlr][jal][jth][2], m_XT[iCLayer][jlr][jal][jth][3], m_XT[iCLayer][jlr][jal][jth][4], m_XT[iCLayer][jlr][jal][jth][5]);
-        } else {
-          dist += w * (m_XT[iCLayer][jlr][jal][jth][0] + timep
-                       * (m_XT[iCLayer][jlr][jal][jth][1] + timep
-                          * (m_XT[iCLayer][jlr][jal][jth][2] + timep
-                             * (m_XT[iCLayer][jlr][jal][jth][3] + timep
-                                * (m_XT[iCLayer][jlr][jal][jth][4] + timep
-                                   * (m_XT[iCLayer][jlr][jal][jth][5]))))));
-        }
-      } else {
-        dist += w * (m_XT[iCLayer][jlr][jal][jth][7] * (timep - boundary) + m_XT[iCLayer][jlr][jal][jth][8]);
-      }
-      //      std::cout <<"k,w,dist= " << k <<" "<< w <<" "<< dist << std::endl;
-    } //end of weighted mean loop
+  //compute linear interpolation (=weithed average over 4 points) in (alpha-theta) space
+  if (!tabulated) {
+    for (unsigned k = 0; k < 4; ++k) {
+      dist += w[k] * getXtOfPoint(timep, iCLayer, jlr[k], jal[k], jth[k]);
+    }
   }
 
   dist = fabs(dist);
   if (delta < 0.) dist *= -1.;
   return dist;
+}
+
+void CDCGeometryPar::getDriftLengths(const std::vector<double>& dts, const std::vector<unsigned short>& layers,
+                                     const std::vector<unsigned short>& lrs, const std::vector<double>& alphas,
+                                     const std::vector<double>& thetas, std::vector<double>& dists) const
+{
+  if (!m_linearInterpolationOfXT) {
+    B2FATAL("linearInterpolationOfXT = false is not allowed now !");
+  }
 
+  //the corners of each hit are determined once and shared by its min. drift time and drift length
+  const std::size_t nHits = dts.size();
+  dists.resize(nHits);
+  unsigned short jlr[4] = {0}, jal[4] = {0}, jth[4] = {0};
+  double w[4] = {0.};
+  for (std::size_t i = 0; i < nHits; ++i) {
+    getXtCorners(lrs[i], alphas[i], thetas[i], jlr, jal, jth, w);
+    const double minTime = getMinDriftTimeOfCorners(layers[i], lrs[i], alphas[i], thetas[i], jlr, jal, jth, w);
+    dists[i] = getDriftLengthOfCorners(dts[i], minTime, layers[i], jlr, jal, jth, w);
+  }
 }
 
 double CDCGeometryPar::getMinDriftTime(const unsigned short iCLayer, const unsigned short lr, const double alpha,
@@ -2260,140 +2238,14 @@ double CDCGeometryPar::getMinDriftTime(const unsigned short iCLayer, const unsig
 {
   double minTime = 0.;
 
-  //convert incoming- to outgoing-lr
-  unsigned short lro = getOutgoingLR(lr, alpha);
-
   if (!m_linearInterpolationOfXT) {
     B2FATAL("linearInterpolationOfXT = false is not allowed now !");
   } else {
-    double wal(0.);
-    unsigned short ial[2] = {0};
-    unsigned short ilr[2] = {lro, lro};
-    getClosestAlphaPoints(alpha, wal, ial, ilr);
-    double wth(0.);
-    unsigned short ith[2] = {0};
-    getClosestThetaPoints(alpha, theta, wth, ith);
-
-    unsigned short jal(0), jlr(0), jth(0);
-    double w = 0.;
-
-    double c[6] = {0.}, a[6] = {0.};
-    for (unsigned k = 0; k < 4; ++k) {
-      if (k == 0) {
-        jal = ial[0];
-        jlr = ilr[0];
-        jth = ith[0];
-        w = (1. - wal) * (1. - wth);
-      } else if (k == 1) {
-        jal = ial[0];
-        jlr = ilr[0];
-        jth = ith[1];
-        w = (1. - wal) * wth;
-      } else if (k == 2) {
-        jal = ial[1];
-        jlr = ilr[1];
-        jth = ith[0];
-        w = wal * (1. - wth);
-      } else if (k == 3) {
-        jal = ial[1];
-        jlr = ilr[1];
-        jth = ith[1];
-        w = wal * wth;
-      }
-
-      for (int i = 0; i < 5; ++i) {
-        c[i] += w * m_XT[iCLayer][jlr][jal][jth][i];
-      }
-    }
+    unsigned short jlr[4] = {0}, jal[4] = {0}, jth[4] = {0};
+    double w[4] = {0.};
+    getXtCorners(lr, alpha, theta, jlr, jal, jth, w);
 
-    if (m_xtParamMode == 1) { //convert c to coeff for normal-poly if Chebyshev
-      a[0] = c[0] -    c[2] +    c[4];
-      a[1] = c[1] - 3.*c[3] + 5.*c[5];
-      a[2] =        2.*c[2] - 8.*c[4];
-      a[3] =        4.*c[3] - 20.*c[5];
-      a[4] =        8.*c[4];
-      a[5] =       16.*c[5];
-    } else { //normal-poly
-      for (int i = 0; i < 5; ++i) a[i] = c[i];
-    }
-
-    //estimate an initial value
-    //    bool check = false;
-    //    bool nointersection = false;
-    if (a[2] != 0.) {  //2nd-order approx. near t=0
-      const double det = a[1] * a[1] - 4.*a[2] * a[0];
-      if (det >= 0.) {
-        //Choose the solution with dx/dt > 0 which gives x=0
-        minTime = (-a[1] + sqrt(det)) / (2.*a[2]);
-      } else {
-        //Choose the solution with smallest x
-        //  nointersection = true;
-        minTime = -a[1]  / (2.*a[2]);
-        //  cout <<"smallest-x solution= " << minTime << endl;
-      }
-    } else if (a[1] != 0.) {
-      minTime = -a[0] / a[1];  //1st-order approx.
-    } else {
-      B2WARNING("CDCGeometryPar::getMinDriftTime: minDriftTime not determined; assume zero.\n" << "layer(#0-55),lr,alpha(rad),theta= " <<
-                iCLayer << " " << lr << " " << alpha << " " << theta);
-      return minTime;
-    }
-
-    //    double minTime0 = minTime;
-    //higher-order corr. using Newton method; trial to minimize x^2
-    double  edm; //  = 10.;   //(cm)  (SG: fix to avoid cpp-check warning)
-    //      const double epsi4t = 0.01; //(ns)
-    //    const double epsi4x = 1.e-5; //(cm)
-    const double epsi4x = 5.e-6; //(cm)
-    //    const unsigned short maxIter = 4;
-    const unsigned short maxIter = 8;
-    const double maxDt = 20.; //(ns)
-    unsigned short nIter = 0;
-    double minXsq = 1.e10; //(cm^2)
-    double minMinTime = minTime;
-    //      double told = minTime + 1000.*epsi4t;
-    //      while (fabs(minTime - told) > epsi && nIter <= maxIter) {
-    for (nIter = 0; nIter <= maxIter; ++nIter) {
-      //  told = minTime;
-      double t = minTime;
-      double x   = a[0] + t * (a[1] + t * (a[2] + t * (a[3] + t * (a[4] + t * a[5]))));
-      double x2 = x * x;
-      if (x2 < minXsq) {
-        minXsq = x2;
-        minMinTime = t;
-      }
-      double xp  = a[1] + t * (2 * a[2] + t * (3 * a[3] + t * (4 * a[4] + t * 5 * a[5])));
-      double xpp = 2 * a[2] + t * (6 * a[3] + t * (12 * a[4] + t * 20 * a[5]));
-      double den = xp * xp + x * xpp;
-      if (den <= 0.) {
-        den = xp * xp;
-      }
-
-      if (den > 0.) {
-        //estimated distance to min.
-        edm = fabs(x * xp) / sqrt(den); //not in distance^2 but in distance
-        if (edm < epsi4x) break; //converged
-      }
-
-      double dt = 1.; //dt for den=0 (ns)
-      if (den != 0.) {
-        dt = x * xp / den;
-        if (dt >= 0.) {
-          dt = std::min(dt,  maxDt);
-        } else {
-          dt = std::max(dt, -maxDt);
-        }
-      } else {
-        B2WARNING("CDCGeometryPar::getMinDriftTime: den = 0\n" << "layer(#0-55),lr,alpha(rad),theta= " <<
-                  iCLayer << " "
-                  << lr <<
-                  " " << alpha << " " << theta);
-      }
-      minTime -= dt;
-    } //end of iteration loop
-
-    //choose minMinTime for not-converged case
-    if (nIter == (maxIter + 1)) minTime = minMinTime;
+    minTime = getMinDriftTimeOfCorners(iCLayer, lr, alpha, theta, jlr, jal, jth, w);
 
     /*
     if (fabs(minTime) > 20.) {
@@ -2445,8 +2297,144 @@ double CDCGeometryPar::getMinDriftTime(const unsigned short iCLayer, const unsig
   return minTime;
 }
 
+double CDCGeometryPar::getMinDriftTimeOfCorners(const unsigned short iCLayer, const unsigned short lr, const double alpha,
+                                                const double theta, const unsigned short jlr[4], const unsigned short jal[4],
+                                                const unsigned short jth[4], const double w[4]) const
+{
+  double c[6] = {0.};
+  for (unsigned k = 0; k < 4; ++k) {
+    for (int i = 0; i < 5; ++i) {
+      c[i] += w[k] * m_XT[iCLayer][jlr[k]][jal[k]][jth[k]][i];
+    }
+  }
+  return getMinDriftTimeOfXt(c, iCLayer, lr, alpha, theta);
+}
+
+double CDCGeometryPar::getMinDriftTimeOfXt(const double c[6], const unsigned short iCLayer, const unsigned short lr,
+                                           const double alpha, const double theta) const
+{
+  double minTime = 0.;
+  double a[6] = {0.};
+
+  if (m_xtParamMode == 1) { //convert c to coeff for normal-poly if Chebyshev
+    a[0] = c[0] -    c[2] +    c[4];
+    a[1] = c[1] - 3.*c[3] + 5.*c[5];
+    a[2] =        2.*c[2] - 8.*c[4];
+    a[3] =        4.*c[3] - 20.*c[5];
+    a[4] =        8.*c[4];
+    a[5] =       16.*c[5];
+  } else { //normal-poly
+    for (int i = 0; i < 5; ++i) a[i] = c[i];
+  }
+
+  //estimate an initial value
+  //    bool check = false;
+  //    bool nointersection = false;
+  if (a[2] != 0.) {  //2nd-order approx. near t=0
+    const double det = a[1] * a[1] - 4.*a[2] * a[0];
+    if (det >= 0.) {
+      //Choose the solution with dx/dt > 0 which gives x=0
+      minTime = (-a[1] + sqrt(det)) / (2.*a[2]);
+    } else {
+      //Choose the solution with smallest x
+      //  nointersection = true;
+      minTime = -a[1]  / (2.*a[2]);
+      //  cout <<"smallest-x solution= " << minTime << endl;
+    }
+  } else if (a[1] != 0.) {
+    minTime = -a[0] / a[1];  //1st-order approx.
+  } else {
+    B2WARNING("CDCGeometryPar::getMinDriftTime: minDriftTime not determined; assume zero.\n" << "layer(#0-55),lr,alpha(rad),theta= " <<
+              iCLayer << " " << lr << " " << alpha << " " << theta);
+    return minTime;
+  }
+
+  //    double minTime0 = minTime;
+  //higher-order corr. using Newton method; trial to minimize x^2
+  double  edm; //  = 10.;   //(cm)  (SG: fix to avoid cpp-check warning)
+  //      const double epsi4t = 0.01; //(ns)
+  //    const double epsi4x = 1.e-5; //(cm)
+  const double epsi4x = 5.e-6; //(cm)
+  //    const unsigned short maxIter = 4;
+  const unsigned short maxIter = 8;
+  const double maxDt = 20.; //(ns)
+  unsigned short nIter = 0;
+  double minXsq = 1.e10; //(cm^2)
+  double minMinTime = minTime;
+  //      double told = minTime + 1000.*epsi4t;
+  //      while (fabs(minTime - told) > epsi && nIter <= maxIter) {
+  for (nIter = 0; nIter <= maxIter; ++nIter) {
+    //  told = minTime;
+    double t = minTime;
+    double x   = a[0] + t * (a[1] + t * (a[2] + t * (a[3] + t * (a[4] + t * a[5]))));
+    double x2 = x * x;
+    if (x2 < minXsq) {
+      minXsq = x2;
+      minMinTime = t;
+    }
+    double xp  = a[1] + t * (2 * a[2] + t * (3 * a[3] + t * (4 * a[4] + t * 5 * a[5])));
+    double xpp = 2 * a[2] + t * (6 * a[3] + t * (12 * a[4] + t * 20 * a[5]));
+    double den = xp * xp + x * xpp;
+    if (den <= 0.) {
+      den = xp * xp;
+    }
+
+    if (den > 0.) {
+      //estimated distance to min.
+      edm = fabs(x * xp) / sqrt(den); //not in distance^2 but in distance
+      if (edm < epsi4x) break; //converged
+    }
+
+    double dt = 1.; //dt for den=0 (ns)
+    if (den != 0.) {
+      dt = x * xp / den;
+      if (dt >= 0.) {
+        dt = std::min(dt,  maxDt);
+      } else {
+        dt = std::max(dt, -maxDt);
+      }
+    } else {
+      B2WARNING("CDCGeometryPar::getMinDriftTime: den = 0\n" << "layer(#0-55),lr,alpha(rad),theta= " <<
+                iCLayer << " "
+                << lr <<
+                " " << alpha << " " << theta);
+    }
+    minTime -= dt;
+  } //end of iteration loop
+
+  //choose minMinTime for not-converged case
+  if (nIter == (maxIter + 1)) minTime = minMinTime;
+
+  return minTime;
+}
+
 double CDCGeometryPar::getDriftTime(const double dist, const unsigned short iCLayer, const unsigned short lr, const double alpha,
                                     const double theta) const
+{
+  unsigned short jlr[4] = {0}, jal[4] = {0}, jth[4] = {0};
+  double w[4] = {0.};
+  getXtCorners(lr, alpha, theta, jlr, jal, jth, w);
+  return getDriftTimeOfCorners(dist, iCLayer, lr, alpha, theta, jlr, jal, jth, w);
+}
+
+void CDCGeometryPar::getDriftTimes(const std::vector<double>& dists, const std::vector<unsigned short>& layers,
+                                   const std::vector<unsigned short>& lrs, const std::vector<double>& alphas,
+                                   const std::vector<double>& thetas, std::vector<double>& dts) const
+{
+  //the corners of each hit are determined once and shared by its min. drift time and all drift lengths of the inversion
+  const std::size_t nHits = dists.size();
+  dts.resize(nHits);
+  unsigned short jlr[4] = {0}, jal[4] = {0}, jth[4] = {0};
+  double w[4] = {0.};
+  for (std::size_t i = 0; i < nHits; ++i) {
+    getXtCorners(lrs[i], alphas[i], thetas[i], jlr, jal, jth, w);
+    dts[i] = getDriftTimeOfCorners(dists[i], layers[i], lrs[i], alphas[i], thetas[i], jlr, jal, jth, w);
+  }
+}
+
+double CDCGeometryPar::getDriftTimeOfCorners(const double dist, const unsigned short iCLayer, const unsigned short lr,
+                                             const double alpha, const double theta, const unsigned short jlr[4],
+                                             const unsigned short jal[4], const unsigned short jth[4], const double w[4]) const
 {
   //to be replaced with a smarter algorithm...
 
@@ -2464,10 +2452,23 @@ double CDCGeometryPar::getDriftTime(const double dist, const unsigned short iCLa
   //    maxTime = m_XT[iCLayer][lrp][ialpha][itheta][6];
   //  }
 
-  double minTime = getMinDriftTime(iCLayer, lr, alpha, theta);
+  if (!m_linearInterpolationOfXT) {
+    B2FATAL("linearInterpolationOfXT = false is not allowed now !");
+  }
+  double minTime = getMinDriftTimeOfCorners(iCLayer, lr, alpha, theta, jlr, jal, jth, w);
+
+  //invert the pre-tabulated xt if available
+  if (m_xtTable.isValid()) {
+    unsigned nodes[4];
+    for (unsigned k = 0; k < 4; ++k) {
+      nodes[k] = getXtTableNode(iCLayer, jlr[k], jal[k], jth[k]);
+    }
+    double time = 0.;
+    if (m_xtTable.getDriftTime(nodes, w, dist, minTime, maxTime, time)) return time;
+  }
+
   double t0 = minTime;
   //  std::cout << "minTime,x= " << t0 <<" "<< getDriftLength(t0, iCLayer, lr, alpha, theta) << std::endl;
-  const bool calMinTime = false;
   //  double d0 = getDriftLength(t0, iCLayer, lr, alpha, theta, calMinTime, minTime) - dist;
   double d0 = - dist;
 
@@ -2476,7 +2477,7 @@ double CDCGeometryPar::getDriftTime(const double dist, const unsigned short iCLa
   double time = dist * m_nominalDriftVInv;
   while (((t1 - t0) > eps) && (i < maxTrials)) {
     time = 0.5 * (t0 + t1);
-    double d1 = getDriftLength(time, iCLayer, lr, alpha, theta, calMinTime, minTime) - dist;
+    double d1 = getDriftLengthOfCorners(time, minTime, iCLayer, jlr, jal, jth, w) - dist;
     //    std::cout <<"i,dist,t0,t1,d0,d1= " << i <<" "<< dist <<" "<< t0 <<" "<< t1 <<" "<< d0 <<" "<< d1 << std::endl;
     if (d0 * d1 > 0.) {
       t0 = time;
@@ -2881,3 +2882,103 @@ signed short CDCGeometryPar::getShiftInSuperLayer(unsigned short iSuperLayer, un
 {
   return m_shiftInSuperLayer[iSuperLayer][iLayer];
 }
+
+
+void CDCGeometryPar::getXtCorners(const unsigned short lr, const double alpha, const double theta, unsigned short jlr[4],
+                                  unsigned short jal[4], unsigned short jth[4], double w[4]) const
+{
+  //convert incoming- to outgoing-lr
+  unsigned short lro = getOutgoingLR(lr, alpha);
+
+  double wal(0.);
+  unsigned short ial[2] = {0};
+  unsigned short ilr[2] = {lro, lro};
+  getClosestAlphaPoints(alpha, wal, ial, ilr);
+  double wth(0.);
+  unsigned short ith[2] = {0};
+  getClosestThetaPoints(alpha, theta, wth, ith);
+
+  for (unsigned k = 0; k < 4; ++k) {
+    const unsigned short ia = k / 2;
+    const unsigned short it = k % 2;
+    jal[k] = ial[ia];
+    jlr[k] = ilr[ia];
+    jth[k] = ith[it];
+    w[k] = (ia == 0 ? 1. - wal : wal) * (it == 0 ? 1. - wth : wth);
+  }
+}
+
+double CDCGeometryPar::getXtOfPoint(const double time, const unsigned short iCLayer, const unsigned short lr,
+                                    const unsigned short ialpha, const unsigned short itheta) const
+{
+  const float* xt = m_XT[iCLayer][lr][ialpha][itheta];
+  const double boundary = xt[6];
+
+  if (time < boundary) {
+    if (m_xtParamMode == 1) {
+      return ROOT::Math::Chebyshev5(time, xt[0], xt[1], xt[2], xt[3], xt[4], xt[5]);
+    } else {
+      return xt[0] + time * (xt[1] + time * (xt[2] + time * (xt[3] + time * (xt[4] + time * xt[5]))));
+    }
+  }
+  return xt[7] * (time - boundary) + xt[8];
+}
+
+void CDCGeometryPar::buildXtLookupTable()
+{
+  m_xtTable.clear();
+
+  CDCGeoControlPar& gcp = CDCGeoControlPar::getInstance();
+  if (!gcp.getXtLookupTable()) return;
+
+  const unsigned nAT = m_nAlphaPoints * m_nThetaPoints;
+  const unsigned nNodes = MAX_N_SLAYERS * 2 * nAT;
+  if (nNodes == 0) return;
+
+  //lower edge below the min. drift time of all points (ns); the margin covers the min. drift times of the
+  //interpolated xt-relations, and below the table the analytic xt-relations are used anyway
+  const double minTimeMargin = 5.;
+  double tMin = 0.;
+  //upper edge where all xt-relations have become linear (ns)
+  double tMax = 0.;
+  for (unsigned short iCL = 0; iCL < MAX_N_SLAYERS; ++iCL) {
+    for (unsigned short iLR = 0; iLR < 2; ++iLR) {
+      for (unsigned short iA = 0; iA < m_nAlphaPoints; ++iA) {
+        for (unsigned short iT = 0; iT < m_nThetaPoints; ++iT) {
+          const float* xt = m_XT[iCL][iLR][iA][iT];
+          //only coefficients 0-4 enter, as in getMinDriftTime()
+          const double c[6] = {xt[0], xt[1], xt[2], xt[3], xt[4], 0.};
+          tMin = std::min(tMin, getMinDriftTimeOfXt(c, iCL, iLR, m_alphaPoints[iA], m_thetaPoints[iT]));
+          tMax = std::max(tMax, double(xt[6]));
+        }
+      }
+    }
+  }
+  tMin -= minTimeMargin;
+  const double maxTableTime = 2000.; //same as the max. drift time in getDriftTime()
+  if (tMax > maxTableTime) {
+    B2WARNING("CDCGeometryPar: xt-relations not tabulated since boundary of the linear part " << tMax << " ns exceeds " <<
+              maxTableTime << " ns; analytic xt-relations are used.");
+    return;
+  }
+
+  auto xtOfNode = [this, nAT](unsigned node, double time) {
+    const unsigned short iCL = node / (2 * nAT);
+    const unsigned short iLR = (node / nAT) % 2;
+    const unsigned short iA = (node % nAT) / m_nThetaPoints;
+    const unsigned short iT = node % m_nThetaPoints;
+    return getXtOfPoint(time, iCL, iLR, iA, iT);
+  };
+
+  m_xtTable.build(nNodes, tMin, tMax, gcp.getXtLookupTableStep(), xtOfNode);
+
+  const double maxDeviation = m_xtTable.validate(xtOfNode);
+  if (maxDeviation > gcp.getXtLookupTableTolerance()) {
+    B2WARNING("CDCGeometryPar: max. deviation of the tabulated xt-relations " << maxDeviation << " cm exceeds the tolerance " <<
+              gcp.getXtLookupTableTolerance() << " cm; analytic xt-relations are used.");
+    m_xtTable.clear();
+    return;
+  }
+  B2DEBUG(100, "CDCGeometryPar: xt-relations tabulated with " << m_xtTable.getNSamples() << " samples per point; max. deviation= "
+          << maxDeviation << " cm");
+}
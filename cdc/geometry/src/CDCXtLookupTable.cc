@@ -0,0 +1,132 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#include <cdc/geometry/CDCXtLookupTable.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Belle2;
+using namespace CDC;
+
+void CDCXtLookupTable::build(const unsigned nNodes, const double tMin, const double tMax, const double step,
+                             const std::function<double(unsigned, double)>& xt)
+{
+  clear();
+  if (nNodes == 0 || step <= 0. || tMax <= tMin) return;
+
+  m_tMin = tMin;
+  m_step = step;
+  m_stepInv = 1. / step;
+  const unsigned nSamples = static_cast<unsigned>(std::ceil((tMax - tMin) * m_stepInv)) + 1;
+
+  m_samples.resize(static_cast<std::size_t>(nNodes) * nSamples);
+  m_tailSlopes.resize(nNodes);
+  for (unsigned iNode = 0; iNode < nNodes; ++iNode) {
+    float* samples = &m_samples[static_cast<std::size_t>(iNode) * nSamples];
+    for (unsigned i = 0; i < nSamples; ++i) {
+      samples[i] = xt(iNode, tMin + i * step);
+    }
+    //all xt-relations are linear beyond tMax, so one step determines the slope exactly
+    const double tLast = tMin + (nSamples - 1) * step;
+    m_tailSlopes[iNode] = (xt(iNode, tLast + step) - xt(iNode, tLast)) * m_stepInv;
+  }
+  m_nSamples = nSamples;
+}
+
+double CDCXtLookupTable::validate(const std::function<double(unsigned, double)>& xt) const
+{
+  double maxDeviation = 0.;
+  if (!isValid()) return maxDeviation;
+
+  const unsigned nNodes = m_tailSlopes.size();
+  const double weights[c_nCorners] = {1., 0., 0., 0.};
+  for (unsigned iNode = 0; iNode < nNodes; ++iNode) {
+    const unsigned nodes[c_nCorners] = {iNode, iNode, iNode, iNode};
+    for (unsigned i = 0; i + 1 < m_nSamples; ++i) {
+      const double time = m_tMin + (i + 0.5) * m_step;
+      const double deviation = std::fabs(interpolate(nodes, weights, i, 0.5) - xt(iNode, time));
+      maxDeviation = std::max(maxDeviation, deviation);
+    }
+  }
+  return maxDeviation;
+}
+
+void CDCXtLookupTable::clear()
+{
+  m_nSamples = 0;
+  m_samples.clear();
+  m_samples.shrink_to_fit();
+  m_tailSlopes.clear();
+  m_tailSlopes.shrink_to_fit();
+}
+
+bool CDCXtLookupTable::getDriftLength(const unsigned nodes[c_nCorners], const double weights[c_nCorners], const double time,
+                                      double& dist) const
+{
+  if (!isValid() || time < m_tMin) return false;
+
+  const double u = (time - m_tMin) * m_stepInv;
+  if (u >= m_nSamples - 1) {
+    dist = extrapolate(nodes, weights, time);
+  } else {
+    const unsigned i = static_cast<unsigned>(u);
+    dist = interpolate(nodes, weights, i, u - i);
+  }
+  return true;
+}
+
+bool CDCXtLookupTable::getDriftTime(const unsigned nodes[c_nCorners], const double weights[c_nCorners], const double dist,
+                                    const double minTime, const double maxTime, double& time) const
+{
+  double xLow = 0.;
+  if (!getDriftLength(nodes, weights, minTime, xLow)) return false;
+  xLow = std::fabs(xLow);
+  if (xLow >= dist) {
+    time = minTime;
+    return true;
+  }
+
+  //first grid point above minTime
+  const unsigned last = m_nSamples - 1;
+  unsigned lo = static_cast<unsigned>(std::ceil((minTime - m_tMin) * m_stepInv));
+  const double xLast = getSample(nodes, weights, last);
+
+  if (lo > last || std::fabs(xLast) < dist) {
+    //solution in the linear part beyond the grid
+    double slope = 0.;
+    for (unsigned k = 0; k < c_nCorners; ++k) {
+      slope += weights[k] * m_tailSlopes[nodes[k]];
+    }
+    const double target = std::copysign(dist, xLast);
+    if (slope * target <= 0.) return false;
+    time = getMaxTime() + (target - xLast) / slope;
+    return time <= maxTime;
+  }
+
+  //binary search for the first grid point with |x| >= dist
+  unsigned hi = last;
+  while (lo < hi) {
+    const unsigned mid = lo + (hi - lo) / 2;
+    if (std::fabs(getSample(nodes, weights, mid)) < dist) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  const double tHi = m_tMin + hi * m_step;
+  const double xHi = std::fabs(getSample(nodes, weights, hi));
+  double tLo = minTime;
+  if (hi > 0 && tHi - m_step > minTime) {
+    tLo = tHi - m_step;
+    xLow = std::fabs(getSample(nodes, weights, hi - 1));
+  }
+  time = xHi > xLow ? tLo + (dist - xLow) / (xHi - xLow) * (tHi - tLo) : tHi;
+  return time <= maxTime;
+}
@@ -51,6 +51,9 @@ namespace Belle2 {
     double m_addFudgeFactorForSigmaForMC;   /**< Additional fudge factor for space resol. for MC. */
     bool   m_mapperGeometry;  /**< Mapper geometry flag. */
     double m_mapperPhiAngle;  /**< Mapper phi-angle(deg). */
+    bool   m_xtLookupTable;  /**< Switch for pre-tabulated xt-relations. */
+    double m_xtLookupTableStep;  /**< Time step of pre-tabulated xt-relations (ns). */
+    double m_xtLookupTableTolerance;  /**< Max. deviation of pre-tabulated xt-relations (cm). */
 
     //For Geometry
     bool m_debug4Geo;              /*!< Switch for debug printing. */
@@ -18,7 +18,8 @@ REG_MODULE(CDCJobCntlParModifier)
 CDCJobCntlParModifierModule::CDCJobCntlParModifierModule() : Module(), m_scp(CDCSimControlPar::getInstance()),
   m_gcp(CDCGeoControlPar::getInstance()), m_timeWalk(), m_wireSag(), m_modLeftRightFlag(), m_debug4Sim(), m_thresholdEnergyDeposit(),
   m_minTrackLength(), m_maxSpaceResol(), m_addFudgeFactorForSigmaForData(), m_addFudgeFactorForSigmaForMC(),
-  m_mapperGeometry(), m_mapperPhiAngle(), m_debug4Geo(), m_printMaterialTable(),
+  m_mapperGeometry(), m_mapperPhiAngle(), m_xtLookupTable(), m_xtLookupTableStep(), m_xtLookupTableTolerance(),
+  m_debug4Geo(), m_printMaterialTable(),
   m_materialDefinitionMode(), m_senseWireZposMode(),
   m_displacement(),
   m_alignment(),
@@ -155,6 +156,13 @@ CDCJobCntlParModifierModule::CDCJobCntlParModifierModule() : Module(), m_scp(CDC
   addParam("MapperPhiAngle", m_mapperPhiAngle, "Phi-angle (deg.) of B-field mapper used in GCR in 2017 summer. Tentative option.",
            double(16.7));
 
+  //pre-tabulated xt-relations
+  addParam("XtLookupTable", m_xtLookupTable,
+           "Switch for pre-tabulated xt-relations; the tables are rebuilt whenever the xt-relations are updated.", false);
+  addParam("XtLookupTableStep", m_xtLookupTableStep, "Time step (ns) of pre-tabulated xt-relations.", double(1.));
+  addParam("XtLookupTableTolerance", m_xtLookupTableTolerance,
+           "Max. deviation (cm) of pre-tabulated xt-relations from analytic ones; analytic ones are used if exceeded.", double(1.e-4));
+
 }
 
 void CDCJobCntlParModifierModule::initialize()
@@ -367,6 +375,22 @@ void CDCJobCntlParModifierModule::initialize()
     B2INFO("CDCJobCntlParModifier: mapper phi-angle modified: " << m_gcp.getMapperPhiAngle() << " to " << m_mapperPhiAngle);
     m_gcp.setMapperPhiAngle(m_mapperPhiAngle);
   }
+
+  if (m_gcp.getXtLookupTable() != m_xtLookupTable) {
+    B2INFO("CDCJobCntlParModifier: xtLookupTable switch modified: " << m_gcp.getXtLookupTable() << " to " << m_xtLookupTable);
+    m_gcp.setXtLookupTable(m_xtLookupTable);
+  }
+
+  if (m_gcp.getXtLookupTableStep() != m_xtLookupTableStep) {
+    B2INFO("CDCJobCntlParModifier: xtLookupTableStep modified: " << m_gcp.getXtLookupTableStep() << " to " << m_xtLookupTableStep);
+    m_gcp.setXtLookupTableStep(m_xtLookupTableStep);
+  }
+
+  if (m_gcp.getXtLookupTableTolerance() != m_xtLookupTableTolerance) {
+    B2INFO("CDCJobCntlParModifier: xtLookupTableTolerance modified: " << m_gcp.getXtLookupTableTolerance() << " to " <<
+           m_xtLookupTableTolerance);
+    m_gcp.setXtLookupTableTolerance(m_xtLookupTableTolerance);
+  }
 }
 
 void CDCJobCntlParModifierModule::event()
@@ -0,0 +1,133 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#include <cdc/geometry/CDCXtLookupTable.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace Belle2;
+using namespace CDC;
+
+namespace {
+
+  /** Number of xt-relations (nodes) in the test table */
+  constexpr unsigned c_nNodes = 6;
+
+  /**
+   * Analytic xt-relation of a node in the form used by CDCGeometryPar:
+   * a polynomial up to a boundary, continued linearly beyond it.
+   */
+  double analyticXt(const unsigned node, const double time)
+  {
+    const double a0 = -2.e-3;
+    const double a1 = 4.e-3 + 1.e-4 * node;
+    const double a2 = -5.e-6;
+    const double a3 = 5.e-9;
+    const double boundary = 300. + 20. * node;
+    if (time < boundary) {
+      return a0 + time * (a1 + time * (a2 + time * a3));
+    }
+    const double x = a0 + boundary * (a1 + boundary * (a2 + boundary * a3));
+    const double slope = a1 + boundary * (2. * a2 + boundary * 3. * a3);
+    return x + slope * (time - boundary);
+  }
+
+  /** Weighted average of the analytic xt-relations of the given nodes */
+  double analyticXt(const unsigned nodes[CDCXtLookupTable::c_nCorners], const double weights[CDCXtLookupTable::c_nCorners],
+                    const double time)
+  {
+    double x = 0.;
+    for (unsigned k = 0; k < CDCXtLookupTable::c_nCorners; ++k) {
+      x += weights[k] * analyticXt(nodes[k], time);
+    }
+    return x;
+  }
+
+  /** Test class for the pre-tabulated xt-relations */
+  class CDCXtLookupTableTest : public ::testing::Test {
+
+  protected:
+    /** Tabulate the analytic xt-relations */
+    void SetUp() override
+    {
+      m_table.build(c_nNodes, m_tMin, m_tMax, 1., [](unsigned node, double time) { return analyticXt(node, time); });
+    }
+
+    /** Lower edge of the time grid (ns) */
+    double m_tMin = -10.;
+
+    /** Time (ns) above which all test xt-relations are linear */
+    double m_tMax = 300. + 20. * c_nNodes;
+
+    /** Tolerance (cm) of the tabulated drift lengths */
+    double m_tolerance = 1.e-4;
+
+    /** Nodes entering the interpolation of a hit */
+    unsigned m_nodes[CDCXtLookupTable::c_nCorners] = {1, 2, 4, 5};
+
+    /** Weights of the nodes, as for alpha and theta weights of 0.3 and 0.6 */
+    double m_weights[CDCXtLookupTable::c_nCorners] = {0.7 * 0.4, 0.7 * 0.6, 0.3 * 0.4, 0.3 * 0.6};
+
+    /** Table under test */
+    CDCXtLookupTable m_table;
+  };
+
+  /** The table reproduces the analytic xt-relation of every node */
+  TEST_F(CDCXtLookupTableTest, ValidateAgainstAnalyticXt)
+  {
+    ASSERT_TRUE(m_table.isValid());
+    EXPECT_LT(m_table.validate([](unsigned node, double time) { return analyticXt(node, time); }), m_tolerance);
+  }
+
+  /** The interpolated drift length agrees with the analytic one on and beyond the grid, and is refused below it */
+  TEST_F(CDCXtLookupTableTest, DriftLength)
+  {
+    for (double time = m_tMin; time < 2. * m_tMax; time += 0.37) {
+      double dist = 0.;
+      ASSERT_TRUE(m_table.getDriftLength(m_nodes, m_weights, time, dist));
+      EXPECT_NEAR(analyticXt(m_nodes, m_weights, time), dist, m_tolerance) << "time= " << time;
+    }
+
+    double dist = 42.;
+    EXPECT_FALSE(m_table.getDriftLength(m_nodes, m_weights, m_tMin - 1., dist));
+    EXPECT_EQ(42., dist);
+  }
+
+  /** The inverted table agrees with the inverse of the analytic xt-relation */
+  TEST_F(CDCXtLookupTableTest, DriftTime)
+  {
+    //time where the analytic drift length is zero
+    double tLow = m_tMin;
+    double tHigh = 50.;
+    for (int i = 0; i < 60; ++i) {
+      const double t = 0.5 * (tLow + tHigh);
+      (analyticXt(m_nodes, m_weights, t) < 0. ? tLow : tHigh) = t;
+    }
+    const double minTime = tHigh;
+    const double maxTime = 2000.;
+
+    for (double dist = 0.01; dist < 2.; dist += 0.013) {
+      double time = 0.;
+      ASSERT_TRUE(m_table.getDriftTime(m_nodes, m_weights, dist, minTime, maxTime, time)) << "dist= " << dist;
+      EXPECT_NEAR(dist, analyticXt(m_nodes, m_weights, time), m_tolerance) << "dist= " << dist;
+      EXPECT_GE(time, minTime);
+    }
+  }
+
+  /** Cleared tables are invalid and do not provide drift lengths */
+  TEST_F(CDCXtLookupTableTest, Clear)
+  {
+    m_table.clear();
+    EXPECT_FALSE(m_table.isValid());
+    double dist = 0.;
+    EXPECT_FALSE(m_table.getDriftLength(m_nodes, m_weights, 100., dist));
+  }
+
+}
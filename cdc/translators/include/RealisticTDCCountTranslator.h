@@ -61,6 +61,22 @@ namespace Belle2 {
                             double theta = static_cast<double>(TMath::Pi() / 2.),
                             unsigned short adcCount = 0) override;
 
+      /**
+       * Get the drift lengths of many hits at once, as getDriftLength() for each of them.
+       * The drift times are translated into drift lengths in one batch by CDCGeometryPar::getDriftLengths().
+       * All input vectors have one entry per hit, see getDriftLength() for their meaning.
+       * @param[out] driftLengths Drift lengths (cm).
+       */
+      void getDriftLengths(const std::vector<unsigned short>& tdcCounts,
+                           const std::vector<WireID>& wireIDs,
+                           const std::vector<double>& timeOfFlightEstimators,
+                           const std::vector<bool>& leftRights,
+                           const std::vector<double>& zs,
+                           const std::vector<double>& alphas,
+                           const std::vector<double>& thetas,
+                           const std::vector<unsigned short>& adcCounts,
+                           std::vector<double>& driftLengths) override;
+
       /**
        * Get Drift time.
        * @param tdcCount              TDC count (ns).
@@ -133,6 +133,30 @@ double RealisticTDCCountTranslator::getDriftLength(unsigned short tdcCount,
 }
 
 
+void RealisticTDCCountTranslator::getDriftLengths(const std::vector<unsigned short>& tdcCounts,
+                                                  const std::vector<WireID>& wireIDs,
+                                                  const std::vector<double>& timeOfFlightEstimators,
+                                                  const std::vector<bool>& leftRights,
+                                                  const std::vector<double>& zs,
+                                                  const std::vector<double>& alphas,
+                                                  const std::vector<double>& thetas,
+                                                  const std::vector<unsigned short>& adcCounts,
+                                                  std::vector<double>& driftLengths)
+{
+  const std::size_t nHits = tdcCounts.size();
+  std::vector<double> driftTimes(nHits);
+  std::vector<unsigned short> layers(nHits);
+  std::vector<unsigned short> lrs(nHits);
+  for (std::size_t i = 0; i < nHits; ++i) {
+    driftTimes[i] = getDriftTime(tdcCounts[i], wireIDs[i], timeOfFlightEstimators[i], zs[i], adcCounts[i]);
+    layers[i] = wireIDs[i].getICLayer();
+    lrs[i] = leftRights[i];
+  }
+
+  m_cdcp.getDriftLengths(driftTimes, layers, lrs, alphas, thetas, driftLengths);
+}
+
+
 /** this function returns the variance that is used as the CDC measurment resolution in track fitting */
 
 double RealisticTDCCountTranslator::getDriftLengthResolution(double driftLength, const WireID&  wireID, bool leftRight, double z,
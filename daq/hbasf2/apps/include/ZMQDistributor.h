@@ -50,6 +50,12 @@ namespace Belle2 {
     bool m_expressRecoMode = false;
     /// Parameter: how long to wait after no events come anymore
     unsigned int m_stopWaitingTime = 2;
+    /// Parameter: send the events to the worker with the smallest estimated outstanding work instead of in ready order
+    bool m_sizeAwareScheduling = false;
+    /// Parameter: maximal number of events in flight per worker (0 for no limit besides the ready messages)
+    unsigned int m_prefetchDepth = 0;
+    /// Parameter: time in seconds after which workers which do not start their events are removed (0 for never)
+    unsigned int m_workerTimeout = 300;
   };
 
   class ZMQInputAdapter : public ZMQStandardApp<ZMQRawInput, ZMQConfirmedOutput> {
@@ -25,14 +25,26 @@ void ZMQDistributor::addOptions(po::options_description& desc)
    "size of the input buffer")
   ("stopWaitingTime",
    boost::program_options::value<unsigned int>(&m_stopWaitingTime)->default_value(m_stopWaitingTime),
-   "how long to wait after no events come anymore");
+   "how long to wait after no events come anymore")
+  ("sizeAwareScheduling",
+   boost::program_options::bool_switch(&m_sizeAwareScheduling)->default_value(m_sizeAwareScheduling),
+   "send each event to the worker with the smallest estimated outstanding work (from the event sizes and processing times) "
+   "instead of the worker with the oldest ready message")
+  ("prefetchDepth",
+   boost::program_options::value<unsigned int>(&m_prefetchDepth)->default_value(m_prefetchDepth),
+   "maximal number of events in flight per worker, 0 for no limit besides the worker's buffer size")
+  ("workerTimeout",
+   boost::program_options::value<unsigned int>(&m_workerTimeout)->default_value(m_workerTimeout),
+   "time in seconds after which a worker which has not started any of its events in flight is considered dead and is removed, "
+   "0 to never remove workers");
 }
 
 void ZMQDistributor::initialize()
 {
   ZMQStandardApp::initialize();
   m_input.reset(new ZMQRawInput(m_inputAddress, m_maximalBufferSize, m_expressRecoMode, m_parent));
-  m_output.reset(new ZMQLoadBalancedOutput(m_outputAddress, m_expressRecoMode, m_parent));
+  m_output.reset(new ZMQLoadBalancedOutput(m_outputAddress, m_expressRecoMode, m_parent, m_sizeAwareScheduling,
+                                           m_prefetchDepth, m_workerTimeout));
 }
 
 void ZMQDistributor::handleExternalSignal(EMessageTypes type)
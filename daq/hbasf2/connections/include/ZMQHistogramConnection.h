@@ -35,7 +35,7 @@ namespace Belle2 {
    * is herby filled with the content of a temporary TMemFile.
    * On clear the shared memory is cleared (ROOT files stay what they are).
    *
-   * Nothing special happens on stop or terminate other than that a merge is performed.
+   * Nothing special happens on stop or terminate other than that the merged histograms are written.
    *
    * The given file path for the root file can include placeholders
    * "{experiment_number}" and "{run_number}" which will be replaced accordingly.
@@ -52,8 +52,9 @@ namespace Belle2 {
                                const std::string& dqmFileName,
                                const std::string& rootFileName);
 
-    /// Merge the given histograms into a single set of histograms and store them to file/shm
-    void mergeAndSend(const std::map<std::string, HistogramMapping>& storedMessages, const std::optional<unsigned int>& experiment,
+    /// Store the merged histograms (of numberOfSenders senders) to file/shm
+    void mergeAndSend(const HistogramMapping& mergedHistograms, unsigned int numberOfSenders,
+                      const std::optional<unsigned int>& experiment,
                       const std::optional<unsigned int>& run,
                       EMessageTypes messageType);
     /// Clear the shared memory
@@ -87,8 +88,9 @@ namespace Belle2 {
     /// Initialize the ZMQConfirmedOutput with the given address
     ZMQHistoServerToZMQOutput(const std::string& outputAddress, const std::shared_ptr<ZMQParent>& parent);
 
-    /// Merge the histograms and send them via the connection. Stop/Terminate messages are sent after that.
-    void mergeAndSend(const std::map<std::string, HistogramMapping>& storedMessages, const std::optional<unsigned int>& experiment,
+    /// Send the merged histograms via the connection. Stop/Terminate messages are sent after that.
+    void mergeAndSend(const HistogramMapping& mergedHistograms, unsigned int numberOfSenders,
+                      const std::optional<unsigned int>& experiment,
                       const std::optional<unsigned int>& run,
                       EMessageTypes messageType);
     /// Nothing to do on clear.
@@ -126,8 +128,9 @@ namespace Belle2 {
     /// Create a new raw output with the given address
     ZMQHistoServerToRawOutput(const std::string& outputAddress, const std::shared_ptr<ZMQParent>& parent);
 
-    /// Merge the histograms and send them via the connection. Stop/Terminate messages are not sent.
-    void mergeAndSend(const std::map<std::string, HistogramMapping>& storedMessages, const std::optional<unsigned int>& experiment,
+    /// Send the merged histograms via the connection. Stop/Terminate messages are not sent.
+    void mergeAndSend(const HistogramMapping& mergedHistograms, unsigned int numberOfSenders,
+                      const std::optional<unsigned int>& experiment,
                       const std::optional<unsigned int>& run,
                       EMessageTypes messageType);
     /// Nothing to do on clear
@@ -26,6 +26,7 @@
 #include <memory>
 #include <map>
 #include <optional>
+#include <set>
 
 namespace Belle2 {
   /**
@@ -43,6 +44,15 @@ namespace Belle2 {
    * * After that (or for uncompressed messages) the received histograms in the message
    *   are stored in the message map with the identity as key. In this way only ever the latest
    *   message for each sender is stored (and used when merging).
+   * * Compressed delta messages (see HistogramDelta) only contain the changes since the last message
+   *   of this sender and are added to its stored histograms. If such a message can not be decoded
+   *   (e.g. it is truncated), the changes of this sender are dismissed until it sends its full
+   *   histograms again, its last complete state is kept until then.
+   *
+   * The merged histograms of all senders are kept as a running sum, which is updated with the
+   * differences of every received message, so no full merge is needed on mergeAndSend.
+   * Only if the differences can not be applied (e.g. changed binning) the sum is rebuilt from
+   * the stored histograms.
    *
    * Data messages are supposed to have the run and experiment number stored as JSON-transformed
    * EventMetaData in the additional messages. This sent event meta data is compared with the
@@ -68,9 +78,22 @@ namespace Belle2 {
 
     /// The stored histograms for each sender identity
     std::map<std::string, HistogramMapping> m_storedMessages;
+    /// The sum of the stored histograms of all senders
+    HistogramMapping m_mergedHistograms;
+    /// The senders whose changes are dismissed until their next full sending (after an invalid delta message)
+    std::set<std::string> m_awaitingFullSending;
+    /// Does the sum need to be rebuilt from the stored histograms?
+    bool m_rebuildMergedHistograms = false;
     /// The buffer used during decompression
     std::vector<char> m_uncompressedBuffer;
 
+    /// Replace the stored histograms of the sender by the full set of histograms and update the sum
+    void storeHistograms(const std::string& identity, HistogramMapping histograms);
+    /// Add the changes to the stored histograms of the sender and to the sum
+    void storeHistogramDelta(const std::string& identity, const HistogramDelta& delta);
+    /// Dismiss the changes of the sender until its next full sending
+    void requestFullSending(const std::string& identity);
+
     /// If already received: the experiment number of the data (on mismatch, everything is cleared)
     std::optional<unsigned int> m_storedExperiment = {};
     /// If already received: the run number of the data (on mismatch, everything is cleared)
@@ -88,6 +111,10 @@ namespace Belle2 {
     AConnectionClass::log("uncompressed_size", 0.0);
     AConnectionClass::log("stored_identities", 0l);
     AConnectionClass::log("histogram_clears", 0l);
+    AConnectionClass::log("received_delta_messages", 0l);
+    AConnectionClass::log("skipped_delta_messages", 0l);
+    AConnectionClass::log("invalid_delta_messages", 0l);
+    AConnectionClass::log("merged_histogram_rebuilds", 0l);
     AConnectionClass::log("last_clear", "");
   }
 
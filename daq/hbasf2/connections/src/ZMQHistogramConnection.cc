@@ -41,11 +41,11 @@ ZMQHistoServerToFileOutput::ZMQHistoServerToFileOutput(unsigned int maximalUncom
   log("memory_file_size", 0l);
 }
 
-void ZMQHistoServerToFileOutput::mergeAndSend(const std::map<std::string, HistogramMapping>& storedMessages,
+void ZMQHistoServerToFileOutput::mergeAndSend(const HistogramMapping& mergedHistograms, unsigned int numberOfSenders,
                                               const std::optional<unsigned int>& experiment,
                                               const std::optional<unsigned int>& run, EMessageTypes messageType)
 {
-  if (storedMessages.empty()) {
+  if (mergedHistograms.empty()) {
     return;
   }
 
@@ -54,19 +54,14 @@ void ZMQHistoServerToFileOutput::mergeAndSend(const std::map<std::string, Histog
   increment("histogram_merges");
 
   // We do not care if this is the run end, or run start or anything. We just write it out.
-  HistogramMapping mergeHistograms;
-
   TMemFile memFile(m_dqmMemFileName.c_str(), "RECREATE");
   memFile.cd();
 
-  log("last_merged_histograms", static_cast<long>(storedMessages.size()));
-  average("average_merged_histograms", static_cast<double>(storedMessages.size()));
+  log("last_merged_histograms", static_cast<long>(numberOfSenders));
+  average("average_merged_histograms", static_cast<double>(numberOfSenders));
 
   logTime("last_merge");
-  for (const auto& keyValue : storedMessages) {
-    const auto& histogram = keyValue.second;
-    mergeHistograms += histogram;
-  }
+  mergedHistograms.write();
 
   memFile.Write();
 
@@ -85,8 +80,6 @@ void ZMQHistoServerToFileOutput::mergeAndSend(const std::map<std::string, Histog
   memFile.Cp(outputFileName.c_str(), false);
 
   log("last_written_file_name", outputFileName);
-
-  mergeHistograms.clear();
 }
 
 void ZMQHistoServerToFileOutput::handleIncomingData()
@@ -123,20 +116,20 @@ ZMQHistoServerToZMQOutput::ZMQHistoServerToZMQOutput(const std::string& outputAd
   m_output.log("size_after_compression", 0.0);
 }
 
-void ZMQHistoServerToZMQOutput::mergeAndSend(const std::map<std::string, HistogramMapping>& storedMessages,
+void ZMQHistoServerToZMQOutput::mergeAndSend(const HistogramMapping& mergedHistograms, unsigned int numberOfSenders,
                                              const std::optional<unsigned int>& experiment,
                                              const std::optional<unsigned int>& run, EMessageTypes messageType)
 {
   if (messageType == EMessageTypes::c_lastEventMessage) {
     // merge one last time
-    mergeAndSend(storedMessages, experiment, run, EMessageTypes::c_eventMessage);
+    mergeAndSend(mergedHistograms, numberOfSenders, experiment, run, EMessageTypes::c_eventMessage);
     // and then send out a stop signal by ourself
     auto message = ZMQMessageFactory::createMessage(EMessageTypes::c_lastEventMessage);
     m_output.handleEvent(std::move(message));
     return;
   } else if (messageType == EMessageTypes::c_terminateMessage) {
     // merge one last time
-    mergeAndSend(storedMessages, experiment, run, EMessageTypes::c_eventMessage);
+    mergeAndSend(mergedHistograms, numberOfSenders, experiment, run, EMessageTypes::c_eventMessage);
     // and send out a terminate message
     auto message = ZMQMessageFactory::createMessage(EMessageTypes::c_terminateMessage);
     m_output.handleEvent(std::move(message));
@@ -146,7 +139,7 @@ void ZMQHistoServerToZMQOutput::mergeAndSend(const std::map<std::string, Histogr
   B2ASSERT("This should be an event message!", messageType == EMessageTypes::c_eventMessage);
 
   // Makes no sense to send out an empty event
-  if (storedMessages.empty()) {
+  if (mergedHistograms.empty()) {
     return;
   }
 
@@ -154,18 +147,11 @@ void ZMQHistoServerToZMQOutput::mergeAndSend(const std::map<std::string, Histogr
 
   m_output.increment("histogram_merges");
 
-  HistogramMapping mergeHistograms;
-
-  m_output.log("last_merged_histograms", static_cast<long>(storedMessages.size()));
-  m_output.average("average_merged_histograms", static_cast<double>(storedMessages.size()));
+  m_output.log("last_merged_histograms", static_cast<long>(numberOfSenders));
+  m_output.average("average_merged_histograms", static_cast<double>(numberOfSenders));
   m_output.logTime("last_merge");
 
-  for (const auto& keyValue : storedMessages) {
-    const auto& histogram = keyValue.second;
-    mergeHistograms += histogram;
-  }
-
-  auto eventMessage = mergeHistograms.toMessage();
+  auto eventMessage = mergedHistograms.toMessage();
 
   if (m_outputBuffer.empty()) {
     m_outputBuffer.resize(m_maximalCompressedSize, 0);
@@ -198,25 +184,25 @@ ZMQHistoServerToRawOutput::ZMQHistoServerToRawOutput(const std::string& outputAd
   m_output.log("size_before_compression", 0.0);
 }
 
-void ZMQHistoServerToRawOutput::mergeAndSend(const std::map<std::string, HistogramMapping>& storedMessages,
+void ZMQHistoServerToRawOutput::mergeAndSend(const HistogramMapping& mergedHistograms, unsigned int numberOfSenders,
                                              const std::optional<unsigned int>& experiment,
                                              const std::optional<unsigned int>& run, EMessageTypes messageType)
 {
   if (messageType == EMessageTypes::c_lastEventMessage) {
     // merge one last time
-    mergeAndSend(storedMessages, experiment, run, EMessageTypes::c_eventMessage);
+    mergeAndSend(mergedHistograms, numberOfSenders, experiment, run, EMessageTypes::c_eventMessage);
     // but do not send out any message
     return;
   } else if (messageType == EMessageTypes::c_terminateMessage) {
     // merge one last time
-    mergeAndSend(storedMessages, experiment, run, EMessageTypes::c_eventMessage);
+    mergeAndSend(mergedHistograms, numberOfSenders, experiment, run, EMessageTypes::c_eventMessage);
     return;
   }
 
   B2ASSERT("This should be an event message!", messageType == EMessageTypes::c_eventMessage);
 
   // Makes no sense to send out an empty event
-  if (storedMessages.empty()) {
+  if (mergedHistograms.empty()) {
     return;
   }
 
@@ -224,18 +210,11 @@ void ZMQHistoServerToRawOutput::mergeAndSend(const std::map<std::string, Histogr
 
   m_output.increment("histogram_merges");
 
-  HistogramMapping mergeHistograms;
-
-  m_output.log("last_merged_histograms", static_cast<long>(storedMessages.size()));
-  m_output.average("average_merged_histograms", static_cast<double>(storedMessages.size()));
+  m_output.log("last_merged_histograms", static_cast<long>(numberOfSenders));
+  m_output.average("average_merged_histograms", static_cast<double>(numberOfSenders));
   m_output.logTime("last_merge");
 
-  for (const auto& keyValue : storedMessages) {
-    const auto& histogram = keyValue.second;
-    mergeHistograms += histogram;
-  }
-
-  auto eventMessage = mergeHistograms.toMessage();
+  auto eventMessage = mergedHistograms.toMessage();
 
   m_output.average("size_before_compression", eventMessage->size());
 
@@ -77,13 +77,32 @@ void ZMQHistogramOutput<AConnectionClass>::handleEvent(std::unique_ptr<ZMQIdMess
             "After decompression, the size is " << uncompressedSize << " and the message itself says " << msg->size());
     HistogramMapping histogram(std::move(msg));
     if (not histogram.empty()) {
-      m_storedMessages[identity] = std::move(histogram);
+      storeHistograms(identity, std::move(histogram));
+    }
+  } else if (message->isMessage(Belle2::EMessageTypes::c_compressedDeltaMessage)) {
+    int uncompressedSize = LZ4_decompress_safe(dataMessage.data<char>(), &m_uncompressedBuffer[0],
+                                               dataMessage.size(), m_maximalUncompressedBufferSize);
+    AConnectionClass::increment("received_delta_messages");
+    if (uncompressedSize <= 0) {
+      B2ERROR("Could not decompress the histogram changes from " << identity << ".");
+      requestFullSending(identity);
+      return;
+    }
+
+    AConnectionClass::average("uncompressed_size", uncompressedSize);
+
+    HistogramDelta delta(&m_uncompressedBuffer[0], uncompressedSize);
+    if (not delta.isValid()) {
+      B2ERROR("Received invalid histogram changes (e.g. a truncated message) from " << identity << ".");
+      requestFullSending(identity);
+    } else if (not delta.empty()) {
+      storeHistogramDelta(identity, delta);
     }
   } else if (message->isMessage(Belle2::EMessageTypes::c_rawDataMessage)) {
     std::unique_ptr<Belle2::EvtMessage> msg(new Belle2::EvtMessage(dataMessage.data<char>()));
     HistogramMapping histogram(std::move(msg));
     if (not histogram.empty()) {
-      m_storedMessages[identity] = std::move(histogram);
+      storeHistograms(identity, std::move(histogram));
     }
   } else {
     B2FATAL("Unknown message type!");
@@ -92,10 +111,71 @@ void ZMQHistogramOutput<AConnectionClass>::handleEvent(std::unique_ptr<ZMQIdMess
   AConnectionClass::log("stored_identities", static_cast<long>(m_storedMessages.size()));
 }
 
+template<class AConnectionClass>
+void ZMQHistogramOutput<AConnectionClass>::storeHistograms(const std::string& identity, HistogramMapping histograms)
+{
+  m_awaitingFullSending.erase(identity);
+  auto& storedHistograms = m_storedMessages[identity];
+  if (not m_rebuildMergedHistograms and not m_mergedHistograms.update(storedHistograms, histograms)) {
+    m_rebuildMergedHistograms = true;
+  }
+  storedHistograms = std::move(histograms);
+}
+
+template<class AConnectionClass>
+void ZMQHistogramOutput<AConnectionClass>::storeHistogramDelta(const std::string& identity, const HistogramDelta& delta)
+{
+  auto storedIterator = m_storedMessages.find(identity);
+  if (storedIterator == m_storedMessages.end()) {
+    B2WARNING("Received histogram changes from " << identity << " without having received its histograms before "
+              "(e.g. after a restart or a clear). Will dismiss them until its next full sending.");
+    AConnectionClass::increment("skipped_delta_messages");
+    return;
+  }
+  if (m_awaitingFullSending.count(identity) > 0) {
+    B2DEBUG(10, "Dismiss the histogram changes from " << identity << " until its next full sending.");
+    AConnectionClass::increment("skipped_delta_messages");
+    return;
+  }
+
+  const unsigned int skippedHistograms = storedIterator->second.applyDelta(delta);
+  if (skippedHistograms > 0) {
+    B2WARNING("Could not apply the changes of " << skippedHistograms << " histograms from " << identity << ".");
+    AConnectionClass::increment("skipped_delta_messages");
+    // the sum would not match the stored histograms anymore
+    m_rebuildMergedHistograms = true;
+  }
+
+  if (not m_rebuildMergedHistograms and m_mergedHistograms.applyDelta(delta) > 0) {
+    m_rebuildMergedHistograms = true;
+  }
+}
+
+template<class AConnectionClass>
+void ZMQHistogramOutput<AConnectionClass>::requestFullSending(const std::string& identity)
+{
+  // There is no way back to the sender, it sends its full histograms regularly (see HLTDQM2ZMQ).
+  // Until then its last complete state is kept and all its changes are dismissed, as they build on the lost ones.
+  B2WARNING("Will dismiss the histogram changes from " << identity << " until its next full sending.");
+  AConnectionClass::increment("invalid_delta_messages");
+  m_awaitingFullSending.insert(identity);
+}
+
 template<class AConnectionClass>
 void ZMQHistogramOutput<AConnectionClass>::mergeAndSend(EMessageTypes messageType)
 {
-  AConnectionClass::mergeAndSend(m_storedMessages, m_storedExperiment, m_storedRun, messageType);
+  if (m_rebuildMergedHistograms) {
+    AConnectionClass::increment("merged_histogram_rebuilds");
+
+    m_mergedHistograms.clear();
+    for (const auto& keyValue : m_storedMessages) {
+      const auto& histogram = keyValue.second;
+      m_mergedHistograms += histogram;
+    }
+    m_rebuildMergedHistograms = false;
+  }
+
+  AConnectionClass::mergeAndSend(m_mergedHistograms, m_storedMessages.size(), m_storedExperiment, m_storedRun, messageType);
 }
 
 template<class AConnectionClass>
@@ -107,6 +187,9 @@ void ZMQHistogramOutput<AConnectionClass>::clear()
   AConnectionClass::clear();
 
   m_storedMessages.clear();
+  m_awaitingFullSending.clear();
+  m_mergedHistograms.clear();
+  m_rebuildMergedHistograms = false;
   m_storedExperiment.reset();
   m_storedRun.reset();
 }
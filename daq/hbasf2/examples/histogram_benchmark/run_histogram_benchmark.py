@@ -0,0 +1,81 @@
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+import argparse
+import os
+import subprocess
+import tempfile
+
+import zmq
+
+
+def get_free_port():
+    """Get a free port number by reusing ZMQ's function for this."""
+    socket = zmq.Context.instance().socket(zmq.ROUTER)
+    port = socket.bind_to_random_port("tcp://*")
+    socket.close()
+    return port
+
+
+def run(args, changes_only):
+    """Start the histogram server and the workers, wait until they are finished and return the server CPU time and the sent bytes."""
+    input_port = get_free_port()
+    monitoring_port = get_free_port()
+
+    with tempfile.TemporaryDirectory() as temporary_directory:
+        server = subprocess.Popen([
+            "b2hlt_finalhistoserver",
+            "--input", f"tcp://*:{input_port}",
+            "--rootFileName", os.path.join(temporary_directory, "histos_{run_number}.root"),
+            "--timeout", str(args.timeout),
+            "--monitor", f"tcp://*:{monitoring_port}"
+        ])
+
+        worker_arguments = [
+            "--output", f"tcp://localhost:{input_port}",
+            "--histograms", str(args.histograms),
+            "--bins", str(args.bins),
+            "--sends", str(args.sends),
+            "--fills", str(args.fills),
+            "--interval", str(args.interval)
+        ]
+        if changes_only:
+            worker_arguments += ["--changesOnly"]
+
+        workers = [subprocess.Popen(["b2hlt_send_histos", "--seed", str(seed + 1)] + worker_arguments,
+                                    stdout=subprocess.PIPE, universal_newlines=True)
+                   for seed in range(args.workers)]
+
+        sent_bytes = 0
+        for worker in workers:
+            output, _ = worker.communicate()
+            for line in output.splitlines():
+                if line.startswith("sent_bytes"):
+                    sent_bytes += int(line.split()[1])
+
+        # the server terminates after having received the terminate messages of all workers
+        _, status, usage = os.wait4(server.pid, 0)
+        server.returncode = os.waitstatus_to_exitcode(status)
+
+    return usage.ru_utime + usage.ru_stime, sent_bytes
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description="Benchmark the histogram server with simulated workers")
+    parser.add_argument("--workers", type=int, default=20, help="number of worker processes")
+    parser.add_argument("--histograms", type=int, default=1000, help="number of histograms per worker")
+    parser.add_argument("--bins", type=int, default=100, help="number of bins (in x) per histogram")
+    parser.add_argument("--sends", type=int, default=10, help="how often each worker sends its histograms")
+    parser.add_argument("--fills", type=int, default=10000, help="number of fills per worker between two sends")
+    parser.add_argument("--interval", type=int, default=1000, help="time between two sends in ms")
+    parser.add_argument("--timeout", type=int, default=2, help="merge interval of the server in s")
+    args = parser.parse_args()
+
+    for changes_only in [False, True]:
+        cpu_time, sent_bytes = run(args, changes_only)
+        mode = "changes only" if changes_only else "full"
+        print(f"{mode:>12}: server CPU time {cpu_time:.2f} s, sent {sent_bytes / 1e6:.1f} MB")
@@ -33,6 +33,11 @@ namespace Belle2 {
    * so all the usual conventions for a confirmed connection apply.
    * This module does only makes sense to run on the HLT, it is not useful for local
    * file writeout.
+   * By default, only the changes of the histograms since the last sending are sent
+   * (see HLTStreamHelper::streamHistogramChanges). The full histograms are sent
+   * on the first and the last sending of each run and after every fullSendInterval sendings
+   * of the changes, so a histogram server which has lost the state of this sender
+   * (e.g. after a restart or a run mismatch) can pick up again.
    */
   class HLTDQM2ZMQModule : public Module {
   public:
@@ -49,10 +54,10 @@ namespace Belle2 {
      */
     void event() override;
 
-    /// Stream the histograms one last time and send out a run end message. We rely on all histogram modules to clear their own state.
+    /// Stream the full histograms one last time and send out a run end message. We rely on all histogram modules to clear their own state.
     void endRun() override;
 
-    /// Call the defineHisto function of all histogram modules registered at the RbTupleManager singleton.
+    /// Call the defineHisto function of all histogram modules registered at the RbTupleManager singleton. The first sending of the run will send the full histograms.
     void beginRun() override;
 
     /// Stream the histograms one last time and send out a terminate message. We rely on all histogram modules to clear their own state.
@@ -63,6 +68,10 @@ namespace Belle2 {
     std::string m_param_output;
     /// Module parameter: send out interval in seconds
     unsigned int m_param_sendOutInterval = 30;
+    /// Module parameter: send only the changes since the last sending
+    bool m_param_sendChangesOnly = true;
+    /// Module parameter: number of sendings of only the changes after which the full histograms are sent again
+    unsigned int m_param_fullSendInterval = 10;
 
     /// ZMQ Parent needed for the connections
     std::shared_ptr<ZMQParent> m_parent;
@@ -80,7 +89,7 @@ namespace Belle2 {
     /// Point in time when the current interval counting started
     std::chrono::system_clock::time_point m_start;
 
-    /// Helper function to serialize and send out the histograms
-    void sendOutHistograms();
+    /// Helper function to serialize and send out the histograms (only the changes if configured and not sendFull)
+    void sendOutHistograms(bool sendFull = false);
   };
 }
\ No newline at end of file
@@ -43,6 +43,10 @@ namespace Belle2 {
    * the remaining modules should not process this event via an event function
    * (assured by the HLTEventProcessor).
    *
+   * With decodingThreads > 0, already received event messages are queued and decoded in
+   * parallel threads while the data store is filled with one event after the other
+   * in the order the messages were received (also for the end run and terminate messages).
+   *
    * TODO: currently, this module is also used in the ExressReco use case, which
    * is good as it makes things more uniform. THe downside is, that we also have to define
    * the store arrays, which are not so trivial in this case (and needs to be kep in sync).
@@ -78,6 +82,8 @@ namespace Belle2 {
     unsigned int m_param_bufferSize = 2;
     /// Module parameter: additional to the raw data, also register the data store objects needed for express reco. TODO: this might change
     bool m_param_addExpressRecoObjects = false;
+    /// Module parameter: number of threads decoding the received event messages in parallel, 0 to decode them one by one
+    unsigned int m_param_decodingThreads = 0;
 
     /// Default experiment number to be set during initialization/run end to have something to load the geometry. Module parameter but will be updated
     unsigned int m_lastExperiment = 42;
@@ -28,7 +28,11 @@ HLTDQM2ZMQModule::HLTDQM2ZMQModule() : Module()
     "The histogram sending is handled via a confirmed connection (output in this case), "
     "so all the usual conventions for a confirmed connection apply. "
     "This module does only makes sense to run on the HLT, it is not useful for local "
-    "file writeout."
+    "file writeout. "
+    "By default, only the changes of the histograms since the last sending are sent. "
+    "The full histograms are sent on the first and the last sending of each run and "
+    "regularly in between (see fullSendInterval), so the histogram servers can recover "
+    "from a lost state."
   );
   setPropertyFlags(EModulePropFlags::c_ParallelProcessingCertified);
 
@@ -37,6 +41,14 @@ HLTDQM2ZMQModule::HLTDQM2ZMQModule() : Module()
            "Please note that the full stack of DQM histo servers"
            "could delay this, as each of them have a timeout.",
            m_param_sendOutInterval);
+  addParam("sendChangesOnly", m_param_sendChangesOnly, "Send only the changed bins of the histograms since the last sending "
+           "instead of the full histograms. The histogram servers need to understand these messages.",
+           m_param_sendChangesOnly);
+  addParam("fullSendInterval", m_param_fullSendInterval, "If only the changes are sent: number of sendings of the changes "
+           "after which the full histograms are sent again. A histogram server dismisses the changes of a sender "
+           "whose full histograms it does not have (e.g. after a restart), until the next full sending. "
+           "0 means to send the full histograms only on the first and the last sending of each run.",
+           m_param_fullSendInterval);
 }
 
 void HLTDQM2ZMQModule::event()
@@ -70,6 +82,9 @@ void HLTDQM2ZMQModule::event()
 
 void HLTDQM2ZMQModule::beginRun()
 {
+  // The histogram servers start from scratch in a new run
+  m_streamHelper.resetHistogramChanges();
+
   if (m_histogramsDefined) {
     return;
   }
@@ -92,7 +107,8 @@ void HLTDQM2ZMQModule::endRun()
 
   try {
     B2DEBUG(10, "Sending out old run message");
-    sendOutHistograms();
+    // Always end the run with the full histograms, so the final result does not depend on previous messages
+    sendOutHistograms(true);
     auto message = ZMQMessageFactory::createMessage(EMessageTypes::c_lastEventMessage);
     m_output->handleEvent(std::move(message), false, 1000);
   } catch (zmq::error_t& error) {
@@ -129,12 +145,13 @@ void HLTDQM2ZMQModule::terminate()
   }
 }
 
-void HLTDQM2ZMQModule::sendOutHistograms()
+void HLTDQM2ZMQModule::sendOutHistograms(bool sendFull)
 {
   if (m_firstEvent) {
     return;
   }
 
-  auto msg = m_streamHelper.streamHistograms();
+  auto msg = m_param_sendChangesOnly and not sendFull ? m_streamHelper.streamHistogramChanges(m_param_fullSendInterval) :
+             m_streamHelper.streamHistograms();
   m_output->handleEvent(std::move(msg), false, 1000);
 }
@@ -36,7 +36,10 @@ HLTZMQ2DsModule::HLTZMQ2DsModule() : Module()
     "are deserialized and written to data store. End run or terminate messages are  "
     "handled by setting a special flag of the EventMetaData. Also in this case  "
     "the remaining modules should not process this event via an event function "
-    "(assured by the HLTEventProcessor)."
+    "(assured by the HLTEventProcessor). "
+    "With decodingThreads > 0, already received event messages are queued and decoded in "
+    "parallel threads while the data store is filled with one event after the other "
+    "in the order the messages were received (also for the end run and terminate messages)."
   );
   setPropertyFlags(EModulePropFlags::c_Input | EModulePropFlags::c_ParallelProcessingCertified);
 
@@ -46,6 +49,10 @@ HLTZMQ2DsModule::HLTZMQ2DsModule() : Module()
            m_param_addExpressRecoObjects);
   addParam("bufferSize", m_param_bufferSize,
            "How many events should be kept in flight. Has an impact on the stopping time as well as the rate stability", m_param_bufferSize);
+  addParam("decodingThreads", m_param_decodingThreads,
+           "Number of threads decoding the received event messages in parallel (0 to decode them one by one). "
+           "Up to decodingThreads + 1 received events are queued, so bufferSize should be at least as large.",
+           m_param_decodingThreads);
 
   addParam("defaultExperiment", m_lastExperiment,
            "Default experiment number to be set during initialization/run end to have something to load the geometry.", m_lastExperiment);
@@ -81,7 +88,7 @@ void HLTZMQ2DsModule::event()
     // If we are not in this initialization step, we can do the normal event processing
     // This becomes now the first "real" event
     if (m_firstEvent) {
-      m_streamHelper.initialize();
+      m_streamHelper.initialize(m_param_decodingThreads);
 
       m_parent = std::make_unique<ZMQParent>();
       m_input = std::make_unique<ZMQLoadBalancedInput>(m_param_input, m_param_bufferSize, m_parent);
@@ -90,41 +97,51 @@ void HLTZMQ2DsModule::event()
     }
 
     const auto reactToInput = [this]() {
-      auto eventMessage = m_input->handleIncomingData();
-
-      if (eventMessage->isMessage(EMessageTypes::c_lastEventMessage)) {
-        B2DEBUG(10, "Received run change request");
-
-        m_eventMetaData.create();
-        m_eventMetaData->setEndOfRun(m_lastExperiment, m_lastRun);
-        return;
-      } else if (eventMessage->isMessage(EMessageTypes::c_terminateMessage)) {
-        B2DEBUG(10, "Received termination request");
+      m_streamHelper.queue(m_input->handleIncomingData());
+    };
 
-        m_eventMetaData.create();
-        m_eventMetaData->setEndOfData();
-        return;
+    // Wait for a message if nothing is queued. Otherwise only take the messages which are
+    // already there, until there are enough to keep all decoding threads busy.
+    while (m_streamHelper.getNumberOfQueuedMessages() <= m_param_decodingThreads) {
+      const int timeout = m_streamHelper.getNumberOfQueuedMessages() == 0 ? -1 : 0;
+      if (not ZMQConnection::poll({{m_input.get(), reactToInput}}, timeout)) {
+        break;
       }
+    }
 
-      B2ASSERT("Must be event message", eventMessage->isMessage(EMessageTypes::c_eventMessage) or
-               eventMessage->isMessage(EMessageTypes::c_rawDataMessage));
-      B2DEBUG(10, "received event message... write it to data store");
-
-      m_streamHelper.read(std::move(eventMessage));
-
-      B2ASSERT("There is still no event meta data present!", m_eventMetaData);
-      m_lastRun = m_eventMetaData->getRun();
-      m_lastExperiment = m_eventMetaData->getExperiment();
-    };
-
-    bool result = ZMQConnection::poll({{m_input.get(), reactToInput}}, -1);
-    if (!result) {
+    if (m_streamHelper.getNumberOfQueuedMessages() == 0) {
       // didn't get any events, probably interrupted by a signal.
       // We're the input module so let's better have some event meta data
       // even if it's not useful
       m_eventMetaData.create();
       m_eventMetaData->setEndOfData();
+      return;
+    }
+
+    // The oldest message is restored (after its decoding has finished)
+    auto eventMessage = m_streamHelper.readQueued();
+
+    if (eventMessage->isMessage(EMessageTypes::c_lastEventMessage)) {
+      B2DEBUG(10, "Received run change request");
+
+      m_eventMetaData.create();
+      m_eventMetaData->setEndOfRun(m_lastExperiment, m_lastRun);
+      return;
+    } else if (eventMessage->isMessage(EMessageTypes::c_terminateMessage)) {
+      B2DEBUG(10, "Received termination request");
+
+      m_eventMetaData.create();
+      m_eventMetaData->setEndOfData();
+      return;
     }
+
+    B2ASSERT("Must be event message", eventMessage->isMessage(EMessageTypes::c_eventMessage) or
+             eventMessage->isMessage(EMessageTypes::c_rawDataMessage));
+    B2DEBUG(10, "received event message... written to data store");
+
+    B2ASSERT("There is still no event meta data present!", m_eventMetaData);
+    m_lastRun = m_eventMetaData->getRun();
+    m_lastExperiment = m_eventMetaData->getExperiment();
   } catch (zmq::error_t& error) {
     // This is an unexpected error: better report it.
     B2ERROR("ZMQ Error while calling the event: " << error.num());
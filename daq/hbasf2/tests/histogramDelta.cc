@@ -0,0 +1,268 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#include <daq/hbasf2/utils/HistogramDelta.h>
+#include <daq/hbasf2/utils/HistogramMapping.h>
+#include <framework/pcore/MsgHandler.h>
+
+#include <gtest/gtest.h>
+
+#include <TH1D.h>
+#include <TH1F.h>
+#include <TH2F.h>
+#include <TProfile.h>
+#include <TRandom3.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Belle2;
+
+namespace {
+
+  /// Compare two doubles up to a relative tolerance (the summation order differs between the merging strategies)
+  void expectClose(double expected, double actual, const std::string& what)
+  {
+    EXPECT_NEAR(expected, actual, 1e-9 * std::max(1., std::fabs(expected))) << what;
+  }
+
+  /// Check that both histograms have the same cells, errors, entries and statistics
+  void expectSameHistogram(const TH1& expected, const TH1& actual)
+  {
+    const std::string name = expected.GetName();
+    ASSERT_EQ(expected.GetNcells(), actual.GetNcells()) << name;
+    expectClose(expected.GetEntries(), actual.GetEntries(), name + " entries");
+    for (int cell = 0; cell < expected.GetNcells(); cell++) {
+      expectClose(expected.GetBinContent(cell), actual.GetBinContent(cell), name + " content of cell " + std::to_string(cell));
+      expectClose(expected.GetBinError(cell), actual.GetBinError(cell), name + " error of cell " + std::to_string(cell));
+    }
+
+    double expectedStats[TH1::kNstat] = {0};
+    double actualStats[TH1::kNstat] = {0};
+    expected.GetStats(expectedStats);
+    actual.GetStats(actualStats);
+    for (int i = 0; i < TH1::kNstat; i++) {
+      expectClose(expectedStats[i], actualStats[i], name + " statistics " + std::to_string(i));
+    }
+  }
+
+  /// Test class for the encoding of histogram changes and their merging in the histogram servers
+  class HistogramDeltaTest : public ::testing::Test {
+
+  protected:
+    /// Create the histograms of all senders outside of any ROOT directory
+    void SetUp() override
+    {
+      TH1::AddDirectory(false);
+      for (unsigned int sender = 0; sender < c_numberOfSenders; sender++) {
+        m_histograms[sender].emplace_back(new TH1D("weighted", "weighted", 50, -5, 5));
+        m_histograms[sender].back()->Sumw2();
+        m_histograms[sender].emplace_back(new TH2F("twoDimensional", "twoDimensional", 20, -5, 5, 10, -5, 5));
+        m_histograms[sender].emplace_back(new TProfile("profile", "profile", 20, -5, 5));
+      }
+    }
+
+    /// Restore the ROOT default
+    void TearDown() override
+    {
+      TH1::AddDirectory(true);
+    }
+
+    /// Fill the histograms of the sender randomly (with weights)
+    void fill(unsigned int sender, unsigned int numberOfFills)
+    {
+      for (unsigned int i = 0; i < numberOfFills; i++) {
+        const double x = m_random.Gaus();
+        const double weight = m_random.Uniform(0.5, 2);
+        m_histograms[sender][0]->Fill(x, weight);
+        dynamic_cast<TH2F&>(*m_histograms[sender][1]).Fill(x, m_random.Gaus());
+        dynamic_cast<TProfile&>(*m_histograms[sender][2]).Fill(x, m_random.Gaus(), weight);
+      }
+    }
+
+    /// Stream the histograms of the sender into a mapping, as the histogram servers receive them
+    HistogramMapping getMapping(unsigned int sender) const
+    {
+      MsgHandler msgHandler;
+      for (const auto& histogram : m_histograms[sender]) {
+        msgHandler.add(histogram.get(), histogram->GetName());
+      }
+      return HistogramMapping(std::unique_ptr<EvtMessage>(msgHandler.encode_msg(MSG_EVENT)));
+    }
+
+    /// Decode the content of a mapping by its serialization
+    static std::map<std::string, std::unique_ptr<TH1>> decode(const HistogramMapping& mapping)
+    {
+      auto message = mapping.toMessage();
+      MsgHandler msgHandler;
+      std::vector<TObject*> objects;
+      std::vector<std::string> names;
+      msgHandler.decode_msg(message.get(), objects, names);
+
+      std::map<std::string, std::unique_ptr<TH1>> histograms;
+      for (size_t i = 0; i < objects.size(); i++) {
+        histograms[names[i]].reset(dynamic_cast<TH1*>(objects[i]));
+      }
+      return histograms;
+    }
+
+    /// Check that both mappings contain the same histograms
+    static void expectSameMapping(const HistogramMapping& expected, const HistogramMapping& actual)
+    {
+      const auto expectedHistograms = decode(expected);
+      const auto actualHistograms = decode(actual);
+      ASSERT_EQ(expectedHistograms.size(), actualHistograms.size());
+      for (const auto& [name, histogram] : expectedHistograms) {
+        auto actualIterator = actualHistograms.find(name);
+        ASSERT_NE(actualIterator, actualHistograms.end()) << name;
+        ASSERT_TRUE(histogram and actualIterator->second) << name;
+        expectSameHistogram(*histogram, *actualIterator->second);
+      }
+    }
+
+    /// Number of senders
+    static constexpr unsigned int c_numberOfSenders = 2;
+    /// Histograms of each sender
+    std::vector<std::unique_ptr<TH1>> m_histograms[c_numberOfSenders];
+    /// Random generator for the fills
+    TRandom3 m_random{42};
+  };
+
+  /// Encoding the changes, transporting the buffer and applying it to the previous state reproduces the current state
+  TEST_F(HistogramDeltaTest, RoundTrip)
+  {
+    fill(0, 1000);
+    std::vector<std::unique_ptr<TH1>> previous;
+    for (const auto& histogram : m_histograms[0]) {
+      previous.emplace_back(dynamic_cast<TH1*>(histogram->Clone()));
+    }
+    fill(0, 500);
+
+    HistogramDelta delta;
+    for (unsigned int i = 0; i < previous.size(); i++) {
+      ASSERT_TRUE(HistogramDelta::isCompatible(*m_histograms[0][i], *previous[i]));
+      EXPECT_TRUE(delta.add(m_histograms[0][i]->GetName(), m_histograms[0][i].get(), previous[i].get()));
+    }
+    // Unchanged histograms are not encoded
+    EXPECT_FALSE(delta.add("unchanged", previous[0].get(), previous[0].get()));
+    EXPECT_EQ(previous.size(), delta.getNumberOfHistograms());
+
+    const HistogramDelta receivedDelta(delta.data(), delta.size());
+    ASSERT_EQ(delta.getNumberOfHistograms(), receivedDelta.getNumberOfHistograms());
+    const unsigned int skippedHistograms = receivedDelta.apply([&previous](const std::string & name) -> TH1* {
+      for (const auto& histogram : previous)
+      {
+        if (name == histogram->GetName()) {
+          return histogram.get();
+        }
+      }
+      return nullptr;
+    });
+    EXPECT_EQ(0u, skippedHistograms);
+
+    for (unsigned int i = 0; i < previous.size(); i++) {
+      expectSameHistogram(*m_histograms[0][i], *previous[i]);
+    }
+  }
+
+  /// Truncated or otherwise inconsistent buffers are detected and not applied at all
+  TEST_F(HistogramDeltaTest, InvalidBuffer)
+  {
+    fill(0, 100);
+    TH1& histogram = *m_histograms[0][0];
+    HistogramDelta delta;
+    ASSERT_TRUE(delta.add(histogram.GetName(), &histogram, nullptr));
+    EXPECT_TRUE(HistogramDelta(delta.data(), delta.size()).isValid());
+
+    std::vector<char> buffer(delta.data(), delta.data() + delta.size());
+    EXPECT_FALSE(HistogramDelta(buffer.data(), buffer.size() - 1).isValid());
+    EXPECT_FALSE(HistogramDelta(buffer.data(), 2).isValid());
+    buffer.push_back(0);
+    EXPECT_FALSE(HistogramDelta(buffer.data(), buffer.size()).isValid());
+    buffer.pop_back();
+
+    // Move the first changed cell out of the histogram
+    const std::string name = histogram.GetName();
+    const size_t positionOfFirstCell = 4 * sizeof(uint32_t) + name.size() + (1 + TH1::kNstat) * sizeof(double) + sizeof(uint32_t);
+    const uint32_t cellOutOfRange = histogram.GetNcells();
+    memcpy(&buffer[positionOfFirstCell], &cellOutOfRange, sizeof(uint32_t));
+    const HistogramDelta invalidDelta(buffer.data(), buffer.size());
+    ASSERT_FALSE(invalidDelta.isValid());
+
+    std::unique_ptr<TH1> target(dynamic_cast<TH1*>(histogram.Clone()));
+    target->Reset();
+    EXPECT_EQ(1u, invalidDelta.apply([&target](const std::string&) { return target.get(); }));
+    EXPECT_EQ(0, target->GetEntries());
+  }
+
+  /// Only histograms with the same type, number of bins and axis limits are compatible
+  TEST_F(HistogramDeltaTest, IsCompatible)
+  {
+    TH1D histogram("histogram", "histogram", 10, 0, 10);
+    TH1D sameBinning("sameBinning", "sameBinning", 10, 0, 10);
+    TH1F differentType("differentType", "differentType", 10, 0, 10);
+    TH1D differentBins("differentBins", "differentBins", 20, 0, 10);
+    TH1D differentLimits("differentLimits", "differentLimits", 10, 0, 20);
+    const double edges[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    const double otherEdges[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9.5, 10};
+    TH1D variableBins("variableBins", "variableBins", 10, edges);
+    TH1D otherVariableBins("otherVariableBins", "otherVariableBins", 10, otherEdges);
+    TH2F twoDimensional("twoDimensional", "twoDimensional", 10, 0, 10, 10, 0, 10);
+    TH2F differentYLimits("differentYLimits", "differentYLimits", 10, 0, 10, 10, -10, 0);
+
+    EXPECT_TRUE(HistogramDelta::isCompatible(histogram, sameBinning));
+    EXPECT_FALSE(HistogramDelta::isCompatible(histogram, differentType));
+    EXPECT_FALSE(HistogramDelta::isCompatible(histogram, differentBins));
+    EXPECT_FALSE(HistogramDelta::isCompatible(histogram, differentLimits));
+    EXPECT_FALSE(HistogramDelta::isCompatible(variableBins, otherVariableBins));
+    EXPECT_FALSE(HistogramDelta::isCompatible(twoDimensional, differentYLimits));
+  }
+
+  /// Merging the changes of one sender gives the same result as merging the full histograms of all senders again
+  TEST_F(HistogramDeltaTest, DeltaMergeEqualsFullMerge)
+  {
+    fill(0, 1000);
+    fill(1, 700);
+    const HistogramMapping firstState = getMapping(0);
+
+    HistogramMapping updatedSum;
+    updatedSum += firstState;
+    updatedSum += getMapping(1);
+    HistogramMapping deltaSum;
+    deltaSum += firstState;
+    deltaSum += getMapping(1);
+
+    fill(0, 300);
+    const HistogramMapping secondState = getMapping(0);
+
+    // Replace the old contribution (as the server does for full messages) ...
+    ASSERT_TRUE(updatedSum.update(firstState, secondState));
+
+    // ... or add the transported changes (as the server does for delta messages)
+    const auto firstHistograms = decode(firstState);
+    HistogramDelta delta;
+    for (unsigned int i = 0; i < m_histograms[0].size(); i++) {
+      const std::string name = m_histograms[0][i]->GetName();
+      delta.add(name, m_histograms[0][i].get(), firstHistograms.at(name).get());
+    }
+    EXPECT_EQ(0u, deltaSum.applyDelta(HistogramDelta(delta.data(), delta.size())));
+
+    HistogramMapping fullSum;
+    fullSum += secondState;
+    fullSum += getMapping(1);
+
+    expectSameMapping(fullSum, updatedSum);
+    expectSameMapping(fullSum, deltaSum);
+  }
+
+}
@@ -7,6 +7,7 @@
 ##########################################################################
 
 import os
+import subprocess
 from unittest import main
 import basf2
 
@@ -330,5 +331,101 @@ class HistogramStopTestCase(HLTZMQTestCase):
         self.assertIsDown("histoserver")
 
 
+def get_total_entries(file_name, number_of_histograms):
+    """Return the sum of the entries of the histograms written by b2hlt_send_histos (None if one is missing)"""
+    import ROOT
+    root_file = ROOT.TFile(file_name, "READ")
+    total_entries = 0
+    for i in range(number_of_histograms):
+        histogram = root_file.Get(f"histogram_{i}")
+        if not histogram:
+            total_entries = None
+            break
+        total_entries += histogram.GetEntries()
+    root_file.Close()
+    return total_entries
+
+
+class HistogramChangesTestCase(HLTZMQTestCase):
+    """Test case for the sending of only the histogram changes, including the recovery after a clear of the server"""
+    #: input_port
+    input_port = HLTZMQTestCase.get_free_port()
+    #: monitoring_port
+    monitoring_port = HLTZMQTestCase.get_free_port()
+
+    #: needed_programs
+    needed_programs = {"histoserver": ["b2hlt_finalhistoserver", "--input", f"tcp://*:{input_port}",
+                                       "--rootFileName", "outputFile.root",
+                                       "--timeout", "0",  # only write out on the stop messages
+                                       "--monitor", f"tcp://*:{monitoring_port}"],
+                       }
+
+    #: histogram_data
+    histogram_data = open(basf2.find_file("daq/hbasf2/tests/histos.raw"), "br").read()
+    #: event_data of another run, which makes the server clear all histograms
+    other_run_event_data = b"""{
+        "_typename" : "Belle2::EventMetaData",
+        "fUniqueID" : 0,
+        "fBits" : 33554432,
+        "m_event" : 1,
+        "m_run" : 2,
+        "m_subrun" : 0,
+        "m_experiment" : 1,
+        "m_production" : 0,
+        "m_time" : 0,
+        "m_parentLfn" : "",
+        "m_generatedWeight" : 1,
+        "m_errorFlag" : 0
+        }"""
+
+    #: number of histograms of the sender
+    number_of_histograms = 10
+    #: number of sendings of the sender
+    number_of_sends = 6
+    #: number of fills between two sendings
+    number_of_fills = 1000
+
+    def testRecoveryAfterClear(self):
+        """The changes after a clear are dismissed until the next full sending, the final result is complete"""
+        monitoring_socket = self.create_socket(self.monitoring_port)
+
+        other_input_socket = self.create_socket(self.input_port, identity="other_socket")
+        self.send(other_input_socket, "h")
+        self.assertIsMsgType(other_input_socket, "c")
+
+        # Sendings: full, 2 x changes, full, changes, full (the last one is always full)
+        sender = subprocess.Popen(["b2hlt_send_histos", "--output", f"tcp://localhost:{self.input_port}",
+                                   "--histograms", str(self.number_of_histograms), "--bins", "20",
+                                   "--sends", str(self.number_of_sends), "--fills", str(self.number_of_fills),
+                                   "--interval", "1000", "--changesOnly", "--fullSendInterval", "2"],
+                                  stdout=subprocess.DEVNULL)
+
+        self.assertMonitoring(monitoring_socket, "input.registered_workers", 2)
+        self.assertMonitoring(monitoring_socket, "input.received_events", 1)
+
+        # A message of another run clears the server, so it loses the state of the sender
+        self.send(other_input_socket, "v", self.histogram_data, self.other_run_event_data)
+        self.assertIsMsgType(other_input_socket, "c")
+
+        self.assertEqual(sender.wait(timeout=30), 0)
+
+        # Only the two sendings of changes before the next full sending are dismissed
+        self.assertMonitoring(monitoring_socket, "input.received_events", self.number_of_sends + 1)
+        self.assertMonitoring(monitoring_socket, "output.skipped_delta_messages", 2)
+
+        self.send(other_input_socket, "l")
+        self.assertIsMsgType(other_input_socket, "c")
+        self.assertMonitoring(monitoring_socket, "input.all_stop_messages", True)
+
+        self.assertHasOutputFile("outputFile.root", unlink=False)
+        self.assertEqual(get_total_entries("outputFile.root", self.number_of_histograms),
+                         self.number_of_sends * self.number_of_fills)
+        os.unlink("outputFile.root")
+
+        self.send(other_input_socket, "x")
+        self.assertIsMsgType(other_input_socket, "c")
+        self.assertIsDown("histoserver")
+
+
 if __name__ == '__main__':
     main()
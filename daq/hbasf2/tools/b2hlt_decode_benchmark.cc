@@ -0,0 +1,129 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <framework/datastore/DataStore.h>
+#include <framework/logging/Logger.h>
+#include <framework/pcore/EvtMessage.h>
+#include <framework/pcore/SeqFile.h>
+#include <framework/pcore/zmq/messages/ZMQMessageFactory.h>
+#include <framework/pcore/zmq/utils/StreamHelper.h>
+
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+
+namespace po = boost::program_options;
+using namespace Belle2;
+
+int main(int argc, char* argv[])
+{
+  std::string inputFileName;
+  unsigned int decodingThreads = 0;
+  unsigned int repetitions = 1;
+
+  po::options_description
+  desc("b2hlt_decode_benchmark - helper tool to benchmark the decoding of recorded event messages in the output processes "
+       "(ZMQRxOutput, HLTZMQ2Ds). All events of a SeqRoot file are read into memory and restored one after the other "
+       "into the data store, optionally decoding them in parallel threads.");
+  desc.add_options()
+  ("help,h", "Print this help message")
+  ("input", po::value<std::string>(&inputFileName)->required(),
+   "SeqRoot file with the recorded events")
+  ("threads", po::value<unsigned int>(&decodingThreads)->default_value(decodingThreads),
+   "number of decoding threads, 0 to decode the events one by one")
+  ("repetitions", po::value<unsigned int>(&repetitions)->default_value(repetitions),
+   "how often all events are decoded");
+
+  po::positional_options_description p;
+
+  po::variables_map vm;
+  try {
+    po::store(
+      po::command_line_parser(argc, argv).options(desc).positional(p).run(), vm);
+  } catch (std::exception& e) {
+    B2FATAL(e.what());
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    exit(1);
+  }
+
+  try {
+    po::notify(vm);
+  } catch (std::exception& e) {
+    B2FATAL(e.what());
+  }
+
+  // Read in all records, so the file reading is not part of the measurement
+  std::vector<std::vector<char>> records;
+  SeqFile file(inputFileName, "r");
+  if (file.status() <= 0) {
+    B2FATAL("Can not open input file " << inputFileName);
+  }
+  char* record = nullptr;
+  while (file.readRecord(record) > 0) {
+    EvtMessage message(record);
+    records.emplace_back(record, record + message.size());
+  }
+
+  StreamHelper streamHelper;
+  streamHelper.initialize(0, true, decodingThreads);
+
+  // The streamer infos and the first event are restored while the data store registration is active
+  DataStore::Instance().setInitializeActive(true);
+  unsigned int firstEvent = 0;
+  for (; firstEvent < records.size(); firstEvent++) {
+    std::unique_ptr<EvtMessage> evtMessage(new EvtMessage(records[firstEvent].data()));
+    const bool isEvent = evtMessage->type() != MSG_STREAMERINFO;
+    streamHelper.read(ZMQMessageFactory::createMessage(EMessageTypes::c_eventMessage, evtMessage));
+    if (isEvent) {
+      firstEvent++;
+      break;
+    }
+  }
+  DataStore::Instance().setInitializeActive(false);
+
+  std::vector<std::unique_ptr<EvtMessage>> events;
+  size_t bytes = 0;
+  for (unsigned int i = firstEvent; i < records.size(); i++) {
+    events.emplace_back(new EvtMessage(records[i].data()));
+    bytes += records[i].size();
+  }
+  if (events.empty()) {
+    B2FATAL("Need at least two events in the input file");
+  }
+
+  // Keep as many messages in the queue as the output modules do
+  const auto start = std::chrono::steady_clock::now();
+  unsigned int restoredEvents = 0;
+  for (unsigned int repetition = 0; repetition < repetitions; repetition++) {
+    for (const auto& event : events) {
+      streamHelper.queue(ZMQMessageFactory::createMessage(EMessageTypes::c_eventMessage, event));
+      if (streamHelper.getNumberOfQueuedMessages() > decodingThreads) {
+        DataStore::Instance().invalidateData(DataStore::c_Event);
+        streamHelper.readQueued();
+        restoredEvents++;
+      }
+    }
+  }
+  while (streamHelper.getNumberOfQueuedMessages() > 0) {
+    DataStore::Instance().invalidateData(DataStore::c_Event);
+    streamHelper.readQueued();
+    restoredEvents++;
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  std::cout << "events " << restoredEvents << std::endl;
+  std::cout << "seconds " << seconds << std::endl;
+  std::cout << "events_per_second " << restoredEvents / seconds << std::endl;
+  std::cout << "megabytes_per_second " << bytes * repetitions / seconds / 1e6 << std::endl;
+}
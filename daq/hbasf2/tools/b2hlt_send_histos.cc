@@ -0,0 +1,146 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <framework/datastore/DataStore.h>
+#include <framework/datastore/StoreObjPtr.h>
+#include <framework/dataobjects/EventMetaData.h>
+#include <framework/logging/Logger.h>
+#include <framework/pcore/zmq/connections/ZMQConfirmedConnection.h>
+#include <framework/pcore/zmq/messages/ZMQMessageFactory.h>
+#include <framework/pcore/zmq/utils/ZMQParent.h>
+
+#include <daq/hbasf2/utils/HLTStreamHelper.h>
+
+#include <TH1F.h>
+#include <TH2F.h>
+#include <TProfile.h>
+#include <TRandom3.h>
+
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace po = boost::program_options;
+using namespace Belle2;
+
+int main(int argc, char* argv[])
+{
+  std::string outputAddress;
+  unsigned int numberOfHistograms = 1000;
+  unsigned int numberOfBins = 100;
+  unsigned int numberOfSends = 10;
+  unsigned int numberOfFills = 10000;
+  unsigned int interval = 1000;
+  unsigned int seed = 1;
+  bool changesOnly = false;
+  unsigned int fullSendInterval = 10;
+
+  po::options_description
+  desc("b2hlt_send_histos - helper tool mimicking the DQM histogram sending of a HLT worker (HLTDQM2ZMQ) for tests and benchmarks. "
+       "Fills a set of histograms randomly and sends them repeatedly to a histogram server.");
+  desc.add_options()
+  ("help,h", "Print this help message")
+  ("output", po::value<std::string>(&outputAddress)->required(),
+   "where to send the histograms to")
+  ("histograms", po::value<unsigned int>(&numberOfHistograms)->default_value(numberOfHistograms),
+   "number of histograms (a mixture of TH1F, TH2F and TProfile)")
+  ("bins", po::value<unsigned int>(&numberOfBins)->default_value(numberOfBins),
+   "number of bins (in x) of each histogram")
+  ("sends", po::value<unsigned int>(&numberOfSends)->default_value(numberOfSends),
+   "how often the histograms are sent")
+  ("fills", po::value<unsigned int>(&numberOfFills)->default_value(numberOfFills),
+   "number of fills (distributed over all histograms) between two sends")
+  ("interval", po::value<unsigned int>(&interval)->default_value(interval),
+   "time between two sends in ms")
+  ("seed", po::value<unsigned int>(&seed)->default_value(seed),
+   "random seed")
+  ("changesOnly", po::bool_switch(&changesOnly),
+   "send only the changes since the last send (except for the first and the last one)")
+  ("fullSendInterval", po::value<unsigned int>(&fullSendInterval)->default_value(fullSendInterval),
+   "with changesOnly: number of sends of the changes after which the full histograms are sent again (0: never)");
+
+  po::positional_options_description p;
+
+  po::variables_map vm;
+  try {
+    po::store(
+      po::command_line_parser(argc, argv).options(desc).positional(p).run(), vm);
+  } catch (std::exception& e) {
+    B2FATAL(e.what());
+  }
+
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    exit(1);
+  }
+
+  try {
+    po::notify(vm);
+  } catch (std::exception& e) {
+    B2FATAL(e.what());
+  }
+
+  DataStore::Instance().setInitializeActive(true);
+  StoreObjPtr<EventMetaData> eventMetaData;
+  eventMetaData.registerInDataStore();
+  DataStore::Instance().setInitializeActive(false);
+
+  eventMetaData.create();
+  eventMetaData->setExperiment(1);
+  eventMetaData->setRun(1);
+
+  // The histograms are created in the current ROOT directory, which is streamed
+  std::vector<std::unique_ptr<TH1>> histograms;
+  for (unsigned int i = 0; i < numberOfHistograms; i++) {
+    const std::string name = "histogram_" + std::to_string(i);
+    if (i % 10 == 9) {
+      histograms.emplace_back(new TProfile(name.c_str(), name.c_str(), numberOfBins, -5, 5));
+    } else if (i % 4 == 3) {
+      histograms.emplace_back(new TH2F(name.c_str(), name.c_str(), numberOfBins, -5, 5, 10, -5, 5));
+    } else {
+      histograms.emplace_back(new TH1F(name.c_str(), name.c_str(), numberOfBins, -5, 5));
+    }
+  }
+
+  auto parent = std::make_shared<ZMQParent>();
+  ZMQConfirmedOutput output(outputAddress, parent);
+  HLTStreamHelper streamHelper;
+  TRandom3 random(seed);
+
+  size_t sentBytes = 0;
+  for (unsigned int send = 0; send < numberOfSends; send++) {
+    for (unsigned int fill = 0; fill < numberOfFills; fill++) {
+      TH1* histogram = histograms[random.Integer(numberOfHistograms)].get();
+      const double x = random.Gaus();
+      if (auto* profile = dynamic_cast<TProfile*>(histogram)) {
+        profile->Fill(x, random.Gaus());
+      } else if (auto* histogram2D = dynamic_cast<TH2F*>(histogram)) {
+        histogram2D->Fill(x, random.Gaus());
+      } else {
+        histogram->Fill(x);
+      }
+    }
+
+    // As in HLTDQM2ZMQ, the last send of the run always contains the full histograms
+    const bool lastSend = send + 1 == numberOfSends;
+    auto message = changesOnly and not lastSend ? streamHelper.streamHistogramChanges(fullSendInterval) :
+                   streamHelper.streamHistograms();
+    sentBytes += message->getDataMessage().size();
+    output.handleEvent(std::move(message), false, 1000);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+  }
+
+  output.handleEvent(ZMQMessageFactory::createMessage(EMessageTypes::c_lastEventMessage), false, 1000);
+  output.handleEvent(ZMQMessageFactory::createMessage(EMessageTypes::c_terminateMessage), false, 1000);
+
+  std::cout << "sent_bytes " << sentBytes << std::endl;
+}
@@ -29,6 +29,9 @@
 #include <hlt/softwaretrigger/dataobjects/SoftwareTriggerVariables.h>
 #include <mdst/dataobjects/TRGSummary.h>
 
+#include <TH1.h>
+
+#include <map>
 #include <string>
 #include <memory>
 
@@ -37,8 +40,8 @@ namespace Belle2 {
   /// Helper class for data store serialization
   class HLTStreamHelper {
   public:
-    /// Initialize this class. Call this e.g. in the first event.
-    void initialize();
+    /// Initialize this class. Call this e.g. in the first event. Event messages in the queue are decoded in decodingThreads threads (if > 0).
+    void initialize(unsigned int decodingThreads = 0);
 
     /// Stream the data store into an event message. Add ROI as additional message (if valid).
     std::unique_ptr<ZMQNoIdMessage> stream(bool addPersistentDurability, bool streamTransientObjects);
@@ -49,13 +52,37 @@ namespace Belle2 {
     /// Stream all objects derived from TH1 into a message. Only the last subfolder is streamed by prefixing the histogram names with "<subfolder>/".
     std::unique_ptr<ZMQNoIdMessage> streamHistograms(bool compressed = true);
 
+    /**
+     * Stream only the changes of the histograms since the last call into a compressed delta message (see HistogramDelta).
+     * If there is no previous state of a histogram (e.g. first call or after resetHistogramChanges)
+     * or its binning has changed, all histograms are streamed in full with streamHistograms instead.
+     * The same happens if only the changes were streamed fullStreamInterval times in a row (0: never),
+     * so a receiver which has lost the state of this sender (e.g. after a restart) can pick up again.
+     */
+    std::unique_ptr<ZMQNoIdMessage> streamHistogramChanges(unsigned int fullStreamInterval = 0);
+
+    /// Forget the last streamed state of the histograms, so the next call to streamHistogramChanges streams all histograms in full.
+    void resetHistogramChanges();
+
     /// Read in a ZMQ message and rebuilt the data store from it.
     void read(std::unique_ptr<ZMQNoIdMessage> message);
 
+    /// Add a received message to the queue, event messages are decoded in the background (see StreamHelper).
+    void queue(std::unique_ptr<ZMQNoIdMessage> message);
+
+    /// Take the oldest queued message and rebuild the data store from it if it is an (raw) event message. The message is returned for further handling.
+    std::unique_ptr<ZMQNoIdMessage> readQueued();
+
+    /// Number of messages in the queue
+    size_t getNumberOfQueuedMessages() const { return m_streamHelper.getNumberOfQueuedMessages(); }
+
     /// Register all needed store objects, either only the raw data, ROIs and event meta data (for HLT) or additional objects (for express reco).
     void registerStoreObjects(bool addExpressRecoObjects);
 
   private:
+    /// Unpack a raw data message into the raw data objects in the data store
+    void readRawData(ZMQNoIdMessage& message);
+
     /// We use the framework stream helper
     StreamHelper m_streamHelper;
 
@@ -98,6 +125,11 @@ namespace Belle2 {
     /// Maximal size of the compression buffer
     unsigned int m_maximalCompressedSize = 100'000'000;
 
+    /// State of the histograms at the last call of streamHistogramChanges
+    std::map<std::string, std::unique_ptr<TH1>> m_sentHistograms;
+    /// Number of calls of streamHistogramChanges which streamed only the changes since the last full streaming
+    unsigned int m_numberOfChangeStreamings = 0;
+
     /// If the ROI payload data storobject is filled, write out the roi message (otherwise an empty message)
     zmq::message_t getROIMessageIfViable() const;
   };
@@ -0,0 +1,79 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#pragma once
+
+#include <TH1.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Belle2 {
+  /**
+   * Sparse encoding of the differences between two states of a set of histograms
+   * (e.g. between the last sent and the current state of the DQM histograms on a worker).
+   *
+   * For each histogram with changes, the difference of the entries and the statistics
+   * (see TH1::GetStats) is stored together with the differences of only the changed cells
+   * (content, sum of squared weights and for profiles bin entries and their sum of squared weights).
+   * Unchanged histograms are not stored at all.
+   * The differences can only be applied to histograms with the same type and binning,
+   * so the first state of a histogram always needs to be transported in full.
+   *
+   * The encoded buffer is a flat byte array which can be sent and reconstructed
+   * on the other side (on the same architecture). A received buffer is checked
+   * completely before anything is applied, see isValid.
+   */
+  class HistogramDelta {
+  public:
+    /// Create an empty delta
+    HistogramDelta();
+    /// Reconstruct the delta from a received buffer (the buffer is copied and checked, see isValid)
+    HistogramDelta(const char* buffer, size_t size);
+
+    /// Can the difference between the two histograms be encoded (same type and binning, including the axis limits)?
+    static bool isCompatible(const TH1& current, const TH1& previous);
+
+    /**
+     * Add the difference current - previous of the histogram with the given name.
+     * One of both can be a nullptr, which is treated like an empty histogram.
+     * The histograms need to be compatible (see isCompatible).
+     * Returns false (and does not add anything) if nothing has changed.
+     */
+    bool add(const std::string& name, const TH1* current, const TH1* previous);
+
+    /**
+     * Add the stored differences to the histogram returned by getHistogram for each name.
+     * Histograms which are not found (nullptr) or which do not match the stored binning are skipped.
+     * Returns the number of skipped histograms. An invalid delta is not applied at all and counts as one skipped histogram.
+     */
+    unsigned int apply(const std::function<TH1*(const std::string&)>& getHistogram) const;
+
+    /// Is the received buffer complete and consistent (e.g. not truncated, all changed cells within the histograms)?
+    bool isValid() const { return m_valid; }
+    /// Number of histograms with changes
+    unsigned int getNumberOfHistograms() const { return m_numberOfHistograms; }
+    /// Check if there are no changes
+    bool empty() const { return m_numberOfHistograms == 0; }
+    /// The encoded buffer
+    const char* data() const { return m_buffer.data(); }
+    /// Size of the encoded buffer
+    size_t size() const { return m_buffer.size(); }
+
+  private:
+    /// The encoded buffer
+    std::vector<char> m_buffer;
+    /// Number of histograms with changes (also stored at the start of the buffer)
+    unsigned int m_numberOfHistograms = 0;
+    /// Is the buffer complete and consistent?
+    bool m_valid = true;
+
+    /// Check the complete buffer, so it can be applied without any further checks
+    bool checkBuffer() const;
+  };
+}
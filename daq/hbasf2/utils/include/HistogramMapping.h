@@ -8,6 +8,7 @@
 #pragma once
 
 #include <framework/pcore/EvtMessage.h>
+#include <daq/hbasf2/utils/HistogramDelta.h>
 #include <TH1.h>
 
 #include <string>
@@ -40,6 +41,15 @@ namespace Belle2 {
 
     /// Add another histogramm tree instance by merging all histograms with the same name.
     void operator+=(const HistogramMapping& rhs);
+    /**
+     * Replace the contribution previous (which was added before) by current, by adding only the differences
+     * between both. Histograms not known so far are copied.
+     * Returns false if this is not possible (e.g. because the binning has changed). The content is undefined
+     * in this case and needs to be rebuilt.
+     */
+    bool update(const HistogramMapping& previous, const HistogramMapping& current);
+    /// Add the differences of the histograms in the delta. Returns the number of histograms that could not be found.
+    unsigned int applyDelta(const HistogramDelta& delta);
 
     /// Write out all stored histograms in the currently selected ROOT gDirectory
     void write() const;
@@ -14,6 +14,7 @@
 
 #include <framework/database/DBStore.h>
 #include <framework/core/RandomNumbers.h>
+#include <framework/core/EventTimeBudget.h>
 #include <framework/core/Environment.h>
 #include <framework/core/ModuleManager.h>
 
@@ -237,6 +238,7 @@ void HLTEventProcessor::processCore(PathPtr path)
     // Main call to event() of the modules, and maybe beginRun() and endRun()
     PathIterator moduleIter(path);
     terminationRequested = processEvent(moduleIter, firstRound);
+    EventTimeBudget::stopEvent();
 
     // Delete event related data in DataStore
     DataStore::Instance().invalidateData(DataStore::c_Event);
@@ -260,6 +262,12 @@ bool HLTEventProcessor::processEvent(PathIterator moduleIter, bool firstRound)
     Module* module = moduleIter.get();
     B2DEBUG(10, "Starting event of " << module->getName());
 
+    // Skip the module if the time budget of the event is exceeded
+    if (skipForEventTimeBudget(module)) {
+      moduleIter.next();
+      continue;
+    }
+
     // The actual call of the event function
     if (module != m_master) {
       // If this is not the master module it is quite simple: just call the event function
@@ -339,6 +347,9 @@ bool HLTEventProcessor::processEvent(PathIterator moduleIter, bool firstRound)
       // and the correct database
       DBStore::Instance().updateEvent();
 
+      // the time budget of the event starts now
+      startEventTimeBudget();
+
       // Store the current event meta data for the next round
       m_previousEventMetaData = *m_eventMetaDataPtr;
     }
@@ -356,6 +367,9 @@ bool HLTEventProcessor::processEvent(PathIterator moduleIter, bool firstRound)
       moduleIter.next();
     }
   }
+
+  // The last module can exceed the time budget as well
+  checkEventTimeBudgetAfterPath();
   return false;
 }
 
@@ -6,6 +6,7 @@
  * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
  **************************************************************************/
 #include <daq/hbasf2/utils/HLTStreamHelper.h>
+#include <daq/hbasf2/utils/HistogramDelta.h>
 #include <framework/pcore/zmq/messages/ZMQMessageFactory.h>
 #include <framework/pcore/MsgHandler.h>
 #include <daq/dataobjects/SendHeader.h>
@@ -26,7 +27,8 @@
 using namespace Belle2;
 
 namespace {
-  void streamHistogramImpl(TDirectory* curdir, Belle2::MsgHandler& msg, const std::string& dirName = "")
+  void collectHistogramsImpl(TDirectory* curdir, std::vector<std::pair<std::string, TH1*>>& histograms,
+                             const std::string& dirName = "")
   {
     TList* keylist = curdir->GetList();
 
@@ -44,20 +46,29 @@ namespace {
 
       if (objectClass->InheritsFrom(TH1::Class())) {
         auto* h1 = dynamic_cast<TH1*>(obj);
-        msg.add(h1, objectName);
+        histograms.emplace_back(objectName, h1);
       } else if (objectClass->InheritsFrom(TDirectory::Class())) {
         auto* tdir = dynamic_cast<TDirectory*>(obj);
         // FIXME: Currently the dqm server does not understand multi-layer directory structures
         // therefore I break this down to only show the last directory
-        streamHistogramImpl(tdir, msg, obj->GetName());
+        collectHistogramsImpl(tdir, histograms, obj->GetName());
       }
     }
   }
+
+  void streamHistogramImpl(TDirectory* curdir, Belle2::MsgHandler& msg)
+  {
+    std::vector<std::pair<std::string, TH1*>> histograms;
+    collectHistogramsImpl(curdir, histograms);
+    for (const auto& [objectName, histogram] : histograms) {
+      msg.add(histogram, objectName);
+    }
+  }
 }
 
-void HLTStreamHelper::initialize()
+void HLTStreamHelper::initialize(unsigned int decodingThreads)
 {
-  m_streamHelper.initialize(0, true);
+  m_streamHelper.initialize(0, true, decodingThreads);
 }
 
 void HLTStreamHelper::registerStoreObjects(bool addExpressRecoObjects)
@@ -185,126 +196,209 @@ std::unique_ptr<ZMQNoIdMessage> HLTStreamHelper::streamHistograms(bool compresse
                                                   std::move(message), std::move(additionalEventMessage));
 }
 
+std::unique_ptr<ZMQNoIdMessage> HLTStreamHelper::streamHistogramChanges(unsigned int fullStreamInterval)
+{
+  B2ASSERT("Event Meta Data not set!", m_eventMetaData.isValid());
+
+  std::vector<std::pair<std::string, TH1*>> histograms;
+  collectHistogramsImpl(gDirectory, histograms);
+
+  bool sendFull = m_sentHistograms.empty() or histograms.size() != m_sentHistograms.size() or
+                  (fullStreamInterval > 0 and m_numberOfChangeStreamings >= fullStreamInterval);
+  for (const auto& [objectName, histogram] : histograms) {
+    if (sendFull) {
+      break;
+    }
+    auto sentIterator = m_sentHistograms.find(objectName);
+    sendFull = sentIterator == m_sentHistograms.end() or not HistogramDelta::isCompatible(*histogram, *sentIterator->second);
+  }
+
+  if (sendFull) {
+    // Remember the state of all histograms. The copies must not end up in the streamed directory.
+    m_sentHistograms.clear();
+    for (const auto& [objectName, histogram] : histograms) {
+      auto* copiedHistogram = dynamic_cast<TH1*>(histogram->Clone());
+      copiedHistogram->SetDirectory(nullptr);
+      m_sentHistograms[objectName].reset(copiedHistogram);
+    }
+    m_numberOfChangeStreamings = 0;
+    return streamHistograms();
+  }
+
+  HistogramDelta delta;
+  for (const auto& [objectName, histogram] : histograms) {
+    delta.add(objectName, histogram, m_sentHistograms[objectName].get());
+  }
+  // Bring the remembered state up to date with the same arithmetic as the receiver
+  delta.apply([this](const std::string & objectName) { return m_sentHistograms[objectName].get(); });
+  m_numberOfChangeStreamings++;
+
+  if (m_outputBuffer.empty()) {
+    m_outputBuffer.resize(m_maximalCompressedSize, 0);
+  }
+
+  B2DEBUG(10, "Size of the changes of " << delta.getNumberOfHistograms() << " histograms before compression " << delta.size());
+  int size = m_maximalCompressedSize;
+  size = LZ4_compress_default(delta.data(), &m_outputBuffer[0], delta.size(), size);
+  B2ASSERT("Compression failed", size > 0);
+  B2DEBUG(10, "Size after compression " << size);
+
+  zmq::message_t message(&m_outputBuffer[0], size);
+
+  EventMetaData& eventMetaData = *m_eventMetaData;
+  auto eventInformationString = TBufferJSON::ToJSON(&eventMetaData);
+  zmq::message_t additionalEventMessage(eventInformationString.Data(), eventInformationString.Length());
+
+  return Belle2::ZMQMessageFactory::createMessage(Belle2::EMessageTypes::c_compressedDeltaMessage,
+                                                  std::move(message), std::move(additionalEventMessage));
+}
+
+void HLTStreamHelper::resetHistogramChanges()
+{
+  m_sentHistograms.clear();
+  m_numberOfChangeStreamings = 0;
+}
+
 void HLTStreamHelper::read(std::unique_ptr<ZMQNoIdMessage> message)
 {
   if (message->isMessage(EMessageTypes::c_eventMessage)) {
     m_streamHelper.read(std::move(message));
   } else if (message->isMessage(EMessageTypes::c_rawDataMessage)) {
-    int* eventBuffer = message->getMessagePart<1>().data<int>();
-
-    SendHeader sndhdr;
-    sndhdr.SetBuffer(eventBuffer);
-    int npackedevts = sndhdr.GetNumEventsinPacket();
-    if (npackedevts != 1) {
-      B2WARNING("Strange SendHeader : ");
-      //    for (int i = 0; i < sndhdr.SENDHDR_NWORDS; i++) {
-      for (int i = 0; i < 10; i++) {
-        B2WARNING(std::hex << * (sndhdr.GetBuffer() + i));
-      }
+    readRawData(*message);
+  }
+}
 
-      B2WARNING("Raw2DsModule::number of events in packet is not 1. This process gets stuck here. Please ABORT the system. (Please see discussion of daqcore channel in https://b2rc.kek.jp/ on 2017. Nov. 30. about why this is not FATAL message.");
-      sleep(86400);
-    }
-    int ncprs = sndhdr.GetNumNodesinPacket();
-    int nwords = sndhdr.GetTotalNwords() - SendHeader::SENDHDR_NWORDS - SendTrailer::SENDTRL_NWORDS;
-
-    // Get buffer header
-    int* bufbody = eventBuffer + SendHeader::SENDHDR_NWORDS;
-
-    // Unpack buffer
-    RawDataBlock tempdblk;
-    tempdblk.SetBuffer(bufbody, nwords, false, npackedevts, ncprs);
-
-    unsigned int utime = 0;
-    unsigned int ctime = 0;
-    unsigned long long int mtime = 0;
-
-    int store_time_flag = 0;
-    unsigned int error_flag = 0;
-
-    // Store data contents in Corresponding RawXXXX
-    for (int cprid = 0; cprid < ncprs * npackedevts; cprid++) {
-      // Pick up one COPPER and copy data in a temporary buffer
-      int nwds_buf = tempdblk.GetBlockNwords(cprid);
-      int* cprbuf = new int[nwds_buf];
-      memcpy(cprbuf, tempdblk.GetBuffer(cprid), nwds_buf * 4);
-
-      // Check FTSW
-      if (tempdblk.CheckFTSWID(cprid)) {
-        RawFTSW* ftsw = m_rawFTSWs.appendNew();
-        ftsw->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
-
-        // Tentative for DESY TB 2017
-        utime = (unsigned int)(ftsw->GetTTUtime(0));
-        ctime = (unsigned int)(ftsw->GetTTCtime(0));
-        mtime = 1000000000 * (unsigned long long int)utime + (unsigned long long int)(std::round(ctime / 0.127216));
-        store_time_flag = 1;
-        continue;
-      } else if (store_time_flag == 0) {
-        // Tentative until RawFTSW data stream is established. 2018.5.28
-        // Not store RawCOPPER here. 2018.11.23
-        RawCOPPER tempcpr_time;
-        tempcpr_time.SetBuffer(cprbuf, nwds_buf, false, 1, 1);
-        utime = (unsigned int)(tempcpr_time.GetTTUtime(0));
-        ctime = (unsigned int)(tempcpr_time.GetTTCtime(0));
-        mtime = 1000000000 * (unsigned long long int)utime + (unsigned long long int)(std::round(ctime / 0.127216));
-        store_time_flag = 1;
-      }
+void HLTStreamHelper::queue(std::unique_ptr<ZMQNoIdMessage> message)
+{
+  m_streamHelper.queue(std::move(message));
+}
 
-      RawCOPPER tempcpr;
-      tempcpr.SetBuffer(cprbuf, nwds_buf, false, 1, 1);
-      int subsysid = tempcpr.GetNodeID(0);
-      error_flag |= (unsigned int)(tempcpr.GetDataType(0));
-
-      // Switch to each detector and register RawXXX
-      if ((subsysid & DETECTOR_MASK) == CDC_ID) {
-        (m_rawCDCs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
-      } else if ((subsysid & DETECTOR_MASK) == SVD_ID) {
-        (m_rawSVDs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
-      } else if ((subsysid & DETECTOR_MASK) == BECL_ID) {
-        (m_rawECLs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
-      } else if ((subsysid & DETECTOR_MASK) == EECL_ID) {
-        (m_rawECLs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
-      } else if ((subsysid & DETECTOR_MASK) == TOP_ID) {
-        (m_rawTOPs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
-      } else if ((subsysid & DETECTOR_MASK) == ARICH_ID) {
-        (m_rawARICHs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
-      } else if ((subsysid & DETECTOR_MASK) == BKLM_ID) {
-        (m_rawKLMs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
-      } else if ((subsysid & DETECTOR_MASK) == EKLM_ID) {
-        (m_rawKLMs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
-      } else if (((subsysid & DETECTOR_MASK) & 0xF0000000) == TRGDATA_ID) {
-        (m_rawTRGs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
-      } else {
-        // Do not store Unknown RawCOPPER object. 2018.11.25
-        B2WARNING("Unknown COPPER ID : ");
-        for (int i = 0; i < 12; i++) {
-          B2WARNING(std::hex << cprbuf[i]);
-        }
-        B2FATAL("Unknown COPPER ID is found. CPRID = " << std::hex << subsysid << " Please check. Exiting...");
-      }
+std::unique_ptr<ZMQNoIdMessage> HLTStreamHelper::readQueued()
+{
+  // event messages are already restored by the framework helper, raw data is unpacked here
+  auto message = m_streamHelper.readQueued();
+  if (message->isMessage(EMessageTypes::c_rawDataMessage)) {
+    readRawData(*message);
+  }
+  return message;
+}
+
+void HLTStreamHelper::readRawData(ZMQNoIdMessage& message)
+{
+  int* eventBuffer = message.getMessagePart<1>().data<int>();
+
+  SendHeader sndhdr;
+  sndhdr.SetBuffer(eventBuffer);
+  int npackedevts = sndhdr.GetNumEventsinPacket();
+  if (npackedevts != 1) {
+    B2WARNING("Strange SendHeader : ");
+    //    for (int i = 0; i < sndhdr.SENDHDR_NWORDS; i++) {
+    for (int i = 0; i < 10; i++) {
+      B2WARNING(std::hex << * (sndhdr.GetBuffer() + i));
     }
 
-    if (store_time_flag != 1) {
-      B2FATAL("No time information could be extracted from Data. That should not happen. Exiting...");
+    B2WARNING("Raw2DsModule::number of events in packet is not 1. This process gets stuck here. Please ABORT the system. (Please see discussion of daqcore channel in https://b2rc.kek.jp/ on 2017. Nov. 30. about why this is not FATAL message.");
+    sleep(86400);
+  }
+  int ncprs = sndhdr.GetNumNodesinPacket();
+  int nwords = sndhdr.GetTotalNwords() - SendHeader::SENDHDR_NWORDS - SendTrailer::SENDTRL_NWORDS;
+
+  // Get buffer header
+  int* bufbody = eventBuffer + SendHeader::SENDHDR_NWORDS;
+
+  // Unpack buffer
+  RawDataBlock tempdblk;
+  tempdblk.SetBuffer(bufbody, nwords, false, npackedevts, ncprs);
+
+  unsigned int utime = 0;
+  unsigned int ctime = 0;
+  unsigned long long int mtime = 0;
+
+  int store_time_flag = 0;
+  unsigned int error_flag = 0;
+
+  // Store data contents in Corresponding RawXXXX
+  for (int cprid = 0; cprid < ncprs * npackedevts; cprid++) {
+    // Pick up one COPPER and copy data in a temporary buffer
+    int nwds_buf = tempdblk.GetBlockNwords(cprid);
+    int* cprbuf = new int[nwds_buf];
+    memcpy(cprbuf, tempdblk.GetBuffer(cprid), nwds_buf * 4);
+
+    // Check FTSW
+    if (tempdblk.CheckFTSWID(cprid)) {
+      RawFTSW* ftsw = m_rawFTSWs.appendNew();
+      ftsw->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
+
+      // Tentative for DESY TB 2017
+      utime = (unsigned int)(ftsw->GetTTUtime(0));
+      ctime = (unsigned int)(ftsw->GetTTCtime(0));
+      mtime = 1000000000 * (unsigned long long int)utime + (unsigned long long int)(std::round(ctime / 0.127216));
+      store_time_flag = 1;
+      continue;
+    } else if (store_time_flag == 0) {
+      // Tentative until RawFTSW data stream is established. 2018.5.28
+      // Not store RawCOPPER here. 2018.11.23
+      RawCOPPER tempcpr_time;
+      tempcpr_time.SetBuffer(cprbuf, nwds_buf, false, 1, 1);
+      utime = (unsigned int)(tempcpr_time.GetTTUtime(0));
+      ctime = (unsigned int)(tempcpr_time.GetTTCtime(0));
+      mtime = 1000000000 * (unsigned long long int)utime + (unsigned long long int)(std::round(ctime / 0.127216));
+      store_time_flag = 1;
     }
 
-    m_eventMetaData.create();
-    m_eventMetaData->setExperiment(sndhdr.GetExpNum());
-    m_eventMetaData->setRun(sndhdr.GetRunNum());
-    m_eventMetaData->setSubrun(sndhdr.GetSubRunNum());
-    m_eventMetaData->setEvent(sndhdr.GetEventNumber());
-    m_eventMetaData->setTime(mtime);
-
-    if (error_flag) {
-      if (error_flag & RawHeader_latest::B2LINK_PACKET_CRC_ERROR) {
-        m_eventMetaData->addErrorFlag(EventMetaData::c_B2LinkPacketCRCError);
-        B2WARNING("Raw2Ds: c_B2LinkPacketCRCError flag was set in EventMetaData.");
-      }
-      if (error_flag & RawHeader_latest::B2LINK_EVENT_CRC_ERROR) {
-        m_eventMetaData->addErrorFlag(EventMetaData::c_B2LinkEventCRCError);
-        B2WARNING("Raw2Ds: c_B2LinkEventCRCError flag was set in EventMetaData.");
+    RawCOPPER tempcpr;
+    tempcpr.SetBuffer(cprbuf, nwds_buf, false, 1, 1);
+    int subsysid = tempcpr.GetNodeID(0);
+    error_flag |= (unsigned int)(tempcpr.GetDataType(0));
+
+    // Switch to each detector and register RawXXX
+    if ((subsysid & DETECTOR_MASK) == CDC_ID) {
+      (m_rawCDCs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
+    } else if ((subsysid & DETECTOR_MASK) == SVD_ID) {
+      (m_rawSVDs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
+    } else if ((subsysid & DETECTOR_MASK) == BECL_ID) {
+      (m_rawECLs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
+    } else if ((subsysid & DETECTOR_MASK) == EECL_ID) {
+      (m_rawECLs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
+    } else if ((subsysid & DETECTOR_MASK) == TOP_ID) {
+      (m_rawTOPs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
+    } else if ((subsysid & DETECTOR_MASK) == ARICH_ID) {
+      (m_rawARICHs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
+    } else if ((subsysid & DETECTOR_MASK) == BKLM_ID) {
+      (m_rawKLMs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
+    } else if ((subsysid & DETECTOR_MASK) == EKLM_ID) {
+      (m_rawKLMs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
+    } else if (((subsysid & DETECTOR_MASK) & 0xF0000000) == TRGDATA_ID) {
+      (m_rawTRGs.appendNew())->SetBuffer(cprbuf, nwds_buf, 1, 1, 1);
+    } else {
+      // Do not store Unknown RawCOPPER object. 2018.11.25
+      B2WARNING("Unknown COPPER ID : ");
+      for (int i = 0; i < 12; i++) {
+        B2WARNING(std::hex << cprbuf[i]);
       }
+      B2FATAL("Unknown COPPER ID is found. CPRID = " << std::hex << subsysid << " Please check. Exiting...");
+    }
+  }
+
+  if (store_time_flag != 1) {
+    B2FATAL("No time information could be extracted from Data. That should not happen. Exiting...");
+  }
+
+  m_eventMetaData.create();
+  m_eventMetaData->setExperiment(sndhdr.GetExpNum());
+  m_eventMetaData->setRun(sndhdr.GetRunNum());
+  m_eventMetaData->setSubrun(sndhdr.GetSubRunNum());
+  m_eventMetaData->setEvent(sndhdr.GetEventNumber());
+  m_eventMetaData->setTime(mtime);
+
+  if (error_flag) {
+    if (error_flag & RawHeader_latest::B2LINK_PACKET_CRC_ERROR) {
+      m_eventMetaData->addErrorFlag(EventMetaData::c_B2LinkPacketCRCError);
+      B2WARNING("Raw2Ds: c_B2LinkPacketCRCError flag was set in EventMetaData.");
+    }
+    if (error_flag & RawHeader_latest::B2LINK_EVENT_CRC_ERROR) {
+      m_eventMetaData->addErrorFlag(EventMetaData::c_B2LinkEventCRCError);
+      B2WARNING("Raw2Ds: c_B2LinkEventCRCError flag was set in EventMetaData.");
     }
   }
 }
@@ -0,0 +1,385 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <daq/hbasf2/utils/HistogramDelta.h>
+
+#include <framework/logging/Logger.h>
+
+#include <TArray.h>
+#include <TArrayD.h>
+#include <TAxis.h>
+#include <TProfile.h>
+#include <TProfile2D.h>
+#include <TProfile3D.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+using namespace Belle2;
+
+namespace {
+  /// The buffer contains the sum of squared weights of each cell
+  constexpr uint32_t c_hasSumw2 = 1;
+  /// The buffer contains the bin entries of each cell (profiles)
+  constexpr uint32_t c_hasBinEntries = 2;
+  /// The buffer contains the sum of squared weights of the bin entries of each cell (profiles)
+  constexpr uint32_t c_hasBinSumw2 = 4;
+
+  /// Append a value to the buffer
+  template<class T>
+  void write(std::vector<char>& buffer, const T& value)
+  {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  /// Read a value from the buffer and advance the position (the buffer needs to be checked before)
+  template<class T>
+  T read(const char*& position)
+  {
+    T value;
+    memcpy(&value, position, sizeof(T));
+    position += sizeof(T);
+    return value;
+  }
+
+  /// Read a value from the buffer and advance the position, returns false if the rest of the buffer is too short
+  template<class T>
+  bool readChecked(const char*& position, const char* end, T& value)
+  {
+    if (static_cast<size_t>(end - position) < sizeof(T)) {
+      return false;
+    }
+    value = read<T>(position);
+    return true;
+  }
+
+  /// Advance the position by the given size, returns false if the rest of the buffer is too short
+  bool skipChecked(const char*& position, const char* end, size_t size)
+  {
+    if (static_cast<size_t>(end - position) < size) {
+      return false;
+    }
+    position += size;
+    return true;
+  }
+
+  /// Direct access to the per-cell arrays of a histogram (without changing the statistics)
+  struct CellArrays {
+    /// Content of the cells (for profiles: sum of weight * y)
+    TArray* content = nullptr;
+    /// Sum of squared weights (for profiles: sum of weight * y^2), nullptr if not stored
+    TArrayD* sumw2 = nullptr;
+    /// Bin entries of profiles, nullptr for other histograms
+    double* binEntries = nullptr;
+    /// Sum of squared weights of the bin entries of profiles, nullptr if not stored
+    double* binSumw2 = nullptr;
+
+    /// Fill the arrays of the given histogram
+    explicit CellArrays(const TH1& constHistogram)
+    {
+      // The profile getters are not const, but we only read through them for const histograms
+      TH1& histogram = const_cast<TH1&>(constHistogram);
+      content = dynamic_cast<TArray*>(&histogram);
+      if (histogram.GetSumw2N() > 0) {
+        sumw2 = histogram.GetSumw2();
+      }
+      if (auto* profile = dynamic_cast<TProfile*>(&histogram)) {
+        binEntries = profile->GetB();
+        binSumw2 = profile->GetB2();
+      } else if (auto* profile2D = dynamic_cast<TProfile2D*>(&histogram)) {
+        binEntries = profile2D->GetB();
+        binSumw2 = profile2D->GetB2();
+      } else if (auto* profile3D = dynamic_cast<TProfile3D*>(&histogram)) {
+        binEntries = profile3D->GetB();
+        binSumw2 = profile3D->GetB2();
+      }
+    }
+
+    /// Content of the cell
+    double getContent(int cell) const { return content->GetAt(cell); }
+    /// Sum of squared weights of the cell (the content if not stored, which is correct for unit weights)
+    double getSumw2(int cell) const { return sumw2 ? sumw2->GetAt(cell) : getContent(cell); }
+    /// Bin entries of the cell
+    double getBinEntries(int cell) const { return binEntries[cell]; }
+    /// Sum of squared weights of the bin entries of the cell (the bin entries if not stored)
+    double getBinSumw2(int cell) const { return binSumw2 ? binSumw2[cell] : getBinEntries(cell); }
+  };
+
+  /// Values of one cell (in the order they are stored in the buffer)
+  void getCellValues(const CellArrays* arrays, int cell, uint32_t flags, double* values)
+  {
+    unsigned int index = 0;
+    values[index++] = arrays ? arrays->getContent(cell) : 0;
+    if (flags & c_hasSumw2) {
+      values[index++] = arrays ? arrays->getSumw2(cell) : 0;
+    }
+    if (flags & c_hasBinEntries) {
+      values[index++] = arrays ? arrays->getBinEntries(cell) : 0;
+    }
+    if (flags & c_hasBinSumw2) {
+      values[index++] = arrays ? arrays->getBinSumw2(cell) : 0;
+    }
+  }
+
+  /// Do both axes have the same bins (number, limits and variable bin edges)?
+  bool haveSameBinning(const TAxis& first, const TAxis& second)
+  {
+    if (first.GetNbins() != second.GetNbins() or first.GetXmin() != second.GetXmin() or first.GetXmax() != second.GetXmax()) {
+      return false;
+    }
+    const TArrayD& firstEdges = *first.GetXbins();
+    const TArrayD& secondEdges = *second.GetXbins();
+    if (firstEdges.GetSize() != secondEdges.GetSize()) {
+      return false;
+    }
+    for (int i = 0; i < firstEdges.GetSize(); i++) {
+      if (firstEdges.GetAt(i) != secondEdges.GetAt(i)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Number of values stored per cell
+  unsigned int getNumberOfCellValues(uint32_t flags)
+  {
+    return 1 + ((flags & c_hasSumw2) ? 1 : 0) + ((flags & c_hasBinEntries) ? 1 : 0) + ((flags & c_hasBinSumw2) ? 1 : 0);
+  }
+}
+
+HistogramDelta::HistogramDelta()
+{
+  write(m_buffer, static_cast<uint32_t>(0));
+}
+
+HistogramDelta::HistogramDelta(const char* buffer, size_t size) : m_buffer(buffer, buffer + size)
+{
+  m_valid = checkBuffer();
+  if (m_valid) {
+    const char* position = m_buffer.data();
+    m_numberOfHistograms = read<uint32_t>(position);
+  }
+}
+
+bool HistogramDelta::checkBuffer() const
+{
+  const char* position = m_buffer.data();
+  const char* end = m_buffer.data() + m_buffer.size();
+  uint32_t numberOfHistograms = 0;
+  if (not readChecked(position, end, numberOfHistograms)) {
+    return false;
+  }
+
+  for (uint32_t histogramIndex = 0; histogramIndex < numberOfHistograms; histogramIndex++) {
+    uint32_t nameLength = 0;
+    uint32_t numberOfCells = 0;
+    uint32_t flags = 0;
+    uint32_t numberOfChangedCells = 0;
+    if (not readChecked(position, end, nameLength) or not skipChecked(position, end, nameLength) or
+        not readChecked(position, end, numberOfCells) or not readChecked(position, end, flags)) {
+      return false;
+    }
+    if ((flags & ~(c_hasSumw2 | c_hasBinEntries | c_hasBinSumw2)) != 0) {
+      return false;
+    }
+    // entries and statistics
+    if (not skipChecked(position, end, (1 + TH1::kNstat) * sizeof(double)) or
+        not readChecked(position, end, numberOfChangedCells)) {
+      return false;
+    }
+    const size_t sizeOfCellValues = getNumberOfCellValues(flags) * sizeof(double);
+    if (numberOfChangedCells > static_cast<size_t>(end - position) / (sizeof(uint32_t) + sizeOfCellValues)) {
+      return false;
+    }
+    for (uint32_t i = 0; i < numberOfChangedCells; i++) {
+      const auto cell = read<uint32_t>(position);
+      if (cell >= numberOfCells) {
+        return false;
+      }
+      position += sizeOfCellValues;
+    }
+  }
+
+  return position == end;
+}
+
+bool HistogramDelta::isCompatible(const TH1& current, const TH1& previous)
+{
+  return current.IsA() == previous.IsA() and current.GetNcells() == previous.GetNcells() and
+         dynamic_cast<const TArray*>(&current) != nullptr and
+         haveSameBinning(*current.GetXaxis(), *previous.GetXaxis()) and
+         haveSameBinning(*current.GetYaxis(), *previous.GetYaxis()) and
+         haveSameBinning(*current.GetZaxis(), *previous.GetZaxis());
+}
+
+bool HistogramDelta::add(const std::string& name, const TH1* current, const TH1* previous)
+{
+  B2ASSERT("At least one histogram needs to be given", current or previous);
+  B2ASSERT("Histograms need to be compatible", not(current and previous) or isCompatible(*current, *previous));
+
+  const TH1& reference = current ? *current : *previous;
+  const int numberOfCells = reference.GetNcells();
+
+  std::unique_ptr<CellArrays> currentArrays;
+  std::unique_ptr<CellArrays> previousArrays;
+  if (current) {
+    currentArrays.reset(new CellArrays(*current));
+  }
+  if (previous) {
+    previousArrays.reset(new CellArrays(*previous));
+  }
+  const CellArrays& referenceArrays = currentArrays ? *currentArrays : *previousArrays;
+  B2ASSERT("Histogram " << name << " has no cell array", referenceArrays.content);
+
+  uint32_t flags = 0;
+  if ((currentArrays and currentArrays->sumw2) or (previousArrays and previousArrays->sumw2)) {
+    flags |= c_hasSumw2;
+  }
+  if (referenceArrays.binEntries) {
+    flags |= c_hasBinEntries;
+    if ((currentArrays and currentArrays->binSumw2) or (previousArrays and previousArrays->binSumw2)) {
+      flags |= c_hasBinSumw2;
+    }
+  }
+  const unsigned int numberOfCellValues = getNumberOfCellValues(flags);
+
+  double currentStats[TH1::kNstat] = {0};
+  double previousStats[TH1::kNstat] = {0};
+  double currentEntries = 0;
+  double previousEntries = 0;
+  if (current) {
+    current->GetStats(currentStats);
+    currentEntries = current->GetEntries();
+  }
+  if (previous) {
+    previous->GetStats(previousStats);
+    previousEntries = previous->GetEntries();
+  }
+
+  // Write the header of this histogram, the number of changed cells is filled in afterwards
+  const size_t startOfRecord = m_buffer.size();
+  write(m_buffer, static_cast<uint32_t>(name.size()));
+  m_buffer.insert(m_buffer.end(), name.begin(), name.end());
+  write(m_buffer, static_cast<uint32_t>(numberOfCells));
+  write(m_buffer, flags);
+  write(m_buffer, currentEntries - previousEntries);
+  bool statsChanged = currentEntries != previousEntries;
+  for (int i = 0; i < TH1::kNstat; i++) {
+    write(m_buffer, currentStats[i] - previousStats[i]);
+    statsChanged |= currentStats[i] != previousStats[i];
+  }
+  const size_t positionOfNumberOfChangedCells = m_buffer.size();
+  write(m_buffer, static_cast<uint32_t>(0));
+
+  uint32_t numberOfChangedCells = 0;
+  double currentValues[4];
+  double previousValues[4];
+  for (int cell = 0; cell < numberOfCells; cell++) {
+    getCellValues(currentArrays.get(), cell, flags, currentValues);
+    getCellValues(previousArrays.get(), cell, flags, previousValues);
+    if (memcmp(currentValues, previousValues, numberOfCellValues * sizeof(double)) == 0) {
+      continue;
+    }
+
+    write(m_buffer, static_cast<uint32_t>(cell));
+    for (unsigned int i = 0; i < numberOfCellValues; i++) {
+      write(m_buffer, currentValues[i] - previousValues[i]);
+    }
+    numberOfChangedCells++;
+  }
+
+  if (numberOfChangedCells == 0 and not statsChanged) {
+    m_buffer.resize(startOfRecord);
+    return false;
+  }
+
+  memcpy(&m_buffer[positionOfNumberOfChangedCells], &numberOfChangedCells, sizeof(uint32_t));
+  m_numberOfHistograms++;
+  memcpy(&m_buffer[0], &m_numberOfHistograms, sizeof(uint32_t));
+  return true;
+}
+
+unsigned int HistogramDelta::apply(const std::function<TH1*(const std::string&)>& getHistogram) const
+{
+  if (not m_valid) {
+    B2ERROR("The histogram changes are not applied, as their buffer is invalid");
+    return 1;
+  }
+
+  const char* position = m_buffer.data();
+  const auto numberOfHistograms = read<uint32_t>(position);
+
+  unsigned int skippedHistograms = 0;
+  for (uint32_t histogramIndex = 0; histogramIndex < numberOfHistograms; histogramIndex++) {
+    const auto nameLength = read<uint32_t>(position);
+    const std::string name(position, nameLength);
+    position += nameLength;
+
+    const auto numberOfCells = read<uint32_t>(position);
+    const auto flags = read<uint32_t>(position);
+    const auto entries = read<double>(position);
+    double stats[TH1::kNstat];
+    for (int i = 0; i < TH1::kNstat; i++) {
+      stats[i] = read<double>(position);
+    }
+    const auto numberOfChangedCells = read<uint32_t>(position);
+    const unsigned int numberOfCellValues = getNumberOfCellValues(flags);
+    const size_t sizeOfCells = numberOfChangedCells * (sizeof(uint32_t) + numberOfCellValues * sizeof(double));
+
+    TH1* histogram = getHistogram(name);
+    if (not histogram or histogram->GetNcells() != static_cast<int>(numberOfCells)) {
+      B2DEBUG(10, "Can not apply the changes of histogram " << name);
+      skippedHistograms++;
+      position += sizeOfCells;
+      continue;
+    }
+
+    // The statistics are read before changing the cells, as ROOT may recompute them from the cells
+    double histogramStats[TH1::kNstat] = {0};
+    histogram->GetStats(histogramStats);
+    const double histogramEntries = histogram->GetEntries();
+
+    if ((flags & c_hasSumw2) and histogram->GetSumw2N() == 0) {
+      histogram->Sumw2();
+    }
+    if ((flags & c_hasBinSumw2) and not CellArrays(*histogram).binSumw2) {
+      histogram->Sumw2();
+    }
+    const CellArrays arrays(*histogram);
+    if (not arrays.content or ((flags & c_hasBinEntries) and not arrays.binEntries) or
+        ((flags & c_hasBinSumw2) and not arrays.binSumw2)) {
+      B2DEBUG(10, "Histogram " << name << " does not match the stored changes");
+      skippedHistograms++;
+      position += sizeOfCells;
+      continue;
+    }
+
+    for (uint32_t i = 0; i < numberOfChangedCells; i++) {
+      const auto cell = read<uint32_t>(position);
+      arrays.content->SetAt(arrays.content->GetAt(cell) + read<double>(position), cell);
+      if (flags & c_hasSumw2) {
+        arrays.sumw2->fArray[cell] += read<double>(position);
+      }
+      if (flags & c_hasBinEntries) {
+        arrays.binEntries[cell] += read<double>(position);
+      }
+      if (flags & c_hasBinSumw2) {
+        arrays.binSumw2[cell] += read<double>(position);
+      }
+    }
+
+    for (int i = 0; i < TH1::kNstat; i++) {
+      histogramStats[i] += stats[i];
+    }
+    histogram->PutStats(histogramStats);
+    histogram->SetEntries(histogramEntries + entries);
+  }
+
+  return skippedHistograms;
+}
@@ -53,6 +53,7 @@ void HistogramMapping::operator+=(const HistogramMapping& rhs)
     if (lhsIterator == m_histograms.end()) {
       B2DEBUG(100, "Creating new histogram with name " << key << ".");
       auto* copiedHistogram = dynamic_cast<TH1*>(histogram->Clone());
+      copiedHistogram->SetDirectory(nullptr);
       m_histograms.insert({key, std::unique_ptr<TH1>(copiedHistogram)});
     } else {
       m_histograms[key]->Add(histogram.get());
@@ -60,10 +61,55 @@ void HistogramMapping::operator+=(const HistogramMapping& rhs)
   }
 }
 
+bool HistogramMapping::update(const HistogramMapping& previous, const HistogramMapping& current)
+{
+  HistogramDelta delta;
+
+  for (const auto& [key, histogram] : current.m_histograms) {
+    auto previousIterator = previous.m_histograms.find(key);
+    const TH1* previousHistogram = previousIterator != previous.m_histograms.end() ? previousIterator->second.get() : nullptr;
+
+    auto lhsIterator = m_histograms.find(key);
+    if (lhsIterator == m_histograms.end()) {
+      if (previousHistogram) {
+        // the previous contribution should be part of the sum already
+        return false;
+      }
+      B2DEBUG(100, "Creating new histogram with name " << key << ".");
+      auto* copiedHistogram = dynamic_cast<TH1*>(histogram->Clone());
+      copiedHistogram->SetDirectory(nullptr);
+      m_histograms.insert({key, std::unique_ptr<TH1>(copiedHistogram)});
+      continue;
+    }
+
+    if (not HistogramDelta::isCompatible(*histogram, *lhsIterator->second) or
+        (previousHistogram and not HistogramDelta::isCompatible(*histogram, *previousHistogram))) {
+      return false;
+    }
+    delta.add(key, histogram.get(), previousHistogram);
+  }
+
+  for (const auto& [key, previousHistogram] : previous.m_histograms) {
+    if (current.m_histograms.find(key) == current.m_histograms.end()) {
+      delta.add(key, nullptr, previousHistogram.get());
+    }
+  }
+
+  return applyDelta(delta) == 0;
+}
+
+unsigned int HistogramMapping::applyDelta(const HistogramDelta& delta)
+{
+  return delta.apply([this](const std::string & key) -> TH1* {
+    auto iterator = m_histograms.find(key);
+    return iterator != m_histograms.end() ? iterator->second.get() : nullptr;
+  });
+}
+
 void HistogramMapping::write() const
 {
+  // Write the histograms without attaching them to the directory, as they are still owned by us
   for (const auto& [key, histogram] : m_histograms) {
-    histogram->SetDirectory(gDirectory);
     histogram->Write();
   }
 }
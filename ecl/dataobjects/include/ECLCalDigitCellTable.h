@@ -0,0 +1,119 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#pragma once
+
+#include <ecl/dataobjects/ECLCalDigit.h>
+
+#include <framework/dataobjects/EventMetaData.h>
+#include <framework/datastore/StoreArray.h>
+#include <framework/logging/Logger.h>
+
+#include <TObject.h>
+
+#include <vector>
+
+namespace Belle2 {
+
+  /*! Table of the ECLCalDigits of the current event indexed by cell id.
+   *
+   *  The clustering modules look up the digits of neighbouring cells many times per event. The table provides
+   *  the store array position, energy and time of the digit in each cell without searching the store array.
+   *  It is kept with persistent durability, such that its vectors are allocated only once, and it is refilled
+   *  by the first clustering module of each event and shared with the following ones. It is not written out.
+   */
+
+  class ECLCalDigitCellTable : public TObject {
+  public:
+
+    /** Number of ECL CellId */
+    static constexpr int c_nECLCellIds = 8736;
+
+    /**
+    * Default constructor.
+    */
+    ECLCalDigitCellTable() :
+      m_storeArrayPosition(c_nECLCellIds + 1, -1),
+      m_energy(c_nECLCellIds + 1, 0.0),
+      m_time(c_nECLCellIds + 1, 0.0)
+    {
+    }
+
+    /** Fill the table from the given digits of the given event, replacing the previous content */
+    void fill(const StoreArray<ECLCalDigit>& eclCalDigits, const EventMetaData& eventMetaData)
+    {
+      for (const int cellid : m_cellIds) {
+        m_storeArrayPosition[cellid] = -1;
+        m_energy[cellid] = 0.0;
+        m_time[cellid] = 0.0;
+      }
+      m_cellIds.clear();
+
+      const int nDigits = eclCalDigits.getEntries();
+      m_cellIds.reserve(nDigits);
+      for (int i = 0; i < nDigits; i++) {
+        const ECLCalDigit* digit = eclCalDigits[i];
+        const int cellid = digit->getCellId();
+        if (cellid < 1 or cellid > c_nECLCellIds) {
+          B2ERROR("Cell Id " << cellid << " does not exist.");
+          continue;
+        }
+        m_storeArrayPosition[cellid] = i;
+        m_energy[cellid] = digit->getEnergy();
+        m_time[cellid] = digit->getTime();
+        m_cellIds.push_back(cellid);
+      }
+      m_arrayName = eclCalDigits.getName();
+      m_nDigits = nDigits;
+      m_eventMetaData = eventMetaData;
+    }
+
+    /** Check whether the table has been filled from the given digits of the given event in their current state */
+    bool isFilledFrom(const StoreArray<ECLCalDigit>& eclCalDigits, const EventMetaData& eventMetaData) const
+    {
+      return m_nDigits == eclCalDigits.getEntries() and m_eventMetaData == eventMetaData and m_arrayName == eclCalDigits.getName();
+    }
+
+    /** Get store array position of the digit in the cell, -1 if there is none (no range check) */
+    int getStoreArrayPosition(const int cellid) const { return m_storeArrayPosition[cellid]; }
+
+    /** Get energy of the digit in the cell, 0 if there is none (no range check) */
+    double getEnergy(const int cellid) const { return m_energy[cellid]; }
+
+    /** Get time of the digit in the cell, 0 if there is none (no range check) */
+    double getTime(const int cellid) const { return m_time[cellid]; }
+
+    /** Get the cell ids of all digits in store array order */
+    const std::vector<int>& getCellIds() const { return m_cellIds; }
+
+  private:
+
+    /** vector (8736+1 entries) with cell id to store array positions */
+    std::vector<int> m_storeArrayPosition; //!
+
+    /** vector (8736+1 entries) with cell id to digit energy */
+    std::vector<double> m_energy; //!
+
+    /** vector (8736+1 entries) with cell id to digit time */
+    std::vector<double> m_time; //!
+
+    /** cell ids of all digits in store array order */
+    std::vector<int> m_cellIds; //!
+
+    /** name of the store array the table was filled from */
+    std::string m_arrayName; //!
+
+    /** number of digits the table was filled from, -1 if not filled */
+    int m_nDigits = -1; //!
+
+    /** event the table was filled from */
+    EventMetaData m_eventMetaData; //!
+
+    ClassDef(ECLCalDigitCellTable, 1); /**< ClassDef */
+  };
+
+} // end namespace Belle2
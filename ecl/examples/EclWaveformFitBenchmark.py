@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+
+"""Runs the offline waveform fit twice on recorded waveforms, first with Minuit
+   and then with the analytic amplitude solution, compares the fit results and
+   prints the execution time of both fits.
+
+   Usage: basf2 EclWaveformFitBenchmark.py -i <file with ECLDsps and ECLDigits> [-- <number of threads>]
+"""
+
+import sys
+import basf2 as b2
+from ROOT import Belle2
+
+nThreads = int(sys.argv[1]) if len(sys.argv) > 1 else 1
+
+# Tolerances for the agreement of the two fits
+amplitudeTolerance = 1e-3  # relative
+timeTolerance = 0.01  # in units of the fit time parameter
+chi2Tolerance = 0.1
+
+
+class StoreFitResultsModule(b2.Module):
+
+    """Stores the fit results of all waveforms by cell id."""
+
+    def initialize(self):
+        """Initialize
+        """
+        #: waveforms
+        self.dsps = Belle2.PyStoreArray('ECLDsps')
+        #: fit results of the current event
+        self.results = {}
+
+    def event(self):
+        """Store fit type, amplitude, time and chi2 of each waveform
+        """
+        self.results = {}
+        for dsp in self.dsps:
+            self.results[dsp.getCellId()] = (dsp.getTwoComponentFitType(), dsp.getTwoComponentTotalAmp(),
+                                             dsp.getTwoComponentTime(), dsp.getTwoComponentChi2())
+
+
+class CompareFitResultsModule(b2.Module):
+
+    """Compares the fit results with the ones stored before."""
+
+    def __init__(self, reference):
+        """Constructor
+        """
+        super().__init__()
+        #: module holding the reference results
+        self.reference = reference
+
+    def initialize(self):
+        """Initialize
+        """
+        #: waveforms
+        self.dsps = Belle2.PyStoreArray('ECLDsps')
+        #: number of compared fits
+        self.nFits = 0
+        #: number of fits with a different fit type
+        self.nTypeDifferences = 0
+        #: number of fits exceeding the tolerances
+        self.nDifferences = 0
+
+    def event(self):
+        """Compare fit type, amplitude, time and chi2 of each waveform
+        """
+        for dsp in self.dsps:
+            reference = self.reference.results.get(dsp.getCellId())
+            if reference is None or reference[3] < 0:
+                continue
+            self.nFits += 1
+            fitType, amp, time, chi2 = reference
+            if dsp.getTwoComponentFitType() != fitType:
+                self.nTypeDifferences += 1
+                continue
+            if abs(dsp.getTwoComponentTotalAmp() - amp) > amplitudeTolerance * max(abs(amp), 1) or \
+               abs(dsp.getTwoComponentTime() - time) > timeTolerance or \
+               abs(dsp.getTwoComponentChi2() - chi2) > chi2Tolerance:
+                self.nDifferences += 1
+
+    def terminate(self):
+        """Print the summary
+        """
+        print('Compared fits: %d, different fit type: %d, outside tolerance: %d' %
+              (self.nFits, self.nTypeDifferences, self.nDifferences))
+
+
+mainPath = b2.create_path()
+mainPath.add_module('RootInput')
+
+minuitFit = mainPath.add_module('ECLWaveformFit', AnalyticFit=False)
+minuitFit.set_name('ECLWaveformFit_Minuit')
+reference = StoreFitResultsModule()
+mainPath.add_module(reference)
+
+analyticFit = mainPath.add_module('ECLWaveformFit', AnalyticFit=True, NumberOfThreads=nThreads)
+analyticFit.set_name('ECLWaveformFit_Analytic')
+mainPath.add_module(CompareFitResultsModule(reference))
+
+mainPath.add_module('Progress')
+b2.process(mainPath)
+print(b2.statistics)
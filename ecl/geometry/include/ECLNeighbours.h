@@ -20,6 +20,26 @@ namespace Belle2 {
 
     public:
 
+      /** Range of neighbour cids in the compressed neighbour table. */
+      class NeighbourRange {
+      public:
+        /** Constructor from the first and behind the last entry. */
+        NeighbourRange(const short int* first, const short int* last) : m_first(first), m_last(last) {}
+
+        /** Begin of the range. */
+        const short int* begin() const { return m_first; }
+
+        /** End of the range. */
+        const short int* end() const { return m_last; }
+
+        /** Number of neighbours. */
+        int size() const { return m_last - m_first; }
+
+      private:
+        const short int* m_first; /**< first neighbour */
+        const short int* m_last; /**< behind the last neighbour */
+      };
+
       /**  Constructor: Fix number of neighbours ("N") in the seed theta ring, fraction cross ("F"),  radius ("R") with par = n or par = fraction (0.1-1.0) or par = radius [cm]. */
       ECLNeighbours(const std::string& neighbourDef, const double par);
 
@@ -29,6 +49,12 @@ namespace Belle2 {
       /** Return the neighbours for a given cell ID.*/
       const std::vector<short int>& getNeighbours(short int cid) const;
 
+      /** Return the neighbours for a given cell ID from the compressed neighbour table (no range check). */
+      NeighbourRange getNeighbourRange(short int cid) const
+      {
+        return NeighbourRange(m_neighbourIds.data() + m_neighbourOffsets[cid], m_neighbourIds.data() + m_neighbourOffsets[cid + 1]);
+      }
+
       /** return number of crystals in a given theta ring */
       short int getCrystalsPerRing(const short int thetaid) const { return m_crystalsPerRing[thetaid]; }
 
@@ -39,6 +65,12 @@ namespace Belle2 {
       /** temporary list of list of neighbour cids. */
       std::vector < std::vector < short int > > m_neighbourMapTemp;
 
+      /** neighbour cids of all cells in one contiguous array (compressed sparse row format). */
+      std::vector<short int> m_neighbourIds;
+
+      /** position of the first neighbour of each cell in m_neighbourIds, one additional entry marks the end. */
+      std::vector<int> m_neighbourOffsets;
+
       /** Number of crystals in each theta ring.*/
       const short m_crystalsPerRing[69] = {
         48, 48, 64, 64, 64, 96, 96, 96, 96, 96, 96, 144, 144, //FWD up to 13
@@ -69,6 +101,9 @@ namespace Belle2 {
       /**  initialize the fractional cross neighbour list. */
       void initializeF(const double fraction);
 
+      /**  fill the compressed neighbour table from the list of list of neighbour cids. */
+      void initializeCompressed();
+
       /**  return the previous phi id. */
       short int decreasePhiId(const short int phiid, const short int thetaid, const short int n);
 
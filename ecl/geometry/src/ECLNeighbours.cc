@@ -75,6 +75,7 @@ ECLNeighbours::ECLNeighbours(const std::string& neighbourDef, const double par)
             " (valid: N(n), NC(n), NLegacy(n), NCLegacy(n), R ( with R<30 cm), F (with 0.1<f<1)");
   }
 
+  initializeCompressed();
 }
 
 ECLNeighbours::~ECLNeighbours()
@@ -391,6 +392,19 @@ void ECLNeighbours::initializeNCLegacy(const int n, const int corners)
   }
 }
 
+void ECLNeighbours::initializeCompressed()
+{
+  m_neighbourOffsets.clear();
+  m_neighbourOffsets.reserve(m_neighbourMap.size() + 1);
+  m_neighbourIds.clear();
+
+  for (const auto& neighbours : m_neighbourMap) {
+    m_neighbourOffsets.push_back(m_neighbourIds.size());
+    m_neighbourIds.insert(m_neighbourIds.end(), neighbours.begin(), neighbours.end());
+  }
+  m_neighbourOffsets.push_back(m_neighbourIds.size());
+}
+
 const std::vector<short int>& ECLNeighbours::getNeighbours(const short int cid) const
 {
   return m_neighbourMap.at(cid);
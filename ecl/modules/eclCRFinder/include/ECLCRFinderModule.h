@@ -16,6 +16,8 @@
 namespace Belle2 {
   class ECLConnectedRegion;
   class ECLCalDigit;
+  class ECLCalDigitCellTable;
+  class EventMetaData;
   class EventLevelClusteringInfo;
 
   namespace ECL {
@@ -56,6 +58,12 @@ namespace Belle2 {
     /** Store object pointer: EventLevelClusteringInfo. */
     StoreObjPtr<EventLevelClusteringInfo> m_eventLevelClusteringInfo;
 
+    /** Store object pointer: ECLCalDigitCellTable, persistent to allocate it only once. */
+    StoreObjPtr<ECLCalDigitCellTable> m_eclCalDigitCellTable{"", DataStore::c_Persistent};
+
+    /** Store object pointer: EventMetaData. */
+    StoreObjPtr<EventMetaData> m_eventMetaData;
+
     /** Name to be used for default or PureCsI option: ECLCalDigits.*/
     virtual const char* eclCalDigitArrayName() const
     { return "ECLCalDigits" ; }
@@ -68,6 +76,10 @@ namespace Belle2 {
     virtual const char* eventLevelClusteringInfoName() const
     { return "EventLevelClusteringInfo" ; }
 
+    /** Name to be used for default or PureCsI option: ECLCalDigitCellTable.*/
+    virtual const char* eclCalDigitCellTableName() const
+    { return "ECLCalDigitCellTable" ; }
+
   private:
 
     // Module parameters
@@ -90,14 +102,12 @@ namespace Belle2 {
     std::vector <int>  m_cellIdToGrowthVec; /**< cellid -> growth digits. */
     std::vector <int>  m_cellIdToDigitVec; /**< cellid -> above threshold digits. */
 
-    /** vector (8736+1 entries) with cell id to store array positions */
-    std::vector< int > m_calDigitStoreArrPosition;
-
     // USE POSITION IN STORE ARRAY!!!
 
     /** Connected Region map. */
     std::vector < int > m_cellIdToTempCRIdVec; /**< cellid -> temporary CR.*/
     std::map < int, int > m_cellIdToTempCRIdMap; /**< cellid -> temporary CR.*/
+    std::vector < int > m_cellIdsInCRs; /**< cellids that belong to a temporary CR.*/
 
     /** Neighbour maps. */
     std::vector<ECL::ECLNeighbours*> m_neighbourMaps;
@@ -125,6 +135,10 @@ namespace Belle2 {
     virtual const char* eventLevelClusteringInfoName() const override
     { return "EventLevelClusteringInfoPureCsI" ; }
 
+    /** Name to be used for PureCsI option: ECLCalDigitCellTablePureCsI.*/
+    virtual const char* eclCalDigitCellTableName() const override
+    { return "ECLCalDigitCellTablePureCsI" ; }
+
   }; // end of ECLCovarianceMatrixPureCsIModule
 
 } // end of Belle2 namespace
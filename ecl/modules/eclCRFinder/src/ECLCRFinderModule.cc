@@ -16,11 +16,15 @@
 //ECL
 #include <ecl/geometry/ECLNeighbours.h>
 #include <ecl/dataobjects/ECLCalDigit.h>
+#include <ecl/dataobjects/ECLCalDigitCellTable.h>
 #include <ecl/dataobjects/ECLConnectedRegion.h>
 
 // MDST
 #include <mdst/dataobjects/EventLevelClusteringInfo.h>
 
+// OTHER
+#include <algorithm>
+
 // NAMESPACE(S)
 using namespace Belle2;
 
@@ -77,6 +81,8 @@ void ECLCRFinderModule::initialize()
   m_eclCalDigits.registerInDataStore(eclCalDigitArrayName());
   m_eclConnectedRegions.registerInDataStore(eclConnectedRegionArrayName());
   m_eventLevelClusteringInfo.registerInDataStore(eventLevelClusteringInfoName());
+  m_eclCalDigitCellTable.registerInDataStore(eclCalDigitCellTableName(), DataStore::c_DontWriteOut);
+  m_eventMetaData.isRequired();
 
   // Register relations.
   m_eclConnectedRegions.registerRelationTo(m_eclCalDigits);
@@ -120,7 +126,6 @@ void ECLCRFinderModule::initialize()
   m_cellIdToGrowthVec.resize(8737); /**< cellid -> growth digits (type 2). */
   m_cellIdToDigitVec.resize(8737); /**< cellid -> above threshold digits. */
   m_cellIdToTempCRIdVec.resize(8737); /**< cellid -> CR. */
-  m_calDigitStoreArrPosition.resize(8737);
 
 }
 
@@ -140,14 +145,13 @@ void ECLCRFinderModule::event()
   memset(&m_cellIdToDigitVec[0], 0, m_cellIdToDigitVec.size() * sizeof m_cellIdToDigitVec[0]);
   memset(&m_cellIdToTempCRIdVec[0], 0, m_cellIdToTempCRIdVec.size() * sizeof m_cellIdToTempCRIdVec[0]);
 
-  // Fill a vector that can be used to map cellid -> store array position
-  memset(&m_calDigitStoreArrPosition[0], -1, m_calDigitStoreArrPosition.size() * sizeof m_calDigitStoreArrPosition[0]);
-  for (int i = 0; i < m_eclCalDigits.getEntries(); i++) {
-    m_calDigitStoreArrPosition[m_eclCalDigits[i]->getCellId()] = i;
-  }
+  // Fill the table that maps cellid -> store array position, it is shared with the following clustering modules
+  if (!m_eclCalDigitCellTable.isValid()) m_eclCalDigitCellTable.create();
+  m_eclCalDigitCellTable->fill(m_eclCalDigits, *m_eventMetaData);
 
   // Clear the map(s).
   m_cellIdToTempCRIdMap.clear();
+  m_cellIdsInCRs.clear();
 
   // Init variables.
   m_tempCRId = 1;
@@ -245,28 +249,28 @@ void ECLCRFinderModule::event()
   }
 
   //-------------------------------------------------------
-  // Make CR Ids consecutive.
+  // Make CR Ids consecutive, numbered in the order of the lowest cellid of each CR.
+  std::sort(m_cellIdsInCRs.begin(), m_cellIdsInCRs.end());
   std::map< int, int > tempCRIdToCRIdMap;
-  std::map< int, int>::iterator tempCRIdToCRIdMapIterator;
 
   int CRId = 1;
-  for (unsigned int i = 1; i < m_cellIdToTempCRIdVec.size(); ++i) {
-
-    if (m_cellIdToTempCRIdVec[i] > 0) { // digit belongs to a temporary CR
-      tempCRIdToCRIdMapIterator = tempCRIdToCRIdMap.find(m_cellIdToTempCRIdVec[i]);
-
-      if (tempCRIdToCRIdMapIterator == tempCRIdToCRIdMap.end()) { // not found
-        tempCRIdToCRIdMap[m_cellIdToTempCRIdVec[i]] = CRId;
-        ++CRId;
-      }
+  for (const int cellid : m_cellIdsInCRs) {
+    if (tempCRIdToCRIdMap.find(m_cellIdToTempCRIdVec[cellid]) == tempCRIdToCRIdMap.end()) { // not found
+      tempCRIdToCRIdMap[m_cellIdToTempCRIdVec[cellid]] = CRId;
+      ++CRId;
     }
   }
 
+  // Group the digits by temporary CR, ordered by cellid within each CR.
+  std::stable_sort(m_cellIdsInCRs.begin(), m_cellIdsInCRs.end(), [this](const int cellid1, const int cellid2) {
+    return m_cellIdToTempCRIdVec[cellid1] < m_cellIdToTempCRIdVec[cellid2];
+  });
+
   // Create CRs and add relations to digits.
+  auto itCellId = m_cellIdsInCRs.begin();
   for (const auto& entry : tempCRIdToCRIdMap) {
-    int connectedRegionID = entry.second;
-
-    // create CR
+    const int tempCRId = entry.first;
+    const int connectedRegionID = entry.second;
 
     // Append to store array.
     const auto aCR = m_eclConnectedRegions.appendNew();
@@ -275,14 +279,11 @@ void ECLCRFinderModule::event()
     aCR->setCRId(connectedRegionID);
 
     // Add relations to all digits in this CR.
-    for (unsigned int i = 1; i < m_cellIdToTempCRIdVec.size(); ++i) {
-      if (tempCRIdToCRIdMap[m_cellIdToTempCRIdVec[i]] == connectedRegionID) {
-
-        const int pos = m_calDigitStoreArrPosition[i];
-        aCR->addRelationTo(m_eclCalDigits[pos], 1.0);
-      }
+    for (; itCellId != m_cellIdsInCRs.end() and m_cellIdToTempCRIdVec[*itCellId] == tempCRId; ++itCellId) {
+      const int pos = m_eclCalDigitCellTable->getStoreArrayPosition(*itCellId);
+      aCR->addRelationTo(m_eclCalDigits[pos], 1.0);
     }
-  } // end m_cellIdToTempCRIdVec loop
+  }
 }
 
 
@@ -306,7 +307,7 @@ void ECLCRFinderModule::checkNeighbours(const int cellid, const int tempcrid, co
 {
   B2DEBUG(200, "ECLCRFinderModule::checkNeighbours() type=" << type);
 
-  for (const auto& neighbour : m_neighbourMaps[type]->getNeighbours(cellid)) {
+  for (const auto& neighbour : m_neighbourMaps[type]->getNeighbourRange(cellid)) {
     B2DEBUG(200, "ECLCRFinderModule::checkNeighbours(): neighbour=" << neighbour);
 
     // Check if this digit is above the lowest threshold (i.e. included in m_cellIdToDigitPointerVec) to be added.
@@ -349,7 +350,7 @@ void ECLCRFinderModule::updateCRs(int cellid, int tempcr)
   if (thiscr != 0) {
 
     // This cellid is already in another connected region, update all cells of this other connected region
-    for (unsigned int i = 1; i < m_cellIdToTempCRIdVec.size(); ++i) {
+    for (const int i : m_cellIdsInCRs) {
       if (m_cellIdToTempCRIdVec[i] == thiscr) {
         m_cellIdToTempCRIdVec[i] = tempcr;
       }
@@ -357,5 +358,6 @@ void ECLCRFinderModule::updateCRs(int cellid, int tempcr)
 
   } else { //not in a CR yet, add it!
     m_cellIdToTempCRIdVec[cellid] = tempcr;
+    m_cellIdsInCRs.push_back(cellid);
   }
 }
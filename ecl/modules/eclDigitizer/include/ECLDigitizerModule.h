@@ -142,6 +142,9 @@ namespace Belle2 {
     void shapeFitterWrapper(const int j, const int* FitA, const int m_ttrig,
                             int& m_lar, int& m_ltr, int& m_lq, int& m_chi) const ;
 
+    /** returns false if the waveform fit of channel j is known to give an amplitude not above the ADC threshold */
+    bool fitCanExceedThreshold(const int j, const int* FitA, const int ttrig) const;
+
     /** dbobject for hadron signal shapes*/
     DBObjPtr<ECLDigitWaveformParametersForMC> m_waveformParametersMC;
 
@@ -193,5 +196,6 @@ namespace Belle2 {
     bool m_trigTime; /**< Use trigger time from beam background overlay */
     std::string m_eclWaveformsName;   /**< name of background waveforms storage*/
     bool m_dspDataTest; /**< DSP data usage flag */
+    bool m_sparseFits; /**< skip waveform fits with known amplitude below the ADC threshold */
   };
 }//Belle2
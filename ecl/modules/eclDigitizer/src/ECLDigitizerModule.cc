@@ -76,6 +76,10 @@ ECLDigitizerModule::ECLDigitizerModule() : Module(), m_waveformParametersMC("ECL
            "Use DSP coefficients from the database for the processing. This "
            "will significantly reduce performance so this option is to be "
            "used for testing only.", false);
+  addParam("SparseFits", m_sparseFits,
+           "Skip the full waveform fit of channels whose first amplitude approximation is below the low amplitude "
+           "threshold of the fit and not above ADCThreshold. The fit would return this approximation, "
+           "so the result is identical (default: true)", true);
 
 }
 
@@ -232,6 +236,36 @@ void ECLDigitizerModule::shapeFitterWrapper(const int j, const int* FitA, const
   }
 }
 
+// first approximation of the shape fitter, see lftda_
+bool ECLDigitizerModule::fitCanExceedThreshold(const int j, const int* FitA, const int ttrig) const
+{
+  if (!m_sparseFits || m_dspDataTest) return true;
+
+  const crystallinks_t& t = m_tbl[j]; //lookup table [0,8735]
+  const fitparams_t& r = m_fitparams[t.ifunc];
+  const algoparams_t& p = m_idn[t.idn];
+
+  int A0  = (int) p.id[0] - 128;
+  int k_a = (int) p.ic[26];
+  int k_16 = (int) p.ic[29];
+
+  long long z00 = 0;
+  for (int i = k_16; i < 16; i++) z00 += FitA[i];
+  // pedestal overflow is handled by the fitter
+  if (z00 > 0x3FFFF) return true;
+
+  // amplitude without time correction (assuming t_0 == trigger time)
+  const int* fg41 = r.fg41[ttrig / 6];
+  long long A2 = fg41[0] * z00;
+  for (int i = 1; i < 16; i++) A2 += FitA[15 + i] * (long long)fg41[i];
+  A2 += (1 << (k_a - 1));
+  A2 >>= k_a;
+
+  // below the low amplitude threshold the fitter returns this amplitude without iterating
+  if (A2 >= A0) return true;
+  return max(A2, -128LL) > m_ADCThreshold;
+}
+
 void ECLDigitizerModule::shapeSignals()
 {
   const EclConfiguration& ec = EclConfiguration::get();
@@ -451,6 +485,9 @@ void ECLDigitizerModule::event()
     int id = m_eclMapper.getCrateID(j + 1) - 1; // 0 .. 51
     int ttrig = 2 * m_ttime[id];
 
+    // most channels carry only noise, their amplitude is known to be below threshold without the full fit
+    if (!fitCanExceedThreshold(j, FitA, ttrig)) continue;
+
     shapeFitterWrapper(j, FitA, ttrig, energyFit, tFit, qualityFit, chi);
 
     if (energyFit > m_ADCThreshold) {
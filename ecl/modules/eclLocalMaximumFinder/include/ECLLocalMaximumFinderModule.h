@@ -11,6 +11,7 @@
 // FRAMEWORK
 #include <framework/core/Module.h>
 #include <framework/datastore/StoreArray.h>
+#include <framework/datastore/StoreObjPtr.h>
 #include <framework/gearbox/Unit.h>
 #include <framework/geometry/B2Vector3.h> // faster than TVector3
 
@@ -23,6 +24,8 @@ namespace Belle2 {
   class ECLHit;
   class ECLDigit;
   class ECLCalDigit;
+  class ECLCalDigitCellTable;
+  class EventMetaData;
   class ECLLocalMaximum;
   class ECLConnectedRegion;
 
@@ -74,6 +77,12 @@ namespace Belle2 {
     /** Store array: ECLLocalMaximum. */
     StoreArray<ECLLocalMaximum> m_eclLocalMaximums;
 
+    /** Store object pointer: ECLCalDigitCellTable, persistent to allocate it only once. */
+    StoreObjPtr<ECLCalDigitCellTable> m_eclCalDigitCellTable{"", DataStore::c_Persistent};
+
+    /** Store object pointer: EventMetaData. */
+    StoreObjPtr<EventMetaData> m_eventMetaData;
+
     /** MCParticles.*/
     virtual const char* mcParticleArrayName() const
     { return "MCParticles" ; }
@@ -98,6 +107,10 @@ namespace Belle2 {
     virtual const char* eclLocalMaximumArrayName() const
     { return "ECLLocalMaximums" ; }
 
+    /** Name to be used for default or PureCsI option: ECLCalDigitCellTable.*/
+    virtual const char* eclCalDigitCellTableName() const
+    { return "ECLCalDigitCellTable" ; }
+
     /** Reset Classifier Variables.*/
     void resetClassifierVariables();
 
@@ -137,9 +150,6 @@ namespace Belle2 {
     // Constants
     const double c_minEnergyCut = 5.0 * Belle2::Unit::MeV; /**< Minimum LM energy */
 
-    /** vector (8736+1 entries) with cell id to store array positions */
-    std::vector< int > m_StoreArrPosition;
-
     /** Neighbour maps. */
     ECL::ECLNeighbours* m_neighbourMap{nullptr};
 
@@ -203,6 +213,10 @@ namespace Belle2 {
     virtual const char* eclLocalMaximumArrayName() const override
     { return "ECLLocalMaximumsPureCsI" ; }
 
+    /** Name to be used for PureCsI option: ECLCalDigitCellTablePureCsI.*/
+    virtual const char* eclCalDigitCellTableName() const override
+    { return "ECLCalDigitCellTablePureCsI" ; }
+
   }; // end of ECLLocalMaximumFinderPureCsIModule
 
 } // end of Belle2 namespace
@@ -25,6 +25,7 @@
 #include <ecl/dataobjects/ECLHit.h>
 #include <ecl/dataobjects/ECLDigit.h>
 #include <ecl/dataobjects/ECLCalDigit.h>
+#include <ecl/dataobjects/ECLCalDigitCellTable.h>
 #include <ecl/dataobjects/ECLLocalMaximum.h>
 #include <ecl/dataobjects/ECLConnectedRegion.h>
 #include <ecl/geometry/ECLNeighbours.h>
@@ -82,6 +83,8 @@ void ECLLocalMaximumFinderModule::initialize()
   m_eclLocalMaximums.registerInDataStore(eclLocalMaximumArrayName());
   m_eclCalDigits.registerInDataStore(eclCalDigitArrayName());
   m_eclConnectedRegions.registerInDataStore(eclConnectedRegionArrayName());
+  m_eclCalDigitCellTable.registerInDataStore(eclCalDigitCellTableName(), DataStore::c_DontWriteOut);
+  m_eventMetaData.isRequired();
   m_eclConnectedRegions.registerRelationTo(m_eclLocalMaximums);
   m_eclCalDigits.registerRelationTo(m_eclLocalMaximums);
 
@@ -154,9 +157,6 @@ void ECLLocalMaximumFinderModule::initialize()
     m_tree->Branch("LMId", &m_LMId, "LMId/F");
   }
 
-  // initialize the vector that gives the relation between cellid and store array position
-  m_StoreArrPosition.resize(8736 + 1);
-
 }
 
 void ECLLocalMaximumFinderModule::beginRun()
@@ -168,11 +168,10 @@ void ECLLocalMaximumFinderModule::event()
 {
   B2DEBUG(200, "ECLLocalMaximumFinderModule::event()");
 
-  // Fill a vector that can be used to map cellid -> store array position
-  std::fill_n(m_StoreArrPosition.begin(), m_StoreArrPosition.size(), -1);
-  for (int i = 0; i < m_eclCalDigits.getEntries(); i++) {
-    m_StoreArrPosition[m_eclCalDigits[i]->getCellId()] = i;
-  }
+  // Get the table that maps cellid -> digit, usually filled by the connected region finder
+  if (!m_eclCalDigitCellTable.isValid()) m_eclCalDigitCellTable.create();
+  if (!m_eclCalDigitCellTable->isFilledFrom(m_eclCalDigits, *m_eventMetaData)) m_eclCalDigitCellTable->fill(m_eclCalDigits, *m_eventMetaData);
+  const ECLCalDigitCellTable& cellTable = *m_eclCalDigitCellTable;
 
   // Vector with neighbour ids.
   std::vector< double > vNeighourEnergies;
@@ -198,14 +197,14 @@ void ECLLocalMaximumFinderModule::event()
         // Check neighbours: Must be a local energy maximum.
         bool isLocMax = 1;
         int neighbourCount = 0;
-        for (auto& neighbourId : m_neighbourMap->getNeighbours(aECLCalDigit.getCellId())) {
+        for (const auto& neighbourId : m_neighbourMap->getNeighbourRange(aECLCalDigit.getCellId())) {
           if (neighbourId == aECLCalDigit.getCellId()) continue; // Skip the center cell to avoid possible floating point issues.
 
-          const int pos = m_StoreArrPosition[neighbourId]; // Get position in the store array for this digit.
+          const int pos = cellTable.getStoreArrayPosition(neighbourId); // Get position in the store array for this digit.
 
           double energyNeighbour = 0.0;
           if (pos >= 0) {
-            energyNeighbour = m_eclCalDigits[pos]->getEnergy(); // Get the energy directly from the store array.
+            energyNeighbour = cellTable.getEnergy(neighbourId); // Get the energy directly from the cell table.
             vNeighourEnergies[neighbourCount] = energyNeighbour;
           } else {
             // Digit does not belong to this CR
@@ -0,0 +1,82 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#pragma once
+
+//STL
+#include <memory>
+#include <string>
+#include <vector>
+
+//Framework
+#include <framework/core/Module.h>
+#include <framework/datastore/StoreArray.h>
+
+//ECL
+#include <ecl/simulation/ShowerLibrary.h>
+
+//Geant4
+#include <G4ThreeVector.hh>
+
+namespace Belle2 {
+  class ECLSimHit;
+  class MCParticle;
+
+  /**
+   * Build the ECL shower library for the fast simulation (FullSim parameter ECLShowerLibrary)
+   * from full simulation.
+   *
+   * Each event must contain a single primary electron, positron or photon, whose shower is
+   * fully simulated. Photon and electron/positron showers are stored separately, so the library
+   * should be built from all particle types it is used for. The ECLSimHits of the event are stored in the shower frame relative to the
+   * point where the particle enters the ECL, which is found by following its straight line of
+   * flight from the production vertex. The events should therefore be simulated without magnetic
+   * field and (ideally) with only the ECL in the geometry.
+   */
+  class ECLShowerLibraryBuilderModule : public Module {
+
+  public:
+    /** Constructor.*/
+    ECLShowerLibraryBuilderModule();
+
+    /** Create the empty library */
+    virtual void initialize() override;
+
+    /** Add the shower of the event to the library */
+    virtual void event() override;
+
+    /** Write the library */
+    virtual void terminate() override;
+
+  private:
+    /**
+     * Find the point where the particle enters the ECL
+     * @param vertex production vertex in cm
+     * @param direction direction of flight
+     * @param entry entry point in cm
+     * @return false if the particle does not hit the ECL
+     */
+    bool findEntry(const G4ThreeVector& vertex, const G4ThreeVector& direction, G4ThreeVector& entry) const;
+
+    /** Name of the library file */
+    std::string m_fileName;
+    /** Edges of the energy bins in GeV */
+    std::vector<double> m_energyBins;
+    /** Edges of the incidence angle bins in rad */
+    std::vector<double> m_angleBins;
+    /** Size of the cells in which the deposits of a shower are merged in cm */
+    double m_cellSize;
+
+    /** The library */
+    std::unique_ptr<ECL::ShowerLibrary> m_library;
+    /** Number of events whose shower could not be stored */
+    unsigned int m_skippedEvents = 0;
+
+    StoreArray<MCParticle> m_mcParticles; /**< MCParticle array */
+    StoreArray<ECLSimHit> m_eclSimHits; /**< ECLSimHit array */
+  };
+} // end of Belle2 namespace
@@ -0,0 +1,182 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+//This module
+#include <ecl/modules/eclShowerLibraryBuilder/ECLShowerLibraryBuilderModule.h>
+
+//Framework
+#include <framework/gearbox/Const.h>
+#include <framework/logging/Logger.h>
+
+//MDST
+#include <mdst/dataobjects/MCParticle.h>
+
+//ECL
+#include <ecl/dataobjects/ECLSimHit.h>
+#include <ecl/simulation/ShowerLibraryModel.h>
+
+//Geant4
+#include <G4Navigator.hh>
+#include <G4TransportationManager.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4LogicalVolume.hh>
+
+//STL
+#include <cmath>
+#include <map>
+#include <tuple>
+
+using namespace std;
+using namespace Belle2;
+using namespace ECL;
+
+//-----------------------------------------------------------------
+//                 Register the Module
+//-----------------------------------------------------------------
+REG_MODULE(ECLShowerLibraryBuilder)
+
+//-----------------------------------------------------------------
+//                 Implementation
+//-----------------------------------------------------------------
+
+ECLShowerLibraryBuilderModule::ECLShowerLibraryBuilderModule() : Module()
+{
+  // Set description
+  setDescription("Builds the shower library of the ECL fast simulation (FullSim parameter ECLShowerLibrary) from full simulation. "
+                 "Each event must contain a single primary electron, positron or photon, simulated without magnetic field "
+                 "and ideally with only the ECL in the geometry.");
+
+  addParam("fileName", m_fileName, "Name of the shower library file", string("ECLShowerLibrary.root"));
+  addParam("energyBins", m_energyBins, "[GeV] Edges of the bins in kinetic energy",
+           vector<double> {0.1, 0.2, 0.35, 0.5, 0.75, 1.0, 1.5, 2.0, 3.0, 5.0, 8.0});
+  addParam("angleBins", m_angleBins, "[rad] Edges of the bins in the angle between the particle and the axis of the hit crystal",
+           vector<double> {0.0, 0.02, 0.04, 0.07, 0.1, 0.2, 0.5});
+  addParam("cellSize", m_cellSize, "[cm] Size of the cells in the shower frame in which the energy deposits are merged", 1.0);
+}
+
+void ECLShowerLibraryBuilderModule::initialize()
+{
+  m_mcParticles.isRequired();
+  m_eclSimHits.isRequired();
+  if (m_cellSize <= 0) {
+    B2ERROR("The cell size must be positive" << LogVar("cellSize", m_cellSize));
+  }
+  m_library.reset(new ShowerLibrary(m_energyBins, m_angleBins));
+}
+
+bool ECLShowerLibraryBuilderModule::findEntry(const G4ThreeVector& vertex, const G4ThreeVector& direction,
+                                              G4ThreeVector& entry) const
+{
+  G4Navigator navigator;
+  navigator.SetWorldVolume(G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume());
+
+  // Follow the straight line of flight from volume to volume until an ECL region is reached
+  G4ThreeVector point = vertex * CLHEP::cm;
+  G4VPhysicalVolume* volume = navigator.LocateGlobalPointAndSetup(point, &direction, false, false);
+  for (int step = 0; step < 1000 and volume; step++) {
+    if (ShowerLibraryModel::isECLRegion(volume->GetLogicalVolume()->GetRegion())) {
+      entry = point / CLHEP::cm;
+      return true;
+    }
+    double safety = 0;
+    const double stepLength = navigator.ComputeStep(point, direction, kInfinity, safety);
+    if (stepLength >= kInfinity) break;
+    point += stepLength * direction;
+    navigator.SetGeometricallyLimitedStep();
+    volume = navigator.LocateGlobalPointAndSetup(point, &direction, true, false);
+  }
+  return false;
+}
+
+void ECLShowerLibraryBuilderModule::event()
+{
+  // Exactly one primary electron, positron or photon
+  const MCParticle* primary = nullptr;
+  for (const MCParticle& particle : m_mcParticles) {
+    if (!particle.hasStatus(MCParticle::c_PrimaryParticle)) continue;
+    if (primary) {
+      B2WARNING("More than one primary particle, skipping the event.");
+      m_skippedEvents++;
+      return;
+    }
+    primary = &particle;
+  }
+  if (!primary or (abs(primary->getPDG()) != Const::electron.getPDGCode() and primary->getPDG() != Const::photon.getPDGCode())) {
+    B2WARNING("The event does not contain a single primary electron, positron or photon, skipping it.");
+    m_skippedEvents++;
+    return;
+  }
+
+  const TVector3 vertex = primary->getProductionVertex();
+  const TVector3 momentum = primary->getMomentum();
+  const G4ThreeVector direction = G4ThreeVector(momentum.X(), momentum.Y(), momentum.Z()).unit();
+  G4ThreeVector entry;
+  if (!findEntry(G4ThreeVector(vertex.X(), vertex.Y(), vertex.Z()), direction, entry)) {
+    B2DEBUG(20, "The primary particle does not hit the ECL, skipping the event.");
+    m_skippedEvents++;
+    return;
+  }
+  const double flightDistance = (entry - G4ThreeVector(vertex.X(), vertex.Y(), vertex.Z())).mag();
+  const TVector3 decayVertex = primary->getDecayVertex();
+  if ((decayVertex - vertex).Mag() < flightDistance) {
+    B2DEBUG(20, "The primary particle interacted before entering the ECL, skipping the event.");
+    m_skippedEvents++;
+    return;
+  }
+  const double entryTime = primary->getProductionTime() + flightDistance / Const::speedOfLight;
+
+  ShowerLibrary::Shower shower;
+  shower.energy = primary->getEnergy() - primary->getMass();
+  shower.particle = ShowerLibrary::getParticle(primary->getPDG());
+  const int cellId = ShowerLibraryModel::findCrystal(entry, direction);
+  shower.angle = ShowerLibraryModel::getIncidenceAngle(cellId, direction);
+  shower.region = ShowerLibrary::getRegion(cellId);
+
+  // Merge the deposits in cells of the shower frame
+  G4ThreeVector u, v;
+  ShowerLibraryModel::getShowerFrame(direction, u, v);
+  map<tuple<int, int, int>, ShowerLibrary::Deposit> cells;
+  for (const ECLSimHit& hit : m_eclSimHits) {
+    const double energy = hit.getEnergyDep();
+    if (energy <= 0) continue;
+    const G4ThreeVector relative = hit.getPosition() - entry;
+    const double x = relative.dot(u), y = relative.dot(v), z = relative.dot(direction);
+    const auto key = make_tuple(lround(x / m_cellSize), lround(y / m_cellSize), lround(z / m_cellSize));
+    ShowerLibrary::Deposit& cell = cells[key];
+    cell.x += energy * x;
+    cell.y += energy * y;
+    cell.z += energy * z;
+    cell.time += energy * (hit.getFlightTime() - entryTime);
+    cell.energyFraction += energy;
+  }
+  if (cells.empty()) {
+    m_skippedEvents++;
+    return;
+  }
+
+  for (const auto& cell : cells) {
+    ShowerLibrary::Deposit deposit = cell.second;
+    const float energy = deposit.energyFraction;
+    deposit.x /= energy;
+    deposit.y /= energy;
+    deposit.z /= energy;
+    deposit.time /= energy;
+    deposit.energyFraction = energy / shower.energy;
+    shower.deposits.push_back(deposit);
+  }
+  if (!m_library->addShower(shower)) {
+    B2DEBUG(20, "The shower is outside of the library binning" << LogVar("energy", shower.energy) << LogVar("angle", shower.angle));
+    m_skippedEvents++;
+  }
+}
+
+void ECLShowerLibraryBuilderModule::terminate()
+{
+  B2RESULT("ECL shower library built" << LogVar("file", m_fileName) << LogVar("showers", m_library->getNumberOfShowers())
+           << LogVar("skippedEvents", m_skippedEvents));
+  m_library->write(m_fileName);
+}
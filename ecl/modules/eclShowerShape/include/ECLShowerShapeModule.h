@@ -7,9 +7,6 @@
  **************************************************************************/
 #pragma once
 
-//STL
-#include <complex>
-
 //ROOT
 #include <TGraph.h>
 
@@ -29,7 +26,7 @@ namespace Belle2 {
 
   namespace MVA {
     class Expert;
-    class SingleDataset;
+    class GeneralOptions;
   }
 
   namespace ECL {
@@ -98,6 +95,10 @@ namespace Belle2 {
 
     const unsigned int m_numZernikeMVAvariables = 22; /**< number of variables expected in the Zernike MVA weightfile */
 
+    static constexpr int c_maxZernikeRank = 5; /**< maximal rank n of the Zernike moments that are computed */
+
+    static constexpr int c_numZernikeMoments = 11; /**< number of Zernike moments of one shower used in the Zernike MVA */
+
     std::string m_zernike_MVAidentifier_FWD; /**< Zernike moment MVA - FWD endcap weight-file */
     std::string m_zernike_MVAidentifier_BRL; /**< Zernike moment MVA - Barrel weight-file */
     std::string m_zernike_MVAidentifier_BWD; /**< Zernike moment MVA - BWD endcap weight-file */
@@ -110,8 +111,11 @@ namespace Belle2 {
     std::unique_ptr<MVA::Expert> m_expert_FWD; /**< Pointer to the current MVA Expert for FWD*/
     std::unique_ptr<MVA::Expert> m_expert_BRL; /**< Pointer to the current MVA Expert for BRL*/
     std::unique_ptr<MVA::Expert> m_expert_BWD; /**< Pointer to the current MVA Expert for BWD*/
-    std::unique_ptr<MVA::SingleDataset>
-    m_dataset; /**< Pointer to the current dataset. It is assumed it holds 22 entries, 11 Zernike moments of N2 shower, followed by 11 Zernike moments of N1 shower. */
+    std::unique_ptr<MVA::GeneralOptions>
+    m_generalOptions; /**< General options of the current Zernike MVA. The input of each N1 shower holds 22 entries, 11 Zernike moments of N2 shower, followed by 11 Zernike moments of N1 shower. */
+
+    /** Coefficients of the radial Zernike polynomials, Rnm(rho) = sum_k m_zernikeRadialCoefficients[n][m][k] * rho^k */
+    double m_zernikeRadialCoefficients[c_maxZernikeRank + 1][c_maxZernikeRank + 1][c_maxZernikeRank + 1];
 
     /** Neighbour map 9 neighbours, for E9oE21 and E1oE9. */
     std::unique_ptr<ECL::ECLNeighbours> m_neighbourMap9;
@@ -125,39 +129,37 @@ namespace Belle2 {
                                   std::unique_ptr<DBObjPtr<DatabaseRepresentationOfWeightfile>>& weightFileRepresentation);
 
     /** Load MVA weight file and set pointer of expert.
-     * If weightFileRepresentation is the BRL MVA, also set m_dataset size according to weightFileRepresentation MVA::GeneralOptions
+     * If weightFileRepresentation is the BRL MVA, also set m_generalOptions from weightFileRepresentation MVA::GeneralOptions
      */
     void initializeMVA(const std::string& identifier,
                        std::unique_ptr<DBObjPtr<DatabaseRepresentationOfWeightfile>>& weightFileRepresentation, std::unique_ptr<MVA::Expert>& expert);
 
     /**
     * Set showr shape variables.
-    * For correct zernike MVA calculation, must be run first on the N2 shower in each connected region, then on the N1 showers of the connected region.
-    * calculateZernikeMVA - determines if MVA calculation should be performed. Should be false, for example, if there was no N2 shower, so MVA can't be calculated.
-    * The function does not set the zernikeMVA variable for N2 showers, because it is calculated from zernikeMVAs of the N1 showers, so it has to be set elsewhere (unless calculateZernikeMVA is false, in which case it is set to 0.0).
+    * zernikeMoments - if not nullptr, the c_numZernikeMoments Zernike moments used in the Zernike MVA are written there,
+    * the MVA itself is evaluated later for all showers of the event at once (see event()).
+    * If nullptr, the MVA is not calculated (for example, if there was no N2 shower) and zernikeMVA is set to 0.0.
     */
-    void setShowerShapeVariables(ECLShower* eclShower, const bool calculateZernikeMVA) const;
+    void setShowerShapeVariables(ECLShower* eclShower, float* zernikeMoments) const;
 
     /** Shower shape variable: Lateral energy. */
     double computeLateralEnergy(const std::vector<ProjectedECLDigit>& projectedDigits, const double avgCrystalDimension) const;
 
-    /** Compute the absolute value of the complex Zernike moment Znm.
+    /** Compute the absolute values of the complex Zernike moments Znm for all n <= c_maxZernikeRank, m <= n, n - m even,
+        in a single loop over the digits.
         The moments are computed in a plane perpendicular to the direction of the shower.
         The plane's origin is at the intersection of the shower direction with the plane.
         The origin is at a distance from the interaction point equal to the shower distance from the interaction point.
 
-        n, m - are the Zernike polynomial rank
-        R0 - is a scaling factor used to normalize the distances in the described plane.
+        rho0 - is a scaling factor used to normalize the distances in the described plane.
         It also sets the maximum distance from the origin (the Zernike polynomials are defined only on the unit circle).
-        All points in the plane with a distance larger than R0 from the origin are ignored.
+        All points in the plane with a distance larger than rho0 from the origin are ignored (or moved to rho0, see m_zernike_useFarCrystals).
 
-        Valid values of n,m are n,m >= 0, m <= n.
-        If n or m are invalid the function returns 0.0.
+        The moment |Znm| is stored in absZernikeMoments[n][m]; entries with n - m odd are set to 0.0.
         */
-
-    double computeAbsZernikeMoment(const std::vector<ProjectedECLDigit>& projectedDigits, const double totalEnergy, const int n,
-                                   const int m,
-                                   const double rho) const;
+    void computeAbsZernikeMoments(const std::vector<ProjectedECLDigit>& projectedDigits, const double totalEnergy,
+                                  const double rho0,
+                                  double absZernikeMoments[c_maxZernikeRank + 1][c_maxZernikeRank + 1]) const;
 
     /** Compute the second moment in the plane perpendicular to the direction of the shower.
         The plane's origin is at the intersection of the shower direction with the plane.
@@ -167,17 +169,6 @@ namespace Belle2 {
     /** Compute projections of the ECLCalDigits to the perpendicular plane */
     std::vector<ProjectedECLDigit> projectECLDigits(const ECLShower& shower) const;
 
-    /** The radial part of the Zernike polynomial
-     * n,m - Zernike polynomial rank
-     * rho - radial distance             */
-    double Rnm(const int n, const int m, const double rho) const;
-
-    /** Return the complex value of the Zernike polynomial of rank n,m.
-    Znm(rho,alpha) = Rnm(rho) * exp(i*m*alpha)
-    rho - radial distance
-    alpha - polar angle */
-    std::complex<double> zernikeValue(const double rho, const double alpha, const int n, const int m) const;
-
     /** Shower shape variable: E9oE21
      The energy ratio is calculated taking the weighted 3x3 (=9) and the weighted 5x5-corners (=21) crystals around the central crystal.
      If the shower is smaller than this, the reduced number is used for this. */
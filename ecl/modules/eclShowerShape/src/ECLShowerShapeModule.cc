@@ -9,6 +9,9 @@
 // THIS MODULE
 #include <ecl/modules/eclShowerShape/ECLShowerShapeModule.h>
 
+//STL
+#include <cmath>
+
 //BOOST
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -21,6 +24,7 @@
 #include <framework/geometry/B2Vector3.h>
 
 //MVA
+#include <mva/interface/Dataset.h>
 #include <mva/interface/Expert.h>
 #include <mva/interface/Weightfile.h>
 #include <mva/interface/Interface.h>
@@ -78,6 +82,20 @@ ECLShowerShapeModule::ECLShowerShapeModule() : Module(),
            "Average crystal dimension used in lateral energy calculation.",
            5.0 * Unit::cm);
 
+  // Coefficients of the radial Zernike polynomials:
+  // Rnm(rho) = sum_k (-1)^k (n-k)! / (k! ((n+m)/2-k)! ((n-m)/2-k)!) rho^(n-2k), defined for n - m even.
+  for (int n = 0; n <= c_maxZernikeRank; ++n) {
+    for (int m = 0; m <= c_maxZernikeRank; ++m) {
+      for (int power = 0; power <= c_maxZernikeRank; ++power)
+        m_zernikeRadialCoefficients[n][m][power] = 0.0;
+      if (m > n || (n - m) % 2 != 0)
+        continue;
+      for (int k = 0; k <= (n - m) / 2; ++k) {
+        m_zernikeRadialCoefficients[n][m][n - 2 * k] = ((k % 2 == 0) ? 1.0 : -1.0) * TMath::Factorial(n - k) / TMath::Factorial(k)
+                                                       / TMath::Factorial((n + m) / 2 - k) / TMath::Factorial((n - m) / 2 - k);
+      }
+    }
+  }
 }
 
 ECLShowerShapeModule::~ECLShowerShapeModule()
@@ -146,11 +164,9 @@ void ECLShowerShapeModule::initializeMVA(const std::string& identifier,
   expert = supported_interfaces[general_options.m_method]->getExpert();
   expert->load(weightfile);
 
-  //create new dataset, if this is the barrel MVA (assumes FWD and BWD datasets are same size)
-  if (weightFileRepresentation == m_weightfile_representation_BRL) {
-    std::vector<float> dummy(general_options.m_variables.size(), 0);
-    m_dataset = std::unique_ptr<MVA::SingleDataset>(new MVA::SingleDataset(general_options, dummy, 0));
-  }
+  //keep the options for the datasets, if this is the barrel MVA (assumes FWD and BWD datasets are same size)
+  if (weightFileRepresentation == m_weightfile_representation_BRL)
+    m_generalOptions = std::unique_ptr<MVA::GeneralOptions>(new MVA::GeneralOptions(general_options));
 }
 
 void ECLShowerShapeModule::beginRun()
@@ -167,7 +183,7 @@ void ECLShowerShapeModule::beginRun()
 }
 
 
-void ECLShowerShapeModule::setShowerShapeVariables(ECLShower* eclShower, const bool calculateZernikeMVA) const
+void ECLShowerShapeModule::setShowerShapeVariables(ECLShower* eclShower, float* zernikeMoments) const
 {
   //Project the digits on the plane perpendicular to the shower direction
   std::vector<ProjectedECLDigit> projectedECLDigits = projectECLDigits(*eclShower);
@@ -186,8 +202,9 @@ void ECLShowerShapeModule::setShowerShapeVariables(ECLShower* eclShower, const b
   if (hypothesisID == ECLShower::c_nPhotons) rho0 = m_zernike_n1_rho0;
   else if (hypothesisID == ECLShower::c_neutralHadron) rho0 = m_zernike_n2_rho0;
 
-  const double absZernike40 = computeAbsZernikeMoment(projectedECLDigits, sumEnergies, 4, 0, rho0);
-  const double absZernike51 = computeAbsZernikeMoment(projectedECLDigits, sumEnergies, 5, 1, rho0);
+  //All Zernike moments are computed in one pass over the digits
+  double absZernikeMoments[c_maxZernikeRank + 1][c_maxZernikeRank + 1];
+  computeAbsZernikeMoments(projectedECLDigits, sumEnergies, rho0, absZernikeMoments);
 
   const double secondMomentCorrection = getSecondMomentCorrection(showerTheta, showerPhi, hypothesisID);
   B2DEBUG(175, "Second moment angular correction: " << secondMomentCorrection << " (theta(rad)=" << showerTheta << ", phi(rad)=" <<
@@ -199,55 +216,43 @@ void ECLShowerShapeModule::setShowerShapeVariables(ECLShower* eclShower, const b
   const double LATenergy    = computeLateralEnergy(projectedECLDigits, m_avgCrystalDimension);
 
   // Set shower shape variables.
-  eclShower->setAbsZernike40(absZernike40);
-  eclShower->setAbsZernike51(absZernike51);
+  eclShower->setAbsZernike40(absZernikeMoments[4][0]);
+  eclShower->setAbsZernike51(absZernikeMoments[5][1]);
   eclShower->setSecondMoment(secondMoment);
   eclShower->setLateralEnergy(LATenergy);
   eclShower->setE1oE9(computeE1oE9(*eclShower));
   if (eclShower->getE9oE21() < 1e-9) eclShower->setE9oE21(computeE9oE21(*eclShower));
 
-  if (calculateZernikeMVA) {
-    //Set Zernike moments that will be used in MVA calculation
-    // m_dataset holds 22 entries, 11 Zernike moments of N2 shower, followed by 11 Zernike moments of N1 shower
-    int indexOffset = 0;//Offset entries depending on hypothesis type
-    if (hypothesisID == ECLShower::c_nPhotons) indexOffset = (m_numZernikeMVAvariables / 2);
-    else if (hypothesisID == ECLShower::c_neutralHadron) indexOffset = 0;
-
-    m_dataset->m_input[0 + indexOffset] = computeAbsZernikeMoment(projectedECLDigits, sumEnergies, 1, 1, rho0);
-    m_dataset->m_input[1 + indexOffset] = computeAbsZernikeMoment(projectedECLDigits, sumEnergies, 2, 0, rho0);
-    m_dataset->m_input[2 + indexOffset] = computeAbsZernikeMoment(projectedECLDigits, sumEnergies, 2, 2, rho0);
-    m_dataset->m_input[3 + indexOffset] = computeAbsZernikeMoment(projectedECLDigits, sumEnergies, 3, 1, rho0);
-    m_dataset->m_input[4 + indexOffset] = computeAbsZernikeMoment(projectedECLDigits, sumEnergies, 3, 3, rho0);
-    m_dataset->m_input[5 + indexOffset] = absZernike40;
-    m_dataset->m_input[6 + indexOffset] = computeAbsZernikeMoment(projectedECLDigits, sumEnergies, 4, 2, rho0);
-    m_dataset->m_input[7 + indexOffset] = computeAbsZernikeMoment(projectedECLDigits, sumEnergies, 4, 4, rho0);
-    m_dataset->m_input[8 + indexOffset] = absZernike51;
-    m_dataset->m_input[9 + indexOffset] = computeAbsZernikeMoment(projectedECLDigits, sumEnergies, 5, 3, rho0);
-    m_dataset->m_input[10 + indexOffset] = computeAbsZernikeMoment(projectedECLDigits, sumEnergies, 5, 5, rho0);
-    //Set zernikeMVA for N1 showers
-    //This assumes that the N2 zernike moments have already been set in m_dataset!!!!
-    if (hypothesisID == ECLShower::c_nPhotons) {
-      //FWD
-      if (eclShower->getTheta() < m_BRLthetaMin) eclShower->setZernikeMVA(m_expert_FWD->apply(*m_dataset)[0]);
-      //BWD
-      else if (eclShower->getTheta() > m_BRLthetaMax) eclShower->setZernikeMVA(m_expert_BWD->apply(*m_dataset)[0]);
-      //BRL
-      else eclShower->setZernikeMVA(m_expert_BRL->apply(*m_dataset)[0]);
+  if (zernikeMoments != nullptr) {
+    //Set Zernike moments that will be used in MVA calculation:
+    //|Z11|, |Z20|, |Z22|, |Z31|, |Z33|, |Z40|, |Z42|, |Z44|, |Z51|, |Z53|, |Z55|
+    int index = 0;
+    for (int n = 1; n <= c_maxZernikeRank; ++n) {
+      for (int m = n % 2; m <= n; m += 2)
+        zernikeMoments[index++] = absZernikeMoments[n][m];
     }
   } else eclShower->setZernikeMVA(0.0);
 }
 
 void ECLShowerShapeModule::event()
 {
+  //Zernike MVA inputs of the N1 showers of the event, for each MVA (0 = FWD, 1 = BRL, 2 = BWD)
+  //The MVA is evaluated once for all showers of the event that use the same weightfile.
+  std::vector<std::vector<float> > zernikeMVAinputs[3];
+  std::vector<ECLShower*> zernikeMVAshowers[3];
+  //N2 shower and N1 showers of each connected region with an N2 shower
+  std::vector<std::pair<ECLShower*, std::vector<ECLShower*> > > regionShowers;
+
   for (auto& eclCR : m_eclConnectedRegions) {
 
     //Start by finding the N2 shower and calculating it's shower shape variables
     //Assumes that there is only 1 N2 Shower per CR!!!!!!
     ECLShower* N2shower = nullptr;
+    float N2zernikeMoments[c_numZernikeMoments];
     for (auto& eclShower : eclCR.getRelationsWith<ECLShower>(eclShowerArrayName())) {
       if (eclShower.getHypothesisId() == ECLShower::c_neutralHadron) {
         N2shower = &eclShower;
-        setShowerShapeVariables(N2shower, true);
+        setShowerShapeVariables(N2shower, N2zernikeMoments);
         break;
       }
     }
@@ -255,8 +260,8 @@ void ECLShowerShapeModule::event()
     //If couldn't find N2 shower, don't calculate zernikeMVA
     bool found_N2shower = true;
     if (N2shower == nullptr) found_N2shower = false;
+    else regionShowers.push_back(std::make_pair(N2shower, std::vector<ECLShower*>()));
 
-    double prodN1zernikeMVAs = 1.0;
     //Calculate shower shape variables for the rest of the showers
     for (auto& eclShower : eclCR.getRelationsWith<ECLShower>(eclShowerArrayName())) {
       if (eclShower.getHypothesisId() == ECLShower::c_neutralHadron)
@@ -265,13 +270,42 @@ void ECLShowerShapeModule::event()
       bool calculateZernikeMVA = true;
       if (!found_N2shower || eclShower.getHypothesisId() != ECLShower::c_nPhotons) calculateZernikeMVA = false;
 
-      setShowerShapeVariables(&eclShower, calculateZernikeMVA);
+      if (!calculateZernikeMVA) {
+        setShowerShapeVariables(&eclShower, nullptr);
+        continue;
+      }
 
-      if (eclShower.getHypothesisId() == ECLShower::c_nPhotons) prodN1zernikeMVAs *= eclShower.getZernikeMVA();
+      // MVA input: 11 Zernike moments of N2 shower, followed by 11 Zernike moments of N1 shower
+      std::vector<float> input(N2zernikeMoments, N2zernikeMoments + c_numZernikeMoments);
+      input.resize(m_numZernikeMVAvariables);
+      setShowerShapeVariables(&eclShower, &input[c_numZernikeMoments]);
+
+      int mva = 1; //BRL
+      if (eclShower.getTheta() < m_BRLthetaMin) mva = 0; //FWD
+      else if (eclShower.getTheta() > m_BRLthetaMax) mva = 2; //BWD
+      zernikeMVAinputs[mva].push_back(std::move(input));
+      zernikeMVAshowers[mva].push_back(&eclShower);
+      regionShowers.back().second.push_back(&eclShower);
     }
+  }
+
+  //Evaluate the Zernike MVAs for all N1 showers of the event
+  const std::unique_ptr<MVA::Expert>* experts[3] = {&m_expert_FWD, &m_expert_BRL, &m_expert_BWD};
+  for (int mva = 0; mva < 3; ++mva) {
+    if (zernikeMVAshowers[mva].empty())
+      continue;
+    MVA::MultiDataset dataset(*m_generalOptions, zernikeMVAinputs[mva], {});
+    const std::vector<float> zernikeMVAs = (*experts[mva])->apply(dataset);
+    for (unsigned int iShower = 0; iShower < zernikeMVAshowers[mva].size(); ++iShower)
+      zernikeMVAshowers[mva][iShower]->setZernikeMVA(zernikeMVAs[iShower]);
+  }
 
-    //Set zernikeMVA for the N2 shower
-    if (N2shower) N2shower->setZernikeMVA(1.0 - prodN1zernikeMVAs);
+  //Set zernikeMVA for the N2 showers
+  for (const auto& region : regionShowers) {
+    double prodN1zernikeMVAs = 1.0;
+    for (const ECLShower* N1shower : region.second)
+      prodN1zernikeMVAs *= N1shower->getZernikeMVA();
+    region.first->setZernikeMVA(1.0 - prodN1zernikeMVAs);
   }
 }
 
@@ -398,53 +432,23 @@ double ECLShowerShapeModule::computeLateralEnergy(const std::vector<ProjectedECL
   return sumE / (sumE + r0sq * (maxEnergy + secondMaxEnergy));
 }
 
-double ECLShowerShapeModule::Rnm(const int n, const int m, const double rho) const
-{
-  // Some explicit polynomials.
-  if (n == 1 && m == 1) return rho;
-  if (n == 2 && m == 0) return 2.0 * rho * rho - 1.0;
-  if (n == 2 && m == 2) return rho * rho;
-  if (n == 3 && m == 1) return 3.0 * rho * rho * rho - 2.0 * rho;
-  if (n == 3 && m == 3) return rho * rho * rho;
-  if (n == 4 && m == 0) return 6.0 * rho * rho * rho * rho - 6.0 * rho * rho + 1.0;
-  if (n == 4 && m == 2) return 4.0 * rho * rho * rho * rho - 3.0 * rho * rho;
-  if (n == 4 && m == 4) return rho * rho * rho * rho;
-  if (n == 5 && m == 1) return 10.0 * rho * rho * rho * rho * rho - 12.0 * rho * rho * rho + 3.0 * rho;
-  if (n == 5 && m == 3) return 5.0 * rho * rho * rho * rho * rho - 4.0 * rho * rho * rho;
-  if (n == 5 && m == 5) return rho * rho * rho * rho * rho;
-
-  // Otherwise compute explicitely.
-  double returnVal = 0;
-  for (int idx = 0; idx <= (n - std::abs(m)) / 2; ++idx)
-    returnVal += std::pow(-1, idx) * TMath::Factorial(n - idx) / TMath::Factorial(idx)
-                 / TMath::Factorial((n + std::abs(m)) / 2 - idx) / TMath::Factorial((n - std::abs(m)) / 2 - idx) * std::pow(rho, n - 2 * idx);
-
-  return returnVal;
-}
-
-std::complex<double> ECLShowerShapeModule::zernikeValue(const double rho, const double alpha, const int n, const int m) const
+void ECLShowerShapeModule::computeAbsZernikeMoments(const std::vector<ProjectedECLDigit>& projectedDigits,
+                                                    const double totalEnergy, const double rho0,
+                                                    double absZernikeMoments[c_maxZernikeRank + 1][c_maxZernikeRank + 1]) const
 {
-  // Zernike moment defined only on the unit cercile (rho < 1).
-  if (rho > 1.0) return std::complex<double>(0, 0);
-
-  std::complex<double> i(0, 1);
-  std::complex<double> exponent = std::exp(i * std::complex<double>(m * alpha, 0));
-  return std::complex<double>(Rnm(n, m, rho), 0) * exponent;
-}
-
-
-double ECLShowerShapeModule::computeAbsZernikeMoment(const std::vector<ProjectedECLDigit>& projectedDigits,
-                                                     const double totalEnergy, const int n, const int m, const double rho0) const
-{
-  if (totalEnergy <= 0.0) return 0.0;
-
-  // Make sure n,m are valid
-  if (n < 0 || m < 0) return 0.0;
-  if (m > n) return 0.0;
-
-  std::complex<double> sum(0.0, 0.0);
-
-  for (const auto projectedDigit : projectedDigits) {
+  for (int n = 0; n <= c_maxZernikeRank; ++n)
+    for (int m = 0; m <= c_maxZernikeRank; ++m)
+      absZernikeMoments[n][m] = 0.0;
+  if (totalEnergy <= 0.0) return;
+
+  // Real and imaginary parts of sum(E * conj(Znm)), Znm(rho, alpha) = Rnm(rho) * exp(i*m*alpha)
+  double sumRe[c_maxZernikeRank + 1][c_maxZernikeRank + 1] = {{0.0}};
+  double sumIm[c_maxZernikeRank + 1][c_maxZernikeRank + 1] = {{0.0}};
+  double rhoPower[c_maxZernikeRank + 1];
+  double cosMAlpha[c_maxZernikeRank + 1];
+  double sinMAlpha[c_maxZernikeRank + 1];
+
+  for (const auto& projectedDigit : projectedDigits) {
     double normalizedRho = projectedDigit.rho / rho0;     // Normalize radial distance according to rho0.
     //Ignore crystals with rho > rho0, if requested
     if (normalizedRho > 1.0) {
@@ -452,9 +456,33 @@ double ECLShowerShapeModule::computeAbsZernikeMoment(const std::vector<Projected
       else normalizedRho = 1.0; //crystals with rho > rho0 are scaled to rho0 instead of discarded
     }
 
-    sum += projectedDigit.energy * std::conj(zernikeValue(normalizedRho, projectedDigit.alpha, n, m));
+    // Powers of rho and cos/sin(m*alpha) from the angle-addition recurrence
+    const double cosAlpha = std::cos(projectedDigit.alpha);
+    const double sinAlpha = std::sin(projectedDigit.alpha);
+    rhoPower[0] = 1.0;
+    cosMAlpha[0] = 1.0;
+    sinMAlpha[0] = 0.0;
+    for (int k = 1; k <= c_maxZernikeRank; ++k) {
+      rhoPower[k] = rhoPower[k - 1] * normalizedRho;
+      cosMAlpha[k] = cosMAlpha[k - 1] * cosAlpha - sinMAlpha[k - 1] * sinAlpha;
+      sinMAlpha[k] = sinMAlpha[k - 1] * cosAlpha + cosMAlpha[k - 1] * sinAlpha;
+    }
+
+    for (int n = 0; n <= c_maxZernikeRank; ++n) {
+      for (int m = n % 2; m <= n; m += 2) {
+        double radial = 0.0;
+        for (int power = m; power <= n; power += 2)
+          radial += m_zernikeRadialCoefficients[n][m][power] * rhoPower[power];
+        const double weightedRadial = projectedDigit.energy * radial;
+        sumRe[n][m] += weightedRadial * cosMAlpha[m];
+        sumIm[n][m] -= weightedRadial * sinMAlpha[m];
+      }
+    }
   }
-  return (n + 1.0) / TMath::Pi() * std::abs(sum) / totalEnergy;
+
+  for (int n = 0; n <= c_maxZernikeRank; ++n)
+    for (int m = n % 2; m <= n; m += 2)
+      absZernikeMoments[n][m] = (n + 1.0) / TMath::Pi() * std::hypot(sumRe[n][m], sumIm[n][m]) / totalEnergy;
 }
 
 double ECLShowerShapeModule::computeSecondMoment(const std::vector<ProjectedECLDigit>& projectedDigits,
@@ -478,7 +506,7 @@ double ECLShowerShapeModule::computeE1oE9(const ECLShower& shower) const
   if (centralCellId == 0) return 0.0; //cell id starts at 1
 
   // get list of 9 neighbour ids
-  const std::vector< short int > n9 = m_neighbourMap9->getNeighbours(centralCellId);
+  const std::vector< short int >& n9 = m_neighbourMap9->getNeighbours(centralCellId);
 
   double energy1 = 0.0; // to check: 'highest energy' data member may not always be the right one
   double energy9 = 0.0;
@@ -515,8 +543,8 @@ double ECLShowerShapeModule::computeE9oE21(const ECLShower& shower) const
   if (centralCellId == 0) return 0.0; //cell id starts at 1
 
   // get list of 9 and 21 neighbour ids
-  const std::vector< short int > n9 = m_neighbourMap9->getNeighbours(centralCellId);
-  const std::vector< short int > n21 = m_neighbourMap21->getNeighbours(centralCellId);
+  const std::vector< short int >& n9 = m_neighbourMap9->getNeighbours(centralCellId);
+  const std::vector< short int >& n21 = m_neighbourMap21->getNeighbours(centralCellId);
 
   double energy9 = 0.0;
   double energy21 = 0.0;
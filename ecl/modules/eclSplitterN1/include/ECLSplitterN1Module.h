@@ -23,6 +23,8 @@ class TH1F;
 
 namespace Belle2 {
   class ECLCalDigit;
+  class ECLCalDigitCellTable;
+  class EventMetaData;
   class ECLConnectedRegion;
   class ECLShower;
   class ECLLocalMaximum;
@@ -111,15 +113,15 @@ namespace Belle2 {
                                                   144, 144, 96, 96, 96, 96, 96, 64, 64, 64
                                                  }; /**< Number of crystals per theta ring. */
 
-    /** vector (8736+1 entries) with cell id to store array positions */
-    std::vector< int > m_StoreArrPosition;
-
     /** vector (8736+1 entries) with cell id to store array positions for LM*/
     std::vector< int > m_StoreArrPositionLM;
 
     /** list with all cellid of this connected region */
     std::vector< int > m_cellIdInCR;
 
+    /** vector (8736+1 entries) with cell id to flag if the cell is in this connected region */
+    std::vector< char > m_isCellIdInCR;
+
     /** Neighbour maps */
     ECL::ECLNeighbours* m_NeighbourMap9{nullptr}; /**< 3x3 = 9 neighbours */
     ECL::ECLNeighbours* m_NeighbourMap21{nullptr}; /**< 5x5 neighbours excluding corners = 21 */
@@ -139,6 +141,12 @@ namespace Belle2 {
     /** Store object pointer: EventLevelClusteringInfo. */
     StoreObjPtr<EventLevelClusteringInfo> m_eventLevelClusteringInfo;
 
+    /** Store object pointer: ECLCalDigitCellTable, persistent to allocate it only once. */
+    StoreObjPtr<ECLCalDigitCellTable> m_eclCalDigitCellTable{"", DataStore::c_Persistent};
+
+    /** Store object pointer: EventMetaData. */
+    StoreObjPtr<EventMetaData> m_eventMetaData;
+
     /** Default name ECLCalDigits */
     virtual const char* eclCalDigitArrayName() const
     { return "ECLCalDigits" ; }
@@ -159,6 +167,10 @@ namespace Belle2 {
     virtual const char* eventLevelClusteringInfoName() const
     { return "EventLevelClusteringInfo" ; }
 
+    /** Default name ECLCalDigitCellTable */
+    virtual const char* eclCalDigitCellTableName() const
+    { return "ECLCalDigitCellTable" ; }
+
     /** Geometry */
     ECL::ECLGeometryPar* m_geom{nullptr};
 
@@ -203,6 +215,10 @@ namespace Belle2 {
     virtual const char* eventLevelClusteringInfoName() const override
     { return "EventLevelClusteringInfoPureCsI" ; }
 
+    /** PureCsI name ECLCalDigitCellTablePureCsI */
+    virtual const char* eclCalDigitCellTableName() const override
+    { return "ECLCalDigitCellTablePureCsI" ; }
+
   }; // end of ECLSplitterN1PureCsIModule
 
 } // end of Belle2 namespace
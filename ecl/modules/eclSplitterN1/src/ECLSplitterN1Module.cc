@@ -20,6 +20,7 @@
 #include "TH1F.h"
 
 // FRAMEWORK
+#include <framework/core/EventTimeBudget.h>
 #include <framework/logging/Logger.h>
 #include <framework/utilities/FileSystem.h>
 #include <framework/geometry/B2Vector3.h>
@@ -27,6 +28,7 @@
 // ECL
 #include <ecl/utility/Position.h>
 #include <ecl/dataobjects/ECLCalDigit.h>
+#include <ecl/dataobjects/ECLCalDigitCellTable.h>
 #include <ecl/dataobjects/ECLConnectedRegion.h>
 #include <ecl/dataobjects/ECLLocalMaximum.h>
 #include <ecl/dataobjects/ECLShower.h>
@@ -122,6 +124,8 @@ void ECLSplitterN1Module::initialize()
   m_eclShowers.registerInDataStore(eclShowerArrayName());
   m_eclLocalMaximums.registerInDataStore(eclLocalMaximumArrayName());
   m_eventLevelClusteringInfo.registerInDataStore(eventLevelClusteringInfoName());
+  m_eclCalDigitCellTable.registerInDataStore(eclCalDigitCellTableName(), DataStore::c_DontWriteOut);
+  m_eventMetaData.isRequired();
 
   // Register relations (we probably dont need all, but keep them for now for debugging).
   m_eclShowers.registerRelationTo(m_eclConnectedRegions);
@@ -134,8 +138,8 @@ void ECLSplitterN1Module::initialize()
   m_NeighbourMap21 = new ECLNeighbours("NC", 2); // NC: 5x5 excluding corners = 21
 
   // initialize the vector that gives the relation between cellid and store array position
-  m_StoreArrPosition.resize(8736 + 1);
   m_StoreArrPositionLM.resize(8736 + 1);
+  m_isCellIdInCR.resize(8736 + 1);
 
   // read the Background correction factors (for full background)
   m_fileBackgroundNorm = new TFile(m_fileBackgroundNormName.c_str(), "READ");
@@ -179,11 +183,9 @@ void ECLSplitterN1Module::event()
 {
   B2DEBUG(175, "ECLCRSplitterModule::event()");
 
-  // Fill a vector that can be used to map cellid -> store array position for eclCalDigits.
-  memset(&m_StoreArrPosition[0], -1, m_StoreArrPosition.size() * sizeof m_StoreArrPosition[0]);
-  for (int i = 0; i < m_eclCalDigits.getEntries(); i++) {
-    m_StoreArrPosition[m_eclCalDigits[i]->getCellId()] = i;
-  }
+  // Get the table that maps cellid -> store array position for eclCalDigits, usually filled by the connected region finder.
+  if (!m_eclCalDigitCellTable.isValid()) m_eclCalDigitCellTable.create();
+  if (!m_eclCalDigitCellTable->isFilledFrom(m_eclCalDigits, *m_eventMetaData)) m_eclCalDigitCellTable->fill(m_eclCalDigits, *m_eventMetaData);
 
   // Fill a vector that can be used to map cellid -> store array position for eclLocalMaximums.
   memset(&m_StoreArrPositionLM[0], -1, m_StoreArrPositionLM.size() * sizeof m_StoreArrPositionLM[0]);
@@ -193,6 +195,12 @@ void ECLSplitterN1Module::event()
 
   // Loop over all connected regions
   for (auto& aCR : m_eclConnectedRegions) {
+    // stop splitting if the time budget of the event is exceeded
+    if (EventTimeBudget::isExceeded()) {
+      B2DEBUG(20, "Time budget of the event exceeded, the remaining connected regions are not split.");
+      break;
+    }
+
     // list theat will hold all cellids in this connected region
     m_cellIdInCR.clear();
 
@@ -200,16 +208,20 @@ void ECLSplitterN1Module::event()
 
     m_cellIdInCR.resize(entries);
 
-    // Fill all calDigits ids in this CR into a vector to make them 'find'-able.
+    // Fill all calDigits ids in this CR into a vector and flag them to make them 'find'-able.
     int i = 0;
     for (const auto& caldigit : aCR.getRelationsWith<ECLCalDigit>(eclCalDigitArrayName())) {
       m_cellIdInCR[i] = caldigit.getCellId();
+      m_isCellIdInCR[caldigit.getCellId()] = 1;
       ++i;
     }
 
     // Split and reconstruct the showers in this connected regions.
     splitConnectedRegion(aCR);
 
+    // Reset the flags for the next CR.
+    for (const int cellid : m_cellIdInCR) m_isCellIdInCR[cellid] = 0;
+
   } // end auto& aCR
 
 }
@@ -271,7 +283,7 @@ void ECLSplitterN1Module::splitConnectedRegion(ECLConnectedRegion& aCR)
     aECLShower->addRelationTo(locmaxvector[0]);
 
     const int locmaxcellid = locmaxvector[0]->getCellId();
-    const int pos = m_StoreArrPosition[locmaxcellid];
+    const int pos = m_eclCalDigitCellTable->getStoreArrayPosition(locmaxcellid);
     double highestEnergyID             = (m_eclCalDigits[pos])->getCellId();
     double highestEnergy               = (m_eclCalDigits[pos])->getEnergy();
     double highestEnergyTime           = (m_eclCalDigits[pos])->getTime();
@@ -289,12 +301,10 @@ void ECLSplitterN1Module::splitConnectedRegion(ECLConnectedRegion& aCR)
     // Add neighbours and weights for the shower.
     std::vector<ECLCalDigit> digits;
     std::vector<double> weights;
-    for (auto& neighbourId : neighbourMap->getNeighbours(highestEnergyID)) {
-      const auto it = std::find(m_cellIdInCR.begin(), m_cellIdInCR.end(),
-                                neighbourId); // check if the neighbour is in the list for this CR
-      if (it == m_cellIdInCR.end()) continue; // not in this CR
+    for (const auto& neighbourId : neighbourMap->getNeighbourRange(highestEnergyID)) {
+      if (!m_isCellIdInCR[neighbourId]) continue; // not in this CR
 
-      const int neighbourpos = m_StoreArrPosition[neighbourId];
+      const int neighbourpos = m_eclCalDigitCellTable->getStoreArrayPosition(neighbourId);
       digits.push_back(*m_eclCalDigits[neighbourpos]); // list of digits for position reconstruction
       weights.push_back(1.0); // list of weights (all 1 in this case for now)
       weightSum += 1.0;
@@ -424,7 +434,7 @@ void ECLSplitterN1Module::splitConnectedRegion(ECLConnectedRegion& aCR)
 
       for (const auto& digitpoint : allPoints) {
         const int cellid = digitpoint.first;
-        const int pos = m_StoreArrPosition[cellid];
+        const int pos = m_eclCalDigitCellTable->getStoreArrayPosition(cellid);
         digitVector.push_back(*m_eclCalDigits[pos]);
       }
 
@@ -458,8 +468,7 @@ void ECLSplitterN1Module::splitConnectedRegion(ECLConnectedRegion& aCR)
 
           // if this is the first iteration the shower energy is not know, take the local maximum energy * 1.5.
           if (nIterations == 0) {
-            const int pos = m_StoreArrPosition[locmaxcellid];
-            const double locmaxenergy = m_eclCalDigits[pos]->getEnergy();
+            const double locmaxenergy = m_eclCalDigitCellTable->getEnergy(locmaxcellid);
             centroidEnergyList[locmaxcellid] = 1.5 * locmaxenergy;
           }
 
@@ -474,8 +483,7 @@ void ECLSplitterN1Module::splitConnectedRegion(ECLConnectedRegion& aCR)
             const int digitcellid = digitpoint.first;
             B2Vector3D digitpos = digitpoint.second;
 
-            const int pos = m_StoreArrPosition[digitcellid];
-            const double digitenergy = m_eclCalDigits[pos]->getEnergy();
+            const double digitenergy = m_eclCalDigitCellTable->getEnergy(digitcellid);
 
             double weight            = 0.0;
             double energy            = 0.0;
@@ -500,8 +508,7 @@ void ECLSplitterN1Module::splitConnectedRegion(ECLConnectedRegion& aCR)
               }
 
               // energy of the centroid aka locmax
-              const int thispos = m_StoreArrPosition[centroidcellid];
-              const double thisenergy = m_eclCalDigits[thispos]->getEnergy();
+              const double thisenergy = m_eclCalDigitCellTable->getEnergy(centroidcellid);
 
               // Not  the most efficienct way to get this information, but not worth the thinking yet:
               if (locmaxcellid == centroidcellid) {
@@ -597,10 +604,9 @@ void ECLSplitterN1Module::splitConnectedRegion(ECLConnectedRegion& aCR)
 
         // Get locmax cellid
         const int locmaxcellid = locmaxpoint.first;
-        const int pos = m_StoreArrPosition[locmaxcellid];
 
         B2DEBUG(175, "locmaxcellid: " << locmaxcellid);
-        const double lmenergy = m_eclCalDigits[pos]->getEnergy();
+        const double lmenergy = m_eclCalDigitCellTable->getEnergy(locmaxcellid);
         B2DEBUG(175, "ok: ");
 
         // Get the weight vector.
@@ -652,7 +658,7 @@ void ECLSplitterN1Module::splitConnectedRegion(ECLConnectedRegion& aCR)
       else neighbourMap = m_NeighbourMap21;
 
       // Get the neighbour list.
-      std::vector<short int> neighbourlist = neighbourMap->getNeighbours(locmaxcellid);
+      const ECLNeighbours::NeighbourRange neighbourlist = neighbourMap->getNeighbourRange(locmaxcellid);
 
       // Get the weight vector.
       std::vector < double > myWeights = (*weightMap.find(locmaxcellid)).second;
@@ -671,7 +677,7 @@ void ECLSplitterN1Module::splitConnectedRegion(ECLConnectedRegion& aCR)
         const double weight = myWeights[i];
 
         const int cellid = dig.getCellId();
-        const int pos = m_StoreArrPosition[cellid];
+        const int pos = m_eclCalDigitCellTable->getStoreArrayPosition(cellid);
 
         // Add weighted relations of all CalDigits to the local maximum.
         m_eclLocalMaximums[posLM]->addRelationTo(m_eclCalDigits[pos], weight);
@@ -860,15 +866,12 @@ double ECLSplitterN1Module::estimateEnergy(const int centerid)
 
   double energyEstimation = 0.0;
 
-  for (auto& neighbourId : m_NeighbourMap9->getNeighbours(centerid)) {
+  for (const auto& neighbourId : m_NeighbourMap9->getNeighbourRange(centerid)) {
 
     // Check if this neighbour is in this CR
-    const auto it = std::find(m_cellIdInCR.begin(), m_cellIdInCR.end(),
-                              neighbourId); // check if the neighbour is in the list for this CR
-    if (it == m_cellIdInCR.end()) continue; // not in this CR
+    if (!m_isCellIdInCR[neighbourId]) continue; // not in this CR
 
-    const int pos = m_StoreArrPosition[neighbourId];
-    const double energyNeighbour = m_eclCalDigits[pos]->getEnergy();
+    const double energyNeighbour = m_eclCalDigitCellTable->getEnergy(neighbourId);
 
     energyEstimation += energyNeighbour;
   }
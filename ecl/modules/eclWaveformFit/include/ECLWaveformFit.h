@@ -135,6 +135,25 @@ namespace Belle2 {
 
 
   private:
+    /** Results of the chain of offline fits of one waveform */
+    struct FitResult {
+      ECLDsp::TwoComponentFitType fitType{ECLDsp::poorChi2};  /**< offline fit hypothesis */
+      double baseline{ -1};  /**< fitted baseline */
+      double photonAmp{ -1};  /**< photon template amplitude */
+      double time{ -1};  /**< pulse time */
+      double secondAmp{ -1};  /**< hadron or diode template amplitude */
+      double chi2{ -1};  /**< chi2 of the accepted fit */
+      double savedChi2[3] = { -1, -1, -1};  /**< chi2 of each fit type tried, -1 if not tried */
+      double backgroundPhotonEnergy{ -1};  /**< background photon amplitude */
+      double backgroundPhotonTime{ -1};  /**< background photon time */
+    };
+
+    /** Chain of fits of the waveform of crystal id: photon+hadron, photon+hadron+background photon and photon+diode.
+     *  Without Minuit the fits are done analytically in the amplitudes, which is thread safe. In this case false
+     *  is returned if a fitted parameter exceeds the limits of the corresponding Minuit fit.
+     */
+    bool fitWaveform(const int id, const double* adc, FitResult& result, const bool useMinuit);
+
     StoreArray<ECLDsp> m_eclDSPs;  /**< StoreArray ECLDsp */
     StoreArray<ECLDigit> m_eclDigits;   /**< StoreArray ECLDigit */
 
@@ -155,5 +174,7 @@ namespace Belle2 {
     CovariancePacked m_c[8736] = {};  /**< Packed covariance matrices */
     bool m_CovarianceMatrix{true};  /**< Option to use crystal dependent covariance matrices.*/
     bool m_IsMCFlag{false};  /**< Flag to indicate if running over data or MC.*/
+    bool m_AnalyticFit{true};  /**< Option to solve the amplitudes analytically instead of fitting all parameters with Minuit.*/
+    int m_NumberOfThreads{1};  /**< Number of threads for the analytic fits.*/
   };
 } // end Belle2 namespace
@@ -25,7 +25,12 @@
 #include <TMatrixDSym.h>
 #include <TDecompChol.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
 #include <numeric>
+#include <thread>
 
 using namespace Belle2;
 using namespace ECL;
@@ -176,6 +181,282 @@ namespace {
     aNoise = matrixPacked.sigma;
   }
 
+  // noise level of the default (diagonal) covariance matrix
+  constexpr double c_defaultSigma = 7.5;
+
+  // start values of the photon+hadron fit
+  void getStartValues2h(const double* adc, double& B0, double& A0, double& T0)
+  {
+    double dt = 0.5;
+    double amax = 0;
+    int jmax = 6;
+    for (int j = 0; j < 31; j++) if (amax < adc[j]) { amax = adc[j]; jmax = j;}
+    double sumB0 = 0; int jsum = 0;
+    for (int j = 0; j < 31; j++) if (j < jmax - 3 || jmax + 4 < j) { sumB0 += adc[j]; ++jsum;}
+    B0 = sumB0 / jsum;
+    amax -= B0;
+    if (amax < 0) amax = 10;
+    T0 = dt * (4.5 - jmax);
+    A0 = amax;
+  }
+
+  // start values of the photon+hadron+background photon fit
+  void getStartValues2hExtraPhoton(const double* adc, double& B0, double& A0, double& T0, double& A01, double& T01)
+  {
+    double dt = 0.5;
+    double amax = 0; int jmax = 6;
+    for (int j = 0; j < 31; j++) if (amax < adc[j]) { amax = adc[j]; jmax = j;}
+
+    double amax1 = 0; int jmax1 = 6;
+    for (int j = 0; j < 31; j++)
+      if (j < jmax - 3 || jmax + 4 < j) {
+        if (j == 0  && amax1 < adc[j] && adc[j + 1] < adc[j]) { amax1 = adc[j]; jmax1 = j;}
+        else if (j == 30 && amax1 < adc[j] && adc[j - 1] < adc[j]) { amax1 = adc[j]; jmax1 = j;}
+        else if (amax1 < adc[j] && adc[j + 1] < adc[j] && adc[j - 1] < adc[j]) { amax1 = adc[j]; jmax1 = j;}
+      }
+
+    double sumB0 = 0; int jsum = 0;
+    for (int j = 0; j < 31; j++) if ((j < jmax - 3 || jmax + 4 < j) && (j < jmax1 - 3 || jmax1 + 4 < j)) { sumB0 += adc[j]; ++jsum;}
+    B0 = sumB0 / jsum;
+    amax -= B0; amax = std::max(10.0, amax);
+    amax1 -= B0; amax1 = std::max(10.0, amax1);
+    T0 = dt * (4.5 - jmax);
+    T01 = dt * (4.5 - jmax1);
+    A0 = amax;
+    A01 = amax1;
+  }
+
+  // Fit of a waveform to a baseline plus a sum of templates at given times. The model is linear in the baseline
+  // and the amplitudes, so for given times they are the weighted least squares solution and the chi2 is
+  // a function of the times only.
+  class LinearWaveformFit {
+  public:
+    static constexpr int c_ns = 31; // number of samples
+    static constexpr int c_maxTemplates = 3; // maximal number of templates
+
+    LinearWaveformFit(const double* adc, const CovariancePacked* packed)
+    {
+      // inflate the inverse covariance matrix, a diagonal one if none is given
+      int count = 0;
+      for (int i = 0; i < c_ns; i++) {
+        for (int j = 0; j < i + 1; j++) {
+          if (packed) m_W[i][j] = m_W[j][i] = (*packed)[count++];
+          else m_W[i][j] = m_W[j][i] = (i == j) / (c_defaultSigma * c_defaultSigma);
+        }
+      }
+
+      // products not depending on the templates
+      m_yWy = 0;
+      m_1W1 = 0;
+      for (int i = 0; i < c_ns; i++) {
+        m_y[i] = adc[i];
+        m_Wy[i] = std::inner_product(m_W[i], m_W[i] + c_ns, adc, 0.0);
+        m_W1[i] = std::accumulate(m_W[i], m_W[i] + c_ns, 0.0);
+        m_yWy += m_y[i] * m_Wy[i];
+        m_1W1 += m_W1[i];
+      }
+      m_1Wy = std::accumulate(m_Wy, m_Wy + c_ns, 0.0);
+    }
+
+    // minimal chi2 for the given template values, p returns the baseline followed by the amplitudes
+    double solve(const int nTemplates, const val_der_t* const* templates, double* p) const
+    {
+      const int n = nTemplates + 1;
+      double M[c_maxTemplates + 1][c_maxTemplates + 2]; // normal equations, last column is the right hand side
+
+      M[0][0] = m_1W1;
+      M[0][n] = m_1Wy;
+      for (int k = 0; k < nTemplates; k++) {
+        const val_der_t* u = templates[k];
+        double Wu[c_ns];
+        for (int i = 0; i < c_ns; i++) {
+          double sum = 0;
+          for (int j = 0; j < c_ns; j++) sum += m_W[i][j] * u[j].f0;
+          Wu[i] = sum;
+        }
+        double uW1 = 0, uWy = 0;
+        for (int i = 0; i < c_ns; i++) {
+          uW1 += u[i].f0 * m_W1[i];
+          uWy += u[i].f0 * m_Wy[i];
+        }
+        M[0][k + 1] = M[k + 1][0] = uW1;
+        M[k + 1][n] = uWy;
+        for (int l = 0; l <= k; l++) {
+          double uWu = 0;
+          for (int i = 0; i < c_ns; i++) uWu += templates[l][i].f0 * Wu[i];
+          M[k + 1][l + 1] = M[l + 1][k + 1] = uWu;
+        }
+      }
+
+      // Gaussian elimination with partial pivoting, keep the right hand side for the chi2
+      double r[c_maxTemplates + 1];
+      for (int i = 0; i < n; i++) r[i] = M[i][n];
+      for (int c = 0; c < n; c++) {
+        int piv = c;
+        for (int i = c + 1; i < n; i++) if (std::abs(M[i][c]) > std::abs(M[piv][c])) piv = i;
+        if (M[piv][c] == 0) return std::numeric_limits<double>::infinity();
+        if (piv != c) for (int j = c; j <= n; j++) std::swap(M[c][j], M[piv][j]);
+        for (int i = c + 1; i < n; i++) {
+          const double f = M[i][c] / M[c][c];
+          for (int j = c; j <= n; j++) M[i][j] -= f * M[c][j];
+        }
+      }
+      for (int i = n - 1; i >= 0; i--) {
+        double sum = M[i][n];
+        for (int j = i + 1; j < n; j++) sum -= M[i][j] * p[j];
+        p[i] = sum / M[i][i];
+      }
+
+      double chi2 = m_yWy;
+      for (int i = 0; i < n; i++) chi2 -= p[i] * r[i];
+      return chi2;
+    }
+
+    // chi2 of the given parameters, evaluated from the residuals
+    double chi2(const int nTemplates, const val_der_t* const* templates, const double* p) const
+    {
+      double df[c_ns];
+      for (int i = 0; i < c_ns; i++) {
+        df[i] = m_y[i] - p[0];
+        for (int k = 0; k < nTemplates; k++) df[i] -= p[k + 1] * templates[k][i].f0;
+      }
+      double chi2 = 0;
+      for (int i = 0; i < c_ns; i++) chi2 += df[i] * std::inner_product(m_W[i], m_W[i] + c_ns, df, 0.0);
+      return chi2;
+    }
+
+  private:
+    double m_W[c_ns][c_ns]; // inverse covariance matrix
+    double m_y[c_ns]; // samples
+    double m_Wy[c_ns]; // W * y
+    double m_W1[c_ns]; // W * 1
+    double m_yWy; // y^T * W * y
+    double m_1W1; // 1^T * W * 1
+    double m_1Wy; // 1^T * W * y
+  };
+
+  // Brent's method to minimise f in [a, b] starting from x, returns the position of the minimum
+  template <typename F>
+  double minimizeBrent(const F& f, double a, double b, double x, double& fx)
+  {
+    const double cgold = 0.3819660, tol = 1e-5, zeps = 1e-10;
+    double w = x, v = x, fw, fv, d = 0, e = 0;
+    fx = fw = fv = f(x);
+    for (int iter = 0; iter < 100; iter++) {
+      const double xm = 0.5 * (a + b);
+      const double tol1 = tol * std::abs(x) + zeps, tol2 = 2 * tol1;
+      if (std::abs(x - xm) <= tol2 - 0.5 * (b - a)) break;
+      bool golden = true;
+      if (std::abs(e) > tol1) {
+        // parabolic step
+        double r = (x - w) * (fx - fv);
+        double q = (x - v) * (fx - fw);
+        double p = (x - v) * q - (x - w) * r;
+        q = 2 * (q - r);
+        if (q > 0) p = -p;
+        q = std::abs(q);
+        const double etemp = e;
+        e = d;
+        if (std::abs(p) < std::abs(0.5 * q * etemp) && p > q * (a - x) && p < q * (b - x)) {
+          d = p / q;
+          const double u = x + d;
+          if (u - a < tol2 || b - u < tol2) d = std::copysign(tol1, xm - x);
+          golden = false;
+        }
+      }
+      if (golden) {
+        e = (x >= xm) ? a - x : b - x;
+        d = cgold * e;
+      }
+      const double u = std::abs(d) >= tol1 ? x + d : x + std::copysign(tol1, d);
+      const double fu = f(u);
+      if (fu <= fx) {
+        if (u >= x) a = x; else b = x;
+        v = w; fv = fw;
+        w = x; fw = fx;
+        x = u; fx = fu;
+      } else {
+        if (u < x) a = u; else b = u;
+        if (fu <= fw || w == x) {
+          v = w; fv = fw;
+          w = u; fw = fu;
+        } else if (fu <= fv || v == x || v == w) {
+          v = u; fv = fu;
+        }
+      }
+    }
+    return x;
+  }
+
+  // returns true if x is within the limits given in arbitrary order
+  bool inLimits(double x, double l0, double l1)
+  {
+    return std::min(l0, l1) <= x && x <= std::max(l0, l1);
+  }
+
+  // analytic version of ECLWaveformFitModule::Fit2h
+  bool fit2hAnalytic(const LinearWaveformFit& fit, const double* adc, const SignalInterpolation2& si,
+                     const SignalInterpolation2& sih, double& B, double& Ag, double& T, double& Ah, double& chi2)
+  {
+    double B0, A0, T0;
+    getStartValues2h(adc, B0, A0, T0);
+
+    val_der_t ADg[31], ADh[31];
+    const val_der_t* templates[2] = {ADg, ADh};
+    double p[3];
+    auto profile = [&](double t) {
+      si.getshape(t, ADg);
+      sih.getshape(t, ADh);
+      return fit.solve(2, templates, p);
+    };
+    T = minimizeBrent(profile, T0 - 2.5, T0 + 2.5, T0, chi2);
+    profile(T);
+    B = p[0]; Ag = p[1]; Ah = p[2];
+    chi2 = fit.chi2(2, templates, p);
+
+    return inLimits(B, B0 / 1.5, B0 * 1.5) && inLimits(Ag, 0, 2 * A0) && inLimits(Ah, -A0, 2 * A0);
+  }
+
+  // analytic version of ECLWaveformFitModule::Fit2hExtraPhoton, the two times are minimised alternately
+  bool fit2hExtraPhotonAnalytic(const LinearWaveformFit& fit, const double* adc, const SignalInterpolation2& si,
+                                const SignalInterpolation2& sih, double& B, double& Ag, double& T, double& Ah,
+                                double& A2, double& T2, double& chi2)
+  {
+    double B0, A0, T0, A01, T01;
+    getStartValues2hExtraPhoton(adc, B0, A0, T0, A01, T01);
+
+    val_der_t ADg[31], ADh[31], AD2[31];
+    const val_der_t* templates[3] = {ADg, ADh, AD2};
+    double p[4];
+    auto profileT = [&](double t) {
+      si.getshape(t, ADg);
+      sih.getshape(t, ADh);
+      return fit.solve(3, templates, p);
+    };
+    auto profileT2 = [&](double t) {
+      si.getshape(t, AD2);
+      return fit.solve(3, templates, p);
+    };
+
+    T = T0; T2 = T01;
+    si.getshape(T2, AD2);
+    for (int iter = 0; iter < 20; iter++) {
+      const double Tprev = T, T2prev = T2;
+      T = minimizeBrent(profileT, T0 - 2.5, T0 + 2.5, T, chi2);
+      si.getshape(T, ADg);
+      sih.getshape(T, ADh);
+      T2 = minimizeBrent(profileT2, T01 - 2.5, T01 + 2.5, T2, chi2);
+      si.getshape(T2, AD2);
+      if (std::abs(T - Tprev) < 1e-4 && std::abs(T2 - T2prev) < 1e-4) break;
+    }
+    fit.solve(3, templates, p);
+    B = p[0]; Ag = p[1]; Ah = p[2]; A2 = p[3];
+    chi2 = fit.chi2(3, templates, p);
+
+    return inLimits(B, B0 / 1.5, B0 * 1.5) && inLimits(Ag, 0, 2 * A0) && inLimits(Ah, -A0, 2 * A0)
+           && inLimits(A2, 0, 2 * A01);
+  }
+
 }
 
 // constructor
@@ -189,6 +470,10 @@ ECLWaveformFitModule::ECLWaveformFitModule()
   addParam("Chi2Threshold27dof", m_chi2Threshold27dof, "chi2 threshold (27 dof) to classify offline fit as good fit.", 60.0);
   addParam("CovarianceMatrix", m_CovarianceMatrix,
            "Option to use crystal dependent covariance matrices (false uses identity matrix).", true);
+  addParam("AnalyticFit", m_AnalyticFit,
+           "Option to solve the baseline and amplitudes analytically and minimise only the times. "
+           "Waveforms with parameters beyond the Minuit limits are refitted with Minuit (false uses Minuit for all).", true);
+  addParam("NumberOfThreads", m_NumberOfThreads, "Number of threads used for the analytic fits.", 1);
 }
 
 // destructor
@@ -257,7 +542,7 @@ void ECLWaveformFitModule::beginRun()
     }
   } else {
     //default covariance matrix is identity for all crystals
-    const double isigma = 1 / 7.5;
+    const double isigma = 1 / c_defaultSigma;
     currentCovMat.clear();
     currentCovMat.resize(31);
     for (int i = 0; i < 31; ++i) {
@@ -321,6 +606,8 @@ void ECLWaveformFitModule::event()
     if (m_eclDSPs.getEntries() > 0)  loadTemplateParameterArray();
   }
 
+  // waveforms to fit
+  std::vector<ECLDsp*> dsps;
   for (auto& aECLDsp : m_eclDSPs) {
 
     aECLDsp.setTwoComponentTotalAmp(-1);
@@ -336,9 +623,6 @@ void ECLWaveformFitModule::event()
 
     const int id = aECLDsp.getCellId() - 1;
 
-    //Filling array with ADC values.
-    for (int j = 0; j < ec.m_nsmp; j++) fitA[j] = aECLDsp.getDspA()[j];
-
     //setting relation of eclDSP to aECLDigit
     const ECLDigit* d = nullptr;
     for (const auto& aECLDigit : m_eclDigits) {
@@ -353,68 +637,132 @@ void ECLWaveformFitModule::event()
     //Skipping low amplitude waveforms
     if (d->getAmp() * m_ADCtoEnergy[id] < m_EnergyThreshold)  continue;
 
-    //loading template for waveform
-    if (m_IsMCFlag == 0) {
-      //data cell id dependent
-      g_si = &m_si[id][0];
-      g_sih = &m_si[id][1];
-    } else {
-      // mc uses same waveform
-      g_si = &m_si[0][0];
-      g_sih = &m_si[0][1];
-    }
+    dsps.push_back(&aECLDsp);
+  }
 
-    //get covariance matrix for cell id
-    if (m_CovarianceMatrix)  unpackcovariance(m_c[id]);
+  std::vector<FitResult> results(dsps.size());
+  std::vector<char> done(dsps.size(), false);
 
-    //Calling optimized fit photon template + hadron template (fit type = 0)
-    double p2_b, p2_a, p2_t, p2_a1, p2_chi2, p_extraPhotonEnergy, p_extraPhotonTime;
-    ECLDsp::TwoComponentFitType fitType = ECLDsp::photonHadron;
-    p2_chi2 = -1;
-    Fit2h(p2_b, p2_a, p2_t, p2_a1, p2_chi2);
-    aECLDsp.setTwoComponentSavedChi2(ECLDsp::photonHadron, p2_chi2);
-
-    //if hadron fit failed try hadron + background photon (fit type = 1)
-    if (p2_chi2 >= m_chi2Threshold27dof) {
-
-      fitType = ECLDsp::photonHadronBackgroundPhoton;
-      p2_chi2 = -1;
-      Fit2hExtraPhoton(p2_b, p2_a, p2_t, p2_a1, p_extraPhotonEnergy, p_extraPhotonTime, p2_chi2);
-      aECLDsp.setTwoComponentSavedChi2(ECLDsp::photonHadronBackgroundPhoton, p2_chi2);
-
-      //hadron + background photon fit failed try diode fit (fit type = 2)
-      if (p2_chi2 >= m_chi2Threshold25dof) {
-        g_sih = &m_si[0][2];//set second component to diode
-        fitType = ECLDsp::photonDiodeCrossing;
-        p2_chi2 = -1;
-        Fit2h(p2_b, p2_a, p2_t, p2_a1, p2_chi2);
-        aECLDsp.setTwoComponentSavedChi2(ECLDsp::photonDiodeCrossing, p2_chi2);
-
-        if (p2_chi2 >= m_chi2Threshold27dof) fitType = ECLDsp::poorChi2;  //indicates all fits tried had bad chi2
-      }
+  auto fitDsp = [&](const size_t i, const bool useMinuit) {
+    //Filling array with ADC values.
+    int dspA[31];
+    dsps[i]->getDspA(dspA);
+    double adc[31];
+    for (int j = 0; j < ec.m_nsmp; j++) adc[j] = dspA[j];
+    done[i] = fitWaveform(dsps[i]->getCellId() - 1, adc, results[i], useMinuit);
+  };
 
+  //Analytic fits do not use any shared state, so they can be distributed over threads
+  if (m_AnalyticFit) {
+    const int nThreads = std::min<int>(m_NumberOfThreads, dsps.size());
+    if (nThreads > 1) {
+      std::atomic<size_t> next(0);
+      auto worker = [&]() {
+        for (size_t i = next++; i < dsps.size(); i = next++) fitDsp(i, false);
+      };
+      std::vector<std::thread> threads;
+      for (int t = 0; t < nThreads; t++) threads.emplace_back(worker);
+      for (auto& thread : threads) thread.join();
+    } else {
+      for (size_t i = 0; i < dsps.size(); i++) fitDsp(i, false);
     }
+  }
+
+  //Minuit fits for all waveforms not handled analytically
+  for (size_t i = 0; i < dsps.size(); i++) {
+    if (!done[i]) fitDsp(i, true);
+  }
 
-    //storing fit results
-    aECLDsp.setTwoComponentTotalAmp(p2_a + p2_a1);
-    if (fitType == ECLDsp::photonDiodeCrossing) {
+  //storing fit results
+  for (size_t i = 0; i < dsps.size(); i++) {
+    ECLDsp& aECLDsp = *dsps[i];
+    const FitResult& r = results[i];
+    aECLDsp.setTwoComponentSavedChi2(ECLDsp::photonHadron, r.savedChi2[ECLDsp::photonHadron]);
+    aECLDsp.setTwoComponentSavedChi2(ECLDsp::photonHadronBackgroundPhoton, r.savedChi2[ECLDsp::photonHadronBackgroundPhoton]);
+    aECLDsp.setTwoComponentSavedChi2(ECLDsp::photonDiodeCrossing, r.savedChi2[ECLDsp::photonDiodeCrossing]);
+    aECLDsp.setTwoComponentTotalAmp(r.photonAmp + r.secondAmp);
+    if (r.fitType == ECLDsp::photonDiodeCrossing) {
       aECLDsp.setTwoComponentHadronAmp(0.0);
-      aECLDsp.setTwoComponentDiodeAmp(p2_a1);
+      aECLDsp.setTwoComponentDiodeAmp(r.secondAmp);
     } else {
-      aECLDsp.setTwoComponentHadronAmp(p2_a1);
+      aECLDsp.setTwoComponentHadronAmp(r.secondAmp);
       aECLDsp.setTwoComponentDiodeAmp(0.0);
     }
-    aECLDsp.setTwoComponentChi2(p2_chi2);
-    aECLDsp.setTwoComponentTime(p2_t);
-    aECLDsp.setTwoComponentBaseline(p2_b);
-    aECLDsp.setTwoComponentFitType(fitType);
-    if (fitType == ECLDsp::photonHadronBackgroundPhoton) {
-      aECLDsp.setbackgroundPhotonEnergy(p_extraPhotonEnergy);
-      aECLDsp.setbackgroundPhotonTime(p_extraPhotonTime);
+    aECLDsp.setTwoComponentChi2(r.chi2);
+    aECLDsp.setTwoComponentTime(r.time);
+    aECLDsp.setTwoComponentBaseline(r.baseline);
+    aECLDsp.setTwoComponentFitType(r.fitType);
+    if (r.fitType == ECLDsp::photonHadronBackgroundPhoton) {
+      aECLDsp.setbackgroundPhotonEnergy(r.backgroundPhotonEnergy);
+      aECLDsp.setbackgroundPhotonTime(r.backgroundPhotonTime);
     }
   }
 }
 
+bool ECLWaveformFitModule::fitWaveform(const int id, const double* adc, FitResult& r, const bool useMinuit)
+{
+  r = FitResult();
+
+  //loading template for waveform
+  const SignalInterpolation2* si = &m_si[0][0];
+  const SignalInterpolation2* sih = &m_si[0][1];
+  if (m_IsMCFlag == 0) {
+    //data cell id dependent
+    si = &m_si[id][0];
+    sih = &m_si[id][1];
+  }
+
+  //the analytic fit needs the covariance matrix for cell id, Minuit the global copies
+  const LinearWaveformFit fit(adc, m_CovarianceMatrix ? &m_c[id] : nullptr);
+  if (useMinuit) {
+    std::copy(adc, adc + 31, fitA.begin());
+    g_si = si;
+    if (m_CovarianceMatrix)  unpackcovariance(m_c[id]);
+  }
+
+  auto fitPhotonAndSecond = [&](const SignalInterpolation2 * second) {
+    if (useMinuit) {
+      g_sih = second;
+      Fit2h(r.baseline, r.photonAmp, r.time, r.secondAmp, r.chi2);
+      return true;
+    }
+    return fit2hAnalytic(fit, adc, *si, *second, r.baseline, r.photonAmp, r.time, r.secondAmp, r.chi2);
+  };
+
+  //Calling optimized fit photon template + hadron template (fit type = 0)
+  r.fitType = ECLDsp::photonHadron;
+  r.chi2 = -1;
+  if (!fitPhotonAndSecond(sih)) return false;
+  r.savedChi2[ECLDsp::photonHadron] = r.chi2;
+
+  //if hadron fit failed try hadron + background photon (fit type = 1)
+  if (r.chi2 >= m_chi2Threshold27dof) {
+
+    r.fitType = ECLDsp::photonHadronBackgroundPhoton;
+    r.chi2 = -1;
+    if (useMinuit) {
+      g_sih = sih;
+      Fit2hExtraPhoton(r.baseline, r.photonAmp, r.time, r.secondAmp, r.backgroundPhotonEnergy, r.backgroundPhotonTime, r.chi2);
+    } else if (!fit2hExtraPhotonAnalytic(fit, adc, *si, *sih, r.baseline, r.photonAmp, r.time, r.secondAmp,
+                                         r.backgroundPhotonEnergy, r.backgroundPhotonTime, r.chi2)) {
+      return false;
+    }
+    r.savedChi2[ECLDsp::photonHadronBackgroundPhoton] = r.chi2;
+
+    //hadron + background photon fit failed try diode fit (fit type = 2)
+    if (r.chi2 >= m_chi2Threshold25dof) {
+      r.fitType = ECLDsp::photonDiodeCrossing;
+      r.chi2 = -1;
+      if (!fitPhotonAndSecond(&m_si[0][2])) return false; //set second component to diode
+      r.savedChi2[ECLDsp::photonDiodeCrossing] = r.chi2;
+
+      if (r.chi2 >= m_chi2Threshold27dof) r.fitType = ECLDsp::poorChi2;  //indicates all fits tried had bad chi2
+    }
+
+  }
+  return true;
+}
+
 // end run
 void ECLWaveformFitModule::endRun()
 {
@@ -433,17 +781,8 @@ void ECLWaveformFitModule::Fit2h(double& B, double& Ag, double& T, double& Ah, d
   int ierflg = 0;
 
   // setting inital fit parameters
-  double dt = 0.5;
-  double amax = 0;
-  int jmax = 6;
-  for (int j = 0; j < 31; j++) if (amax < fitA[j]) { amax = fitA[j]; jmax = j;}
-  double sumB0 = 0; int jsum = 0;
-  for (int j = 0; j < 31; j++) if (j < jmax - 3 || jmax + 4 < j) { sumB0 += fitA[j]; ++jsum;}
-  double B0 = sumB0 / jsum;
-  amax -= B0;
-  if (amax < 0) amax = 10;
-  double T0 = dt * (4.5 - jmax);
-  double A0 = amax;
+  double B0, A0, T0;
+  getStartValues2h(fitA.data(), B0, A0, T0);
 
   //initalize minimizer
   m_Minit2h->mnparm(0, "B",  B0,    10, B0 / 1.5, B0 * 1.5, ierflg);
@@ -473,27 +812,9 @@ void ECLWaveformFitModule::Fit2hExtraPhoton(double& B, double& Ag, double& T, do
 {
   double arglist[10];
   int ierflg = 0;
-  double dt = 0.5;
-  double amax = 0; int jmax = 6;
-  for (int j = 0; j < 31; j++) if (amax < fitA[j]) { amax = fitA[j]; jmax = j;}
-
-  double amax1 = 0; int jmax1 = 6;
-  for (int j = 0; j < 31; j++)
-    if (j < jmax - 3 || jmax + 4 < j) {
-      if (j == 0  && amax1 < fitA[j] && fitA[j + 1] < fitA[j]) { amax1 = fitA[j]; jmax1 = j;}
-      else if (j == 30 && amax1 < fitA[j] && fitA[j - 1] < fitA[j]) { amax1 = fitA[j]; jmax1 = j;}
-      else if (amax1 < fitA[j] && fitA[j + 1] < fitA[j] && fitA[j - 1] < fitA[j]) { amax1 = fitA[j]; jmax1 = j;}
-    }
-
-  double sumB0 = 0; int jsum = 0;
-  for (int j = 0; j < 31; j++) if ((j < jmax - 3 || jmax + 4 < j) && (j < jmax1 - 3 || jmax1 + 4 < j)) { sumB0 += fitA[j]; ++jsum;}
-  double B0 = sumB0 / jsum;
-  amax -= B0; amax = std::max(10.0, amax);
-  amax1 -= B0; amax1 = std::max(10.0, amax1);
-  double T0 = dt * (4.5 - jmax);
-  double T01 = dt * (4.5 - jmax1);
+  double B0, A0, T0, A01, T01;
+  getStartValues2hExtraPhoton(fitA.data(), B0, A0, T0, A01, T01);
 
-  double A0 = amax, A01 = amax1;
   m_Minit2h2->mnparm(0, "B",  B0,    10, B0 / 1.5, B0 * 1.5, ierflg);
   m_Minit2h2->mnparm(1, "Ag", A0, A0 / 20,      0,   2 * A0, ierflg);
   m_Minit2h2->mnparm(2, "T",  T0,   0.5, T0 - 2.5, T0 + 2.5, ierflg);
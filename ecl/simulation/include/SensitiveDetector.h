@@ -42,6 +42,16 @@ namespace Belle2 {
       /** Do what you want to do at the end of each event */
       void EndOfEvent(G4HCofThisEvent* eventHC) override;
 
+      /**
+       * Create an ECLSimHit for the energy deposited in a crystal by a shower of the fast simulation (see ShowerLibraryModel).
+       * All quantities are in Geant4 units, the cell id starts at 0.
+       */
+      void saveShowerHit(G4int cellId, G4int trackID, G4int pid, G4double tof, G4double edep, const G4ThreeVector& mom,
+                         const G4ThreeVector& pos)
+      {
+        saveSimHit(cellId, trackID, pid, tof, edep, mom, pos, 0);
+      }
+
     private:
       TGraph* m_HadronEmissionFunction = nullptr;  /**< Graph for hadron scintillation component emission function */
       double GetHadronIntensityFromDEDX(double);  /**< Evaluates hadron scintillation component emission function */
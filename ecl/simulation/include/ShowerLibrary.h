@@ -0,0 +1,142 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Belle2 {
+  namespace ECL {
+
+    /**
+     * Library of frozen electromagnetic showers in the ECL, used by the ShowerLibraryModel.
+     *
+     * Each shower is stored together with the type (photon or electron/positron), the kinetic
+     * energy and the incidence angle (with respect to the axis of the hit crystal) of the particle
+     * entering the ECL and the region of the hit crystal. The energy deposits of a shower are
+     * given in the shower frame (see ShowerLibraryModel::getShowerFrame) relative to the entry
+     * point of the particle, with their energy as fraction of the particle energy and their time
+     * relative to the entry time.
+     *
+     * The showers are grouped into bins of energy and incidence angle for each particle type and
+     * region. The bin edges are stored in the library file together with the showers.
+     */
+    class ShowerLibrary {
+
+    public:
+
+      /** Detector regions with separate showers */
+      enum ERegion {
+        c_Forward = 0,  /**< forward endcap */
+        c_Barrel = 1,   /**< barrel */
+        c_Backward = 2, /**< backward endcap */
+        c_NumberOfRegions = 3 /**< number of regions */
+      };
+
+      /** Particle types with separate showers */
+      enum EParticle {
+        c_Photon = 0,   /**< photon */
+        c_Electron = 1, /**< electron or positron */
+        c_NumberOfParticles = 2 /**< number of particle types */
+      };
+
+      /** A single energy deposit of a shower */
+      struct Deposit {
+        float x = 0; /**< first transverse coordinate in cm */
+        float y = 0; /**< second transverse coordinate in cm */
+        float z = 0; /**< longitudinal coordinate in cm */
+        float energyFraction = 0; /**< deposited energy as fraction of the particle energy */
+        float time = 0; /**< time after the entry of the particle in ns */
+      };
+
+      /** A frozen shower */
+      struct Shower {
+        double energy = 0; /**< kinetic energy of the particle in GeV */
+        double angle = 0; /**< incidence angle of the particle in rad */
+        int particle = c_Photon; /**< type of the particle */
+        int region = c_Barrel; /**< region of the hit crystal */
+        std::vector<Deposit> deposits; /**< energy deposits */
+      };
+
+      /** Create an empty library, e.g. to read it from a file */
+      ShowerLibrary() = default;
+
+      /**
+       * Create an empty library with the given binning.
+       * @param energyBins edges of the energy bins in GeV
+       * @param angleBins edges of the incidence angle bins in rad
+       */
+      ShowerLibrary(const std::vector<double>& energyBins, const std::vector<double>& angleBins);
+
+      /** Add a shower to its bin. Returns false if it is outside of the binning. */
+      bool addShower(const Shower& shower);
+
+      /**
+       * Get a shower for a particle with the given properties.
+       *
+       * The shower is chosen from the bin of the particle by the given random number. If
+       * this bin is empty, the closest bin with showers of the same particle type and region
+       * is used (in energy first).
+       * @param particle type of the particle
+       * @param region region of the hit crystal
+       * @param energy kinetic energy of the particle in GeV
+       * @param angle incidence angle of the particle in rad
+       * @param random uniformly distributed random number in [0, 1)
+       * @return nullptr if there are no showers for the particle type and region
+       */
+      const Shower* getShower(int particle, int region, double energy, double angle, double random) const;
+
+      /** Are there showers of the given particle type (in any region)? */
+      bool hasShowers(int particle) const;
+
+      /** Total number of showers in the library */
+      unsigned int getNumberOfShowers() const;
+
+      /** Edges of the energy bins in GeV */
+      const std::vector<double>& getEnergyBins() const { return m_energyBins; }
+
+      /** Edges of the incidence angle bins in rad */
+      const std::vector<double>& getAngleBins() const { return m_angleBins; }
+
+      /** Write the library to a ROOT file */
+      void write(const std::string& fileName) const;
+
+      /** Read the library from a ROOT file, replacing the current content */
+      void read(const std::string& fileName);
+
+      /** Get the region of the crystal with the given cell id (starting at 0) */
+      static ERegion getRegion(int cellId);
+
+      /** Get the particle type of the given PDG code, -1 if there are no showers for it */
+      static int getParticle(int pdgCode);
+
+    private:
+
+      /** Get the bin index of the value (-1 if outside of the binning) */
+      static int getBin(const std::vector<double>& edges, double value);
+
+      /** Get the bin index of the value, using the first or last bin if it is outside */
+      static int getClosestBin(const std::vector<double>& edges, double value);
+
+      /** Get the index in m_showers */
+      unsigned int getIndex(int particle, int region, int energyBin, int angleBin) const;
+
+      /** Create the empty bins for the current binning */
+      void createBins();
+
+      /** Edges of the energy bins in GeV */
+      std::vector<double> m_energyBins;
+      /** Edges of the incidence angle bins in rad */
+      std::vector<double> m_angleBins;
+      /** The showers in each bin, see getIndex() */
+      std::vector<std::vector<Shower>> m_showers;
+    };
+
+  } // end of namespace ECL
+} // end of namespace Belle2
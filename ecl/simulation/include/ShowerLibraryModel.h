@@ -0,0 +1,107 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#pragma once
+
+#include <ecl/simulation/ShowerLibrary.h>
+
+#include <G4VFastSimulationModel.hh>
+#include <G4Navigator.hh>
+#include <G4TouchableHistory.hh>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Belle2 {
+  namespace ECL {
+    class ECLGeometryPar;
+    class SensitiveDetector;
+
+    /**
+     * Geant4 fast simulation model replacing electromagnetic showers in the ECL by frozen
+     * showers from a ShowerLibrary.
+     *
+     * The model is attached to the ECL envelopes. Electrons, positrons and photons entering the
+     * ECL with a kinetic energy above the threshold are not tracked further, if the library
+     * contains showers of their type. Instead, the energy deposits of a library shower of the
+     * same particle type with similar energy, incidence angle and region are placed
+     * into the crystals along the direction of the particle and stored as ECLSimHits (and later
+     * ECLHits) by the ECL SensitiveDetector. Particles created inside of the ECL are always
+     * tracked normally.
+     */
+    class ShowerLibraryModel : public G4VFastSimulationModel {
+
+    public:
+
+      /** Names of the Geant4 regions of the ECL */
+      static const std::vector<std::string> c_regionNames;
+
+      /**
+       * Maximal fraction of the shower energy outside of the crystals which is redistributed to
+       * the other deposits. The energy of larger losses is dropped.
+       */
+      static constexpr double c_maximalRedistributedFraction = 0.1;
+
+      /**
+       * Constructor
+       * @param name name of the model
+       * @param envelope ECL region the model is attached to
+       * @param library shower library shared by all models
+       * @param energyThreshold minimal kinetic energy of the replaced particles (Geant4 units)
+       */
+      ShowerLibraryModel(const std::string& name, G4Region* envelope, std::shared_ptr<const ShowerLibrary> library,
+                         double energyThreshold);
+
+      /** The model is applicable to the particle types (photons, electrons and positrons) contained in the library */
+      G4bool IsApplicable(const G4ParticleDefinition& particle) override;
+
+      /** Trigger the model for particles above the energy threshold entering the ECL */
+      G4bool ModelTrigger(const G4FastTrack& fastTrack) override;
+
+      /** Kill the particle and deposit the energy of a library shower */
+      void DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep) override;
+
+      /** Is the region one of the ECL regions? */
+      static bool isECLRegion(const G4Region* region);
+
+      /**
+       * Get the transverse axes of the shower frame for a particle with the given direction.
+       * The longitudinal axis is the direction itself.
+       */
+      static void getShowerFrame(const G4ThreeVector& direction, G4ThreeVector& u, G4ThreeVector& v);
+
+      /**
+       * Find the crystal hit by a particle, i.e. the crystal whose center is closest to its line of flight.
+       * @param position position of the particle in cm
+       * @param direction direction of the particle
+       * @return cell id starting at 0
+       */
+      static int findCrystal(const G4ThreeVector& position, const G4ThreeVector& direction);
+
+      /** Get the angle between the direction of the particle and the axis of the crystal in rad */
+      static double getIncidenceAngle(int cellId, const G4ThreeVector& direction);
+
+    private:
+
+      /** The shower library */
+      std::shared_ptr<const ShowerLibrary> m_library;
+      /** Minimal kinetic energy of the replaced particles */
+      double m_energyThreshold;
+      /** The ECL sensitive detector to store the hits */
+      SensitiveDetector* m_sensitiveDetector = nullptr;
+      /** Pointer to ECLGeometryPar */
+      ECLGeometryPar* m_eclp = nullptr;
+      /** Navigator to find the crystals of the deposits, independent of the one used for tracking */
+      G4Navigator m_navigator;
+      /** Touchable of the current deposit */
+      G4TouchableHistory m_touchable;
+    };
+
+  } // end of namespace ECL
+} // end of namespace Belle2
@@ -0,0 +1,220 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#include <ecl/simulation/ShowerLibrary.h>
+#include <framework/gearbox/Const.h>
+#include <framework/logging/Logger.h>
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TVectorD.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+
+using namespace Belle2;
+using namespace Belle2::ECL;
+
+ShowerLibrary::ShowerLibrary(const std::vector<double>& energyBins, const std::vector<double>& angleBins):
+  m_energyBins(energyBins), m_angleBins(angleBins)
+{
+  if (m_energyBins.size() < 2 or m_angleBins.size() < 2) {
+    B2FATAL("The ECL shower library needs at least one energy and one angle bin");
+  }
+  createBins();
+}
+
+void ShowerLibrary::createBins()
+{
+  m_showers.clear();
+  m_showers.resize(c_NumberOfParticles * c_NumberOfRegions * (m_energyBins.size() - 1) * (m_angleBins.size() - 1));
+}
+
+unsigned int ShowerLibrary::getIndex(int particle, int region, int energyBin, int angleBin) const
+{
+  return ((particle * c_NumberOfRegions + region) * (m_energyBins.size() - 1) + energyBin) * (m_angleBins.size() - 1) + angleBin;
+}
+
+int ShowerLibrary::getBin(const std::vector<double>& edges, double value)
+{
+  if (value < edges.front() or value >= edges.back()) return -1;
+  return std::upper_bound(edges.begin(), edges.end(), value) - edges.begin() - 1;
+}
+
+int ShowerLibrary::getClosestBin(const std::vector<double>& edges, double value)
+{
+  const int nBins = edges.size() - 1;
+  const int bin = std::upper_bound(edges.begin(), edges.end(), value) - edges.begin() - 1;
+  return std::min(std::max(bin, 0), nBins - 1);
+}
+
+ShowerLibrary::ERegion ShowerLibrary::getRegion(int cellId)
+{
+  if (cellId < 1152) return c_Forward;
+  if (cellId < 7776) return c_Barrel;
+  return c_Backward;
+}
+
+int ShowerLibrary::getParticle(int pdgCode)
+{
+  if (pdgCode == Const::photon.getPDGCode()) return c_Photon;
+  if (abs(pdgCode) == Const::electron.getPDGCode()) return c_Electron;
+  return -1;
+}
+
+bool ShowerLibrary::addShower(const Shower& shower)
+{
+  const int energyBin = getBin(m_energyBins, shower.energy);
+  const int angleBin = getBin(m_angleBins, shower.angle);
+  if (energyBin < 0 or angleBin < 0 or shower.region < 0 or shower.region >= c_NumberOfRegions or
+      shower.particle < 0 or shower.particle >= c_NumberOfParticles) {
+    return false;
+  }
+  m_showers[getIndex(shower.particle, shower.region, energyBin, angleBin)].push_back(shower);
+  return true;
+}
+
+const ShowerLibrary::Shower* ShowerLibrary::getShower(int particle, int region, double energy, double angle,
+                                                      double random) const
+{
+  if (m_showers.empty() or region < 0 or region >= c_NumberOfRegions or particle < 0 or particle >= c_NumberOfParticles) {
+    return nullptr;
+  }
+
+  const int nEnergyBins = m_energyBins.size() - 1;
+  const int nAngleBins = m_angleBins.size() - 1;
+  const int energyBin = getClosestBin(m_energyBins, energy);
+  const int angleBin = getClosestBin(m_angleBins, angle);
+
+  // Look for the closest bin with showers, preferring a different angle over a different energy
+  for (int energyDistance = 0; energyDistance < nEnergyBins; energyDistance++) {
+    for (int angleDistance = 0; angleDistance < nAngleBins; angleDistance++) {
+      for (int energySign : {1, -1}) {
+        for (int angleSign : {1, -1}) {
+          const int e = energyBin + energySign * energyDistance;
+          const int a = angleBin + angleSign * angleDistance;
+          if (e < 0 or e >= nEnergyBins or a < 0 or a >= nAngleBins) continue;
+          const std::vector<Shower>& showers = m_showers[getIndex(particle, region, e, a)];
+          if (showers.empty()) continue;
+          const unsigned int index = std::min<unsigned int>(random * showers.size(), showers.size() - 1);
+          return &showers[index];
+        }
+      }
+    }
+  }
+  return nullptr;
+}
+
+bool ShowerLibrary::hasShowers(int particle) const
+{
+  if (m_showers.empty() or particle < 0 or particle >= c_NumberOfParticles) return false;
+  const unsigned int begin = getIndex(particle, 0, 0, 0);
+  const unsigned int end = getIndex(particle + 1, 0, 0, 0);
+  for (unsigned int index = begin; index < end; index++) {
+    if (not m_showers[index].empty()) return true;
+  }
+  return false;
+}
+
+unsigned int ShowerLibrary::getNumberOfShowers() const
+{
+  unsigned int numberOfShowers = 0;
+  for (const auto& showers : m_showers) numberOfShowers += showers.size();
+  return numberOfShowers;
+}
+
+void ShowerLibrary::write(const std::string& fileName) const
+{
+  TFile file(fileName.c_str(), "RECREATE");
+  if (file.IsZombie()) {
+    B2ERROR("Could not create the ECL shower library file" << LogVar("file", fileName));
+    return;
+  }
+
+  TVectorD energyBins(m_energyBins.size(), m_energyBins.data());
+  TVectorD angleBins(m_angleBins.size(), m_angleBins.data());
+  energyBins.Write("energyBins");
+  angleBins.Write("angleBins");
+
+  Shower shower;
+  std::vector<float> x, y, z, energyFraction, time;
+  TTree tree("showers", "ECL shower library");
+  tree.Branch("energy", &shower.energy);
+  tree.Branch("angle", &shower.angle);
+  tree.Branch("particle", &shower.particle);
+  tree.Branch("region", &shower.region);
+  tree.Branch("x", &x);
+  tree.Branch("y", &y);
+  tree.Branch("z", &z);
+  tree.Branch("energyFraction", &energyFraction);
+  tree.Branch("time", &time);
+  for (const auto& showers : m_showers) {
+    for (const Shower& libraryShower : showers) {
+      shower.energy = libraryShower.energy;
+      shower.angle = libraryShower.angle;
+      shower.particle = libraryShower.particle;
+      shower.region = libraryShower.region;
+      x.clear(); y.clear(); z.clear(); energyFraction.clear(); time.clear();
+      for (const Deposit& deposit : libraryShower.deposits) {
+        x.push_back(deposit.x);
+        y.push_back(deposit.y);
+        z.push_back(deposit.z);
+        energyFraction.push_back(deposit.energyFraction);
+        time.push_back(deposit.time);
+      }
+      tree.Fill();
+    }
+  }
+  tree.Write();
+  file.Close();
+}
+
+void ShowerLibrary::read(const std::string& fileName)
+{
+  std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+  if (!file or file->IsZombie()) {
+    B2FATAL("Could not open the ECL shower library file" << LogVar("file", fileName));
+  }
+  const TVectorD* energyBins = dynamic_cast<TVectorD*>(file->Get("energyBins"));
+  const TVectorD* angleBins = dynamic_cast<TVectorD*>(file->Get("angleBins"));
+  TTree* tree = dynamic_cast<TTree*>(file->Get("showers"));
+  if (!energyBins or !angleBins or !tree) {
+    B2FATAL("The file is not a valid ECL shower library" << LogVar("file", fileName));
+  }
+  m_energyBins.assign(energyBins->GetMatrixArray(), energyBins->GetMatrixArray() + energyBins->GetNrows());
+  m_angleBins.assign(angleBins->GetMatrixArray(), angleBins->GetMatrixArray() + angleBins->GetNrows());
+  createBins();
+
+  Shower shower;
+  std::vector<float>* x = nullptr, *y = nullptr, *z = nullptr, *energyFraction = nullptr, *time = nullptr;
+  tree->SetBranchAddress("energy", &shower.energy);
+  tree->SetBranchAddress("angle", &shower.angle);
+  // Libraries without particle types contain photon showers only
+  if (tree->GetBranch("particle")) tree->SetBranchAddress("particle", &shower.particle);
+  tree->SetBranchAddress("region", &shower.region);
+  tree->SetBranchAddress("x", &x);
+  tree->SetBranchAddress("y", &y);
+  tree->SetBranchAddress("z", &z);
+  tree->SetBranchAddress("energyFraction", &energyFraction);
+  tree->SetBranchAddress("time", &time);
+  for (Long64_t entry = 0; entry < tree->GetEntries(); entry++) {
+    tree->GetEntry(entry);
+    shower.deposits.resize(x->size());
+    for (size_t i = 0; i < x->size(); i++) {
+      shower.deposits[i] = {x->at(i), y->at(i), z->at(i), energyFraction->at(i), time->at(i)};
+    }
+    addShower(shower);
+  }
+  tree->ResetBranchAddresses();
+  delete x; delete y; delete z; delete energyFraction; delete time;
+
+  if (getNumberOfShowers() == 0) {
+    B2FATAL("The ECL shower library is empty" << LogVar("file", fileName));
+  }
+}
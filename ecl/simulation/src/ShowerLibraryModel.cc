@@ -0,0 +1,206 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#include <ecl/simulation/ShowerLibraryModel.h>
+#include <ecl/simulation/SensitiveDetector.h>
+#include <ecl/geometry/ECLGeometryPar.h>
+#include <simulation/kernel/FastSimulationModelFactory.h>
+#include <framework/gearbox/Unit.h>
+#include <framework/logging/Logger.h>
+
+#include <G4FastStep.hh>
+#include <G4FastTrack.hh>
+#include <G4RegionStore.hh>
+#include <G4SDManager.hh>
+#include <G4TransportationManager.hh>
+#include <Randomize.hh>
+
+#include <cmath>
+#include <map>
+
+using namespace Belle2;
+using namespace Belle2::ECL;
+
+const std::vector<std::string> ShowerLibraryModel::c_regionNames = {"ECLForwardEnvelope", "ECLBarrelSector", "ECLBackwardEnvelope"};
+
+namespace {
+  /** Number of ECL crystals */
+  const int c_nCrystals = 8736;
+
+  /** Create the shower library models for all ECL regions */
+  std::vector<G4VFastSimulationModel*> createShowerLibraryModels(const std::string& fileName, double energyThreshold)
+  {
+    auto library = std::make_shared<ShowerLibrary>();
+    library->read(fileName);
+    B2INFO("Using the ECL shower library" << LogVar("file", fileName) << LogVar("showers", library->getNumberOfShowers())
+           << LogVar("energyThreshold", energyThreshold));
+
+    std::vector<G4VFastSimulationModel*> models;
+    for (const std::string& regionName : ShowerLibraryModel::c_regionNames) {
+      G4Region* region = G4RegionStore::GetInstance()->GetRegion(regionName, false);
+      if (!region) {
+        B2WARNING("Cannot find the Geant4 region for the ECL shower library" << LogVar("region", regionName));
+        continue;
+      }
+      models.push_back(new ShowerLibraryModel("ECLShowerLibrary" + regionName, region, library,
+                                              energyThreshold / Unit::GeV * CLHEP::GeV));
+    }
+    return models;
+  }
+
+  /** Register the model with the FastSimulationModelFactory when the library is loaded */
+  struct ShowerLibraryModelRegistration {
+    /** Constructor registering the factory function */
+    ShowerLibraryModelRegistration()
+    {
+      Simulation::FastSimulationModelFactory::registerFactory("ECLShowerLibrary", createShowerLibraryModels);
+    }
+  } showerLibraryModelRegistration;
+
+  /** Energy, energy weighted time and position of the deposits of a shower in one crystal */
+  struct CrystalDeposit {
+    double energy = 0; /**< energy */
+    double time = 0; /**< energy weighted time */
+    G4ThreeVector position; /**< energy weighted position */
+  };
+}
+
+ShowerLibraryModel::ShowerLibraryModel(const std::string& name, G4Region* envelope, std::shared_ptr<const ShowerLibrary> library,
+                                       double energyThreshold):
+  G4VFastSimulationModel(name, envelope), m_library(library), m_energyThreshold(energyThreshold)
+{
+  m_sensitiveDetector = dynamic_cast<SensitiveDetector*>(G4SDManager::GetSDMpointer()->FindSensitiveDetector("ECLSensitiveDetector",
+                                                         false));
+  if (!m_sensitiveDetector) {
+    B2FATAL("The ECL shower library needs the ECL sensitive detector");
+  }
+  m_eclp = ECLGeometryPar::Instance();
+  m_navigator.SetWorldVolume(G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume());
+}
+
+G4bool ShowerLibraryModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+  return m_library->hasShowers(ShowerLibrary::getParticle(particle.GetPDGEncoding()));
+}
+
+G4bool ShowerLibraryModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  if (track->GetKineticEnergy() < m_energyThreshold) return false;
+
+  // Particles created inside of the ECL are part of a shower which is simulated already
+  const G4LogicalVolume* vertexVolume = track->GetLogicalVolumeAtVertex();
+  return vertexVolume == nullptr or not isECLRegion(vertexVolume->GetRegion());
+}
+
+void ShowerLibraryModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  const double energy = track->GetKineticEnergy();
+  const G4ThreeVector& position = track->GetPosition();
+  const G4ThreeVector& direction = track->GetMomentumDirection();
+
+  fastStep.KillPrimaryTrack();
+  fastStep.ProposePrimaryTrackPathLength(0);
+  fastStep.ProposeTotalEnergyDeposited(energy);
+
+  const int cellId = findCrystal(position / CLHEP::cm, direction);
+  const int pdgCode = track->GetDefinition()->GetPDGEncoding();
+  const ShowerLibrary::Shower* shower = m_library->getShower(ShowerLibrary::getParticle(pdgCode), ShowerLibrary::getRegion(cellId),
+                                                             energy / CLHEP::GeV, getIncidenceAngle(cellId, direction),
+                                                             G4UniformRand());
+  if (!shower) return;
+
+  // Showers are symmetric around their axis, so rotate them randomly
+  G4ThreeVector u, v;
+  getShowerFrame(direction, u, v);
+  const double phi = CLHEP::twopi * G4UniformRand();
+  const G4ThreeVector rotatedU = cos(phi) * u + sin(phi) * v;
+  const G4ThreeVector rotatedV = direction.cross(rotatedU);
+
+  // Collect the deposits per crystal. Deposits which end up outside of the crystals (e.g. in
+  // the wrapping of a crystal with different shape) are dropped. If this is only a small
+  // fraction of the shower, their energy is shared by the other deposits, so the total energy
+  // of the shower is conserved. Larger losses (e.g. at the edges of the calorimeter) are real
+  // and the energy is not redistributed.
+  std::map<int, CrystalDeposit> crystalDeposits;
+  double libraryEnergy = 0;
+  double depositedEnergy = 0;
+  for (const ShowerLibrary::Deposit& deposit : shower->deposits) {
+    const double depositEnergy = deposit.energyFraction * energy;
+    libraryEnergy += depositEnergy;
+
+    const G4ThreeVector depositPosition = position + (deposit.x * rotatedU + deposit.y * rotatedV + deposit.z * direction) * CLHEP::cm;
+    m_navigator.LocateGlobalPointAndUpdateTouchable(depositPosition, &m_touchable, false);
+    const G4VPhysicalVolume* volume = m_touchable.GetVolume();
+    if (!volume or volume->GetLogicalVolume()->GetSensitiveDetector() != m_sensitiveDetector) continue;
+
+    CrystalDeposit& crystalDeposit = crystalDeposits[m_eclp->TouchableToCellID(&m_touchable)];
+    crystalDeposit.energy += depositEnergy;
+    crystalDeposit.time += depositEnergy * deposit.time * CLHEP::ns;
+    crystalDeposit.position += depositEnergy * depositPosition;
+    depositedEnergy += depositEnergy;
+  }
+  if (depositedEnergy <= 0) return;
+
+  const double droppedFraction = 1 - depositedEnergy / libraryEnergy;
+  const double scale = droppedFraction <= c_maximalRedistributedFraction ? libraryEnergy / depositedEnergy : 1;
+  const double time = track->GetGlobalTime();
+  for (const auto& crystalDeposit : crystalDeposits) {
+    const CrystalDeposit& d = crystalDeposit.second;
+    m_sensitiveDetector->saveShowerHit(crystalDeposit.first, track->GetTrackID(), pdgCode, time + d.time / d.energy, d.energy * scale,
+                                       track->GetMomentum(), d.position / d.energy);
+  }
+}
+
+bool ShowerLibraryModel::isECLRegion(const G4Region* region)
+{
+  if (!region) return false;
+  for (const std::string& regionName : c_regionNames) {
+    if (region->GetName() == regionName) return true;
+  }
+  return false;
+}
+
+void ShowerLibraryModel::getShowerFrame(const G4ThreeVector& direction, G4ThreeVector& u, G4ThreeVector& v)
+{
+  u = direction.orthogonal().unit();
+  v = direction.cross(u);
+}
+
+int ShowerLibraryModel::findCrystal(const G4ThreeVector& position, const G4ThreeVector& direction)
+{
+  // Crystal positions in cm, filled on first use
+  static std::vector<G4ThreeVector> crystalPositions;
+  if (crystalPositions.empty()) {
+    ECLGeometryPar* eclp = ECLGeometryPar::Instance();
+    crystalPositions.reserve(c_nCrystals);
+    for (int cellId = 0; cellId < c_nCrystals; cellId++) {
+      crystalPositions.push_back(eclp->getCrystalPos(cellId));
+    }
+  }
+
+  int bestCellId = 0;
+  double bestDistance2 = -1;
+  for (int cellId = 0; cellId < c_nCrystals; cellId++) {
+    const G4ThreeVector relative = crystalPositions[cellId] - position;
+    const double longitudinal = relative.dot(direction);
+    if (longitudinal < 0) continue;
+    const double distance2 = relative.mag2() - longitudinal * longitudinal;
+    if (bestDistance2 < 0 or distance2 < bestDistance2) {
+      bestCellId = cellId;
+      bestDistance2 = distance2;
+    }
+  }
+  return bestCellId;
+}
+
+double ShowerLibraryModel::getIncidenceAngle(int cellId, const G4ThreeVector& direction)
+{
+  return direction.angle(ECLGeometryPar::Instance()->getCrystalVec(cellId));
+}
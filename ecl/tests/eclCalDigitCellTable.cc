@@ -0,0 +1,83 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <ecl/dataobjects/ECLCalDigit.h>
+#include <ecl/dataobjects/ECLCalDigitCellTable.h>
+
+#include <framework/datastore/StoreArray.h>
+
+#include <gtest/gtest.h>
+
+namespace Belle2 {
+
+  /** Test the cell id table of the ECLCalDigits. */
+  class ECLCalDigitCellTableTest : public ::testing::Test {
+
+  protected:
+    /** Register the ECLCalDigits in the datastore */
+    virtual void SetUp()
+    {
+      DataStore::Instance().setInitializeActive(true);
+      StoreArray<ECLCalDigit> eclCalDigits;
+      eclCalDigits.registerInDataStore();
+      DataStore::Instance().setInitializeActive(false);
+    }
+
+    /** Clear datastore */
+    virtual void TearDown()
+    {
+      DataStore::Instance().reset();
+    }
+
+  };
+
+  /** Test filling and refilling of the table. */
+  TEST_F(ECLCalDigitCellTableTest, Fill)
+  {
+    StoreArray<ECLCalDigit> eclCalDigits;
+    const int cellIds[] = {8736, 1, 4242};
+    for (int i = 0; i < 3; i++) {
+      ECLCalDigit* digit = eclCalDigits.appendNew();
+      digit->setCellId(cellIds[i]);
+      digit->setEnergy(0.1 * (i + 1));
+      digit->setTime(10. * (i + 1));
+    }
+
+    const EventMetaData event(1, 2, 3);
+    ECLCalDigitCellTable table;
+    EXPECT_FALSE(table.isFilledFrom(eclCalDigits, event));
+    table.fill(eclCalDigits, event);
+    EXPECT_TRUE(table.isFilledFrom(eclCalDigits, event));
+
+    ASSERT_EQ(table.getCellIds().size(), 3u);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_EQ(table.getCellIds()[i], cellIds[i]);
+      EXPECT_EQ(table.getStoreArrayPosition(cellIds[i]), i);
+      EXPECT_DOUBLE_EQ(table.getEnergy(cellIds[i]), 0.1 * (i + 1));
+      EXPECT_DOUBLE_EQ(table.getTime(cellIds[i]), 10. * (i + 1));
+    }
+    EXPECT_EQ(table.getStoreArrayPosition(2), -1);
+    EXPECT_EQ(table.getEnergy(2), 0);
+
+    // The table is not valid in another event with the same number of digits
+    const EventMetaData nextEvent(2, 2, 3);
+    EXPECT_FALSE(table.isFilledFrom(eclCalDigits, nextEvent));
+
+    // Changing the number of digits invalidates the table, refilling removes the old entries
+    eclCalDigits.clear();
+    ECLCalDigit* digit = eclCalDigits.appendNew();
+    digit->setCellId(2);
+    digit->setEnergy(0.5);
+    EXPECT_FALSE(table.isFilledFrom(eclCalDigits, nextEvent));
+    table.fill(eclCalDigits, nextEvent);
+    EXPECT_TRUE(table.isFilledFrom(eclCalDigits, nextEvent));
+    EXPECT_EQ(table.getStoreArrayPosition(2), 0);
+    EXPECT_DOUBLE_EQ(table.getEnergy(2), 0.5);
+    EXPECT_EQ(table.getStoreArrayPosition(8736), -1);
+    EXPECT_EQ(table.getEnergy(8736), 0);
+  }
+}
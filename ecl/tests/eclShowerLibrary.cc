@@ -0,0 +1,128 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <ecl/simulation/ShowerLibrary.h>
+#include <framework/utilities/TestHelpers.h>
+
+#include <gtest/gtest.h>
+
+using namespace std;
+
+namespace Belle2 {
+  using ECL::ShowerLibrary;
+
+  /** Test the binning and IO of the ECL shower library */
+  class ECLShowerLibraryTest : public ::testing::Test {
+  protected:
+    /** Create a shower with a single deposit */
+    ShowerLibrary::Shower createShower(int region, double energy, double angle, float z, int particle = ShowerLibrary::c_Photon)
+    {
+      ShowerLibrary::Shower shower;
+      shower.particle = particle;
+      shower.region = region;
+      shower.energy = energy;
+      shower.angle = angle;
+      ShowerLibrary::Deposit deposit;
+      deposit.z = z;
+      deposit.energyFraction = 0.9;
+      deposit.time = 0.5;
+      shower.deposits.push_back(deposit);
+      return shower;
+    }
+  };
+
+  /** Test the regions of the crystals */
+  TEST_F(ECLShowerLibraryTest, Regions)
+  {
+    EXPECT_EQ(ShowerLibrary::getRegion(0), ShowerLibrary::c_Forward);
+    EXPECT_EQ(ShowerLibrary::getRegion(1151), ShowerLibrary::c_Forward);
+    EXPECT_EQ(ShowerLibrary::getRegion(1152), ShowerLibrary::c_Barrel);
+    EXPECT_EQ(ShowerLibrary::getRegion(7775), ShowerLibrary::c_Barrel);
+    EXPECT_EQ(ShowerLibrary::getRegion(7776), ShowerLibrary::c_Backward);
+    EXPECT_EQ(ShowerLibrary::getRegion(8735), ShowerLibrary::c_Backward);
+  }
+
+  /** Test the particle types of the PDG codes */
+  TEST_F(ECLShowerLibraryTest, Particles)
+  {
+    EXPECT_EQ(ShowerLibrary::getParticle(22), ShowerLibrary::c_Photon);
+    EXPECT_EQ(ShowerLibrary::getParticle(11), ShowerLibrary::c_Electron);
+    EXPECT_EQ(ShowerLibrary::getParticle(-11), ShowerLibrary::c_Electron);
+    EXPECT_EQ(ShowerLibrary::getParticle(13), -1);
+  }
+
+  /** Test that the showers of photons and electrons are kept apart */
+  TEST_F(ECLShowerLibraryTest, ParticleLookup)
+  {
+    ShowerLibrary library({0.1, 1.0, 10.0}, {0.0, 0.1, 0.5});
+    EXPECT_TRUE(library.addShower(createShower(ShowerLibrary::c_Barrel, 0.5, 0.05, 1)));
+    EXPECT_FALSE(library.addShower(createShower(ShowerLibrary::c_Barrel, 0.5, 0.05, 2, -1)));
+    EXPECT_TRUE(library.hasShowers(ShowerLibrary::c_Photon));
+    EXPECT_FALSE(library.hasShowers(ShowerLibrary::c_Electron));
+    EXPECT_FALSE(library.hasShowers(-1));
+    // Electrons do not get photon showers
+    EXPECT_EQ(library.getShower(ShowerLibrary::c_Electron, ShowerLibrary::c_Barrel, 0.5, 0.05, 0.5), nullptr);
+
+    EXPECT_TRUE(library.addShower(createShower(ShowerLibrary::c_Barrel, 5.0, 0.3, 3, ShowerLibrary::c_Electron)));
+    EXPECT_TRUE(library.hasShowers(ShowerLibrary::c_Electron));
+    EXPECT_EQ(library.getShower(ShowerLibrary::c_Electron, ShowerLibrary::c_Barrel, 0.5, 0.05, 0.5)->deposits[0].z, 3);
+    EXPECT_EQ(library.getShower(ShowerLibrary::c_Photon, ShowerLibrary::c_Barrel, 5.0, 0.3, 0.5)->deposits[0].z, 1);
+  }
+
+  /** Test the lookup of showers in the bins */
+  TEST_F(ECLShowerLibraryTest, Lookup)
+  {
+    ShowerLibrary library({0.1, 1.0, 10.0}, {0.0, 0.1, 0.5});
+    EXPECT_EQ(library.getShower(ShowerLibrary::c_Photon, ShowerLibrary::c_Barrel, 0.5, 0.05, 0.5), nullptr);
+
+    EXPECT_TRUE(library.addShower(createShower(ShowerLibrary::c_Barrel, 0.5, 0.05, 1)));
+    EXPECT_TRUE(library.addShower(createShower(ShowerLibrary::c_Barrel, 0.6, 0.05, 2)));
+    EXPECT_TRUE(library.addShower(createShower(ShowerLibrary::c_Barrel, 5.0, 0.05, 3)));
+    EXPECT_TRUE(library.addShower(createShower(ShowerLibrary::c_Barrel, 0.5, 0.3, 4)));
+    EXPECT_FALSE(library.addShower(createShower(ShowerLibrary::c_Barrel, 20.0, 0.05, 5)));
+    EXPECT_FALSE(library.addShower(createShower(ShowerLibrary::c_Barrel, 0.5, 1.0, 6)));
+    EXPECT_EQ(library.getNumberOfShowers(), 4u);
+
+    // The random number chooses the shower in the bin
+    EXPECT_EQ(library.getShower(ShowerLibrary::c_Photon, ShowerLibrary::c_Barrel, 0.2, 0.01, 0.0)->deposits[0].z, 1);
+    EXPECT_EQ(library.getShower(ShowerLibrary::c_Photon, ShowerLibrary::c_Barrel, 0.2, 0.01, 0.99)->deposits[0].z, 2);
+    EXPECT_EQ(library.getShower(ShowerLibrary::c_Photon, ShowerLibrary::c_Barrel, 2.0, 0.01, 0.5)->deposits[0].z, 3);
+    EXPECT_EQ(library.getShower(ShowerLibrary::c_Photon, ShowerLibrary::c_Barrel, 0.2, 0.2, 0.5)->deposits[0].z, 4);
+    // Values outside of the binning use the closest bin
+    EXPECT_EQ(library.getShower(ShowerLibrary::c_Photon, ShowerLibrary::c_Barrel, 50.0, 0.0, 0.5)->deposits[0].z, 3);
+    // Empty bins use the closest bin with the same energy first
+    EXPECT_EQ(library.getShower(ShowerLibrary::c_Photon, ShowerLibrary::c_Barrel, 2.0, 0.3, 0.5)->deposits[0].z, 3);
+    // No showers for the region
+    EXPECT_EQ(library.getShower(ShowerLibrary::c_Photon, ShowerLibrary::c_Forward, 0.5, 0.05, 0.5), nullptr);
+  }
+
+  /** Test writing and reading the library */
+  TEST_F(ECLShowerLibraryTest, ReadWrite)
+  {
+    TestHelpers::TempDirCreator tempDir;
+    ShowerLibrary library({0.1, 1.0, 10.0}, {0.0, 0.1, 0.5});
+    library.addShower(createShower(ShowerLibrary::c_Forward, 0.5, 0.05, 1));
+    library.addShower(createShower(ShowerLibrary::c_Backward, 5.0, 0.3, 2, ShowerLibrary::c_Electron));
+    library.write("library.root");
+
+    ShowerLibrary readLibrary;
+    readLibrary.read("library.root");
+    EXPECT_EQ(readLibrary.getEnergyBins(), library.getEnergyBins());
+    EXPECT_EQ(readLibrary.getAngleBins(), library.getAngleBins());
+    EXPECT_EQ(readLibrary.getNumberOfShowers(), 2u);
+    EXPECT_EQ(readLibrary.getShower(ShowerLibrary::c_Photon, ShowerLibrary::c_Backward, 5.0, 0.3, 0.5), nullptr);
+    const ShowerLibrary::Shower* shower = readLibrary.getShower(ShowerLibrary::c_Electron, ShowerLibrary::c_Backward, 5.0, 0.3, 0.5);
+    ASSERT_NE(shower, nullptr);
+    EXPECT_EQ(shower->particle, ShowerLibrary::c_Electron);
+    EXPECT_DOUBLE_EQ(shower->energy, 5.0);
+    EXPECT_DOUBLE_EQ(shower->angle, 0.3);
+    ASSERT_EQ(shower->deposits.size(), 1u);
+    EXPECT_FLOAT_EQ(shower->deposits[0].z, 2);
+    EXPECT_FLOAT_EQ(shower->deposits[0].energyFraction, 0.9);
+    EXPECT_FLOAT_EQ(shower->deposits[0].time, 0.5);
+  }
+}
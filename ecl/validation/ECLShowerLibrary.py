@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+
+"""
+<header>
+<output>ECLShowerLibrary.root</output>
+<contact>Elisa Manoni, elisa.manoni@pg.infn.it</contact>
+<description>Builds the shower library of the ECL fast simulation from single photons, electrons and positrons in full simulation</description>
+</header>
+"""
+
+import basf2 as b2
+
+# Create paths
+main = b2.create_path()
+
+# Event setting and info
+main.add_module('EventInfoSetter', evtNumList=[6000], runList=[1])
+
+# Fixed random seed
+b2.set_random_seed(123456)
+
+# single photons, electrons and positrons from the interaction point
+main.add_module('ParticleGun',
+                pdgCodes=[22, 11, -11],
+                nTracks=1,
+                momentumGeneration='uniform',
+                momentumParams=[0.1, 3.0],
+                thetaGeneration='uniform',
+                thetaParams=[13., 150.],
+                phiGeneration='uniform',
+                phiParams=[0, 360],
+                vertexGeneration='fixed',
+                xVertexParams=[0.0],
+                yVertexParams=[0.0],
+                zVertexParams=[0.0])
+
+# only the ECL and no magnetic field, so the particles reach the ECL on a straight line
+main.add_module('Gearbox')
+main.add_module('Geometry', useDB=False, components=['ECL'])
+main.add_module('FullSim', magneticField='none')
+
+main.add_module('ECLShowerLibraryBuilder',
+                fileName='../ECLShowerLibrary.root',
+                energyBins=[0.1, 0.2, 0.35, 0.5, 0.75, 1.0, 1.5, 2.0, 3.0],
+                angleBins=[0.0, 0.02, 0.04, 0.07, 0.1, 0.5])
+
+b2.process(main)
+print(b2.statistics)
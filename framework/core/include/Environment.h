@@ -213,6 +213,24 @@ namespace Belle2 {
     /** Get list of streaming objects */
     const std::vector<std::string>& getStreamingObjects() const { return m_streamingObjects; }
 
+    /**
+     * Set the time budget of each event, see EventTimeBudget.
+     *
+     * @param wallTime maximal wall time per event in seconds, 0 for no limit
+     * @param cpuTime maximal CPU time per event in seconds, 0 for no limit
+     */
+    void setEventTimeBudget(double wallTime, double cpuTime)
+    {
+      m_eventWallTimeBudget = wallTime;
+      m_eventCPUTimeBudget = cpuTime;
+    }
+
+    /** Maximal wall time per event in seconds, 0 for no limit */
+    double getEventWallTimeBudget() const { return m_eventWallTimeBudget; }
+
+    /** Maximal CPU time per event in seconds, 0 for no limit */
+    double getEventCPUTimeBudget() const { return m_eventCPUTimeBudget; }
+
     // ZMQ Options
     /// Flag if ZMQ should be used instead of the RingBuffer multiprocesing implementation
     bool getUseZMQ() const
@@ -262,6 +280,42 @@ namespace Belle2 {
       m_zmqEventBufferSize = zmqEventBufferSize;
     }
 
+    /// Send the events to the worker with the smallest estimated outstanding work instead of in the order of the ready messages
+    bool getZMQSizeAwareScheduling() const
+    {
+      return m_zmqSizeAwareScheduling;
+    }
+
+    /// Send the events to the worker with the smallest estimated outstanding work instead of in the order of the ready messages
+    void setZMQSizeAwareScheduling(bool zmqSizeAwareScheduling)
+    {
+      m_zmqSizeAwareScheduling = zmqSizeAwareScheduling;
+    }
+
+    /// Maximal number of events in flight for every worker, 0 for no limit besides the event buffer size
+    unsigned int getZMQPrefetchDepth() const
+    {
+      return m_zmqPrefetchDepth;
+    }
+
+    /// Maximal number of events in flight for every worker, 0 for no limit besides the event buffer size
+    void setZMQPrefetchDepth(unsigned int zmqPrefetchDepth)
+    {
+      m_zmqPrefetchDepth = zmqPrefetchDepth;
+    }
+
+    /// Number of threads decoding the events in the output process in parallel, 0 to decode them one by one
+    unsigned int getZMQDecodingThreads() const
+    {
+      return m_zmqDecodingThreads;
+    }
+
+    /// Number of threads decoding the events in the output process in parallel, 0 to decode them one by one
+    void setZMQDecodingThreads(unsigned int zmqDecodingThreads)
+    {
+      m_zmqDecodingThreads = zmqDecodingThreads;
+    }
+
     /// How long should a worker maximally need to process all of his events in the queue. Set to 0 to disable the check.
     unsigned int getZMQWorkerTimeout() const
     {
@@ -335,12 +389,17 @@ namespace Belle2 {
     int m_experiment; /**< override experiment for EventInfoSetter. */
     unsigned int m_skipNEvents; /**< override skipNEvents for EventInfoSetter/RootInput. */
     LogConfig::ELogRealm m_realm = LogConfig::c_None; /**< The realm in which basf2 is executed. */
+    double m_eventWallTimeBudget = 0; /**< Maximal wall time per event in seconds, 0 for no limit. */
+    double m_eventCPUTimeBudget = 0; /**< Maximal CPU time per event in seconds, 0 for no limit. */
 
     // ZMQ specific settings
     bool m_useZMQ = false; /**< Set to true to use ZMQ instead of RingBuffer */
     std::string m_zmqSocketAddress = ""; /**< Socket address to use in ZMQ. If not set, uses a random IPC connection. */
     unsigned int m_zmqMaximalWaitingTime = 100 * 1000; /**< Maximal waiting time of any ZMQ module for any communication in ms */
     unsigned int m_zmqEventBufferSize = 2; /**< Number of events to keep in flight for every worker */
+    bool m_zmqSizeAwareScheduling = false; /**< Send the events to the worker with the smallest estimated outstanding work */
+    unsigned int m_zmqPrefetchDepth = 0; /**< Maximal number of events in flight for every worker (0 for no limit) */
+    unsigned int m_zmqDecodingThreads = 0; /**< Number of threads decoding the events in the output process */
     unsigned int m_zmqWorkerTimeout =
       0; /**< How long should a worker maximally need to process all of his events in the queue. Set to 0 to disable the check. */
     bool m_zmqUseEventBackup = false; /**< If a worker dies, store its events in a backup. */
@@ -113,6 +113,23 @@ namespace Belle2 {
      */
     void callEvent(Module* module);
 
+    /** Start the time budget of the current event with the limits from the Environment (see EventTimeBudget). */
+    void startEventTimeBudget();
+
+    /** Check the time budget of the current event before calling the given module.
+     *
+     * If the budget is exceeded, the event is marked with EventMetaData::c_TimeBudgetExceeded.
+     * @return true if the module should be skipped, which is the case for all modules except
+     * the master module, output modules and modules with the Module::c_AlwaysRun flag
+     */
+    bool skipForEventTimeBudget(const Module* module);
+
+    /** Mark the event with EventMetaData::c_TimeBudgetExceeded if the time budget was exceeded by the last module of the path. */
+    void checkEventTimeBudgetAfterPath();
+
+    /** Mark the event with EventMetaData::c_TimeBudgetExceeded (once), nextModule is the first skipped module or nullptr. */
+    void flagEventTimeBudgetExceeded(const Module* nextModule);
+
     /**
      * Terminates the modules.
      *
@@ -0,0 +1,58 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#pragma once
+
+#include <atomic>
+
+namespace Belle2 {
+
+  /**
+   * Wall and CPU time budget of the current event with cooperative checkpoints.
+   *
+   * The event processor starts the budget for every event after the master module
+   * with the limits given by Environment::setEventTimeBudget(). Long running modules
+   * can call isExceeded() at convenient points (e.g. once per track) and stop their
+   * work early if it returns true. Once the budget is exceeded, the event processor
+   * adds EventMetaData::c_TimeBudgetExceeded to the event and skips all further modules
+   * except output modules and modules flagged with Module::c_AlwaysRun (e.g. the
+   * serializers of parallel processing), so the event still leaves the process
+   * instead of stalling it.
+   *
+   * Without a budget, isExceeded() returns false without looking at any clock.
+   *
+   * The state is shared by all threads of the process, so modules running in the threads
+   * of a ParallelPath see the budget of the event started by the main thread.
+   */
+  class EventTimeBudget {
+  public:
+    /**
+     * Start the budget for a new event.
+     *
+     * @param wallTime maximal wall time of the event in default time units, <= 0 for no limit
+     * @param cpuTime maximal CPU time (of the process) of the event in default time units, <= 0 for no limit
+     */
+    static void startEvent(double wallTime, double cpuTime);
+
+    /** Stop the budget at the end of the event. isExceeded() returns false until the next start. */
+    static void stopEvent();
+
+    /** Checkpoint: is the time budget of the current event exceeded? Stays true for the rest of the event. */
+    static bool isExceeded();
+
+  private:
+    /** Is a budget running? */
+    static std::atomic<bool> s_active;
+    /** Was the budget of the current event exceeded? */
+    static std::atomic<bool> s_exceeded;
+    /** Wall clock at which the budget is exceeded, 0 for no limit */
+    static std::atomic<double> s_wallTimeEnd;
+    /** CPU clock at which the budget is exceeded, 0 for no limit */
+    static std::atomic<double> s_cpuTimeEnd;
+  };
+}
@@ -78,6 +78,7 @@ namespace Belle2 {
       c_InternalSerializer          = 16,  /**< This module is an internal serializer/deserializer for parallel processing */
       c_TerminateInAllProcesses     = 32,  /**< When using parallel processing, call this module's terminate() function in all processes(). This will also ensure that there is exactly one process (single-core if no parallel modules found) or at least one input, one main and one output process. */
       c_DontCollectStatistics       = 64,  /**< No statistics is collected for this module. */
+      c_AlwaysRun                   = 128, /**< This module is called for every event, even if all further modules are skipped because the time budget of the event is exceeded (see EventTimeBudget). Output modules are always called anyway. */
     };
 
     /// Forward the EAfterConditionPath definition from the ModuleCondition.
@@ -0,0 +1,106 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#pragma once
+
+#include <framework/core/Module.h>
+#include <framework/core/EventProcessor.h>
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Belle2 {
+  class Path;
+
+  /** Framework-internal module that implements the functionality of
+   * Path::addParallelPath().
+   *
+   * Each element of the given path (a module or a sub-path) is a task. In each
+   * event the tasks are executed concurrently on a pool of threads, the modules
+   * of a sub-path are executed in order within their task. At initialize it is
+   * checked that no task writes a DataStore entry that another task reads or
+   * writes, and that relations are only used between arrays that no other task
+   * uses (the related objects cache their relations). The event statistics of
+   * the modules are collected per module, the statistics of this module show
+   * the wall-clock time of the whole concurrent stage.
+   */
+  class ParallelPathModule : public Module, public EventProcessor {
+  public:
+    ParallelPathModule();
+    ~ParallelPathModule();
+
+    /** used by Path::addParallelPath() to actually set parameters. */
+    void initParallelPath(std::shared_ptr<Path> path, unsigned int numThreads);
+
+    virtual void initialize() override;
+    virtual void beginRun() override;
+    virtual void endRun() override;
+    virtual void event() override;
+    virtual void terminate() override;
+
+  private:
+    /** Set properties for this module based on the modules found in m_path */
+    void setProperties();
+    /** Split the path into tasks and check that the modules can be executed concurrently */
+    void setTasks();
+    /** B2FATAL if tasks share DataStore entries that at least one of them writes or use relations to shared arrays */
+    void checkDataStoreOverlaps() const;
+    /** Is the given relation (or a named relation) between two of the given arrays? */
+    static bool isRelationBetween(const std::string& relation, const std::set<std::string>& arrays);
+    /** Start the worker threads (in the process which executes the events) */
+    void startThreads();
+    /** Stop and join the worker threads */
+    void stopThreads();
+    /** Forget the worker threads inherited from the parent process after fork() */
+    void releaseForeignThreads();
+    /** Main loop of a worker thread */
+    void workerLoop();
+    /** Execute tasks of the current event until none is left */
+    void runTasks();
+    /** Execute one task and record the time spent in each of its modules */
+    void runTask(unsigned int task);
+
+    /** Path with the tasks (its elements) to execute. */
+    std::shared_ptr<Path> m_path;
+    /** Number of threads including the calling thread, 0 = one per task. */
+    unsigned int m_numThreads{0};
+    /** when using multi-processing contains the ID of the process where
+     * event() is called (in that process only). -1 otherwise. */
+    int m_processID{ -1};
+    /** Modules of each task, in execution order. */
+    std::vector<ModulePtrList> m_tasks;
+    /** Time (ns) spent in each module of each task in the current event. */
+    std::vector<std::vector<double>> m_taskModuleTimes;
+    /** Worker threads (the calling thread executes tasks as well). */
+    std::vector<std::thread> m_threads;
+    /** ID of the process in which the worker threads were started. */
+    int m_threadsProcessID{ -1};
+    /** Protects the members below. */
+    std::mutex m_mutex;
+    /** Signals a new event or the end of processing to the workers. */
+    std::condition_variable m_startCondition;
+    /** Signals the completion of all tasks to the calling thread. */
+    std::condition_variable m_doneCondition;
+    /** Incremented for each event, to wake up the workers. */
+    unsigned long m_generation{0};
+    /** Index of the next task to execute in the current event. */
+    unsigned int m_nextTask{0};
+    /** Number of tasks of the current event that are not finished yet. */
+    unsigned int m_pendingTasks{0};
+    /** Workers should terminate. */
+    bool m_stop{false};
+    /** First exception thrown by a task in the current event. */
+    std::exception_ptr m_exception;
+  };
+}
@@ -89,6 +89,9 @@ namespace Belle2 {
      */
     bool contains(const std::string& moduleType) const;
 
+    /** Returns the elements (Modules and sub-Paths) of this path, without descending into sub-Paths. */
+    const std::list<std::shared_ptr<PathElement> >& getElements() const { return m_elements; }
+
     /** Create an independent copy of this path, recreating all contained modules with the same parameters.
      *
      * Note that parameters are shared, so changing them on a module in the cloned path will also affect
@@ -113,6 +116,9 @@ namespace Belle2 {
     /** See 'pydoc3 basf2.Path' */
     void addIndependentPath(const PathPtr& independent_path, std::string ds_ID, const boost::python::list& merge_back);
 
+    /** See 'pydoc3 basf2.Path' */
+    void addParallelPath(const PathPtr& path, unsigned int numThreads);
+
     /** return a string of the form [module a -> module b -> [another path]]
      *
      *  can be used to 'print' a path in a steering file.
@@ -17,6 +17,7 @@
 #include <framework/database/Database.h>
 #include <framework/logging/Logger.h>
 #include <framework/core/Environment.h>
+#include <framework/core/EventTimeBudget.h>
 #include <framework/core/DataFlowVisualization.h>
 #include <framework/core/RandomNumbers.h>
 #include <framework/core/MetadataService.h>
@@ -227,6 +228,50 @@ void EventProcessor::callEvent(Module* module)
   logSystem.updateModule(nullptr);
 };
 
+void EventProcessor::startEventTimeBudget()
+{
+  const Environment& environment = Environment::Instance();
+  EventTimeBudget::startEvent(environment.getEventWallTimeBudget() * Unit::s, environment.getEventCPUTimeBudget() * Unit::s);
+}
+
+bool EventProcessor::skipForEventTimeBudget(const Module* module)
+{
+  if (module == m_master or not EventTimeBudget::isExceeded()) {
+    return false;
+  }
+
+  flagEventTimeBudgetExceeded(module);
+  return not module->hasProperties(Module::c_Output) and not module->hasProperties(Module::c_AlwaysRun);
+}
+
+void EventProcessor::checkEventTimeBudgetAfterPath()
+{
+  if (EventTimeBudget::isExceeded()) {
+    flagEventTimeBudgetExceeded(nullptr);
+  }
+}
+
+void EventProcessor::flagEventTimeBudgetExceeded(const Module* nextModule)
+{
+  if (not m_eventMetaDataPtr or (m_eventMetaDataPtr->getErrorFlag() & EventMetaData::c_TimeBudgetExceeded)) {
+    return;
+  }
+
+  if (nextModule) {
+    B2WARNING("The time budget of the event is exceeded, all further modules except the output modules are skipped."
+              << LogVar("module", nextModule->getName())
+              << LogVar("experiment", m_eventMetaDataPtr->getExperiment())
+              << LogVar("run", m_eventMetaDataPtr->getRun())
+              << LogVar("event", m_eventMetaDataPtr->getEvent()));
+  } else {
+    B2WARNING("The time budget of the event was exceeded by the last module of the path."
+              << LogVar("experiment", m_eventMetaDataPtr->getExperiment())
+              << LogVar("run", m_eventMetaDataPtr->getRun())
+              << LogVar("event", m_eventMetaDataPtr->getEvent()));
+  }
+  m_eventMetaDataPtr->addErrorFlag(EventMetaData::c_TimeBudgetExceeded);
+}
+
 void EventProcessor::processInitialize(const ModulePtrList& modulePathList, bool setEventInfo)
 {
   LogSystem& logSystem = LogSystem::Instance();
@@ -319,6 +364,12 @@ bool EventProcessor::processEvent(PathIterator moduleIter, bool skipMasterModule
   while (!moduleIter.isDone()) {
     Module* module = moduleIter.get();
 
+    // skip the module if the time budget of the event is exceeded
+    if (skipForEventTimeBudget(module)) {
+      moduleIter.next();
+      continue;
+    }
+
     // run the module ... unless we don't want to
     if (!(skipMasterModule && module == m_master)) {
       callEvent(module);
@@ -361,6 +412,9 @@ bool EventProcessor::processEvent(PathIterator moduleIter, bool skipMasterModule
 
       DBStore::Instance().updateEvent();
 
+      //the time budget of the event starts after the master module
+      startEventTimeBudget();
+
     } else {
       //Check for a second master module. Cannot do this if we skipped the
       //master module as the EventMetaData is probably set before we call this
@@ -388,6 +442,9 @@ bool EventProcessor::processEvent(PathIterator moduleIter, bool skipMasterModule
       moduleIter.next();
     }
   } //end module loop
+
+  //the last module can exceed the time budget as well
+  checkEventTimeBudgetAfterPath();
   return false;
 }
 
@@ -409,6 +466,7 @@ void EventProcessor::processCore(const PathPtr& startPath, const ModulePtrList&
 
     PathIterator moduleIter(startPath);
     endProcess = processEvent(moduleIter, isInputProcess && currEvent == 0);
+    EventTimeBudget::stopEvent();
 
     //Delete event related data in DataStore
     DataStore::Instance().invalidateData(DataStore::c_Event);
@@ -0,0 +1,47 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#include <framework/core/EventTimeBudget.h>
+#include <framework/utilities/Utils.h>
+
+using namespace Belle2;
+
+std::atomic<bool> EventTimeBudget::s_active{false};
+std::atomic<bool> EventTimeBudget::s_exceeded{false};
+std::atomic<double> EventTimeBudget::s_wallTimeEnd{0};
+std::atomic<double> EventTimeBudget::s_cpuTimeEnd{0};
+
+void EventTimeBudget::startEvent(double wallTime, double cpuTime)
+{
+  s_exceeded = false;
+  s_wallTimeEnd = wallTime > 0 ? Utils::getClock() + wallTime : 0;
+  s_cpuTimeEnd = cpuTime > 0 ? Utils::getCPUClock() + cpuTime : 0;
+  s_active = s_wallTimeEnd > 0 or s_cpuTimeEnd > 0;
+}
+
+void EventTimeBudget::stopEvent()
+{
+  s_active = false;
+  s_exceeded = false;
+}
+
+bool EventTimeBudget::isExceeded()
+{
+  if (not s_active) {
+    return false;
+  }
+  if (s_exceeded) {
+    return true;
+  }
+  const double wallTimeEnd = s_wallTimeEnd;
+  const double cpuTimeEnd = s_cpuTimeEnd;
+  if ((wallTimeEnd > 0 and Utils::getClock() > wallTimeEnd) or (cpuTimeEnd > 0 and Utils::getCPUClock() > cpuTimeEnd)) {
+    s_exceeded = true;
+  }
+  return s_exceeded;
+}
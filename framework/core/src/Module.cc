@@ -369,6 +369,10 @@ void Module::exposePythonAPI()
 .. attribute:: TERMINATEINALLPROCESSES
 
   When using parallel processing, call this module's terminate() function in all processes. This will also ensure that there is exactly one process (single-core if no parallel modules found) or at least one input, one main and one output process.
+
+.. attribute:: ALWAYSRUN
+
+  Call this module for every event, even if all further modules are skipped because the time budget of the event is exceeded (see :func:`basf2.set_event_time_budget()`). Output modules are always called anyway.
 )")
   .value("INPUT", Module::EModulePropFlags::c_Input)
   .value("OUTPUT", Module::EModulePropFlags::c_Output)
@@ -376,6 +380,7 @@ void Module::exposePythonAPI()
   .value("HISTOGRAMMANAGER", Module::EModulePropFlags::c_HistogramManager)
   .value("INTERNALSERIALIZER", Module::EModulePropFlags::c_InternalSerializer)
   .value("TERMINATEINALLPROCESSES", Module::EModulePropFlags::c_TerminateInAllProcesses)
+  .value("ALWAYSRUN", Module::EModulePropFlags::c_AlwaysRun)
   ;
 
   //Python class definition
@@ -0,0 +1,378 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#include <framework/core/ParallelPathModule.h>
+
+#include <framework/core/ModuleManager.h>
+#include <framework/core/Path.h>
+#include <framework/core/ProcessStatistics.h>
+#include <framework/core/Environment.h>
+#include <framework/datastore/DataStore.h>
+#include <framework/datastore/DependencyMap.h>
+#include <framework/datastore/StoreObjPtr.h>
+#include <framework/pcore/ProcHandler.h>
+#include <framework/utilities/Utils.h>
+
+#include <TROOT.h>
+
+#include <algorithm>
+#include <unistd.h>
+#include <utility>
+
+using namespace Belle2;
+
+//REG_MODLUE needed for --execute-path functionality
+//Note: should not appear in module list since we're not in the right directory
+REG_MODULE(ParallelPath)
+
+
+ParallelPathModule::ParallelPathModule(): Module(), EventProcessor()
+{
+  setDescription(R"DOC(Internal module to handle Path.add_parallel_path().
+
+  Warning:
+    Don't add this module directly with `Path.add_module` or
+    `basf2.register_module` but use `Path.add_parallel_path()`
+
+  This module shouldn't appear in ``basf2 -m`` output.
+  If it does, check REG_MODULE() handling.)DOC");
+
+  addParam("path", m_path, "Path whose elements (modules or sub-paths) are executed concurrently.", PathPtr(nullptr));
+  addParam("numThreads", m_numThreads, "Number of threads (including the calling thread), 0 = one per task.", m_numThreads);
+}
+
+ParallelPathModule::~ParallelPathModule()
+{
+  stopThreads();
+}
+
+void ParallelPathModule::initParallelPath(std::shared_ptr<Path> path, unsigned int numThreads)
+{
+  m_path = std::move(path);
+  m_numThreads = numThreads;
+  setName("parallel" + m_path->getPathString());
+  setProperties();
+}
+
+void ParallelPathModule::setProperties()
+{
+  m_moduleList = m_path->buildModulePathList();
+  //set c_ParallelProcessingCertified flag if _all_ modules have it set
+  auto flag = Module::c_ParallelProcessingCertified;
+  if (ModuleManager::allModulesHaveFlag(m_moduleList, flag))
+    setPropertyFlags(c_TerminateInAllProcesses | flag);
+  else
+    setPropertyFlags(c_TerminateInAllProcesses);
+}
+
+void ParallelPathModule::setTasks()
+{
+  m_tasks.clear();
+  for (const auto& element : m_path->getElements()) {
+    // a module is a task of its own, the modules of a sub-path form one task
+    ModulePtrList elementModules;
+    if (ModulePtr elementModule = std::dynamic_pointer_cast<Module>(element))
+      elementModules.push_back(elementModule);
+    else
+      elementModules = element->getModules();
+    ModulePtrList taskModules;
+    for (const ModulePtr& module : elementModules) {
+      if (module->getType() == "PyModule")
+        B2FATAL(getName() << ": Python module " << module->getName() << " cannot be executed in a worker thread");
+      if (module->hasCondition())
+        B2FATAL(getName() << ": Modules in a Path.add_parallel_path() cannot have any conditions (" << module->getName() << ")");
+      taskModules.push_back(module);
+    }
+    if (!taskModules.empty())
+      m_tasks.push_back(taskModules);
+  }
+  if (m_tasks.empty())
+    B2FATAL(getName() << ": Cannot execute empty path");
+
+  m_taskModuleTimes.resize(m_tasks.size());
+  for (unsigned int task = 0; task < m_tasks.size(); ++task)
+    m_taskModuleTimes[task].assign(m_tasks[task].size(), 0.0);
+}
+
+bool ParallelPathModule::isRelationBetween(const std::string& relation, const std::set<std::string>& arrays)
+{
+  for (const std::string& from : arrays) {
+    for (const std::string& to : arrays) {
+      const std::string name = DataStore::relationName(from, to);
+      if (relation == name or relation.rfind(name + "Named", 0) == 0)
+        return true;
+    }
+  }
+  return false;
+}
+
+void ParallelPathModule::checkDataStoreOverlaps() const
+{
+  // Collect the DataStore entries used by each task (filled during initialize of its modules)
+  const std::map<std::string, DependencyMap::ModuleInfo>& moduleInfoMap = DataStore::Instance().getDependencyMap().getModuleInfoMap();
+  std::vector<std::set<std::string>> reads(m_tasks.size());
+  std::vector<std::set<std::string>> writes(m_tasks.size());
+  std::vector<std::map<std::string, std::string>> relations(m_tasks.size()); // relation -> module
+  bool fatal = false;
+  for (unsigned int task = 0; task < m_tasks.size(); ++task) {
+    for (const ModulePtr& module : m_tasks[task]) {
+      auto it = moduleInfoMap.find(DependencyMap::getModuleID(*module));
+      if (it == moduleInfoMap.end())
+        continue;
+      const DependencyMap::ModuleInfo& info = it->second;
+      for (int type = 0; type < DependencyMap::c_NEntryTypes; ++type) {
+        for (const std::string& relation : info.relations[type])
+          relations[task].emplace(relation, module->getName());
+      }
+      reads[task].insert(info.entries[DependencyMap::c_Input].begin(), info.entries[DependencyMap::c_Input].end());
+      reads[task].insert(info.entries[DependencyMap::c_OptionalInput].begin(), info.entries[DependencyMap::c_OptionalInput].end());
+      writes[task].insert(info.entries[DependencyMap::c_Output].begin(), info.entries[DependencyMap::c_Output].end());
+    }
+  }
+
+  // Relations are stored in the objects they connect, so both arrays must be used by this task only
+  for (unsigned int task = 0; task < m_tasks.size(); ++task) {
+    std::set<std::string> used = reads[task];
+    used.insert(writes[task].begin(), writes[task].end());
+    std::set<std::string> exclusive;
+    for (const std::string& name : used) {
+      bool shared = false;
+      for (unsigned int other = 0; other < m_tasks.size(); ++other) {
+        if (other != task and (reads[other].count(name) or writes[other].count(name)))
+          shared = true;
+      }
+      if (!shared)
+        exclusive.insert(name);
+    }
+    for (const auto& [relation, moduleName] : relations[task]) {
+      if (!isRelationBetween(relation, exclusive)) {
+        B2ERROR(getName() << ": Module " << moduleName << " uses the relation " << relation
+                << ", which is not between arrays used by its task only and cannot be accessed concurrently");
+        fatal = true;
+      }
+    }
+  }
+
+  // An entry written by one task must not be read or written by any other task
+  for (unsigned int task1 = 0; task1 < m_tasks.size(); ++task1) {
+    for (unsigned int task2 = 0; task2 < m_tasks.size(); ++task2) {
+      if (task1 == task2)
+        continue;
+      for (const std::string& name : writes[task1]) {
+        bool written = (task2 > task1) && writes[task2].count(name);
+        if (written or reads[task2].count(name)) {
+          B2ERROR(getName() << ": DataStore entry " << name << " is written by " << m_tasks[task1].front()->getName()
+                  << (m_tasks[task1].size() > 1 ? " (task)" : "") << " and " << (written ? "written" : "read")
+                  << " by " << m_tasks[task2].front()->getName() << (m_tasks[task2].size() > 1 ? " (task)" : ""));
+          fatal = true;
+        }
+      }
+    }
+  }
+  if (fatal)
+    B2FATAL(getName() << ": The tasks cannot be executed concurrently");
+}
+
+void ParallelPathModule::initialize()
+{
+  if (!m_path) {
+    B2FATAL("ParallelPath module not initialised properly.");
+  }
+  setTasks();
+
+  StoreObjPtr<ProcessStatistics> processStatistics("", DataStore::c_Persistent);
+  processStatistics->suspendGlobal();
+
+  m_moduleList = m_path->buildModulePathList();
+  processInitialize(m_moduleList, false);
+  checkDataStoreOverlaps();
+
+  // Objects are created and class information is looked up in several threads
+  if (m_numThreads != 1)
+    ROOT::EnableThreadSafety();
+
+  //don't screw up statistics for this module
+  processStatistics->startModule();
+  processStatistics->resumeGlobal();
+}
+
+void ParallelPathModule::terminate()
+{
+  stopThreads();
+
+  StoreObjPtr<ProcessStatistics> processStatistics("", DataStore::c_Persistent);
+  processStatistics->suspendGlobal();
+
+  if (!ProcHandler::parallelProcessingUsed() or m_processID == ProcHandler::EvtProcID()) {
+    processTerminate(m_moduleList);
+  } else {
+    //we're in another process than we actually belong to, only call terminate where approriate
+    ModulePtrList tmpModuleList;
+    for (const ModulePtr& m : m_moduleList) {
+      if (m->hasProperties(c_TerminateInAllProcesses))
+        tmpModuleList.push_back(m);
+    }
+    processTerminate(tmpModuleList);
+  }
+
+  //don't screw up statistics for this module
+  processStatistics->startModule();
+  processStatistics->resumeGlobal();
+}
+
+void ParallelPathModule::beginRun()
+{
+  m_processID = ProcHandler::EvtProcID();
+
+  StoreObjPtr<ProcessStatistics> processStatistics("", DataStore::c_Persistent);
+  processStatistics->suspendGlobal();
+  processBeginRun();
+
+  //don't screw up statistics for this module
+  processStatistics->startModule();
+  processStatistics->resumeGlobal();
+}
+
+void ParallelPathModule::endRun()
+{
+  StoreObjPtr<ProcessStatistics> processStatistics("", DataStore::c_Persistent);
+  processStatistics->suspendGlobal();
+  processEndRun();
+
+  //don't screw up statistics for this module
+  processStatistics->startModule();
+  processStatistics->resumeGlobal();
+}
+
+void ParallelPathModule::startThreads()
+{
+  // Threads do not survive fork(), so they are started by the process which executes the events
+  if (m_threadsProcessID == getpid())
+    return;
+  releaseForeignThreads();
+  unsigned int numThreads = (m_numThreads == 0) ? m_tasks.size() : std::min<unsigned int>(m_numThreads, m_tasks.size());
+  m_stop = false;
+  for (unsigned int i = 1; i < numThreads; ++i)
+    m_threads.emplace_back(&ParallelPathModule::workerLoop, this);
+  m_threadsProcessID = getpid();
+}
+
+void ParallelPathModule::releaseForeignThreads()
+{
+  // std::thread objects inherited from the parent process refer to threads that do not
+  // exist in this process: they can be neither joined nor destroyed, so they are leaked.
+  if (!m_threads.empty())
+    new std::vector<std::thread>(std::move(m_threads));
+  m_threads.clear();
+  m_threadsProcessID = -1;
+}
+
+void ParallelPathModule::stopThreads()
+{
+  if (m_threadsProcessID != getpid()) {
+    releaseForeignThreads();
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_startCondition.notify_all();
+  for (std::thread& thread : m_threads)
+    thread.join();
+  m_threads.clear();
+  m_threadsProcessID = -1;
+}
+
+void ParallelPathModule::workerLoop()
+{
+  unsigned long generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_startCondition.wait(lock, [&] { return m_stop or m_generation != generation; });
+      if (m_stop)
+        return;
+      generation = m_generation;
+    }
+    runTasks();
+  }
+}
+
+void ParallelPathModule::runTasks()
+{
+  while (true) {
+    unsigned int task;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_nextTask >= m_tasks.size())
+        return;
+      task = m_nextTask++;
+    }
+    try {
+      runTask(task);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_exception)
+        m_exception = std::current_exception();
+    }
+    bool done;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      done = (--m_pendingTasks == 0);
+    }
+    if (done)
+      m_doneCondition.notify_all();
+  }
+}
+
+void ParallelPathModule::runTask(unsigned int task)
+{
+  unsigned int index = 0;
+  for (const ModulePtr& module : m_tasks[task]) {
+    const double start = Utils::getClock();
+    module->event();
+    m_taskModuleTimes[task][index++] = Utils::getClock() - start;
+  }
+}
+
+void ParallelPathModule::event()
+{
+  startThreads();
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_nextTask = 0;
+    m_pendingTasks = m_tasks.size();
+    m_exception = nullptr;
+    ++m_generation;
+  }
+  m_startCondition.notify_all();
+  // the calling thread takes tasks as well
+  runTasks();
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [&] { return m_pendingTasks == 0; });
+  }
+  if (m_exception)
+    std::rethrow_exception(m_exception);
+
+  // Per-module statistics, attributed in the calling thread. The memory
+  // consumption of a single module cannot be separated from the others.
+  if (!Environment::Instance().getNoStats()) {
+    StoreObjPtr<ProcessStatistics> processStatistics("", DataStore::c_Persistent);
+    for (unsigned int task = 0; task < m_tasks.size(); ++task) {
+      unsigned int index = 0;
+      for (const ModulePtr& module : m_tasks[task]) {
+        if (!module->hasProperties(c_DontCollectStatistics))
+          processStatistics->getStatistics(module.get()).add(ModuleStatistics::c_Event, m_taskModuleTimes[task][index], 0);
+        ++index;
+      }
+    }
+  }
+}
@@ -16,6 +16,7 @@
 #include <framework/core/Module.h>
 #include <framework/core/ModuleManager.h>
 #include <framework/core/SubEventModule.h>
+#include <framework/core/ParallelPathModule.h>
 #include <framework/core/SwitchDataStoreModule.h>
 #include <framework/core/PyObjConvUtils.h>
 
@@ -129,6 +130,13 @@ void Path::addIndependentPath(const PathPtr& independent_path, std::string ds_ID
   addModule(switchEnd);
 }
 
+void Path::addParallelPath(const PathPtr& path, unsigned int numThreads)
+{
+  ModulePtr module = ModuleManager::Instance().registerModule("ParallelPath");
+  static_cast<ParallelPathModule&>(*module).initParallelPath(path, numThreads);
+  addModule(module);
+}
+
 bool Path::contains(const std::string& moduleType) const
 {
   const std::list<ModulePtr>& modules = getModules();
@@ -283,6 +291,34 @@ Parameters:
     the execution is aborted.
        )", (bparg("path"), bparg("condition") = "<1", bparg("max_iterations") = 10000))
   .def("_add_independent_path", &Path::addIndependentPath)
+  .def("add_parallel_path", &Path::addParallelPath, R"(add_parallel_path(path, num_threads=0)
+
+Similar to `add_path()` this will execute the given ``path`` at the current
+position, but the elements of ``path`` are executed concurrently in several
+threads of the current process. Each module added directly to ``path`` is a
+task of its own, each sub path added to ``path`` is one task in which its
+modules are executed in order. This is meant for stages of independent modules
+like the unpackers of the different detectors.
+
+The tasks must not depend on each other: after the modules are initialized it
+is checked that no DataStore entry written by one task is read or written by
+another task and processing is aborted otherwise. In addition the modules
+
+* may only use relations between arrays that no other task uses, e.g. between
+  the digits and the raw hits written by an unpacker (the related objects cache
+  their relations),
+* must not be Python modules and must not have conditions,
+* must not modify objects they only read (e.g. the error flags of EventMetaData).
+
+The event statistics are recorded for each module, the memory consumption of
+the individual modules is not available. The statistics of the module
+representing the whole stage show its wall-clock time.
+
+Parameters:
+  path (basf2.Path): path whose elements are executed concurrently
+  num_threads (int): number of threads, including the thread which processes
+    the event. 0 means one thread per task.
+       )", (bparg("path"), bparg("num_threads") = 0))
   .def("__contains__", &Path::contains, R"(Does this Path contain a module of the given type?
 
     >>> path = basf2.Path()
@@ -13,6 +13,7 @@
 #include <array>
 #include <memory>
 #include <map>
+#include <mutex>
 
 namespace Belle2 {
 
@@ -46,19 +47,22 @@ namespace Belle2 {
 
       const std::string& name = relation.getName();
       DataStore::EDurability durability = relation.getDurability();
-      RelationMap& relations =  m_cache[durability];
       std::shared_ptr<RelationIndexContainer<FROM, TO>> indexContainer;
-      RelationMap::iterator it = relations.find(name);
-      if (it != relations.end()) {
-        //if existing array is of wrong type, we'll overwrite the shared_ptr here, but the index will live on with any RelationIndex objects that use it.
-        indexContainer = std::dynamic_pointer_cast<RelationIndexContainer<FROM, TO>>(it->second);
-      }
-      if (!indexContainer) {
-        indexContainer.reset(new RelationIndexContainer<FROM, TO>(relation));
-        relations[name] = indexContainer;
-      } else {
-        indexContainer->rebuild(false);
+      {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        RelationMap& relations =  m_cache[durability];
+        RelationMap::iterator it = relations.find(name);
+        if (it != relations.end()) {
+          //if existing array is of wrong type, we'll overwrite the shared_ptr here, but the index will live on with any RelationIndex objects that use it.
+          indexContainer = std::dynamic_pointer_cast<RelationIndexContainer<FROM, TO>>(it->second);
+        }
+        if (!indexContainer) {
+          indexContainer.reset(new RelationIndexContainer<FROM, TO>(relation));
+          relations[name] = indexContainer;
+          return indexContainer;
+        }
       }
+      indexContainer->rebuild(false);
       return indexContainer;
     }
 
@@ -76,6 +80,7 @@ namespace Belle2 {
      */
     void reset()
     {
+      std::lock_guard<std::mutex> lock(m_cacheMutex);
       for (int i = 0; i < DataStore::c_NDurabilityTypes; i++)
         m_cache[i].clear();
     }
@@ -97,6 +102,7 @@ namespace Belle2 {
     template<class FROM, class TO> std::shared_ptr<RelationIndexContainer<FROM, TO>> getIndexIfExists(const std::string& name,
         DataStore::EDurability durability) const
     {
+      std::lock_guard<std::mutex> lock(m_cacheMutex);
       const RelationMap& relations =  m_cache[durability];
       RelationMap::const_iterator it = relations.find(name);
       if (it != relations.end()) {
@@ -119,6 +125,9 @@ namespace Belle2 {
     /** Cache for all Containers */
     RelationCache m_cache;
 
+    /** Protects the cache, which is shared by modules running in worker threads (see Path.add_parallel_path()) */
+    mutable std::mutex m_cacheMutex;
+
     /** only DataStore should be able to get non-const indices. */
     friend class DataStore;
   };
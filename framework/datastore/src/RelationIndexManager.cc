@@ -17,6 +17,7 @@ RelationIndexManager& RelationIndexManager::Instance()
 }
 void RelationIndexManager::clear(DataStore::EDurability durability)
 {
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
   RelationMap& relations = m_cache[durability];
   for (auto& e : relations) {
     if (e.second) e.second->clear();
@@ -14,6 +14,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 
 
@@ -111,6 +112,15 @@ namespace Belle2 {
      */
     bool sendMessage(LogMessage&& message);
 
+    /**
+     * Collects the log messages of the calling thread in the given buffer instead of sending them.
+     * Worker threads use this to hand their messages over to the main thread, which sends them
+     * with sendMessage() after the workers are finished. Fatal messages are always sent directly.
+     *
+     * @param buffer The buffer for the messages of the calling thread, nullptr to send them directly again.
+     */
+    static void setThreadMessageBuffer(std::vector<LogMessage>* buffer);
+
     /** Resets the message counter and error log by setting all message counts to 0. */
     void resetMessageCounter();
 
@@ -217,6 +227,8 @@ namespace Belle2 {
     unsigned int m_suppressedMessages{0};
     /** Counts the number of messages sent per message level. */
     int m_messageCounter[LogConfig::c_Default];
+    /** Serializes sendMessage() for modules running in worker threads (see Path.add_parallel_path()) */
+    std::mutex m_sendMessageMutex;
     /** Global flag for fast checking if debug output is enabled */
     static bool s_debugEnabled;
 
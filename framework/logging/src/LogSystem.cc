@@ -27,6 +27,11 @@ using namespace std;
 
 bool LogSystem::s_debugEnabled = false;
 
+namespace {
+  /** Buffer collecting the log messages of the current thread, nullptr if they are sent directly */
+  thread_local std::vector<LogMessage>* s_threadMessageBuffer = nullptr;
+}
+
 
 LogSystem& LogSystem::Instance()
 {
@@ -66,8 +71,19 @@ void LogSystem::showText(LogConfig::ELogLevel level, const std::string& txt, int
   deliverMessageToConnections(customText);
 }
 
+void LogSystem::setThreadMessageBuffer(std::vector<LogMessage>* buffer)
+{
+  s_threadMessageBuffer = buffer;
+}
+
 bool LogSystem::sendMessage(LogMessage&& message)
 {
+  if (s_threadMessageBuffer and message.getLogLevel() < LogConfig::c_Fatal) {
+    s_threadMessageBuffer->push_back(std::move(message));
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock(m_sendMessageMutex);
   LogConfig::ELogLevel logLevel = message.getLogLevel();
   auto packageLogConfig = m_packageLogConfigs.find(message.getPackage());
   if ((packageLogConfig != m_packageLogConfigs.end()) && packageLogConfig->second.getLogInfo(logLevel)) {
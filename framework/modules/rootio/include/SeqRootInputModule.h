@@ -12,7 +12,9 @@
 #include <framework/pcore/DataStoreStreamer.h>
 #include <framework/pcore/SeqFile.h>
 
+#include <set>
 #include <string>
+#include <vector>
 
 #include <sys/time.h>
 
@@ -35,6 +37,15 @@ namespace Belle2 {
     virtual void terminate() override;
 
   private:
+    //! Open the input file with the given index in m_filelist and read its StreamerInfo. Returns false if there is none.
+    bool openInputFile(int fileptr);
+    //! Skip events in the file until the next selected entry. Returns false at the end of the input.
+    bool goToNextSelectedEntry();
+    //! Skip the given number of (selected) events without decoding them.
+    void skipEvents(unsigned int n);
+    //! Read the next selected event and restore it in the DataStore. Returns false at the end of the input.
+    bool readEvent();
+
     //! File name
     std::string m_inputFileName{""};
     //! List of all file names to read
@@ -46,6 +57,24 @@ namespace Belle2 {
     //! Is the input real data?
     bool m_realData{false};
 
+    //! Number of events to skip at the beginning
+    unsigned int m_skipNEvents{0};
+
+    //! The number sequences (e.g. 23:42,101) defining the entries which are processed for each input file
+    std::vector<std::string> m_entrySequences;
+
+    //! Are only the entries in m_selectedEntries processed for the current file?
+    bool m_selectEntries{false};
+
+    //! Entries to process in the current file
+    std::set<int64_t> m_selectedEntries;
+
+    //! Next entry to process in the current file
+    std::set<int64_t>::const_iterator m_nextSelectedEntry;
+
+    //! Entry number of the next event in the current file
+    int64_t m_entry{0};
+
     //! Blocked file handler
     SeqFile* m_file{nullptr};
 
@@ -54,6 +54,9 @@ namespace Belle2 {
     //! Compression level
     int m_compressionLevel;
 
+    //! If true an event index is appended to each output file
+    bool m_writeIndex;
+
     //! Blocked file handler
     SeqFile* m_file;
 
@@ -14,9 +14,9 @@
 #include <framework/dataobjects/FileMetaData.h>
 #include <framework/io/RootIOUtilities.h>
 #include <framework/database/Configuration.h>
+#include <framework/utilities/NumberSequence.h>
 
 #include <cmath>
-#include <cstdio>
 
 using namespace std;
 using namespace Belle2;
@@ -48,6 +48,12 @@ SeqRootInputModule::SeqRootInputModule() : Module()
            "subsequent files are named .sroot-N. For example 'myfile-f%08d.sroot'",
            false);
   addParam("declareRealData", m_realData, "Declare the input to be real, not generated data", false);
+  addParam("skipNEvents", m_skipNEvents, "Skip this number of events before starting. Files written with "
+           "an event index (see SeqRootOutput) are not read for the skipped events.", 0u);
+  addParam("entrySequences", m_entrySequences,
+           "The number sequences (e.g. 23:42,101) defining the entries which are processed for each input file. "
+           "Must be specified exactly once for each file to be opened, ':' selects all entries of a file. "
+           "The first event has the entry number 0.", empty);
 }
 
 SeqRootInputModule::~SeqRootInputModule() = default;
@@ -60,16 +66,22 @@ void SeqRootInputModule::initialize()
   }
   const std::vector<std::string>& inputFiles = Environment::Instance().getInputFilesOverride();
   if (!inputFiles.empty()) {  // Override parameter specification
-    if (inputFiles.size() > 1) {
-      m_filelist = inputFiles;
-    }
-    m_inputFileName = inputFiles[0];
-    m_nfile = m_filelist.size();
-  } else if (m_filelist.size() > 0) {
-    m_nfile = m_filelist.size();
-    m_inputFileName = m_filelist[0];
-  } else {
-    m_nfile = 1;
+    m_filelist = inputFiles;
+  } else if (m_filelist.empty()) {
+    m_filelist.push_back(m_inputFileName);
+  }
+  m_inputFileName = m_filelist[0];
+  m_nfile = m_filelist.size();
+
+  unsigned int skipNEventsOverride = Environment::Instance().getSkipEventsOverride();
+  if (skipNEventsOverride != 0)
+    m_skipNEvents = skipNEventsOverride;
+  auto entrySequencesOverride = Environment::Instance().getEntrySequencesOverride();
+  if (entrySequencesOverride.size() > 0)
+    m_entrySequences = entrySequencesOverride;
+  if (m_entrySequences.size() > 0 and m_entrySequences.size() != m_filelist.size()) {
+    B2FATAL("Number of provided filenames does not match the number of given entrySequences parameters: len(inputFileNames) = "
+            << m_filelist.size() << " len(entrySequences) = " << m_entrySequences.size());
   }
 
   // Initialize DataStoreStreamer
@@ -78,52 +90,137 @@ void SeqRootInputModule::initialize()
   // Read the first event in SeqRoot file and restore in DataStore.
   // This is necessary to create object tables before TTree initialization
   // if used together with TTree based output (RootOutput module).
+  openInputFile(0);
+  skipEvents(m_skipNEvents);
+  if (!readEvent()) {
+    B2FATAL("SeqRootInput : Error in reading first event");
+  }
 
-  EvtMessage* evtmsg = nullptr;
-  // Open input file
-  m_file = new SeqFile(m_inputFileName.c_str(), "r", nullptr, 0, m_fileNameIsPattern);
+  if (m_realData) {
+    StoreObjPtr<FileMetaData> fileMetaData("", DataStore::c_Persistent);
+    fileMetaData.registerInDataStore();
+    fileMetaData.create();
+    fileMetaData->declareRealData();
+  }
+  // make sure global tag replay is disabled and users have to specify a globaltag.
+  // We don't have input file metadata so this is all we can do.
+  Conditions::Configuration::getInstance().setInputGlobaltags({});
+}
+
+bool SeqRootInputModule::openInputFile(int fileptr)
+{
+  delete m_file;
+  m_file = nullptr;
+  if (fileptr >= m_nfile) return false;
+
+  m_fileptr = fileptr;
+  m_inputFileName = m_filelist[m_fileptr];
+  m_file = new SeqFile(m_inputFileName, "r", nullptr, 0, m_fileNameIsPattern);
   if (m_file->status() <= 0)
     B2FATAL("SeqRootInput : Error in opening input file : " << m_inputFileName);
-
   B2INFO("SeqRootInput : Open " << m_inputFileName);
 
-  //Read StreamerInfo and the first event
-  int info_cnt = 0;
-  while (true) {
-    auto* evtbuf = new char[EvtMessage::c_MaxEventSize];
-    int size = m_file->read(evtbuf, EvtMessage::c_MaxEventSize);
-    if (size > 0) {
-      evtmsg = new EvtMessage(evtbuf);
-      m_streamer->restoreDataStore(evtmsg);
-      if (evtmsg->type() == MSG_STREAMERINFO) {
-        // StreamerInfo was read
-        B2INFO("Reading StreamerInfo");
-        if (info_cnt != 0) B2FATAL("SeqRootInput : Reading StreamerInfos twice");
-        info_cnt++;
+  // The first record is the StreamerInfo, it has to be restored only once
+  char* record = nullptr;
+  int size = m_file->readRecord(record);
+  if (size <= 0) {
+    B2FATAL("SeqRootInput : Error in reading file. error code = " << size);
+  }
+  EvtMessage streamerInfo(record);
+  if (streamerInfo.type() != MSG_STREAMERINFO) {
+    B2FATAL("SeqRootInput : No StreamerInfo at the beginning of " << m_inputFileName);
+  }
+  if (m_fileptr == 0) {
+    B2INFO("Reading StreamerInfo");
+    m_streamer->restoreDataStore(&streamerInfo);
+  }
+
+  // Select the entries to process in this file
+  m_entry = 0;
+  m_selectEntries = m_entrySequences.size() > 0 and m_entrySequences[m_fileptr] != ":";
+  if (m_selectEntries) {
+    m_selectedEntries = generate_number_sequence(m_entrySequences[m_fileptr]);
+    m_nextSelectedEntry = m_selectedEntries.begin();
+  }
+  return true;
+}
+
+bool SeqRootInputModule::goToNextSelectedEntry()
+{
+  while (m_file) {
+    if (!m_selectEntries) return true;
+    if (m_nextSelectedEntry != m_selectedEntries.end()) {
+      const int n = *m_nextSelectedEntry - m_entry;
+      const int skipped = m_file->skipEvents(n);
+      m_entry += skipped;
+      if (skipped == n) return true;
+      B2WARNING("Given sequence contains entry numbers which are out of range. "
+                "I won't process any further events of the current file.");
+    }
+    // nothing selected anymore in this file
+    openInputFile(m_fileptr + 1);
+  }
+  return false;
+}
+
+void SeqRootInputModule::skipEvents(unsigned int n)
+{
+  while (n > 0 and m_file) {
+    if (m_selectEntries) {
+      // skip the selected entries one by one
+      if (!goToNextSelectedEntry()) return;
+      if (!m_selectEntries) continue;
+      if (m_file->skipEvents(1) == 1) {
+        m_entry++;
+        ++m_nextSelectedEntry;
+        n--;
       } else {
-        // first event was read
-        delete[] evtbuf;
-        delete evtmsg;
-        break;
+        openInputFile(m_fileptr + 1);
       }
-      delete[] evtbuf;
-      delete evtmsg;
-
     } else {
-      B2FATAL("SeqRootInput : Error in reading first event");
+      const int skipped = m_file->skipEvents(n);
+      m_entry += skipped;
+      n -= skipped;
+      if (n > 0) openInputFile(m_fileptr + 1);
     }
   }
-  m_fileptr = 0;
+}
 
-  if (m_realData) {
-    StoreObjPtr<FileMetaData> fileMetaData("", DataStore::c_Persistent);
-    fileMetaData.registerInDataStore();
-    fileMetaData.create();
-    fileMetaData->declareRealData();
+bool SeqRootInputModule::readEvent()
+{
+  while (goToNextSelectedEntry()) {
+    // Get a SeqRoot record from the file, without copying if possible
+    char* record = nullptr;
+    int size = m_file->readRecord(record);
+    if (size < 0) {
+      B2ERROR("SeqRootInput : file read error");
+      delete m_file;
+      m_file = nullptr;
+      return false;
+    } else if (size == 0) {
+      B2INFO("SeqRootInput : EOF detected");
+      openInputFile(m_fileptr + 1);
+      continue;
+    }
+
+    EvtMessage evtmsg(record);
+    if (evtmsg.type() == MSG_STREAMERINFO) {
+      B2WARNING("SeqRootInput : StreamerInfo is found in the middle of *.sroot-* files. Skip record");
+      continue;
+    }
+    m_entry++;
+    if (m_selectEntries) ++m_nextSelectedEntry;
+
+    // Statistics
+    double dsize = (double)size / 1000.0;
+    m_size += dsize;
+    m_size2 += dsize * dsize;
+
+    // Restore objects in DataStore
+    m_streamer->restoreDataStore(&evtmsg);
+    return true;
   }
-  // make sure global tag replay is disabled and users have to specify a globaltag.
-  // We don't have input file metadata so this is all we can do.
-  Conditions::Configuration::getInstance().setInputGlobaltags({});
+  return false;
 }
 
 
@@ -144,72 +241,7 @@ void SeqRootInputModule::event()
   // so don't get confused by the m_nevt=0 in beginRun()
   if (++m_nevt == 0) return;
 
-  // Get a SeqRoot record from the file
-  auto* evtbuf = new char[EvtMessage::c_MaxEventSize];
-  EvtMessage* evtmsg = nullptr;
-  int size = m_file->read(evtbuf, EvtMessage::c_MaxEventSize);
-  if (size < 0) {
-    B2ERROR("SeqRootInput : file read error");
-    delete m_file;
-    m_file = nullptr;
-    delete[] evtbuf;
-    evtbuf = nullptr;
-    return;
-  } else if (size == 0) {
-    B2INFO("SeqRootInput : EOF detected");
-    delete m_file;
-    m_file = nullptr;
-    m_fileptr++;
-    if (m_fileptr >= m_nfile) {
-      delete[] evtbuf;
-      evtbuf = nullptr;
-      return;
-    }
-    printf("fileptr = %d ( of %d )\n", m_fileptr, m_nfile);
-    fflush(stdout);
-    m_inputFileName = m_filelist[m_fileptr];
-    m_file = new SeqFile(m_inputFileName, "r");
-    if (m_file->status() <= 0)
-      B2FATAL("SeqRootInput : Error in opening input file : " << m_inputFileName);
-    B2INFO("SeqRootInput : Open " << m_inputFileName);
-    evtmsg = new EvtMessage(evtbuf);
-    // Skip the first record (StreamerInfo)
-    int is = m_file->read(evtbuf, EvtMessage::c_MaxEventSize);
-    if (is <= 0) {
-      B2FATAL("SeqRootInput : Error in reading file. error code = " << is);
-    }
-    // Read next record
-    is = m_file->read(evtbuf, EvtMessage::c_MaxEventSize);
-    if (is <= 0) {
-      B2FATAL("SeqRootInput : Error in reading file. error code = " << is);
-    }
-  } else {
-    //    printf("SeqRootInput : read = %d\n", size);
-    evtmsg = new EvtMessage(evtbuf);
-  }
-
-  // Statistics
-  double dsize = (double)size / 1000.0;
-  m_size += dsize;
-  m_size2 += dsize * dsize;
-
-  if (evtmsg->type() == MSG_STREAMERINFO) {
-    B2WARNING("SeqRootInput : StreamerInfo is found in the middle of *.sroot-* files. Skip record");
-    int is = m_file->read(evtbuf, EvtMessage::c_MaxEventSize);
-    if (is <= 0) {
-      B2FATAL("SeqRootInput : Error in reading file. error code = " << is);
-    }
-    evtmsg = new EvtMessage(evtbuf);
-  }
-
-  // Restore objects in DataStore
-  m_streamer->restoreDataStore(evtmsg);
-
-  // Delete buffers
-  delete[] evtbuf;
-  evtbuf = nullptr;
-  delete evtmsg;
-  evtmsg = nullptr;
+  readEvent();
 }
 
 void SeqRootInputModule::endRun()
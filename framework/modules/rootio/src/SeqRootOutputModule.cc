@@ -8,6 +8,8 @@
 
 #include <framework/modules/rootio/SeqRootOutputModule.h>
 #include <framework/datastore/DataStore.h>
+#include <framework/datastore/StoreObjPtr.h>
+#include <framework/dataobjects/EventMetaData.h>
 #include <framework/core/Environment.h>
 
 #include <cmath>
@@ -43,8 +45,13 @@ SeqRootOutputModule::SeqRootOutputModule() : Module(), m_nevt(0), m_streamer(nul
            "Output file name. Add a .gz suffix to save a gzip-compressed file. Parameter can be overridden using the -o argument to basf2.",
            string("SeqRootOutput.sroot"));
   addParam("compressionLevel", m_compressionLevel,
-           "Compression Level: 0 for no, 1 for low, 9 for high compression. Level 1 usually reduces size by 50%, higher levels have no noticable effect. NOTE: Because of a ROOT bug ( https://sft.its.cern.ch/jira/browse/ROOT-4550 ), this option currently causes memory leaks and is disabled.",
+           "Compression of each record, given as 100 * algorithm + level like for ROOT files: 0 for no compression, "
+           "1-9 for zlib, 404 for LZ4 (fast, recommended) or 505 for ZSTD (smaller files). As each event is compressed "
+           "on its own the file can still be indexed and read with random access, which is not possible for .gz files.",
            0);
+  addParam("writeIndex", m_writeIndex, "If true append an event index (offset, experiment, run and event number) "
+           "to each output file which allows SeqRootInput to skip events without reading them. Files with index "
+           "cannot be read by older software versions. Not possible for .gz files.", false);
   addParam("saveObjs", m_saveObjs, "List of objects/arrays to be saved", emptyvector);
   addParam("fileNameIsPattern", m_fileNameIsPattern, "If true interpret the output filename as a boost::format pattern "
            "instead of the standard where subsequent files are named .sroot-N. For example 'myfile-f%08d.sroot'", false);
@@ -75,7 +82,7 @@ void SeqRootOutputModule::initialize()
   //Write StreamerInfo at the beginning of a file
   getStreamerInfos();
 
-  m_file = new SeqFile(m_outputFileName.c_str(), "w", m_streamerinfo, m_streamerinfo_size, m_fileNameIsPattern);
+  m_file = new SeqFile(m_outputFileName.c_str(), "w", m_streamerinfo, m_streamerinfo_size, m_fileNameIsPattern, m_writeIndex);
 
   B2INFO("SeqRootOutput: initialized.");
 }
@@ -99,7 +106,13 @@ void SeqRootOutputModule::event()
   EvtMessage* msg = m_streamer->streamDataStore(false);
 
   // Store EvtMessage
-  int stat = m_file->write(msg->buffer());
+  int stat = 0;
+  StoreObjPtr<EventMetaData> eventMetaData;
+  if (eventMetaData.isValid()) {
+    stat = m_file->write(msg->buffer(), eventMetaData->getExperiment(), eventMetaData->getRun(), eventMetaData->getEvent());
+  } else {
+    stat = m_file->write(msg->buffer());
+  }
 
   // Clean up EvtMessage
   delete msg;
@@ -64,6 +64,30 @@ namespace Belle2 {
      */
     int restoreDataStore(EvtMessage* msg);
 
+    /** Objects of an EvtMessage decoded by decodeMessage() but not yet restored in the DataStore. */
+    struct DecodedMessage {
+      ERecordType type{MSG_EVENT}; /**< type of the message */
+      int nObjects{0}; /**< number of objects in the message */
+      int nArrays{0}; /**< number of arrays in the message */
+      std::vector<TObject*> objects; /**< decoded objects, owned until they are restored */
+      std::vector<std::string> names; /**< names of the decoded objects */
+    };
+
+    /** Decode EvtMessage without touching the DataStore.
+     *
+     *  This is the expensive part of restoreDataStore() and can be done in a separate
+     *  thread (ROOT thread safety needs to be enabled), if each thread uses its own MsgHandler.
+     *  @param msg        EvtMessage to be decoded.
+     *  @param msghandler MsgHandler to use for decoding.
+     *  @param decoded    filled with the decoded objects.
+     */
+    static void decodeMessage(EvtMessage* msg, MsgHandler& msghandler, DecodedMessage& decoded);
+
+    /** Restore DataStore objects decoded by decodeMessage().
+     *  @param decoded    decoded objects, ownership is taken over (the lists are cleared).
+     */
+    int restoreDataStore(DecodedMessage& decoded);
+
     /** Set names of objects to be streamed/destreamed. */
     void setStreamingObjects(const std::vector<std::string>& list);
 
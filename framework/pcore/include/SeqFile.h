@@ -8,13 +8,36 @@
 
 #pragma once
 
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Belle2 {
 
-  /** A class to manage I/O for a chain of blocked files */
+  /** Entry of the event index written at the end of each file of a SeqFile chain */
+  struct SeqFileIndexEntry {
+    int64_t offset; /**< position of the record in the file, in bytes from the start of the file */
+    int experiment; /**< experiment number of the event */
+    int run; /**< run number of the event */
+    unsigned int event; /**< event number of the event */
+    int size; /**< size of the record in bytes */
+  };
+
+  /** A class to manage I/O for a chain of blocked files
+   *
+   * Each file contains a sequence of records, the first word of each record
+   * is its size in bytes. Optionally (not for gzip compressed files) an event
+   * index is appended to each file as a last record which is recognized by
+   * c_IndexMagic in its second word (where normal records have their type).
+   * The index ends with its own offset and c_IndexMagic, so it can be found
+   * from the end of the file. Files without index stay readable as before.
+   *
+   * Uncompressed files are memory-mapped for reading, so readRecord() can
+   * return the records without copying them and skipEvents() can jump over
+   * events using the index.
+   */
   class SeqFile {
   public:
     /** Constructor.
@@ -26,10 +49,12 @@ namespace Belle2 {
      * @param filenameIsPattern if true interpret the filename as a
      *     boost::format pattern which takes the sequence number as argument
      *     instead of producing .sroot-N files
+     * @param writeIndex if true append an event index to each written
+     *     file (ignored for gzip compressed files)
      */
     SeqFile(const std::string& filename, const std::string& rwflag,
             char* streamerinfo = nullptr, int streamerinfo_size = 0,
-            bool filenameIsPattern = false);
+            bool filenameIsPattern = false, bool writeIndex = false);
     /** Destructor */
     ~SeqFile();
     /** No copying */
@@ -41,12 +66,53 @@ namespace Belle2 {
 
     /** Write a record to a file.  First word of the record should contain number of words.*/
     int write(const char* buf);
+    /** Write an event record to a file and add it to the event index (if enabled) */
+    int write(const char* buf, int experiment, int run, unsigned int event);
     /** Read a record from a file. The record length is returned. */
     int read(char* buf, int max);
+    /** Read the next record without copying it.
+     *
+     * @param record set to the start of the record, which stays valid until
+     *     the next call of a reading function (it points into the mapped file
+     *     or an internal buffer for compressed files)
+     * @return the record length, 0 at the end of all files and -1 on error
+     */
+    int readRecord(char*& record);
+    /** Skip the next n event records (StreamerInfo records are not counted).
+     *
+     * Files with an event index are not read at all, otherwise the records
+     * are read but not decoded. Returns the number of skipped events, which
+     * is smaller than n only at the end of all files.
+     */
+    int skipEvents(int n);
+    /** Does the currently read file have an event index? */
+    bool hasIndex() const { return !m_index.empty(); }
 
   private:
     /** actually open the file */
     void openFile(std::string filename, bool readonly);
+    /** close the current file, its mapping and stream */
+    void closeFile();
+    /** try to memory-map the file opened for reading, falls back to the stream if not possible */
+    void mapFile();
+    /** read the event index at the end of the mapped file (if present) */
+    void readIndex();
+    /** append the event index to the file opened for writing */
+    void writeIndex();
+    /** name of the file with the given sequence number */
+    std::string getFileName(int nfile) const;
+    /** open the next file of the chain for reading, returns false if there is none */
+    bool openNextFile();
+    /** read a record from the stream into buf (or m_buffer if buf is nullptr). Returns 0 at the end of the current file */
+    int readFromStream(char* buf, int size);
+    /** read the next record from the chain of files, pointing record into the mapping, buf or m_buffer */
+    int readNextRecord(char* buf, int size, char*& record);
+
+  public:
+    /** marker of the event index record (and the end of a file with index) */
+    constexpr static uint32_t c_IndexMagic {0x58495253};
+    /** version of the event index */
+    constexpr static uint32_t c_IndexVersion {1};
 
   private:
     /** maximal size of one file (in Bytes). */
@@ -59,6 +125,12 @@ namespace Belle2 {
     int m_nfile{0}; /**< file counter, starting at 0 (files are split after c_MaxFileSize bytes). */
     bool m_compressed{false}; /**< is file gzipped compressed? */
     std::unique_ptr<std::ios> m_stream; /**< pointer to the filtering input or output stream */
+    bool m_writeIndex{false}; /**< append an event index to each written file? */
+    std::vector<SeqFileIndexEntry> m_index; /**< event index of the current file */
+    int64_t m_offset{0}; /**< position of the next record in the current file */
+    char* m_map{nullptr}; /**< memory-mapped content of the file when reading, nullptr if not mapped */
+    int64_t m_mapSize{0}; /**< size of the mapped file */
+    std::vector<char> m_buffer; /**< buffer for readRecord() if the file is not mapped */
 
     /** StreamerInfo */
     char* m_streamerinfo;
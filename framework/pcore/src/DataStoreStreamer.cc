@@ -206,7 +206,31 @@ EvtMessage* DataStoreStreamer::streamDataStore(bool addPersistentDurability, boo
 // Restore DataStore
 int DataStoreStreamer::restoreDataStore(EvtMessage* msg)
 {
-  if (msg->type() == MSG_TERMINATE) {
+  DecodedMessage decoded;
+  decodeMessage(msg, *m_msghandler, decoded);
+  return restoreDataStore(decoded);
+}
+
+void DataStoreStreamer::decodeMessage(EvtMessage* msg, MsgHandler& msghandler, DecodedMessage& decoded)
+{
+  decoded.type = msg->type();
+  decoded.objects.clear();
+  decoded.names.clear();
+  //termination message doesn't contain data
+  if (decoded.type == MSG_TERMINATE) return;
+
+  // Clear Message Handler
+  msghandler.clear();
+
+  // Decode EvtMessage
+  msghandler.decode_msg(msg, decoded.objects, decoded.names);
+  decoded.nObjects = (msg->header())->nObjects;
+  decoded.nArrays = (msg->header())->nArrays;
+}
+
+int DataStoreStreamer::restoreDataStore(DecodedMessage& decoded)
+{
+  if (decoded.type == MSG_TERMINATE) {
     B2INFO("Got termination message. Exitting...");
     //msg doesn't really contain data, set EventMetaData to something equivalent
     StoreObjPtr<EventMetaData> eventMetaData;
@@ -215,17 +239,13 @@ int DataStoreStreamer::restoreDataStore(EvtMessage* msg)
     eventMetaData.create();
     eventMetaData->setEndOfData();
   } else {
-    // Clear Message Handler
-    m_msghandler->clear();
-
-    // List of objects to be restored
+    // List of objects to be restored, we take over ownership
     std::vector<TObject*> objlist;
     std::vector<std::string> namelist;
-
-    // Decode EvtMessage
-    m_msghandler->decode_msg(msg, objlist, namelist);
-    int nobjs = (msg->header())->nObjects;
-    int narrays = (msg->header())->nArrays;
+    objlist.swap(decoded.objects);
+    namelist.swap(decoded.names);
+    int nobjs = decoded.nObjects;
+    int narrays = decoded.nArrays;
     if (unsigned(nobjs + narrays) != objlist.size())
       B2WARNING("restoreDataStore(): inconsistent #objects/#arrays in header");
 
@@ -236,7 +256,7 @@ int DataStoreStreamer::restoreDataStore(EvtMessage* msg)
       if (obj != nullptr) {
 
         // Read and Build StreamerInfo
-        if (msg->type() == MSG_STREAMERINFO) {
+        if (decoded.type == MSG_STREAMERINFO) {
           restoreStreamerInfos(static_cast<TList*>(obj));
           return 0;
         }
@@ -120,6 +120,9 @@ ModulePtrList PathUtils::preparePaths(PathPtr& inputPath, PathPtr& mainPath, Pat
   unsigned int eventBufferSize = environment.getZMQEventBufferSize();
   unsigned int workerTimeout = environment.getZMQWorkerTimeout();
   bool useEventBackup = environment.getZMQUseEventBackup();
+  bool sizeAwareScheduling = environment.getZMQSizeAwareScheduling();
+  unsigned int prefetchDepth = environment.getZMQPrefetchDepth();
+  unsigned int decodingThreads = environment.getZMQDecodingThreads();
 
   if (inputPath) {
     // Add TXInput after input path
@@ -129,6 +132,8 @@ ModulePtrList PathUtils::preparePaths(PathPtr& inputPath, PathPtr& mainPath, Pat
     zmqTxInputModule->getParam<std::string>("xsubProxySocketName").setValue(subSocketAddress);
     zmqTxInputModule->getParam<unsigned int>("workerProcessTimeout").setValue(workerTimeout);
     zmqTxInputModule->getParam<bool>("useEventBackup").setValue(useEventBackup);
+    zmqTxInputModule->getParam<bool>("sizeAwareScheduling").setValue(sizeAwareScheduling);
+    zmqTxInputModule->getParam<unsigned int>("prefetchDepth").setValue(prefetchDepth);
     zmqTxInputModule->getParam<unsigned int>("maximalWaitingTime").setValue(maximalWaitingTime);
     appendModule(inputPath, zmqTxInputModule);
 
@@ -156,6 +161,7 @@ ModulePtrList PathUtils::preparePaths(PathPtr& inputPath, PathPtr& mainPath, Pat
     zmqRxOutputModule->getParam<std::string>("xpubProxySocketName").setValue(pubSocketAddress);
     zmqRxOutputModule->getParam<std::string>("xsubProxySocketName").setValue(subSocketAddress);
     zmqRxOutputModule->getParam<unsigned int>("maximalWaitingTime").setValue(maximalWaitingTime);
+    zmqRxOutputModule->getParam<unsigned int>("decodingThreads").setValue(decodingThreads);
     prependModule(outputPath, zmqRxOutputModule);
   }
 
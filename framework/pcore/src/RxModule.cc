@@ -20,7 +20,7 @@ RxModule::RxModule(RingBuffer* rbuf) : Module(), m_streamer(nullptr), m_nrecv(-1
 {
   //Set module properties
   setDescription("Decode data from RingBuffer into DataStore");
-  setPropertyFlags(c_Input | c_InternalSerializer);
+  setPropertyFlags(c_Input | c_InternalSerializer | c_AlwaysRun);
   setType("Rx");
 
   m_rbuf = rbuf;
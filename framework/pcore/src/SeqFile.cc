@@ -7,11 +7,17 @@
  **************************************************************************/
 
 #include <framework/pcore/SeqFile.h>
+#include <framework/pcore/EvtMessage.h>
 #include <framework/logging/Logger.h>
 
+#include <algorithm>
+#include <cstring>
 #include <ios>
 #include <fcntl.h>
 #include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <boost/iostreams/device/file_descriptor.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
@@ -22,9 +28,27 @@ using namespace Belle2;
 using namespace std;
 namespace io = boost::iostreams;
 
+namespace {
+  static_assert(sizeof(SeqFileIndexEntry) == 24, "The event index entries have to be packed");
+
+  /** size of the event index record without entries and footer: size, magic, version, number of entries */
+  constexpr int c_IndexHeaderSize = 4 * sizeof(uint32_t);
+  /** size of the footer at the very end of a file with index: offset of the index record and magic */
+  constexpr int c_IndexFooterSize = sizeof(int64_t) + sizeof(uint32_t);
+
+  /** is the record the event index? */
+  bool isIndexRecord(const char* record, int size)
+  {
+    if (size < (int)(2 * sizeof(uint32_t))) return false;
+    uint32_t magic;
+    memcpy(&magic, record + sizeof(uint32_t), sizeof(magic));
+    return magic == SeqFile::c_IndexMagic;
+  }
+}
+
 SeqFile::SeqFile(const std::string& filename, const std::string& rwflag, char* streamerinfo, int streamerinfo_size,
-                 bool filenameIsPattern):
-  m_filename(filename)
+                 bool filenameIsPattern, bool writeIndex):
+  m_filename(filename), m_writeIndex(writeIndex)
 {
   if (filename.empty()) {
     B2ERROR("SeqFile: Empty filename given");
@@ -37,6 +61,11 @@ SeqFile::SeqFile(const std::string& filename, const std::string& rwflag, char* s
   if (m_compressed) {
     m_filename = filename.substr(0, filename.size() - 3);
   }
+  // the offsets in the index refer to the uncompressed stream, so they are useless for gzip files
+  if (m_compressed && m_writeIndex) {
+    B2WARNING("SeqFile: no event index is written for gzip compressed files");
+    m_writeIndex = false;
+  }
   // check if we want different naming scheme using boost::format
   if (filenameIsPattern) {
     m_filenamePattern = m_filename;
@@ -76,6 +105,7 @@ SeqFile::SeqFile(const std::string& filename, const std::string& rwflag, char* s
 
 void SeqFile::openFile(std::string filename, bool readonly)
 {
+  closeFile();
 
   // add compression suffix if file is supposed to be compressed
   if (m_compressed) filename += ".gz";
@@ -107,25 +137,122 @@ void SeqFile::openFile(std::string filename, bool readonly)
         B2ERROR("SeqFile::openFile() error: " << e.what() << ", " << strerror(errno));
       }
     }
+    // the first record after the StreamerInfo
+    m_offset = m_streamerinfo_size;
 
   } else {
-    //open file in read mode and set stream correctly
+    //open file in read mode and map it if possible, otherwise set stream correctly
     m_fd = open(filename.c_str(), O_RDONLY);
-    auto filter = new io::filtering_istream();
-    if (m_compressed) filter->push(io::gzip_decompressor());
-    filter->push(io::file_descriptor_source(m_fd, io::close_handle));
-    filter->exceptions(ios_base::badbit | ios_base::failbit);
-    m_stream.reset(filter);
+    m_offset = 0;
+    if (m_fd >= 0 && !m_compressed) mapFile();
+    if (!m_map) {
+      auto filter = new io::filtering_istream();
+      if (m_compressed) filter->push(io::gzip_decompressor());
+      filter->push(io::file_descriptor_source(m_fd, io::close_handle));
+      filter->exceptions(ios_base::badbit | ios_base::failbit);
+      m_stream.reset(filter);
+    }
   }
   // reset number of written bytes (does not include streamerinfo )
   m_nb = 0;
 }
 
+void SeqFile::closeFile()
+{
+  if (m_map) {
+    munmap(m_map, m_mapSize);
+    m_map = nullptr;
+    m_mapSize = 0;
+    // the descriptor is not owned by a stream in this case
+    close(m_fd);
+  }
+  m_index.clear();
+  m_stream.reset();
+}
+
+void SeqFile::mapFile()
+{
+  struct stat st;
+  // only regular files can be mapped, anything else (pipes, devices) is read as a stream
+  if (fstat(m_fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) return;
+  // private writable mapping: records can be handed out as (non-const) EvtMessage
+  // buffers without copying, any modification only affects a copy of the page
+  void* map = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, m_fd, 0);
+  if (map == MAP_FAILED) {
+    B2DEBUG(20, "SeqFile: cannot map file, reading it as stream: " << strerror(errno));
+    return;
+  }
+  madvise(map, st.st_size, MADV_SEQUENTIAL);
+  m_map = static_cast<char*>(map);
+  m_mapSize = st.st_size;
+  readIndex();
+}
+
+void SeqFile::readIndex()
+{
+  if (m_mapSize < c_IndexHeaderSize + c_IndexFooterSize) return;
+  // the footer at the very end points to the index record
+  int64_t indexOffset;
+  uint32_t magic;
+  memcpy(&indexOffset, m_map + m_mapSize - c_IndexFooterSize, sizeof(indexOffset));
+  memcpy(&magic, m_map + m_mapSize - sizeof(magic), sizeof(magic));
+  if (magic != c_IndexMagic) return;
+  if (indexOffset < 0 || indexOffset > m_mapSize - c_IndexHeaderSize - c_IndexFooterSize) {
+    B2WARNING("SeqFile: invalid event index offset, reading file without index");
+    return;
+  }
+  uint32_t header[4];
+  memcpy(header, m_map + indexOffset, sizeof(header));
+  const uint32_t version = header[2], nEntries = header[3];
+  const int64_t size = header[0];
+  if (header[1] != c_IndexMagic || size != m_mapSize - indexOffset
+      || size != (int64_t)(c_IndexHeaderSize + nEntries * sizeof(SeqFileIndexEntry) + c_IndexFooterSize)) {
+    B2WARNING("SeqFile: corrupt event index, reading file without index");
+    return;
+  }
+  if (version != c_IndexVersion) {
+    B2WARNING("SeqFile: unknown event index version " << version << ", reading file without index");
+    return;
+  }
+  m_index.resize(nEntries);
+  memcpy(m_index.data(), m_map + indexOffset + c_IndexHeaderSize, nEntries * sizeof(SeqFileIndexEntry));
+}
+
+void SeqFile::writeIndex()
+{
+  auto* out = dynamic_cast<std::ostream*>(m_stream.get());
+  if (!out || m_fd < 0) return;
+  const uint32_t nEntries = m_index.size();
+  const uint32_t header[4] = {
+    static_cast<uint32_t>(c_IndexHeaderSize + nEntries * sizeof(SeqFileIndexEntry) + c_IndexFooterSize),
+    c_IndexMagic, c_IndexVersion, nEntries
+  };
+  try {
+    out->write(reinterpret_cast<const char*>(header), sizeof(header));
+    out->write(reinterpret_cast<const char*>(m_index.data()), nEntries * sizeof(SeqFileIndexEntry));
+    out->write(reinterpret_cast<const char*>(&m_offset), sizeof(m_offset));
+    out->write(reinterpret_cast<const char*>(&c_IndexMagic), sizeof(c_IndexMagic));
+    out->flush();
+  } catch (ios_base::failure& e) {
+    B2ERROR("SeqFile::writeIndex() error: " << e.what() << ", " << strerror(errno));
+  }
+  m_index.clear();
+}
+
+std::string SeqFile::getFileName(int nfile) const
+{
+  if (!m_filenamePattern.empty()) {
+    return (boost::format(m_filenamePattern) % nfile).str();
+  }
+  return m_filename + '-' + std::to_string(nfile);
+}
+
 SeqFile::~SeqFile()
 {
+  if (m_writeIndex) writeIndex();
+  closeFile();
   if (m_streamerinfo != nullptr) delete m_streamerinfo;
   B2INFO("Closing SeqFile " << m_nfile);
-  //closed automatically by m_stream.
 }
 
 int SeqFile::status() const
@@ -143,11 +270,9 @@ int SeqFile::write(const char* buf)
   int insize = *((int*)buf); // nbytes in the buffer at the beginning
   if (insize + m_nb >= c_MaxFileSize && m_filename != "/dev/null") {
     B2INFO("SeqFile: previous file closed (size=" << m_nb << " bytes)");
+    if (m_writeIndex) writeIndex();
     m_nfile++;
-    auto file = m_filename + '-' + std::to_string(m_nfile);
-    if (!m_filenamePattern.empty()) {
-      file = (boost::format(m_filenamePattern) % m_nfile).str();
-    }
+    auto file = getFileName(m_nfile);
     openFile(file, false);
     if (m_fd < 0) {
       B2FATAL("SeqFile::write() error opening file '" << file << "': " << strerror(errno));
@@ -160,6 +285,7 @@ int SeqFile::write(const char* buf)
   try {
     out->write(buf, insize);
     m_nb += insize;
+    m_offset += insize;
     return insize;
   } catch (ios_base::failure& e) {
     B2ERROR("SeqFile::write() error: " << e.what() << ", " << strerror(errno));
@@ -167,7 +293,27 @@ int SeqFile::write(const char* buf)
   }
 }
 
-int SeqFile::read(char* buf, int size)
+int SeqFile::write(const char* buf, int experiment, int run, unsigned int event)
+{
+  // the file might be split in write(), so the offset is only known afterwards
+  int size = write(buf);
+  if (m_writeIndex && size > 0) {
+    m_index.push_back({m_offset - size, experiment, run, event, size});
+  }
+  return size;
+}
+
+bool SeqFile::openNextFile()
+{
+  m_nfile++;
+  auto nextfile = getFileName(m_nfile);
+  openFile(nextfile, true);
+  if (m_fd < 0) return false;   // End of all files
+  B2INFO("SeqFile::read() opened '" << nextfile << "'");
+  return true;
+}
+
+int SeqFile::readFromStream(char* buf, int size)
 {
   // cast stream object
   auto* in = dynamic_cast<std::istream*>(m_stream.get());
@@ -181,33 +327,28 @@ int SeqFile::read(char* buf, int size)
     B2ERROR("SeqFile::read() cannot read file: " << e.what());
     return -1;
   }
-  //ok, now we can open the next file reliably
-  if (in->eof()) {
-    // EOF of current file, search for next file
-    m_nfile++;
-    auto nextfile = m_filename + '-' + std::to_string(m_nfile);
-    if (!m_filenamePattern.empty()) {
-      nextfile = (boost::format(m_filenamePattern) % m_nfile).str();
-    }
-    openFile(nextfile, true);
-    if (m_fd < 0) return 0;   // End of all files
-    // update the stream pointer
-    in = dynamic_cast<std::istream*>(m_stream.get());
-    B2INFO("SeqFile::read() opened '" << nextfile << "'");
-  }
+  // EOF of current file
+  if (in->eof()) return 0;
+  int recsize;
   try {
     // Obtain new header
-    in->read(buf, sizeof(int));
+    in->read(reinterpret_cast<char*>(&recsize), sizeof(int));
   } catch (ios_base::failure& e) {
     B2ERROR("SeqFile::read() " << e.what() << ": couldn't read next record size");
     return -1;
   }
-  // Normal processing, extract the record size from the first 4 bytes
-  int recsize = *((int*)buf);
-  if (recsize > size) {
+  if (recsize < (int)sizeof(int)) {
+    B2ERROR("SeqFile::read() invalid record size " << recsize);
+    return -1;
+  }
+  if (!buf) {
+    if ((int)m_buffer.size() < recsize) m_buffer.resize(recsize);
+    buf = m_buffer.data();
+  } else if (recsize > size) {
     B2ERROR("SeqFile::read() buffer too small, need at least " << recsize << " bytes");
     return -1;
   }
+  memcpy(buf, &recsize, sizeof(int));
   try {
     in->read(buf + sizeof(int), recsize - sizeof(int));
   } catch (ios_base::failure& e) {
@@ -216,3 +357,83 @@ int SeqFile::read(char* buf, int size)
   }
   return recsize;
 }
+
+int SeqFile::readNextRecord(char* buf, int size, char*& record)
+{
+  while (m_fd >= 0) {
+    int recsize = 0;
+    if (m_map) {
+      if (m_offset < m_mapSize) {
+        if (m_offset + (int64_t)sizeof(int) > m_mapSize) {
+          B2ERROR("SeqFile::read() end of file: couldn't read next record size");
+          return -1;
+        }
+        memcpy(&recsize, m_map + m_offset, sizeof(int));
+        if (recsize < (int)sizeof(int)) {
+          B2ERROR("SeqFile::read() invalid record size " << recsize);
+          return -1;
+        }
+        if (m_offset + recsize > m_mapSize) {
+          B2ERROR("SeqFile::read() end of file: could only read " << m_mapSize - m_offset - sizeof(int)
+                  << " bytes, expected " << recsize);
+          return -1;
+        }
+        record = m_map + m_offset;
+        m_offset += recsize;
+      }
+    } else {
+      recsize = readFromStream(buf, size);
+      if (recsize < 0) return recsize;
+      record = buf ? buf : m_buffer.data();
+    }
+    // the event index is the last record in a file, continue with the next file after it
+    if (recsize > 0 && !isIndexRecord(record, recsize)) return recsize;
+    if (!openNextFile()) return 0;
+  }
+  return 0;
+}
+
+int SeqFile::read(char* buf, int size)
+{
+  char* record = nullptr;
+  int recsize = readNextRecord(buf, size, record);
+  if (recsize > 0 && record != buf) {
+    // record is in the mapped file
+    if (recsize > size) {
+      B2ERROR("SeqFile::read() buffer too small, need at least " << recsize << " bytes");
+      return -1;
+    }
+    memcpy(buf, record, recsize);
+  }
+  return recsize;
+}
+
+int SeqFile::readRecord(char*& record)
+{
+  return readNextRecord(nullptr, 0, record);
+}
+
+int SeqFile::skipEvents(int n)
+{
+  int skipped = 0;
+  while (skipped < n && m_fd >= 0) {
+    if (m_map && !m_index.empty()) {
+      // the entries are ordered by offset, find the first event which was not read yet
+      auto next = std::lower_bound(m_index.begin(), m_index.end(), m_offset,
+      [](const SeqFileIndexEntry & entry, int64_t offset) { return entry.offset < offset; });
+      const int available = m_index.end() - next;
+      if (n - skipped < available) {
+        m_offset = (next + (n - skipped))->offset;
+        return n;
+      }
+      // nothing to read in this file anymore
+      skipped += available;
+      if (!openNextFile()) break;
+      continue;
+    }
+    char* record = nullptr;
+    if (readRecord(record) <= 0) break;
+    if (EvtMessage(record).type() != MSG_STREAMERINFO) skipped++;
+  }
+  return skipped;
+}
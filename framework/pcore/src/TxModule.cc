@@ -22,7 +22,7 @@ TxModule::TxModule(RingBuffer* rbuf) : Module(), m_streamer(nullptr), m_blocking
 {
   //Set module properties
   setDescription("Encode DataStore into RingBuffer");
-  setPropertyFlags(c_Input | c_InternalSerializer);
+  setPropertyFlags(c_Input | c_InternalSerializer | c_AlwaysRun);
   setType("Tx");
 
   m_rbuf = rbuf;
@@ -9,6 +9,7 @@
 
 #include <framework/pcore/zmq/connections/ZMQConnection.h>
 #include <framework/pcore/zmq/utils/ZMQParent.h>
+#include <framework/pcore/zmq/utils/ZMQWorkerScheduler.h>
 
 #include <framework/pcore/zmq/messages/ZMQIdMessage.h>
 #include <framework/pcore/zmq/messages/ZMQNoIdMessage.h>
@@ -18,7 +19,6 @@
 #include <string>
 #include <memory>
 #include <set>
-#include <deque>
 
 namespace Belle2 {
   /**
@@ -27,7 +27,9 @@ namespace Belle2 {
    * This part is quite strait forward: it connects via a ZMQ_DEALER socket
    * to a single output and registers itself by sending a defined number
    * of ready messages.
-   * For each event message it receives it answers with a ready message.
+   * For each event message it receives it answers with a ready message,
+   * which carries the size of the received event (so the output can follow
+   * the queue of this input).
    * All messages are passed on.
    *
    * Please note that only event messages (and raw event messages) are answered
@@ -49,12 +51,19 @@ namespace Belle2 {
    * Multiple inputs can connect to this output. The output keeps a list of all
    * received ready messages and sends events on requests always to the next
    * input in the list, which creates some sort of load-balancing.
+   * In the size aware mode, the event is instead sent to the ready input with the
+   * smallest estimated outstanding work (see ZMQWorkerScheduler), which takes the size of the
+   * events in flight and the measured processing times into account. Optionally, the number
+   * of events in flight per input can be limited by a prefetch depth.
+   * The queue depth, queue latency and estimated work of each input are reported in the
+   * monitoring values.
    *
    * Stop and terminate messages are sent all all inputs that have sent at least
-   * a single ready so far. There is no unregistration happening, so dead inputs will
-   * still be served with both events and stop/terminate messages. For stop/terminate
-   * messages this is no problem and event messages will only be sent as long as there
-   * are ready messages.
+   * a single ready so far. There is no explicit unregistration. However, if a worker
+   * timeout is given, inputs which have events in flight but do not answer any of them
+   * within this time are considered dead and are removed together with their ready
+   * messages and events in flight. If such an input sends a ready message again,
+   * it is registered anew.
    *
    * After a stop message is sent all additional incoming events will be dismissed.
    *
@@ -66,8 +75,12 @@ namespace Belle2 {
    */
   class ZMQLoadBalancedOutput : public ZMQConnectionOverSocket {
   public:
-    /// Create a new load-balanced output and bind to the given address.
-    ZMQLoadBalancedOutput(const std::string& outputAddress, bool lax, const std::shared_ptr<ZMQParent>& parent);
+    /**
+     * Create a new load-balanced output and bind to the given address. See ZMQWorkerScheduler for sizeAware and prefetchDepth.
+     * Inputs which do not answer their events within workerTimeout seconds are removed (0 to never remove them).
+     */
+    ZMQLoadBalancedOutput(const std::string& outputAddress, bool lax, const std::shared_ptr<ZMQParent>& parent,
+                          bool sizeAware = false, unsigned int prefetchDepth = 0, unsigned int workerTimeout = 0);
 
     /**
      * Send the given message (without identity) to the next input
@@ -91,8 +104,8 @@ namespace Belle2 {
     bool isReady() const final;
 
   protected:
-    /// List of identities of ready inputs in LIFO order
-    std::deque<std::string> m_readyWorkers;
+    /// Ready messages and events in flight of all inputs
+    ZMQWorkerScheduler m_scheduler;
     /// All ever registered inputs
     std::set<std::string> m_allWorkers;
     /// Did we already sent a stop message?
@@ -101,5 +114,10 @@ namespace Belle2 {
     bool m_sentTerminateMessages = false;
     /// Parameter to enable lax mode
     bool m_lax = false;
+    /// Parameter: time in seconds after which inputs which do not answer their events are removed (0 for never)
+    unsigned int m_workerTimeout = 0;
+
+    /// Remove the inputs which did not answer their events within the worker timeout
+    void removeUnresponsiveWorkers();
   };
 }
\ No newline at end of file
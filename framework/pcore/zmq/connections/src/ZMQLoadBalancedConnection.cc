@@ -37,14 +37,14 @@ std::unique_ptr<ZMQNoIdMessage> ZMQLoadBalancedInput::handleIncomingData()
   auto message = ZMQMessageFactory::fromSocket<ZMQNoIdMessage>(m_socket);
 
   if (message->isMessage(EMessageTypes::c_rawDataMessage) or message->isMessage(EMessageTypes::c_eventMessage)) {
-    // if it is an event message, return a ready message back. If not, no need for that.
-    auto readyMessage = ZMQMessageFactory::createMessage(EMessageTypes::c_readyMessage);
+    const auto dataSize = message->getDataMessage().size();
+
+    // if it is an event message, return a ready message back (with the event size). If not, no need for that.
+    auto readyMessage = ZMQMessageFactory::createMessage(EMessageTypes::c_readyMessage, std::to_string(dataSize));
     ZMQParent::send(m_socket, std::move(readyMessage));
     increment("sent_ready");
 
     // and also do some logging
-    const auto dataSize = message->getDataMessage().size();
-
     average("data_size", dataSize);
     increment("received_events");
     timeit("event_rate");
@@ -54,17 +54,19 @@ std::unique_ptr<ZMQNoIdMessage> ZMQLoadBalancedInput::handleIncomingData()
 }
 
 ZMQLoadBalancedOutput::ZMQLoadBalancedOutput(const std::string& outputAddress, bool lax,
-                                             const std::shared_ptr<ZMQParent>& parent) : ZMQConnectionOverSocket(
-                                                 parent), m_lax(lax)
+                                             const std::shared_ptr<ZMQParent>& parent, bool sizeAware,
+                                             unsigned int prefetchDepth, unsigned int workerTimeout) :
+  ZMQConnectionOverSocket(parent), m_scheduler(sizeAware, prefetchDepth), m_lax(lax), m_workerTimeout(workerTimeout)
 {
   // We clear all our internal state and counters
-  log("ready_queue_size", static_cast<long>(m_readyWorkers.size()));
+  log("ready_queue_size", static_cast<long>(m_scheduler.getNumberOfReadyMessages()));
   log("registered_workers", static_cast<long>(m_allWorkers.size()));
 
   log("data_size", 0.0);
   log("dismissed_events", 0l);
   log("event_rate", 0.0);
   log("sent_events", 0l);
+  log("removed_workers", 0l);
 
   log("all_stop_messages", 0l);
   log("sent_stop_messages",  0l);
@@ -104,7 +106,7 @@ void ZMQLoadBalancedOutput::handleEvent(std::unique_ptr<ZMQNoIdMessage> message)
     return;
   }
 
-  if (m_lax and m_readyWorkers.empty()) {
+  if (m_lax and not m_scheduler.isReady()) {
     // There is no one that can handle the event in the moment, dismiss it (if lax is true)
     increment("dismissed_events");
     return;
@@ -117,9 +119,8 @@ void ZMQLoadBalancedOutput::handleEvent(std::unique_ptr<ZMQNoIdMessage> message)
 
   const auto dataSize = message->getDataMessage().size();
 
-  B2ASSERT("Must be > 0", not m_readyWorkers.empty());
-  auto nextWorker = m_readyWorkers.front();
-  m_readyWorkers.pop_front();
+  B2ASSERT("Must be > 0", m_scheduler.isReady());
+  const auto nextWorker = m_scheduler.scheduleEvent(dataSize);
 
   average("data_size", dataSize);
   average("data_size_to[" + nextWorker + "]", dataSize);
@@ -133,8 +134,12 @@ void ZMQLoadBalancedOutput::handleEvent(std::unique_ptr<ZMQNoIdMessage> message)
   m_socket->send(ZMQMessageHelper::createZMQMessage(nextWorker), zmq::send_flags::sndmore);
   ZMQParent::send(m_socket, std::move(message));
 
-  log("ready_queue_size", static_cast<long>(m_readyWorkers.size()));
+  log("ready_queue_size", static_cast<long>(m_scheduler.getNumberOfReadyMessages()));
   decrement("ready_messages[" + nextWorker + "]");
+  log("queue_depth[" + nextWorker + "]", static_cast<long>(m_scheduler.getQueueDepth(nextWorker)));
+  log("estimated_work[" + nextWorker + "]", m_scheduler.getEstimatedWork(nextWorker));
+
+  removeUnresponsiveWorkers();
 }
 
 void ZMQLoadBalancedOutput::handleIncomingData()
@@ -142,9 +147,10 @@ void ZMQLoadBalancedOutput::handleIncomingData()
   auto readyMessage = ZMQMessageFactory::fromSocket<ZMQIdMessage>(m_socket);
   B2ASSERT("Should be a ready message", readyMessage->isMessage(EMessageTypes::c_readyMessage));
 
-  // Register it as another ready worker
+  // Register it as another ready worker. A ready message with data is the answer to an event, which the worker has just taken.
   const auto toIdentity = readyMessage->getIdentity();
-  m_readyWorkers.push_back(toIdentity);
+  const bool eventStarted = readyMessage->getDataMessage().size() > 0;
+  m_scheduler.addReady(toIdentity, eventStarted);
 
   if (m_allWorkers.emplace(toIdentity).second) {
     // Aha, we did never see this worker so far, so add it to our list.
@@ -161,9 +167,38 @@ void ZMQLoadBalancedOutput::handleIncomingData()
     }
   }
 
-  log("ready_queue_size", static_cast<long>(m_readyWorkers.size()));
+  log("ready_queue_size", static_cast<long>(m_scheduler.getNumberOfReadyMessages()));
   log("registered_workers", static_cast<long>(m_allWorkers.size()));
   increment("ready_messages[" + toIdentity + "]");
+  if (eventStarted) {
+    log("queue_depth[" + toIdentity + "]", static_cast<long>(m_scheduler.getQueueDepth(toIdentity)));
+    log("latency[" + toIdentity + "]", m_scheduler.getLatency(toIdentity));
+  }
+
+  removeUnresponsiveWorkers();
+}
+
+void ZMQLoadBalancedOutput::removeUnresponsiveWorkers()
+{
+  if (m_workerTimeout == 0) {
+    return;
+  }
+
+  // Otherwise a dead worker would keep its ready messages and events in flight forever
+  const auto removedWorkers = m_scheduler.removeUnresponsiveWorkers(std::chrono::seconds(m_workerTimeout));
+  if (removedWorkers.empty()) {
+    return;
+  }
+
+  for (const auto& worker : removedWorkers) {
+    B2WARNING("Worker " << worker << " did not answer its events for " << m_workerTimeout << " s. Will remove it.");
+    m_allWorkers.erase(worker);
+    increment("removed_workers");
+    log("ready_messages[" + worker + "]", 0l);
+    log("queue_depth[" + worker + "]", 0l);
+  }
+  log("ready_queue_size", static_cast<long>(m_scheduler.getNumberOfReadyMessages()));
+  log("registered_workers", static_cast<long>(m_allWorkers.size()));
 }
 
 void ZMQLoadBalancedOutput::clear()
@@ -178,5 +213,5 @@ void ZMQLoadBalancedOutput::clear()
 bool ZMQLoadBalancedOutput::isReady() const
 {
   // if we are lax, we are always ready. If not, we need to have at least a single ready worker. This prevents the B2ASSERT to fail.
-  return m_lax or not m_readyWorkers.empty();
+  return m_lax or m_scheduler.isReady();
 }
@@ -31,5 +31,6 @@ namespace Belle2 {
     // Only needed by DAQ
     c_monitoringMessage = 'm',   // sent in DAQ package to monitor from remote
     c_newRunMessage = 'n',              // sent in DAQ package on starting
+    c_compressedDeltaMessage = 'y',     // sent in DAQ package: changes of histograms since the last message in compressed format
   };
 }
\ No newline at end of file
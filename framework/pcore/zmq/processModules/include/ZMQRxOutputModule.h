@@ -14,11 +14,17 @@
 #include <framework/pcore/zmq/sockets/ZMQClient.h>
 #include <framework/pcore/zmq/utils/StreamHelper.h>
 
+#include <deque>
+
 namespace Belle2 {
   /**
    * Module connecting the worker path with the output path on the output side.
    * Handles the data communication and the event confirmation to the
    * input process.
+   *
+   * With decodingThreads > 0, the already received events are queued and decoded
+   * in parallel threads. They are still written to the data store (and confirmed)
+   * one after the other in the order they were received.
    */
   class ZMQRxOutputModule : public Module {
   public:
@@ -48,6 +54,11 @@ namespace Belle2 {
     int m_param_compressionLevel = 0;
     /// Parameter: Can we handle mergeables?
     bool m_param_handleMergeable = true;
+    /// Parameter: Number of threads decoding the received events in parallel
+    unsigned int m_param_decodingThreads = 0;
+
+    /// For each queued message: is it an event backup received via multicast?
+    std::deque<bool> m_queuedEventBackups;
 
     /// Our ZMQ client
     ZMQClient m_zmqClient;
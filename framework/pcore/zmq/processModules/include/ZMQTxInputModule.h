@@ -13,14 +13,16 @@
 #include <framework/core/RandomGenerator.h>
 #include <framework/pcore/zmq/sockets/ZMQClient.h>
 #include <framework/pcore/zmq/utils/StreamHelper.h>
+#include <framework/pcore/zmq/utils/ZMQWorkerScheduler.h>
 
 #include <framework/pcore/zmq/processModules/ProcessedEventsBackupList.h>
-#include <deque>
 
 namespace Belle2 {
   /**
    * Module connecting the input path with the worker path on the input side.
    * Handles the data communication and the event backup. Tells the monitor to kill processes if needed and sends an end message when done.
+   * The events are sent to the workers in the order of their ready messages or, with sizeAwareScheduling,
+   * to the worker with the smallest estimated outstanding work (see ZMQWorkerScheduler).
    */
   class ZMQTxInputModule : public Module {
   public:
@@ -34,8 +36,8 @@ namespace Belle2 {
     void initialize() override;
 
   private:
-    /// The list of next worker ids.
-    std::deque<unsigned int> m_nextWorker;
+    /// The ready messages and queued events of the workers (by their id).
+    ZMQWorkerScheduler m_scheduler;
     /// The list of all workers (to say goodbye properly).
     std::vector<unsigned int> m_workers;
     /// The backup list
@@ -47,6 +49,10 @@ namespace Belle2 {
     unsigned int m_param_workerProcessTimeout;
     /// Flag to use the event backup or not.
     bool m_param_useEventBackup;
+    /// Send the events to the worker with the smallest estimated outstanding work
+    bool m_param_sizeAwareScheduling = false;
+    /// Maximal number of events in flight per worker (0 for no limit)
+    unsigned int m_param_prefetchDepth = 0;
 
     /// Set to false if the objects are initialized
     bool m_firstEvent = true;
@@ -22,7 +22,9 @@ ZMQRxOutputModule::ZMQRxOutputModule() : Module()
   addParam("xpubProxySocketName", m_param_xpubProxySocketName, "Address of the XPUB socket of the proxy");
   addParam("xsubProxySocketName", m_param_xsubProxySocketName, "Address of the XSUB socket of the proxy");
   addParam("maximalWaitingTime", m_param_maximalWaitingTime, "Maximal time to wait for any message");
-  setPropertyFlags(EModulePropFlags::c_ParallelProcessingCertified);
+  addParam("decodingThreads", m_param_decodingThreads,
+           "Number of threads decoding the received events in parallel, 0 to decode them one by one", m_param_decodingThreads);
+  setPropertyFlags(EModulePropFlags::c_ParallelProcessingCertified | EModulePropFlags::c_AlwaysRun);
 
   B2ASSERT("Module is only allowed in a multiprocessing environment. If you only want to use a single process,"
            "set the number of processes to at least 1.",
@@ -38,7 +40,7 @@ void ZMQRxOutputModule::event()
 {
   try {
     if (m_firstEvent) {
-      m_streamer.initialize(m_param_compressionLevel, m_param_handleMergeable);
+      m_streamer.initialize(m_param_compressionLevel, m_param_handleMergeable, m_param_decodingThreads);
       m_zmqClient.initialize<ZMQ_PULL>(m_param_xpubProxySocketName, m_param_xsubProxySocketName, m_param_socketName, true);
 
       auto multicastHelloMsg = ZMQMessageFactory::createMessage(EMessageTypes::c_helloMessage, getpid());
@@ -51,21 +53,13 @@ void ZMQRxOutputModule::event()
       m_firstEvent = false;
     }
 
+    // All messages are queued, so they are handled in the order they were received
     const auto multicastAnswer = [this](const auto & socket) {
       auto message = ZMQMessageFactory::fromSocket<ZMQNoIdMessage>(socket);
-      if (message->isMessage(EMessageTypes::c_eventMessage)) {
-        B2DEBUG(100, "Having received an event backup. Will go in with this.");
-        m_streamer.read(std::move(message));
-        StoreObjPtr<EventMetaData> eventMetaData;
-        eventMetaData->addErrorFlag(EventMetaData::EventErrorFlag::c_HLTCrash);
-        return false;
-      } else if (message->isMessage(EMessageTypes::c_lastEventMessage)) {
-        B2DEBUG(100, "Having received an end message. Will not go on.");
-        // By not storing anything in the data store, we will just stop event processing here...
-        return false;
-      } else if (message->isMessage(EMessageTypes::c_terminateMessage)) {
-        B2DEBUG(100, "Having received an graceful stop message. Will not go on.");
-        // By not storing anything in the data store, we will just stop event processing here...
+      if (message->isMessage(EMessageTypes::c_eventMessage) or message->isMessage(EMessageTypes::c_lastEventMessage)
+          or message->isMessage(EMessageTypes::c_terminateMessage)) {
+        m_streamer.queue(std::move(message));
+        m_queuedEventBackups.push_back(true);
         return false;
       }
 
@@ -76,10 +70,8 @@ void ZMQRxOutputModule::event()
     const auto socketAnswer = [this](const auto & socket) {
       auto message = ZMQMessageFactory::fromSocket<ZMQNoIdMessage>(socket);
       if (message->isMessage(EMessageTypes::c_eventMessage)) {
-        m_streamer.read(std::move(message));
-        B2DEBUG(100, "received event " << m_eventMetaData->getEvent());
-        auto confirmMessage = ZMQMessageFactory::createMessage(EMessageTypes::c_confirmMessage, m_eventMetaData);
-        m_zmqClient.publish(std::move(confirmMessage));
+        m_streamer.queue(std::move(message));
+        m_queuedEventBackups.push_back(false);
         return false;
       }
 
@@ -87,10 +79,40 @@ void ZMQRxOutputModule::event()
       return true;
     };
 
-
+    // Wait for a message if nothing is queued. Otherwise only take the messages which are
+    // already there, until there are enough to keep all decoding threads busy.
     B2DEBUG(100, "Start polling");
-    const int pollReply = m_zmqClient.poll(m_param_maximalWaitingTime, multicastAnswer, socketAnswer);
-    B2ASSERT("Output process did not receive any message in some time. Aborting.", pollReply);
+    while (m_streamer.getNumberOfQueuedMessages() <= m_param_decodingThreads) {
+      if (m_streamer.getNumberOfQueuedMessages() == 0) {
+        const int pollReply = m_zmqClient.poll(m_param_maximalWaitingTime, multicastAnswer, socketAnswer);
+        B2ASSERT("Output process did not receive any message in some time. Aborting.", pollReply);
+      } else if (not m_zmqClient.poll(0, multicastAnswer, socketAnswer)) {
+        break;
+      }
+    }
+
+    // The oldest message is restored (after its decoding has finished)
+    auto message = m_streamer.readQueued();
+    const bool isEventBackup = m_queuedEventBackups.front();
+    m_queuedEventBackups.pop_front();
+
+    if (message->isMessage(EMessageTypes::c_eventMessage)) {
+      if (isEventBackup) {
+        B2DEBUG(100, "Having received an event backup. Will go in with this.");
+        StoreObjPtr<EventMetaData> eventMetaData;
+        eventMetaData->addErrorFlag(EventMetaData::EventErrorFlag::c_HLTCrash);
+      } else {
+        B2DEBUG(100, "received event " << m_eventMetaData->getEvent());
+        auto confirmMessage = ZMQMessageFactory::createMessage(EMessageTypes::c_confirmMessage, m_eventMetaData);
+        m_zmqClient.publish(std::move(confirmMessage));
+      }
+    } else if (message->isMessage(EMessageTypes::c_lastEventMessage)) {
+      B2DEBUG(100, "Having received an end message. Will not go on.");
+      // By not storing anything in the data store, we will just stop event processing here...
+    } else if (message->isMessage(EMessageTypes::c_terminateMessage)) {
+      B2DEBUG(100, "Having received an graceful stop message. Will not go on.");
+      // By not storing anything in the data store, we will just stop event processing here...
+    }
 
     B2DEBUG(100, "finished reading in an event.");
   } catch (zmq::error_t& ex) {
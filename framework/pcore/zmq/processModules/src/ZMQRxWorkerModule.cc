@@ -25,7 +25,7 @@ ZMQRxWorkerModule::ZMQRxWorkerModule() : Module()
   addParam("eventBufferSize", m_param_bufferSize, "Maximal number of events to store in the internal buffer");
   addParam("maximalWaitingTime", m_param_maximalWaitingTime, "Maximal time to wait for any message");
 
-  setPropertyFlags(EModulePropFlags::c_ParallelProcessingCertified);
+  setPropertyFlags(EModulePropFlags::c_ParallelProcessingCertified | EModulePropFlags::c_AlwaysRun);
 
   B2ASSERT("Module is only allowed in a multiprocessing environment. If you only want to use a single process,"
            "set the number of processes to at least 1.",
@@ -96,8 +96,10 @@ void ZMQRxWorkerModule::event()
       auto message = ZMQMessageFactory::fromSocket<ZMQNoIdMessage>(socket);
       if (message->isMessage(EMessageTypes::c_eventMessage)) {
         B2DEBUG(10, "received event message... write it to data store");
+        const auto dataSize = message->getDataMessage().size();
         m_streamer.read(std::move(message));
-        auto readyMessage = ZMQMessageFactory::createMessage(EMessageTypes::c_readyMessage);
+        // The event size in the ready message tells the input, that this event is started now
+        auto readyMessage = ZMQMessageFactory::createMessage(EMessageTypes::c_readyMessage, std::to_string(dataSize));
         m_zmqClient.send(std::move(readyMessage));
         return false;
       } else if (message->isMessage(EMessageTypes::c_lastEventMessage)) {
@@ -14,7 +14,6 @@
 #include <framework/datastore/StoreObjPtr.h>
 #include <thread>
 #include <chrono>
-#include <algorithm>
 
 using namespace std;
 using namespace Belle2;
@@ -29,8 +28,13 @@ ZMQTxInputModule::ZMQTxInputModule() : Module()
   addParam("maximalWaitingTime", m_param_maximalWaitingTime, "Maximal time to wait for any message");
   addParam("workerProcessTimeout", m_param_workerProcessTimeout, "Maximal time a worker is allowed to spent per event");
   addParam("useEventBackup", m_param_useEventBackup, "Turn on the event backup");
+  addParam("sizeAwareScheduling", m_param_sizeAwareScheduling,
+           "Send each event to the worker with the smallest estimated outstanding work (from the event sizes and processing times) "
+           "instead of the worker with the oldest ready message", m_param_sizeAwareScheduling);
+  addParam("prefetchDepth", m_param_prefetchDepth,
+           "Maximal number of events in flight per worker, 0 for no limit besides the worker's buffer size", m_param_prefetchDepth);
 
-  setPropertyFlags(EModulePropFlags::c_ParallelProcessingCertified);
+  setPropertyFlags(EModulePropFlags::c_ParallelProcessingCertified | EModulePropFlags::c_AlwaysRun);
 
   B2ASSERT("Module is only allowed in a multiprocessing environment. If you only want to use a single process,"
            "set the number of processes to at least 1.",
@@ -48,6 +52,7 @@ void ZMQTxInputModule::event()
   try {
     if (m_firstEvent) {
       m_streamer.initialize(m_param_compressionLevel, m_param_handleMergeable);
+      m_scheduler = ZMQWorkerScheduler(m_param_sizeAwareScheduling, m_param_prefetchDepth);
       m_zmqClient.initialize<ZMQ_ROUTER>(m_param_xpubProxySocketName, m_param_xsubProxySocketName, m_param_socketName, true);
 
       auto multicastHelloMsg = ZMQMessageFactory::createMessage(EMessageTypes::c_helloMessage, getpid());
@@ -67,7 +72,7 @@ void ZMQTxInputModule::event()
     }
 
     int timeout = m_param_maximalWaitingTime;
-    if (not m_nextWorker.empty()) {
+    if (m_scheduler.isReady()) {
       // if next worker are available do not waste time
       timeout = 0;
     }
@@ -94,7 +99,7 @@ void ZMQTxInputModule::event()
         B2DEBUG(10, "received worker delete message, workerID: " << workerID);
 
         m_procEvtBackupList.sendWorkerBackupEvents(workerID, m_zmqClient);
-        m_nextWorker.erase(std::remove(m_nextWorker.begin(), m_nextWorker.end(), workerID), m_nextWorker.end());
+        m_scheduler.removeWorker(std::to_string(workerID));
         return true;
       } else if (multicastMessage->isMessage(EMessageTypes::c_terminateMessage)) {
         B2DEBUG(10, "Having received a stop message. I can not do much here, but just hope for the best.");
@@ -109,7 +114,8 @@ void ZMQTxInputModule::event()
       const auto message = ZMQMessageFactory::fromSocket<ZMQIdMessage>(socket);
       if (message->isMessage(EMessageTypes::c_readyMessage)) {
         B2DEBUG(10, "got worker ready message");
-        m_nextWorker.push_back(std::stoi(message->getIdentity()));
+        // A ready message with data is the answer to an event, which the worker has just taken
+        m_scheduler.addReady(message->getIdentity(), message->getDataMessage().size() > 0);
         return false;
       }
 
@@ -117,28 +123,31 @@ void ZMQTxInputModule::event()
       return true;
     };
 
-    m_zmqClient.poll(timeout, multicastAnswer, socketAnswer);
+    int pollResult = m_zmqClient.poll(timeout, multicastAnswer, socketAnswer);
+    // With a prefetch depth, a ready message does not necessarily make its worker ready, so we may need to wait for more
+    while (pollResult and not terminate and not m_scheduler.isReady()) {
+      pollResult = m_zmqClient.poll(m_param_maximalWaitingTime, multicastAnswer, socketAnswer);
+    }
     // false positive due to lambda capture ...
     if (terminate) {
       m_zmqClient.terminate();
       return;
     }
 
-    B2ASSERT("Did not receive any ready messaged for quite some time!", not m_nextWorker.empty());
-
-    const unsigned int nextWorker = m_nextWorker.front();
-    m_nextWorker.pop_front();
-    B2DEBUG(10, "Next worker is " << nextWorker);
+    B2ASSERT("Did not receive any ready messaged for quite some time!", m_scheduler.isReady());
 
     auto eventMessage = m_streamer.stream();
 
     if (eventMessage->size() > 0) {
-      auto message = ZMQMessageFactory::createMessage(std::to_string(nextWorker), EMessageTypes::c_eventMessage, eventMessage);
+      const std::string nextWorker = m_scheduler.scheduleEvent(eventMessage->size());
+      B2DEBUG(10, "Next worker is " << nextWorker << " with " << m_scheduler.getQueueDepth(nextWorker) << " queued events");
+
+      auto message = ZMQMessageFactory::createMessage(nextWorker, EMessageTypes::c_eventMessage, eventMessage);
       m_zmqClient.send(std::move(message));
       B2DEBUG(10, "Having send message to worker " << nextWorker);
 
       if (m_param_useEventBackup) {
-        m_procEvtBackupList.storeEvent(std::move(eventMessage), m_eventMetaData, nextWorker);
+        m_procEvtBackupList.storeEvent(std::move(eventMessage), m_eventMetaData, std::stoi(nextWorker));
         B2DEBUG(10, "stored event " << m_eventMetaData->getEvent() << " backup.. list size: " << m_procEvtBackupList.size());
         checkWorkerProcTimeout();
       }
@@ -169,7 +178,7 @@ void ZMQTxInputModule::checkWorkerProcTimeout()
     m_zmqClient.publish(std::move(deathMessage));
 
     m_procEvtBackupList.sendWorkerBackupEvents(workerID, m_zmqClient);
-    m_nextWorker.erase(std::remove(m_nextWorker.begin(), m_nextWorker.end(), workerID), m_nextWorker.end());
+    m_scheduler.removeWorker(std::to_string(workerID));
   }
 }
 
@@ -18,7 +18,7 @@ ZMQTxWorkerModule::ZMQTxWorkerModule() : Module()
   addParam("socketName", m_param_socketName, "Name of the socket to connect this module to.");
   addParam("xpubProxySocketName", m_param_xpubProxySocketName, "Address of the XPUB socket of the proxy");
   addParam("xsubProxySocketName", m_param_xsubProxySocketName, "Address of the XSUB socket of the proxy");
-  setPropertyFlags(EModulePropFlags::c_ParallelProcessingCertified);
+  setPropertyFlags(EModulePropFlags::c_ParallelProcessingCertified | EModulePropFlags::c_AlwaysRun);
 
   B2ASSERT("Module is only allowed in a multiprocessing environment. If you only want to use a single process,"
            "set the number of processes to at least 1.",
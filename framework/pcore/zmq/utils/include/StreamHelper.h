@@ -11,24 +11,85 @@
 #include <framework/datastore/StoreObjPtr.h>
 #include <framework/core/RandomGenerator.h>
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace Belle2 {
 
-  /// Helper class for data store serialization
+  /**
+   * Helper class for data store serialization
+   *
+   * Received messages can either be restored directly with read() or be put
+   * into a queue with queue() and restored in the same order with readQueued().
+   * If decoding threads are used, the event messages in the queue are decoded
+   * in the background while the data store is only touched in readQueued(),
+   * so the expensive ROOT deserialization of several events runs in parallel.
+   */
   class StreamHelper {
   public:
-    /// Initialize this class. Call this e.g. in the first event.
-    void initialize(int compressionLevel, bool handleMergeable);
+    /// Stop the decoding threads
+    ~StreamHelper();
+
+    /**
+     * Initialize this class. Call this e.g. in the first event (after forking, as threads are started).
+     * @param compressionLevel compression level for streaming
+     * @param handleMergeable handle Mergeable objects when restoring?
+     * @param decodingThreads number of threads to decode queued event messages, 0 to decode them in readQueued()
+     */
+    void initialize(int compressionLevel, bool handleMergeable, unsigned int decodingThreads = 0);
     /// Stream the data store into an event message
     std::unique_ptr<EvtMessage> stream(bool addPersistentDurability = true, bool streamTransientObjects = true);
     /// Read in a ZMQ message and rebuilt the data store from it.
     void read(std::unique_ptr<ZMQNoIdMessage> message);
 
+    /// Add a received message to the queue. Event messages are decoded in the background (if decoding threads are used).
+    void queue(std::unique_ptr<ZMQNoIdMessage> message);
+    /**
+     * Take the oldest message from the queue. If it is an event message, the data store is rebuilt from it
+     * (waiting for its decoding if needed). All messages are returned for further handling.
+     */
+    std::unique_ptr<ZMQNoIdMessage> readQueued();
+    /// Number of messages in the queue
+    size_t getNumberOfQueuedMessages() const { return m_queue.size(); }
+
   private:
+    /// A message in the queue together with its decoded objects
+    struct QueuedMessage {
+      /// The received message
+      std::unique_ptr<ZMQNoIdMessage> message;
+      /// The decoded objects (only for event messages decoded in a thread)
+      DataStoreStreamer::DecodedMessage decoded;
+      /// Is the decoding done? Protected by m_mutex.
+      bool isDecoded = false;
+    };
+
+    /// Main function of the decoding threads
+    void decode();
+    /// Copy the random generator from the restored data store
+    void restoreRandomGenerator();
+
     /// The data store streamer to use
     std::unique_ptr<DataStoreStreamer> m_streamer;
     /// The random generator object in the data store that we need to transport also
     StoreObjPtr<RandomGenerator> m_randomGenerator;
+
+    /// Queued messages in the order they were received
+    std::deque<std::unique_ptr<QueuedMessage>> m_queue;
+    /// Queued event messages not yet picked up by a decoding thread. Protected by m_mutex.
+    std::deque<QueuedMessage*> m_toDecode;
+    /// The decoding threads
+    std::vector<std::thread> m_decodingThreads;
+    /// Mutex for the communication with the decoding threads
+    std::mutex m_mutex;
+    /// Signals new messages to decode (or stopping) to the decoding threads
+    std::condition_variable m_toDecodeCondition;
+    /// Signals decoded messages to readQueued()
+    std::condition_variable m_decodedCondition;
+    /// Should the decoding threads stop? Protected by m_mutex.
+    bool m_stopDecoding = false;
   };
 }
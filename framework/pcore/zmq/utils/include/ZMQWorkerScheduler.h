@@ -0,0 +1,131 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Belle2 {
+  /**
+   * Bookkeeping of the ready messages of the workers and the decision which worker gets the next event.
+   *
+   * Each ready message of a worker is a credit for one event. Workers send a number of ready messages
+   * when they register (their buffer size) and one more for every event they take out of their queue
+   * to process it (marked by a non-empty data part of the ready message, see ZMQLoadBalancedInput).
+   * This allows to follow each worker's queue: events are sent, wait in the worker's buffer and are
+   * started one after the other.
+   *
+   * Two scheduling modes are available:
+   * - ready order: the event goes to the worker with the oldest unused ready message, which is the
+   *   classical load balancing purely on ready messages.
+   * - size aware: the event goes to the worker with the smallest estimated outstanding work, i.e. the
+   *   summed size of its queued events and the rest of its currently processed event, converted into
+   *   time with the processing time per byte measured for this worker (from the time between the
+   *   start of two consecutive events). Workers which have just received a huge event therefore get
+   *   the next events only after the others have caught up.
+   *
+   * In both modes, the number of events queued at a worker can be limited further with a prefetch depth.
+   *
+   * Workers are never unregistered by themselves. A worker which has events queued but does not start any
+   * of them for a given timeout is considered to be gone and can be removed with removeUnresponsiveWorkers,
+   * so its ready messages and events do not stay in the bookkeeping forever. If it is still alive after all,
+   * its next ready message registers it again.
+   */
+  class ZMQWorkerScheduler {
+  public:
+    /// Clock used for all time measurements
+    using Clock = std::chrono::steady_clock;
+
+    /// Create a scheduler. A prefetch depth of 0 means no limit (besides the number of ready messages).
+    explicit ZMQWorkerScheduler(bool sizeAware = false, unsigned int prefetchDepth = 0);
+
+    /// Handle a ready message of the given worker. If eventStarted, the oldest queued event of this worker was started.
+    void addReady(const std::string& worker, bool eventStarted, Clock::time_point now = Clock::now());
+    /// Is there a worker which can receive an event?
+    bool isReady() const;
+    /**
+     * Choose the worker for the next event with the given size (in bytes) and book the event for it.
+     * Must only be called if isReady().
+     */
+    std::string scheduleEvent(size_t eventSize, Clock::time_point now = Clock::now());
+    /// Forget all ready messages and events of the worker (e.g. because it is gone)
+    void removeWorker(const std::string& worker);
+    /**
+     * Remove all workers which have events queued, but have not sent any ready message since the timeout
+     * (counted from their last ready message or their oldest queued event, whatever came later).
+     * Returns the identities of the removed workers.
+     */
+    std::vector<std::string> removeUnresponsiveWorkers(Clock::duration timeout, Clock::time_point now = Clock::now());
+
+    /// Number of unused ready messages of all workers
+    unsigned int getNumberOfReadyMessages() const;
+    /// Number of events sent to the worker but not started so far
+    unsigned int getQueueDepth(const std::string& worker) const;
+    /// Estimated time in seconds the worker needs for its queued events and the rest of the current one (in bytes if no time was measured so far)
+    double getEstimatedWork(const std::string& worker, Clock::time_point now = Clock::now()) const;
+    /// Average time in seconds the events of the worker waited in its queue before being started (-1 if unknown)
+    double getLatency(const std::string& worker) const;
+    /// Measured processing time in seconds per byte of event size of the worker (or of all workers, if not measured yet)
+    double getProcessingTimePerByte(const std::string& worker) const;
+
+  private:
+    /// An event sent to a worker
+    struct Event {
+      /// Size of the event in bytes
+      size_t size = 0;
+      /// When it was sent
+      Clock::time_point sent;
+      /// When it was started by the worker
+      Clock::time_point started;
+    };
+
+    /// Everything known about a single worker
+    struct Worker {
+      /// Sequence numbers of the unused ready messages (oldest first)
+      std::deque<unsigned long> readyMessages;
+      /// Events sent to the worker and not started so far (oldest first)
+      std::deque<Event> queuedEvents;
+      /// Summed size of the queued events
+      size_t queuedBytes = 0;
+      /// Is the worker processing an event?
+      bool hasCurrentEvent = false;
+      /// The currently processed event (if hasCurrentEvent)
+      Event currentEvent;
+      /// Measured processing time per byte (0 if not measured yet)
+      double processingTimePerByte = 0;
+      /// Average queue waiting time in seconds (-1 if not measured yet)
+      double latency = -1;
+      /// When the last ready message was received
+      Clock::time_point lastReady;
+    };
+
+    /// Can the worker receive an event?
+    bool canReceive(const Worker& worker) const;
+    /// Estimated outstanding work of the worker in seconds
+    double getEstimatedWork(const Worker& worker, Clock::time_point now) const;
+    /// Processing time per byte of the worker or of all workers, if not measured yet
+    double getProcessingTimePerByte(const Worker& worker) const;
+
+    /// Weight of a new measurement in the exponential moving averages
+    static constexpr double c_averageWeight = 0.1;
+
+    /// All workers by their identity
+    std::map<std::string, Worker> m_workers;
+    /// Use size aware scheduling?
+    bool m_sizeAware = false;
+    /// Maximal number of queued events per worker (0 for no limit)
+    unsigned int m_prefetchDepth = 0;
+    /// Sequence number of the next ready message
+    unsigned long m_nextReadySequence = 0;
+    /// Processing time per byte measured over all workers (0 if not measured yet)
+    double m_processingTimePerByte = 0;
+  };
+}
@@ -7,15 +7,36 @@
  **************************************************************************/
 
 #include <framework/pcore/zmq/utils/StreamHelper.h>
+#include <framework/pcore/zmq/messages/ZMQDefinitions.h>
+#include <framework/pcore/MsgHandler.h>
 #include <framework/core/Environment.h>
 #include <framework/core/RandomNumbers.h>
 #include <framework/logging/Logger.h>
 
+#include <TROOT.h>
 #include <TSystem.h>
 
 using namespace Belle2;
 
-void StreamHelper::initialize(int compressionLevel, bool handleMergeable)
+StreamHelper::~StreamHelper()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopDecoding = true;
+  }
+  m_toDecodeCondition.notify_all();
+  for (auto& thread : m_decodingThreads) {
+    thread.join();
+  }
+  // objects of messages which were decoded but never restored
+  for (auto& queued : m_queue) {
+    for (TObject* object : queued->decoded.objects) {
+      delete object;
+    }
+  }
+}
+
+void StreamHelper::initialize(int compressionLevel, bool handleMergeable, unsigned int decodingThreads)
 {
   gSystem->Load("libdataobjects");
   m_streamer = std::make_unique<DataStoreStreamer>(compressionLevel, handleMergeable);
@@ -24,6 +45,15 @@ void StreamHelper::initialize(int compressionLevel, bool handleMergeable)
     m_streamer->setStreamingObjects(Environment::Instance().getStreamingObjects());
     B2INFO("Tx: Streaming objects limited : " << (Environment::Instance().getStreamingObjects()).size() << " objects");
   }
+
+  if (decodingThreads > 0 and m_decodingThreads.empty()) {
+    // Class information is looked up and objects are created in several threads
+    ROOT::EnableThreadSafety();
+    for (unsigned int i = 0; i < decodingThreads; i++) {
+      m_decodingThreads.emplace_back(&StreamHelper::decode, this);
+    }
+    B2DEBUG(10, "Decoding event messages in " << decodingThreads << " threads");
+  }
 }
 
 std::unique_ptr<EvtMessage> StreamHelper::stream(bool addPersistentDurability, bool streamTransientObjects)
@@ -42,8 +72,73 @@ void StreamHelper::read(std::unique_ptr<ZMQNoIdMessage> message)
 {
   EvtMessage eventMessage(message->getMessagePartAsCharArray<ZMQNoIdMessage::c_data>());
   m_streamer->restoreDataStore(&eventMessage);
+  restoreRandomGenerator();
+}
 
+void StreamHelper::restoreRandomGenerator()
+{
   if (m_randomGenerator.isValid()) {
     RandomNumbers::getEventRandomGenerator() = *m_randomGenerator;
   }
 }
+
+void StreamHelper::queue(std::unique_ptr<ZMQNoIdMessage> message)
+{
+  auto queued = std::make_unique<QueuedMessage>();
+  queued->message = std::move(message);
+  if (not m_decodingThreads.empty() and queued->message->isMessage(EMessageTypes::c_eventMessage)) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_toDecode.push_back(queued.get());
+    }
+    m_toDecodeCondition.notify_one();
+  }
+  m_queue.push_back(std::move(queued));
+}
+
+std::unique_ptr<ZMQNoIdMessage> StreamHelper::readQueued()
+{
+  B2ASSERT("There is no queued message to read", not m_queue.empty());
+  std::unique_ptr<QueuedMessage> queued = std::move(m_queue.front());
+  m_queue.pop_front();
+
+  if (queued->message->isMessage(EMessageTypes::c_eventMessage)) {
+    if (m_decodingThreads.empty()) {
+      EvtMessage eventMessage(queued->message->getMessagePartAsCharArray<ZMQNoIdMessage::c_data>());
+      m_streamer->restoreDataStore(&eventMessage);
+    } else {
+      {
+        // the messages are restored in the order they were received, no matter which one is decoded first
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_decodedCondition.wait(lock, [&queued]() { return queued->isDecoded; });
+      }
+      m_streamer->restoreDataStore(queued->decoded);
+    }
+    restoreRandomGenerator();
+  }
+  return std::move(queued->message);
+}
+
+void StreamHelper::decode()
+{
+  // Each thread needs its own message handler
+  MsgHandler msgHandler(0);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_toDecodeCondition.wait(lock, [this]() { return m_stopDecoding or not m_toDecode.empty(); });
+    if (m_stopDecoding) {
+      return;
+    }
+    QueuedMessage* queued = m_toDecode.front();
+    m_toDecode.pop_front();
+
+    lock.unlock();
+    EvtMessage eventMessage(queued->message->getMessagePartAsCharArray<ZMQNoIdMessage::c_data>());
+    DataStoreStreamer::decodeMessage(&eventMessage, msgHandler, queued->decoded);
+    lock.lock();
+
+    queued->isDecoded = true;
+    m_decodedCondition.notify_all();
+  }
+}
@@ -0,0 +1,173 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <framework/pcore/zmq/utils/ZMQWorkerScheduler.h>
+#include <framework/logging/Logger.h>
+
+#include <algorithm>
+#include <tuple>
+
+using namespace Belle2;
+
+namespace {
+  /// Duration in seconds
+  double toSeconds(std::chrono::steady_clock::duration duration)
+  {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+  }
+
+  /// Add a new measurement to an exponential moving average (which is not set if <= 0)
+  void updateAverage(double& average, double value, double weight)
+  {
+    average = average <= 0 ? value : (1 - weight) * average + weight * value;
+  }
+}
+
+ZMQWorkerScheduler::ZMQWorkerScheduler(bool sizeAware, unsigned int prefetchDepth) :
+  m_sizeAware(sizeAware), m_prefetchDepth(prefetchDepth)
+{
+}
+
+void ZMQWorkerScheduler::addReady(const std::string& worker, bool eventStarted, Clock::time_point now)
+{
+  Worker& state = m_workers[worker];
+  state.readyMessages.push_back(m_nextReadySequence++);
+  state.lastReady = now;
+
+  if (not eventStarted or state.queuedEvents.empty()) {
+    return;
+  }
+
+  Event startedEvent = state.queuedEvents.front();
+  state.queuedEvents.pop_front();
+  state.queuedBytes -= startedEvent.size;
+  startedEvent.started = now;
+
+  // Only if the started event was already waiting when the current one was started, the worker went on
+  // directly after finishing the current event. Otherwise the time in between also contains idle time.
+  if (state.hasCurrentEvent and state.currentEvent.size > 0 and startedEvent.sent <= state.currentEvent.started) {
+    const double processingTimePerByte = toSeconds(now - state.currentEvent.started) / state.currentEvent.size;
+    updateAverage(state.processingTimePerByte, processingTimePerByte, c_averageWeight);
+    updateAverage(m_processingTimePerByte, processingTimePerByte, c_averageWeight);
+  }
+  updateAverage(state.latency, toSeconds(now - startedEvent.sent), c_averageWeight);
+
+  state.currentEvent = startedEvent;
+  state.hasCurrentEvent = true;
+}
+
+bool ZMQWorkerScheduler::canReceive(const Worker& worker) const
+{
+  return not worker.readyMessages.empty() and (m_prefetchDepth == 0 or worker.queuedEvents.size() < m_prefetchDepth);
+}
+
+bool ZMQWorkerScheduler::isReady() const
+{
+  return std::any_of(m_workers.begin(), m_workers.end(), [this](const auto & worker) { return canReceive(worker.second); });
+}
+
+std::string ZMQWorkerScheduler::scheduleEvent(size_t eventSize, Clock::time_point now)
+{
+  auto nextWorker = m_workers.end();
+  std::tuple<double, unsigned long> bestRank;
+  for (auto worker = m_workers.begin(); worker != m_workers.end(); ++worker) {
+    if (not canReceive(worker->second)) {
+      continue;
+    }
+    // In both modes, the oldest ready message wins if everything else is equal
+    const double work = m_sizeAware ? getEstimatedWork(worker->second, now) : 0;
+    const std::tuple<double, unsigned long> rank{work, worker->second.readyMessages.front()};
+    if (nextWorker == m_workers.end() or rank < bestRank) {
+      nextWorker = worker;
+      bestRank = rank;
+    }
+  }
+  B2ASSERT("There is no worker ready to receive an event", nextWorker != m_workers.end());
+
+  Worker& state = nextWorker->second;
+  state.readyMessages.pop_front();
+  Event event;
+  event.size = eventSize;
+  event.sent = now;
+  state.queuedEvents.push_back(event);
+  state.queuedBytes += eventSize;
+  return nextWorker->first;
+}
+
+void ZMQWorkerScheduler::removeWorker(const std::string& worker)
+{
+  m_workers.erase(worker);
+}
+
+std::vector<std::string> ZMQWorkerScheduler::removeUnresponsiveWorkers(Clock::duration timeout, Clock::time_point now)
+{
+  std::vector<std::string> removedWorkers;
+  for (auto worker = m_workers.begin(); worker != m_workers.end();) {
+    const Worker& state = worker->second;
+    if (not state.queuedEvents.empty() and now - std::max(state.lastReady, state.queuedEvents.front().sent) > timeout) {
+      removedWorkers.push_back(worker->first);
+      worker = m_workers.erase(worker);
+    } else {
+      ++worker;
+    }
+  }
+  return removedWorkers;
+}
+
+unsigned int ZMQWorkerScheduler::getNumberOfReadyMessages() const
+{
+  unsigned int readyMessages = 0;
+  for (const auto& worker : m_workers) {
+    readyMessages += worker.second.readyMessages.size();
+  }
+  return readyMessages;
+}
+
+unsigned int ZMQWorkerScheduler::getQueueDepth(const std::string& worker) const
+{
+  const auto state = m_workers.find(worker);
+  return state == m_workers.end() ? 0 : state->second.queuedEvents.size();
+}
+
+double ZMQWorkerScheduler::getEstimatedWork(const std::string& worker, Clock::time_point now) const
+{
+  const auto state = m_workers.find(worker);
+  return state == m_workers.end() ? 0 : getEstimatedWork(state->second, now);
+}
+
+double ZMQWorkerScheduler::getEstimatedWork(const Worker& worker, Clock::time_point now) const
+{
+  const double processingTimePerByte = getProcessingTimePerByte(worker);
+  if (processingTimePerByte <= 0) {
+    // Nothing measured so far: the size of the events is the best estimate we have
+    return worker.queuedBytes + (worker.hasCurrentEvent ? worker.currentEvent.size : 0);
+  }
+
+  double work = worker.queuedBytes * processingTimePerByte;
+  if (worker.hasCurrentEvent) {
+    const double remaining = worker.currentEvent.size * processingTimePerByte - toSeconds(now - worker.currentEvent.started);
+    work += std::max(remaining, 0.0);
+  }
+  return work;
+}
+
+double ZMQWorkerScheduler::getLatency(const std::string& worker) const
+{
+  const auto state = m_workers.find(worker);
+  return state == m_workers.end() ? -1 : state->second.latency;
+}
+
+double ZMQWorkerScheduler::getProcessingTimePerByte(const std::string& worker) const
+{
+  const auto state = m_workers.find(worker);
+  return state == m_workers.end() ? m_processingTimePerByte : getProcessingTimePerByte(state->second);
+}
+
+double ZMQWorkerScheduler::getProcessingTimePerByte(const Worker& worker) const
+{
+  return worker.processingTimePerByte > 0 ? worker.processingTimePerByte : m_processingTimePerByte;
+}
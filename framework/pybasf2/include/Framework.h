@@ -120,6 +120,21 @@ namespace Belle2 {
     */
     static void setStreamingObjects(const boost::python::list& streamingObjects);
 
+    /**
+     * Function to set the time budget of each event
+     *
+     * @param wallTime maximal wall time per event in seconds, 0 for no limit
+     * @param cpuTime maximal CPU time per event in seconds, 0 for no limit
+    */
+    static void setEventTimeBudget(double wallTime, double cpuTime);
+
+    /**
+     * Function to set the number of threads decoding the events in the output process of the ZMQ parallel processing
+     *
+     * @param decodingThreads number of decoding threads, 0 to decode the events one by one
+    */
+    static void setZMQDecodingThreads(unsigned int decodingThreads);
+
     /**
      * Function to set the execution realm
      *
@@ -194,6 +194,16 @@ void Framework::setStreamingObjects(const boost::python::list& streamingObjects)
   Environment::Instance().setStreamingObjects(vec);
 }
 
+void Framework::setEventTimeBudget(double wallTime, double cpuTime)
+{
+  Environment::Instance().setEventTimeBudget(wallTime, cpuTime);
+}
+
+void Framework::setZMQDecodingThreads(unsigned int decodingThreads)
+{
+  Environment::Instance().setZMQDecodingThreads(decodingThreads);
+}
+
 void Framework::setRealm(const std::string& realm)
 {
   int irealm = -1;
@@ -372,6 +382,27 @@ Set the names of all DataStore objects which should be sent between the
 parallel processes. This can be used to improve parallel processing performance
 by removing objects not required.
 )DOCSTRING");
+  def("set_event_time_budget", &Framework::setEventTimeBudget, R"DOCSTRING(
+Set a time budget for each event.
+
+Long running modules check this budget at suitable points and stop their work
+early once it is exceeded. Afterwards, the event is marked with the error flag
+``EventMetaData.c_TimeBudgetExceeded`` and all further modules except for the
+output modules and modules flagged with ``ModulePropFlags.ALWAYSRUN`` are
+skipped, so that a pathological event can not stall the processing.
+
+Parameters:
+  wall_time (float): maximal wall time per event in seconds, 0 for no limit
+  cpu_time (float): maximal CPU time per event in seconds, 0 for no limit
+)DOCSTRING", args("wall_time", "cpu_time"));
+  def("set_zmq_decoding_threads", &Framework::setZMQDecodingThreads, R"DOCSTRING(
+Set the number of threads which decode the received events in the output process
+of the ZMQ parallel processing (``basf2 --zmq``). The events are still restored
+in the order they were received.
+
+Parameters:
+  decoding_threads (int): number of decoding threads, 0 to decode the events one by one
+)DOCSTRING", args("decoding_threads"));
   {
     // The register_module function is overloaded with different signatures which makes
     // the boost docstring very useless so we handcraft a docstring
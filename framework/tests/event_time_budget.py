@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+
+"""
+Check that modules are skipped and the event is flagged once the time budget of an event is exceeded
+"""
+
+import time
+import basf2
+from ROOT import Belle2
+
+#: Number of events processed by each module, by module name
+processed = {}
+
+
+class SlowModule(basf2.Module):
+
+    """Sleep in every second event, longer than the time budget"""
+
+    def event(self):
+        """Count the event and sleep if the event number is even"""
+        processed["slow"] = processed.get("slow", 0) + 1
+        if Belle2.PyStoreObj("EventMetaData").obj().getEvent() % 2 == 0:
+            time.sleep(0.2)
+
+
+class CheckFlag(basf2.Module):
+
+    """Count the events reaching this module and check the error flag"""
+
+    def __init__(self, name, flags=None):
+        """Set up the module with a given name, optionally with property flags (e.g. as an output module)"""
+        super().__init__()
+        #: key in the processed dictionary
+        self.key = name
+        if flags is not None:
+            self.set_property_flags(flags)
+
+    def event(self):
+        """Count the event and check the flag is set for all slow events"""
+        processed[self.key] = processed.get(self.key, 0) + 1
+        evtmetadata = Belle2.PyStoreObj("EventMetaData").obj()
+        exceeded = evtmetadata.getErrorFlag() & Belle2.EventMetaData.c_TimeBudgetExceeded != 0
+        assert exceeded == (evtmetadata.getEvent() % 2 == 0)
+
+
+basf2.set_event_time_budget(0.1, 0)
+
+main = basf2.Path()
+main.add_module("EventInfoSetter", evtNumList=[10])
+main.add_module(SlowModule())
+main.add_module(CheckFlag("reconstruction"))
+main.add_module(CheckFlag("always", basf2.ModulePropFlags.ALWAYSRUN))
+main.add_module(CheckFlag("output", basf2.ModulePropFlags.OUTPUT))
+basf2.process(main)
+
+# the slow module runs in all events, the further reconstruction only in the fast ones,
+# but the output module and the module flagged to always run see all events including the flag
+assert processed["slow"] == 10
+assert processed.get("reconstruction", 0) == 5
+assert processed["always"] == 10
+assert processed["output"] == 10
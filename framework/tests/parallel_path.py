@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+
+# @cond
+
+import basf2
+import b2test_utils
+from ROOT import Belle2
+
+
+class CheckData(basf2.Module):
+
+    """check that the modules of the parallel path have been executed"""
+
+    def initialize(self):
+        """reimplementation"""
+
+        self.mcparticles = Belle2.PyStoreArray('MCParticles')
+        self.mcparticles.isRequired()
+
+    def event(self):
+        """reimplementation"""
+
+        assert self.mcparticles.getEntries() > 0
+
+
+basf2.set_random_seed("parallel")
+basf2.logging.log_level = basf2.LogLevel.WARNING
+
+# a module and a sub path as tasks, executed with one thread per task and in one thread
+for num_threads in [0, 1]:
+    main = basf2.create_path()
+    main.add_module('EventInfoSetter', evtNumList=[20])
+    parallel = basf2.create_path()
+    parallel.add_module('ParticleGun')
+    subpath = basf2.create_path()
+    subpath.add_module('EventInfoPrinter')
+    subpath.add_module('EventInfoPrinter')
+    parallel.add_path(subpath)
+    main.add_parallel_path(parallel, num_threads=num_threads)
+    main.add_module(CheckData())
+    assert b2test_utils.safe_process(main) == 0
+
+# two tasks writing the same DataStore entry cannot be executed concurrently
+main = basf2.create_path()
+main.add_module('EventInfoSetter')
+parallel = basf2.create_path()
+parallel.add_module('ParticleGun')
+parallel.add_module('ParticleGun')
+main.add_parallel_path(parallel)
+assert b2test_utils.safe_process(main) != 0
+
+# Python modules cannot be executed in worker threads
+main = basf2.create_path()
+main.add_module('EventInfoSetter')
+parallel = basf2.create_path()
+parallel.add_module(CheckData())
+main.add_parallel_path(parallel)
+assert b2test_utils.safe_process(main) != 0
+
+# @endcond
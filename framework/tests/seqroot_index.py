@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+
+# Test skipping events and selecting entries with SeqRootInput for files with
+# and without event index and with per event compression
+
+import basf2
+from ROOT import Belle2
+from b2test_utils import clean_working_directory, safe_process
+
+
+class EventNumbers(basf2.Module):
+    """Write the event numbers of all processed events to a file (processing happens in a child process)"""
+
+    def initialize(self):
+        """Start with an empty list"""
+        #: event numbers of the processed events
+        self.events = []
+
+    def event(self):
+        """Remember the current event number"""
+        self.events.append(Belle2.PyStoreObj("EventMetaData").obj().getEvent())
+
+    def terminate(self):
+        """Write the event numbers"""
+        with open("events.txt", "w") as output:
+            output.write(" ".join(str(event) for event in self.events))
+
+
+def read(filename, **params):
+    """Read the given file with SeqRootInput and return the event numbers"""
+    path = basf2.Path()
+    path.add_module("SeqRootInput", inputFileName=filename, **params)
+    path.add_module(EventNumbers())
+    assert safe_process(path) == 0
+    with open("events.txt") as events:
+        return [int(event) for event in events.read().split()]
+
+
+basf2.conditions.disable_globaltag_replay()
+basf2.logging.log_level = basf2.LogLevel.WARNING
+
+with clean_working_directory():
+    for filename, params in [("noindex.sroot", {}),
+                             ("index.sroot", {"writeIndex": True}),
+                             ("index-lz4.sroot", {"writeIndex": True, "compressionLevel": 404})]:
+        path = basf2.Path()
+        path.add_module("EventInfoSetter", evtNumList=[20])
+        path.add_module("SeqRootOutput", outputFileName=filename, **params)
+        assert safe_process(path) == 0
+
+        assert read(filename) == list(range(1, 21))
+        assert read(filename, skipNEvents=5) == list(range(6, 21))
+        assert read(filename, entrySequences=["0,3:5,17,30"]) == [1, 4, 5, 6, 18]
+        assert read(filename, entrySequences=["2:10"], skipNEvents=3) == list(range(6, 12))
+        assert read(filename, entrySequences=[":"], skipNEvents=19) == [20]
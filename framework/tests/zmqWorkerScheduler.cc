@@ -0,0 +1,155 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <framework/pcore/zmq/utils/ZMQWorkerScheduler.h>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace Belle2;
+
+namespace {
+  /// Fixed starting time for all tests
+  const ZMQWorkerScheduler::Clock::time_point c_start{};
+
+  /// Time after the start in ms
+  ZMQWorkerScheduler::Clock::time_point at(int milliseconds)
+  {
+    return c_start + std::chrono::milliseconds(milliseconds);
+  }
+
+  /** The classical mode sends the events in the order of the ready messages */
+  TEST(ZMQWorkerScheduler, ReadyOrder)
+  {
+    ZMQWorkerScheduler scheduler;
+    EXPECT_FALSE(scheduler.isReady());
+
+    scheduler.addReady("a", false, at(0));
+    scheduler.addReady("b", false, at(0));
+    scheduler.addReady("a", false, at(0));
+    EXPECT_TRUE(scheduler.isReady());
+    EXPECT_EQ(scheduler.getNumberOfReadyMessages(), 3u);
+
+    EXPECT_EQ(scheduler.scheduleEvent(1000, at(1)), "a");
+    EXPECT_EQ(scheduler.scheduleEvent(10, at(1)), "b");
+    EXPECT_EQ(scheduler.scheduleEvent(10, at(1)), "a");
+    EXPECT_FALSE(scheduler.isReady());
+    EXPECT_EQ(scheduler.getQueueDepth("a"), 2u);
+    EXPECT_EQ(scheduler.getQueueDepth("b"), 1u);
+
+    // b takes its event and asks for the next one
+    scheduler.addReady("b", true, at(5));
+    EXPECT_EQ(scheduler.getQueueDepth("b"), 0u);
+    EXPECT_NEAR(scheduler.getLatency("b"), 0.004, 1e-9);
+    EXPECT_EQ(scheduler.scheduleEvent(10, at(6)), "b");
+  }
+
+  /** The size aware mode prefers the worker with less outstanding work */
+  TEST(ZMQWorkerScheduler, SizeAware)
+  {
+    ZMQWorkerScheduler scheduler(true);
+    for (int i = 0; i < 2; i++) {
+      scheduler.addReady("a", false, at(0));
+      scheduler.addReady("b", false, at(0));
+    }
+
+    // a gets a huge event, so the next ones go to b, although a has sent the older ready message
+    EXPECT_EQ(scheduler.scheduleEvent(1000, at(0)), "a");
+    EXPECT_EQ(scheduler.scheduleEvent(100, at(0)), "b");
+    EXPECT_EQ(scheduler.scheduleEvent(100, at(0)), "b");
+    EXPECT_EQ(scheduler.getEstimatedWork("a", at(0)), 1000);
+    EXPECT_EQ(scheduler.getEstimatedWork("b", at(0)), 200);
+
+    // b starts its first event at 10ms and its second one at 20ms: 100 bytes in 10ms
+    scheduler.addReady("b", true, at(10));
+    scheduler.addReady("b", true, at(20));
+    EXPECT_NEAR(scheduler.getProcessingTimePerByte("b"), 1e-4, 1e-12);
+    // a is not measured so far, so the average of all workers is used
+    EXPECT_NEAR(scheduler.getProcessingTimePerByte("a"), 1e-4, 1e-12);
+    EXPECT_NEAR(scheduler.getEstimatedWork("b", at(25)), 0.005, 1e-9);
+    EXPECT_NEAR(scheduler.getEstimatedWork("a", at(25)), 0.1, 1e-9);
+
+    // a has one ready message left, but b has less to do
+    EXPECT_EQ(scheduler.scheduleEvent(100, at(25)), "b");
+    EXPECT_EQ(scheduler.scheduleEvent(100, at(25)), "b");
+    EXPECT_EQ(scheduler.scheduleEvent(100, at(25)), "a");
+    EXPECT_FALSE(scheduler.isReady());
+  }
+
+  /** The processing time is only measured if the worker did not wait for its next event */
+  TEST(ZMQWorkerScheduler, IdleWorker)
+  {
+    ZMQWorkerScheduler scheduler(true);
+    scheduler.addReady("a", false, at(0));
+    EXPECT_EQ(scheduler.scheduleEvent(100, at(0)), "a");
+    scheduler.addReady("a", true, at(1));
+
+    // the next event is only sent after a long time, so a was idle in between
+    EXPECT_EQ(scheduler.scheduleEvent(100, at(1000)), "a");
+    scheduler.addReady("a", true, at(1001));
+    EXPECT_EQ(scheduler.getProcessingTimePerByte("a"), 0);
+    EXPECT_NEAR(scheduler.getLatency("a"), 0.001, 1e-9);
+  }
+
+  /** The prefetch depth limits the number of queued events of each worker */
+  TEST(ZMQWorkerScheduler, PrefetchDepth)
+  {
+    ZMQWorkerScheduler scheduler(false, 1);
+    for (int i = 0; i < 3; i++) {
+      scheduler.addReady("a", false, at(0));
+    }
+
+    EXPECT_TRUE(scheduler.isReady());
+    EXPECT_EQ(scheduler.scheduleEvent(10, at(0)), "a");
+    EXPECT_FALSE(scheduler.isReady());
+    EXPECT_EQ(scheduler.getNumberOfReadyMessages(), 2u);
+
+    scheduler.addReady("a", true, at(1));
+    EXPECT_TRUE(scheduler.isReady());
+    EXPECT_EQ(scheduler.scheduleEvent(10, at(1)), "a");
+
+    scheduler.removeWorker("a");
+    EXPECT_FALSE(scheduler.isReady());
+    EXPECT_EQ(scheduler.getNumberOfReadyMessages(), 0u);
+    EXPECT_EQ(scheduler.getQueueDepth("a"), 0u);
+  }
+
+  /** Workers which do not start their queued events are removed after the timeout */
+  TEST(ZMQWorkerScheduler, UnresponsiveWorkers)
+  {
+    const std::chrono::milliseconds timeout(100);
+    ZMQWorkerScheduler scheduler;
+    for (int i = 0; i < 2; i++) {
+      scheduler.addReady("a", false, at(0));
+      scheduler.addReady("b", false, at(0));
+    }
+    // c is registered but idle for a long time, which is fine
+    scheduler.addReady("c", false, at(0));
+
+    EXPECT_EQ(scheduler.scheduleEvent(10, at(50)), "a");
+    EXPECT_EQ(scheduler.scheduleEvent(10, at(50)), "b");
+    EXPECT_TRUE(scheduler.removeUnresponsiveWorkers(timeout, at(100)).empty());
+
+    // b goes on with its events, a does not answer anymore
+    scheduler.addReady("b", true, at(120));
+    EXPECT_EQ(scheduler.scheduleEvent(10, at(130)), "a");
+    EXPECT_EQ(scheduler.scheduleEvent(10, at(140)), "b");
+    EXPECT_EQ(scheduler.scheduleEvent(10, at(140)), "c");
+    EXPECT_EQ(scheduler.removeUnresponsiveWorkers(timeout, at(200)), std::vector<std::string>({"a"}));
+    EXPECT_EQ(scheduler.getQueueDepth("a"), 0u);
+    EXPECT_EQ(scheduler.getNumberOfReadyMessages(), 1u);
+
+    // b starts its event in time, c does not
+    scheduler.addReady("b", true, at(236));
+    EXPECT_EQ(scheduler.removeUnresponsiveWorkers(timeout, at(245)), std::vector<std::string>({"c"}));
+    EXPECT_TRUE(scheduler.removeUnresponsiveWorkers(timeout, at(1000)).empty());
+
+    // a comes back and is registered again
+    scheduler.addReady("a", true, at(1000));
+    EXPECT_TRUE(scheduler.isReady());
+    EXPECT_EQ(scheduler.getQueueDepth("a"), 0u);
+  }
+}
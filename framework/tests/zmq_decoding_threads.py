@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+
+"""
+Check that the output process of the ZMQ parallel processing restores all events in order and with the right
+content, if the events are decoded in parallel threads. The run end and the terminate message are queued behind
+the events, so the runs and the processing must only end after all events have been restored.
+"""
+
+import json
+import subprocess
+import sys
+
+import basf2
+from ROOT import Belle2
+from b2test_utils import clean_working_directory
+
+#: Number of events in each run
+number_of_events = 50
+#: Processed runs
+runs = [1, 2]
+
+
+def get_weight(run, event):
+    """Weight set by the worker for the given event, to check that the content of the events arrives"""
+    return 1000 * run + event
+
+
+class SetWeight(basf2.Module):
+    """Worker module: store a weight depending on the run and event number"""
+
+    def __init__(self):
+        """Run this module on the workers"""
+        super().__init__()
+        self.set_property_flags(basf2.ModulePropFlags.PARALLELPROCESSINGCERTIFIED)
+
+    def event(self):
+        """Set the weight"""
+        event_meta_data = Belle2.PyStoreObj("EventMetaData").obj()
+        event_meta_data.setGeneratedWeight(get_weight(event_meta_data.getRun(), event_meta_data.getEvent()))
+
+
+class RecordEvents(basf2.Module):
+    """Output module: record the sequence of runs and events and write it to a file at the end"""
+
+    def __init__(self, file_name):
+        """Remember the output file"""
+        super().__init__()
+        #: output file of the recorded sequence
+        self.file_name = file_name
+        #: recorded sequence of run begins, events and run ends
+        self.sequence = []
+
+    def beginRun(self):
+        """Record the run begin"""
+        self.sequence.append(["begin", Belle2.PyStoreObj("EventMetaData").obj().getRun()])
+
+    def event(self):
+        """Record the event with its weight"""
+        event_meta_data = Belle2.PyStoreObj("EventMetaData").obj()
+        self.sequence.append(["event", event_meta_data.getRun(), event_meta_data.getEvent(),
+                              event_meta_data.getGeneratedWeight()])
+
+    def endRun(self):
+        """Record the run end"""
+        self.sequence.append(["end", Belle2.PyStoreObj("EventMetaData").obj().getRun()])
+
+    def terminate(self):
+        """Write out the sequence (only in the output process, which has seen the events)"""
+        if self.sequence:
+            with open(self.file_name, "w") as output_file:
+                json.dump(self.sequence, output_file)
+
+
+if len(sys.argv) > 1:
+    # Processing with ZMQ, as started below
+    basf2.set_random_seed("zmq_decoding_threads")
+    # A single worker keeps the order of the events, so the output has to restore them in exactly this order
+    basf2.set_nprocesses(1)
+    basf2.set_zmq_decoding_threads(2)
+
+    main = basf2.Path()
+    main.add_module("EventInfoSetter", evtNumList=[number_of_events] * len(runs), runList=runs, expList=[0] * len(runs))
+    main.add_module(SetWeight())
+    main.add_module(RecordEvents(sys.argv[1]))
+    basf2.process(main)
+    sys.exit(0)
+
+expected_sequence = []
+for run in runs:
+    expected_sequence.append(["begin", run])
+    for event in range(1, number_of_events + 1):
+        expected_sequence.append(["event", run, event, get_weight(run, event)])
+    expected_sequence.append(["end", run])
+
+with clean_working_directory():
+    # The ZMQ parallel processing can only be enabled on the command line
+    steering_file = basf2.find_file("framework/tests/zmq_decoding_threads.py")
+    assert 0 == subprocess.run(["basf2", "--zmq", steering_file, "sequence.json"]).returncode
+
+    with open("sequence.json") as sequence_file:
+        sequence = json.load(sequence_file)
+    assert sequence == expected_sequence, f"Unexpected sequence of runs and events: {sequence}"
@@ -70,6 +70,8 @@ namespace Belle2 {
       SoftwareTriggerObject m_calculationResult;
       /// Flag to not add the branches twice to the TTree.
       bool m_debugPrepared = false;
+      /// Address of the values when the branches of the TTree were set.
+      const double* m_debugValues = nullptr;
     };
   }
 }
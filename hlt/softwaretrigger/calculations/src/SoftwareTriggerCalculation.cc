@@ -10,18 +10,28 @@
 
 #include <framework/logging/Logger.h>
 
+#include <TBranch.h>
+
 namespace Belle2 {
   namespace SoftwareTrigger {
     void SoftwareTriggerCalculation::writeDebugOutput(const std::unique_ptr<TTree>& debugOutputTTree)
     {
       if (not m_debugPrepared) {
-        for (auto& identifierWithValue : m_calculationResult) {
-          const std::string& identifier = identifierWithValue.first;
-          double& value = identifierWithValue.second;
-
-          debugOutputTTree->Branch(identifier.c_str(), &value);
+        for (unsigned int slot : m_calculationResult.getSlotsByName()) {
+          const std::string& identifier = SoftwareTriggerObject::getName(slot);
+          debugOutputTTree->Branch(identifier.c_str(), m_calculationResult.getValueAddress(slot));
         }
         m_debugPrepared = true;
+        m_debugValues = m_calculationResult.data();
+      } else if (m_calculationResult.data() != m_debugValues) {
+        // the values have been moved by adding new variables
+        for (unsigned int slot : m_calculationResult.getSlotsByName()) {
+          TBranch* branch = debugOutputTTree->GetBranch(SoftwareTriggerObject::getName(slot).c_str());
+          if (branch) {
+            branch->SetAddress(m_calculationResult.getValueAddress(slot));
+          }
+        }
+        m_debugValues = m_calculationResult.data();
       }
 
       debugOutputTTree->Fill();
@@ -29,9 +39,9 @@ namespace Belle2 {
 
     void SoftwareTriggerCalculation::addDebugOutput(const StoreObjPtr<SoftwareTriggerVariables>& storeObject, const std::string& prefix)
     {
-      for (auto& identifierWithValue : m_calculationResult) {
-        const std::string& identifier = identifierWithValue.first;
-        const double value = identifierWithValue.second;
+      for (unsigned int slot : m_calculationResult.getSlotsByName()) {
+        const std::string& identifier = SoftwareTriggerObject::getName(slot);
+        const double value = m_calculationResult.at(slot);
 
         storeObject->append(prefix + "_" + identifier, value);
       }
@@ -7,8 +7,8 @@
  **************************************************************************/
 #pragma once
 
-#include <map>
 #include <string>
+#include <vector>
 
 namespace Belle2 {
   namespace SoftwareTrigger {
@@ -20,7 +20,104 @@ namespace Belle2 {
      *
      * This has the advantage that the values are only created once and can
      * share temporary objects during calculation.
+     *
+     * Every variable name is assigned a slot number once (shared by all objects),
+     * the values are stored in a flat array indexed by the slot. The variables of
+     * the cuts resolve their slot when the cut is compiled, so checking a cut does not
+     * need any string comparison. The calculations can still fill the object by name,
+     * it behaves like a std::map<std::string, double> in this respect: operator[]
+     * adds a variable (with value 0) if it is not present yet and iterating with
+     * getSlotsByName() visits the variables in the order of their names.
      */
-    typedef std::map<std::string, double> SoftwareTriggerObject;
+    class SoftwareTriggerObject {
+    public:
+      /// Get the slot of a variable name, a new slot is assigned to an unknown name.
+      static unsigned int getSlot(const std::string& name);
+
+      /// Get the name of the variable in the given slot.
+      static const std::string& getName(unsigned int slot);
+
+      /// Access the variable with the given name, adding it with value 0 if not present.
+      double& operator[](const std::string& name)
+      {
+        return getOrAdd(getSlot(name));
+      }
+
+      /// Value of the variable in the given slot, throws std::out_of_range if it is not present.
+      double at(unsigned int slot) const
+      {
+        if (not has(slot)) {
+          throwOutOfRange(slot);
+        }
+        return m_values[slot];
+      }
+
+      /// Value of the variable with the given name, throws std::out_of_range if it is not present.
+      double at(const std::string& name) const
+      {
+        return at(getSlot(name));
+      }
+
+      /// Is the variable in the given slot present in this object?
+      bool has(unsigned int slot) const
+      {
+        return slot < m_isPresent.size() and m_isPresent[slot];
+      }
+
+      /// Number of variables present in this object.
+      size_t size() const
+      {
+        return m_slotsByName.size();
+      }
+
+      /// Slots of the variables present in this object, ordered by the variable names.
+      const std::vector<unsigned int>& getSlotsByName() const
+      {
+        return m_slotsByName;
+      }
+
+      /// Address of the value in the given slot. It changes whenever new variables are added.
+      double* getValueAddress(unsigned int slot)
+      {
+        return &m_values.at(slot);
+      }
+
+      /// Start of the flat array of values (indexed by slot). It changes whenever new variables are added.
+      const double* data() const
+      {
+        return m_values.data();
+      }
+
+      /// Remove all variables.
+      void clear()
+      {
+        m_values.clear();
+        m_isPresent.clear();
+        m_slotsByName.clear();
+      }
+
+    private:
+      /// Access the variable in the given slot, adding it with value 0 if not present.
+      double& getOrAdd(unsigned int slot)
+      {
+        if (not has(slot)) {
+          add(slot);
+        }
+        return m_values[slot];
+      }
+
+      /// Add the variable in the given slot with value 0.
+      void add(unsigned int slot);
+
+      /// Throw the std::out_of_range exception for a variable which is not present.
+      [[noreturn]] static void throwOutOfRange(unsigned int slot);
+
+      /// Values indexed by slot.
+      std::vector<double> m_values;
+      /// Flags if the variable in a slot is present.
+      std::vector<char> m_isPresent;
+      /// Slots of the present variables, ordered by name.
+      std::vector<unsigned int> m_slotsByName;
+    };
   }
 }
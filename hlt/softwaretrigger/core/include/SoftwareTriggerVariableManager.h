@@ -9,6 +9,7 @@
 
 #include <hlt/softwaretrigger/core/SoftwareTriggerObject.h>
 
+#include <map>
 #include <memory>
 
 namespace Belle2 {
@@ -25,7 +26,7 @@ namespace Belle2 {
      * at hand at all time) or use temporary shared calculation objects when compiling the numbers.
      * Whenever a SoftwareTriggerCut has a variable it it and the check function asks the variable
      * manager for its value, the variable manager will collect this value from the
-     * SoftwareTriggerObject (a map from std::string to double) with the given variable name. So you as
+     * SoftwareTriggerObject (a map from the variable name to double) with the given variable name. So you as
      * the user has to make sure that the needed variables can be found in the SoftwareTriggerObject,
      * that you hand in to the checkPreScaled function of the SoftwareTriggerCut.
      */
@@ -47,19 +48,24 @@ namespace Belle2 {
         /**
          * Function wich is called by the SoftwareTriggerCut whenever the value of this variable is needed.
          * As the values are all already compiled, it just takes the corresponding number
-         * from the map of values given as the SoftwareTriggerObject.
+         * from the map of values given as the SoftwareTriggerObject, using the slot of the
+         * variable which was resolved once when the variable was created.
          */
         double function(const SoftwareTriggerObject* mapOfValues) const
         {
-          return mapOfValues->at(name);
+          return mapOfValues->at(slot);
         }
 
         /// Name of this particular variable.
         std::string name = "";
 
+        /// Slot of this variable in the SoftwareTriggerObject.
+        unsigned int slot = 0;
+
       private:
         /// Private constructor. Should only be called by the SoftwareTriggerVariableManager.
-        explicit SoftwareTriggerVariable(const std::string& theName) : name(theName) { }
+        explicit SoftwareTriggerVariable(const std::string& theName) :
+          name(theName), slot(SoftwareTriggerObject::getSlot(theName)) { }
 
         /// Make the object move constructable
         SoftwareTriggerVariable(SoftwareTriggerVariable&&) = default;
@@ -0,0 +1,72 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <hlt/softwaretrigger/core/SoftwareTriggerObject.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Belle2 {
+  namespace SoftwareTrigger {
+    namespace {
+      /// Registry of the variable names and their slots, shared by all objects.
+      struct SlotRegistry {
+        /// slot for each name
+        std::unordered_map<std::string, unsigned int> slots;
+        /// name for each slot
+        std::vector<std::string> names;
+      };
+
+      /// Get the registry.
+      SlotRegistry& getRegistry()
+      {
+        static SlotRegistry registry;
+        return registry;
+      }
+    }
+
+    unsigned int SoftwareTriggerObject::getSlot(const std::string& name)
+    {
+      SlotRegistry& registry = getRegistry();
+      auto slotIterator = registry.slots.find(name);
+      if (slotIterator != registry.slots.end()) {
+        return slotIterator->second;
+      }
+      const unsigned int slot = registry.names.size();
+      registry.names.push_back(name);
+      registry.slots.emplace(name, slot);
+      return slot;
+    }
+
+    const std::string& SoftwareTriggerObject::getName(unsigned int slot)
+    {
+      return getRegistry().names.at(slot);
+    }
+
+    void SoftwareTriggerObject::add(unsigned int slot)
+    {
+      if (slot >= m_values.size()) {
+        const size_t numberOfSlots = getRegistry().names.size();
+        m_values.resize(numberOfSlots, 0);
+        m_isPresent.resize(numberOfSlots, false);
+      }
+      m_values[slot] = 0;
+      m_isPresent[slot] = true;
+
+      const std::string& name = getName(slot);
+      auto position = std::lower_bound(m_slotsByName.begin(), m_slotsByName.end(), name,
+      [](unsigned int otherSlot, const std::string & otherName) { return getName(otherSlot) < otherName; });
+      m_slotsByName.insert(position, slot);
+    }
+
+    void SoftwareTriggerObject::throwOutOfRange(unsigned int slot)
+    {
+      throw std::out_of_range("Variable " + getName(slot) + " is not present in the SoftwareTriggerObject");
+    }
+  }
+}
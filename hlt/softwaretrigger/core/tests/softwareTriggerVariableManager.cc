@@ -9,6 +9,9 @@
 #include <hlt/softwaretrigger/core/SoftwareTriggerCut.h>
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 using namespace std;
 
 namespace Belle2 {
@@ -38,5 +41,35 @@ namespace Belle2 {
       softwareTriggerObject["two_variable"] = 2.3;
       EXPECT_EQ(SoftwareTriggerCutResult::c_noResult, compiledSecondCut->checkPreScaled(softwareTriggerObject));
     }
+
+    /** Test the slot based access and the ordering of the software trigger object. */
+    TEST(SoftwareTriggerVarialeManagerTest, objectSlots)
+    {
+      SoftwareTriggerObject softwareTriggerObject;
+      softwareTriggerObject["z_variable"] = 3;
+      softwareTriggerObject["a_variable"] = 1;
+      softwareTriggerObject["m_variable"] = 2;
+
+      // The slot is shared by all objects, but the variable is only present in the one it was added to
+      const unsigned int slot = SoftwareTriggerObject::getSlot("a_variable");
+      EXPECT_EQ("a_variable", SoftwareTriggerObject::getName(slot));
+      EXPECT_TRUE(softwareTriggerObject.has(slot));
+      EXPECT_FALSE(SoftwareTriggerObject().has(slot));
+      EXPECT_THROW(SoftwareTriggerObject().at(slot), std::out_of_range);
+
+      // Iteration is in the order of the names, like in a std::map
+      std::vector<std::string> names;
+      std::vector<double> values;
+      for (unsigned int variableSlot : softwareTriggerObject.getSlotsByName()) {
+        names.push_back(SoftwareTriggerObject::getName(variableSlot));
+        values.push_back(softwareTriggerObject.at(variableSlot));
+      }
+      EXPECT_EQ(std::vector<std::string>({"a_variable", "m_variable", "z_variable"}), names);
+      EXPECT_EQ(std::vector<double>({1, 2, 3}), values);
+
+      softwareTriggerObject.clear();
+      EXPECT_EQ(0u, softwareTriggerObject.size());
+      EXPECT_FALSE(softwareTriggerObject.has(slot));
+    }
   }
 }
@@ -0,0 +1,97 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#pragma once
+
+/* ROOT headers. */
+#include <TVector3.h>
+
+/* C++ headers. */
+#include <vector>
+
+namespace Belle2 {
+
+  /**
+   * Grid of (theta, phi) cells for the search of hits within a given angle
+   * from another hit.
+   * @details
+   * The cell size is close to the search angle in both directions, so a hit
+   * has to be compared only with the hits in the cells overlapping with the
+   * theta band around it and with the phi window that is allowed for its
+   * polar angle.
+   */
+  class KLMHit2dGrid {
+
+  public:
+
+    /**
+     * Constructor.
+     * @param[in] angle Search angle (rad).
+     */
+    explicit KLMHit2dGrid(double angle);
+
+    /**
+     * Destructor.
+     */
+    ~KLMHit2dGrid();
+
+    /**
+     * Fill the grid.
+     * @param[in] positions Hit positions.
+     */
+    void fill(const std::vector<TVector3>& positions);
+
+    /**
+     * Find the hits within the search angle from a hit.
+     * @param[in]  hit        Hit index.
+     * @param[out] neighbours Indices of the neighbour hits (the hit itself
+     *                        is not included), in no particular order.
+     */
+    void findNeighbours(int hit, std::vector<int>& neighbours) const;
+
+  private:
+
+    /**
+     * Get theta cell number.
+     * @param[in] theta Polar angle.
+     */
+    int getThetaCell(double theta) const;
+
+    /**
+     * Get phi cell number (without wrapping).
+     * @param[in] phi Azimuthal angle.
+     */
+    int getPhiCell(double phi) const;
+
+    /** Search angle. */
+    double m_Angle;
+
+    /** Number of theta cells. */
+    int m_NTheta;
+
+    /** Number of phi cells. */
+    int m_NPhi;
+
+    /** Width of phi cells (the full circle is divided into equal cells). */
+    double m_PhiCellWidth;
+
+    /** Hit positions. */
+    std::vector<TVector3> m_Positions;
+
+    /** Hit polar angles. */
+    std::vector<double> m_Theta;
+
+    /** Hit azimuthal angles. */
+    std::vector<double> m_Phi;
+
+    /** Hit indices in each cell (theta cell * number of phi cells + phi cell). */
+    std::vector<std::vector<int> > m_Cells;
+
+  };
+
+}
@@ -13,9 +13,12 @@
 #include <klm/dataobjects/bklm/BKLMElementNumbers.h>
 #include <klm/dataobjects/eklm/EKLMElementNumbers.h>
 #include <klm/modules/KLMClustersReconstructor/KLMHit2d.h>
+#include <klm/modules/KLMClustersReconstructor/KLMHit2dGrid.h>
 
 /* C++ headers. */
 #include <algorithm>
+#include <functional>
+#include <queue>
 
 using namespace Belle2;
 
@@ -81,7 +84,7 @@ void KLMClustersReconstructorModule::event()
   float minTime = -1;
   double p;//, v;
   std::vector<KLMHit2d> klmHit2ds, klmClusterHits;
-  std::vector<KLMHit2d>::iterator it, it0, it2;
+  std::vector<KLMHit2d>::iterator it, it0;
   KLMCluster* klmCluster;
   TVector3 hitPos;
   layerHitsBKLM = new int[nLayersBKLM];
@@ -99,38 +102,66 @@ void KLMClustersReconstructorModule::event()
   }
   /* Sort by the distance from center. */
   sort(klmHit2ds.begin(), klmHit2ds.end(), compareDistance);
-  /* Clustering. */
-  while (klmHit2ds.size() > 0) {
-    klmClusterHits.clear();
-    it = klmHit2ds.begin();
-    klmClusterHits.push_back(*it);
-    it = klmHit2ds.erase(it);
-    while (it != klmHit2ds.end()) {
-      it2 = klmClusterHits.begin();
-      switch (m_ClusterMode) {
-        case c_AnyHit:
-          while (it2 != klmClusterHits.end()) {
-            if (it->getPosition().Angle(it2->getPosition()) <
-                m_ClusteringAngle) {
-              klmClusterHits.push_back(*it);
-              it = klmHit2ds.erase(it);
-              goto clusterFound;
-            } else
-              ++it2;
+  /* Fill the angular grid. */
+  int nHitsTotal = klmHit2ds.size();
+  std::vector<TVector3> positions(nHitsTotal);
+  for (i = 0; i < nHitsTotal; i++)
+    positions[i] = klmHit2ds[i].getPosition();
+  KLMHit2dGrid grid(m_ClusteringAngle);
+  grid.fill(positions);
+  /*
+   * Clustering. The hits are processed in the order of the distance from
+   * the center; a hit is added to the cluster if it is close to a hit that
+   * has been added before it (AnyHit) or to the seed (FirstHit). The
+   * candidates are taken from the grid and processed in the increasing
+   * hit order, which reproduces the result of the sequential scan.
+   */
+  std::vector<bool> used(nHitsTotal, false);
+  std::vector<bool> queued(nHitsTotal, false);
+  std::vector<int> clusterHitIndices, neighbours;
+  std::priority_queue<int, std::vector<int>, std::greater<int> > candidates;
+  for (int seed = 0; seed < nHitsTotal; seed++) {
+    if (used[seed])
+      continue;
+    clusterHitIndices.clear();
+    clusterHitIndices.push_back(seed);
+    used[seed] = true;
+    grid.findNeighbours(seed, neighbours);
+    switch (m_ClusterMode) {
+      case c_AnyHit:
+        for (int neighbour : neighbours) {
+          if (!used[neighbour] && !queued[neighbour]) {
+            queued[neighbour] = true;
+            candidates.push(neighbour);
           }
-          break;
-        case c_FirstHit:
-          if (it->getPosition().Angle(it2->getPosition()) <
-              m_ClusteringAngle) {
-            klmClusterHits.push_back(*it);
-            it = klmHit2ds.erase(it);
-            goto clusterFound;
+        }
+        while (!candidates.empty()) {
+          int hit = candidates.top();
+          candidates.pop();
+          clusterHitIndices.push_back(hit);
+          used[hit] = true;
+          grid.findNeighbours(hit, neighbours);
+          for (int neighbour : neighbours) {
+            if (neighbour > hit && !used[neighbour] && !queued[neighbour]) {
+              queued[neighbour] = true;
+              candidates.push(neighbour);
+            }
           }
-          break;
-      }
-      ++it;
-clusterFound:;
+        }
+        break;
+      case c_FirstHit:
+        for (int neighbour : neighbours) {
+          if (!used[neighbour]) {
+            clusterHitIndices.push_back(neighbour);
+            used[neighbour] = true;
+          }
+        }
+        sort(clusterHitIndices.begin() + 1, clusterHitIndices.end());
+        break;
     }
+    klmClusterHits.clear();
+    for (int hit : clusterHitIndices)
+      klmClusterHits.push_back(klmHit2ds[hit]);
     hitPos.SetX(0);
     hitPos.SetY(0);
     hitPos.SetZ(0);
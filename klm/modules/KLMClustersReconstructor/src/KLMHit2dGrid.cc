@@ -0,0 +1,102 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+/* Own header. */
+#include <klm/modules/KLMClustersReconstructor/KLMHit2dGrid.h>
+
+/* C++ headers. */
+#include <algorithm>
+#include <cmath>
+
+using namespace Belle2;
+
+/*
+ * Relative enlargement of the search window that protects against rounding;
+ * the final selection is always done with the exact angle.
+ */
+static const double c_WindowMargin = 1.0 + 1.0e-6;
+
+KLMHit2dGrid::KLMHit2dGrid(double angle) :
+  m_Angle(angle)
+{
+  m_NTheta = std::max(1, (int)std::ceil(M_PI / angle));
+  m_NPhi = std::max(1, (int)std::ceil(2.0 * M_PI / angle));
+  m_PhiCellWidth = 2.0 * M_PI / m_NPhi;
+  m_Cells.resize(m_NTheta * m_NPhi);
+}
+
+KLMHit2dGrid::~KLMHit2dGrid()
+{
+}
+
+int KLMHit2dGrid::getThetaCell(double theta) const
+{
+  int cell = (int)std::floor(theta / m_Angle);
+  return std::max(0, std::min(cell, m_NTheta - 1));
+}
+
+int KLMHit2dGrid::getPhiCell(double phi) const
+{
+  return (int)std::floor((phi + M_PI) / m_PhiCellWidth);
+}
+
+void KLMHit2dGrid::fill(const std::vector<TVector3>& positions)
+{
+  int i, n;
+  for (std::vector<int>& cell : m_Cells)
+    cell.clear();
+  m_Positions = positions;
+  n = m_Positions.size();
+  m_Theta.resize(n);
+  m_Phi.resize(n);
+  for (i = 0; i < n; i++) {
+    m_Theta[i] = m_Positions[i].Theta();
+    m_Phi[i] = m_Positions[i].Phi();
+    int phiCell = getPhiCell(m_Phi[i]) % m_NPhi;
+    m_Cells[getThetaCell(m_Theta[i]) * m_NPhi + phiCell].push_back(i);
+  }
+}
+
+void KLMHit2dGrid::findNeighbours(int hit, std::vector<int>& neighbours) const
+{
+  neighbours.clear();
+  double theta = m_Theta[hit];
+  double window = m_Angle * c_WindowMargin;
+  int thetaMin = getThetaCell(theta - window);
+  int thetaMax = getThetaCell(theta + window);
+  /*
+   * Points within the angle a from a point with polar angle theta differ
+   * from it in phi by at most asin(sin(a) / sin(theta)), unless the cone
+   * around the point contains a pole.
+   */
+  int phiMin = 0;
+  int phiMax = m_NPhi - 1;
+  if (theta - window > 0 && theta + window < M_PI && window < 0.5 * M_PI) {
+    double sinRatio = std::sin(window) / std::sin(theta);
+    if (sinRatio < 1) {
+      double dPhi = std::asin(sinRatio) * c_WindowMargin;
+      phiMin = getPhiCell(m_Phi[hit] - dPhi);
+      phiMax = getPhiCell(m_Phi[hit] + dPhi);
+      if (phiMax - phiMin >= m_NPhi) {
+        phiMin = 0;
+        phiMax = m_NPhi - 1;
+      }
+    }
+  }
+  for (int thetaCell = thetaMin; thetaCell <= thetaMax; thetaCell++) {
+    for (int phiCell = phiMin; phiCell <= phiMax; phiCell++) {
+      int cell = thetaCell * m_NPhi + (phiCell % m_NPhi + m_NPhi) % m_NPhi;
+      for (int i : m_Cells[cell]) {
+        if (i == hit)
+          continue;
+        if (m_Positions[i].Angle(m_Positions[hit]) < m_Angle)
+          neighbours.push_back(i);
+      }
+    }
+  }
+}
@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+
+# Throughput of the PXDUnpacker on recorded ONSEN data
+#
+# usage: basf2 BenchmarkUnpacker.py -i <file with RawPXDs> [-n <events>]
+#
+# The size of the RawPXD data is summed before the unpacker and divided by
+# the event processing time of the PXDUnpacker module.
+
+import basf2 as b2
+from ROOT import Belle2
+
+
+class RawPXDSize(b2.Module):
+    """Sum the size of the RawPXD data"""
+
+    def initialize(self):
+        """Require the RawPXD array"""
+        #: RawPXD array
+        self.raw = Belle2.PyStoreArray('RawPXDs')
+        self.raw.isRequired()
+        #: total size of the RawPXD data in bytes
+        self.nBytes = 0
+
+    def event(self):
+        """Add the size of the RawPXD data of this event"""
+        for raw in self.raw:
+            self.nBytes += 4 * raw.size()
+
+
+b2.set_log_level(b2.LogLevel.ERROR)
+
+main = b2.create_path()
+main.add_module('RootInput', branchNames=['RawPXDs'])
+size = RawPXDSize()
+main.add_module(size)
+unpacker = main.add_module('PXDUnpacker')
+
+b2.process(main)
+
+# event processing time of the unpacker in seconds
+seconds = b2.statistics.get(unpacker).time_sum(b2.statistics.EVENT) * 1e-9
+megabytes = size.nBytes / 1e6
+print(b2.statistics)
+print(f'RawPXD data: {megabytes:.1f} MB, PXDUnpacker time: {seconds:.3f} s')
+if seconds > 0:
+    print(f'PXDUnpacker throughput: {megabytes / seconds:.1f} MB/s')
@@ -14,7 +14,7 @@
 #include <framework/datastore/StoreObjPtr.h>
 #include <framework/core/ModuleParam.templateDetails.h>
 
-#include <boost/crc.hpp>
+#include <pxd/unpacking/PXDCRC32.h>
 
 #include <numeric>
 
@@ -31,8 +31,7 @@ using namespace Belle2::PXD::PXDError;
 REG_MODULE(PXDPackerErr)
 
 
-using boost::crc_optimal;
-typedef crc_optimal<32, 0x04C11DB7, 0, 0, false, false> dhc_crc_32_type;
+typedef PXDCRC32 dhc_crc_32_type;
 
 ///******************************************************************
 ///*********************** Main packer code *************************
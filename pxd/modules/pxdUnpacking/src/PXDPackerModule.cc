@@ -14,7 +14,7 @@
 #include <framework/datastore/StoreObjPtr.h>
 #include <framework/core/ModuleParam.templateDetails.h>
 
-#include <boost/crc.hpp>
+#include <pxd/unpacking/PXDCRC32.h>
 #include <boost/algorithm/clamp.hpp>
 
 #include <pxd/unpacking/PXDMappingLookup.h>
@@ -35,8 +35,7 @@ REG_MODULE(PXDPacker)
 //                 Implementation
 //-----------------------------------------------------------------
 
-using boost::crc_optimal;
-typedef crc_optimal<32, 0x04C11DB7, 0, 0, false, false> dhe_crc_32_type;
+typedef PXDCRC32 dhe_crc_32_type;
 
 ///******************************************************************
 ///*********************** Main packer code *************************
@@ -8,7 +8,7 @@
 
 #include <pxd/modules/pxdUnpacking/PXDReadRawBonnDAQ.h>
 #include <boost/endian/arithmetic.hpp>
-#include <boost/crc.hpp>
+#include <pxd/unpacking/PXDCRC32.h>
 
 using namespace std;
 using namespace Belle2;
@@ -19,8 +19,7 @@ using ulittle32_t = boost::endian::little_uint32_t;
 using ubig16_t = boost::endian::big_uint16_t;
 using ubig32_t = boost::endian::big_uint32_t;
 
-using boost::crc_optimal;
-typedef crc_optimal<32, 0x04C11DB7, 0, 0, false, false> dhe_crc_32_type;
+typedef PXDCRC32 dhe_crc_32_type;
 
 //-----------------------------------------------------------------
 //                 Register the Module
@@ -190,9 +190,10 @@ void PXDUnpackerOTModule::unpack_rawpxd(RawPXD& px, int inx)
     m_errorMask[c_nrPACKET_SIZE] = true;
     return;
   }
-  std::vector<unsigned int> data(px.size());
+  // The frames are decoded directly from the RawPXD buffer (big endian access
+  // through ubig16_t/ubig32_t), it is only read and therefore not copied.
+  unsigned int* data = reinterpret_cast<unsigned int*>(px.data());
   fullsize = px.size() * 4; /// in bytes ... rounded up to next 32bit boundary
-  std::copy_n(px.data(), px.size(), data.begin());
 
   if (fullsize < 8) {
     if (!(m_suppressErrorMask[c_nrPACKET_SIZE])) {
@@ -213,7 +214,7 @@ void PXDUnpackerOTModule::unpack_rawpxd(RawPXD& px, int inx)
   }
 
 
-  Frames_in_event = ((ubig32_t*)data.data())[1];
+  Frames_in_event = ((ubig32_t*)data)[1];
   if (Frames_in_event < 0 || Frames_in_event > 256) {
     if (!(m_suppressErrorMask[c_nrFRAME_NR])) {
       B2WARNING("Number of Frames invalid: Will not unpack anything. Header corrupted!" << LogVar("Frames in event", Frames_in_event));
@@ -0,0 +1,48 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#include <pxd/unpacking/PXDCRC32.h>
+#include <gtest/gtest.h>
+#include <boost/crc.hpp>
+#include <random>
+#include <vector>
+
+namespace Belle2 {
+  namespace PXD {
+    /** Check that the slicing-by-8 CRC agrees with the boost CRC it replaces
+     * for all lengths, alignments and when it is fed in pieces. */
+    TEST(PXDCRC32, CompareToBoost)
+    {
+      std::mt19937 generator(42);
+      std::vector<unsigned char> data(4096);
+      for (unsigned char& byte : data) byte = generator();
+
+      for (std::size_t offset = 0; offset < 8; offset++) {
+        for (std::size_t length = 0; length < 200; length++) {
+          boost::crc_optimal<32, 0x04C11DB7, 0, 0, false, false> reference;
+          reference.process_bytes(data.data() + offset, length);
+          EXPECT_EQ(PXDCRC32::calculate(data.data() + offset, length), reference.checksum());
+
+          // in pieces, including single bytes
+          PXDCRC32 crc;
+          std::size_t half = length / 2;
+          crc.process_bytes(data.data() + offset, half);
+          if (half < length) {
+            crc.process_byte(data[offset + half]);
+            crc.process_bytes(data.data() + offset + half + 1, length - half - 1);
+          }
+          EXPECT_EQ(crc.checksum(), reference.checksum());
+        }
+      }
+
+      boost::crc_optimal<32, 0x04C11DB7, 0, 0, false, false> reference;
+      reference.process_bytes(data.data(), data.size());
+      EXPECT_EQ(PXDCRC32::calculate(data.data(), data.size()), reference.checksum());
+    }
+  }
+}
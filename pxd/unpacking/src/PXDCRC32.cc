@@ -0,0 +1,62 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#include <pxd/unpacking/PXDCRC32.h>
+
+using namespace Belle2::PXD;
+
+namespace {
+  /** Lookup tables: table[k][b] is the CRC of byte b followed by k zero bytes */
+  struct CRC32Tables {
+    uint32_t table[8][256]; /**< the tables */
+  };
+
+  /** Calculate the lookup tables at compile time */
+  constexpr CRC32Tables makeTables()
+  {
+    CRC32Tables tables{};
+    for (uint32_t b = 0; b < 256; b++) {
+      uint32_t crc = b << 24;
+      for (int bit = 0; bit < 8; bit++)
+        crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+      tables.table[0][b] = crc;
+    }
+    for (int k = 1; k < 8; k++)
+      for (uint32_t b = 0; b < 256; b++)
+        tables.table[k][b] = (tables.table[k - 1][b] << 8) ^ tables.table[0][tables.table[k - 1][b] >> 24];
+    return tables;
+  }
+
+  /** The lookup tables */
+  constexpr CRC32Tables c_tables = makeTables();
+}
+
+void PXDCRC32::process_byte(unsigned char byte)
+{
+  m_crc = (m_crc << 8) ^ c_tables.table[0][(m_crc >> 24) ^ byte];
+}
+
+void PXDCRC32::process_bytes(const void* data, std::size_t length)
+{
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  const unsigned char* end = p + length;
+  uint32_t crc = m_crc;
+  const auto& t = c_tables.table;
+
+  // 8 bytes per step, the bytes are read one by one so neither the alignment
+  // nor the endianness of the host matters
+  for (; end - p >= 8; p += 8) {
+    crc ^= (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    crc = t[7][crc >> 24] ^ t[6][(crc >> 16) & 0xFF] ^ t[5][(crc >> 8) & 0xFF] ^ t[4][crc & 0xFF]
+          ^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+  }
+  for (; p != end; p++)
+    crc = (crc << 8) ^ t[0][(crc >> 24) ^ *p];
+
+  m_crc = crc;
+}
@@ -10,7 +10,7 @@
 #include <pxd/unpacking/PXDRawDataDefinitions.h>
 #include <framework/logging/Logger.h>
 
-#include <boost/crc.hpp>
+#include <pxd/unpacking/PXDCRC32.h>
 
 
 ///*********************************************************************************
@@ -22,7 +22,7 @@ namespace Belle2 {
   namespace PXD {
 
     /// define our CRC function
-    typedef boost::crc_optimal<32, 0x04C11DB7, 0, 0, false, false> dhc_crc_32_type;
+    typedef PXDCRC32 dhc_crc_32_type;
 
     using ubig16_t = boost::endian::big_uint16_t;
     using ubig32_t = boost::endian::big_uint32_t;
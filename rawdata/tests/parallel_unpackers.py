@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+
+"""
+Test the unpackers of ECL, TOP and KLM executed concurrently with Path.add_parallel_path().
+
+The digits of rawdata/tests/digits.root are packed, then the raw data are unpacked
+once sequentially and once concurrently. The unpackers add relations between the
+arrays they write, both ways of unpacking have to give the same digits and relations.
+"""
+
+import basf2
+import b2test_utils
+import rawdata
+from ROOT import Belle2
+
+#: Name of the file with the packed raw data
+raw_file = 'raw.root'
+
+
+class CountEntries(basf2.Module):
+    """Count the unpacked digits and their relations in each event"""
+
+    def __init__(self):
+        """Initialize the counts"""
+        super().__init__()
+        #: numbers of digits and relations per event
+        self.counts = []
+
+    def event(self):
+        """Count digits and relations"""
+        ecl_digits = Belle2.PyStoreArray('ECLDigits')
+        top_digits = Belle2.PyStoreArray('TOPDigits')
+        self.counts.append((ecl_digits.getEntries(),
+                            Belle2.PyStoreArray('ECLDsps').getEntries(),
+                            sum(digit.getRelationsWith('ECLDsps').size() for digit in ecl_digits),
+                            Belle2.PyStoreArray('TOPRawDigits').getEntries(),
+                            top_digits.getEntries(),
+                            sum(digit.getRelationsWith('TOPRawDigits').size() for digit in top_digits),
+                            Belle2.PyStoreArray('KLMDigits').getEntries()))
+
+
+def pack(digits_file):
+    """Pack the ECL, TOP and KLM digits of the given file"""
+    main = basf2.create_path()
+    main.add_module('RootInput', inputFileName=digits_file)
+    rawdata.add_packers(main, components=['ECL', 'TOP', 'KLM'])
+    main.add_module('RootOutput', outputFileName=raw_file, branchNames=['RawECLs', 'RawTOPs', 'RawKLMs'])
+    assert b2test_utils.safe_process(main) == 0
+
+
+def unpack(parallel):
+    """Unpack the raw data sequentially or concurrently and return the counts of each event"""
+    main = basf2.create_path()
+    main.add_module('RootInput', inputFileName=raw_file)
+    main.add_module('Gearbox')
+    main.add_module('Geometry')
+    # one task per detector, the TOP unpacking consists of two modules
+    unpackers = basf2.create_path() if parallel else main
+    unpackers.add_module('ECLUnpacker', storeTrigTime=True)
+    top = basf2.create_path() if parallel else main
+    top.add_module('TOPUnpacker', addRelations=True)
+    top.add_module('TOPRawDigitConverter', addRelations=True)
+    if parallel:
+        unpackers.add_path(top)
+    unpackers.add_module('KLMUnpacker')
+    if parallel:
+        main.add_parallel_path(unpackers)
+    counter = CountEntries()
+    main.add_module(counter)
+    basf2.process(main)
+    assert basf2.statistics.get(counter).calls(basf2.statistics.EVENT) > 0
+    return counter.counts
+
+
+if __name__ == '__main__':
+
+    basf2.set_log_level(basf2.LogLevel.ERROR)
+    # The digits were created with an older release, the current packers and unpackers are tested
+    basf2.conditions.disable_globaltag_replay()
+    digits_file = Belle2.FileSystem.findFile('rawdata/tests/digits.root')
+
+    with b2test_utils.clean_working_directory():
+
+        pack(digits_file)
+        sequential = unpack(parallel=False)
+        concurrent = unpack(parallel=True)
+
+        assert any(count[2] > 0 and count[5] > 0 for count in sequential), "No relations have been unpacked"
+        assert sequential == concurrent, f"Concurrent unpacking differs: {sequential} vs. {concurrent}"
@@ -0,0 +1,78 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class G4VFastSimulationModel;
+
+namespace Belle2 {
+
+  namespace Simulation {
+
+    /**
+     * Registry of the Geant4 fast simulation models provided by the sub detectors.
+     *
+     * The sub detectors register a factory function for their models when their library
+     * is loaded (usually together with their geometry creator). The FullSim module then
+     * creates the models requested by its parameters, so the simulation package does not
+     * depend on the sub detector libraries. The created models are owned by this class.
+     */
+    class FastSimulationModelFactory {
+
+    public:
+
+      /**
+       * Factory function: create the models for the given library file and energy threshold
+       * and attach them to the Geant4 regions they are responsible for.
+       */
+      typedef std::vector<G4VFastSimulationModel*> Factory(const std::string& fileName, double energyThreshold);
+
+      /**
+       * Register a new fast simulation model factory.
+       * @param name Name of the fast simulation model
+       * @param factory Pointer to a function creating the models
+       */
+      static void registerFactory(const std::string& name, Factory* factory);
+
+      /**
+       * Create the models with the given name.
+       * @param name Name of the fast simulation model
+       * @param fileName Name of the file with the parameters or library of the model
+       * @param energyThreshold Minimal energy of the particles to be handled by the model in GeV
+       * @return false if no factory with the given name is registered
+       */
+      static bool createModels(const std::string& name, const std::string& fileName, double energyThreshold);
+
+      /** Delete all created models */
+      static void clear();
+
+    private:
+
+      /** singleton, hide constructor */
+      FastSimulationModelFactory() {}
+      /** singleton, hide copy constructor */
+      FastSimulationModelFactory(const FastSimulationModelFactory&) = delete;
+      /** singleton, hide assignment operator */
+      void operator=(const FastSimulationModelFactory&) = delete;
+      /** getter for the singleton instance */
+      static FastSimulationModelFactory& getInstance();
+
+      /** All registered factories by name */
+      std::map<std::string, Factory*> m_factories;
+      /** All created models */
+      std::vector<std::unique_ptr<G4VFastSimulationModel>> m_models;
+    };
+
+  } // end of namespace Simulation
+
+} // end of namespace Belle2
@@ -36,6 +36,9 @@ namespace Belle2 {
       /** virtual destructor for inheritance */
       virtual ~SensitiveDetectorBase() {}
 
+      /** Return the subdetector the sensitive detector belongs to */
+      Const::EDetector getSubdetector() const { return m_subdetector; }
+
       /** Return a list of all registered Relations with MCParticles. */
       static const std::map<std::string, RelationArray::EConsolidationAction>& getMCParticleRelations() { return s_mcRelations; }
       /** Enable/Disable all Sensitive Detectors.
@@ -9,9 +9,13 @@
 #ifndef STACKINGACTION_H_
 #define STACKINGACTION_H_
 
+#include <framework/gearbox/Const.h>
+
 #include <globals.hh>
 #include <G4UserStackingAction.hh>
 
+#include <set>
+
 namespace Belle2 {
 
   namespace Simulation {
@@ -41,10 +45,17 @@ namespace Belle2 {
       /** Set fraction of Cerenkov photons that are actually propagated. */
       void setPropagatedPhotonFraction(double fraction) { m_photonFraction = fraction; };
 
+      /**
+       * Kill the Cerenkov photons created in the sensitive volumes of a subdetector,
+       * which are simulated by a fast optical simulation instead.
+       */
+      void killOpticalPhotonsIn(Const::EDetector detector) { m_killOpticalPhotonsIn.insert(detector); };
+
 
     private:
 
       double    m_photonFraction; /**< The fraction of Cerenkov photons which will be kept and propagated. */
+      std::set<Const::EDetector> m_killOpticalPhotonsIn; /**< Subdetectors in which Cerenkov photons are killed at creation. */
 
     };
 
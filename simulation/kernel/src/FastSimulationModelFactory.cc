@@ -0,0 +1,45 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#include <simulation/kernel/FastSimulationModelFactory.h>
+#include <framework/logging/Logger.h>
+
+#include <G4VFastSimulationModel.hh>
+
+using namespace Belle2;
+using namespace Belle2::Simulation;
+
+FastSimulationModelFactory& FastSimulationModelFactory::getInstance()
+{
+  static FastSimulationModelFactory instance;
+  return instance;
+}
+
+void FastSimulationModelFactory::registerFactory(const std::string& name, Factory* factory)
+{
+  B2DEBUG(50, "Registering fast simulation model " << name);
+  getInstance().m_factories[name] = factory;
+}
+
+bool FastSimulationModelFactory::createModels(const std::string& name, const std::string& fileName, double energyThreshold)
+{
+  FastSimulationModelFactory& instance = getInstance();
+  auto factory = instance.m_factories.find(name);
+  if (factory == instance.m_factories.end()) {
+    return false;
+  }
+  for (G4VFastSimulationModel* model : factory->second(fileName, energyThreshold)) {
+    instance.m_models.emplace_back(model);
+  }
+  return true;
+}
+
+void FastSimulationModelFactory::clear()
+{
+  getInstance().m_models.clear();
+}
@@ -7,11 +7,14 @@
  **************************************************************************/
 
 #include <simulation/kernel/StackingAction.h>
+#include <simulation/kernel/SensitiveDetectorBase.h>
 #include <simulation/kernel/UserInfo.h>
 
+#include <G4LogicalVolume.hh>
 #include <G4ParticleDefinition.hh>
 #include <G4ParticleTypes.hh>
 #include <G4Track.hh>
+#include <G4VPhysicalVolume.hh>
 #include <G4VProcess.hh>
 
 #include <TRandom.h>
@@ -53,6 +56,15 @@ G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* aTrac
   TrackInfo* info = dynamic_cast<TrackInfo*>(aTrack->GetUserInformation());
   if (!info) return fUrgent;
 
+  // kill photons created in subdetectors with a fast optical simulation
+  if (!m_killOpticalPhotonsIn.empty() && aTrack->GetVolume()) {
+    const auto* detector = dynamic_cast<const SensitiveDetectorBase*>(aTrack->GetVolume()->GetLogicalVolume()->GetSensitiveDetector());
+    if (detector && m_killOpticalPhotonsIn.count(detector->getSubdetector()) > 0) {
+      TrackInfo::getInfo(*aTrack).setIgnore();
+      return fKill;
+    }
+  }
+
   // chech if prescaling already done
   if (info->getStatus() != 0) return fUrgent;
 
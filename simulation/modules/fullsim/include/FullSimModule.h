@@ -102,6 +102,8 @@ namespace Belle2 {
     double m_arichtopProductionCut;        /*!< Secondary production threshold in ARICH and TOP envelopes. */
     double m_eclProductionCut;             /*!< Secondary production threshold in ECL envelopes. */
     double m_klmProductionCut;             /*!< Secondary production threshold in BKLM and EKLM envelopes. */
+    std::string m_eclShowerLibrary;        /**< Name of the ECL shower library file, empty to track all particles in the ECL. */
+    double m_eclShowerLibraryEnergyThreshold; /**< Minimal kinetic energy of the particles replaced by library showers in the ECL. */
     int m_maxNumberSteps;                  /*!< The maximum number of steps before the track transportation is stopped and the track is killed. */
     double m_photonFraction;               /**< The fraction of Cerenkov photons which will be kept and propagated. */
     bool m_useNativeGeant4;                /**< If set to true, uses the Geant4 navigator and native detector construction class. */
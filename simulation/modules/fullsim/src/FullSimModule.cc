@@ -18,6 +18,7 @@
 #include <simulation/kernel/TrackingAction.h>
 #include <simulation/kernel/SteppingAction.h>
 #include <simulation/kernel/StackingAction.h>
+#include <simulation/kernel/FastSimulationModelFactory.h>
 
 #include <mdst/dataobjects/MCParticle.h>
 #include <framework/datastore/StoreObjPtr.h>
@@ -45,6 +46,7 @@
 #include <G4EmParameters.hh>
 #include <G4HadronicProcessStore.hh>
 #include <G4InuclParticleNames.hh>
+#include <G4FastSimulationPhysics.hh>
 
 #include <G4Mag_UsualEqRhs.hh>
 #include <G4NystromRK4.hh>
@@ -101,6 +103,12 @@ FullSimModule::FullSimModule() : Module(), m_useNativeGeant4(true)
   addParam("ARICHTOPProductionCut", m_arichtopProductionCut, "[cm] Secondary production threshold in ARICH and TOP envelopes.", 0.0);
   addParam("ECLProductionCut", m_eclProductionCut, "[cm] Secondary production threshold in ECL envelope.", 0.0);
   addParam("KLMProductionCut", m_klmProductionCut, "[cm] Secondary production threshold in BKLM and EKLM envelopes.", 0.0);
+  addParam("ECLShowerLibrary", m_eclShowerLibrary,
+           "Name of the ECL shower library file (see ECLShowerLibraryBuilder). If set, electrons, positrons and photons entering the "
+           "ECL with more than ECLShowerLibraryEnergyThreshold are not tracked, but replaced by showers from the library.",
+           string(""));
+  addParam("ECLShowerLibraryEnergyThreshold", m_eclShowerLibraryEnergyThreshold,
+           "[GeV] Minimal kinetic energy of the electrons, positrons and photons replaced by showers from the ECL shower library.", 0.1);
   addParam("MaxNumberSteps", m_maxNumberSteps,
            "The maximum number of steps before the track transportation is stopped and the track is killed.", 100000);
   addParam("PhotonFraction", m_photonFraction, "The fraction of Cerenkov photons which will be kept and propagated.", 0.5);
@@ -211,6 +219,7 @@ void FullSimModule::initialize()
     physicsList->SetECLProductionCutValue(m_eclProductionCut);
     physicsList->SetKLMProductionCutValue(m_klmProductionCut);
     physicsList->UseLongLivedNeutralParticles();
+    physicsList->UseFastSimulation(!m_eclShowerLibrary.empty());
 
     //Apply the Geant4 UI commands in PreInit State - before initialization
     if (m_uiCommandsAtPreInit.size() > 0) {
@@ -236,6 +245,14 @@ void FullSimModule::initialize()
 
     physicsList->RegisterPhysics(new G4LongLivedNeutralPhysics());
 
+    if (!m_eclShowerLibrary.empty()) {
+      G4FastSimulationPhysics* fastSimulationPhysics = new G4FastSimulationPhysics();
+      fastSimulationPhysics->ActivateFastSimulation("e-");
+      fastSimulationPhysics->ActivateFastSimulation("e+");
+      fastSimulationPhysics->ActivateFastSimulation("gamma");
+      physicsList->RegisterPhysics(fastSimulationPhysics);
+    }
+
     physicsList->SetDefaultCutValue((m_productionCut / Unit::mm) * CLHEP::mm);  // default is 0.7 mm
 
     //Apply the Geant4 UI commands in PreInit State - before initialization
@@ -337,6 +354,13 @@ void FullSimModule::initialize()
   //Initialize G4 kernel
   runManager.Initialize();
 
+  //Attach the fast simulation models to their regions, which exist since the geometry was created
+  if (!m_eclShowerLibrary.empty()) {
+    if (!FastSimulationModelFactory::createModels("ECLShowerLibrary", m_eclShowerLibrary, m_eclShowerLibraryEnergyThreshold)) {
+      B2FATAL("The ECL shower library is requested, but no ECL fast simulation model is available. Is the ECL part of the geometry?");
+    }
+  }
+
   //Set the parameters for the G4Transportation system.
   //To make sure we really change all G4Transportation classes, we loop over all particles
   //even if the pointer to the G4Transportation object seems to be the same for all particles.
@@ -466,6 +490,8 @@ void FullSimModule::terminate()
   //And clean up the run manager
   if (m_visManager != nullptr) delete m_visManager;
   RunManager::Instance().destroy();
+  // Delete the fast simulation models
+  FastSimulationModelFactory::clear();
   // Delete the step limiter process
   delete m_stepLimiter;
   // Delete the objects associated with transport in magnetic field
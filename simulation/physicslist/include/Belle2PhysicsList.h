@@ -70,6 +70,9 @@ namespace Belle2 {
       /** Simulate neutral long-lived particles with given pdg and mass value */
       void UseLongLivedNeutralParticles();
 
+      /** Enable fast simulation models (e.g. the ECL shower library) for electrons, positrons and photons */
+      void UseFastSimulation(G4bool);
+
     private:
       /** Set the produciton cuts to the given value for a list of regions belonging to a sub detector
        * @param name name of the sub detector to print in messages
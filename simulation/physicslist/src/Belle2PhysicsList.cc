@@ -16,6 +16,7 @@
 #include "G4EmStandardPhysics_option1.hh"
 #include "G4OpticalPhysics.hh"
 #include "G4DecayPhysics.hh"
+#include "G4FastSimulationPhysics.hh"
 #include <simulation/physicslist/Geant4ePhysics.h>
 
 // Hadronic physics
@@ -351,3 +352,15 @@ void Belle2PhysicsList::UseLongLivedNeutralParticles()
   RegisterPhysics(pLongLivedNeutral);
   pLongLivedNeutral->ConstructParticle();
 }
+
+
+void Belle2PhysicsList::UseFastSimulation(G4bool yesno)
+{
+  if (yesno) {
+    G4FastSimulationPhysics* fastSimulationPhysics = new G4FastSimulationPhysics();
+    fastSimulationPhysics->ActivateFastSimulation("e-");
+    fastSimulationPhysics->ActivateFastSimulation("e+");
+    fastSimulationPhysics->ActivateFastSimulation("gamma");
+    RegisterPhysics(fastSimulationPhysics);
+  }
+}
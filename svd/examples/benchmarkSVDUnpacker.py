@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+
+##############################################################################
+#
+# Throughput of the SVDUnpacker on recorded raw data
+#
+# usage: basf2 benchmarkSVDUnpacker.py -i <raw data file> [-n <events>]
+#
+# Only the RawSVD branch is read. The size of the RawSVD data is summed by a
+# Python module before the unpacker and divided by the event processing time
+# of the SVDUnpacker module to obtain the throughput in MB/s.
+#
+##############################################################################
+
+import basf2 as b2
+from ROOT import Belle2
+
+
+class RawSVDSize(b2.Module):
+    """Sum the size of the RawSVD data"""
+
+    def initialize(self):
+        """Require the RawSVD array"""
+        #: RawSVD array
+        self.raw = Belle2.PyStoreArray('RawSVDs')
+        self.raw.isRequired()
+        #: total size of the RawSVD buffers in bytes
+        self.nBytes = 0
+
+    def event(self):
+        """Add the size of the RawSVD buffers of this event"""
+        for raw in self.raw:
+            self.nBytes += 4 * raw.TotalBufNwords()
+
+
+b2.set_log_level(b2.LogLevel.WARNING)
+
+main = b2.create_path()
+main.add_module('RootInput', branchNames=['RawSVDs'])
+size = RawSVDSize()
+main.add_module(size)
+unpacker = main.add_module('SVDUnpacker')
+
+b2.process(main)
+
+# event processing time of the unpacker in seconds
+seconds = b2.statistics.get(unpacker).time_sum(b2.statistics.EVENT) * 1e-9
+megabytes = size.nBytes / 1e6
+print(b2.statistics)
+print(f'RawSVD data: {megabytes:.1f} MB, SVDUnpacker time: {seconds:.3f} s')
+if seconds > 0:
+    print(f'SVDUnpacker throughput: {megabytes / seconds:.1f} MB/s')
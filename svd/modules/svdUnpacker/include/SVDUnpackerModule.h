@@ -68,8 +68,11 @@ namespace Belle2::SVD {
     /** how many FADCs we have */
     unsigned short nFADCboards;
 
-    /** pointer to APVforFADCmap filled by mapping procedure */
-    std::unordered_multimap<unsigned char, unsigned char>* APVmap;
+    /** APV numbers of each FADC number, in the order of APVforFADCmap of the mapping */
+    std::vector<std::vector<unsigned char> > m_APVsOfFADC;
+
+    /** flat (FADC, APV) -> sensor lookup table, see SVDOnlineToOfflineMap::fillSensorInfoTable() */
+    std::vector<SVDOnlineToOfflineMap::SensorInfo> m_sensorInfoTable;
 
     /** Pointer to online-to-offline map */
     std::unique_ptr<SVDOnlineToOfflineMap> m_map;
@@ -151,7 +154,8 @@ namespace Belle2::SVD {
     };
 
 
-    union {  // The 4 byte words of the stream can be interpreted as:
+    /** The 4 byte words of the stream can be interpreted as: */
+    union RawWord {
       uint32_t m_data32; /**< Input 32-bit data word */
       FTBHeader m_FTBHeader; /**< Implementation of FTB Header */
       MainHeader m_MainHeader;  /**< Implementation of FADC Header */
@@ -162,6 +166,27 @@ namespace Belle2::SVD {
       FTBTrailer m_FTBTrailer; /**< Implementation of FTB Trailer */
     };
 
+    /** Strip decoded in the current event, stored until the DAQ diagnostics are complete */
+    struct DecodedStrip {
+      /** sort key: sensor, side (u first) and strip as in SVDShaperDigit::operator<,
+       * followed by the decoding order (which keeps the first of duplicated strips) */
+      unsigned long long key;
+      VxdID sensorID; /**< sensor ID */
+      bool isU; /**< true if u-side strip */
+      short cellID; /**< strip number */
+      SVDShaperDigit::APVRawSamples samples; /**< APV samples */
+      SVDDAQDiagnostic* diagnostic; /**< diagnostic of the APV the strip belongs to */
+    };
+
+    /** strips of the current event (kept as member to reuse the allocation) */
+    std::vector<DecodedStrip> m_decodedStrips;
+
+    /** diagnostics of the current FADC (kept as member to reuse the allocation) */
+    std::vector<SVDDAQDiagnostic*> m_fadcDiagnostics;
+
+    /** pipeline address << 16 | FADC << 8 | APV for each APV header of the current event */
+    std::vector<unsigned int> m_apvsByPipeline;
+
     StoreObjPtr<EventMetaData> m_eventMetaDataPtr;   /**< Required input for EventMetaData */
     StoreObjPtr<SVDEventInfo> m_svdEventInfoPtr;  /**< SVDEventInfo output per event */
     SVDTriggerType m_SVDTriggerType;  /**< SVDTriggerType object */
@@ -13,16 +13,13 @@
 #include <framework/datastore/StoreObjPtr.h>
 #include <framework/logging/Logger.h>
 
-#include <boost/crc.hpp>      // for boost::crc_basic, boost::augmented_crc
+#include <boost/crc.hpp>      // for boost::crc_optimal
 #define CRC16POLYREV 0x8005   // CRC-16 polynomial, normal representation 
 
-#include <arpa/inet.h>
-
 #include <sstream>
 #include <iomanip>
 #include <cstring>
 #include <vector>
-#include <set>
 #include <map>
 #include <utility>
 #include <algorithm>
@@ -94,7 +91,15 @@ void SVDUnpackerModule::beginRun()
     B2FATAL("no valid SVD Channel Mapping. We stop here.");
 
   m_wrongFTBcrc = 0;
-  if (m_mapping.hasChanged()) { m_map = std::make_unique<SVDOnlineToOfflineMap>(m_mapping->getFileName()); }
+  if (m_mapping.hasChanged()) {
+    m_map = std::make_unique<SVDOnlineToOfflineMap>(m_mapping->getFileName());
+
+    // flat lookup tables for the decoding loop
+    m_map->fillSensorInfoTable(m_sensorInfoTable);
+    m_APVsOfFADC.assign(256, std::vector<unsigned char>());
+    for (const auto& fadcApv : m_map->APVforFADCmap)
+      m_APVsOfFADC[fadcApv.first].push_back(fadcApv.second);
+  }
 
   if (! m_map) { //give up
     B2ERROR("SVD xml map not loaded." << std::endl <<
@@ -105,9 +110,6 @@ void SVDUnpackerModule::beginRun()
   //number of FADC boards
   nFADCboards = m_map->getFADCboardsNumber();
 
-  //passing APV<->FADC mapping from SVDOnlineToOfflineMap object
-  APVmap = &(m_map->APVforFADCmap);
-
   //setting UnpackerErrorRate factor to use it for BadMapping error suppression
   m_map->setErrorRate(m_errorRate);
 
@@ -131,10 +133,6 @@ void SVDUnpackerModule::beginRun()
 
 }
 
-#ifndef __clang__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wstack-usage="
-#endif
 void SVDUnpackerModule::event()
 {
   if (!m_rawSVD || !m_rawSVD.getEntries())
@@ -146,18 +144,22 @@ void SVDUnpackerModule::event()
               << "remember to use SVDShaperDigitSorter in your path and \n"
               << "set the silentlyAppend parameter of SVDUnpacker to true.");
 
-  SVDDAQDiagnostic* currentDAQDiagnostic;
-  vector<SVDDAQDiagnostic*> vDiagnostic_ptr;
+  SVDDAQDiagnostic* currentDAQDiagnostic = nullptr;
 
-  map<SVDShaperDigit, SVDDAQDiagnostic*> diagnosticMap;
+  // Strips are collected with the diagnostic of their APV and written once the
+  // diagnostics are complete, sorted and without duplicates.
+  m_decodedStrips.clear();
   // Store encountered pipeline addresses with APVs in which they were observed
-  map<unsigned short, set<pair<unsigned short, unsigned short> > > apvsByPipeline;
+  m_apvsByPipeline.clear();
 
   if (!m_eventMetaDataPtr.isValid()) {  // give up...
     B2ERROR("Missing valid EventMetaData." << std::endl << "No SVDShaperDigit produced for this event!");
     return;
   }
 
+  if (!m_map) // no mapping for this run, already reported in beginRun
+    return;
+
   bool nFADCmatch = true;
   bool nAPVmatch = true;
   bool badMapping = false;
@@ -173,12 +175,15 @@ void SVDUnpackerModule::event()
   bool isSetNAPVsamples = false;
 
   unsigned short nAPVheaders = 999;
-  set<short> seenAPVHeaders = {};
+  // bit n is set if the header of APV n has been seen for the current FADC
+  uint64_t seenAPVHeaders = 0;
 
   unsigned short nEntries_rawSVD = m_rawSVD.getEntries();
   auto eventNo = m_eventMetaDataPtr->getEvent();
 
   short fadc = 255, apv = 63;
+  // sensor of the current FADC/APV, from the flat lookup table
+  const SVDOnlineToOfflineMap::SensorInfo* sensorInfo = &m_sensorInfoTable[SVDOnlineToOfflineMap::getFlatIndex(fadc, apv)];
 
   if (nEntries_rawSVD != nFADCboards) {
     nFADCMatchErrors++;
@@ -189,6 +194,12 @@ void SVDUnpackerModule::event()
     nFADCmatch = false;
   }
 
+  // a strip takes at least one word of the raw data
+  unsigned int nRawWords = 0;
+  for (unsigned int i = 0; i < nEntries_rawSVD; i++)
+    nRawWords += m_rawSVD[i]->TotalBufNwords();
+  m_decodedStrips.reserve(nRawWords);
+
   for (unsigned int i = 0; i < nEntries_rawSVD; i++) {
 
     unsigned int numEntries_rawSVD = m_rawSVD[ i ]->GetNumEntries();
@@ -231,25 +242,24 @@ void SVDUnpackerModule::event()
         missedHeader = false;
         missedTrailer = false;
 
-        uint32_t* data32_it = data32tab[buf];
-        short strip, sample[6];
-        vector<uint32_t> crc16vec;
+        const uint32_t* data32_it = data32tab[buf];
+        const uint32_t* const data32_end = &data32tab[buf][nWords[buf]];
+        // the CRC16 of the FTB trailer covers all words from the FTB header to the trailer
+        const uint32_t* crc16begin = data32tab[buf];
+        RawWord word;
 
-        for (; data32_it != &data32tab[buf][nWords[buf]]; data32_it++) {
-          m_data32 = *data32_it; //put current 32-bit frame to union
+        for (; data32_it != data32_end; data32_it++) {
+          word.m_data32 = *data32_it;
 
-          if (m_data32 == 0xffaa0000) {   // first part of FTB header
-            crc16vec.clear(); // clear the input container for crc16 calculation
-            crc16vec.push_back(m_data32);
+          if (word.m_data32 == 0xffaa0000) {   // first part of FTB header
+            crc16begin = data32_it;
 
             seenHeadersAndTrailers++; // we found FTB header
 
             data32_it++; // go to 2nd part of FTB header
-            crc16vec.push_back(*data32_it);
+            word.m_data32 = *data32_it; //put the second 32-bit frame to union
 
-            m_data32 = *data32_it; //put the second 32-bit frame to union
-
-            ftbError = m_FTBHeader.errorsField;
+            ftbError = word.m_FTBHeader.errorsField;
 
             if (ftbError != 240) {
               nErrorFieldErrors++;
@@ -274,31 +284,125 @@ void SVDUnpackerModule::event()
               }
             }
 
-            if (m_FTBHeader.eventNumber !=
+            if (word.m_FTBHeader.eventNumber !=
                 (eventNo & 0xFFFFFF)) {
               nEventMatchErrors++;
               if (m_shutUpFTBError && !(nEventMatchErrors % m_errorRate)) { //
                 m_shutUpFTBError -= 1;
                 B2ERROR("Event number mismatch detected! The event number given by EventMetaData object is different from the one in the FTB Header."
                         << LogVar("Expected event number & 0xFFFFFF",
-                                  (eventNo & 0xFFFFFF)) << LogVar("Event number in the FTB", m_FTBHeader.eventNumber));
+                                  (eventNo & 0xFFFFFF)) << LogVar("Event number in the FTB", word.m_FTBHeader.eventNumber));
               }
             }
 
             continue;
           } // is FTB Header
 
-          crc16vec.push_back(m_data32);
+          // Data words are by far the most frequent ones and are identified by the MSB,
+          // the other frame types are mutually exclusive, so only one of them is tested.
+          if (word.m_data_A.check == 0) { // data
+            short strip = word.m_data_A.stripNum;
+
+            SVDShaperDigit::APVRawSamples samples;
+            samples[0] = word.m_data_A.sample1;
+            samples[1] = word.m_data_A.sample2;
+            samples[2] = word.m_data_A.sample3;
+
+            // Let's check the next rawdata word to determine if we acquired 3 or 6 sample
+            RawWord next;
+            next.m_data32 = (data32_it + 1 != data32_end) ? *(data32_it + 1) : 0xffffffff;
+
+            if (next.m_data_B.check == 0 && strip == next.m_data_B.stripNum) { // 2nd data frame with the same strip number -> six samples
+              data32_it++;
+
+              if (!isSetNAPVsamples) {
+                m_svdEventInfoPtr->setNSamples(6);
+                isSetNAPVsamples = true;
+              } else {
+                if (is3sampleData)
+                  B2ERROR("DAQMode value (indicating 3-sample acquisition mode) doesn't correspond to the actual number of samples (6) in the data! The data might be corrupted!");
+              }
+
+              samples[3] = next.m_data_B.sample4;
+              samples[4] = next.m_data_B.sample5;
+              samples[5] = next.m_data_B.sample6;
+            }
 
-          if (m_MainHeader.check == 6) { // FADC header
+            else { // three samples
+              samples[3] = 0;
+              samples[4] = 0;
+              samples[5] = 0;
+
+              if (!isSetNAPVsamples) {
+                m_svdEventInfoPtr->setNSamples(3);
+                isSetNAPVsamples = true;
+              } else {
+                if (is6sampleData)
+                  B2ERROR("DAQMode value (indicating 6-sample acquisition mode) doesn't correspond to the actual number of samples (3) in the data! The data might be corrupted!");
+              }
+            }
+
+            // Storing the strip for the SVDShaperDigit
+            if (sensorInfo->m_sensorID) {
+              DecodedStrip decoded;
+              decoded.sensorID = sensorInfo->m_sensorID;
+              decoded.isU = sensorInfo->m_uSide;
+              decoded.cellID = m_map->getStripNumber(strip, *sensorInfo);
+              decoded.samples = samples;
+              decoded.diagnostic = currentDAQDiagnostic;
+              decoded.key = ((unsigned long long)decoded.sensorID.getID() << 48)
+                            | ((unsigned long long)(decoded.isU ? 0 : 1) << 47)
+                            | ((unsigned long long)(uint16_t)(decoded.cellID + 0x8000) << 31)
+                            | m_decodedStrips.size();
+              m_decodedStrips.push_back(decoded);
+            } else {
+              // not in the map: the slow lookup reports the bad mapping
+              m_map->getSensorInfo(fadc, apv);
+              if (m_badMappingFatal)
+                B2FATAL("Respective FADC/APV combination not found -->> incorrect payload in the database! ");
+              badMapping = true;
+            }
+
+          }  //is data frame
+
+          else if (word.m_APVHeader.check == 2) { // APV header
+
+            nAPVheaders++;
+            apv = word.m_APVHeader.APVnum;
+            seenAPVHeaders |= uint64_t(1) << apv;
+            sensorInfo = &m_sensorInfoTable[SVDOnlineToOfflineMap::getFlatIndex(fadc, apv)];
+
+            cmc1 = word.m_APVHeader.CMC1;
+            cmc2 = word.m_APVHeader.CMC2;
+            apvErrors = word.m_APVHeader.apvErr;
+            pipAddr = word.m_APVHeader.pipelineAddr;
+
+            if (apvErrors != 0) {
+              nAPVErrors++;
+              if (!(nAPVErrors % m_errorRate)
+                  or nAPVErrors < 100) B2ERROR("APV error has been detected." << LogVar("FADC", fadc) << LogVar("APV", apv) << LogVar("Error value",
+                                                 apvErrors));
+            }
+            // temporary SVDDAQDiagnostic object (no info from trailers and APVmatch code)
+            currentDAQDiagnostic = m_storeDAQDiagnostics.appendNew(trgNumber, trgType, pipAddr, cmc1, cmc2, apvErrors, ftbError, nFADCmatch,
+                                                                   nAPVmatch,
+                                                                   badHeader, missedHeader, missedTrailer,
+                                                                   fadc, apv);
+            m_fadcDiagnostics.push_back(currentDAQDiagnostic);
+
+            m_apvsByPipeline.push_back((pipAddr << 16) | ((fadc & 0xFF) << 8) | apv);
+          } //is APV Header
+
+          else if (word.m_MainHeader.check == 6) { // FADC header
 
             seenHeadersAndTrailers += 2; //we found FADC Header
 
-            fadc = m_MainHeader.FADCnum;
-            trgType = m_MainHeader.trgType;
-            trgNumber = m_MainHeader.trgNumber;
-            daqMode = m_MainHeader.DAQMode;
-            daqType = m_MainHeader.DAQType;
+            fadc = word.m_MainHeader.FADCnum;
+            sensorInfo = &m_sensorInfoTable[SVDOnlineToOfflineMap::getFlatIndex(fadc, apv)];
+            trgType = word.m_MainHeader.trgType;
+            trgNumber = word.m_MainHeader.trgNumber;
+            daqMode = word.m_MainHeader.DAQMode;
+            daqType = word.m_MainHeader.DAQType;
 
             //Let's add run-dependent info: daqMode="11" in case of 3-mixed-6 sample acquisition mode.
             if (daqType) daqMode = 3;
@@ -318,19 +422,19 @@ void SVDUnpackerModule::event()
             if (daqMode == 2) is6sampleData = true;
 
             if (
-              m_MainHeader.trgNumber !=
+              word.m_MainHeader.trgNumber !=
               ((eventNo - m_FADCTriggerNumberOffset) & 0xFF)) {
 
               nTriggerMatchErrors++;
               if (!(nTriggerMatchErrors % m_errorRate))
                 B2ERROR("Event number mismatch detected! The event number given by EventMetaData object is different from the one in the FADC Header. "
                         << LogVar("Event number", eventNo) << LogVar("FADC", fadc) << LogVar("Trigger number LSByte reported by the FADC",
-                            m_MainHeader.trgNumber) << LogVar("+ offset", m_FADCTriggerNumberOffset) << LogVar("expected", (eventNo & 0xFF)));
+                            word.m_MainHeader.trgNumber) << LogVar("+ offset", m_FADCTriggerNumberOffset) << LogVar("expected", (eventNo & 0xFF)));
               badHeader = true;
             }
 
             // create SVDModeByte object from MainHeader vars
-            m_SVDModeByte = SVDModeByte(m_MainHeader.runType, 0, daqMode, m_MainHeader.trgTiming);
+            m_SVDModeByte = SVDModeByte(word.m_MainHeader.runType, 0, daqMode, word.m_MainHeader.trgTiming);
 
             // create SVDEventInfo and fill it with SVDModeByte & SVDTriggerType objects
             if (!isSetEventInfo) {
@@ -342,7 +446,7 @@ void SVDUnpackerModule::event()
               //set relative time shift
               m_svdEventInfoPtr->setRelativeShift(m_relativeTimeShift);
               // set X-talk info online from Raw Data
-              m_svdEventInfoPtr->setCrossTalk(m_MainHeader.xTalk);
+              m_svdEventInfoPtr->setCrossTalk(word.m_MainHeader.xTalk);
 
               isSetEventInfo = true;
             } else {  // let's check if the current SVDModeByte and SVDTriggerType are consistent with the one stored in SVDEventInfo
@@ -351,114 +455,29 @@ void SVDUnpackerModule::event()
             }
           } // is FADC header
 
-          if (m_APVHeader.check == 2) { // APV header
-
-            nAPVheaders++;
-            apv = m_APVHeader.APVnum;
-            seenAPVHeaders.insert(apv);
-
-            cmc1 = m_APVHeader.CMC1;
-            cmc2 = m_APVHeader.CMC2;
-            apvErrors = m_APVHeader.apvErr;
-            pipAddr = m_APVHeader.pipelineAddr;
-
-            if (apvErrors != 0) {
-              nAPVErrors++;
-              if (!(nAPVErrors % m_errorRate)
-                  or nAPVErrors < 100) B2ERROR("APV error has been detected." << LogVar("FADC", fadc) << LogVar("APV", apv) << LogVar("Error value",
-                                                 apvErrors));
-            }
-            // temporary SVDDAQDiagnostic object (no info from trailers and APVmatch code)
-            currentDAQDiagnostic = m_storeDAQDiagnostics.appendNew(trgNumber, trgType, pipAddr, cmc1, cmc2, apvErrors, ftbError, nFADCmatch,
-                                                                   nAPVmatch,
-                                                                   badHeader, missedHeader, missedTrailer,
-                                                                   fadc, apv);
-            vDiagnostic_ptr.push_back(currentDAQDiagnostic);
-
-            apvsByPipeline[pipAddr].insert(make_pair(fadc, apv));
-          } //is APV Header
-
-          if (m_data_A.check == 0) { // data
-            strip = m_data_A.stripNum;
-
-            sample[0] = m_data_A.sample1;
-            sample[1] = m_data_A.sample2;
-            sample[2] = m_data_A.sample3;
-
-            sample[3] = 0;
-            sample[4] = 0;
-            sample[5] = 0;
-
-            // Let's check the next rawdata word to determine if we acquired 3 or 6 sample
-            data32_it++;
-            m_data32 = *data32_it;
-
-            if (m_data_B.check == 0 && strip == m_data_B.stripNum) { // 2nd data frame with the same strip number -> six samples
-
-              if (!isSetNAPVsamples) {
-                m_svdEventInfoPtr->setNSamples(6);
-                isSetNAPVsamples = true;
-              } else {
-                if (is3sampleData)
-                  B2ERROR("DAQMode value (indicating 3-sample acquisition mode) doesn't correspond to the actual number of samples (6) in the data! The data might be corrupted!");
-              }
-
-              crc16vec.push_back(m_data32);
-
-              sample[3] = m_data_B.sample4;
-              sample[4] = m_data_B.sample5;
-              sample[5] = m_data_B.sample6;
-            }
-
-            else { // three samples
-              data32_it--;
-              m_data32 = *data32_it;
-
-              if (!isSetNAPVsamples) {
-                m_svdEventInfoPtr->setNSamples(3);
-                isSetNAPVsamples = true;
-              } else {
-                if (is6sampleData)
-                  B2ERROR("DAQMode value (indicating 6-sample acquisition mode) doesn't correspond to the actual number of samples (3) in the data! The data might be corrupted!");
-              }
-            }
-
-            // Generating SVDShaperDigit object
-            SVDShaperDigit* newShaperDigit = m_map->NewShaperDigit(fadc, apv, strip, sample, 0.0);
-            if (newShaperDigit) {
-              diagnosticMap.insert(make_pair(*newShaperDigit, currentDAQDiagnostic));
-              delete newShaperDigit;
-            } else if (m_badMappingFatal) {
-              B2FATAL("Respective FADC/APV combination not found -->> incorrect payload in the database! ");
-            } else {
-              badMapping = true;
-            }
-
-          }  //is data frame
-
-
-          if (m_FADCTrailer.check == 14)  { // FADC trailer
+          else if (word.m_FADCTrailer.check == 14)  { // FADC trailer
 
             seenHeadersAndTrailers += 4; // we found FAD trailer
 
+            const std::vector<unsigned char>& fadcAPVs = m_APVsOfFADC[fadc & 0xFF];
+
             //additional check if we have a faulty/fake FADC that is not in the map
-            if (APVmap->find(fadc) == APVmap->end()) badMapping = true;
+            if (fadcAPVs.empty()) badMapping = true;
 
             //comparing number of APV chips and the number of APV headers, for the current FADC
-            unsigned short nAPVs = APVmap->count(fadc);
+            unsigned short nAPVs = fadcAPVs.size();
 
             if (nAPVheaders == 0) {
               currentDAQDiagnostic = m_storeDAQDiagnostics.appendNew(0, 0, 0, 0, 0, 0, ftbError, nFADCmatch, nAPVmatch, badHeader, 0, 0, fadc, 0);
-              vDiagnostic_ptr.push_back(currentDAQDiagnostic);
+              m_fadcDiagnostics.push_back(currentDAQDiagnostic);
             }
 
             if (nAPVs != nAPVheaders) {
               // There is an APV missing, detect which it is.
-              for (const auto& fadcApv : *APVmap) {
-                if (fadcApv.first != fadc) continue;
-                if (seenAPVHeaders.find(fadcApv.second) == seenAPVHeaders.end()) {
+              for (unsigned char mapAPV : fadcAPVs) {
+                if (mapAPV > 0x3F or !((seenAPVHeaders >> mapAPV) & 1)) {
                   // We have a missing APV. Look if it is a known one.
-                  auto missingRec = m_missingAPVs.find(make_pair(fadcApv.first, fadcApv.second));
+                  auto missingRec = m_missingAPVs.find(make_pair(fadc, mapAPV));
                   if (missingRec != m_missingAPVs.end()) {
                     // This is known to be missing, so keep quiet and just update event counters
                     if (missingRec->second.first > eventNo)
@@ -469,21 +488,21 @@ void SVDUnpackerModule::event()
                     // We haven't seen this previously.
                     nMissingAPVsErrors++;
                     m_missingAPVs.insert(make_pair(
-                                           make_pair(fadcApv.first, fadcApv.second),
+                                           make_pair(fadc, mapAPV),
                                            make_pair(eventNo, eventNo)
                                          ));
                     if (!(nMissingAPVsErrors % m_errorRate)) B2ERROR("missing APV header! " << LogVar("Event number", eventNo) << LogVar("APV",
-                                                                       int(fadcApv.second)) << LogVar("FADC",
-                                                                           int(fadcApv.first)));
+                                                                       int(mapAPV)) << LogVar("FADC",
+                                                                           int(fadc)));
                   }
                 }
               }
               nAPVmatch = false;
             } // is nAPVs != nAPVheaders
 
-            seenAPVHeaders.clear();
+            seenAPVHeaders = 0;
 
-            ftbFlags = m_FADCTrailer.FTBFlags;
+            ftbFlags = word.m_FADCTrailer.FTBFlags;
             if ((ftbFlags >> 5) != 0) badTrailer = true;
             if (ftbFlags != 0) {
               nFTBFlagsErrors++;
@@ -498,29 +517,27 @@ void SVDUnpackerModule::event()
               }
             }
 
-            apvErrorsOR = m_FADCTrailer.apvErrOR;
+            apvErrorsOR = word.m_FADCTrailer.apvErrOR;
 
 
           }// is FADC trailer
 
-          if (m_FTBTrailer.controlWord == 0xff55)  {// FTB trailer
+          else if (word.m_FTBTrailer.controlWord == 0xff55)  {// FTB trailer
 
             seenHeadersAndTrailers += 8; // we found FTB trailer
 
-            //check CRC16
-            crc16vec.pop_back();
-            unsigned short iCRC = crc16vec.size();
-            uint32_t crc16input[iCRC];
-
-            for (unsigned short icrc = 0; icrc < iCRC; icrc++)
-              crc16input[icrc] = htonl(crc16vec.at(icrc));
-
-            //verify CRC16
-            boost::crc_basic<16> bcrc(0x8005, 0xffff, 0, false, false);
-            bcrc.process_block(crc16input, crc16input + iCRC);
+            //verify CRC16 of the big-endian words from the FTB header up to the trailer
+            boost::crc_optimal<16, CRC16POLYREV, 0xffff, 0, false, false> bcrc;
+            for (const uint32_t* crc_it = crc16begin; crc_it != data32_it; ++crc_it) {
+              const uint32_t crcWord = *crc_it;
+              bcrc.process_byte(crcWord >> 24);
+              bcrc.process_byte(crcWord >> 16);
+              bcrc.process_byte(crcWord >> 8);
+              bcrc.process_byte(crcWord);
+            }
             unsigned int checkCRC = bcrc.checksum();
 
-            if (checkCRC != m_FTBTrailer.crc16) {
+            if (checkCRC != word.m_FTBTrailer.crc16) {
               B2WARNING("FTB CRC16 checksum DOES NOT MATCH" << LogVar("for FADC no.", fadc));
               m_wrongFTBcrc++;
             }
@@ -542,7 +559,7 @@ void SVDUnpackerModule::event()
       //reset value for headers and trailers check
       seenHeadersAndTrailers = 0;
 
-      for (auto p : vDiagnostic_ptr) {
+      for (auto p : m_fadcDiagnostics) {
         // adding remaining info to Diagnostic object
         p->setFTBFlags(ftbFlags);
         p->setApvErrorOR(apvErrorsOR);
@@ -554,62 +571,83 @@ void SVDUnpackerModule::event()
 
       }
 
-      vDiagnostic_ptr.clear();
+      m_fadcDiagnostics.clear();
 
     } // end event loop
 
   }// end loop over RawSVD objects
 
-  // Detect upset APVs and report/treat
-  auto major_apv = max_element(apvsByPipeline.begin(), apvsByPipeline.end(),
-                               [](const decltype(apvsByPipeline)::value_type & p1,
-                                  const decltype(apvsByPipeline)::value_type & p2) -> bool
-  { return p1.second.size() < p2.second.size(); }
-                              );
+  // Group the (FADC, APV) pairs by pipeline address, ordered and without duplicates
+  sort(m_apvsByPipeline.begin(), m_apvsByPipeline.end());
+  m_apvsByPipeline.erase(unique(m_apvsByPipeline.begin(), m_apvsByPipeline.end()), m_apvsByPipeline.end());
+
+  // Detect upset APVs and report/treat: the major pipeline address is the one seen in most APVs
+  // (the lowest one in case of ties)
+  unsigned int nPipelineAddresses = 0;
+  unsigned short majorPipelineAddress = 0;
+  size_t majorCount = 0;
+  for (size_t begin = 0, end = 0; begin < m_apvsByPipeline.size(); begin = end) {
+    unsigned short pipelineAddress = m_apvsByPipeline[begin] >> 16;
+    for (end = begin; end < m_apvsByPipeline.size() and (m_apvsByPipeline[end] >> 16) == pipelineAddress; end++);
+    nPipelineAddresses++;
+    if (end - begin > majorCount) {
+      majorCount = end - begin;
+      majorPipelineAddress = pipelineAddress;
+    }
+  }
   // We set emuPipelineAddress fields in diagnostics to this.
-  if (m_emulatePipelineAddress)
+  if (m_emulatePipelineAddress and nPipelineAddresses > 0)
     for (auto& p : m_storeDAQDiagnostics)
-      p.setEmuPipelineAddress(major_apv->first);
+      p.setEmuPipelineAddress(majorPipelineAddress);
   // And report any upset apvs or update records
-  if (apvsByPipeline.size() > 1)
-    for (const auto& p : apvsByPipeline) {
-      if (p.first == major_apv->first) continue;
-      for (const auto& fadcApv : p.second) {
-        // We have an upset APV. Look if it is a known one.
-        auto upsetRec = m_upsetAPVs.find(make_pair(fadcApv.first, fadcApv.second));
-        if (upsetRec != m_upsetAPVs.end()) {
-          // This is known to be upset, so keep quiet and update event counters
-          if (upsetRec->second.first > eventNo)
-            upsetRec->second.first = eventNo;
-          if (upsetRec->second.second < eventNo)
-            upsetRec->second.second = eventNo;
-        } else {
-          // We haven't seen this one previously.
-          nUpsetAPVsErrors++;
-          m_upsetAPVs.insert(make_pair(
-                               make_pair(fadcApv.first, fadcApv.second),
-                               make_pair(eventNo, eventNo)
-                             ));
-          for (auto& pp : m_storeDAQDiagnostics) {
-
-            if (pp.getFADCNumber() == fadcApv.first and pp.getAPVNumber() == fadcApv.second)
-              pp.setUpsetAPV(true);
-          }
-          if (!(nUpsetAPVsErrors % m_errorRate)) B2ERROR("Upset APV detected!!!" << LogVar("APV", int(fadcApv.second)) << LogVar("FADC",
-                                                           int(fadcApv.first)) << LogVar("Event number", eventNo));
+  if (nPipelineAddresses > 1)
+    for (unsigned int pipelineAPV : m_apvsByPipeline) {
+      if ((pipelineAPV >> 16) == majorPipelineAddress) continue;
+      unsigned short upsetFADC = (pipelineAPV >> 8) & 0xFF;
+      unsigned short upsetAPV = pipelineAPV & 0xFF;
+      // We have an upset APV. Look if it is a known one.
+      auto upsetRec = m_upsetAPVs.find(make_pair(upsetFADC, upsetAPV));
+      if (upsetRec != m_upsetAPVs.end()) {
+        // This is known to be upset, so keep quiet and update event counters
+        if (upsetRec->second.first > eventNo)
+          upsetRec->second.first = eventNo;
+        if (upsetRec->second.second < eventNo)
+          upsetRec->second.second = eventNo;
+      } else {
+        // We haven't seen this one previously.
+        nUpsetAPVsErrors++;
+        m_upsetAPVs.insert(make_pair(
+                             make_pair(upsetFADC, upsetAPV),
+                             make_pair(eventNo, eventNo)
+                           ));
+        for (auto& pp : m_storeDAQDiagnostics) {
+
+          if (pp.getFADCNumber() == upsetFADC and pp.getAPVNumber() == upsetAPV)
+            pp.setUpsetAPV(true);
         }
+        if (!(nUpsetAPVsErrors % m_errorRate)) B2ERROR("Upset APV detected!!!" << LogVar("APV", int(upsetAPV)) << LogVar("FADC",
+                                                         int(upsetFADC)) << LogVar("Event number", eventNo));
       }
     }
 
+  // Strips ordered as SVDShaperDigits, the first decoded one is kept for duplicated strips
+  sort(m_decodedStrips.begin(), m_decodedStrips.end(),
+  [](const DecodedStrip & a, const DecodedStrip & b) { return a.key < b.key; });
+  const unsigned long long c_stripKeyMask = ~((1ULL << 31) - 1);
+
   // Here we can delete digits coming from upset APVs. We detect them by comparing
   // actual and emulated pipeline address fields in DAQDiagnostics.
-  for (auto& p : diagnosticMap) {
-
-    if ((m_killUpsetDigits && p.second->getPipelineAddress() != p.second->getEmuPipelineAddress()) || p.second->getFTBError() != 240
-        || p.second->getFTBFlags()     || p.second->getAPVError() || !(p.second->getAPVMatch()) || !(p.second->getFADCMatch())
-        || p.second->getBadHeader()
-        ||  p.second->getBadMapping() || p.second->getUpsetAPV() || p.second->getMissedHeader() || p.second->getMissedTrailer()) continue;
-    m_storeShaperDigits.appendNew(p.first);
+  for (size_t iStrip = 0; iStrip < m_decodedStrips.size(); iStrip++) {
+    const DecodedStrip& strip = m_decodedStrips[iStrip];
+    if (iStrip > 0 and ((m_decodedStrips[iStrip - 1].key ^ strip.key) & c_stripKeyMask) == 0) continue;
+    const SVDDAQDiagnostic* diagnostic = strip.diagnostic;
+    if (!diagnostic) continue;
+
+    if ((m_killUpsetDigits && diagnostic->getPipelineAddress() != diagnostic->getEmuPipelineAddress()) || diagnostic->getFTBError() != 240
+        || diagnostic->getFTBFlags()     || diagnostic->getAPVError() || !(diagnostic->getAPVMatch()) || !(diagnostic->getFADCMatch())
+        || diagnostic->getBadHeader()
+        ||  diagnostic->getBadMapping() || diagnostic->getUpsetAPV() || diagnostic->getMissedHeader() || diagnostic->getMissedTrailer()) continue;
+    m_storeShaperDigits.appendNew(strip.sensorID, strip.isU, strip.cellID, strip.samples);
   }
 
   if (!m_svdEventInfoPtr->getMatchTriggerType()) {if (!(nEventInfoMatchErrors % m_errorRate) or nEventInfoMatchErrors < 200) B2WARNING("Inconsistent SVD Trigger Type value for: " << LogVar("Event number", eventNo));}
@@ -617,9 +655,6 @@ void SVDUnpackerModule::event()
 
 
 } //end event function
-#ifndef __clang__
-#pragma GCC diagnostic pop
-#endif
 
 void SVDUnpackerModule::endRun()
 {
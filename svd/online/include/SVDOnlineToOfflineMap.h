@@ -15,6 +15,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
+#include <vector>
 
 namespace Belle2 {
   /** This class implements the methods to map raw SVD hits to BASF2 SVD hits.
@@ -178,6 +179,23 @@ namespace Belle2 {
      */
     const SensorInfo& getSensorInfo(unsigned char FADC, unsigned char APV25);
 
+    /** Number of entries of the flat FADC/APV25 lookup table, see getFlatIndex() */
+    static constexpr unsigned int c_nFlatEntries = 256 * 64;
+
+    /** Index of a FADC/APV25 combination in the flat lookup table.
+     * @param FADC is FADC number from the SVDRawCopper data.
+     * @param APV25 is the APV25 number (6 bits) from the SVDRawCopper data.
+     */
+    static unsigned int getFlatIndex(unsigned char FADC, unsigned char APV25)
+    { return (((unsigned int)FADC) << 6) | (APV25 & 0x3F); }
+
+    /** Fill a flat lookup table of the SensorInfo of each FADC/APV25 combination,
+     * indexed by getFlatIndex(). Combinations not in the map have a zero sensor ID.
+     * The table avoids the hash lookup in getSensorInfo() for every strip.
+     * @param table the table, resized to c_nFlatEntries
+     */
+    void fillSensorInfoTable(std::vector<SensorInfo>& table) const;
+
     /** is the APV of the strips in the map? for a given layer/ladder/dssd/side/strip combination.
      * @param layer is the layer number
      * @param ladder is the ladder number
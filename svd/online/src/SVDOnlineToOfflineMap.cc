@@ -99,6 +99,25 @@ const SVDOnlineToOfflineMap::SensorInfo& SVDOnlineToOfflineMap::getSensorInfo(un
 
 
 
+void SVDOnlineToOfflineMap::fillSensorInfoTable(std::vector<SensorInfo>& table) const
+{
+  SensorInfo empty;
+  empty.m_sensorID = 0;
+  empty.m_uSide = false;
+  empty.m_parallel = false;
+  empty.m_channel0 = 0;
+  empty.m_channel127 = 0;
+  table.assign(c_nFlatEntries, empty);
+
+  for (const auto& sensor : m_sensors) {
+    ChipID id(sensor.first);
+    // APV25 numbers are 6 bits in the data, other chips can never be addressed
+    if (id.getAPV25() > 0x3F) continue;
+    table[getFlatIndex(id.getFADC(), id.getAPV25())] = sensor.second;
+  }
+}
+
+
 const SVDOnlineToOfflineMap::ChipInfo& SVDOnlineToOfflineMap::getChipInfo(unsigned short layer,  unsigned short ladder,
     unsigned short dssd, bool side, unsigned short strip)
 {
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+
+# ---------------------------------------------------------------------------------------
+# Validation of TOP fast optical simulation against the full (Geant) photon simulation
+# Hit times, pixel occupancies and kaon/pion log likelihood differences are histogrammed
+#
+# usage: basf2 compareFastOpticalSim.py [full|fast]
+# Run the script in both modes and overlay the histograms of the two output files.
+# The timing of the simulation modules is printed at the end.
+# ---------------------------------------------------------------------------------------
+
+import sys
+import basf2 as b2
+from ROOT import Belle2, TFile, TH1F
+
+mode = sys.argv[1] if len(sys.argv) > 1 else 'fast'
+if mode not in ['full', 'fast']:
+    b2.B2FATAL('Unknown mode ' + mode + ', use full or fast')
+outputFile = 'TOPOpticalSim_' + mode + '.root'
+
+
+class TOPSimHistograms(b2.Module):
+    ''' Histograms of TOP digits and likelihoods '''
+
+    def initialize(self):
+        ''' Book histograms '''
+
+        #: output file
+        self.file = TFile(outputFile, 'recreate')
+        #: hit times
+        self.time = TH1F('time', 'hit times; time [ns]', 500, -10, 90)
+        #: pixel occupancy
+        self.pixel = TH1F('pixel', 'pixel occupancy; pixel ID', 512, 0.5, 512.5)
+        #: number of hits per event
+        self.nhits = TH1F('nhits', 'number of hits per event; number of hits', 100, 0, 200)
+        #: log likelihood difference for pions
+        self.dlogl_pion = TH1F('dlogl_pion', 'pions; logL(K) - logL(#pi)', 200, -100, 100)
+        #: log likelihood difference for kaons
+        self.dlogl_kaon = TH1F('dlogl_kaon', 'kaons; logL(K) - logL(#pi)', 200, -100, 100)
+
+    def event(self):
+        ''' Fill histograms '''
+
+        digits = Belle2.PyStoreArray('TOPDigits')
+        self.nhits.Fill(digits.getEntries())
+        for digit in digits:
+            self.time.Fill(digit.getTime())
+            self.pixel.Fill(digit.getPixelID())
+
+        for track in Belle2.PyStoreArray('Tracks'):
+            mcParticle = track.getRelated('MCParticles')
+            likelihood = track.getRelated('TOPLikelihoods')
+            if not mcParticle or not likelihood or likelihood.getFlag() != 1:
+                continue
+            dlogl = likelihood.getLogL_K() - likelihood.getLogL_pi()
+            pdg = abs(mcParticle.getPDG())
+            if pdg == 211:
+                self.dlogl_pion.Fill(dlogl)
+            elif pdg == 321:
+                self.dlogl_kaon.Fill(dlogl)
+
+    def terminate(self):
+        ''' Write histograms '''
+
+        self.file.Write()
+        self.file.Close()
+
+
+# Suppress messages and warnings during processing:
+b2.set_log_level(b2.LogLevel.WARNING)
+
+# Create path
+main = b2.create_path()
+
+# Set number of events to generate
+main.add_module('EventInfoSetter', evtNumList=[1000])
+
+# Gearbox and geometry (only TOP and B-field)
+main.add_module('Gearbox')
+main.add_module('Geometry', useDB=False, components=['MagneticField', 'TOP'])
+
+# Particle gun: pions and kaons in the TOP acceptance
+particlegun = b2.register_module('ParticleGun')
+particlegun.param('pdgCodes', [211, -211, 321, -321])
+particlegun.param('nTracks', 1)
+particlegun.param('varyNTracks', False)
+particlegun.param('momentumGeneration', 'uniform')
+particlegun.param('momentumParams', [1, 4])
+particlegun.param('thetaGeneration', 'uniformCos')
+particlegun.param('thetaParams', [32, 122])
+particlegun.param('phiGeneration', 'uniform')
+particlegun.param('phiParams', [0, 360])
+particlegun.param('vertexGeneration', 'fixed')
+particlegun.param('xVertexParams', [0])
+particlegun.param('yVertexParams', [0])
+particlegun.param('zVertexParams', [0])
+particlegun.param('independentVertices', False)
+main.add_module(particlegun)
+
+# Simulation: in fast mode photons are generated by TOPFastOpticalSimulator
+main.add_module('FullSim')
+if mode == 'fast':
+    main.add_module('TOPFastOpticalSimulator')
+
+# TOP digitization (TTS and time smearing are applied here in both modes)
+main.add_module('TOPDigitizer')
+
+# Dedicated track maker using MC information only
+main.add_module('TOPMCTrackMaker')
+
+# TOP reconstruction
+main.add_module('TOPReconstructor')
+
+# Histograms
+main.add_module(TOPSimHistograms())
+
+# Show progress of processing
+main.add_module('Progress')
+
+# Process events
+b2.process(main)
+
+# Print call statistics
+print(b2.statistics)
@@ -0,0 +1,106 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#pragma once
+
+#include <framework/core/Module.h>
+#include <framework/datastore/StoreArray.h>
+#include <mdst/dataobjects/MCParticle.h>
+#include <top/dataobjects/TOPBarHit.h>
+#include <top/dataobjects/TOPSimHit.h>
+#include <top/dataobjects/TOPSimPhoton.h>
+#include <top/dbobjects/TOPGeoModule.h>
+#include <top/reconstruction_cpp/RaytracerBase.h>
+#include <TVector3.h>
+#include <vector>
+
+namespace Belle2 {
+
+  /**
+   * Fast simulation of Cerenkov photons in TOP quartz.
+   * Photons of particles entering the bars (TOPBarHits) are generated along a straight line
+   * and propagated to the photo-detectors with the ray tracer of the reconstruction;
+   * the detected ones are stored as TOPSimHits and TOPSimPhotons for the digitization.
+   * Cerenkov photons of the full (Geant) simulation are killed at their creation in quartz.
+   */
+  class TOPFastOpticalSimulatorModule : public Module {
+
+  public:
+
+    /**
+     * Constructor
+     */
+    TOPFastOpticalSimulatorModule();
+
+    /**
+     * Destructor
+     */
+    virtual ~TOPFastOpticalSimulatorModule()
+    {}
+
+    /**
+     * Initialize the Module.
+     * This method is called at the beginning of data processing.
+     */
+    virtual void initialize() override;
+
+    /**
+     * Called when entering a new run.
+     * Set run dependent things like run header parameters, alignment, etc.
+     */
+    virtual void beginRun() override;
+
+    /**
+     * Event processor.
+     */
+    virtual void event() override;
+
+  private:
+
+    /**
+     * Returns the particle path inside the bar along a straight line
+     * @param position particle position in module nominal frame
+     * @param direction particle direction (unit vector) in module nominal frame
+     * @param raytracer ray tracer of the module
+     * @param start on return: distance from position to the point where the particle enters the bar
+     * @return path length inside the bar (0 if the particle does not cross the bar)
+     */
+    double getPathInBar(const TVector3& position, const TVector3& direction,
+                        const TOP::RaytracerBase& raytracer, double& start) const;
+
+    /**
+     * Finds the PMT hit by a photon at the detector plane
+     * @param x photon position in x (module nominal frame)
+     * @param y photon position in y (module nominal frame)
+     * @param module module geometry
+     * @param xLocal on return: photon position x in local PMT frame
+     * @param yLocal on return: photon position y in local PMT frame
+     * @return PMT ID or 0 if photon did not hit the sensitive area of an optically coupled PMT
+     */
+    int findPMT(double x, double y, const TOPGeoModule& module, double& xLocal, double& yLocal) const;
+
+    // module parameters
+    int m_numEnergyBins = 0; /**< number of bins of photon energy spectrum */
+    double m_minBeta = 0; /**< minimal particle velocity to be considered */
+
+    // photon energy spectrum
+    std::vector<double> m_energies;     /**< photon energies at bin centers [eV] */
+    std::vector<double> m_phaseIndices; /**< phase refractive indices at bin centers */
+    std::vector<double> m_envelopeQE;   /**< envelope of PMT efficiencies at bin centers */
+    std::vector<double> m_cumulative;   /**< cumulative spectrum (buffer) */
+    double m_energyStep = 0; /**< energy bin size [eV] */
+
+    // datastore objects
+    StoreArray<MCParticle> m_mcParticles; /**< collection of MC particles */
+    StoreArray<TOPBarHit> m_barHits; /**< collection of entrance-to-bar hits */
+    StoreArray<TOPSimHit> m_simHits; /**< collection of simulated hits */
+    StoreArray<TOPSimPhoton> m_simPhotons; /**< collection of simulated photons */
+
+  };
+
+} // Belle2 namespace
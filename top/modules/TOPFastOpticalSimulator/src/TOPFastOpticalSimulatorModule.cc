@@ -0,0 +1,296 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+// Own include
+#include <top/modules/TOPFastOpticalSimulator/TOPFastOpticalSimulatorModule.h>
+
+// TOP headers.
+#include <top/geometry/TOPGeometryPar.h>
+#include <top/reconstruction_cpp/TOPRecoManager.h>
+#include <top/reconstruction_cpp/FastRaytracer.h>
+#include <top/reconstruction_cpp/PhotonState.h>
+
+// simulation
+#include <simulation/kernel/StackingAction.h>
+
+// framework aux
+#include <framework/gearbox/Const.h>
+#include <framework/gearbox/Unit.h>
+#include <framework/logging/Logger.h>
+
+// ROOT
+#include <TDatabasePDG.h>
+#include <TRandom.h>
+
+// Geant4
+#include <G4EventManager.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+namespace Belle2 {
+
+  using namespace TOP;
+
+  //-----------------------------------------------------------------
+  //                 Register module
+  //-----------------------------------------------------------------
+
+  REG_MODULE(TOPFastOpticalSimulator)
+
+  //-----------------------------------------------------------------
+  //                 Implementation
+  //-----------------------------------------------------------------
+
+  TOPFastOpticalSimulatorModule::TOPFastOpticalSimulatorModule() : Module()
+  {
+    // set module description
+    setDescription("Fast simulation of Cerenkov photons in TOP quartz. "
+                   "Photons of particles entering the bars are propagated to the photo-detectors "
+                   "with the ray tracer of the reconstruction and stored as TOPSimHits. "
+                   "Cerenkov photons of the full simulation are killed at their creation in quartz. "
+                   "Must be placed after FullSim and before TOPDigitizer.");
+    setPropertyFlags(c_ParallelProcessingCertified);
+
+    // Add parameters
+    addParam("numEnergyBins", m_numEnergyBins,
+             "number of bins of photon energy spectrum", 100);
+    addParam("minBeta", m_minBeta,
+             "minimal particle velocity (in units of c) to be considered", 0.5);
+  }
+
+
+  void TOPFastOpticalSimulatorModule::initialize()
+  {
+    // input
+
+    m_barHits.isRequired();
+    m_mcParticles.isRequired();
+
+    // output (same as in SensitivePMT)
+
+    m_simHits.registerInDataStore();
+    m_mcParticles.registerRelationTo(m_simHits);
+    m_simPhotons.registerInDataStore(DataStore::c_DontWriteOut);
+    m_simHits.registerRelationTo(m_simPhotons, DataStore::c_Event, DataStore::c_DontWriteOut);
+
+    if (m_numEnergyBins <= 0) B2FATAL("TOPFastOpticalSimulator: numEnergyBins must be positive");
+  }
+
+
+  void TOPFastOpticalSimulatorModule::beginRun()
+  {
+    const auto* topgp = TOPGeometryPar::Instance();
+    if (not topgp->isValid()) B2FATAL("TOPFastOpticalSimulator: TOP geometry not available");
+
+    // photons in the quartz are generated here: Geant kills them at creation (set for the stacking action of this run)
+
+    auto* eventManager = G4EventManager::GetEventManager();
+    auto* stackingAction = eventManager ? dynamic_cast<Simulation::StackingAction*>(eventManager->GetUserStackingAction()) : 0;
+    if (not stackingAction) B2FATAL("TOPFastOpticalSimulator: no Geant stacking action found, FullSim must be in the path");
+    stackingAction->killOpticalPhotonsIn(Const::TOP);
+
+    const auto& nominalQE = topgp->getGeometry()->getNominalQE();
+    double eMin = TOPGeometryPar::c_hc / nominalQE.getMaxLambda();
+    double eMax = TOPGeometryPar::c_hc / nominalQE.getMinLambda();
+    m_energyStep = (eMax - eMin) / m_numEnergyBins;
+
+    m_energies.clear();
+    m_phaseIndices.clear();
+    m_envelopeQE.clear();
+    for (int i = 0; i < m_numEnergyBins; i++) {
+      double e = eMin + (i + 0.5) * m_energyStep;
+      m_energies.push_back(e);
+      m_phaseIndices.push_back(topgp->getPhaseIndex(e));
+      m_envelopeQE.push_back(topgp->getPMTEfficiencyEnvelope(e));
+    }
+    m_cumulative.resize(m_numEnergyBins);
+  }
+
+
+  void TOPFastOpticalSimulatorModule::event()
+  {
+    const double yield = 369.8 / Unit::cm; // Cerenkov photons per eV and unit length for sin^2(thc) = 1
+
+    const auto* topgp = TOPGeometryPar::Instance();
+    const auto* geo = topgp->getGeometry();
+
+    for (const auto& barHit : m_barHits) {
+      int moduleID = barHit.getModuleID();
+      if (not geo->isModuleIDValid(moduleID)) continue;
+
+      // particle velocity and charge
+
+      const auto* particle = TDatabasePDG::Instance()->GetParticle(barHit.getPDG());
+      if (not particle) continue;
+      double charge = particle->Charge() / 3;
+      if (charge == 0) continue;
+      double p = barHit.getMomentum().Mag();
+      double mass = particle->Mass();
+      double beta = p / sqrt(p * p + mass * mass);
+      if (beta < m_minBeta) continue;
+
+      // straight line path inside the bar in module nominal frame (as used in reconstruction)
+
+      const auto& module = geo->getModule(moduleID);
+      const auto* fastRaytracer = TOPRecoManager::getFastRaytracer(moduleID);
+      if (not fastRaytracer) continue;
+      TVector3 position = module.pointGlobalToNominal(barHit.getPosition());
+      TVector3 direction = module.momentumGlobalToNominal(barHit.getMomentum()).Unit();
+      double start = 0;
+      double length = getPathInBar(position, direction, *fastRaytracer, start);
+      if (length <= 0) continue;
+      position += start * direction;
+      double time = barHit.getTime() + start / beta / Const::speedOfLight;
+
+      // photon energy spectrum, weighted with the envelope of PMT efficiencies
+
+      double sum = 0;
+      for (int i = 0; i < m_numEnergyBins; i++) {
+        double cosThc = 1 / (beta * m_phaseIndices[i]);
+        if (cosThc < 1) sum += m_envelopeQE[i] * (1 - cosThc * cosThc);
+        m_cumulative[i] = sum;
+      }
+      if (sum <= 0) continue;
+      int numPhotons = gRandom->Poisson(yield * charge * charge * sum * m_energyStep * length);
+
+      auto* mcParticle = barHit.getRelated<MCParticle>();
+      double surfReflectivity = fastRaytracer->getBars().front().reflectivity;
+      double mirrorReflectivity = std::min(fastRaytracer->getMirror().reflectivity, 1.0);
+
+      for (int k = 0; k < numPhotons; k++) {
+
+        // photon energy, emission point and emission angles
+
+        int i = std::upper_bound(m_cumulative.begin(), m_cumulative.end(), gRandom->Uniform(sum)) - m_cumulative.begin();
+        i = std::min(i, m_numEnergyBins - 1);
+        double e = m_energies[i] + (gRandom->Rndm() - 0.5) * m_energyStep;
+        double phaseIndex = topgp->getPhaseIndex(e);
+        double cosThc = 1 / (beta * phaseIndex);
+        if (cosThc >= 1) continue;
+        double s = gRandom->Uniform(length);
+        TVector3 emiPoint = position + s * direction;
+        double fic = gRandom->Uniform(2 * M_PI);
+
+        // propagation to the detector plane
+
+        fastRaytracer->propagate(PhotonState(emiPoint, direction, acos(cosThc), fic));
+        if (not fastRaytracer->getPropagationStatus()) continue;
+        double cosTotal = sqrt(1 - 1 / (phaseIndex * phaseIndex));
+        if (not fastRaytracer->getTotalReflStatus(cosTotal)) continue;
+
+        // bulk absorption and surface reflectivity (as in PDFConstructor)
+
+        const auto& firstState = fastRaytracer->getPhotonStates().front();
+        const auto& lastState = fastRaytracer->getPhotonStates().back();
+        double propLen = fastRaytracer->getPropagationLen();
+        int nx = fastRaytracer->getNx();
+        int ny = fastRaytracer->getNy();
+        double survival = exp(-propLen / topgp->getAbsorptionLength(e)) * pow(surfReflectivity, abs(nx) + abs(ny));
+        if (firstState.getKz() > 0) survival *= mirrorReflectivity;
+        if (gRandom->Rndm() > survival) continue;
+
+        // detection, the envelope of efficiencies is already applied in the spectrum
+
+        double xLocal = 0;
+        double yLocal = 0;
+        int pmtID = findPMT(lastState.getX(), lastState.getY(), module, xLocal, yLocal);
+        if (pmtID == 0) continue;
+        double envelopeQE = topgp->getPMTEfficiencyEnvelope(e);
+        double qeffi = topgp->getPMTEfficiency(e, moduleID, pmtID, xLocal, yLocal);
+        if (qeffi == 0 or gRandom->Uniform(envelopeQE) > qeffi) continue;
+
+        // store
+
+        double emiTime = time + s / beta / Const::speedOfLight;
+        double detTime = emiTime + propLen * topgp->getGroupIndex(e) / Const::speedOfLight;
+        auto* simHit = m_simHits.appendNew(moduleID, pmtID, xLocal, yLocal, detTime, e);
+        if (mcParticle) mcParticle->addRelationTo(simHit);
+
+        TVector3 emiDir(firstState.getKx(), firstState.getKy(), firstState.getKz());
+        TVector3 detPoint(lastState.getX(), lastState.getY(), lastState.getZ());
+        TVector3 detDir(lastState.getKx(), lastState.getKy(), lastState.getKz());
+        auto* simPhoton = m_simPhotons.appendNew(moduleID,
+                                                 module.pointToLocal(module.pointNominalToGlobal(emiPoint)),
+                                                 module.momentumToLocal(module.momentumNominalToGlobal(emiDir)),
+                                                 emiTime,
+                                                 module.pointToLocal(module.pointNominalToGlobal(detPoint)),
+                                                 module.momentumToLocal(module.momentumNominalToGlobal(detDir)),
+                                                 detTime, propLen, e);
+        simHit->addRelationTo(simPhoton);
+      }
+    }
+
+  }
+
+
+  double TOPFastOpticalSimulatorModule::getPathInBar(const TVector3& position, const TVector3& direction,
+                                                     const RaytracerBase& raytracer, double& start) const
+  {
+    const auto& bars = raytracer.getBars();
+    double pos[3] = {position.X(), position.Y(), position.Z()};
+    double dir[3] = {direction.X(), direction.Y(), direction.Z()};
+    double low[3] = { -bars.front().A / 2, -bars.front().B / 2, bars.front().zL};
+    double high[3] = {bars.front().A / 2, bars.front().B / 2, bars.back().zR};
+
+    // intersection of the line with the box; the entrance point may lie slightly outside
+    // because TOPBarHits are given in the displaced module frame
+
+    double tmin = -std::numeric_limits<double>::infinity();
+    double tmax = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 3; i++) {
+      if (dir[i] == 0) {
+        if (pos[i] < low[i] or pos[i] > high[i]) return 0;
+        continue;
+      }
+      double t1 = (low[i] - pos[i]) / dir[i];
+      double t2 = (high[i] - pos[i]) / dir[i];
+      tmin = std::max(tmin, std::min(t1, t2));
+      tmax = std::min(tmax, std::max(t1, t2));
+    }
+    start = std::max(tmin, 0.0);
+    return std::max(tmax - start, 0.0);
+  }
+
+
+  int TOPFastOpticalSimulatorModule::findPMT(double x, double y, const TOPGeoModule& module,
+                                             double& xLocal, double& yLocal) const
+  {
+    const auto& pmtArray = module.getPMTArray();
+    const auto& pmt = pmtArray.getPMT();
+
+    // PMT array position in module nominal frame (as in PixelPositions)
+
+    const auto& prism = module.getPrism();
+    double yUp = prism.getThickness() / 2;
+    double yDown = yUp - prism.getExitThickness();
+    const auto& pmtArrayDispl = module.getPMTArrayDisplacement();
+    double xa = x - pmtArrayDispl.getX();
+    double ya = y - pmtArrayDispl.getY() - (yUp + yDown) / 2;
+
+    // PMT columns are numbered in opposite direction to x, rows along y
+
+    int col = int((pmtArray.getSizeX() / 2 - xa) / pmtArray.getDx()) + 1;
+    int row = int((ya + pmtArray.getSizeY() / 2) / pmtArray.getDy()) + 1;
+    if (xa > pmtArray.getSizeX() / 2 or col > int(pmtArray.getNumColumns())) return 0;
+    if (ya < -pmtArray.getSizeY() / 2 or row > int(pmtArray.getNumRows())) return 0;
+
+    xLocal = xa - pmtArray.getX(col);
+    yLocal = ya - pmtArray.getY(row);
+    if (fabs(xLocal) >= pmt.getSensSizeX() / 2 or fabs(yLocal) >= pmt.getSensSizeY() / 2) return 0;
+
+    int pmtID = pmtArray.getPmtID(row, col);
+    if (pmtArray.isPMTDecoupled(pmtID)) return 0;
+    return pmtID;
+  }
+
+
+} // end Belle2 namespace
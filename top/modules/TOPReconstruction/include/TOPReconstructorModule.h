@@ -52,6 +52,11 @@ namespace Belle2 {
      */
     virtual void event() override;
 
+    /**
+     * Termination action.
+     */
+    virtual void terminate() override;
+
   private:
 
     // Module steering parameters
@@ -62,6 +67,12 @@ namespace Belle2 {
     std::string m_topDigitCollectionName; /**< name of the collection of TOPDigits */
     std::string m_topLikelihoodCollectionName; /**< name of the collection of created TOPLikelihoods */
     std::string m_topPullCollectionName; /**< name of the collection of created TOPPulls */
+    int m_numThreads = 1; /**< number of threads used to reconstruct the tracks of an event */
+
+    // timing
+
+    unsigned m_numTracks = 0; /**< number of reconstructed tracks */
+    double m_totalTime = 0; /**< sum of per-track reconstruction times [ms] */
 
     // datastore objects
 
@@ -15,7 +15,13 @@
 // framework aux
 #include <framework/gearbox/Const.h>
 #include <framework/logging/Logger.h>
+#include <framework/logging/LogSystem.h>
 #include <set>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <chrono>
 
 using namespace std;
 
@@ -28,6 +34,18 @@ namespace Belle2 {
 
   REG_MODULE(TOPReconstructor)
 
+  namespace {
+    /**
+     * Reconstruction result of a track for one particle hypothesis
+     */
+    struct HypothesisResult {
+      bool valid = false; /**< true if PDF has been constructed */
+      PDFConstructor::LogL logL = PDFConstructor::LogL(0); /**< log likelihood */
+      double expBkgPhotons = 0; /**< expected number of background photons */
+      std::vector<PDFConstructor::Pull> pulls; /**< photon pulls (only for the hypothesis chosen for pulls) */
+    };
+  }
+
   //-----------------------------------------------------------------
   //                 Implementation
   //-----------------------------------------------------------------
@@ -54,6 +72,8 @@ namespace Belle2 {
     addParam("TOPLikelihoodCollectionName", m_topLikelihoodCollectionName,
              "Name of the produced collection of TOPLikelihoods", string(""));
     addParam("TOPPullCollectionName", m_topPullCollectionName, "Name of the collection of produced TOPPulls", string(""));
+    addParam("numberOfThreads", m_numThreads,
+             "number of threads used to reconstruct the tracks of an event (results do not depend on it)", 1);
   }
 
 
@@ -98,48 +118,116 @@ namespace Belle2 {
 
     TOPRecoManager::setTimeWindow(m_minTime, m_maxTime);
 
-    // reconstruct track-by-track and store the results
+    // construct tracks at TOP (uses datastore, hence done serially)
 
+    std::vector<const Track*> tracks;
+    std::vector<std::unique_ptr<const TOPTrack>> trks;
     for (const auto& track : m_tracks) {
+      std::unique_ptr<const TOPTrack> trk(new TOPTrack(track, m_topDigitCollectionName));
+      if (not trk->isValid()) continue; // track missed the bars
+      tracks.push_back(&track);
+      trks.push_back(std::move(trk));
+    }
 
-      const TOPTrack trk(track, m_topDigitCollectionName);
-      if (not trk.isValid()) continue; // track missed the bars
+    // reconstruct track-by-track: PDF's for all particle hypotheses of a track are constructed in the same thread
+
+    std::vector<std::vector<HypothesisResult>> results(trks.size());
+    std::vector<double> times(trks.size(), 0);
+
+    auto reconstruct = [&](size_t i) {
+      auto start = std::chrono::steady_clock::now();
+      const auto& trk = *trks[i];
+      int pdgCode = (m_PDGCode != 0) ? m_PDGCode : trk.getPDGCode(); // PDG code used for providing pulls
+      for (const auto& chargedStable : Const::chargedStableSet) {
+        results[i].push_back(HypothesisResult());
+        auto& result = results[i].back();
+        const PDFConstructor pdfConstructor(trk, chargedStable);
+        if (not pdfConstructor.isValid()) continue;
+        result.valid = true;
+        result.logL = pdfConstructor.getLogL();
+        result.expBkgPhotons = pdfConstructor.getExpectedBkgPhotons();
+        if (abs(chargedStable.getPDGCode()) == abs(pdgCode)) result.pulls = pdfConstructor.getPulls();
+      }
+      times[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    const int numThreads = std::min<int>(m_numThreads, trks.size());
+    if (numThreads > 1) {
+      // geometry and time window are fetched here, log messages are collected per track and sent after the join
+      TOPRecoManager::prepareWorkingCopies(numThreads);
+      std::vector<std::vector<LogMessage>> messages(trks.size());
+      std::atomic<size_t> next(0);
+      auto worker = [&](int index) {
+        TOPRecoManager::useWorkingCopy(index);
+        for (size_t i = next++; i < trks.size(); i = next++) {
+          LogSystem::setThreadMessageBuffer(&messages[i]);
+          reconstruct(i);
+        }
+        LogSystem::setThreadMessageBuffer(nullptr);
+        TOPRecoManager::useWorkingCopy(-1);
+      };
+      std::vector<std::thread> threads;
+      for (int t = 0; t < numThreads; t++) threads.emplace_back(worker, t);
+      for (auto& thread : threads) thread.join();
+      for (auto& trackMessages : messages) {
+        for (auto& message : trackMessages) LogSystem::Instance().sendMessage(std::move(message));
+      }
+    } else {
+      for (size_t i = 0; i < trks.size(); i++) reconstruct(i);
+    }
+
+    // store the results
+
+    for (size_t i = 0; i < trks.size(); i++) {
+      const auto& track = *tracks[i];
+      const auto& trk = *trks[i];
 
       auto* topLL = m_likelihoods.appendNew();
       track.addRelationTo(topLL);
       topLL->addRelationTo(trk.getExtHit());
       topLL->addRelationTo(trk.getBarHit());
 
-      int pdgCode = (m_PDGCode != 0) ? m_PDGCode : trk.getPDGCode(); // PDG code used for providing pulls
       std::set<int> nfotSet;    // to x-check if the number of photons differs between particle hypotheses
       std::set<double> nbkgSet; // to x-check if the background differs between particle hypotheses
       int flag = 1;
+      size_t k = 0;
       for (const auto& chargedStable : Const::chargedStableSet) {
-        const PDFConstructor pdfConstructor(trk, chargedStable);
-        if (not pdfConstructor.isValid()) {
+        const auto& result = results[i][k++];
+        if (not result.valid) {
           flag = -1;
           continue;
         }
-        auto LL = pdfConstructor.getLogL();
-        topLL->set(chargedStable, LL.numPhotons, LL.logL, LL.expPhotons, pdfConstructor.getExpectedBkgPhotons());
+        const auto& LL = result.logL;
+        topLL->set(chargedStable, LL.numPhotons, LL.logL, LL.expPhotons, result.expBkgPhotons);
 
         nfotSet.insert(LL.numPhotons);
-        nbkgSet.insert(pdfConstructor.getExpectedBkgPhotons());
+        nbkgSet.insert(result.expBkgPhotons);
 
-        if (abs(chargedStable.getPDGCode()) == abs(pdgCode)) {
-          for (const auto& p : pdfConstructor.getPulls()) {
-            auto* pull = m_topPulls.appendNew(p.pixelID, p.time, p.peakT0 + p.ttsT0, p.sigma, p.phiCer, p.wt);
-            track.addRelationTo(pull);
-          }
+        for (const auto& p : result.pulls) {
+          auto* pull = m_topPulls.appendNew(p.pixelID, p.time, p.peakT0 + p.ttsT0, p.sigma, p.phiCer, p.wt);
+          track.addRelationTo(pull);
         }
       }
       topLL->setFlag(flag);
 
       if (nfotSet.size() > 1) B2ERROR("Bug in TOP::PDFConstructor: number of photons differs between particle hypotheses");
       if (nbkgSet.size() > 1) B2ERROR("Bug in TOP::PDFConstructor: estimated background differs between particle hypotheses");
+
+      B2DEBUG(20, "TOPReconstructor: track reconstructed" << LogVar("slot", trk.getModuleID())
+              << LogVar("time [ms]", times[i]));
+      m_numTracks++;
+      m_totalTime += times[i];
     }
 
   }
 
+
+  void TOPReconstructorModule::terminate()
+  {
+    if (m_numTracks == 0) return;
+    B2RESULT("TOPReconstructor: " << m_numTracks << " tracks reconstructed, mean time per track = "
+             << m_totalTime / m_numTracks << " ms (" << m_numThreads << " thread(s))");
+  }
+
 } // end Belle2 namespace
 
@@ -523,6 +523,7 @@ namespace Belle2 {
       int m_moduleID = 0; /**< slot ID */
       const TOPTrack& m_track;   /**< temporary reference to track at TOP */
       const Const::ChargedStable m_hypothesis; /**< particle hypothesis */
+      const std::vector<TOPTrack::SelectedHit>& m_selectedHits; /**< selected photon hits (temporary reference to those of track) */
       const InverseRaytracer* m_inverseRaytracer = 0; /**< inverse ray-tracer */
       const FastRaytracer* m_fastRaytracer = 0; /**< fast ray-tracer */
       const YScanner* m_yScanner = 0; /**< PDF expander in y */
@@ -539,7 +540,6 @@ namespace Belle2 {
       double m_cosTotal = 0; /**< cosine of total reflection angle */
       double m_minTime = 0; /**< time window lower edge */
       double m_maxTime = 0; /**< time window upper edge */
-      std::vector<TOPTrack::SelectedHit> m_selectedHits; /**< selected photon hits */
       double m_bkgRate = 0; /**< estimated background hit rate */
 
       std::vector<SignalPDF> m_signalPDFs; /**< parameterized signal PDF in pixels (index = pixelID - 1) */
@@ -12,6 +12,7 @@
 #include <top/reconstruction_cpp/FastRaytracer.h>
 #include <top/reconstruction_cpp/YScanner.h>
 #include <top/reconstruction_cpp/BackgroundPDF.h>
+#include <top/reconstruction_cpp/DeltaRayPDF.h>
 #include <top/dbobjects/TOPCalChannelMask.h>
 #include <top/dbobjects/TOPCalChannelT0.h>
 #include <top/dbobjects/TOPCalTimebase.h>
@@ -65,18 +66,41 @@ namespace Belle2 {
        */
       static const BackgroundPDF* getBackgroundPDF(int moduleID);
 
+      /**
+       * Returns delta-ray PDF of a given module with the track independent tables already set.
+       * The object must be copied and prepared for a given track before use.
+       * @param moduleID slot ID (1-based)
+       * @return pointer to delta-ray PDF or null pointer if moduleID is not valid
+       */
+      static const DeltaRayPDF* getDeltaRayPDF(int moduleID);
+
       /**
        * Returns background PDF's of all modules
        * @return collection of background PDF's (index = moduleID - 1)
        */
       static const std::vector<BackgroundPDF>& getBackgroundPDFs() {return getInstance().backgroundPDFs();}
 
+      /**
+       * Returns geometry parameters in basf2 units.
+       * In the worker threads the pointer fetched by prepareWorkingCopies() is returned,
+       * because TOPGeometryPar::getGeometry() sets the units and is therefore not thread-safe.
+       * @return geometry parameters
+       */
+      static const TOPGeometry* getGeometry()
+      {
+        const auto* copy = getInstance().workingCopy();
+        if (copy) return copy->geometry;
+        return TOPGeometryPar::Instance()->getGeometry();
+      }
+
       /**
        * Returns time window lower edge
        * @return time window lower edge
        */
       static double getMinTime()
       {
+        const auto* copy = getInstance().workingCopy();
+        if (copy) return copy->minTime;
         if (getInstance().m_minTime < getInstance().m_maxTime) {
           return getInstance().m_minTime;
         }
@@ -89,6 +113,8 @@ namespace Belle2 {
        */
       static double getMaxTime()
       {
+        const auto* copy = getInstance().workingCopy();
+        if (copy) return copy->maxTime;
         if (getInstance().m_minTime < getInstance().m_maxTime) {
           return getInstance().m_maxTime;
         }
@@ -146,6 +172,22 @@ namespace Belle2 {
        */
       static void setChannelEffi();
 
+      /**
+       * Prepares working copies of the objects with mutable internal state (ray-tracers and y-scanners)
+       * for reconstruction in parallel threads and brings the shared objects up to date.
+       * The geometry and the time window are fetched here for use in the worker threads.
+       * Must be called from the main thread before the worker threads are started.
+       * @param numCopies number of working copies (one per worker thread)
+       */
+      static void prepareWorkingCopies(unsigned numCopies);
+
+      /**
+       * Selects the working copy returned by getInverseRaytracer, getFastRaytracer and getYScanner
+       * in the calling thread
+       * @param index working copy index or -1 to use the original objects
+       */
+      static void useWorkingCopy(int index);
+
     private:
 
       /** Singleton: private constructor */
@@ -157,9 +199,28 @@ namespace Belle2 {
       /** Singleton: private destructor */
       ~TOPRecoManager() = default;
 
+      /**
+       * Working copies of the objects with mutable internal state, used by a single thread
+       */
+      struct WorkingCopy {
+        std::vector<InverseRaytracer> inverseRaytracers; /**< copies of inverse raytracers */
+        std::vector<FastRaytracer> fastRaytracers; /**< copies of fast raytracers */
+        std::vector<YScanner> yScanners; /**< copies of y-scanners */
+        unsigned version = 0; /**< version of the original objects at the time of copying */
+        const TOPGeometry* geometry = 0; /**< geometry parameters in basf2 units */
+        double minTime = 0; /**< time window lower edge */
+        double maxTime = 0; /**< time window upper edge */
+      };
+
       /** Sets the reconstruction object collections */
       void set();
 
+      /**
+       * Returns working copy selected in the calling thread
+       * @return pointer to working copy or null pointer if the original objects are to be used
+       */
+      WorkingCopy* workingCopy();
+
       /**
        * Interface to inverse ray-tracers of all modules.
        * Any accesses to underlying collection must be made with this method.
@@ -192,6 +253,9 @@ namespace Belle2 {
       std::vector<FastRaytracer> m_fastRaytracers; /**< collection of fast raytracers */
       std::vector<YScanner> m_yScanners; /**< collection of y-scanners */
       std::vector<BackgroundPDF> m_backgroundPDFs; /**< collection of background PDF's */
+      std::vector<DeltaRayPDF> m_deltaRayPDFs; /**< collection of delta-ray PDF's with track independent tables */
+      std::vector<WorkingCopy> m_workingCopies; /**< working copies for parallel threads */
+      unsigned m_version = 1; /**< version of the original objects, incremented at each change of y-scanners */
       double m_minTime = 0; /**< time window lower edge */
       double m_maxTime = 0; /**< time window upper edge */
       bool m_redoBkg = false; /**< flag to signal whether backgroundPDF has to be redone */
@@ -23,11 +23,13 @@ namespace Belle2 {
     PDFConstructor::PDFConstructor(const TOPTrack& track, const Const::ChargedStable& hypothesis,
                                    EPDFOption PDFOption, EStoreOption storeOption, double overrideMass):
       m_moduleID(track.getModuleID()), m_track(track), m_hypothesis(hypothesis),
+      m_selectedHits(track.getSelectedHits()),
       m_inverseRaytracer(TOPRecoManager::getInverseRaytracer(m_moduleID)),
       m_fastRaytracer(TOPRecoManager::getFastRaytracer(m_moduleID)),
       m_yScanner(TOPRecoManager::getYScanner(m_moduleID)),
       m_backgroundPDF(TOPRecoManager::getBackgroundPDF(m_moduleID)),
-      m_deltaRayPDF(m_moduleID),
+      m_deltaRayPDF(TOPRecoManager::getDeltaRayPDF(m_moduleID) ?
+                    *TOPRecoManager::getDeltaRayPDF(m_moduleID) : DeltaRayPDF(m_moduleID)),
       m_PDFOption(PDFOption), m_storeOption(storeOption)
     {
       if (not track.isValid()) {
@@ -50,14 +52,14 @@ namespace Belle2 {
       m_cosTotal = m_yScanner->getCosTotal();
       m_minTime = TOPRecoManager::getMinTime();
       m_maxTime = TOPRecoManager::getMaxTime();
-      m_selectedHits = track.getSelectedHits();
       m_bkgRate = track.getBkgRate();
 
       // prepare the memory for storing signal PDF
 
       const auto& pixelPositions = m_yScanner->getPixelPositions();
       int numPixels = pixelPositions.getNumPixels();
-      const auto* geo = TOPGeometryPar::Instance()->getGeometry();
+      const auto* geo = TOPRecoManager::getGeometry();
+      m_signalPDFs.reserve(numPixels);
       for (int pixelID = 1; pixelID <= numPixels; pixelID++) {
         auto pmtType = pixelPositions.get(pixelID).pmtType;
         const auto& tts = geo->getTTS(pmtType);
@@ -12,6 +12,11 @@
 namespace Belle2 {
   namespace TOP {
 
+    namespace {
+      /** working copy index selected in the calling thread (-1: use the original objects) */
+      thread_local int s_workingCopyIndex = -1;
+    }
+
     TOPRecoManager& TOPRecoManager::getInstance()
     {
       static TOPRecoManager instance;
@@ -27,11 +32,53 @@ namespace Belle2 {
         m_fastRaytracers.push_back(FastRaytracer(moduleID));
         m_backgroundPDFs.push_back(BackgroundPDF(moduleID));
       }
+      // delta-ray PDF's need the collections above, hence in a separate loop
+      for (unsigned moduleID = 1; moduleID <= geo->getNumModules(); moduleID++) {
+        m_deltaRayPDFs.push_back(DeltaRayPDF(moduleID));
+      }
+    }
+
+    TOPRecoManager::WorkingCopy* TOPRecoManager::workingCopy()
+    {
+      if (s_workingCopyIndex < 0) return 0;
+      unsigned k = s_workingCopyIndex;
+      if (k < m_workingCopies.size()) return &m_workingCopies[k];
+
+      B2ERROR("TOPRecoManager: invalid working copy index, original objects will be used"
+              << LogVar("index", s_workingCopyIndex));
+      s_workingCopyIndex = -1;
+      return 0;
+    }
+
+    void TOPRecoManager::prepareWorkingCopies(unsigned numCopies)
+    {
+      auto& instance = getInstance();
+      instance.backgroundPDFs(); // sets the collections if not done yet and redoes background PDF's if needed
+      instance.m_workingCopies.resize(numCopies);
+      const auto* geometry = getGeometry();
+      double minTime = getMinTime();
+      double maxTime = getMaxTime();
+      for (auto& copy : instance.m_workingCopies) {
+        copy.geometry = geometry;
+        copy.minTime = minTime;
+        copy.maxTime = maxTime;
+        if (copy.version == instance.m_version) continue;
+        copy.inverseRaytracers = instance.inverseRaytracers();
+        copy.fastRaytracers = instance.fastRaytracers();
+        copy.yScanners = instance.yScanners();
+        copy.version = instance.m_version;
+      }
+    }
+
+    void TOPRecoManager::useWorkingCopy(int index)
+    {
+      s_workingCopyIndex = index;
     }
 
     const InverseRaytracer* TOPRecoManager::getInverseRaytracer(int moduleID)
     {
-      const auto& collection = getInstance().inverseRaytracers();
+      auto* copy = getInstance().workingCopy();
+      const auto& collection = copy ? copy->inverseRaytracers : getInstance().inverseRaytracers();
       unsigned k = moduleID - 1;
       if (k < collection.size()) {
         collection[k].clear();
@@ -44,7 +91,8 @@ namespace Belle2 {
 
     const FastRaytracer* TOPRecoManager::getFastRaytracer(int moduleID)
     {
-      const auto& collection = getInstance().fastRaytracers();
+      auto* copy = getInstance().workingCopy();
+      const auto& collection = copy ? copy->fastRaytracers : getInstance().fastRaytracers();
       unsigned k = moduleID - 1;
       if (k < collection.size()) {
         collection[k].clear();
@@ -57,7 +105,8 @@ namespace Belle2 {
 
     const YScanner* TOPRecoManager::getYScanner(int moduleID)
     {
-      const auto& collection = getInstance().yScanners();
+      auto* copy = getInstance().workingCopy();
+      const auto& collection = copy ? copy->yScanners : getInstance().yScanners();
       unsigned k = moduleID - 1;
       if (k < collection.size()) {
         collection[k].clear();
@@ -81,6 +130,20 @@ namespace Belle2 {
       return 0;
     }
 
+    const DeltaRayPDF* TOPRecoManager::getDeltaRayPDF(int moduleID)
+    {
+      auto& instance = getInstance();
+      if (instance.m_deltaRayPDFs.empty()) instance.set();
+      const auto& collection = instance.m_deltaRayPDFs;
+      unsigned k = moduleID - 1;
+      if (k < collection.size()) {
+        return &collection[k];
+      }
+
+      B2ERROR("TOPRecoManager::getDeltaRayPDF: invalid moduleID" << LogVar("moduleID", moduleID));
+      return 0;
+    }
+
     void TOPRecoManager::setChannelMask(const DBObjPtr<TOPCalChannelMask>& mask,
                                         const TOPAsicMask& asicMask)
     {
@@ -95,6 +158,7 @@ namespace Belle2 {
         }
       }
       getInstance().m_redoBkg = true;
+      getInstance().m_version++;
 
       B2INFO("TOPRecoManager: new channel masks have been passed to reconstruction");
     }
@@ -113,6 +177,7 @@ namespace Belle2 {
         }
       }
       getInstance().m_redoBkg = true;
+      getInstance().m_version++;
 
       B2INFO("TOPRecoManager: channelT0-uncalibrated channels have been masked off");
     }
@@ -139,6 +204,7 @@ namespace Belle2 {
         }
       }
       getInstance().m_redoBkg = true;
+      getInstance().m_version++;
 
       B2INFO("TOPRecoManager: timebase-uncalibrated channels have been masked off");
     }
@@ -172,6 +238,7 @@ namespace Belle2 {
         }
       }
       getInstance().m_redoBkg = true;
+      getInstance().m_version++;
 
       B2INFO("TOPRecoManager: new relative pixel efficiencies have been passed to reconstruction");
     }
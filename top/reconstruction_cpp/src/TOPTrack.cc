@@ -363,7 +363,7 @@ namespace Belle2 {
 
     bool TOPTrack::isScanRequired(unsigned col, double time, double wid) const
     {
-      const auto& tts = TOPGeometryPar::Instance()->getGeometry()->getTTS(0); // PMT independent TTS should be fine here
+      const auto& tts = TOPRecoManager::getGeometry()->getTTS(0); // PMT independent TTS should be fine here
       const auto& range = m_columnHits.equal_range(col);
       for (auto it = range.first; it != range.second; ++it) {
         const auto hit = it->second;
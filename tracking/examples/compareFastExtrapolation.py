@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+##########################################################################
+# basf2 (Belle II Analysis Software Framework)                           #
+# Author: The Belle II Collaboration                                     #
+#                                                                        #
+# See git log for contributors and copyright holders.                    #
+# This file is licensed under LGPL-3.0, see LICENSE.md.                  #
+##########################################################################
+
+# ---------------------------------------------------------------------------------------
+# Validation of the fast track extrapolation against the geant4e extrapolation
+# ExtHit positions in TOP, ARICH and ECL and the muon identification efficiency and
+# pion misidentification probability are histogrammed
+#
+# usage: basf2 compareFastExtrapolation.py [geant4e|fast]
+# Run the script in both modes and overlay the histograms of the two output files.
+# The timing of the Ext and Muid modules is printed at the end.
+# ---------------------------------------------------------------------------------------
+
+import sys
+import basf2 as b2
+from simulation import add_simulation
+from reconstruction import add_reconstruction
+from ROOT import Belle2, TFile, TH1F, TH2F
+
+mode = sys.argv[1] if len(sys.argv) > 1 else 'fast'
+if mode not in ['geant4e', 'fast']:
+    b2.B2FATAL('Unknown mode ' + mode + ', use geant4e or fast')
+outputFile = 'Extrapolation_' + mode + '.root'
+
+#: cut on the muon probability for the identification efficiency
+muonIDCut = 0.9
+
+
+class ExtrapolationHistograms(b2.Module):
+    ''' Histograms of ExtHit positions and of the muon identification '''
+
+    def initialize(self):
+        ''' Book histograms '''
+
+        #: output file
+        self.file = TFile(outputFile, 'recreate')
+        #: TOP entry points
+        self.top = TH2F('top', 'TOP entry points; z [cm]; #phi [rad]', 300, -150, 300, 200, -3.2, 3.2)
+        #: TOP entry radius
+        self.top_r = TH1F('top_r', 'TOP entry points; r [cm]', 200, 110, 130)
+        #: ARICH exit points
+        self.arich = TH2F('arich', 'ARICH aerogel exit points; x [cm]; y [cm]', 250, -125, 125, 250, -125, 125)
+        #: ECL entry points
+        self.ecl = TH2F('ecl', 'ECL entry points; z [cm]; r [cm]', 400, -150, 250, 200, 0, 200)
+        #: ECL entry cells
+        self.ecl_cell = TH1F('ecl_cell', 'ECL entry cells; cell ID', 8736, 0.5, 8736.5)
+        #: muon probability of true muons
+        self.muonID_muon = TH1F('muonID_muon', 'muons; muon probability', 100, 0, 1)
+        #: muon probability of true pions
+        self.muonID_pion = TH1F('muonID_pion', 'pions; muon probability', 100, 0, 1)
+        #: momentum of true muons
+        self.p_muon = TH1F('p_muon', 'muons; p [GeV/c]', 30, 0, 3)
+        #: momentum of true muons identified as muons
+        self.p_muon_id = TH1F('p_muon_id', 'muons identified as muons; p [GeV/c]', 30, 0, 3)
+        #: momentum of true pions
+        self.p_pion = TH1F('p_pion', 'pions; p [GeV/c]', 30, 0, 3)
+        #: momentum of true pions identified as muons
+        self.p_pion_id = TH1F('p_pion_id', 'pions identified as muons; p [GeV/c]', 30, 0, 3)
+
+    def event(self):
+        ''' Fill histograms '''
+
+        for track in Belle2.PyStoreArray('Tracks'):
+            mcParticle = track.getRelated('MCParticles')
+            if not mcParticle:
+                continue
+            pdg = abs(mcParticle.getPDG())
+            if pdg not in [13, 211]:
+                continue
+
+            for extHit in track.getRelationsTo('ExtHits'):
+                if abs(extHit.getPdgCode()) != pdg:
+                    continue
+                position = extHit.getPosition()
+                detector = extHit.getDetectorID()
+                status = extHit.getStatus()
+                if detector == Belle2.Const.TOP and status == Belle2.EXT_ENTER and extHit.getCopyID() > 0:
+                    self.top.Fill(position.Z(), position.Phi())
+                    self.top_r.Fill(position.Perp())
+                elif detector == Belle2.Const.ARICH and status == Belle2.EXT_EXIT and extHit.getCopyID() == 6789:
+                    self.arich.Fill(position.X(), position.Y())
+                elif detector == Belle2.Const.ECL and status == Belle2.EXT_ENTER:
+                    self.ecl.Fill(position.Z(), position.Perp())
+                    self.ecl_cell.Fill(extHit.getCopyID() + 1)
+
+            likelihood = None
+            for muidLikelihood in track.getRelationsTo('KLMMuidLikelihoods'):
+                if abs(muidLikelihood.getPDGCode()) == 13:
+                    likelihood = muidLikelihood
+            if not likelihood:
+                continue
+            pdfSum = likelihood.getMuonPDFValue() + likelihood.getPionPDFValue() + likelihood.getKaonPDFValue() + \
+                likelihood.getProtonPDFValue() + likelihood.getElectronPDFValue()
+            if pdfSum <= 0:
+                continue
+            muonID = likelihood.getMuonPDFValue() / pdfSum
+            p = mcParticle.getMomentum().Mag()
+            if pdg == 13:
+                self.muonID_muon.Fill(muonID)
+                self.p_muon.Fill(p)
+                if muonID > muonIDCut:
+                    self.p_muon_id.Fill(p)
+            else:
+                self.muonID_pion.Fill(muonID)
+                self.p_pion.Fill(p)
+                if muonID > muonIDCut:
+                    self.p_pion_id.Fill(p)
+
+    def terminate(self):
+        ''' Write histograms '''
+
+        #: muon identification efficiency
+        self.eff_muon = self.p_muon_id.Clone('eff_muon')
+        self.eff_muon.SetTitle('muon identification efficiency; p [GeV/c]')
+        self.eff_muon.Divide(self.p_muon_id, self.p_muon, 1, 1, 'B')
+        #: pion misidentification probability
+        self.eff_pion = self.p_pion_id.Clone('eff_pion')
+        self.eff_pion.SetTitle('pion misidentification probability; p [GeV/c]')
+        self.eff_pion.Divide(self.p_pion_id, self.p_pion, 1, 1, 'B')
+        self.file.Write()
+        self.file.Close()
+
+
+# Suppress messages and warnings during processing:
+b2.set_log_level(b2.LogLevel.WARNING)
+
+# Create path
+main = b2.create_path()
+
+# Set number of events to generate
+main.add_module('EventInfoSetter', evtNumList=[2000])
+
+# Particle gun: muons and pions
+particlegun = b2.register_module('ParticleGun')
+particlegun.param('pdgCodes', [13, -13, 211, -211])
+particlegun.param('nTracks', 1)
+particlegun.param('varyNTracks', False)
+particlegun.param('momentumGeneration', 'uniform')
+particlegun.param('momentumParams', [0.5, 3])
+particlegun.param('thetaGeneration', 'uniformCos')
+particlegun.param('thetaParams', [17, 150])
+particlegun.param('phiGeneration', 'uniform')
+particlegun.param('phiParams', [0, 360])
+particlegun.param('vertexGeneration', 'fixed')
+particlegun.param('xVertexParams', [0])
+particlegun.param('yVertexParams', [0])
+particlegun.param('zVertexParams', [0])
+particlegun.param('independentVertices', False)
+main.add_module(particlegun)
+
+# Simulation and reconstruction
+add_simulation(main)
+add_reconstruction(main)
+
+# Select the extrapolation backend of the Ext and Muid modules
+fast = (mode == 'fast')
+b2.set_module_parameters(main, 'Ext', recursive=True, FastExtrapolation=fast)
+b2.set_module_parameters(main, 'Muid', recursive=True, FastExtrapolation=fast)
+
+# Histograms
+main.add_module(ExtrapolationHistograms())
+
+# Show progress of processing
+main.add_module('Progress')
+
+# Process events
+b2.process(main)
+
+# Print call statistics
+print(b2.statistics)
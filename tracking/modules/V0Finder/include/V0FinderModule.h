@@ -8,6 +8,7 @@
 #pragma once
 //Object with performing the actual algorithm:
 #include <tracking/v0Finding/fitter/V0Fitter.h>
+#include <tracking/v0Finding/fitter/V0HelixPreSelection.h>
 
 #include <mdst/dataobjects/Track.h>
 
@@ -16,6 +17,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace Belle2 {
   /** A V0 finder module.
@@ -50,6 +52,16 @@ namespace Belle2 {
     void event() override;
 
   private:
+    /** Track with the quantities used to pre-select the pairs, looked up once per event. */
+    struct TrackCandidate {
+      const Track* track;     ///< the track itself
+      Helix helix;            ///< helix of the fit result with the mass closest to the pion
+      double momentumPion;    ///< momentum of the fit result with the mass closest to the pion
+      double momentumProton;  ///< momentum of the fit result with the mass closest to the proton
+    };
+
+    /** Look up the pre-selection quantities of a track. */
+    static TrackCandidate makeTrackCandidate(const Track* track);
 
     std::string m_arrayNameTrack;     ///< StoreArray name of the Tracks          (Input).
     StoreArray<Track> m_tracks;       ///< Actually array of mdst Tracks.
@@ -90,11 +102,17 @@ namespace Belle2 {
       @param trackMinus: the track for the negatively charged candidate
       @param v0Hypothesis: the hypothesis for the V0 (Lambda, or Kshort, for all others nothing happens)
     */
-    bool preFilterTracks(const Track* trackPlus, const Track* trackMinus, const Const::ParticleType& v0Hypothesis);
+    bool preFilterTracks(const TrackCandidate& trackPlus, const TrackCandidate& trackMinus,
+                         const Const::ParticleType& v0Hypothesis);
     // buffer some variables to speed up time, actual values will be calculated at initialization
     double m_mKshortMin2 = 0; ///< pre-calculated mininum Kshort mass squared
     double m_mKshortMax2 = 0; ///< pre-calculated maximum Kshort mass squared
     double m_mLambdaMin2 = 0; ///< pre-calculated mininum Lambda mass squared
     double m_mLambdaMax2 = 0; ///< pre-calculated maximum Lambda mass squared
+
+    bool m_useHelixPreSelection;            ///< Flag if the pairs are pre-selected by the closest approach of their helices.
+    double m_helixPreSelectionMaxDistance;  ///< Maximal distance of the helices at the vertex.
+    double m_helixPreSelectionMinRadius;    ///< Minimal cylindrical radius of the vertex from the helices.
+    V0HelixPreSelection m_helixPreSelection;  ///< Pre-selection by the closest approach of the helices.
   };
 }
@@ -84,6 +84,18 @@ V0FinderModule::V0FinderModule() : Module()
   addParam("massRangeLambda", m_preFilterMassRangeLambda,
            "mass range in GeV for reconstructed Lambda used for pre-selection of candidates"
            " (to be chosen loosely as used momenta ignore material effects)", m_preFilterMassRangeLambda);
+
+  addParam("useHelixPreSelection", m_useHelixPreSelection,
+           "Pre-select the track pairs by the closest approach of their helices before any vertex fit. "
+           "The helices are moved analytically, so this is much faster than the extrapolation done in the fit. "
+           "Off by default until its efficiency is validated.",
+           false);
+  addParam("helixPreSelectionMaxDistance", m_helixPreSelectionMaxDistance,
+           "Maximal distance in cm of the two helices at their closest approach used for pre-selection of candidates"
+           " (to be chosen loosely as the helices ignore material effects and field inhomogeneities)", 10.);
+  addParam("helixPreSelectionMinRadius", m_helixPreSelectionMinRadius,
+           "Minimal cylindrical radius in cm of the closest approach of the two helices used for pre-selection of candidates"
+           " (should be a little below beamPipeRadius)", 0.5);
 }
 
 
@@ -125,6 +137,12 @@ void V0FinderModule::initialize()
                   (m_preFilterMassRangeLambda) : std::get<1>
                   (m_preFilterMassRangeLambda) * std::get<1>(m_preFilterMassRangeLambda);
 
+  if (m_helixPreSelectionMinRadius > m_beamPipeRadius) {
+    B2WARNING("The minimal radius of the helix pre-selection is larger than the beam pipe radius, "
+              "V0s that would pass the vertex fit are lost." << LogVar("helixPreSelectionMinRadius", m_helixPreSelectionMinRadius)
+              << LogVar("beamPipeRadius", m_beamPipeRadius));
+  }
+  m_helixPreSelection = V0HelixPreSelection(m_helixPreSelectionMaxDistance, m_helixPreSelectionMinRadius);
 }
 
 
@@ -132,11 +150,15 @@ void V0FinderModule::event()
 {
   B2DEBUG(200, m_tracks.getEntries() << " tracks in event.");
 
+  // The copies of the genfit::Tracks are only valid within the event.
+  m_v0Fitter->clearGenfitTrackCopies();
+
   // Group tracks into positive and negative tracks.
-  std::vector<const Track*> tracksPlus;
+  // The quantities used in the pre-selection are looked up once per track and shared by all pairs and hypotheses.
+  std::vector<TrackCandidate> tracksPlus;
   tracksPlus.reserve(m_tracks.getEntries());
 
-  std::vector<const Track*> tracksMinus;
+  std::vector<TrackCandidate> tracksMinus;
   tracksMinus.reserve(m_tracks.getEntries());
 
   for (const auto& track : m_tracks) {
@@ -144,10 +166,10 @@ void V0FinderModule::event()
     B2ASSERT("No RecoTrack available for given Track.", recoTrack);
 
     if (recoTrack->getChargeSeed() > 0) {
-      tracksPlus.push_back(&track);
+      tracksPlus.push_back(makeTrackCandidate(&track));
     }
     if (recoTrack->getChargeSeed() < 0) {
-      tracksMinus.push_back(&track);
+      tracksMinus.push_back(makeTrackCandidate(&track));
     }
   }
 
@@ -159,10 +181,18 @@ void V0FinderModule::event()
 
 
   // Pair up each positive track with each negative track.
-  for (auto& trackPlus : tracksPlus) {
-    for (auto& trackMinus : tracksMinus) {
+  for (const auto& candidatePlus : tracksPlus) {
+    for (const auto& candidateMinus : tracksMinus) {
+      // the closest approach of the helices does not depend on the hypothesis, so it is checked once per pair
+      if (m_useHelixPreSelection and not m_helixPreSelection.accept(candidatePlus.helix, candidateMinus.helix)) {
+        B2DEBUG(200, "Track pair rejected by helix pre-selection.");
+        continue;
+      }
+
+      const Track* trackPlus = candidatePlus.track;
+      const Track* trackMinus = candidateMinus.track;
       try {
-        if (preFilterTracks(trackPlus, trackMinus, Const::Kshort)) m_v0Fitter->fitAndStore(trackPlus, trackMinus, Const::Kshort);
+        if (preFilterTracks(candidatePlus, candidateMinus, Const::Kshort)) m_v0Fitter->fitAndStore(trackPlus, trackMinus, Const::Kshort);
       } catch (const genfit::Exception& e) {
         // genfit exception raised, skip this track pair for this hypothesis
         B2WARNING("Genfit exception caught. Skipping this track pair for Kshort hypothesis. " << LogVar("Genfit exception:", e.what()));
@@ -177,14 +207,15 @@ void V0FinderModule::event()
       }
 
       try {
-        if (preFilterTracks(trackPlus, trackMinus, Const::Lambda))  m_v0Fitter->fitAndStore(trackPlus, trackMinus, Const::Lambda);
+        if (preFilterTracks(candidatePlus, candidateMinus, Const::Lambda))  m_v0Fitter->fitAndStore(trackPlus, trackMinus, Const::Lambda);
       } catch (const genfit::Exception& e) {
         // genfit exception raised, skip this track pair for this hypothesis
         B2WARNING("Genfit exception caught. Skipping this track pair for Lambda hypothesis. " << LogVar("Genfit exception:", e.what()));
       }
 
       try {
-        if (preFilterTracks(trackPlus, trackMinus, Const::antiLambda)) m_v0Fitter->fitAndStore(trackPlus, trackMinus, Const::antiLambda);
+        if (preFilterTracks(candidatePlus, candidateMinus, Const::antiLambda)) m_v0Fitter->fitAndStore(trackPlus, trackMinus,
+              Const::antiLambda);
       } catch (const genfit::Exception& e) {
         // genfit exception raised, skip this track pair for this hypothesis
         B2WARNING("Genfit exception caught. Skipping this track pair for anti-Lambda hypothesis. " << LogVar("Genfit exception:",
@@ -196,8 +227,17 @@ void V0FinderModule::event()
 }
 
 
+V0FinderModule::TrackCandidate V0FinderModule::makeTrackCandidate(const Track* track)
+{
+  const TrackFitResult* pionFitResult = track->getTrackFitResultWithClosestMass(Const::pion);
+  const TrackFitResult* protonFitResult = track->getTrackFitResultWithClosestMass(Const::proton);
+  return {track, pionFitResult->getHelix(), pionFitResult->getMomentum().Mag(), protonFitResult->getMomentum().Mag()};
+}
+
+
 bool
-V0FinderModule::preFilterTracks(const Track* trackPlus, const Track* trackMinus, const Const::ParticleType& v0Hypothesis)
+V0FinderModule::preFilterTracks(const TrackCandidate& trackPlus, const TrackCandidate& trackMinus,
+                                const Const::ParticleType& v0Hypothesis)
 {
   const double* range_m2_min = nullptr;
   const double* range_m2_max = nullptr;
@@ -216,12 +256,12 @@ V0FinderModule::preFilterTracks(const Track* trackPlus, const Track* trackMinus,
 
   // first track should always be the positve one
   double m_plus = trackHypotheses.first.getMass();
-  double p_plus = trackPlus->getTrackFitResultWithClosestMass(trackHypotheses.first)->getMomentum().Mag();
+  double p_plus = trackHypotheses.first == Const::proton ? trackPlus.momentumProton : trackPlus.momentumPion;
   double E_plus = sqrt(m_plus * m_plus + p_plus * p_plus);
 
   // second track is the negative
   double m_minus = trackHypotheses.second.getMass();
-  double p_minus = trackMinus->getTrackFitResultWithClosestMass(trackHypotheses.second)->getMomentum().Mag();
+  double p_minus = trackHypotheses.second == Const::proton ? trackMinus.momentumProton : trackMinus.momentumPion;
   double E_minus = sqrt(m_minus * m_minus + p_minus * p_minus);
 
   // now do the adding of the 4momenta
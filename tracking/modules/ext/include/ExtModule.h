@@ -92,6 +92,9 @@ namespace Belle2 {
     //! User-defined maximum miss-distance between the trajectory curve and its linear chord(s) approximation
     double m_DeltaChordInMagneticField;
 
+    //! User-defined flag to use the fast extrapolation in the simplified geometry instead of geant4e
+    bool m_FastExtrapolation;
+
   private:
 
     //! Pointer to the TrackExtrapoleG4e singleton
@@ -39,7 +39,8 @@ ExtModule::ExtModule() :
   m_EnableVisualization(false),
   m_MagneticFieldStepperName(""),
   m_MagneticCacheDistance(0.0),
-  m_DeltaChordInMagneticField(0.0)
+  m_DeltaChordInMagneticField(0.0),
+  m_FastExtrapolation(false)
 {
   m_Extrapolator = TrackExtrapolateG4e::getInstance();
   m_PDGCodes.clear();
@@ -65,6 +66,9 @@ ExtModule::ExtModule() :
            0.0);
   addParam("deltaChordInMagneticField", m_DeltaChordInMagneticField,
            "[mm] The maximum miss-distance between the trajectory curve and its linear cord(s) approximation", 0.25);
+  addParam("FastExtrapolation", m_FastExtrapolation,
+           "If set to True the tracks are extrapolated along helices in a simplified geometry of TOP, ARICH and ECL "
+           "with parametrized energy loss and multiple scattering instead of geant4e", false);
   vector<string> defaultCommands;
   addParam("UICommands", m_UICommands, "A list of Geant4 UI commands that should be applied at the start of the job",
            defaultCommands);
@@ -124,7 +128,7 @@ void ExtModule::initialize()
 
   // Initialize the extrapolator engine for EXT (vs MUID)
   // *NOTE* that MinPt and MinKE are shared by MUID and EXT; only last caller wins
-  m_Extrapolator->initialize(m_MinPt, m_MinKE, m_Hypotheses);
+  m_Extrapolator->initialize(m_MinPt, m_MinKE, m_Hypotheses, m_FastExtrapolation);
 }
 
 void ExtModule::beginRun()
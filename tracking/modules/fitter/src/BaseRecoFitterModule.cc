@@ -14,6 +14,7 @@
 #include <genfit/FieldManager.h>
 
 #include <framework/datastore/StoreArray.h>
+#include <framework/core/EventTimeBudget.h>
 #include <tracking/trackFitting/fitter/base/TrackFitter.h>
 
 #include <simulation/monopoles/MonopoleConstants.h>
@@ -90,6 +91,11 @@ void BaseRecoFitterModule::event()
   unsigned int recoTrackCounter = 0;
 
   for (RecoTrack& recoTrack : recoTracks) {
+    if (EventTimeBudget::isExceeded()) {
+      B2DEBUG(20, "Time budget of the event exceeded, the remaining reco track candidates are not fitted.");
+      break;
+    }
+
     if (recoTrack.getNumberOfTotalHits() < 3) {
       B2WARNING("Genfit2Module: only " << recoTrack.getNumberOfTotalHits() << " were assigned to the Track! " <<
                 "This Track will not be fitted!");
@@ -106,6 +106,9 @@ namespace Belle2 {
     //! Parameter to add the found hits also to the reco tracks or not. Is turned off by default.
     bool m_addHitsToRecoTrack = false;
 
+    //! Parameter to use the fast extrapolation in the simplified geometry instead of geant4e. Is turned off by default.
+    bool m_FastExtrapolation = false;
+
     //! A list of Geant4 UI commands that should be applied before the extrapolation starts
     std::vector<std::string> m_UICommands;
 
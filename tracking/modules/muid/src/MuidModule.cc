@@ -84,6 +84,10 @@ MuidModule::MuidModule() :
            "Parameter to add the found hits also to the reco tracks or not. Is turned off by default. "
            "Make sure to refit the track afterwards.",
            m_addHitsToRecoTrack);
+  addParam("FastExtrapolation", m_FastExtrapolation,
+           "If set to True the tracks are extrapolated along helices in a simplified geometry of the ECL, solenoid and KLM "
+           "with parametrized energy loss and multiple scattering instead of geant4e. No KLM ExtHits are stored in this mode.",
+           m_FastExtrapolation);
   vector<string> defaultCommands;
   addParam("UICommands", m_UICommands, "A list of Geant4 UI commands that should be applied at the start of the job.",
            defaultCommands);
@@ -140,7 +144,8 @@ void MuidModule::initialize()
   // Initialize the extrapolator engine for MUID (vs EXT)
   // *NOTE* that MinPt and MinKE are shared by MUID and EXT; only last caller wins
   m_Extrapolator->initialize(m_MeanDt, m_MaxDt, m_MaxDistSqInVariances, m_MaxKLMTrackClusterDistance,
-                             m_MaxECLTrackClusterDistance, m_MinPt, m_MinKE, m_addHitsToRecoTrack, m_Hypotheses);
+                             m_MaxECLTrackClusterDistance, m_MinPt, m_MinKE, m_addHitsToRecoTrack, m_Hypotheses,
+                             m_FastExtrapolation);
   return;
 }
 
@@ -153,6 +153,9 @@ namespace Belle2 {
     /// Maximal size of SegmentNetwork; if exceeded, filling of SegmentNetwork will be stopped and the event skipped.
     unsigned short m_PARAMmaxNetworkSize = 40000;
 
+    /// If true, the SegmentNetwork is capped at m_PARAMmaxNetworkSize and the truncated network is kept instead of skipping the event.
+    bool m_PARAMtruncateNetwork = true;
+
     /// Maximal number of Segment connections; if exceeded, filling of SegmentNetwork will be stopped and the event skipped.
     unsigned int m_PARAMmaxSegmentConnections = 30000;
 
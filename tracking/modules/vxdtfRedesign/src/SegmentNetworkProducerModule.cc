@@ -79,9 +79,15 @@ SegmentNetworkProducerModule::SegmentNetworkProducerModule() : Module()
 
   addParam("maxNetworkSize",
            m_PARAMmaxNetworkSize,
-           "Maximal size of the SegmentNetwork; if exceeded, the event execution will be skipped.",
+           "Maximal size of the SegmentNetwork; if exceeded, the network is truncated or the event execution is skipped (see truncateNetwork).",
            m_PARAMmaxNetworkSize);
 
+  addParam("truncateNetwork",
+           m_PARAMtruncateNetwork,
+           "If true, the SegmentNetwork stops growing when reaching maxNetworkSize, and the network built so far is kept "
+           "for the track finding. If false, the network is cleared and the event is skipped.",
+           m_PARAMtruncateNetwork);
+
   addParam("maxConnections",
            m_PARAMmaxSegmentConnections ,
            "Maximal number of Segment connections; if exceeded, the event execution will be skipped.",
@@ -419,6 +425,11 @@ void SegmentNetworkProducerModule::buildSegmentNetwork()
   DirectedNodeNetwork<Segment<Belle2::TrackNode>, CACell>& segmentNetwork = m_network->accessSegmentNetwork();
   std::deque<Belle2::Segment<Belle2::TrackNode>>& segments = m_network->accessSegments();
   unsigned int nLinked = 0, nAdded = 0;
+  bool wasTruncated = false;
+
+  if (m_PARAMtruncateNetwork) {
+    segmentNetwork.setMaxNodes(m_PARAMmaxNetworkSize);
+  }
 
   for (DirectedNode<TrackNode, VoidMetaInfo>* outerHit : hitNetwork.getNodes()) {
     const vector<DirectedNode<TrackNode, VoidMetaInfo>*>& centerHits = outerHit->getInnerNodes();
@@ -472,6 +483,18 @@ void SegmentNetworkProducerModule::buildSegmentNetwork()
 
         std::int64_t innerSegmentID = static_cast<std::int64_t>(centerHit->getEntry().getID()) << 32 | static_cast<std::int64_t>
                                       (innerHit->getEntry().getID());
+        std::int64_t outerSegmentID = static_cast<std::int64_t>(outerHit->getEntry().getID()) << 32 | static_cast<std::int64_t>
+                                      (centerHit->getEntry().getID());
+
+        // if the network is capped, only accept combinations for which both segments still fit into the network
+        if (m_PARAMtruncateNetwork) {
+          const unsigned int nNewSegments = (segmentNetwork.isNodeInNetwork(innerSegmentID) ? 0 : 1) +
+                                            (segmentNetwork.isNodeInNetwork(outerSegmentID) ? 0 : 1);
+          if (segmentNetwork.size() + nNewSegments > m_PARAMmaxNetworkSize) {
+            wasTruncated = true;
+            continue;
+          }
+        }
 
         if (not segmentNetwork.isNodeInNetwork(innerSegmentID)) {
           // create innerSegment first (order of storage in vector<segments> is irrelevant):
@@ -482,8 +505,6 @@ void SegmentNetworkProducerModule::buildSegmentNetwork()
           segmentNetwork.addNode(innerSegmentID, segments.back());
         }
 
-        std::int64_t outerSegmentID = static_cast<std::int64_t>(outerHit->getEntry().getID()) << 32 | static_cast<std::int64_t>
-                                      (centerHit->getEntry().getID());
         if (not segmentNetwork.isNodeInNetwork(outerSegmentID)) {
           segments.emplace_back(outerHit->getEntry().m_sector->getFullSecID(),
                                 centerHit->getEntry().m_sector->getFullSecID(),
@@ -523,7 +544,7 @@ void SegmentNetworkProducerModule::buildSegmentNetwork()
           m_network->clear();
           return;
         }
-        if (segments.size() > m_PARAMmaxNetworkSize) {
+        if (not m_PARAMtruncateNetwork and segments.size() > m_PARAMmaxNetworkSize) {
           B2WARNING("SegmentNetwork size exceeds the limit of " << m_PARAMmaxNetworkSize
                     << ". Network size is " << segmentNetwork.size()
                     << ". VXDTF2 will abort the processing ot the event and the SegmentNetwork is cleared.");
@@ -539,6 +560,12 @@ void SegmentNetworkProducerModule::buildSegmentNetwork()
   m_network->set_segmentConnections(nLinked);
   m_network->set_segmentAddedConnections(nAdded);
 
+  if (wasTruncated) {
+    B2WARNING("SegmentNetwork size reached the limit of " << m_PARAMmaxNetworkSize
+              << ". VXDTF2 continues with the truncated SegmentNetwork.");
+    m_eventLevelTrackingInfo->setVXDTF2AbortionFlag();
+  }
+
   if (m_PARAMprintNetworks) {
     std::string fileName = m_vxdtfFilters->getConfig().secMapName + "_Segment_Ev" + std::to_string(m_eventCounter);
     DNN::printNetwork<Segment<Belle2::TrackNode>, CACell>(segmentNetwork, fileName);
@@ -6,6 +6,7 @@
  * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
  **************************************************************************/
 
+#include <framework/core/EventTimeBudget.h>
 #include <framework/logging/Logger.h>
 #include <framework/geometry/BFieldManager.h>
 
@@ -143,6 +144,13 @@ void TrackFinderVXDCellOMatModule::event()
     m_sptcSelector->prepareSelector(nFamilies);
   }
 
+  /// the path collection can explode in busy events, so give up if the time budget of the event is exceeded
+  if (EventTimeBudget::isExceeded()) {
+    B2WARNING("Time budget of the event exceeded, VXDCellOMat aborts the event.");
+    m_eventLevelTrackingInfo->setVXDTF2AbortionFlag();
+    return;
+  }
+
   /// collect all Paths starting from a Seed:
   m_collectedPaths.clear();
   if (not m_pathCollector.findPaths(segmentNetwork, m_collectedPaths, m_PARAMmaxPaths, m_PARAMstoreSubsets)) {
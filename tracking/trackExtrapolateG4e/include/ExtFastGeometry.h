@@ -0,0 +1,237 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+#pragma once
+
+/* Tracking headers. */
+#include <tracking/dataobjects/ExtHit.h>
+
+/* Belle 2 headers. */
+#include <arich/dbobjects/ARICHGeometryConfig.h>
+#include <framework/database/DBObjPtr.h>
+#include <framework/gearbox/Const.h>
+#include <structure/dbobjects/COILGeometryPar.h>
+#include <top/dbobjects/TOPGeometry.h>
+
+/* Geant4 headers. */
+#include <G4ThreeVector.hh>
+
+/* C++ headers. */
+#include <vector>
+
+namespace Belle2 {
+
+  /**
+   * Simplified detector geometry for the fast track extrapolation.
+   *
+   * TOP quartz bars are boxes, the ARICH aerogel image plate is an annulus between two planes
+   * of constant z, the ECL is the union of the barrel shell and the two endcap disks that enclose
+   * its crystals, the solenoid is a cylindrical shell and the KLM iron is an octagonal barrel
+   * shell and two endcap disks with the iron averaged over the gaps.
+   * All positions are in cm (genfit2 units).
+   */
+  class ExtFastGeometry {
+
+  public:
+
+    //! Crossing of a straight step with the boundary of a detector volume
+    struct Crossing {
+      //! Detector whose volume is entered or left
+      Const::EDetector detector;
+      //! Copy number of the volume, same meaning as in the geant4e extrapolation
+      int copyID;
+      //! EXT_ENTER or EXT_EXIT
+      ExtHitStatus status;
+      //! Fraction of the step at which the boundary is crossed
+      double fraction;
+    };
+
+    //! Material of the simplified geometry
+    struct Material {
+      //! Radiation length (cm), 0 for vacuum
+      double radiationLength;
+      //! Mean energy loss of a minimum-ionizing particle (GeV/cm)
+      double dEdx;
+    };
+
+    //! Constructor
+    ExtFastGeometry();
+
+    //! Read the simplified geometry from the geometry payloads and the ECL crystal positions
+    //! (requires that the detector geometry has been built).
+    void initialize();
+
+    //! Find the boundaries of TOP, ARICH and ECL volumes crossed by the straight step
+    //! from prePos to postPos (cm), ordered along the step
+    void findCrossings(const G4ThreeVector& prePos, const G4ThreeVector& postPos,
+                       std::vector<Crossing>& crossings) const;
+
+    //! Get the material at a position (cm)
+    Material getMaterial(const G4ThreeVector& position) const;
+
+  private:
+
+    //! Box of a TOP quartz bar
+    struct TOPBar {
+      //! Module ID
+      int moduleID;
+      //! Local x axis expressed in the Belle II frame
+      G4ThreeVector xAxis;
+      //! Local y axis expressed in the Belle II frame
+      G4ThreeVector yAxis;
+      //! Local z axis expressed in the Belle II frame
+      G4ThreeVector zAxis;
+      //! Bar center in the Belle II frame (cm)
+      G4ThreeVector center;
+      //! Half-width (cm)
+      double halfWidth;
+      //! Half-thickness (cm)
+      double halfThickness;
+      //! Half-length (cm)
+      double halfLength;
+    };
+
+    //! Transform a point to the local frame of a TOP bar
+    G4ThreeVector toTOPLocal(const TOPBar& bar, const G4ThreeVector& position) const
+    {
+      G4ThreeVector d = position - bar.center;
+      return G4ThreeVector(d * bar.xAxis, d * bar.yAxis, d * bar.zAxis);
+    }
+
+    //! Is the point inside a TOP bar?
+    bool isInsideTOP(const G4ThreeVector& position) const;
+
+    //! Is the point inside the ECL?
+    bool isInsideECL(const G4ThreeVector& position) const;
+
+    //! Get the 0-based ECL cell ID of the crystal nearest to the point
+    int getECLCell(const G4ThreeVector& position) const;
+
+    //! Find the TOP crossings of the step
+    void findTOPCrossings(const G4ThreeVector&, const G4ThreeVector&, std::vector<Crossing>&) const;
+
+    //! Find the ARICH crossings of the step
+    void findARICHCrossings(const G4ThreeVector&, const G4ThreeVector&, std::vector<Crossing>&) const;
+
+    //! Find the ECL crossings of the step
+    void findECLCrossings(const G4ThreeVector&, const G4ThreeVector&, std::vector<Crossing>&) const;
+
+    //! Half-length (cm) of an ECL crystal
+    static constexpr double c_ECLCrystalHalfLength = 15.0;
+
+    //! Tolerance (cm) of the ECL volume perpendicular to the crystal axes
+    static constexpr double c_ECLTolerance = 3.0;
+
+    //! TOP bars
+    std::vector<TOPBar> m_TOPBars;
+
+    //! Minimum radius (cm) of the TOP bars
+    double m_TOPMinR;
+
+    //! Maximum radius (cm) of the TOP bars
+    double m_TOPMaxR;
+
+    //! z (cm) of the upstream face of the ARICH aerogel image plate
+    double m_ARICHEnterZ;
+
+    //! z (cm) of the downstream face of the ARICH aerogel image plate
+    double m_ARICHExitZ;
+
+    //! Inner radius (cm) of the ARICH aerogel image plate
+    double m_ARICHMinR;
+
+    //! Outer radius (cm) of the ARICH aerogel image plate
+    double m_ARICHMaxR;
+
+    //! Inner radius (cm) of the ECL barrel
+    double m_ECLBarrelMinR;
+
+    //! Outer radius (cm) of the ECL barrel
+    double m_ECLBarrelMaxR;
+
+    //! Minimum z (cm) of the ECL barrel
+    double m_ECLBarrelMinZ;
+
+    //! Maximum z (cm) of the ECL barrel
+    double m_ECLBarrelMaxZ;
+
+    //! Inner radius (cm) of the ECL endcaps (0 = forward, 1 = backward)
+    double m_ECLEndcapMinR[2];
+
+    //! Outer radius (cm) of the ECL endcaps (0 = forward, 1 = backward)
+    double m_ECLEndcapMaxR[2];
+
+    //! Minimum z (cm) of the ECL endcaps (0 = forward, 1 = backward)
+    double m_ECLEndcapMinZ[2];
+
+    //! Maximum z (cm) of the ECL endcaps (0 = forward, 1 = backward)
+    double m_ECLEndcapMaxZ[2];
+
+    //! Polar angle of each ECL theta ring, increasing with the ring number
+    std::vector<double> m_ECLRingTheta;
+
+    //! Azimuthal angle of the first crystal of each ECL theta ring
+    std::vector<double> m_ECLRingPhi0;
+
+    //! Signed azimuthal step between neighbouring crystals of each ECL theta ring
+    std::vector<double> m_ECLRingDPhi;
+
+    //! Number of crystals in each ECL theta ring
+    std::vector<int> m_ECLRingNPhi;
+
+    //! 0-based cell ID of the first crystal of each ECL theta ring
+    std::vector<int> m_ECLRingFirstCell;
+
+    //! Inner radius (cm) of the solenoid
+    double m_CoilMinR;
+
+    //! Outer radius (cm) of the solenoid
+    double m_CoilMaxR;
+
+    //! Minimum z (cm) of the solenoid
+    double m_CoilMinZ;
+
+    //! Maximum z (cm) of the solenoid
+    double m_CoilMaxZ;
+
+    //! offset (cm) along z axis of KLM midpoint from IP
+    double m_KLMOffsetZ;
+
+    //! Inner radius (cm) of the barrel KLM iron
+    double m_KLMBarrelMinR;
+
+    //! Outer radius (cm) of the barrel KLM iron
+    double m_KLMBarrelMaxR;
+
+    //! Half-length (cm) of the barrel KLM
+    double m_KLMBarrelHalfLength;
+
+    //! Inner radius (cm) of the endcap KLM
+    double m_KLMEndcapMinR;
+
+    //! Outer radius (cm) of the endcap KLM
+    double m_KLMEndcapMaxR;
+
+    //! Length (cm) of an endcap KLM
+    double m_KLMEndcapLength;
+
+    //! Fraction of the KLM volume filled with iron
+    double m_KLMIronFraction;
+
+    //! Conditions-database object for TOP geometry
+    DBObjPtr<TOPGeometry> m_TOPGeometry;
+
+    //! Conditions-database object for ARICH geometry
+    DBObjPtr<ARICHGeometryConfig> m_ARICHGeometry;
+
+    //! Conditions-database object for COIL geometry
+    DBObjPtr<COILGeometryPar> m_COILGeometryPar;
+
+  };
+
+} // end of namespace Belle2
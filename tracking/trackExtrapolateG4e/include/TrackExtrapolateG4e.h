@@ -47,6 +47,7 @@ class G4StepPoint;
 namespace Belle2 {
 
   class ECLCluster;
+  class ExtFastGeometry;
   class KLMCluster;
   class KLMMuidHit;
   class KLMMuidLikelihood;
@@ -148,6 +149,20 @@ namespace Belle2 {
     double chi2;
   };
 
+  //! ECLCluster-Track and KLMCluster-Track matching of one muid-extrapolated track
+  struct ClusterMatching {
+    //! closest distance (mm) between the track and each ECLCluster
+    std::vector<double> eclClusterDistance;
+    //! crossing of the track with the sphere through each ECLCluster (EXT_ECLCROSS)
+    std::vector<ExtHit> eclHit1;
+    //! closest approach of the track to the radial line to each ECLCluster (EXT_ECLDL)
+    std::vector<ExtHit> eclHit2;
+    //! closest approach of the track to each ECLCluster (EXT_ECLNEAR)
+    std::vector<ExtHit> eclHit3;
+    //! separation between the track and each KLMCluster
+    std::vector<TrackClusterSeparation> klmHit;
+  };
+
   /**
    * geant4e-based track extrapolation.
    *
@@ -161,6 +176,9 @@ namespace Belle2 {
    * the ExtModule's so-named functions - but also has an entry that can be
    * called to extrapolate a single user-defined track.
    *
+   * Optionally, the tracks are extrapolated by a fast analytic helix propagation
+   * in a simplified geometry (ExtFastGeometry) instead of geant4e.
+   *
    */
   class TrackExtrapolateG4e {
 
@@ -176,9 +194,10 @@ namespace Belle2 {
      @param minPt Minimum transverse momentum to begin extrapolation (GeV/c).
      @param minKE Minimum kinetic energy to continue extrapolation (GeV/c).
      @param hypotheses Vector of charged-particle hypotheses used in extrapolation of each track.
+     @param fastExtrapolation Use the fast extrapolation in the simplified geometry instead of geant4e.
     */
     void initialize(double minPt, double minKE,
-                    std::vector<Const::ChargedStable>& hypotheses);
+                    std::vector<Const::ChargedStable>& hypotheses, bool fastExtrapolation = false);
 
     /** Initialize for track extrapolation by the MUID module.
      @param meanDt Mean value of the in-time window (ns).
@@ -190,10 +209,12 @@ namespace Belle2 {
      @param minKE Minimum kinetic energy to continue extrapolation (GeV/c).
      @param addHitsToRecoTrack Parameter to add the found hits also to the reco tracks or not. Is turned off by default.
      @param hypotheses Vector of charged-particle hypotheses used in extrapolation of each track.
+     @param fastExtrapolation Use the fast extrapolation in the simplified geometry instead of geant4e.
     */
     void initialize(double meanDt, double maxDt, double maxSeparation,
                     double maxKLMTrackClusterDistance, double maxECLTrackClusterDistance,
-                    double minPt, double minKE, bool addHitsToRecoTrack, std::vector<Const::ChargedStable>& hypotheses);
+                    double minPt, double minKE, bool addHitsToRecoTrack, std::vector<Const::ChargedStable>& hypotheses,
+                    bool fastExtrapolation = false);
 
     //! Perform beginning-of-run actions.
     //! @param flag True if called by Muid module, false if called by Ext module.
@@ -254,6 +275,37 @@ namespace Belle2 {
     //! Swim a single track (EXT) until it stops or leaves the target cylinder
     void swim(ExtState&, G4ErrorFreeTrajState&);
 
+    //! Swim a single track (MUID) with the fast extrapolation until it stops or leaves the target cylinder
+    void swimFast(ExtState&, G4ErrorFreeTrajState&,
+                  const std::vector<std::pair<ECLCluster*, G4ThreeVector> >*,
+                  const std::vector<std::pair<KLMCluster*, G4ThreeVector> >*,
+                  std::vector<std::map<const Track*, double> >*);
+
+    //! Swim a single track (EXT) with the fast extrapolation until it stops or leaves the target cylinder
+    void swimFast(ExtState&, G4ErrorFreeTrajState&);
+
+    //! Propagate the track by one step of the fast extrapolation, returns false if the particle stopped
+    bool stepFast(G4ErrorFreeTrajState&, double, double, G4ErrorSymMatrix&, double&, double&);
+
+    //! Prepare the ECLCluster-Track and KLMCluster-Track matching of a track (MUID)
+    void initClusterMatching(const ExtState&,
+                             const std::vector<std::pair<ECLCluster*, G4ThreeVector> >*,
+                             const std::vector<std::pair<KLMCluster*, G4ThreeVector> >*,
+                             ClusterMatching&);
+
+    //! Update the ECLCluster-Track and KLMCluster-Track matching with one extrapolation step (MUID)
+    void matchClusters(const ExtState&, const G4ErrorFreeTrajState&,
+                       const G4ThreeVector&, const G4ThreeVector&, const G4ThreeVector&, double, double,
+                       const std::vector<std::pair<ECLCluster*, G4ThreeVector> >*,
+                       const std::vector<std::pair<KLMCluster*, G4ThreeVector> >*,
+                       ClusterMatching&);
+
+    //! Store the ECLCluster-Track and KLMCluster-Track matching of a track after its extrapolation (MUID)
+    void storeClusterMatching(const ExtState&,
+                              const std::vector<std::pair<ECLCluster*, G4ThreeVector> >*,
+                              const std::vector<std::pair<KLMCluster*, G4ThreeVector> >*,
+                              const ClusterMatching&);
+
     //! Register the list of geant4 physical volumes whose entry/exit
     //! points will be saved during extrapolation
     void registerVolumes();
@@ -276,12 +328,17 @@ namespace Belle2 {
     //! Create another EXT extrapolation hit for a track candidate
     void createExtHit(ExtHitStatus, const ExtState&, const G4ErrorFreeTrajState&, const G4StepPoint*, const G4TouchableHandle&);
 
+    //! Create another EXT extrapolation hit for a track candidate in the fast extrapolation
+    void createFastExtHit(ExtHitStatus, const ExtState&, Const::EDetector, int, double,
+                          const G4ThreeVector&, const G4ThreeVector&, const G4ErrorSymMatrix&);
+
     //! Create another EXT ECL-crystal-crossing hit for a track candidate
     void createECLHit(const ExtState&, const G4ErrorFreeTrajState&, const G4StepPoint*, const G4StepPoint*, const G4TouchableHandle&,
                       const std::pair<ECLCluster*, G4ThreeVector>&, double, double);
 
     //! Create another MUID extrapolation hit for a track candidate
-    bool createMuidHit(ExtState&, G4ErrorFreeTrajState&, KLMMuidLikelihood*, std::vector<std::map<const Track*, double> >*);
+    bool createMuidHit(ExtState&, G4ErrorFreeTrajState&, const G4ThreeVector&, G4VPhysicalVolume*, KLMMuidLikelihood*,
+                       std::vector<std::map<const Track*, double> >*);
 
     //! Find the intersection point of the track with the crossed BKLM plane
     bool findBarrelIntersection(ExtState&, const G4ThreeVector&, Intersection&);
@@ -289,6 +346,9 @@ namespace Belle2 {
     //! Find the intersection point of the track with the crossed EKLM plane
     bool findEndcapIntersection(ExtState&, const G4ThreeVector&, Intersection&);
 
+    //! Sort the in-time KLM 2D hits of the event by layer for the hit matching
+    void fillKLMHitLists();
+
     //! Find the matching BKLM 2D hit nearest the intersection point of the track with the crossed BKLM plane
     bool findMatchingBarrelHit(Intersection&, const Track*);
 
@@ -310,6 +370,12 @@ namespace Belle2 {
     //! Flag to indicate that MUID initialize() has been called
     bool m_MuidInitialized;
 
+    //! Flag to use the fast extrapolation for EXT
+    bool m_FastExt;
+
+    //! Flag to use the fast extrapolation for MUID
+    bool m_FastMuid;
+
     //! Mean hit - trigger time (ns)
     double m_MeanDt;
 
@@ -337,6 +403,9 @@ namespace Belle2 {
     //! Pointer to the ExtManager singleton
     Simulation::ExtManager* m_ExtMgr;
 
+    //! Simplified geometry for the fast extrapolation
+    ExtFastGeometry* m_FastGeometry;
+
     //!  ChargedStable hypotheses for EXT
     const std::vector<Const::ChargedStable>* m_HypothesesExt;
 
@@ -464,6 +533,12 @@ namespace Belle2 {
     //! EKLM 2d hits
     StoreArray<EKLMHit2d> m_eklmHit2ds;
 
+    //! Indices of the in-time BKLM 2d hits in each barrel layer (refilled for each event)
+    std::vector<std::vector<int> > m_bklmLayerHits;
+
+    //! Indices of the in-time EKLM 2d hits in each endcap section and layer (refilled for each event)
+    std::vector<std::vector<int> > m_eklmLayerHits;
+
     //! KLM clusters
     StoreArray<KLMCluster> m_klmClusters;
 
@@ -0,0 +1,387 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+
+/* Own header. */
+#include <tracking/trackExtrapolateG4e/ExtFastGeometry.h>
+
+/* Belle 2 headers. */
+#include <ecl/geometry/ECLGeometryPar.h>
+#include <framework/logging/Logger.h>
+#include <klm/bklm/geometry/GeometryPar.h>
+#include <klm/eklm/geometry/GeometryData.h>
+
+/* CLHEP headers. */
+#include <CLHEP/Units/SystemOfUnits.h>
+
+/* ROOT headers. */
+#include <TVector3.h>
+
+/* C++ headers. */
+#include <algorithm>
+#include <cmath>
+
+#define NCRYSTAL_ECL 8736
+#define NCRYSTAL_ECL_FORWARD 1152
+#define NCRYSTAL_ECL_FORWARD_BARREL 7776
+#define NBISECTION 12
+
+using namespace Belle2;
+
+namespace {
+
+  //! Material of the TOP quartz bars
+  const ExtFastGeometry::Material c_Quartz = {12.29, 3.74E-3};
+
+  //! Material of the ECL crystals
+  const ExtFastGeometry::Material c_CsI = {1.86, 5.61E-3};
+
+  //! Material of the solenoid
+  const ExtFastGeometry::Material c_Aluminium = {8.897, 4.36E-3};
+
+  //! Radiation length (cm) of the KLM iron
+  const double c_IronRadiationLength = 1.757;
+
+  //! Energy loss (GeV/cm) of a minimum-ionizing particle in the KLM iron
+  const double c_IronDEdx = 11.43E-3;
+
+  //! Wrap an azimuthal angle difference into [-pi, pi)
+  double wrapPhi(double dPhi)
+  {
+    return dPhi - 2.0 * M_PI * std::floor((dPhi + M_PI) / (2.0 * M_PI));
+  }
+
+}
+
+ExtFastGeometry::ExtFastGeometry() :
+  m_TOPMinR(0.0), // initialized later
+  m_TOPMaxR(0.0), // initialized later
+  m_ARICHEnterZ(0.0), // initialized later
+  m_ARICHExitZ(0.0), // initialized later
+  m_ARICHMinR(0.0), // initialized later
+  m_ARICHMaxR(0.0), // initialized later
+  m_ECLBarrelMinR(0.0), // initialized later
+  m_ECLBarrelMaxR(0.0), // initialized later
+  m_ECLBarrelMinZ(0.0), // initialized later
+  m_ECLBarrelMaxZ(0.0), // initialized later
+  m_CoilMinR(0.0), // initialized later
+  m_CoilMaxR(0.0), // initialized later
+  m_CoilMinZ(0.0), // initialized later
+  m_CoilMaxZ(0.0), // initialized later
+  m_KLMOffsetZ(0.0), // initialized later
+  m_KLMBarrelMinR(0.0), // initialized later
+  m_KLMBarrelMaxR(0.0), // initialized later
+  m_KLMBarrelHalfLength(0.0), // initialized later
+  m_KLMEndcapMinR(0.0), // initialized later
+  m_KLMEndcapMaxR(0.0), // initialized later
+  m_KLMEndcapLength(0.0), // initialized later
+  m_KLMIronFraction(0.0) // initialized later
+{
+  for (int j = 0; j < 2; ++j) {
+    m_ECLEndcapMinR[j] = 0.0;
+    m_ECLEndcapMaxR[j] = 0.0;
+    m_ECLEndcapMinZ[j] = 0.0;
+    m_ECLEndcapMaxZ[j] = 0.0;
+  }
+}
+
+void ExtFastGeometry::initialize()
+{
+
+  // TOP: one box per module that covers the quartz bar, the mirror segment is included
+  // in the bar length while the prism is ignored
+  m_TOPBars.clear();
+  m_TOPMinR = 0.0;
+  m_TOPMaxR = 0.0;
+  if (m_TOPGeometry.isValid()) {
+    TOPGeometry::useBasf2Units();
+    m_TOPMinR = 1.0E10;
+    for (const auto& module : m_TOPGeometry->getModules()) {
+      // local = R^-1 * global + c: the rows of R^-1 are the local axes in the Belle II frame
+      TVector3 c = module.pointToLocal(TVector3(0.0, 0.0, 0.0));
+      TVector3 ex = module.momentumToLocal(TVector3(1.0, 0.0, 0.0));
+      TVector3 ey = module.momentumToLocal(TVector3(0.0, 1.0, 0.0));
+      TVector3 ez = module.momentumToLocal(TVector3(0.0, 0.0, 1.0));
+      TOPBar bar;
+      bar.moduleID = module.getModuleID();
+      bar.xAxis.set(ex.X(), ey.X(), ez.X());
+      bar.yAxis.set(ex.Y(), ey.Y(), ez.Y());
+      bar.zAxis.set(ex.Z(), ey.Z(), ez.Z());
+      bar.center = -(c.X() * bar.xAxis + c.Y() * bar.yAxis + c.Z() * bar.zAxis);
+      bar.halfWidth = 0.5 * module.getBarWidth();
+      bar.halfThickness = 0.5 * module.getBarThickness();
+      bar.halfLength = 0.5 * module.getBarLength();
+      m_TOPBars.push_back(bar);
+      double rMin = module.getInnerRadius();
+      double rMax = std::hypot(module.getRadius() + bar.halfThickness, bar.halfWidth);
+      m_TOPMinR = std::min(m_TOPMinR, rMin - 1.0); // allow for the alignment
+      m_TOPMaxR = std::max(m_TOPMaxR, rMax + 1.0);
+    }
+  } else {
+    B2WARNING("TOP geometry data are not available: no TOP hits from the fast extrapolation.");
+  }
+
+  // ARICH: the aerogel image plate is placed at the downstream side of the aerogel plane
+  m_ARICHEnterZ = 0.0;
+  m_ARICHExitZ = 0.0;
+  m_ARICHMinR = 0.0;
+  m_ARICHMaxR = 0.0;
+  if (m_ARICHGeometry.isValid()) {
+    ARICHGeometryConfig::useBasf2Units();
+    const ARICHGeoAerogelPlane& aerogelPlane = m_ARICHGeometry->getAerogelPlane();
+    double z = m_ARICHGeometry->getMasterVolume().getPosition().Z() + aerogelPlane.getPosition().Z()
+               + 0.5 * (aerogelPlane.getWallHeight() + aerogelPlane.getSupportThickness());
+    double halfThickness = 0.5 * aerogelPlane.getImgTubeThickness();
+    m_ARICHEnterZ = z - halfThickness;
+    m_ARICHExitZ = z + halfThickness;
+    m_ARICHMinR = aerogelPlane.getSupportInnerR();
+    m_ARICHMaxR = aerogelPlane.getSupportOuterR();
+  } else {
+    B2WARNING("ARICH geometry data are not available: no ARICH hits from the fast extrapolation.");
+  }
+
+  // ECL: envelopes of the crystals (front and back faces of the crystals) and the theta rings
+  ECL::ECLGeometryPar* eclGeometry = ECL::ECLGeometryPar::Instance();
+  m_ECLBarrelMinR = m_ECLEndcapMinR[0] = m_ECLEndcapMinR[1] = 1.0E10;
+  m_ECLBarrelMinZ = m_ECLEndcapMinZ[0] = m_ECLEndcapMinZ[1] = 1.0E10;
+  m_ECLBarrelMaxR = m_ECLEndcapMaxR[0] = m_ECLEndcapMaxR[1] = -1.0E10;
+  m_ECLBarrelMaxZ = m_ECLEndcapMaxZ[0] = m_ECLEndcapMaxZ[1] = -1.0E10;
+  m_ECLRingTheta.clear();
+  m_ECLRingPhi0.clear();
+  m_ECLRingDPhi.clear();
+  m_ECLRingNPhi.clear();
+  m_ECLRingFirstCell.clear();
+  std::vector<double> ringPhi1;
+  for (int cid = 0; cid < NCRYSTAL_ECL; ++cid) {
+    TVector3 center = eclGeometry->GetCrystalPos(cid);
+    TVector3 axis = eclGeometry->GetCrystalVec(cid).Unit();
+    TVector3 front = center - c_ECLCrystalHalfLength * axis;
+    TVector3 back = center + c_ECLCrystalHalfLength * axis;
+    if (cid >= NCRYSTAL_ECL_FORWARD && cid < NCRYSTAL_ECL_FORWARD_BARREL) {
+      m_ECLBarrelMinR = std::min(m_ECLBarrelMinR, std::min(front.Perp(), back.Perp()));
+      m_ECLBarrelMaxR = std::max(m_ECLBarrelMaxR, std::max(front.Perp(), back.Perp()));
+      m_ECLBarrelMinZ = std::min(m_ECLBarrelMinZ, std::min(front.Z(), back.Z()) - c_ECLTolerance);
+      m_ECLBarrelMaxZ = std::max(m_ECLBarrelMaxZ, std::max(front.Z(), back.Z()) + c_ECLTolerance);
+    } else {
+      int j = (cid < NCRYSTAL_ECL_FORWARD) ? 0 : 1;
+      m_ECLEndcapMinR[j] = std::min(m_ECLEndcapMinR[j], std::min(front.Perp(), back.Perp()) - c_ECLTolerance);
+      m_ECLEndcapMaxR[j] = std::max(m_ECLEndcapMaxR[j], std::max(front.Perp(), back.Perp()) + c_ECLTolerance);
+      m_ECLEndcapMinZ[j] = std::min(m_ECLEndcapMinZ[j], std::min(front.Z(), back.Z()));
+      m_ECLEndcapMaxZ[j] = std::max(m_ECLEndcapMaxZ[j], std::max(front.Z(), back.Z()));
+    }
+    eclGeometry->Mapping(cid);
+    int thetaID = eclGeometry->GetThetaID();
+    int phiID = eclGeometry->GetPhiID();
+    if (thetaID >= int(m_ECLRingTheta.size())) {
+      m_ECLRingTheta.resize(thetaID + 1, 0.0);
+      m_ECLRingPhi0.resize(thetaID + 1, 0.0);
+      m_ECLRingDPhi.resize(thetaID + 1, 0.0);
+      m_ECLRingNPhi.resize(thetaID + 1, 0);
+      m_ECLRingFirstCell.resize(thetaID + 1, 0);
+      ringPhi1.resize(thetaID + 1, 0.0);
+    }
+    m_ECLRingTheta[thetaID] += center.Theta();
+    m_ECLRingNPhi[thetaID]++;
+    if (phiID == 0) {
+      m_ECLRingPhi0[thetaID] = center.Phi();
+      m_ECLRingFirstCell[thetaID] = cid;
+    } else if (phiID == 1) {
+      ringPhi1[thetaID] = center.Phi();
+    }
+  }
+  for (unsigned int ring = 0; ring < m_ECLRingTheta.size(); ++ring) {
+    m_ECLRingTheta[ring] /= m_ECLRingNPhi[ring];
+    double dPhi = 2.0 * M_PI / m_ECLRingNPhi[ring];
+    m_ECLRingDPhi[ring] = (wrapPhi(ringPhi1[ring] - m_ECLRingPhi0[ring]) < 0.0) ? -dPhi : dPhi;
+  }
+
+  // Solenoid: the superconducting coil (the rest of the cryostat is vacuum)
+  if (!m_COILGeometryPar.isValid())
+    B2FATAL("Coil geometry data are not available.");
+  m_CoilMinR = m_COILGeometryPar->getCoilRmin() / CLHEP::cm;
+  m_CoilMaxR = m_COILGeometryPar->getCoilRmax() / CLHEP::cm;
+  m_CoilMinZ = (m_COILGeometryPar->getGlobalOffsetZ() - m_COILGeometryPar->getCoilLength()) / CLHEP::cm;
+  m_CoilMaxZ = (m_COILGeometryPar->getGlobalOffsetZ() + m_COILGeometryPar->getCoilLength()) / CLHEP::cm;
+
+  // KLM: the iron is averaged over the iron plates and the gaps of the barrel
+  bklm::GeometryPar* bklmGeometry = bklm::GeometryPar::instance();
+  const EKLM::GeometryData& eklmGeometry = EKLM::GeometryData::Instance();
+  m_KLMOffsetZ = bklmGeometry->getOffsetZ();
+  m_KLMBarrelMinR = bklmGeometry->getGap1InnerRadius();
+  m_KLMBarrelMaxR = bklmGeometry->getOuterRadius();
+  m_KLMBarrelHalfLength = bklmGeometry->getHalfLength();
+  m_KLMEndcapMinR = eklmGeometry.getSectionPosition()->getInnerR() / CLHEP::cm;
+  m_KLMEndcapMaxR = eklmGeometry.getSectionPosition()->getOuterR() / CLHEP::cm;
+  m_KLMEndcapLength = eklmGeometry.getSectionPosition()->getLength() / CLHEP::cm;
+  m_KLMIronFraction = bklmGeometry->getIronActualHeight() /
+                      (bklmGeometry->getIronActualHeight() + bklmGeometry->getGapActualHeight());
+
+}
+
+void ExtFastGeometry::findCrossings(const G4ThreeVector& prePos, const G4ThreeVector& postPos,
+                                    std::vector<Crossing>& crossings) const
+{
+  crossings.clear();
+  findTOPCrossings(prePos, postPos, crossings);
+  findARICHCrossings(prePos, postPos, crossings);
+  findECLCrossings(prePos, postPos, crossings);
+  std::sort(crossings.begin(), crossings.end(),
+            [](const Crossing & a, const Crossing & b) { return a.fraction < b.fraction; });
+}
+
+ExtFastGeometry::Material ExtFastGeometry::getMaterial(const G4ThreeVector& position) const
+{
+  if (isInsideTOP(position))
+    return c_Quartz;
+  if (isInsideECL(position))
+    return c_CsI;
+  double r = position.perp();
+  double z = position.z();
+  if ((r > m_CoilMinR) && (r < m_CoilMaxR) && (z > m_CoilMinZ) && (z < m_CoilMaxZ))
+    return c_Aluminium;
+  Material iron = {c_IronRadiationLength / m_KLMIronFraction, c_IronDEdx * m_KLMIronFraction};
+  double dz = std::fabs(z - m_KLMOffsetZ);
+  if (dz < m_KLMBarrelHalfLength) {
+    // Distance to the IP of the octagonal barrel sector planes
+    double rSector = 0.0;
+    for (int sector = 0; sector < 8; ++sector) {
+      double phi = M_PI_4 * sector;
+      rSector = std::max(rSector, position.x() * std::cos(phi) + position.y() * std::sin(phi));
+    }
+    if ((rSector > m_KLMBarrelMinR) && (rSector < m_KLMBarrelMaxR))
+      return iron;
+  } else if (dz < m_KLMBarrelHalfLength + m_KLMEndcapLength) {
+    if ((r > m_KLMEndcapMinR) && (r < m_KLMEndcapMaxR))
+      return iron;
+  }
+  Material vacuum = {0.0, 0.0};
+  return vacuum;
+}
+
+bool ExtFastGeometry::isInsideTOP(const G4ThreeVector& position) const
+{
+  double r = position.perp();
+  if ((r < m_TOPMinR) || (r > m_TOPMaxR))
+    return false;
+  for (const TOPBar& bar : m_TOPBars) {
+    G4ThreeVector local = toTOPLocal(bar, position);
+    if ((std::fabs(local.x()) < bar.halfWidth) && (std::fabs(local.y()) < bar.halfThickness) &&
+        (std::fabs(local.z()) < bar.halfLength))
+      return true;
+  }
+  return false;
+}
+
+bool ExtFastGeometry::isInsideECL(const G4ThreeVector& position) const
+{
+  double r = position.perp();
+  double z = position.z();
+  if ((r > m_ECLBarrelMinR) && (r < m_ECLBarrelMaxR) && (z > m_ECLBarrelMinZ) && (z < m_ECLBarrelMaxZ))
+    return true;
+  for (int j = 0; j < 2; ++j) {
+    if ((r > m_ECLEndcapMinR[j]) && (r < m_ECLEndcapMaxR[j]) && (z > m_ECLEndcapMinZ[j]) && (z < m_ECLEndcapMaxZ[j]))
+      return true;
+  }
+  return false;
+}
+
+int ExtFastGeometry::getECLCell(const G4ThreeVector& position) const
+{
+  // Nearest theta ring
+  double theta = position.theta();
+  int ring = std::lower_bound(m_ECLRingTheta.begin(), m_ECLRingTheta.end(), theta) - m_ECLRingTheta.begin();
+  if (ring == int(m_ECLRingTheta.size())) {
+    ring--;
+  } else if ((ring > 0) && (theta - m_ECLRingTheta[ring - 1] < m_ECLRingTheta[ring] - theta)) {
+    ring--;
+  }
+  // Nearest crystal in this ring
+  int nPhi = m_ECLRingNPhi[ring];
+  int phiID = std::lround(wrapPhi(position.phi() - m_ECLRingPhi0[ring]) / m_ECLRingDPhi[ring]);
+  phiID = ((phiID % nPhi) + nPhi) % nPhi;
+  return m_ECLRingFirstCell[ring] + phiID;
+}
+
+void ExtFastGeometry::findTOPCrossings(const G4ThreeVector& prePos, const G4ThreeVector& postPos,
+                                       std::vector<Crossing>& crossings) const
+{
+  double preR = prePos.perp();
+  double postR = postPos.perp();
+  if (std::max(preR, postR) < m_TOPMinR || std::min(preR, postR) > m_TOPMaxR)
+    return;
+  // Slab method in the local frame of each bar
+  for (const TOPBar& bar : m_TOPBars) {
+    G4ThreeVector a = toTOPLocal(bar, prePos);
+    G4ThreeVector d = toTOPLocal(bar, postPos) - a;
+    double tEnter = 0.0;
+    double tExit = 1.0;
+    const double halfSize[3] = {bar.halfWidth, bar.halfThickness, bar.halfLength};
+    for (int k = 0; k < 3; ++k) {
+      if (std::fabs(d[k]) < 1.0E-12) {
+        if (std::fabs(a[k]) >= halfSize[k]) {
+          tEnter = 1.0;
+          tExit = 0.0;
+          break;
+        }
+        continue;
+      }
+      double t1 = (-halfSize[k] - a[k]) / d[k];
+      double t2 = (halfSize[k] - a[k]) / d[k];
+      tEnter = std::max(tEnter, std::min(t1, t2));
+      tExit = std::min(tExit, std::max(t1, t2));
+    }
+    if (tEnter >= tExit)
+      continue;
+    if (tEnter > 0.0)
+      crossings.push_back({Const::EDetector::TOP, bar.moduleID, EXT_ENTER, tEnter});
+    if (tExit < 1.0)
+      crossings.push_back({Const::EDetector::TOP, bar.moduleID, EXT_EXIT, tExit});
+  }
+}
+
+void ExtFastGeometry::findARICHCrossings(const G4ThreeVector& prePos, const G4ThreeVector& postPos,
+                                         std::vector<Crossing>& crossings) const
+{
+  if (m_ARICHMaxR <= 0.0)
+    return;
+  // Only outgoing tracks are of interest for ARICH
+  double dz = postPos.z() - prePos.z();
+  if (dz <= 0.0)
+    return;
+  const double planeZ[2] = {m_ARICHEnterZ, m_ARICHExitZ};
+  const ExtHitStatus status[2] = {EXT_ENTER, EXT_EXIT};
+  for (int j = 0; j < 2; ++j) {
+    if ((prePos.z() >= planeZ[j]) || (postPos.z() < planeZ[j]))
+      continue;
+    double f = (planeZ[j] - prePos.z()) / dz;
+    double r = (prePos + f * (postPos - prePos)).perp();
+    if ((r > m_ARICHMinR) && (r < m_ARICHMaxR))
+      crossings.push_back({Const::EDetector::ARICH, 6789, status[j], f}); // copy number of ARICH.AerogelImgPlate
+  }
+}
+
+void ExtFastGeometry::findECLCrossings(const G4ThreeVector& prePos, const G4ThreeVector& postPos,
+                                       std::vector<Crossing>& crossings) const
+{
+  bool preInside = isInsideECL(prePos);
+  if (preInside == isInsideECL(postPos))
+    return;
+  // Bisection for the boundary on the straight step
+  double fIn = preInside ? 0.0 : 1.0;
+  double fOut = 1.0 - fIn;
+  G4ThreeVector delta = postPos - prePos;
+  for (int j = 0; j < NBISECTION; ++j) {
+    double f = 0.5 * (fIn + fOut);
+    if (isInsideECL(prePos + f * delta)) {
+      fIn = f;
+    } else {
+      fOut = f;
+    }
+  }
+  int cell = getECLCell(prePos + fIn * delta);
+  crossings.push_back({Const::EDetector::ECL, cell, (preInside ? EXT_EXIT : EXT_ENTER), 0.5 * (fIn + fOut)});
+}
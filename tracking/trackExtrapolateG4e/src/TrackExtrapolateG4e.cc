@@ -9,6 +9,9 @@
 /* Own header. */
 #include <tracking/trackExtrapolateG4e/TrackExtrapolateG4e.h>
 
+/* Tracking headers. */
+#include <tracking/trackExtrapolateG4e/ExtFastGeometry.h>
+
 /* Belle 2 headers. */
 #include <ecl/geometry/ECLGeometryPar.h>
 #include <framework/datastore/StoreArray.h>
@@ -64,6 +67,8 @@
 #define PI_8 (0.125*M_PI)
 #define DEPTH_RPC 9
 #define DEPTH_SCINT 11
+#define FASTSTEP_LENGTH (4.0*CLHEP::cm)
+#define MAXSTEP_FAST 2500
 
 using namespace Belle2;
 
@@ -79,6 +84,8 @@ TrackExtrapolateG4e* TrackExtrapolateG4e::getInstance()
 TrackExtrapolateG4e::TrackExtrapolateG4e() :
   m_ExtInitialized(false), // initialized later
   m_MuidInitialized(false), // initialized later
+  m_FastExt(false), // initialized later
+  m_FastMuid(false), // initialized later
   m_MeanDt(0.0), // initialized later
   m_MaxDt(0.0), // initialized later
   m_MagneticField(0.0), // initialized later
@@ -88,6 +95,7 @@ TrackExtrapolateG4e::TrackExtrapolateG4e() :
   m_MinPt(0.0), // initialized later
   m_MinKE(0.0), // initialized later
   m_ExtMgr(nullptr), // initialized later
+  m_FastGeometry(nullptr), // initialized later
   m_HypothesesExt(nullptr), // initialized later
   m_HypothesesMuid(nullptr), // initialized later
   m_DefaultHypotheses(nullptr), // initialized later
@@ -136,9 +144,10 @@ TrackExtrapolateG4e::~TrackExtrapolateG4e()
 
 // Initialize for EXT
 void TrackExtrapolateG4e::initialize(double minPt, double minKE,
-                                     std::vector<Const::ChargedStable>& hypotheses)
+                                     std::vector<Const::ChargedStable>& hypotheses, bool fastExtrapolation)
 {
   m_ExtInitialized = true;
+  m_FastExt = fastExtrapolation;
 
   // Define required objects, register the new ones and relations
   m_recoTracks.isRequired();
@@ -185,15 +194,20 @@ void TrackExtrapolateG4e::initialize(double minPt, double minKE,
     beampipeRadius = m_BeamPipeGeo->getParameter("Lv2OutBe.R2") * CLHEP::cm;
   });
   m_MinRadiusSq = beampipeRadius * beampipeRadius; // mm^2
+
+  // The simplified geometry of the fast extrapolation is read at the beginning of each run
+  if (m_FastExt && (m_FastGeometry == nullptr))
+    m_FastGeometry = new ExtFastGeometry();
 }
 
 // Initialize for MUID
 void TrackExtrapolateG4e::initialize(double meanDt, double maxDt, double maxKLMTrackHitDistance,
                                      double maxKLMTrackClusterDistance, double maxECLTrackClusterDistance,
                                      double minPt, double minKE, bool addHitsToRecoTrack,
-                                     std::vector<Const::ChargedStable>& hypotheses)
+                                     std::vector<Const::ChargedStable>& hypotheses, bool fastExtrapolation)
 {
   m_MuidInitialized = true;
+  m_FastMuid = fastExtrapolation;
   m_addHitsToRecoTrack = addHitsToRecoTrack;
 
   // Define required objects, register the new ones and relations
@@ -330,11 +344,17 @@ void TrackExtrapolateG4e::initialize(double meanDt, double maxDt, double maxKLMT
   }
 
   m_eklmTransformData = &(EKLM::TransformDataGlobalAligned::Instance());
+
+  // The simplified geometry of the fast extrapolation is read at the beginning of each run
+  if (m_FastMuid && (m_FastGeometry == nullptr))
+    m_FastGeometry = new ExtFastGeometry();
 }
 
 void TrackExtrapolateG4e::beginRun(bool byMuid)
 {
   B2DEBUG(20, (byMuid ? "muid" : "ext"));
+  if (m_FastGeometry != nullptr)
+    m_FastGeometry->initialize();
   if (byMuid) {
     if (!m_klmChannelStatus.isValid())
       B2FATAL("KLM channel status data are not available.");
@@ -371,6 +391,7 @@ void TrackExtrapolateG4e::event(bool byMuid)
   // Do extrapolation for each hypothesis of each reconstructed track.
   if (byMuid) { // event() called by Muid module
     G4ErrorPropagatorData::GetErrorPropagatorData()->SetTarget(m_TargetMuid);
+    fillKLMHitLists();
     std::vector<std::pair<ECLCluster*, G4ThreeVector> > eclClusterInfo(m_eclClusters.getEntries());
     for (int c = 0; c < m_eclClusters.getEntries(); ++c) {
       eclClusterInfo[c].first = m_eclClusters[c];
@@ -394,7 +415,11 @@ void TrackExtrapolateG4e::event(bool byMuid)
           pdgCode = -pdgCode;
         G4ErrorFreeTrajState g4eState("g4e_mu+", G4ThreeVector(), G4ThreeVector()); // will be updated
         ExtState extState = getStartPoint(b2track, pdgCode, g4eState);
-        swim(extState, g4eState, &eclClusterInfo, &klmClusterInfo, &bklmHitUsed);
+        // Cosmic rays are back-propagated by geant4e also in the fast mode
+        if (m_FastMuid && !extState.isCosmic)
+          swimFast(extState, g4eState, &eclClusterInfo, &klmClusterInfo, &bklmHitUsed);
+        else
+          swim(extState, g4eState, &eclClusterInfo, &klmClusterInfo, &bklmHitUsed);
       } // Muid hypothesis loop
     } // Muid track loop
   } else { // event() called by Ext module
@@ -405,7 +430,11 @@ void TrackExtrapolateG4e::event(bool byMuid)
         if (hypothesis == Const::electron || hypothesis == Const::muon) pdgCode = -pdgCode;
         G4ErrorFreeTrajState g4eState("g4e_mu+", G4ThreeVector(), G4ThreeVector()); // will be updated
         ExtState extState = getStartPoint(b2track, pdgCode, g4eState);
-        swim(extState, g4eState);
+        // Cosmic rays are back-propagated by geant4e also in the fast mode
+        if (m_FastExt && !extState.isCosmic)
+          swimFast(extState, g4eState);
+        else
+          swim(extState, g4eState);
       } // Ext hypothesis loop
     } // Ext track loop
   } // byMuid
@@ -429,6 +458,10 @@ void TrackExtrapolateG4e::terminate(bool byMuid)
     delete m_TargetExt;
     m_TargetExt = nullptr;
   }
+  if (m_FastGeometry != nullptr) {
+    delete m_FastGeometry;
+    m_FastGeometry = nullptr;
+  }
   if (m_EnterExit != nullptr) {
     delete m_EnterExit;
     delete m_BKLMVolumes;
@@ -532,6 +565,7 @@ void TrackExtrapolateG4e::identifyMuon(int pdgCode, // signed for charge
   ExtState extState = { nullptr, pdgCode, isCosmic, tof, 0.0,                             // for EXT and MUID
                         momentumG4e.unit(), 0.0, 0, 0, 0, -1, -1, -1, -1, 0, 0, false  // for MUID only
                       };
+  fillKLMHitLists();
   swim(extState, g4eState, nullptr, nullptr, nullptr);
 }
 
@@ -550,23 +584,9 @@ void TrackExtrapolateG4e::swim(ExtState& extState, G4ErrorFreeTrajState& g4eStat
   G4ParticleDefinition* particle = G4ParticleTable::GetParticleTable()->FindParticle(extState.pdgCode);
   double mass = particle->GetPDGMass();
   double minPSq = (mass + m_MinKE) * (mass + m_MinKE) - mass * mass;
-  // Create structures for ECLCluster-Track matching
-  std::vector<double> eclClusterDistance;
-  std::vector<ExtHit> eclHit1, eclHit2, eclHit3;
-  if (eclClusterInfo != nullptr) {
-    eclClusterDistance.resize(eclClusterInfo->size(), 1.0E10); // "positive infinity"
-    ExtHit tempExtHit(extState.pdgCode, Const::EDetector::ECL, 0, EXT_FIRST,
-                      extState.isCosmic, 0.0,
-                      G4ThreeVector(), G4ThreeVector(), G4ErrorSymMatrix(6));
-    eclHit1.resize(eclClusterInfo->size(), tempExtHit);
-    eclHit2.resize(eclClusterInfo->size(), tempExtHit);
-    eclHit3.resize(eclClusterInfo->size(), tempExtHit);
-  }
-  // Create structures for KLMCluster-Track matching
-  std::vector<TrackClusterSeparation> klmHit;
-  if (klmClusterInfo != nullptr) {
-    klmHit.resize(klmClusterInfo->size()); // initialize each to huge distance
-  }
+  // Create structures for ECLCluster-Track and KLMCluster-Track matching
+  ClusterMatching clusterMatching;
+  initClusterMatching(extState, eclClusterInfo, klmClusterInfo, clusterMatching);
   KLMMuidLikelihood* klmMuidLikelihood = m_klmMuidLikelihoods.appendNew(); // rest of this object will be filled later
   klmMuidLikelihood->setPDGCode(extState.pdgCode);
   if (extState.track != nullptr)
@@ -611,74 +631,12 @@ void TrackExtrapolateG4e::swim(ExtState& extState, G4ErrorFreeTrajState& g4eStat
           }
         }
       }
-      if (createMuidHit(extState, g4eState, klmMuidLikelihood, bklmHitUsed)) {
+      G4ThreeVector prePos(preStepPoint->GetPosition());
+      if (createMuidHit(extState, g4eState, prePos / CLHEP::cm, track->GetVolume(), klmMuidLikelihood, bklmHitUsed)) {
         // Force geant4e to update its G4Track from the Kalman-updated state
         m_ExtMgr->GetPropagator()->SetStepN(0);
       }
-      if (eclClusterInfo != nullptr) {
-        for (unsigned int c = 0; c < eclClusterInfo->size(); ++c) {
-          G4ThreeVector eclPos((*eclClusterInfo)[c].second);
-          G4ThreeVector prePos(preStepPoint->GetPosition());
-          G4ThreeVector diff(prePos - eclPos);
-          double distance = diff.mag();
-          if (distance < m_MaxECLTrackClusterDistance) {
-            // fallback ECLNEAR in case no ECLCROSS is found
-            if (distance < eclClusterDistance[c]) {
-              eclClusterDistance[c] = distance;
-              G4ErrorSymMatrix covariance(6, 0);
-              fromG4eToPhasespace(g4eState, covariance);
-              eclHit3[c].update(EXT_ECLNEAR, extState.tof, pos / CLHEP::cm, mom / CLHEP::GeV, covariance);
-            }
-            // find position of crossing of the track with the ECLCluster's sphere
-            if (eclHit1[c].getStatus() == EXT_FIRST) {
-              if (pos.mag2() >= eclPos.mag2()) {
-                double r = eclPos.mag();
-                double preD = prePos.mag() - r;
-                double postD = pos.mag() - r;
-                double f = postD / (postD - preD);
-                G4ThreeVector midPos = pos + (prePos - pos) * f;
-                double tof = extState.tof + dt * f * (extState.isCosmic ? +1 : -1); // in ns, at end of step
-                G4ErrorSymMatrix covariance(6, 0);
-                fromG4eToPhasespace(g4eState, covariance);
-                eclHit1[c].update(EXT_ECLCROSS, tof, midPos / CLHEP::cm, mom / CLHEP::GeV, covariance);
-              }
-            }
-          }
-          // find closest distance to the radial line to the ECLCluster
-          if (eclHit2[c].getStatus() == EXT_FIRST) {
-            G4ThreeVector delta(pos - prePos);
-            G4ThreeVector perp(eclPos.cross(delta));
-            double perpMag2 = perp.mag2();
-            if (perpMag2 > 1.0E-10) {
-              double dist = std::fabs(diff * perp) / std::sqrt(perpMag2);
-              if (dist < m_MaxECLTrackClusterDistance) {
-                double f = eclPos * (prePos.cross(perp)) / perpMag2;
-                if ((f > -0.5) && (f <= 1.0)) {
-                  G4ThreeVector midPos(prePos + f * delta);
-                  double length = extState.length + dl * (1.0 - f) * (extState.isCosmic ? +1 : -1);
-                  G4ErrorSymMatrix covariance(6, 0);
-                  fromG4eToPhasespace(g4eState, covariance);
-                  eclHit2[c].update(EXT_ECLDL, length, midPos / CLHEP::cm, mom / CLHEP::GeV, covariance);
-                }
-              }
-            }
-          }
-        }
-      }
-      if (klmClusterInfo != nullptr) {
-        for (unsigned int c = 0; c < klmClusterInfo->size(); ++c) {
-          G4ThreeVector klmPos = (*klmClusterInfo)[c].second;
-          G4ThreeVector separation = klmPos - pos;
-          double distance = separation.mag();
-          if (distance < klmHit[c].getDistance()) {
-            klmHit[c].setDistance(distance);
-            klmHit[c].setTrackClusterAngle(mom.angle(separation));
-            klmHit[c].setTrackClusterSeparationAngle(mom.angle(klmPos));
-            klmHit[c].setTrackRotationAngle(extState.directionAtIP.angle(mom));
-            klmHit[c].setTrackClusterInitialSeparationAngle(extState.directionAtIP.angle(klmPos));
-          }
-        }
-      }
+      matchClusters(extState, g4eState, prePos, pos, mom, dt, dl, eclClusterInfo, klmClusterInfo, clusterMatching);
     }
     // Post-step momentum too low?
     if (errCode || (mom.mag2() < minPSq)) {
@@ -698,20 +656,188 @@ void TrackExtrapolateG4e::swim(ExtState& extState, G4ErrorFreeTrajState& g4eStat
 
   finishTrack(extState, klmMuidLikelihood, (g4eState.GetPosition().z() > m_OffsetZ));
 
+  storeClusterMatching(extState, eclClusterInfo, klmClusterInfo, clusterMatching);
+
+}
+
+// Swim one track for MUID with the fast extrapolation until it stops or leaves the KLM-bounding cylinder
+void TrackExtrapolateG4e::swimFast(ExtState& extState, G4ErrorFreeTrajState& g4eState,
+                                   const std::vector<std::pair<ECLCluster*, G4ThreeVector> >* eclClusterInfo,
+                                   const std::vector<std::pair<KLMCluster*, G4ThreeVector> >* klmClusterInfo,
+                                   std::vector<std::map<const Track*, double> >* bklmHitUsed)
+{
+  if (extState.pdgCode == 0)
+    return;
+  if (g4eState.GetMomentum().perp() <= m_MinPt)
+    return;
+  if (m_TargetMuid->GetDistanceFromPoint(g4eState.GetPosition()) < 0.0)
+    return;
+  G4ParticleDefinition* particle = G4ParticleTable::GetParticleTable()->FindParticle(extState.pdgCode);
+  double mass = particle->GetPDGMass();
+  double charge = particle->GetPDGCharge();
+  double minPSq = (mass + m_MinKE) * (mass + m_MinKE) - mass * mass;
+  // Create structures for ECLCluster-Track and KLMCluster-Track matching
+  ClusterMatching clusterMatching;
+  initClusterMatching(extState, eclClusterInfo, klmClusterInfo, clusterMatching);
+  KLMMuidLikelihood* klmMuidLikelihood = m_klmMuidLikelihoods.appendNew(); // rest of this object will be filled later
+  klmMuidLikelihood->setPDGCode(extState.pdgCode);
+  if (extState.track != nullptr)
+    extState.track->addRelationTo(klmMuidLikelihood);
+  G4ErrorSymMatrix covariance(6, 0);
+  fromG4eToPhasespace(g4eState, covariance);
+  for (int nStep = 0; nStep < MAXSTEP_FAST; ++nStep) {
+    G4ThreeVector prePos = g4eState.GetPosition();
+    double dt, dl;
+    bool isAlive = stepFast(g4eState, mass, charge, covariance, dt, dl);
+    G4ThreeVector pos = g4eState.GetPosition();
+    G4ThreeVector mom = g4eState.GetMomentum();
+    extState.tof += dt;
+    extState.length += dl;
+    // No geant4 volume: every crossing of a KLM layer is considered to be inside a sensitive
+    // volume, the crossings outside the strips are rejected by the channel-status check
+    if (createMuidHit(extState, g4eState, prePos / CLHEP::cm, nullptr, klmMuidLikelihood, bklmHitUsed)) {
+      // Continue from the Kalman-updated state
+      fromG4eToPhasespace(g4eState, covariance);
+    }
+    matchClusters(extState, g4eState, prePos, pos, mom, dt, dl, eclClusterInfo, klmClusterInfo, clusterMatching);
+    // Post-step momentum too low?
+    if (!isAlive || (mom.mag2() < minPSq)) {
+      break;
+    }
+    // Detect escapes from the imaginary target cylinder.
+    if (m_TargetMuid->GetDistanceFromPoint(pos) < 0.0) {
+      break;
+    }
+    // Stop extrapolating as soon as the track curls inward too much
+    if (pos.perp2() < m_MinRadiusSq) {
+      break;
+    }
+  } // track-extrapolation loop
+
+  finishTrack(extState, klmMuidLikelihood, (g4eState.GetPosition().z() > m_OffsetZ));
+
+  storeClusterMatching(extState, eclClusterInfo, klmClusterInfo, clusterMatching);
+
+}
+
+// Prepare the ECLCluster-Track and KLMCluster-Track matching of one track
+void TrackExtrapolateG4e::initClusterMatching(const ExtState& extState,
+                                              const std::vector<std::pair<ECLCluster*, G4ThreeVector> >* eclClusterInfo,
+                                              const std::vector<std::pair<KLMCluster*, G4ThreeVector> >* klmClusterInfo,
+                                              ClusterMatching& clusterMatching)
+{
   if (eclClusterInfo != nullptr) {
+    clusterMatching.eclClusterDistance.resize(eclClusterInfo->size(), 1.0E10); // "positive infinity"
+    ExtHit tempExtHit(extState.pdgCode, Const::EDetector::ECL, 0, EXT_FIRST,
+                      extState.isCosmic, 0.0,
+                      G4ThreeVector(), G4ThreeVector(), G4ErrorSymMatrix(6));
+    clusterMatching.eclHit1.resize(eclClusterInfo->size(), tempExtHit);
+    clusterMatching.eclHit2.resize(eclClusterInfo->size(), tempExtHit);
+    clusterMatching.eclHit3.resize(eclClusterInfo->size(), tempExtHit);
+  }
+  if (klmClusterInfo != nullptr) {
+    clusterMatching.klmHit.resize(klmClusterInfo->size()); // initialize each to huge distance
+  }
+}
+
+// Update the ECLCluster-Track and KLMCluster-Track matching with one extrapolation step
+void TrackExtrapolateG4e::matchClusters(const ExtState& extState, const G4ErrorFreeTrajState& g4eState,
+                                        const G4ThreeVector& prePos, const G4ThreeVector& pos, const G4ThreeVector& mom,
+                                        double dt, double dl,
+                                        const std::vector<std::pair<ECLCluster*, G4ThreeVector> >* eclClusterInfo,
+                                        const std::vector<std::pair<KLMCluster*, G4ThreeVector> >* klmClusterInfo,
+                                        ClusterMatching& clusterMatching)
+{
+  if (eclClusterInfo != nullptr) {
+    std::vector<double>& eclClusterDistance = clusterMatching.eclClusterDistance;
+    std::vector<ExtHit>& eclHit1 = clusterMatching.eclHit1;
+    std::vector<ExtHit>& eclHit2 = clusterMatching.eclHit2;
+    std::vector<ExtHit>& eclHit3 = clusterMatching.eclHit3;
     for (unsigned int c = 0; c < eclClusterInfo->size(); ++c) {
-      if (eclHit1[c].getStatus() != EXT_FIRST) {
-        ExtHit* h = m_extHits.appendNew(eclHit1[c]);
+      G4ThreeVector eclPos((*eclClusterInfo)[c].second);
+      G4ThreeVector diff(prePos - eclPos);
+      double distance = diff.mag();
+      if (distance < m_MaxECLTrackClusterDistance) {
+        // fallback ECLNEAR in case no ECLCROSS is found
+        if (distance < eclClusterDistance[c]) {
+          eclClusterDistance[c] = distance;
+          G4ErrorSymMatrix covariance(6, 0);
+          fromG4eToPhasespace(g4eState, covariance);
+          eclHit3[c].update(EXT_ECLNEAR, extState.tof, pos / CLHEP::cm, mom / CLHEP::GeV, covariance);
+        }
+        // find position of crossing of the track with the ECLCluster's sphere
+        if (eclHit1[c].getStatus() == EXT_FIRST) {
+          if (pos.mag2() >= eclPos.mag2()) {
+            double r = eclPos.mag();
+            double preD = prePos.mag() - r;
+            double postD = pos.mag() - r;
+            double f = postD / (postD - preD);
+            G4ThreeVector midPos = pos + (prePos - pos) * f;
+            double tof = extState.tof + dt * f * (extState.isCosmic ? +1 : -1); // in ns, at end of step
+            G4ErrorSymMatrix covariance(6, 0);
+            fromG4eToPhasespace(g4eState, covariance);
+            eclHit1[c].update(EXT_ECLCROSS, tof, midPos / CLHEP::cm, mom / CLHEP::GeV, covariance);
+          }
+        }
+      }
+      // find closest distance to the radial line to the ECLCluster
+      if (eclHit2[c].getStatus() == EXT_FIRST) {
+        G4ThreeVector delta(pos - prePos);
+        G4ThreeVector perp(eclPos.cross(delta));
+        double perpMag2 = perp.mag2();
+        if (perpMag2 > 1.0E-10) {
+          double dist = std::fabs(diff * perp) / std::sqrt(perpMag2);
+          if (dist < m_MaxECLTrackClusterDistance) {
+            double f = eclPos * (prePos.cross(perp)) / perpMag2;
+            if ((f > -0.5) && (f <= 1.0)) {
+              G4ThreeVector midPos(prePos + f * delta);
+              double length = extState.length + dl * (1.0 - f) * (extState.isCosmic ? +1 : -1);
+              G4ErrorSymMatrix covariance(6, 0);
+              fromG4eToPhasespace(g4eState, covariance);
+              eclHit2[c].update(EXT_ECLDL, length, midPos / CLHEP::cm, mom / CLHEP::GeV, covariance);
+            }
+          }
+        }
+      }
+    }
+  }
+  if (klmClusterInfo != nullptr) {
+    std::vector<TrackClusterSeparation>& klmHit = clusterMatching.klmHit;
+    for (unsigned int c = 0; c < klmClusterInfo->size(); ++c) {
+      G4ThreeVector klmPos = (*klmClusterInfo)[c].second;
+      G4ThreeVector separation = klmPos - pos;
+      double distance = separation.mag();
+      if (distance < klmHit[c].getDistance()) {
+        klmHit[c].setDistance(distance);
+        klmHit[c].setTrackClusterAngle(mom.angle(separation));
+        klmHit[c].setTrackClusterSeparationAngle(mom.angle(klmPos));
+        klmHit[c].setTrackRotationAngle(extState.directionAtIP.angle(mom));
+        klmHit[c].setTrackClusterInitialSeparationAngle(extState.directionAtIP.angle(klmPos));
+      }
+    }
+  }
+}
+
+// Store the ECLCluster-Track and KLMCluster-Track matching of one track
+void TrackExtrapolateG4e::storeClusterMatching(const ExtState& extState,
+                                               const std::vector<std::pair<ECLCluster*, G4ThreeVector> >* eclClusterInfo,
+                                               const std::vector<std::pair<KLMCluster*, G4ThreeVector> >* klmClusterInfo,
+                                               const ClusterMatching& clusterMatching)
+{
+  if (eclClusterInfo != nullptr) {
+    for (unsigned int c = 0; c < eclClusterInfo->size(); ++c) {
+      if (clusterMatching.eclHit1[c].getStatus() != EXT_FIRST) {
+        ExtHit* h = m_extHits.appendNew(clusterMatching.eclHit1[c]);
         (*eclClusterInfo)[c].first->addRelationTo(h);
         extState.track->addRelationTo(h);
       }
-      if (eclHit2[c].getStatus() != EXT_FIRST) {
-        ExtHit* h = m_extHits.appendNew(eclHit2[c]);
+      if (clusterMatching.eclHit2[c].getStatus() != EXT_FIRST) {
+        ExtHit* h = m_extHits.appendNew(clusterMatching.eclHit2[c]);
         (*eclClusterInfo)[c].first->addRelationTo(h);
         extState.track->addRelationTo(h);
       }
-      if (eclHit3[c].getStatus() != EXT_FIRST) {
-        ExtHit* h = m_extHits.appendNew(eclHit3[c]);
+      if (clusterMatching.eclHit3[c].getStatus() != EXT_FIRST) {
+        ExtHit* h = m_extHits.appendNew(clusterMatching.eclHit3[c]);
         (*eclClusterInfo)[c].first->addRelationTo(h);
         extState.track->addRelationTo(h);
       }
@@ -724,15 +850,16 @@ void TrackExtrapolateG4e::swim(ExtState& extState, G4ErrorFreeTrajState& g4eStat
     double minDistance = m_MaxKLMTrackClusterDistance;
     unsigned int closestCluster = 0;
     for (unsigned int c = 0; c < klmClusterInfo->size(); ++c) {
-      if (klmHit[c].getDistance() > 1.0E9) {
+      const TrackClusterSeparation& klmHit = clusterMatching.klmHit[c];
+      if (klmHit.getDistance() > 1.0E9) {
         continue;
       }
-      TrackClusterSeparation* h = m_trackClusterSeparations.appendNew(klmHit[c]);
+      TrackClusterSeparation* h = m_trackClusterSeparations.appendNew(klmHit);
       (*klmClusterInfo)[c].first->addRelationTo(h); // relation KLMCluster to TrackSep
       extState.track->addRelationTo(h); // relation Track to TrackSep
-      if (klmHit[c].getDistance() < minDistance) {
+      if (klmHit.getDistance() < minDistance) {
         closestCluster = c;
-        minDistance = klmHit[c].getDistance();
+        minDistance = klmHit.getDistance();
       }
     }
     if (minDistance < m_MaxKLMTrackClusterDistance) {
@@ -740,7 +867,6 @@ void TrackExtrapolateG4e::swim(ExtState& extState, G4ErrorFreeTrajState& g4eStat
       extState.track->addRelationTo((*klmClusterInfo)[closestCluster].first, 1. / minDistance);
     }
   }
-
 }
 
 // Swim one track for EXT until it stops or leaves the ECL-bounding  cylinder
@@ -824,6 +950,148 @@ void TrackExtrapolateG4e::swim(ExtState& extState, G4ErrorFreeTrajState& g4eStat
 
 }
 
+// Swim one track for EXT with the fast extrapolation until it stops or leaves the ECL-bounding cylinder
+void TrackExtrapolateG4e::swimFast(ExtState& extState, G4ErrorFreeTrajState& g4eState)
+{
+  if (extState.pdgCode == 0)
+    return;
+  if (g4eState.GetMomentum().perp() <= m_MinPt)
+    return;
+  if (m_TargetExt->GetDistanceFromPoint(g4eState.GetPosition()) < 0.0)
+    return;
+  G4ParticleDefinition* particle = G4ParticleTable::GetParticleTable()->FindParticle(extState.pdgCode);
+  double mass = particle->GetPDGMass();
+  double charge = particle->GetPDGCharge();
+  double minPSq = (mass + m_MinKE) * (mass + m_MinKE) - mass * mass;
+  G4ErrorSymMatrix covariance(6, 0);
+  fromG4eToPhasespace(g4eState, covariance);
+  // Volume of the simplified geometry in which the track is
+  Const::EDetector detID(Const::EDetector::invalidDetector);
+  int copyID(0);
+  std::vector<ExtFastGeometry::Crossing> crossings;
+  for (int nStep = 0; nStep < MAXSTEP_FAST; ++nStep) {
+    G4ThreeVector prePos = g4eState.GetPosition();
+    G4ThreeVector preMom = g4eState.GetMomentum();
+    double dt, dl;
+    bool isAlive = stepFast(g4eState, mass, charge, covariance, dt, dl);
+    G4ThreeVector pos = g4eState.GetPosition();
+    G4ThreeVector mom = g4eState.GetMomentum();
+    // Volume boundaries crossed in this step, interpolated along the chord
+    m_FastGeometry->findCrossings(prePos / CLHEP::cm, pos / CLHEP::cm, crossings);
+    for (const ExtFastGeometry::Crossing& crossing : crossings) {
+      double f = crossing.fraction;
+      createFastExtHit(crossing.status, extState, crossing.detector, crossing.copyID, extState.tof + f * dt,
+                       prePos + f * (pos - prePos), preMom + f * (mom - preMom), covariance);
+      if (crossing.status == EXT_ENTER) {
+        detID = crossing.detector;
+        copyID = crossing.copyID;
+      } else {
+        detID = Const::EDetector::invalidDetector;
+        copyID = 0;
+      }
+    }
+    extState.tof += dt;
+    extState.length += dl;
+    // Post-step momentum too low?
+    if (!isAlive || (mom.mag2() < minPSq)) {
+      if (detID != Const::EDetector::invalidDetector) {
+        createFastExtHit(EXT_STOP, extState, detID, copyID, extState.tof, pos, mom, covariance);
+      }
+      break;
+    }
+    // Detect escapes from the imaginary target cylinder.
+    if (m_TargetExt->GetDistanceFromPoint(pos) < 0.0) {
+      if (detID != Const::EDetector::invalidDetector) {
+        createFastExtHit(EXT_ESCAPE, extState, detID, copyID, extState.tof, pos, mom, covariance);
+      }
+      break;
+    }
+    // Stop extrapolating as soon as the track curls inward too much
+    if (pos.perp2() < m_MinRadiusSq) {
+      break;
+    }
+  } // track-extrapolation loop
+
+}
+
+// Propagate the state of the fast extrapolation by one step along the helix in the local magnetic field,
+// with the parametrized energy loss and multiple scattering of the simplified geometry.
+// Returns false if the particle stopped in this step.
+bool TrackExtrapolateG4e::stepFast(G4ErrorFreeTrajState& g4eState, double mass, double charge,
+                                   G4ErrorSymMatrix& covariance, double& dt, double& dl)
+{
+  const double stepLength = FASTSTEP_LENGTH; // in G4 units (mm)
+  G4ThreeVector pos = g4eState.GetPosition(); // in G4 units (mm)
+  G4ThreeVector mom = g4eState.GetMomentum(); // in G4 units (MeV/c)
+  double p = mom.mag();
+  G4ThreeVector u = mom / p;
+
+  // Helix in the field at the start of the step
+  B2Vector3D field = BFieldManager::getField(pos.x() / CLHEP::cm, pos.y() / CLHEP::cm, pos.z() / CLHEP::cm);
+  G4ThreeVector b(field.X() / Unit::T, field.Y() / Unit::T, field.Z() / Unit::T); // in tesla
+  double bMag = b.mag();
+  double k = charge * CLHEP::c_light * bMag * CLHEP::tesla / p; // signed curvature (1/mm)
+  G4ThreeVector newPos(pos + u * stepLength);
+  G4ThreeVector newU(u);
+  if (std::fabs(k * stepLength) > 1.0E-8) {
+    G4ThreeVector bUnit = b / bMag;
+    G4ThreeVector uPar = (u * bUnit) * bUnit;
+    G4ThreeVector uPerp = u - uPar;
+    G4ThreeVector uCross = u.cross(bUnit);
+    double sinKs = std::sin(k * stepLength);
+    double cosKs = std::cos(k * stepLength);
+    newPos = pos + uPar * stepLength + uPerp * (sinKs / k) + uCross * ((1.0 - cosKs) / k);
+    newU = uPar + uPerp * cosKs + uCross * sinKs;
+  }
+
+  // Material at the middle of the step
+  ExtFastGeometry::Material material = m_FastGeometry->getMaterial(0.5 * (pos + newPos) / CLHEP::cm);
+  double energy = std::sqrt(p * p + mass * mass);
+  double beta = p / energy;
+  double stepCm = stepLength / CLHEP::cm;
+  dt = stepLength / (beta * CLHEP::c_light);
+  dl = (material.radiationLength > 0.0) ? stepCm / material.radiationLength : 0.0;
+
+  // Mean energy loss, scaled with 1/beta^2 below minimum ionization
+  double newEnergy = energy - material.dEdx * CLHEP::GeV * stepCm / (beta * beta);
+  bool isAlive = (newEnergy > mass);
+  double newP = isAlive ? std::sqrt(newEnergy * newEnergy - mass * mass) : 1.0E-3 * p;
+
+  // Phase-space covariance (cm, GeV/c): straight-line transport and multiple scattering
+  double pGeV = p / CLHEP::GeV;
+  G4ErrorMatrix jacobian(6, 6, 1); // unit matrix
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      jacobian(i + 1, j + 4) = stepCm / pGeV * ((i == j ? 1.0 : 0.0) - u[i] * u[j]); // @(x)/@(p)
+    }
+  }
+  covariance = covariance.similarity(jacobian);
+  if (dl > 0.0) {
+    double theta0 = 13.6 * CLHEP::MeV / (beta * p) * std::sqrt(dl) * (1.0 + 0.038 * std::log(dl)); // Highland
+    double theta0Sq = theta0 * theta0;
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        double projection = (i == j ? 1.0 : 0.0) - newU[i] * newU[j];
+        if (j <= i) {
+          covariance(i + 1, j + 1) += stepCm * stepCm * theta0Sq / 3.0 * projection;
+          covariance(i + 4, j + 4) += pGeV * pGeV * theta0Sq * projection;
+        }
+        covariance(i + 4, j + 1) += 0.5 * stepCm * pGeV * theta0Sq * projection;
+      }
+    }
+  }
+
+  G4ThreeVector newMom(newU * newP);
+  G4Point3D newPosG4e(newPos.x(), newPos.y(), newPos.z());
+  g4eState.SetPosition(newPosG4e);
+  G4Vector3D newMomG4e(newMom.x(), newMom.y(), newMom.z());
+  g4eState.SetMomentum(newMomG4e);
+  G4ErrorTrajErr covG4e;
+  fromPhasespaceToG4e(newMom / CLHEP::GeV, covariance, covG4e);
+  g4eState.SetError(covG4e);
+  return isAlive;
+}
+
 // Register the list of volumes for which entry/exit point is to be saved during extrapolation
 void TrackExtrapolateG4e::registerVolumes()
 {
@@ -1240,10 +1508,26 @@ void TrackExtrapolateG4e::createExtHit(ExtHitStatus status, const ExtState& extS
     extState.track->addRelationTo(extHit);
 }
 
+// write another volume-entry or volume-exit point of the fast extrapolation (position in mm, momentum in MeV/c)
+void TrackExtrapolateG4e::createFastExtHit(ExtHitStatus status, const ExtState& extState,
+                                           Const::EDetector detID, int copyID, double tof,
+                                           const G4ThreeVector& position, const G4ThreeVector& momentum,
+                                           const G4ErrorSymMatrix& covariance)
+{
+  ExtHit* extHit = m_extHits.appendNew(extState.pdgCode, detID, copyID, status,
+                                       extState.isCosmic, tof,
+                                       position / CLHEP::cm, momentum / CLHEP::GeV, covariance);
+  // If called standalone, there will be no associated track
+  if (extState.track != nullptr)
+    extState.track->addRelationTo(extHit);
+}
+
 // Write another volume-entry point on track.
 // The track state will be modified here by the Kalman fitter.
+// The pre-step position is in cm; the current geant4 volume is nullptr for the fast extrapolation.
 
-bool TrackExtrapolateG4e::createMuidHit(ExtState& extState, G4ErrorFreeTrajState& g4eState, KLMMuidLikelihood* klmMuidLikelihood,
+bool TrackExtrapolateG4e::createMuidHit(ExtState& extState, G4ErrorFreeTrajState& g4eState, const G4ThreeVector& oldPosition,
+                                        G4VPhysicalVolume* volume, KLMMuidLikelihood* klmMuidLikelihood,
                                         std::vector<std::map<const Track*, double> >* bklmHitUsed)
 {
 
@@ -1252,8 +1536,6 @@ bool TrackExtrapolateG4e::createMuidHit(ExtState& extState, G4ErrorFreeTrajState
   intersection.chi2 = -1.0;
   intersection.position = g4eState.GetPosition() / CLHEP::cm;
   intersection.momentum = g4eState.GetMomentum() / CLHEP::GeV;
-  G4ThreeVector prePos = g4eState.GetG4Track()->GetStep()->GetPreStepPoint()->GetPosition() / CLHEP::cm;
-  G4ThreeVector oldPosition(prePos.x(), prePos.y(), prePos.z());
   double r = intersection.position.perp();
   double z = std::fabs(intersection.position.z() - m_OffsetZ);
 
@@ -1287,9 +1569,8 @@ bool TrackExtrapolateG4e::createMuidHit(ExtState& extState, G4ErrorFreeTrajState
         }
       } else {
         // Record a no-hit track crossing if this step is strictly within a barrel sensitive volume
-        std::vector<G4VPhysicalVolume*>::iterator j = find(m_BKLMVolumes->begin(), m_BKLMVolumes->end(),
-                                                           g4eState.GetG4Track()->GetVolume());
-        if (j != m_BKLMVolumes->end()) {
+        if ((volume == nullptr) ||
+            (find(m_BKLMVolumes->begin(), m_BKLMVolumes->end(), volume) != m_BKLMVolumes->end())) {
           bool isDead = true; // by default, the nearest orthogonal strips are dead
           int section = intersection.isForward ?
                         BKLMElementNumbers::c_ForwardSection :
@@ -1505,6 +1786,42 @@ bool TrackExtrapolateG4e::findEndcapIntersection(ExtState& extState, const G4Thr
   return false;
 }
 
+void TrackExtrapolateG4e::fillKLMHitLists()
+{
+  // The layer, section and time selections of the hit matching depend only on the hit,
+  // so they are applied once per event instead of for each crossed layer of each track.
+  // The hits are kept in the StoreArray order so that ties are resolved as before.
+  m_bklmLayerHits.resize(BKLMElementNumbers::getMaximalLayerNumber());
+  for (std::vector<int>& layerHits : m_bklmLayerHits)
+    layerHits.clear();
+  for (int h = 0; h < m_bklmHit2ds.getEntries(); ++h) {
+    BKLMHit2d* hit = m_bklmHit2ds[h];
+    if ((hit->getLayer() < 1) || (hit->getLayer() > BKLMElementNumbers::getMaximalLayerNumber()))
+      continue;
+    if (hit->isOutOfTime())
+      continue;
+    if (std::fabs(hit->getTime() - m_MeanDt) > m_MaxDt)
+      continue;
+    m_bklmLayerHits[hit->getLayer() - 1].push_back(h);
+  }
+  int nLayersEKLM = EKLMElementNumbers::getMaximalLayerNumber();
+  m_eklmLayerHits.resize(EKLMElementNumbers::getMaximalSectionNumber() * nLayersEKLM);
+  for (std::vector<int>& layerHits : m_eklmLayerHits)
+    layerHits.clear();
+  for (int h = 0; h < m_eklmHit2ds.getEntries(); ++h) {
+    EKLMHit2d* hit = m_eklmHit2ds[h];
+    if ((hit->getLayer() < 1) || (hit->getLayer() > nLayersEKLM))
+      continue;
+    if ((hit->getSection() < 1) || (hit->getSection() > EKLMElementNumbers::getMaximalSectionNumber()))
+      continue;
+    // DIVOT no such function for EKLM!
+    // if (hit->isOutOfTime()) continue;
+    if (std::fabs(hit->getTime() - m_MeanDt) > m_MaxDt)
+      continue;
+    m_eklmLayerHits[(hit->getSection() - 1) * nLayersEKLM + hit->getLayer() - 1].push_back(h);
+  }
+}
+
 bool TrackExtrapolateG4e::findMatchingBarrelHit(Intersection& intersection, const Track* track)
 
 {
@@ -1513,14 +1830,8 @@ bool TrackExtrapolateG4e::findMatchingBarrelHit(Intersection& intersection, cons
   int bestHit = -1;
   int matchingLayer = intersection.layer + 1;
   G4ThreeVector n(m_BarrelSectorPerp[intersection.sector]);
-  for (int h = 0; h < m_bklmHit2ds.getEntries(); ++h) {
+  for (int h : m_bklmLayerHits[matchingLayer - 1]) {
     BKLMHit2d* hit = m_bklmHit2ds[h];
-    if (hit->getLayer() != matchingLayer)
-      continue;
-    if (hit->isOutOfTime())
-      continue;
-    if (std::fabs(hit->getTime() - m_MeanDt) > m_MaxDt)
-      continue;
     G4ThreeVector diff(hit->getGlobalPositionX() - intersection.position.x(),
                        hit->getGlobalPositionY() - intersection.position.y(),
                        hit->getGlobalPositionZ() - intersection.position.z());
@@ -1608,16 +1919,8 @@ bool TrackExtrapolateG4e::findMatchingEndcapHit(Intersection& intersection, cons
   int matchingLayer = intersection.layer + 1;
   int matchingEndcap = (intersection.isForward ? 2 : 1);
   G4ThreeVector n(0.0, 0.0, (intersection.isForward ? 1.0 : -1.0));
-  for (int h = 0; h < m_eklmHit2ds.getEntries(); ++h) {
+  for (int h : m_eklmLayerHits[(matchingEndcap - 1) * EKLMElementNumbers::getMaximalLayerNumber() + matchingLayer - 1]) {
     EKLMHit2d* hit = m_eklmHit2ds[h];
-    if (hit->getLayer() != matchingLayer)
-      continue;
-    if (hit->getSection() != matchingEndcap)
-      continue;
-    // DIVOT no such function for EKLM!
-    // if (hit->isOutOfTime()) continue;
-    if (std::fabs(hit->getTime() - m_MeanDt) > m_MaxDt)
-      continue;
     G4ThreeVector diff(hit->getPositionX() - intersection.position.x(),
                        hit->getPositionY() - intersection.position.y(),
                        hit->getPositionZ() - intersection.position.z());
@@ -14,6 +14,7 @@
 #include <tracking/trackFindingCDC/numerics/Weight.h>
 
 #include <string>
+#include <vector>
 #include <memory>
 
 namespace Belle2 {
@@ -62,6 +63,15 @@ namespace Belle2 {
       /// Const version of operator
       Weight operator()(const Object& object) const;
 
+      /**
+       *  Function to evaluate a batch of objects.
+       *  Delegates to the batch evaluation of the filter chosen by module parameters.
+       *
+       *  @param objects The objects to be accepted or rejected.
+       *  @return        The weights of the objects in the same order, NAN for rejected objects.
+       */
+      std::vector<Weight> operator()(const std::vector<Object*>& objects) final;
+
     public:
       /// Return name of the selected filter
       std::string getFilterName() const
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Belle2 {
   namespace TrackFindingCDC {
@@ -98,6 +99,14 @@ namespace Belle2 {
       return (*m_filter)(object);
     }
 
+    template <class AFilter>
+    std::vector<Weight> Chooseable<AFilter>::operator()(const std::vector<Object*>& objects)
+    {
+      // Call through the filter interface, as the chosen filter may hide the batch overload
+      Filter<Object>& filter = *m_filter;
+      return filter(objects);
+    }
+
     template <class AFilterFactory>
     ChooseableFilter<AFilterFactory>::ChooseableFilter()
       : Super(std::make_unique<AFilterFactory>())
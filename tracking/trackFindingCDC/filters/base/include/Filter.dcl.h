@@ -14,6 +14,7 @@
 #include <tracking/trackFindingCDC/numerics/Weight.h>
 
 #include <string>
+#include <vector>
 
 namespace Belle2 {
   class ModuleParamList;
@@ -70,6 +71,17 @@ namespace Belle2 {
        *             NAN if the object is rejected. Nullptr is always rejected.
        */
       Weight operator()(const Object* obj);
+
+      /**
+       *  Function to evaluate a batch of objects.
+       *  Base implementation evaluates each object on its own.
+       *  Filters which profit from seeing many objects at once, like the mva based filters, override it.
+       *
+       *  @param objs The objects to be accepted or rejected.
+       *  @return     The weights of the objects in the same order.
+       *              NAN for each rejected object. Nullptr is always rejected.
+       */
+      virtual std::vector<Weight> operator()(const std::vector<Object*>& objs);
     };
   }
 }
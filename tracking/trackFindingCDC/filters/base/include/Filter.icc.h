@@ -12,6 +12,7 @@
 #include <tracking/trackFindingCDC/numerics/Weight.h>
 
 #include <string>
+#include <vector>
 #include <cmath>
 
 namespace Belle2 {
@@ -50,5 +51,16 @@ namespace Belle2 {
     {
       return obj ? operator()(*obj) : NAN;
     }
+
+    template <class AObject>
+    std::vector<Weight> Filter<AObject>::operator()(const std::vector<Object*>& objs)
+    {
+      std::vector<Weight> weights;
+      weights.reserve(objs.size());
+      for (const Object* obj : objs) {
+        weights.push_back(operator()(obj));
+      }
+      return weights;
+    }
   }
 }
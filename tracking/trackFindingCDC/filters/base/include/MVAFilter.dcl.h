@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include <cmath>
 
 namespace Belle2 {
@@ -62,9 +63,15 @@ namespace Belle2 {
       /// Function to object for its signalness
       Weight operator()(const Object& obj) override;
 
+      /// Function to evaluate a batch of objects for their signalness with a single call to the mva method
+      std::vector<Weight> operator()(const std::vector<Object*>& objs) override;
+
       /// Evaluate the mva method
       virtual double predict(const Object& obj);
 
+      /// Evaluate the mva method for a batch of objects, NAN for objects for which the variables could not be extracted
+      virtual std::vector<Weight> predict(const std::vector<Object*>& objs);
+
     private:
       /// The cut on the MVA output.
       double m_param_cut;
@@ -74,6 +81,9 @@ namespace Belle2 {
 
       /// MVA Expert to examine the object
       std::unique_ptr<MVAExpert> m_mvaExpert;
+
+      /// Row-major matrix of the variables of the current batch, kept to reuse its memory
+      std::vector<float> m_batchFeatures;
     };
 
     /// Convience template to create a mva filter for a set of variables.
@@ -80,6 +80,16 @@ namespace Belle2 {
       return prediction < m_param_cut ? NAN : prediction;
     }
 
+    template <class AFilter>
+    std::vector<Weight> MVA<AFilter>::operator()(const std::vector<Object*>& objs)
+    {
+      std::vector<Weight> predictions = predict(objs);
+      for (Weight& prediction : predictions) {
+        if (prediction < m_param_cut) prediction = NAN;
+      }
+      return predictions;
+    }
+
     template <class AFilter>
     double MVA<AFilter>::predict(const Object& obj)
     {
@@ -91,6 +101,32 @@ namespace Belle2 {
       }
     }
 
+    template <class AFilter>
+    std::vector<Weight> MVA<AFilter>::predict(const std::vector<Object*>& objs)
+    {
+      const unsigned int nFeatures = m_mvaExpert->getNFeatures();
+      std::vector<Weight> predictions(objs.size(), NAN);
+
+      // Extract the variables of all objects into one contiguous matrix
+      std::vector<size_t> extractedIndices;
+      extractedIndices.reserve(objs.size());
+      m_batchFeatures.resize(objs.size() * nFeatures);
+      for (size_t iObj = 0; iObj < objs.size(); ++iObj) {
+        if (objs[iObj] == nullptr) continue;
+        Weight extracted = Super::operator()(*objs[iObj]);
+        if (std::isnan(extracted)) continue;
+        m_mvaExpert->extractFeatures(m_batchFeatures.data() + extractedIndices.size() * nFeatures);
+        extractedIndices.push_back(iObj);
+      }
+
+      // Evaluate the whole matrix at once
+      std::vector<float> mvaOutputs = m_mvaExpert->predict(m_batchFeatures, extractedIndices.size());
+      for (size_t iRow = 0; iRow < extractedIndices.size(); ++iRow) {
+        predictions[extractedIndices[iRow]] = mvaOutputs[iRow];
+      }
+      return predictions;
+    }
+
     template <class AVarSet>
     MVAFilter<AVarSet>::MVAFilter(const std::string& defaultTrainingName,
                                   double defaultCut)
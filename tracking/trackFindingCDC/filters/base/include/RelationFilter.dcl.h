@@ -22,6 +22,10 @@ namespace Belle2 {
     template <class AObject>
     class RelationFilter : public Filter<Relation<AObject> > {
 
+    private:
+      /// Type of the super class
+      using Super = Filter<Relation<AObject> >;
+
     public:
       /// Default constructor
       RelationFilter();
@@ -45,6 +49,9 @@ namespace Belle2 {
        *  the method implementing the rejection.
        */
       Weight operator()(const Relation<AObject>& relation) override;
+
+      /// Make the other overloads of the filter interface, e.g. the batch evaluation, visible
+      using Super::operator();
     };
   }
 }
@@ -7,6 +7,8 @@
  **************************************************************************/
 #pragma once
 
+#include <tracking/trackFindingCDC/filters/base/Filter.dcl.h>
+
 #include <tracking/trackFindingCDC/utilities/WeightedRelation.h>
 #include <tracking/trackFindingCDC/utilities/Relation.h>
 #include <tracking/trackFindingCDC/numerics/Weight.h>
@@ -63,8 +65,6 @@ namespace Belle2 {
                               unsigned int maximumNumberOfRelations = std::numeric_limits<unsigned int>::max())
       {
         for (AObject* from : froms) {
-          StoreObjPtr<EventLevelTrackingInfo> m_eventLevelTrackingInfo;
-
           std::vector<AObject*> possibleTos = relationFilter.getPossibleTos(from, tos);
 
           for (AObject* to : possibleTos) {
@@ -75,20 +75,7 @@ namespace Belle2 {
             weightedRelations.emplace_back(from, weight, to);
 
             if (weightedRelations.size() == maximumNumberOfRelations) {
-              B2WARNING("Relations Creator reached maximal number of items. Aborting");
-              if (m_eventLevelTrackingInfo.isValid()) {
-                if (std::is_base_of<AObject, CKFToPXDState>::value) {
-                  m_eventLevelTrackingInfo->setPXDCKFAbortionFlag();
-                } else if (std::is_base_of<AObject, CKFToSVDState>::value) {
-                  m_eventLevelTrackingInfo->setSVDCKFAbortionFlag();
-                } else if (std::is_base_of<AObject, vxdHoughTracking::VXDHoughState>::value) {
-                  B2INFO("Aborting processing DATCON track candidate, not setting AbortionFlag.");
-                } else {
-                  B2WARNING("Undefined class used for CKFStates. Could not set AbortionFlag.");
-                }
-              }
-
-              weightedRelations.clear();
+              abortRelationCreation<AObject>(weightedRelations);
               return;
             }
           }
@@ -98,6 +85,59 @@ namespace Belle2 {
       }
       /* *@}*/
 
+      /**
+       *  Appends relations between elements in the given AItems using the ARelationFilter.
+       *  In contrast to appendUsing all possible relations are collected first and
+       *  passed to the relation filter in one batch, which is favourable for mva based filters.
+       *  The maximal number of relations is applied in the same order as in appendUsing.
+       */
+      template <class AObject, class ARelationFilter>
+      static void appendUsingBatch(ARelationFilter& relationFilter,
+                                   const std::vector<AObject*>& froms,
+                                   const std::vector<AObject*>& tos,
+                                   std::vector<WeightedRelation<AObject>>& weightedRelations,
+                                   unsigned int maximumNumberOfRelations = std::numeric_limits<unsigned int>::max())
+      {
+        std::vector<Relation<AObject>> relations;
+        for (AObject* from : froms) {
+          std::vector<AObject*> possibleTos = relationFilter.getPossibleTos(from, tos);
+          for (AObject* to : possibleTos) {
+            if (from == to) continue;
+            relations.emplace_back(from, to);
+          }
+        }
+
+        std::vector<Relation<AObject>*> relationPtrs;
+        relationPtrs.reserve(relations.size());
+        for (Relation<AObject>& relation : relations) {
+          relationPtrs.push_back(&relation);
+        }
+
+        // Call through the filter interface, as derived relation filters may hide the batch overload
+        Filter<Relation<AObject>>& filter = relationFilter;
+        std::vector<Weight> weights = filter(relationPtrs);
+        for (size_t iRelation = 0; iRelation < relations.size(); ++iRelation) {
+          if (std::isnan(weights[iRelation])) continue;
+          weightedRelations.emplace_back(relations[iRelation].getFrom(), weights[iRelation], relations[iRelation].getTo());
+
+          if (weightedRelations.size() == maximumNumberOfRelations) {
+            abortRelationCreation<AObject>(weightedRelations);
+            return;
+          }
+        }
+        // sort everything afterwards
+        std::sort(std::begin(weightedRelations), std::end(weightedRelations));
+      }
+
+      /// Shortcut for applying appendUsingBatch with froms=tos
+      template <class AObject, class ARelationFilter>
+      static void appendUsingBatch(ARelationFilter& relationFilter,
+                                   const std::vector<AObject*>& objects,
+                                   std::vector<WeightedRelation<AObject>>& weightedRelations)
+      {
+        appendUsingBatch(relationFilter, objects, objects, weightedRelations);
+      };
+
       /// Shortcut for applying appendUsing with froms=tos
       template <class AObject, class ARelationFilter>
       static void appendUsing(ARelationFilter& relationFilter,
@@ -106,6 +146,28 @@ namespace Belle2 {
       {
         appendUsing(relationFilter, objects, objects, weightedRelations);
       };
+
+    private:
+      /// Warn that the maximal number of relations is reached, set the abortion flag of the event and drop all relations
+      template <class AObject>
+      static void abortRelationCreation(std::vector<WeightedRelation<AObject>>& weightedRelations)
+      {
+        B2WARNING("Relations Creator reached maximal number of items. Aborting");
+        StoreObjPtr<EventLevelTrackingInfo> eventLevelTrackingInfo;
+        if (eventLevelTrackingInfo.isValid()) {
+          if (std::is_base_of<AObject, CKFToPXDState>::value) {
+            eventLevelTrackingInfo->setPXDCKFAbortionFlag();
+          } else if (std::is_base_of<AObject, CKFToSVDState>::value) {
+            eventLevelTrackingInfo->setSVDCKFAbortionFlag();
+          } else if (std::is_base_of<AObject, vxdHoughTracking::VXDHoughState>::value) {
+            B2INFO("Aborting processing DATCON track candidate, not setting AbortionFlag.");
+          } else {
+            B2WARNING("Undefined class used for CKFStates. Could not set AbortionFlag.");
+          }
+        }
+
+        weightedRelations.clear();
+      }
     };
   }
 }
@@ -0,0 +1,235 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <gtest/gtest.h>
+
+#include <tracking/trackFindingCDC/filters/base/MVAFilter.icc.h>
+#include <tracking/trackFindingCDC/filters/base/RelationFilter.icc.h>
+#include <tracking/trackFindingCDC/filters/base/RelationFilterUtil.h>
+
+#include <tracking/trackFindingCDC/varsets/VarSet.h>
+#include <tracking/trackFindingCDC/varsets/VarNames.h>
+
+#include <tracking/trackFindingCDC/utilities/WeightedRelation.h>
+#include <tracking/trackFindingCDC/utilities/Relation.h>
+
+#include <mva/interface/Interface.h>
+#include <mva/interface/Dataset.h>
+#include <mva/interface/Weightfile.h>
+#include <mva/methods/FastBDT.h>
+
+#include <framework/utilities/TestHelpers.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Belle2;
+using namespace TrackFindingCDC;
+
+namespace {
+  /// Names of the variables of the test relations
+  constexpr
+  static char const* const testRelationVarNames[] = {
+    "from",
+    "to",
+  };
+
+  /// Vehicle class to transport the variable names
+  struct TestRelationVarNames : public VarNames<Relation<const float>> {
+
+    /// Number of variables to be generated
+    static const size_t nVars = size(testRelationVarNames);
+
+    /// Getter for the name at the given index
+    static constexpr char const* getName(int iName)
+    {
+      return testRelationVarNames[iName];
+    }
+  };
+
+  /// Variable set of a relation between two numbers
+  class TestRelationVarSet : public VarSet<TestRelationVarNames> {
+
+  public:
+    /// Generate and assign the contained variables
+    bool extract(const Relation<const float>* ptrRelation) final
+    {
+      if (not ptrRelation) return false;
+      var<named("from")>() = *ptrRelation->getFrom();
+      var<named("to")>() = *ptrRelation->getTo();
+      return true;
+    }
+  };
+
+  /// Mva relation filter between two numbers
+  class TestMVARelationFilter : public MVA<RelationFilter<const float>> {
+
+  private:
+    /// Type of the super class
+    using Super = MVA<RelationFilter<const float>>;
+
+  public:
+    /// Constructor from the weight file name
+    explicit TestMVARelationFilter(const std::string& identifier)
+      : Super(std::make_unique<TestRelationVarSet>(), identifier, 0.5)
+    {
+    }
+  };
+
+  /// Relation filter which only defines the weight of a pair, like most relation filters
+  class TestDistanceRelationFilter : public RelationFilter<const float> {
+
+  private:
+    /// Type of the super class
+    using Super = RelationFilter<const float>;
+
+  public:
+    /// Accept numbers closer than one
+    Weight operator()(const float& from, const float& to) final
+    {
+      return std::fabs(to - from) < 1 ? to - from : NAN;
+    }
+
+    /// Copy the implementation from the base class
+    using Super::operator();
+  };
+
+  /// Train a FastBDT which accepts relations to larger numbers and write it to the given file
+  void trainTestExpert(const std::string& fileName)
+  {
+    MVA::AbstractInterface::initSupportedInterfaces();
+    MVA::GeneralOptions generalOptions;
+    generalOptions.m_variables = {"from", "to"};
+    generalOptions.m_method = "FastBDT";
+    MVA::FastBDTOptions specificOptions;
+    specificOptions.m_randRatio = 1.0;
+
+    std::vector<std::vector<float>> features;
+    std::vector<float> targets;
+    for (int iFrom = 0; iFrom < 20; ++iFrom) {
+      for (int iTo = 0; iTo < 20; ++iTo) {
+        features.push_back({0.1f * iFrom, 0.1f * iTo});
+        targets.push_back(iTo > iFrom ? 1 : 0);
+      }
+    }
+    MVA::MultiDataset dataset(generalOptions, features, {}, targets);
+
+    auto teacher = MVA::AbstractInterface::getSupportedInterfaces()["FastBDT"]->getTeacher(generalOptions, specificOptions);
+    MVA::Weightfile weightfile = teacher->train(dataset);
+    MVA::Weightfile::saveToXMLFile(weightfile, fileName);
+  }
+}
+
+/// The batch evaluation of a mva filter yields the same weights as the evaluation of the single objects
+TEST(TrackFindingCDCTest, filter_base_MVAFilter_batch_agrees_with_single)
+{
+  TestHelpers::TempDirCreator tempDir;
+  trainTestExpert("TestMVARelationFilter.xml");
+
+  TestMVARelationFilter filter("TestMVARelationFilter.xml");
+  filter.initialize();
+  filter.beginRun();
+  filter.beginEvent();
+
+  std::vector<float> numbers;
+  for (int i = 0; i < 20; ++i) {
+    numbers.push_back(0.1 * i + 0.05);
+  }
+  std::vector<Relation<const float>> relations;
+  for (const float& from : numbers) {
+    for (const float& to : numbers) {
+      relations.emplace_back(&from, &to);
+    }
+  }
+
+  std::vector<Relation<const float>*> relationPtrs;
+  for (Relation<const float>& relation : relations) {
+    relationPtrs.push_back(&relation);
+  }
+  relationPtrs.push_back(nullptr);
+
+  // The batch evaluation is part of the common filter interface
+  Filter<Relation<const float>>& baseFilter = filter;
+  std::vector<Weight> weights = baseFilter(relationPtrs);
+  ASSERT_EQ(relationPtrs.size(), weights.size());
+
+  int nAccepted = 0;
+  for (size_t iRelation = 0; iRelation < relations.size(); ++iRelation) {
+    Weight weight = filter(relations[iRelation]);
+    EXPECT_EQ(std::isnan(weight), std::isnan(weights[iRelation]));
+    if (not std::isnan(weight)) {
+      EXPECT_FLOAT_EQ(weight, weights[iRelation]);
+      ++nAccepted;
+    }
+  }
+  EXPECT_TRUE(std::isnan(weights.back()));
+
+  // The expert separates the relations, so both accepted and rejected relations are checked
+  EXPECT_GT(nAccepted, 0);
+  EXPECT_LT(nAccepted, static_cast<int>(relations.size()));
+
+  filter.endRun();
+  filter.terminate();
+}
+
+/// The relation creation in batches yields the same relations as the creation one by one
+TEST(TrackFindingCDCTest, filter_base_RelationFilterUtil_appendUsingBatch_agrees_with_appendUsing)
+{
+  TestHelpers::TempDirCreator tempDir;
+  trainTestExpert("TestMVARelationFilter.xml");
+
+  std::vector<float> numbers;
+  for (int i = 0; i < 20; ++i) {
+    numbers.push_back(0.1 * i + 0.05);
+  }
+  std::vector<const float*> numberPtrs;
+  for (const float& number : numbers) {
+    numberPtrs.push_back(&number);
+  }
+
+  TestMVARelationFilter mvaFilter("TestMVARelationFilter.xml");
+  mvaFilter.initialize();
+  mvaFilter.beginRun();
+  mvaFilter.beginEvent();
+
+  std::vector<WeightedRelation<const float>> mvaRelations;
+  RelationFilterUtil::appendUsing(mvaFilter, numberPtrs, mvaRelations);
+  std::vector<WeightedRelation<const float>> mvaBatchRelations;
+  RelationFilterUtil::appendUsingBatch(mvaFilter, numberPtrs, mvaBatchRelations);
+  EXPECT_FALSE(mvaRelations.empty());
+  ASSERT_EQ(mvaRelations.size(), mvaBatchRelations.size());
+  for (size_t iRelation = 0; iRelation < mvaRelations.size(); ++iRelation) {
+    EXPECT_EQ(mvaRelations[iRelation].getFrom(), mvaBatchRelations[iRelation].getFrom());
+    EXPECT_EQ(mvaRelations[iRelation].getTo(), mvaBatchRelations[iRelation].getTo());
+    EXPECT_FLOAT_EQ(mvaRelations[iRelation].getWeight(), mvaBatchRelations[iRelation].getWeight());
+  }
+
+  mvaFilter.endRun();
+  mvaFilter.terminate();
+
+  // Relation filters without a batch evaluation of their own evaluate the relations one by one
+  TestDistanceRelationFilter distanceFilter;
+  std::vector<WeightedRelation<const float>> distanceRelations;
+  RelationFilterUtil::appendUsing(distanceFilter, numberPtrs, distanceRelations);
+  std::vector<WeightedRelation<const float>> distanceBatchRelations;
+  RelationFilterUtil::appendUsingBatch(distanceFilter, numberPtrs, distanceBatchRelations);
+  EXPECT_FALSE(distanceRelations.empty());
+  EXPECT_EQ(distanceRelations.size(), distanceBatchRelations.size());
+
+  // Both abort and drop all relations when reaching the maximal number of relations
+  const unsigned int maximumNumberOfRelations = distanceRelations.size();
+  std::vector<WeightedRelation<const float>> cappedRelations;
+  RelationFilterUtil::appendUsing(distanceFilter, numberPtrs, numberPtrs, cappedRelations, maximumNumberOfRelations);
+  std::vector<WeightedRelation<const float>> cappedBatchRelations;
+  RelationFilterUtil::appendUsingBatch(distanceFilter, numberPtrs, numberPtrs, cappedBatchRelations, maximumNumberOfRelations);
+  EXPECT_TRUE(cappedRelations.empty());
+  EXPECT_TRUE(cappedBatchRelations.empty());
+
+  RelationFilterUtil::appendUsingBatch(distanceFilter, numberPtrs, numberPtrs, cappedBatchRelations, maximumNumberOfRelations + 1);
+  EXPECT_EQ(distanceRelations.size(), cappedBatchRelations.size());
+}
@@ -42,6 +42,9 @@ namespace Belle2 {
        *  The size of the facet with a small penalty depending on the mva probability.
        */
       Weight predict(const CDCFacet& facet) final;
+
+      /// Batch version of the main filter method, applying the same penalty to each facet.
+      std::vector<Weight> predict(const std::vector<const CDCFacet*>& facets) final;
     };
   }
 }
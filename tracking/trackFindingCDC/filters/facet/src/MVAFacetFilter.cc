@@ -26,3 +26,12 @@ Weight MVAFacetFilter::predict(const CDCFacet& facet)
 {
   return 3 - 0.2 * (1 - Super::predict(facet));
 }
+
+std::vector<Weight> MVAFacetFilter::predict(const std::vector<const CDCFacet*>& facets)
+{
+  std::vector<Weight> predictions = Super::predict(facets);
+  for (Weight& prediction : predictions) {
+    prediction = 3 - 0.2 * (1 - prediction);
+  }
+  return predictions;
+}
@@ -66,3 +66,54 @@ TEST_F(TrackFindingCDCTestWithTopology, filter_facet_FeasibleRLFacetFilter_accep
   filter.endRun();
   filter.terminate();
 }
+
+TEST_F(TrackFindingCDCTestWithTopology, filter_facet_FeasibleRLFacetFilter_batch_agrees_with_single)
+{
+  FeasibleRLFacetFilter filter;
+
+  filter.initialize();
+  filter.beginRun();
+
+  const CDCWireTopology& wireTopology = CDCWireTopology::getInstance();
+
+  const CDCWire& aWire = wireTopology.getWire(0, 0, 0);
+  const CDCWire& bWire = wireTopology.getWire(0, 0, 1);
+  const CDCWire& cWire = wireTopology.getWire(0, 0, 3);
+
+  const CDCWireHit aWireHit(aWire.getWireID(), 0.1);
+  const CDCWireHit bWireHit(bWire.getWireID(), 0.1);
+  const CDCWireHit cWireHit(cWire.getWireID(), 0.1);
+
+  filter.beginEvent();
+
+  std::vector<CDCFacet> facets;
+  for (ERightLeft aRLInfo : {ERightLeft::c_Left, ERightLeft::c_Right}) {
+    for (ERightLeft bRLInfo : {ERightLeft::c_Left, ERightLeft::c_Right}) {
+      for (ERightLeft cRLInfo : {ERightLeft::c_Left, ERightLeft::c_Right}) {
+        facets.emplace_back(CDCRLWireHit(&aWireHit, aRLInfo),
+                            CDCRLWireHit(&bWireHit, bRLInfo),
+                            CDCRLWireHit(&cWireHit, cRLInfo));
+      }
+    }
+  }
+
+  std::vector<const CDCFacet*> facetPtrs;
+  for (const CDCFacet& facet : facets) {
+    facetPtrs.push_back(&facet);
+  }
+  facetPtrs.push_back(nullptr);
+
+  // The batch evaluation is part of the common filter interface
+  BaseFacetFilter& baseFilter = filter;
+  std::vector<Weight> weights = baseFilter(facetPtrs);
+  ASSERT_EQ(facetPtrs.size(), weights.size());
+  for (size_t iFacet = 0; iFacet < facets.size(); ++iFacet) {
+    Weight weight = filter(facets[iFacet]);
+    EXPECT_EQ(std::isnan(weight), std::isnan(weights[iFacet]));
+    if (not std::isnan(weight)) EXPECT_EQ(weight, weights[iFacet]);
+  }
+  EXPECT_TRUE(std::isnan(weights.back()));
+
+  filter.endRun();
+  filter.terminate();
+}
@@ -45,6 +45,9 @@ namespace Belle2 {
       /// Function to object for its signalness
       Weight operator()(const Relation<const CDCSegment2D>& segmentRelation) override;
 
+      /// Function to evaluate a batch of objects for their signalness, only the feasible ones are passed to the main mva
+      std::vector<Weight> operator()(const std::vector<Relation<const CDCSegment2D>*>& segmentRelations) override;
+
     private:
       /// Feasibility filter applied first before invoking the main cut
       MVAFeasibleSegmentRelationFilter m_feasibleSegmentRelationFilter;
@@ -31,3 +31,23 @@ Weight MVARealisticSegmentRelationFilter::operator()(const Relation<const CDCSeg
     return Super::operator()(segmentRelation);
   }
 }
+
+std::vector<Weight> MVARealisticSegmentRelationFilter::operator()(const std::vector<Relation<const CDCSegment2D>*>&
+    segmentRelations)
+{
+  std::vector<Weight> isFeasibleWeights = m_feasibleSegmentRelationFilter(segmentRelations);
+
+  std::vector<Relation<const CDCSegment2D>*> feasibleSegmentRelations;
+  feasibleSegmentRelations.reserve(segmentRelations.size());
+  for (size_t iRelation = 0; iRelation < segmentRelations.size(); ++iRelation) {
+    if (not std::isnan(isFeasibleWeights[iRelation])) feasibleSegmentRelations.push_back(segmentRelations[iRelation]);
+  }
+
+  std::vector<Weight> feasibleWeights = Super::operator()(feasibleSegmentRelations);
+
+  std::vector<Weight> weights(segmentRelations.size(), NAN);
+  for (size_t iRelation = 0, iFeasible = 0; iRelation < segmentRelations.size(); ++iRelation) {
+    if (not std::isnan(isFeasibleWeights[iRelation])) weights[iRelation] = feasibleWeights[iFeasible++];
+  }
+  return weights;
+}
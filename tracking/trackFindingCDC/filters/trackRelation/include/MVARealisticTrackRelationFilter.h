@@ -38,6 +38,9 @@ namespace Belle2 {
       /// Function to object for its signalness
       Weight operator()(const Relation<const CDCTrack>& trackRelation) final;
 
+      /// Function to evaluate a batch of objects for their signalness, only the feasible ones are passed to the main mva
+      std::vector<Weight> operator()(const std::vector<Relation<const CDCTrack>*>& trackRelations) final;
+
     private:
       /// Feasibility filter applied first before invoking the main cut
       MVAFeasibleTrackRelationFilter m_feasibleTrackRelationFilter;
@@ -29,3 +29,22 @@ Weight MVARealisticTrackRelationFilter::operator()(const Relation<const CDCTrack
     return Super::operator()(trackRelation);
   }
 }
+
+std::vector<Weight> MVARealisticTrackRelationFilter::operator()(const std::vector<Relation<const CDCTrack>*>& trackRelations)
+{
+  std::vector<Weight> isFeasibleWeights = m_feasibleTrackRelationFilter(trackRelations);
+
+  std::vector<Relation<const CDCTrack>*> feasibleTrackRelations;
+  feasibleTrackRelations.reserve(trackRelations.size());
+  for (size_t iRelation = 0; iRelation < trackRelations.size(); ++iRelation) {
+    if (not std::isnan(isFeasibleWeights[iRelation])) feasibleTrackRelations.push_back(trackRelations[iRelation]);
+  }
+
+  std::vector<Weight> feasibleWeights = Super::operator()(feasibleTrackRelations);
+
+  std::vector<Weight> weights(trackRelations.size(), NAN);
+  for (size_t iRelation = 0, iFeasible = 0; iRelation < trackRelations.size(); ++iRelation) {
+    if (not std::isnan(isFeasibleWeights[iRelation])) weights[iRelation] = feasibleWeights[iFeasible++];
+  }
+  return weights;
+}
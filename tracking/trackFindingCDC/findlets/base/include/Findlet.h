@@ -8,10 +8,14 @@
 #pragma once
 
 #include <tracking/trackFindingCDC/utilities/CompositeProcessingSignalListener.h>
+#include <tracking/trackFindingCDC/utilities/FindletStatistics.h>
 
 #include <vector>
 #include <tuple>
 #include <string>
+#include <chrono>
+#include <array>
+#include <numeric>
 
 namespace Belle2 {
   class ModuleParamList;
@@ -69,6 +73,57 @@ namespace Belle2 {
 
       /// Main function executing the algorithm
       virtual void apply(ToVector<AIOTypes>& ... ioVectors) = 0;
+
+      /**
+       *  Execute the algorithm and record its time, calls and collection sizes
+       *  if FindletStatistics are currently recorded.
+       *  Otherwise this is a plain call to apply.
+       */
+      void applyWithStatistics(ToVector<AIOTypes>& ... ioVectors)
+      {
+        FindletStatistics* findletStatistics = FindletStatistics::getRecording();
+        if (not findletStatistics) {
+          this->apply(ioVectors...);
+          return;
+        }
+
+        if (m_statisticsName.empty()) m_statisticsName = this->getDescription();
+        const std::array<unsigned long, sizeof...(AIOTypes)> inputSizes{{ioVectors.size()...}};
+        const unsigned long nInputs = std::accumulate(inputSizes.begin(), inputSizes.end(), 0ul);
+
+        findletStatistics->enter(m_statisticsName);
+        const auto start = std::chrono::steady_clock::now();
+        try {
+          this->apply(ioVectors...);
+        } catch (...) {
+          findletStatistics->leave(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), nInputs, 0);
+          throw;
+        }
+        const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const std::array<unsigned long, sizeof...(AIOTypes)> outputSizes{{getNOutputs(ioVectors)...}};
+        const unsigned long nOutputs = std::accumulate(outputSizes.begin(), outputSizes.end(), 0ul);
+        findletStatistics->leave(time, nInputs, nOutputs);
+      }
+
+    private:
+      /// Size of a mutable vector after the call
+      template<class T>
+      static unsigned long getNOutputs(std::vector<T>& outputVector)
+      {
+        return outputVector.size();
+      }
+
+      /// Immutable vectors do not count as output
+      template<class T>
+      static unsigned long getNOutputs(const std::vector<T>& inputVector __attribute__((unused)))
+      {
+        return 0;
+      }
+
+    private:
+      /// Name under which the statistics of this findlet are recorded
+      std::string m_statisticsName;
     };
   }
 }
@@ -10,9 +10,13 @@
 #include <tracking/trackFindingCDC/rootification/StoreWrappedObjPtr.h>
 
 #include <tracking/trackFindingCDC/utilities/EvalVariadic.h>
+#include <tracking/trackFindingCDC/utilities/FindletStatistics.h>
 
+#include <framework/core/EventTimeBudget.h>
 #include <framework/core/Module.h>
 #include <framework/core/ModuleParamList.h>
+#include <framework/datastore/StoreObjPtr.h>
+#include <framework/pcore/ProcHandler.h>
 
 #include <utility>
 #include <vector>
@@ -81,6 +85,17 @@ namespace Belle2 {
 
         this->addStoreVectorParameters(Indices());
 
+        this->addParam("recordFindletStatistics",
+                       m_param_recordFindletStatistics,
+                       "Record time, calls and collection sizes of the nested findlets",
+                       m_param_recordFindletStatistics);
+
+        this->addParam("findletStatisticsFileName",
+                       m_param_findletStatisticsFileName,
+                       "Name of the file to which the findlet statistics are written in the collapsed stack format "
+                       "used by flame graph tools. No file is written if empty.",
+                       m_param_findletStatisticsFileName);
+
         ModuleParamList moduleParamList = this->getParamList();
 
         const std::string prefix = "";
@@ -97,6 +112,10 @@ namespace Belle2 {
       {
         Super::initialize();
         this->requireOrRegisterStoreVectors(Indices());
+        if (m_param_recordFindletStatistics) {
+          m_findletStatistics.registerInDataStore(this->getName() + "FindletStatistics");
+          if (not m_findletStatistics.isValid()) m_findletStatistics.create();
+        }
         m_findlet.initialize();
       }
 
@@ -112,7 +131,19 @@ namespace Belle2 {
       {
         m_findlet.beginEvent();
         this->createStoreVectors(Indices());
-        applyFindlet(Indices());
+        // Checkpoint of the event time budget: the findlet is applied completely or not at all,
+        // as skipping single sub findlets (e.g. exporters) would leave inconsistent outputs
+        if (EventTimeBudget::isExceeded()) {
+          this->clearOutputStoreVectors(Indices());
+          return;
+        }
+        if (m_param_recordFindletStatistics) {
+          FindletStatistics::setRecording(&*m_findletStatistics);
+          applyFindlet(Indices());
+          FindletStatistics::setRecording(nullptr);
+        } else {
+          applyFindlet(Indices());
+        }
       }
 
       /// Signal the end of the run.
@@ -126,6 +157,13 @@ namespace Belle2 {
       virtual void terminate() override
       {
         m_findlet.terminate();
+        if (m_param_recordFindletStatistics and m_findletStatistics.isValid() and
+            (not ProcHandler::parallelProcessingUsed() or ProcHandler::isOutputProcess())) {
+          B2INFO("Findlet statistics of " << this->getName() << ":\n" << m_findletStatistics->getStatisticsString());
+          if (not m_param_findletStatisticsFileName.empty()) {
+            m_findletStatistics->writeCollapsedStacks(m_param_findletStatisticsFileName);
+          }
+        }
         Super::terminate();
       }
 
@@ -134,7 +172,7 @@ namespace Belle2 {
       template <size_t... Is>
       void applyFindlet(std::index_sequence<Is...>)
       {
-        m_findlet.apply(*(getStoreVector<Is>())...);
+        m_findlet.applyWithStatistics(*(getStoreVector<Is>())...);
       }
 
       /// Create the vectors on the DataStore
@@ -144,6 +182,13 @@ namespace Belle2 {
         evalVariadic((createStoreVector<Is>(), std::ignore)...);
       }
 
+      /// Clear the output vectors on the DataStore
+      template <size_t... Is>
+      void clearOutputStoreVectors(std::index_sequence<Is...>)
+      {
+        evalVariadic((clearOutputStoreVector<Is>(), std::ignore)...);
+      }
+
       /// Require or register the vectors on the DataStore
       template <size_t... Is>
       void requireOrRegisterStoreVectors(std::index_sequence<Is...>)
@@ -183,6 +228,15 @@ namespace Belle2 {
         }
       }
 
+      /** Clear the vector with index I on the DataStore if it is an output of the findlet.*/
+      template<std::size_t I>
+      void clearOutputStoreVector()
+      {
+        if (not isInputStoreVector<I>()) {
+          getStoreVector<I>()->clear();
+        }
+      }
+
       /** Get the vector with index I from the DataStore.*/
       template<std::size_t I>
       StoreVector<I> getStoreVector()
@@ -297,6 +351,15 @@ namespace Belle2 {
       /// Parameters : Names of the vectors on the DataStore
       std::array<std::string, c_nTypes> m_param_storeVectorNames;
 
+      /// Parameter : Switch to record the statistics of the nested findlets
+      bool m_param_recordFindletStatistics = false;
+
+      /// Parameter : File to write the findlet statistics to
+      std::string m_param_findletStatisticsFileName = "";
+
+      /// Statistics of the nested findlets, merged over all processes
+      StoreObjPtr<FindletStatistics> m_findletStatistics{"", DataStore::c_Persistent};
+
       /// Findlet that implements the algorithm to be executed.
       AFindlet m_findlet;
     };
@@ -58,7 +58,7 @@ void AxialStraightTrackFinder::apply(const std::vector<CDCWireHit>& wireHits,
     axialWireHits.emplace_back(&wireHit);
   }
 
-  m_axialStraightTrackCreator.apply(clusters, axialWireHits, tracks);
+  m_axialStraightTrackCreator.applyWithStatistics(clusters, axialWireHits, tracks);
 
 //   AxialTrackUtil::deleteShortTracks(tracks);
 }
@@ -86,22 +86,22 @@ void AxialTrackFinderHough::apply(const std::vector<CDCWireHit>& wireHits,
   }
 
   // Fine hough search
-  m_fineHoughSearch.apply(axialWireHits, tracks);
+  m_fineHoughSearch.applyWithStatistics(axialWireHits, tracks);
 
   // One step of migrating hits between the already found tracks
-  m_axialTrackHitMigrator.apply(axialWireHits, tracks);
+  m_axialTrackHitMigrator.applyWithStatistics(axialWireHits, tracks);
 
   // Rough hough search
-  m_roughHoughSearch.apply(axialWireHits, tracks);
+  m_roughHoughSearch.applyWithStatistics(axialWireHits, tracks);
 
   // One step of migrating hits between the already found tracks
-  m_axialTrackHitMigrator.apply(axialWireHits, tracks);
+  m_axialTrackHitMigrator.applyWithStatistics(axialWireHits, tracks);
 
   // Do track merging and finalization steps
-  m_axialTrackMerger.apply(tracks, axialWireHits);
+  m_axialTrackMerger.applyWithStatistics(tracks, axialWireHits);
 
   // Last step of migrating hits between the already found tracks
-  m_axialTrackHitMigrator.apply(axialWireHits, tracks);
+  m_axialTrackHitMigrator.applyWithStatistics(axialWireHits, tracks);
 
 }
 
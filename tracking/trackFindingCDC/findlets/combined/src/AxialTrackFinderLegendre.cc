@@ -56,16 +56,16 @@ void AxialTrackFinderLegendre::apply(const std::vector<CDCWireHit>& wireHits,
   }
 
   // First legendre pass
-  m_nonCurlerAxialTrackCreatorHitLegendre.apply(axialWireHits, tracks);
+  m_nonCurlerAxialTrackCreatorHitLegendre.applyWithStatistics(axialWireHits, tracks);
 
   // Assign new hits to the tracks
-  m_axialTrackHitMigrator.apply(axialWireHits, tracks);
+  m_axialTrackHitMigrator.applyWithStatistics(axialWireHits, tracks);
 
   // Second legendre pass
-  m_nonCurlersWithIncreasingThresholdAxialTrackCreatorHitLegendre.apply(axialWireHits, tracks);
+  m_nonCurlersWithIncreasingThresholdAxialTrackCreatorHitLegendre.applyWithStatistics(axialWireHits, tracks);
 
   // Assign new hits to the tracks
-  m_axialTrackHitMigrator.apply(axialWireHits, tracks);
+  m_axialTrackHitMigrator.applyWithStatistics(axialWireHits, tracks);
 
   // Iterate the last finding pass until no track is found anymore
 
@@ -74,10 +74,10 @@ void AxialTrackFinderLegendre::apply(const std::vector<CDCWireHit>& wireHits,
     int nCandsAdded = tracks.size();
 
     // Third legendre pass
-    m_fullRangeAxialTrackCreatorHitLegendre.apply(axialWireHits, tracks);
+    m_fullRangeAxialTrackCreatorHitLegendre.applyWithStatistics(axialWireHits, tracks);
 
     // Assign new hits to the tracks
-    m_axialTrackHitMigrator.apply(axialWireHits, tracks);
+    m_axialTrackHitMigrator.applyWithStatistics(axialWireHits, tracks);
 
     nCandsAdded = tracks.size() - nCandsAdded;
 
@@ -86,10 +86,10 @@ void AxialTrackFinderLegendre::apply(const std::vector<CDCWireHit>& wireHits,
   }
 
   // Merge found tracks
-  m_axialTrackMerger.apply(tracks, axialWireHits);
+  m_axialTrackMerger.applyWithStatistics(tracks, axialWireHits);
 
   // Assign new hits to the tracks
-  m_axialTrackHitMigrator.apply(axialWireHits, tracks);
+  m_axialTrackHitMigrator.applyWithStatistics(axialWireHits, tracks);
 
   AxialTrackUtil::deleteShortTracks(tracks);
 }
@@ -38,7 +38,7 @@ void ClusterPreparer::apply(std::vector<CDCWireHit>& inputWireHits,
   clusters.reserve(100);
   superClusters.reserve(50);
 
-  m_superClusterCreator.apply(inputWireHits, superClusters);
-  m_clusterRefiner.apply(superClusters, clusters);
-  m_clusterBackgroundDetector.apply(clusters);
+  m_superClusterCreator.applyWithStatistics(inputWireHits, superClusters);
+  m_clusterRefiner.applyWithStatistics(superClusters, clusters);
+  m_clusterBackgroundDetector.applyWithStatistics(clusters);
 }
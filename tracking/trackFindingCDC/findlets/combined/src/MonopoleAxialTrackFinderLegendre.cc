@@ -46,7 +46,7 @@ void MonopoleAxialTrackFinderLegendre::apply(const std::vector<CDCWireHit>& wire
   }
 
   // Legendre pass
-  m_straightMonopoleAxialTrackCreatorHitLegendre.apply(axialWireHits, tracks);
+  m_straightMonopoleAxialTrackCreatorHitLegendre.applyWithStatistics(axialWireHits, tracks);
 
 //   AxialTrackUtil::deleteShortTracks(tracks);
 }
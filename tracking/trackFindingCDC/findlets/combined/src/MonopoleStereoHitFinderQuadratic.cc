@@ -61,12 +61,12 @@ void MonopoleStereoHitFinderQuadratic::apply(std::vector<CDCWireHit>& inputWireH
   m_rlTaggedWireHits.reserve(2 * inputWireHits.size());
   m_relations.reserve(2 * inputWireHits.size() * tracks.size());
 
-  m_rlWireHitCreator.apply(inputWireHits, m_rlTaggedWireHits);
-  m_matcher.apply(tracks, m_rlTaggedWireHits, m_relations);
+  m_rlWireHitCreator.applyWithStatistics(inputWireHits, m_rlTaggedWireHits);
+  m_matcher.applyWithStatistics(tracks, m_rlTaggedWireHits, m_relations);
 //   m_filterSelector.apply(m_relations);
-  m_singleMatchSelector.apply(m_relations);
-  m_adder.apply(m_relations);
-  m_inspector.apply(tracks);
+  m_singleMatchSelector.applyWithStatistics(m_relations);
+  m_adder.applyWithStatistics(m_relations);
+  m_inspector.applyWithStatistics(tracks);
 
   for (auto track : tracks)
     track.sortByArcLength2D();
@@ -71,25 +71,25 @@ void SegmentFinderFacetAutomaton::apply(std::vector<CDCWireHitCluster>& clusters
 {
   outputSegments.reserve(200);
 
-  m_facetCreator.apply(clusters, m_facets);
+  m_facetCreator.applyWithStatistics(clusters, m_facets);
 
   std::vector<const CDCFacet*> facetPtrs = as_pointers<const CDCFacet>(m_facets);
-  m_facetRelationCreator.apply(facetPtrs, m_facetRelations);
+  m_facetRelationCreator.applyWithStatistics(facetPtrs, m_facetRelations);
   if (m_facetRelations.size() == 0) return; // Break point for facet recording runs
 
-  m_segmentCreatorFacetAutomaton.apply(m_facets, m_facetRelations, m_segments);
-  m_segmentFitter.apply(m_segments);
+  m_segmentCreatorFacetAutomaton.applyWithStatistics(m_facets, m_facetRelations, m_segments);
+  m_segmentFitter.applyWithStatistics(m_segments);
 
-  m_segmentOrienter.apply(m_segments, m_intermediateSegments);
-  m_segmentFitter.apply(m_intermediateSegments);
+  m_segmentOrienter.applyWithStatistics(m_segments, m_intermediateSegments);
+  m_segmentFitter.applyWithStatistics(m_intermediateSegments);
 
-  m_segmentAliasResolver.apply(m_intermediateSegments);
-  m_segmentFitter.apply(m_intermediateSegments);
+  m_segmentAliasResolver.applyWithStatistics(m_intermediateSegments);
+  m_segmentFitter.applyWithStatistics(m_intermediateSegments);
 
-  m_segmentLinker.apply(m_intermediateSegments, outputSegments);
-  m_segmentFitter.apply(outputSegments);
-  m_segmentFitter.apply(outputSegments);
+  m_segmentLinker.applyWithStatistics(m_intermediateSegments, outputSegments);
+  m_segmentFitter.applyWithStatistics(outputSegments);
+  m_segmentFitter.applyWithStatistics(outputSegments);
 
   // Move facets to the DataStore
-  m_facetSwapper.apply(m_facets);
+  m_facetSwapper.applyWithStatistics(m_facets);
 }
@@ -64,7 +64,7 @@ void SegmentTrackCombiner::exposeParameters(ModuleParamList* moduleParamList, co
 void SegmentTrackCombiner::apply(std::vector<TrackFindingCDC::CDCSegment2D>& segments,
                                  std::vector<TrackFindingCDC::CDCTrack>& tracks)
 {
-  m_trackNormalizer.apply(tracks);
+  m_trackNormalizer.applyWithStatistics(tracks);
 
   // Add a precut to add segments which are fully taken immediately at this stage
   for (const CDCSegment2D& segment : segments) {
@@ -76,20 +76,20 @@ void SegmentTrackCombiner::apply(std::vector<TrackFindingCDC::CDCSegment2D>& seg
   }
 
   // After that, relations contains all pairs of segments and tracks, with the number of shared hits as weight
-  m_sharedHitsMatcher.apply(tracks, segments, m_relations);
+  m_sharedHitsMatcher.applyWithStatistics(tracks, segments, m_relations);
 
   // Require a certain (definable) amount of shared hits between segments and tracks
-  m_selectPairsWithSharedHits.apply(m_relations);
+  m_selectPairsWithSharedHits.applyWithStatistics(m_relations);
 
   // Apply a (mva) filter to all combinations
-  m_chooseableSegmentTrackSelector.apply(m_relations);
+  m_chooseableSegmentTrackSelector.applyWithStatistics(m_relations);
 
   // Search for the best combinations
-  m_singleMatchSelector.apply(m_relations);
+  m_singleMatchSelector.applyWithStatistics(m_relations);
 
   // Add those combinations and remove all hits, that are part of other tracks (non-selected combinations)
-  m_segmentTrackAdderWithNormalization.apply(m_relations, tracks, segments);
+  m_segmentTrackAdderWithNormalization.applyWithStatistics(m_relations, tracks, segments);
 
   // Reject tracks according to a (mva) filter
-  m_trackRejecter.apply(tracks);
+  m_trackRejecter.applyWithStatistics(tracks);
 }
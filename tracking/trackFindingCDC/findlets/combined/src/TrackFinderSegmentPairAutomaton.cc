@@ -65,19 +65,19 @@ void TrackFinderSegmentPairAutomaton::beginEvent()
 void TrackFinderSegmentPairAutomaton::apply(const std::vector<CDCSegment2D>& inputSegments,
                                             std::vector<CDCTrack>& tracks)
 {
-  m_segmentPairCreator.apply(inputSegments, m_segmentPairs);
+  m_segmentPairCreator.applyWithStatistics(inputSegments, m_segmentPairs);
 
   std::vector<const CDCSegmentPair*> segmentPairPtrs =
     as_pointers<const CDCSegmentPair>(m_segmentPairs);
-  m_segmentPairRelationCreator.apply(segmentPairPtrs, m_segmentPairRelations);
+  m_segmentPairRelationCreator.applyWithStatistics(segmentPairPtrs, m_segmentPairRelations);
 
-  m_trackCreatorSegmentPairAutomaton.apply(m_segmentPairs, m_segmentPairRelations, m_preLinkingTracks);
+  m_trackCreatorSegmentPairAutomaton.applyWithStatistics(m_segmentPairs, m_segmentPairRelations, m_preLinkingTracks);
 
-  m_trackCreatorSingleSegments.apply(inputSegments, m_preLinkingTracks);
+  m_trackCreatorSingleSegments.applyWithStatistics(inputSegments, m_preLinkingTracks);
 
-  m_trackOrienter.apply(m_preLinkingTracks, m_orientedTracks);
-  m_trackLinker.apply(m_orientedTracks, tracks);
+  m_trackOrienter.applyWithStatistics(m_preLinkingTracks, m_orientedTracks);
+  m_trackLinker.applyWithStatistics(m_orientedTracks, tracks);
 
   // Put the segment pairs on the DataStore
-  m_segmentPairSwapper.apply(m_segmentPairs);
+  m_segmentPairSwapper.applyWithStatistics(m_segmentPairs);
 }
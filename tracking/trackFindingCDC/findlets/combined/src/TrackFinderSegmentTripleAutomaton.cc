@@ -61,20 +61,20 @@ void TrackFinderSegmentTripleAutomaton::beginEvent()
 void TrackFinderSegmentTripleAutomaton::apply(const std::vector<CDCSegment2D>& inputSegments,
                                               std::vector<CDCTrack>& tracks)
 {
-  m_axialSegmentPairCreator.apply(inputSegments, m_axialSegmentPairs);
+  m_axialSegmentPairCreator.applyWithStatistics(inputSegments, m_axialSegmentPairs);
 
-  m_segmentTripleCreator.apply(inputSegments, m_axialSegmentPairs, m_segmentTriples);
+  m_segmentTripleCreator.applyWithStatistics(inputSegments, m_axialSegmentPairs, m_segmentTriples);
 
   std::vector<const CDCSegmentTriple*> segmentTriplePtrs =
     as_pointers<const CDCSegmentTriple>(m_segmentTriples);
-  m_segmentTripleRelationCreator.apply(segmentTriplePtrs, m_segmentTripleRelations);
+  m_segmentTripleRelationCreator.applyWithStatistics(segmentTriplePtrs, m_segmentTripleRelations);
 
-  m_trackCreatorSegmentTripleAutomaton.apply(m_segmentTriples, m_segmentTripleRelations, m_preLinkingTracks);
+  m_trackCreatorSegmentTripleAutomaton.applyWithStatistics(m_segmentTriples, m_segmentTripleRelations, m_preLinkingTracks);
 
-  m_trackCreatorSingleSegments.apply(inputSegments, m_preLinkingTracks);
-  m_trackOrienter.apply(m_preLinkingTracks, m_orientedTracks);
-  m_trackLinker.apply(m_orientedTracks, tracks);
+  m_trackCreatorSingleSegments.applyWithStatistics(inputSegments, m_preLinkingTracks);
+  m_trackOrienter.applyWithStatistics(m_preLinkingTracks, m_orientedTracks);
+  m_trackLinker.applyWithStatistics(m_orientedTracks, tracks);
 
   // Put the segment triples on the DataStore
-  m_segmentTripleSwapper.apply(m_segmentTriples);
+  m_segmentTripleSwapper.applyWithStatistics(m_segmentTriples);
 }
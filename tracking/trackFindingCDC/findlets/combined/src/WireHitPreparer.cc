@@ -35,9 +35,9 @@ void WireHitPreparer::exposeParameters(ModuleParamList* moduleParamList, const s
 
 void WireHitPreparer::apply(std::vector<CDCWireHit>& outputWireHits)
 {
-  m_wireHitCreator.apply(outputWireHits);
-  m_wireHitBackgroundBlocker.apply(outputWireHits);
-  m_wireHitBackgroundDetector.apply(outputWireHits);
-  m_wireHitMCMultiLoopBlocker.apply(outputWireHits);
-  m_asicBackgroundDetector.apply(outputWireHits);
+  m_wireHitCreator.applyWithStatistics(outputWireHits);
+  m_wireHitBackgroundBlocker.applyWithStatistics(outputWireHits);
+  m_wireHitBackgroundDetector.applyWithStatistics(outputWireHits);
+  m_wireHitMCMultiLoopBlocker.applyWithStatistics(outputWireHits);
+  m_asicBackgroundDetector.applyWithStatistics(outputWireHits);
 }
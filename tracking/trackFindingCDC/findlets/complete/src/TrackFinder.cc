@@ -98,28 +98,28 @@ void TrackFinder::apply()
   m_axialTracks.reserve(30);
   m_tracks.reserve(30);
 
-  m_wireHitPreparer.apply(m_wireHits);
-  m_clusterPreparer.apply(m_wireHits, m_clusters, m_superClusters);
-  m_segmentFinderFacetAutomaton.apply(m_clusters, m_segments);
+  m_wireHitPreparer.applyWithStatistics(m_wireHits);
+  m_clusterPreparer.applyWithStatistics(m_wireHits, m_clusters, m_superClusters);
+  m_segmentFinderFacetAutomaton.applyWithStatistics(m_clusters, m_segments);
 
-  m_axialTrackFinderLegendre.apply(m_wireHits, m_axialTracks);
-  m_trackQualityAsserter.apply(m_axialTracks);
+  m_axialTrackFinderLegendre.applyWithStatistics(m_wireHits, m_axialTracks);
+  m_trackQualityAsserter.applyWithStatistics(m_axialTracks);
 
-  m_stereoHitFinder.apply(m_wireHits, m_axialTracks);
-  m_segmentTrackCombiner.apply(m_segments, m_axialTracks);
+  m_stereoHitFinder.applyWithStatistics(m_wireHits, m_axialTracks);
+  m_segmentTrackCombiner.applyWithStatistics(m_segments, m_axialTracks);
 
   if (m_param_withCA) {
-    m_trackFinderSegmentPairAutomaton.apply(m_segments, m_tracks);
-    m_trackCombiner.apply(m_axialTracks, m_tracks, m_tracks);
+    m_trackFinderSegmentPairAutomaton.applyWithStatistics(m_segments, m_tracks);
+    m_trackCombiner.applyWithStatistics(m_axialTracks, m_tracks, m_tracks);
   } else {
     m_tracks.swap(m_axialTracks);
   }
 
-  m_finalTrackQualityAsserter.apply(m_tracks);
+  m_finalTrackQualityAsserter.applyWithStatistics(m_tracks);
 
   if (m_param_withCA) {
-    m_trackCreatorSingleSegments.apply(m_segments, m_tracks);
+    m_trackCreatorSingleSegments.applyWithStatistics(m_segments, m_tracks);
   }
 
-  m_trackExporter.apply(m_tracks);
+  m_trackExporter.applyWithStatistics(m_tracks);
 }
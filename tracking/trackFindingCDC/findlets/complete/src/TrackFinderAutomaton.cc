@@ -76,19 +76,19 @@ void TrackFinderAutomaton::beginEvent()
 void TrackFinderAutomaton::apply()
 {
   // Aquire the wire hits, segments and tracks from the DataStore in case they have already been created
-  m_wireHitsSwapper.apply(m_wireHits);
-  m_segmentsSwapper.apply(m_segments);
-  m_tracksSwapper.apply(m_tracks);
+  m_wireHitsSwapper.applyWithStatistics(m_wireHits);
+  m_segmentsSwapper.applyWithStatistics(m_segments);
+  m_tracksSwapper.applyWithStatistics(m_tracks);
 
-  m_wireHitPreparer.apply(m_wireHits);
-  m_clusterPreparer.apply(m_wireHits, m_clusters, m_superClusters);
-  m_segmentFinderFacetAutomaton.apply(m_clusters, m_segments);
-  m_trackFinderSegmentPairAutomaton.apply(m_segments, m_tracks);
-  m_trackFlightTimeAdjuster.apply(m_tracks);
-  m_trackExporter.apply(m_tracks);
+  m_wireHitPreparer.applyWithStatistics(m_wireHits);
+  m_clusterPreparer.applyWithStatistics(m_wireHits, m_clusters, m_superClusters);
+  m_segmentFinderFacetAutomaton.applyWithStatistics(m_clusters, m_segments);
+  m_trackFinderSegmentPairAutomaton.applyWithStatistics(m_segments, m_tracks);
+  m_trackFlightTimeAdjuster.applyWithStatistics(m_tracks);
+  m_trackExporter.applyWithStatistics(m_tracks);
 
   // Put the segments and tracks on the DataStore
-  m_wireHitsSwapper.apply(m_wireHits);
-  m_segmentsSwapper.apply(m_segments);
-  m_tracksSwapper.apply(m_tracks);
+  m_wireHitsSwapper.applyWithStatistics(m_wireHits);
+  m_segmentsSwapper.applyWithStatistics(m_segments);
+  m_tracksSwapper.applyWithStatistics(m_tracks);
 }
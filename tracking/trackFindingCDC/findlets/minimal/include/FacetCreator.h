@@ -14,6 +14,7 @@
 #include <tracking/trackFindingCDC/filters/wireHitRelation/BridgingWireHitRelationFilter.h>
 
 #include <tracking/trackFindingCDC/eventdata/utils/DriftLengthEstimator.h>
+#include <tracking/trackFindingCDC/eventdata/hits/CDCFacet.h>
 
 #include <tracking/trackFindingCDC/utilities/WeightedRelation.h>
 
@@ -24,7 +25,6 @@ namespace Belle2 {
 
 
   namespace TrackFindingCDC {
-    class CDCFacet;
     class CDCWireHitCluster;
 
     /// Class providing construction combinatorics for the facets.
@@ -55,15 +55,16 @@ namespace Belle2 {
 
     private:
       /**
-       *  Generates facets on the given wire hits generating neighboring triples of hits.
+       *  Generates facet candidates on the given wire hits generating neighboring triples of hits.
        *  Inserts the result to the end of the GenericFacetCollection.
+       *  The candidates still have to be evaluated by the facet filter.
        */
       void createFacets(const std::vector<CDCWireHit*>& wireHits,
                         const std::vector<WeightedRelation<CDCWireHit> >& wireHitRelations,
                         std::vector<CDCFacet>& facets);
 
       /**
-       *  Generates reconstruted facets on the three given wire hits by hypothesizing
+       *  Generates reconstruted facet candidates on the three given wire hits by hypothesizing
        *  over the 8 left right passage combinations.
        *  Inserts the result to the end of the GenericFacetCollection.
        */
@@ -97,6 +98,9 @@ namespace Belle2 {
     private:
       /// Memory for the wire hit neighborhood in within a cluster.
       std::vector<WeightedRelation<CDCWireHit> > m_wireHitRelations;
+
+      /// Memory for the facet candidates within a cluster, which are evaluated by the facet filter in one batch.
+      std::vector<CDCFacet> m_candidateFacets;
     };
   }
 }
@@ -76,9 +76,25 @@ void FacetCreator::apply(const std::vector<CDCWireHitCluster>& inputClusters, st
     B2ASSERT("Wire neighborhood is not symmetric. Check the geometry.",
              WeightedRelationUtil<CDCWireHit>::areSymmetric(m_wireHitRelations));
 
-    // Create the facets
+    // Create the facet candidates
+    m_candidateFacets.clear();
+    createFacets(cluster, m_wireHitRelations, m_candidateFacets);
+
+    // Evaluate all candidates of the cluster in one batch and keep the accepted ones
+    std::vector<const CDCFacet*> candidateFacetPtrs;
+    candidateFacetPtrs.reserve(m_candidateFacets.size());
+    for (const CDCFacet& candidateFacet : m_candidateFacets) {
+      candidateFacetPtrs.push_back(&candidateFacet);
+    }
+    std::vector<Weight> weights = m_facetFilter(candidateFacetPtrs);
+
     std::size_t nBefore = facets.size();
-    createFacets(cluster, m_wireHitRelations, facets);
+    for (std::size_t iCandidate = 0; iCandidate < m_candidateFacets.size(); ++iCandidate) {
+      if (std::isnan(weights[iCandidate])) continue;
+      CDCFacet& facet = m_candidateFacets[iCandidate];
+      facet.getAutomatonCell().setCellWeight(weights[iCandidate]);
+      facets.push_back(std::move(facet));
+    }
     std::size_t nAfter = facets.size();
 
     VectorRange<CDCFacet> facetsInCluster(facets.begin() + nBefore, facets.begin() + nAfter);
@@ -175,12 +191,8 @@ void FacetCreator::createFacetsForHitTriple(const CDCWireHit& startWireHit,
           m_driftLengthEstimator.updateDriftLength(facet);
         }
 
-        Weight weight = m_facetFilter(facet);
-
-        if (not std::isnan(weight)) {
-          facet.getAutomatonCell().setCellWeight(weight);
-          facets.insert(facets.end(), facet);
-        }
+        // The facet filter is applied to all candidates of the cluster at once
+        facets.insert(facets.end(), facet);
       } // end for endRLWireHit
     } // end for middleRLWireHit
   } // end for startRLWireHit
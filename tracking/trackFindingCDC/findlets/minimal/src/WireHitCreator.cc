@@ -219,7 +219,35 @@ void WireHitCreator::apply(std::vector<CDCWireHit>& outputWireHits)
 
   std::map<int, size_t> nHitsByMCParticleId;
 
-  outputWireHits.reserve(nHits);
+  // The hits are selected first and the drift lengths of all of them are translated in one batch.
+  // Each hit enters the batch twice, for the left and for the right passage.
+  std::vector<const CDCHit*> selectedHits;
+  std::vector<const CDCWire*> selectedWires;
+  std::vector<double> driftTimes;
+  std::vector<unsigned short> tdcCounts;
+  std::vector<WireID> wireIDs;
+  std::vector<double> flightTimeEstimates;
+  std::vector<bool> leftRights;
+  std::vector<double> refZs;
+  std::vector<double> alphas;
+  std::vector<double> thetas;
+  std::vector<unsigned short> adcCounts;
+  selectedHits.reserve(nHits);
+  selectedWires.reserve(nHits);
+  driftTimes.reserve(nHits);
+  tdcCounts.reserve(2 * nHits);
+  wireIDs.reserve(2 * nHits);
+  flightTimeEstimates.reserve(2 * nHits);
+  leftRights.reserve(2 * nHits);
+  refZs.reserve(2 * nHits);
+  alphas.reserve(2 * nHits);
+  thetas.reserve(2 * nHits);
+  adcCounts.reserve(2 * nHits);
+
+  const bool left = false;
+  const bool right = true;
+  const double theta = M_PI / 2;
+
   for (const CDCHit& hit : hits) {
 
     // ignore this hit if it contains the information of a 2nd hit
@@ -290,27 +318,36 @@ void WireHitCreator::apply(std::vector<CDCWireHit>& outputWireHits)
                                                               flightTimeEstimate,
                                                               wire.getRefZ(),
                                                               hit.getADCCount());
-    const bool left = false;
-    const bool right = true;
-    const double theta = M_PI / 2;
-
-    const double leftRefDriftLength =
-      tdcCountTranslator.getDriftLength(hit.getTDCCount(),
-                                        wire.getWireID(),
-                                        flightTimeEstimate,
-                                        left,
-                                        wire.getRefZ(),
-                                        alpha,
-                                        theta);
-
-    const double rightRefDriftLength =
-      tdcCountTranslator.getDriftLength(hit.getTDCCount(),
-                                        wire.getWireID(),
-                                        flightTimeEstimate,
-                                        right,
-                                        wire.getRefZ(),
-                                        alpha,
-                                        theta);
+
+    selectedHits.push_back(&hit);
+    selectedWires.push_back(&wire);
+    driftTimes.push_back(driftTime);
+    for (const bool leftRight : {left, right}) {
+      tdcCounts.push_back(hit.getTDCCount());
+      wireIDs.push_back(wire.getWireID());
+      flightTimeEstimates.push_back(flightTimeEstimate);
+      leftRights.push_back(leftRight);
+      refZs.push_back(wire.getRefZ());
+      alphas.push_back(alpha);
+      thetas.push_back(theta);
+      // the reference drift lengths are determined without the ADC count
+      adcCounts.push_back(0);
+    }
+  }
+
+  std::vector<double> refDriftLengths;
+  tdcCountTranslator.getDriftLengths(tdcCounts, wireIDs, flightTimeEstimates, leftRights, refZs, alphas, thetas, adcCounts,
+                                     refDriftLengths);
+
+  outputWireHits.reserve(selectedHits.size());
+  for (std::size_t iHit = 0; iHit < selectedHits.size(); ++iHit) {
+    const CDCHit& hit = *selectedHits[iHit];
+    const CDCWire& wire = *selectedWires[iHit];
+    const double driftTime = driftTimes[iHit];
+    const double alpha = alphas[2 * iHit];
+
+    const double leftRefDriftLength = refDriftLengths[2 * iHit];
+    const double rightRefDriftLength = refDriftLengths[2 * iHit + 1];
 
     const double refDriftLength =
       (leftRefDriftLength + rightRefDriftLength) / 2.0;
@@ -42,6 +42,20 @@ namespace Belle2 {
       /// Evaluate the MVA method and return the MVAOutput
       double predict();
 
+      /// Number of variables the mva method expects for each object, i.e. the row length of a batch
+      unsigned int getNFeatures() const;
+
+      /// Copy the current values of the variables fed to the mva method to the given row of a batch
+      void extractFeatures(float* features) const;
+
+      /**
+       *  Evaluate the MVA method for a batch of objects with a single call to the mva method.
+       *  @param features  Row-major matrix with the variables of one object per row, as filled by extractFeatures
+       *  @param nRows     Number of objects in the batch
+       *  @return          The MVAOutput of each object
+       */
+      std::vector<float> predict(const std::vector<float>& features, unsigned int nRows);
+
     private:
       /// Forward declartion of implementation.
       class Impl;
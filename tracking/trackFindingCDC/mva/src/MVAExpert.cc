@@ -33,6 +33,9 @@ namespace Belle2 {
       void beginRun(); /**< Called once before a new run begins */
       std::unique_ptr<MVA::Weightfile> getWeightFile(); /**< Get the weight file */
       double predict(); /**< Get the MVA prediction */
+      unsigned int getNFeatures() const; /**< Get the number of selected variables */
+      void extractFeatures(float* features) const; /**< Copy the selected variables to a row of a batch */
+      std::vector<float> predict(const std::vector<float>& features, unsigned int nRows); /**< Get the MVA predictions of a batch */
 
     private:
       /// References to the all named values from the source variable set.
@@ -50,6 +53,9 @@ namespace Belle2 {
       /// Pointer to the current dataset
       std::unique_ptr<MVA::Dataset> m_dataset;
 
+      /// General options of the current expert, needed to set up the dataset of a batch
+      MVA::GeneralOptions m_generalOptions;
+
       /// DB identifier of the expert or file name
       std::string m_identifier;
     };
@@ -58,15 +64,61 @@ namespace Belle2 {
 
 /** Impl Definitions **/
 #include <mva/interface/Interface.h>
+#include <mva/interface/Dataset.h>
 
 #include <framework/utilities/FileSystem.h>
 #include <framework/logging/Logger.h>
 
 #include <algorithm>
+#include <cmath>
 
 using namespace Belle2;
 using namespace TrackFindingCDC;
 
+namespace {
+  /// Dataset presenting the rows of a contiguous row-major feature matrix to the mva method without copying the matrix
+  class BatchDataset : public MVA::Dataset {
+
+  public:
+    /// Constructor from the matrix, which has to outlive the dataset
+    BatchDataset(const MVA::GeneralOptions& generalOptions, const std::vector<float>& features, unsigned int nFeatures,
+                 unsigned int nRows)
+      : MVA::Dataset(generalOptions)
+      , m_features(features)
+      , m_nFeatures(nFeatures)
+      , m_nRows(nRows)
+    {
+      m_input.resize(nFeatures);
+    }
+
+    /// Returns the number of features in this dataset
+    unsigned int getNumberOfFeatures() const override { return m_nFeatures; }
+
+    /// Returns the number of spectators in this dataset
+    unsigned int getNumberOfSpectators() const override { return 0; }
+
+    /// Returns the number of events in this dataset
+    unsigned int getNumberOfEvents() const override { return m_nRows; }
+
+    /// Loads the row of the given event into the input of the dataset
+    void loadEvent(unsigned int iEvent) override
+    {
+      auto itRow = m_features.begin() + iEvent * m_nFeatures;
+      std::copy(itRow, itRow + m_nFeatures, m_input.begin());
+    }
+
+  private:
+    /// Row-major matrix of the features
+    const std::vector<float>& m_features;
+
+    /// Number of features per row
+    unsigned int m_nFeatures;
+
+    /// Number of rows
+    unsigned int m_nRows;
+  };
+}
+
 MVAExpert::Impl::Impl(const std::string& identifier,
                       std::vector<Named<Float_t*> > namedVariables)
   : m_allNamedVariables(std::move(namedVariables))
@@ -129,6 +181,7 @@ void MVAExpert::Impl::beginRun()
     std::vector<float> dummy;
     dummy.resize(m_selectedNamedVariables.size(), 0);
     m_dataset = std::make_unique<MVA::SingleDataset>(generalOptions, std::move(dummy), 0);
+    m_generalOptions = generalOptions;
   } else {
     B2ERROR("Could not find weight file for identifier " << m_identifier);
   }
@@ -159,6 +212,32 @@ double MVAExpert::Impl::predict()
   return m_expert->apply(*m_dataset)[0];
 }
 
+unsigned int MVAExpert::Impl::getNFeatures() const
+{
+  return m_selectedNamedVariables.size();
+}
+
+void MVAExpert::Impl::extractFeatures(float* features) const
+{
+  for (unsigned int i = 0; i < m_selectedNamedVariables.size(); ++i) {
+    features[i] = *m_selectedNamedVariables[i];
+  }
+}
+
+std::vector<float> MVAExpert::Impl::predict(const std::vector<float>& features, unsigned int nRows)
+{
+  if (not m_expert) {
+    B2ERROR("MVA Expert is not loaded! I will return NAN");
+    return std::vector<float>(nRows, NAN);
+  }
+  if (nRows == 0) {
+    return {};
+  }
+
+  BatchDataset dataset(m_generalOptions, features, getNFeatures(), nRows);
+  return m_expert->apply(dataset);
+}
+
 /** PImpl Interface **/
 MVAExpert::MVAExpert(const std::string& identifier,
                      std::vector<Named<Float_t*> > namedVariables)
@@ -182,3 +261,18 @@ double MVAExpert::predict()
 {
   return m_impl->predict();
 }
+
+unsigned int MVAExpert::getNFeatures() const
+{
+  return m_impl->getNFeatures();
+}
+
+void MVAExpert::extractFeatures(float* features) const
+{
+  m_impl->extractFeatures(features);
+}
+
+std::vector<float> MVAExpert::predict(const std::vector<float>& features, unsigned int nRows)
+{
+  return m_impl->predict(features, nRows);
+}
@@ -0,0 +1,129 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#pragma once
+
+#include <framework/pcore/Mergeable.h>
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Belle2 {
+  namespace TrackFindingCDC {
+
+    /**
+     *  Call statistics of the findlets nested in a findlet module.
+     *
+     *  The statistics of each findlet are kept per call path, i.e. the descriptions of all findlets
+     *  on the call stack joined by ';'. Hence the same findlet used in two places appears twice.
+     *  The object is mergeable, such that the statistics of parallel workers are summed up if it
+     *  is stored with persistent durability in the DataStore.
+     *
+     *  Recording is switched on by setting an instance as the current recording,
+     *  which is done by the FindletModule if requested.
+     */
+    class FindletStatistics : public Mergeable {
+
+    public:
+      /// Accumulated statistics of one call path
+      struct Entry {
+        /// Number of calls
+        unsigned long nCalls = 0;
+
+        /// Total time spend in the calls including the nested findlets (seconds)
+        double time = 0;
+
+        /// Total number of elements in all vectors handed to the calls
+        unsigned long nInputs = 0;
+
+        /// Total number of elements in the mutable vectors after the calls
+        unsigned long nOutputs = 0;
+
+        /// Add the statistics of another entry
+        Entry& operator+=(const Entry& other)
+        {
+          nCalls += other.nCalls;
+          time += other.time;
+          nInputs += other.nInputs;
+          nOutputs += other.nOutputs;
+          return *this;
+        }
+      };
+
+    public:
+      /**
+       *  Get the statistics currently recording, nullptr if recording is switched off.
+       *  The recording is set per thread, as modules may run in parallel paths.
+       *  As long as no thread records, only a global counter is checked.
+       */
+      static FindletStatistics* getRecording()
+      {
+        if (s_nRecordingThreads.load(std::memory_order_relaxed) == 0) return nullptr;
+        return getRecordingInThread();
+      }
+
+      /// Set the statistics to be recorded to in the current thread, nullptr to switch off recording
+      static void setRecording(FindletStatistics* recording);
+
+      /// Descend into a call of the findlet with the given name
+      void enter(const std::string& name);
+
+      /// Return from the current call and add its statistics to the current call path
+      void leave(double time, unsigned long nInputs, unsigned long nOutputs);
+
+      /// Get the accumulated statistics by call path
+      const std::map<std::string, Entry>& getEntries() const
+      {
+        return m_entries;
+      }
+
+      /**
+       *  Get the statistics in the collapsed stack format understood by flame graph tools,
+       *  one line per call path with its exclusive time in microseconds.
+       */
+      std::string getCollapsedStacks() const;
+
+      /// Write the collapsed stacks to the given file
+      void writeCollapsedStacks(const std::string& fileName) const;
+
+      /// Get a human readable summary table of all call paths
+      std::string getStatisticsString() const;
+
+      /// Merge the statistics of another object into this one
+      void merge(const Mergeable* other) override;
+
+      /// Clear the accumulated statistics
+      void clear() override;
+
+    private:
+      /// Get the statistics currently recording in this thread
+      static FindletStatistics* getRecordingInThread();
+
+      /// Time spend in the call path excluding the direct sub calls
+      double getExclusiveTime(const std::string& path) const;
+
+    private:
+      /// Number of threads with a recording set
+      static std::atomic<int> s_nRecordingThreads;
+
+    private:
+      /// Accumulated statistics by call path
+      std::map<std::string, Entry> m_entries;
+
+      /// Call path of the findlet currently executed
+      std::string m_currentPath; //!
+
+      /// Lengths of the call path before each of the currently active calls
+      std::vector<std::size_t> m_pathLengths; //!
+
+      /// ROOT Macro to make FindletStatistics a ROOT class.
+      ClassDefOverride(FindletStatistics, 1);
+    };
+  }
+}
@@ -12,3 +12,6 @@
 // Other instances can be defined in other linkdef.h files.
 #pragma link C++ class Belle2::TrackFindingCDC::Relation<int, int>+; // checksum=0x4ceedc3e, version=-1
 #pragma link C++ class Belle2::TrackFindingCDC::WeightedRelation<int, int>+; // checksum=0x612ec9bc, version=-1
+
+#pragma link C++ class Belle2::TrackFindingCDC::FindletStatistics+; // checksum=0xb93fd275, version=1
+#pragma link C++ class Belle2::TrackFindingCDC::FindletStatistics::Entry+; // checksum=0x5de1e92, version=-1
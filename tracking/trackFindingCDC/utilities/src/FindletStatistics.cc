@@ -0,0 +1,146 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <tracking/trackFindingCDC/utilities/FindletStatistics.h>
+
+#include <framework/logging/Logger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace Belle2;
+using namespace TrackFindingCDC;
+
+namespace {
+  /// Statistics currently recording in this thread
+  thread_local FindletStatistics* s_recording = nullptr;
+}
+
+std::atomic<int> FindletStatistics::s_nRecordingThreads{0};
+
+FindletStatistics* FindletStatistics::getRecordingInThread()
+{
+  return s_recording;
+}
+
+void FindletStatistics::setRecording(FindletStatistics* recording)
+{
+  if (recording and not s_recording) ++s_nRecordingThreads;
+  if (not recording and s_recording) --s_nRecordingThreads;
+  s_recording = recording;
+}
+
+void FindletStatistics::enter(const std::string& name)
+{
+  m_pathLengths.push_back(m_currentPath.size());
+  if (not m_currentPath.empty()) m_currentPath += ';';
+  std::size_t nameStart = m_currentPath.size();
+  m_currentPath += name;
+  // The separator must not appear in the names
+  std::replace(m_currentPath.begin() + nameStart, m_currentPath.end(), ';', ',');
+}
+
+void FindletStatistics::leave(double time, unsigned long nInputs, unsigned long nOutputs)
+{
+  if (m_pathLengths.empty()) {
+    B2ERROR("Left more findlet calls than entered");
+    return;
+  }
+  Entry& entry = m_entries[m_currentPath];
+  entry.nCalls += 1;
+  entry.time += time;
+  entry.nInputs += nInputs;
+  entry.nOutputs += nOutputs;
+
+  m_currentPath.resize(m_pathLengths.back());
+  m_pathLengths.pop_back();
+}
+
+double FindletStatistics::getExclusiveTime(const std::string& path) const
+{
+  auto itEntry = m_entries.find(path);
+  if (itEntry == m_entries.end()) return 0;
+  double exclusiveTime = itEntry->second.time;
+
+  // All sub paths directly follow the path in the sorted map
+  const std::string prefix = path + ';';
+  for (auto itSub = m_entries.lower_bound(prefix); itSub != m_entries.end(); ++itSub) {
+    const std::string& subPath = itSub->first;
+    if (subPath.compare(0, prefix.size(), prefix) != 0) break;
+    if (subPath.find(';', prefix.size()) != std::string::npos) continue;
+    exclusiveTime -= itSub->second.time;
+  }
+  return std::max(exclusiveTime, 0.0);
+}
+
+std::string FindletStatistics::getCollapsedStacks() const
+{
+  std::ostringstream out;
+  for (const auto& pathAndEntry : m_entries) {
+    const double microSeconds = getExclusiveTime(pathAndEntry.first) * 1e6;
+    out << pathAndEntry.first << ' ' << static_cast<unsigned long>(std::llround(microSeconds)) << '\n';
+  }
+  return out.str();
+}
+
+void FindletStatistics::writeCollapsedStacks(const std::string& fileName) const
+{
+  std::ofstream outFile(fileName);
+  if (not outFile) {
+    B2ERROR("Could not open " << fileName << " to write the findlet statistics");
+    return;
+  }
+  outFile << getCollapsedStacks();
+}
+
+std::string FindletStatistics::getStatisticsString() const
+{
+  std::ostringstream out;
+  out << std::left << std::setw(60) << "Findlet" << std::right
+      << std::setw(10) << "Calls"
+      << std::setw(14) << "Time [ms]"
+      << std::setw(14) << "Self [ms]"
+      << std::setw(14) << "Inputs/call"
+      << std::setw(14) << "Outputs/call" << '\n';
+
+  for (const auto& pathAndEntry : m_entries) {
+    const std::string& path = pathAndEntry.first;
+    const Entry& entry = pathAndEntry.second;
+
+    const std::size_t depth = std::count(path.begin(), path.end(), ';');
+    const std::size_t nameStart = path.rfind(';') == std::string::npos ? 0 : path.rfind(';') + 1;
+    std::string name = std::string(2 * depth, ' ') + path.substr(nameStart);
+    if (name.size() > 58) name = name.substr(0, 55) + "...";
+
+    const double nCalls = std::max(entry.nCalls, 1ul);
+    out << std::left << std::setw(60) << name << std::right
+        << std::setw(10) << entry.nCalls
+        << std::fixed << std::setprecision(2)
+        << std::setw(14) << entry.time * 1e3
+        << std::setw(14) << getExclusiveTime(path) * 1e3
+        << std::setprecision(1)
+        << std::setw(14) << entry.nInputs / nCalls
+        << std::setw(14) << entry.nOutputs / nCalls << '\n';
+  }
+  return out.str();
+}
+
+void FindletStatistics::merge(const Mergeable* other)
+{
+  const auto* otherStatistics = static_cast<const FindletStatistics*>(other);
+  for (const auto& pathAndEntry : otherStatistics->m_entries) {
+    m_entries[pathAndEntry.first] += pathAndEntry.second;
+  }
+}
+
+void FindletStatistics::clear()
+{
+  m_entries.clear();
+}
@@ -0,0 +1,80 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <gtest/gtest.h>
+
+#include <tracking/trackFindingCDC/utilities/FindletStatistics.h>
+
+using namespace Belle2;
+using namespace TrackFindingCDC;
+
+namespace {
+  TEST(TrackFindingCDCTest, utilities_FindletStatistics_nested_calls)
+  {
+    FindletStatistics findletStatistics;
+    findletStatistics.enter("outer");
+    findletStatistics.enter("inner");
+    findletStatistics.leave(1.0, 10, 5);
+    findletStatistics.enter("inner");
+    findletStatistics.leave(2.0, 5, 1);
+    findletStatistics.enter("other;name");
+    findletStatistics.leave(0.5, 0, 0);
+    findletStatistics.leave(4.0, 10, 2);
+
+    const auto& entries = findletStatistics.getEntries();
+    ASSERT_EQ(3u, entries.size());
+
+    const FindletStatistics::Entry& inner = entries.at("outer;inner");
+    EXPECT_EQ(2u, inner.nCalls);
+    EXPECT_EQ(3.0, inner.time);
+    EXPECT_EQ(15u, inner.nInputs);
+    EXPECT_EQ(6u, inner.nOutputs);
+
+    // Separator in names is replaced
+    EXPECT_EQ(1u, entries.count("outer;other,name"));
+
+    // Collapsed stacks carry the exclusive time in microseconds
+    EXPECT_EQ("outer 500000\nouter;inner 3000000\nouter;other,name 500000\n", findletStatistics.getCollapsedStacks());
+  }
+
+  TEST(TrackFindingCDCTest, utilities_FindletStatistics_merge)
+  {
+    FindletStatistics first;
+    first.enter("outer");
+    first.leave(1.0, 1, 1);
+
+    FindletStatistics second;
+    second.enter("outer");
+    second.leave(2.0, 2, 2);
+    second.enter("another");
+    second.leave(1.0, 0, 0);
+
+    first.merge(&second);
+    const auto& entries = first.getEntries();
+    ASSERT_EQ(2u, entries.size());
+    EXPECT_EQ(2u, entries.at("outer").nCalls);
+    EXPECT_EQ(3.0, entries.at("outer").time);
+    EXPECT_EQ(1u, entries.at("another").nCalls);
+
+    first.clear();
+    EXPECT_TRUE(first.getEntries().empty());
+  }
+
+  TEST(TrackFindingCDCTest, utilities_FindletStatistics_recording)
+  {
+    EXPECT_EQ(nullptr, FindletStatistics::getRecording());
+
+    FindletStatistics findletStatistics;
+    FindletStatistics::setRecording(&findletStatistics);
+    EXPECT_EQ(&findletStatistics, FindletStatistics::getRecording());
+
+    // Setting the recording twice in the same thread does not count twice
+    FindletStatistics::setRecording(&findletStatistics);
+    FindletStatistics::setRecording(nullptr);
+    EXPECT_EQ(nullptr, FindletStatistics::getRecording());
+  }
+}
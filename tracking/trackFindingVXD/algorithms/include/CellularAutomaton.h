@@ -12,6 +12,11 @@
 namespace Belle2 {
   /** The CellularAutomaton class
    * This class serves as a functor for the algorithm itself
+   *
+   * Requirements for ContainerType:
+   * - must have function: NodeContainerType& getNodes(), returning the nodes of the finalized network
+   * - must have function: IndexRange getInnerNodeIndices(unsigned int), returning the positions of the inner
+   *   neighbours of a node in getNodes() (compact adjacency, see DirectedNodeNetwork)
    */
   template<class ContainerType, class ValidatorType>
   class CellularAutomaton final : public TrackerAlgorithmBase<ContainerType, ValidatorType> {
@@ -42,24 +47,30 @@ namespace Belle2 {
                    goodNeighbours = 0,
                    highestCellState = 0;
 
+      // the compact adjacency of the network is only valid for the finalized network, getNodes() takes care of that
+      auto& nodes = aNetworkContainer.getNodes();
+      const unsigned int nNodes = nodes.size();
+
       // each iteration of following while loop is one CA-time-step
       while (activeCells != 0 and caRound < stopInRound) {
         activeCells = 0;
 
         /// CAstep:
         // compare cells with inner neighbours:
-        for (auto* aNode : aNetworkContainer) {
-          auto& currentCell = aNode->getMetaInfo();
+        for (unsigned int iNode = 0; iNode < nNodes; ++iNode) {
+          auto& currentCell = nodes[iNode]->getMetaInfo();
           if (currentCell.isActivated() == false) { continue; }
           goodNeighbours = 0;
 
-          for (auto* aNeighbour :  aNode->getInnerNodes()) {
+          for (unsigned int iNeighbour : aNetworkContainer.getInnerNodeIndices(iNode)) {
             // skip if neighbour has not the same state (NOTE if one wants to improve the versatility of the code,
             // this should actually become a member of the cell-class, which then can add some extra
             // stuff like checking for loops.
-            if (currentCell != aNeighbour->getMetaInfo()) continue;
+            if (currentCell != nodes[iNeighbour]->getMetaInfo()) continue;
 
+            // one good neighbour is sufficient to allow the upgrade
             goodNeighbours++;
+            break;
           }
           if (goodNeighbours != 0) {
             currentCell.setStateUpgrade(true);
@@ -73,7 +84,7 @@ namespace Belle2 {
         }
 
         /// Updatestep:
-        for (auto* aNode : aNetworkContainer) {
+        for (auto* aNode : nodes) {
           auto& currentCell = aNode->getMetaInfo();
           if (currentCell.isActivated() == false or currentCell.isUpgradeAllowed() == false) { continue; }
 
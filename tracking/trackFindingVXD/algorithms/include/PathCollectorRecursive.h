@@ -21,16 +21,19 @@ namespace Belle2 {
    *
    * Requirements for ContainerType:
    * - must have begin() and end() with iterator pointing to pointers of entries ( = ContainerType< NodeType*>)
+   * - must have function: IndexRange getInnerNodeIndices(unsigned int), returning the indices of the inner neighbours
+   *   of a node (compact adjacency, see DirectedNodeNetwork)
+   * - must have function: NodeType* getNodeByIndex(unsigned int)
    *
    * Requirements for NodeType:
    * - must have function: bool NodeType::getMetaInfo().isSeed()
-   * - must have function: NeighbourContainerType& NodeType::getInnerNodes()
+   * - must have function: unsigned int NodeType::getIndex()
    * - must have function: bool NodeType::getOuterNodes().empty()
    * - other requirements depend on NodeCompatibilityCheckerType used.
    *
    * Requirements for NeighbourContainerType:
-   * - must have function: bool NeighbourContainerType::empty()
    * - must have function: unsigned int (or comparable) NeighbourContainerType::size()
+   * - must have functions: clear() and push_back(NodeType*)
    * - must have access operator:  NeighbourContainerType: operator [] returning a NodeType*
    *
    * Requirements for NodeCompatibilityCheckerType:
@@ -60,8 +63,7 @@ namespace Belle2 {
           continue;
         }
 
-        NeighbourContainerType& innerNeighbours = aNode->getInnerNodes();
-        if (innerNeighbours.empty()) {
+        if (aNetwork.getInnerNodeIndices(aNode->getIndex()).empty()) {
           continue;
         }
         if (aNode->getOuterNodes().empty()) {
@@ -71,7 +73,7 @@ namespace Belle2 {
         // creating unique_ptr of a new path:
         Path newPath = Path{aNode};
 
-        findPathsRecursive(allNodePaths, newPath, innerNeighbours);
+        findPathsRecursive(aNetwork, allNodePaths, newPath);
         storeAcceptedPath(newPath, allNodePaths);
 
         if (allNodePaths.size() > pathLimit) {
@@ -79,7 +81,7 @@ namespace Belle2 {
           return false;
         }
       }
-      paths = allNodePaths;
+      paths = std::move(allNodePaths);
       return true;
     }
 
@@ -129,7 +131,7 @@ namespace Belle2 {
 
 
     /// Recursive pathFinder: Collects all possible segment combinations to build paths.
-    void findPathsRecursive(std::vector<Path >& allNodePaths, Path& currentPath, NeighbourContainerType& innerNeighbours)
+    void findPathsRecursive(ContainerType& aNetwork, std::vector<Path >& allNodePaths, Path& currentPath)
     {
       nRecursiveCalls++;
 
@@ -138,11 +140,13 @@ namespace Belle2 {
         return;
       }
 
-      // Test if there are viable neighbours to current node
+      // Test if there are viable neighbours to current node, the inner neighbours are taken from the compact adjacency
+      NodeType* currentNode = currentPath.back();
       NeighbourContainerType viableNeighbours;
-      for (size_t iNeighbour = 0; iNeighbour < innerNeighbours.size(); ++iNeighbour) {
-        if (m_compatibilityChecker.areCompatible(currentPath.back(), innerNeighbours[iNeighbour])) {
-          viableNeighbours.push_back(innerNeighbours[iNeighbour]);
+      for (unsigned int iNeighbour : aNetwork.getInnerNodeIndices(currentNode->getIndex())) {
+        NodeType* innerNeighbour = aNetwork.getNodeByIndex(iNeighbour);
+        if (m_compatibilityChecker.areCompatible(currentNode, innerNeighbour)) {
+          viableNeighbours.push_back(innerNeighbour);
         }
       }
 
@@ -156,16 +160,14 @@ namespace Belle2 {
         // the last alternative is assigned to the existing path.
         if (iNeighbour == viableNeighbours.size() - 1) {
           currentPath.push_back(viableNeighbours[iNeighbour]);
-          NeighbourContainerType& newNeighbours = viableNeighbours[iNeighbour]->getInnerNodes();
 
-          findPathsRecursive(allNodePaths, currentPath, newNeighbours);
+          findPathsRecursive(aNetwork, allNodePaths, currentPath);
         } else {
           Path newPath = clone(currentPath);
 
           newPath.push_back(viableNeighbours[iNeighbour]);
-          NeighbourContainerType& newNeighbours = viableNeighbours[iNeighbour]->getInnerNodes();
 
-          findPathsRecursive(allNodePaths, newPath, newNeighbours);
+          findPathsRecursive(aNetwork, allNodePaths, newPath);
           storeAcceptedPath(newPath, allNodePaths);
         }
       }
@@ -7,6 +7,7 @@
  **************************************************************************/
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 namespace Belle2 {
@@ -28,15 +29,17 @@ namespace Belle2 {
     /** Only the DirectedNodeNetwork can create DirectedNodes and link them */
     template<typename AnyType, typename AnyOtherType> friend class DirectedNodeNetwork;
 
+    /** The DirectedNodeArena constructs the DirectedNodes in place */
+    template<typename AnyType, std::size_t AnySize> friend class DirectedNodeArena;
+
   protected:
     /** ************************* CONSTRUCTORS ************************* */
     /** Protected constructor. accepts an entry which can not be changed any more */
-    explicit DirectedNode(EntryType& entry) :
-      m_entry(entry), m_metaInfo(MetaInfoType()), m_family(-1)
+    DirectedNode(EntryType& entry, unsigned int index) :
+      m_entry(entry), m_metaInfo(MetaInfoType()), m_family(-1), m_index(index)
     {
-      // Reserve some space for the vectors, TODO: can still be fine-tuned
-      m_innerNodes.reserve(10);
-      m_outerNodes.reserve(10);
+      // No space is reserved for the links: most nodes have only a few of them, and
+      // reserving would cost two heap allocations per node of the arena
     }
 
     /** Forbid copy constructor */
@@ -102,6 +105,9 @@ namespace Belle2 {
     /** Assign a family identifier to this cell */
     void setFamily(short family) { m_family = family; }
 
+    /** Returns position of this node in the network it belongs to, used to access the compact adjacency of the network */
+    unsigned int getIndex() const { return m_index; }
+
 
     /** ************************* DATA MEMBERS ************************* */
     /** Entry can be of any type, DirectedNode is just the carrier */
@@ -118,6 +124,9 @@ namespace Belle2 {
 
     /** Identifier for all connected nodes */
     short m_family;
+
+    /** Position of this node in the network, nodes are numbered in order of creation */
+    unsigned int m_index;
   };
 
 
@@ -0,0 +1,94 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Belle2 {
+
+  /** Chunked arena allocator for the nodes of a DirectedNodeNetwork.
+   *
+   * Nodes are constructed in place into fixed-size chunks of raw storage, so that adding a node does not require
+   * a heap allocation of its own and nodes created one after the other are neighbours in memory.
+   * The addresses of the nodes stay valid until reset() is called, as chunks are never moved.
+   * reset() destroys all nodes but keeps the chunks, so that the memory can be reused for the next event.
+   *
+   * Prerequisites for template NodeType:
+   * - has to be constructible by the arena (DirectedNode declares DirectedNodeArena as friend).
+   */
+  template<typename NodeType, std::size_t ChunkSize = 4096>
+  class DirectedNodeArena {
+    /** Raw storage for a single node */
+    using Slot = typename std::aligned_storage<sizeof(NodeType), alignof(NodeType)>::type;
+
+  public:
+    /** Constructor */
+    DirectedNodeArena() = default;
+
+    /** Forbid copy constructor, nodes are referenced by address */
+    DirectedNodeArena(const DirectedNodeArena&) = delete;
+
+    /** Forbid assignment operator, nodes are referenced by address */
+    DirectedNodeArena& operator=(const DirectedNodeArena&) = delete;
+
+    /** Destructor, destroys all nodes still stored */
+    ~DirectedNodeArena() { reset(); }
+
+
+    /** Constructs a new node in the next free slot and returns a pointer to it */
+    template<typename ... Args>
+    NodeType* create(Args&& ... args)
+    {
+      const std::size_t iChunk = m_size / ChunkSize;
+      if (iChunk == m_chunks.size()) {
+        m_chunks.emplace_back(new Slot[ChunkSize]);
+      }
+      NodeType* node = new (&m_chunks[iChunk][m_size % ChunkSize]) NodeType(std::forward<Args>(args)...);
+      ++m_size;
+      return node;
+    }
+
+
+    /** Destroys all nodes, the allocated chunks are kept for reuse */
+    void reset()
+    {
+      for (std::size_t i = 0; i < m_size; ++i) {
+        at(i).~NodeType();
+      }
+      m_size = 0;
+    }
+
+
+    /** Returns the node with the given index, nodes are indexed in order of creation */
+    NodeType& at(std::size_t index)
+    {
+      return *reinterpret_cast<NodeType*>(&m_chunks[index / ChunkSize][index % ChunkSize]);
+    }
+
+
+    /** Returns number of nodes stored */
+    inline std::size_t size() const { return m_size; }
+
+
+    /** Returns number of nodes which can be stored without allocating a new chunk */
+    inline std::size_t capacity() const { return m_chunks.size() * ChunkSize; }
+
+
+  private:
+    /** Chunks of raw storage, never reallocated to keep the node addresses stable */
+    std::vector<std::unique_ptr<Slot[]>> m_chunks;
+
+    /** Number of nodes currently stored */
+    std::size_t m_size = 0;
+  };
+}
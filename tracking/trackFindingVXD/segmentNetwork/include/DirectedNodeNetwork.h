@@ -7,16 +7,25 @@
  **************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 #include <unordered_map>
 
 #include <framework/logging/Logger.h>
 
 #include <tracking/trackFindingVXD/segmentNetwork/DirectedNode.h>
+#include <tracking/trackFindingVXD/segmentNetwork/DirectedNodeArena.h>
 
 
 namespace Belle2 {
   /** Network of directed nodes of the type EntryType
+   *
+   * The nodes are allocated from a DirectedNodeArena owned by the network. When the network is finalized,
+   * the links to the inner nodes are additionally stored in a compact compressed-sparse-row (CSR) form,
+   * which is used by the algorithms iterating over the network many times (e.g. the CellularAutomaton).
+   * Optionally the number of nodes can be capped, further nodes are then rejected by addNode.
+   *
    * @tparam EntryType : type of the directe nodes
    * @tparam MetaInfoType : meta info type of the nodes
    */
@@ -29,37 +38,58 @@ namespace Belle2 {
     using NodeID = std::int64_t;
 
   public:
+    /** Range of node indices of the compact adjacency representation, valid until the network is modified */
+    class IndexRange {
+    public:
+      /** Constructor */
+      IndexRange(const unsigned int* first, const unsigned int* last) : m_first(first), m_last(last) {}
+
+      /** Returns pointer to the first index */
+      const unsigned int* begin() const { return m_first; }
+
+      /** Returns pointer behind the last index */
+      const unsigned int* end() const { return m_last; }
+
+      /** Returns number of indices in the range */
+      std::size_t size() const { return m_last - m_first; }
+
+      /** Returns true if the range contains no index */
+      bool empty() const { return m_first == m_last; }
+
+    private:
+      /** Pointer to the first index */
+      const unsigned int* m_first;
+
+      /** Pointer behind the last index */
+      const unsigned int* m_last;
+    };
+
+
     /** ************************* CONSTRUCTOR/DESTRUCTOR ************************* */
     /** Constructor */
     DirectedNodeNetwork() :
       m_lastOuterNodeID(),
       m_lastInnerNodeID(),
-      m_isFinalized(false)
+      m_isFinalized(false),
+      m_maxNodes(std::numeric_limits<unsigned int>::max())
     {
       m_nodeMap.reserve(40000);
       m_nodes.reserve(40000);
     }
 
 
-    /** destructor taking care of cleaning up the pointer-mess
-     *  WARNING only needed when using classic pointers for the nodes! */
-    ~DirectedNodeNetwork()
-    {
-      for (auto nodePointer : m_nodeMap) {
-        delete nodePointer.second;
-      }
-      m_nodeMap.clear();
-    }
-
-
     /** ************************* PUBLIC MEMBER FUNCTIONS ************************* */
-    /** Adding new node to nodeMap, if the nodeID is not already present in the nodeMap.
+    /** Adding new node to nodeMap, if the nodeID is not already present in the nodeMap
+     *  and the maximal number of nodes is not yet reached.
      *  Returns true if new node was added. */
     bool addNode(NodeID nodeID, EntryType& newEntry)
     {
+      if (isFull()) {
+        return false;
+      }
       if (m_nodeMap.count(nodeID) == 0) {
         // cppcheck-suppress stlFindInsert
-        m_nodeMap.emplace(nodeID, new Node(newEntry));
+        m_nodeMap.emplace(nodeID, m_arena.create(newEntry, m_arena.size()));
         m_isFinalized = false;
         return true;
       }
@@ -149,15 +179,26 @@ namespace Belle2 {
     void clear()
     {
       m_nodes.clear();
+      m_innerEnds.clear();
+      m_outerEnds.clear();
+      m_innerOffsets.clear();
+      m_innerIndices.clear();
       // Clearing the unordered_map is important as the following modules will process the event
       // if it still contains entries.
-      for (auto nodePointer : m_nodeMap) {
-        delete nodePointer.second;
-      }
       m_nodeMap.clear();
+      m_arena.reset();
+      m_isFinalized = false;
     }
 
 
+    /** Sets the maximal number of nodes the network accepts, addNode rejects all further nodes. */
+    void setMaxNodes(unsigned int maxNodes) { m_maxNodes = maxNodes; }
+
+
+    /** Returns true if the maximal number of nodes is reached */
+    inline bool isFull() const { return m_nodeMap.size() >= m_maxNodes; }
+
+
     /// getters:
     /** returns all nodes which have no outer nodes (but inner ones) and therefore are outer ends of the network */
     std::vector<Node*> getOuterEnds()
@@ -191,6 +232,19 @@ namespace Belle2 {
     }
 
 
+    /** Returns node with given index, the index of a node is its position in getNodes() */
+    inline Node* getNodeByIndex(unsigned int index) const { return m_nodes[index]; }
+
+
+    /** Returns the indices of the inner nodes of the node with given index.
+     *  The index of a node is its position in getNodes(). */
+    inline IndexRange getInnerNodeIndices(unsigned int index)
+    {
+      if (!m_isFinalized) finalize();
+      return IndexRange(m_innerIndices.data() + m_innerOffsets[index], m_innerIndices.data() + m_innerOffsets[index + 1]);
+    }
+
+
     /** Returns iterator for container: begin */
     typename std::vector<Node* >::iterator begin()
     {
@@ -229,24 +283,39 @@ namespace Belle2 {
       return true;
     }
 
-    /** Finalizing the NodeNetwork */
+    /** Finalizing the NodeNetwork: collects the nodes in order of creation and builds the compact adjacency */
     void finalize()
     {
       if (m_isFinalized) return;
+      const unsigned int nNodes = m_arena.size();
       m_nodes.clear();
-      m_nodes.reserve(m_nodeMap.size());
+      m_nodes.reserve(nNodes);
       m_innerEnds.clear();
       m_outerEnds.clear();
-      for (const auto& item : m_nodeMap) {
-        m_nodes.push_back(item.second);
-        if (item.second->getInnerNodes().empty()) m_innerEnds.push_back(item.second);
-        if (item.second->getOuterNodes().empty()) m_outerEnds.push_back(item.second);
+      m_innerOffsets.clear();
+      m_innerOffsets.reserve(nNodes + 1);
+      m_innerIndices.clear();
+
+      m_innerOffsets.push_back(0);
+      for (unsigned int iNode = 0; iNode < nNodes; ++iNode) {
+        Node* node = &m_arena.at(iNode);
+        m_nodes.push_back(node);
+        if (node->getInnerNodes().empty()) m_innerEnds.push_back(node);
+        if (node->getOuterNodes().empty()) m_outerEnds.push_back(node);
+
+        for (const Node* innerNode : node->getInnerNodes()) {
+          m_innerIndices.push_back(innerNode->getIndex());
+        }
+        m_innerOffsets.push_back(m_innerIndices.size());
       }
       m_isFinalized = true;
     }
 
     /** ************************* DATA MEMBERS ************************* */
-    /** carries all nodes */
+    /** owns the memory of all nodes */
+    DirectedNodeArena<Node> m_arena;
+
+    /** maps the NodeIDs to the nodes stored in the arena */
     std::unordered_map<NodeID, Node*> m_nodeMap;
 
     /** temporal storage for last outer node added, used for speed-up */
@@ -258,6 +327,9 @@ namespace Belle2 {
     /** keeps track of the state of the network to fill the vectors m_nodes, m_outerEnds, m_innerEnds only if required */
     bool m_isFinalized;
 
+    /** maximal number of nodes accepted by addNode */
+    unsigned int m_maxNodes;
+
     /** After the network is finalized this vector will also carry all nodes to be able to keep the old interface.
      * This shouldn't affect the performance drastically in comparison to directly accessing the nodeMap.
      */
@@ -270,5 +342,11 @@ namespace Belle2 {
     /** keeps track of current innerEnds (nodes which have no innerNodes)
      *  entries are the NodeIds of the nodes which currently form an innermost node */
     std::vector<Node*> m_innerEnds;
+
+    /** CSR offsets: the inner nodes of the node with index i are stored in m_innerIndices[m_innerOffsets[i], m_innerOffsets[i + 1]) */
+    std::vector<unsigned int> m_innerOffsets;
+
+    /** CSR column indices: indices of the inner nodes of all nodes, grouped by node */
+    std::vector<unsigned int> m_innerIndices;
   };
 }
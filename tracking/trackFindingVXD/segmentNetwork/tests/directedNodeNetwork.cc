@@ -483,6 +483,63 @@ namespace DirectedNodeNetworkTests {
   }
 
 
+  /** testing the compact adjacency, the node limit and the reuse of the network after clearing it */
+  TEST_F(DirectedNodeNetworkTest, CompactAdjacencyAndNodeLimit)
+  {
+    std::array<int, 5> intArray  = { { 2, 5, 3, 4, 99} };
+
+    DirectedNodeNetwork<int, VoidMetaInfo> intNetwork;
+    for (int& entry : intArray) {
+      EXPECT_TRUE(intNetwork.addNode(entry, entry));
+    }
+    // 2 -> 5 -> 3 -> 4 and 2 -> 3, 99 is not linked at all
+    EXPECT_TRUE(intNetwork.linkNodes(intArray.at(0), intArray.at(1)));
+    EXPECT_TRUE(intNetwork.linkNodes(intArray.at(1), intArray.at(2)));
+    EXPECT_TRUE(intNetwork.linkNodes(intArray.at(2), intArray.at(3)));
+    EXPECT_TRUE(intNetwork.linkNodes(intArray.at(0), intArray.at(2)));
+
+    // nodes are stored in order of creation, the index of a node is its position in the network
+    std::vector<DirectedNode<int, VoidMetaInfo>*>& nodes = intNetwork.getNodes();
+    ASSERT_EQ(5, nodes.size());
+    for (unsigned int index = 0; index < nodes.size(); index++) {
+      EXPECT_EQ(intArray.at(index), nodes.at(index)->getEntry());
+      EXPECT_EQ(index, nodes.at(index)->getIndex());
+      EXPECT_EQ(nodes.at(index), intNetwork.getNodeByIndex(index));
+
+      // the compact adjacency has to be identical to the inner nodes of each node
+      auto innerIndices = intNetwork.getInnerNodeIndices(index);
+      ASSERT_EQ(nodes.at(index)->getInnerNodes().size(), innerIndices.size());
+      unsigned int iInner = 0;
+      for (unsigned int innerIndex : innerIndices) {
+        EXPECT_EQ(nodes.at(index)->getInnerNodes().at(iInner), intNetwork.getNodeByIndex(innerIndex));
+        iInner++;
+      }
+    }
+    EXPECT_EQ(2, intNetwork.getInnerNodeIndices(0).size());
+    EXPECT_TRUE(intNetwork.getInnerNodeIndices(4).empty());
+
+    // clearing the network removes all nodes, the network can be refilled afterwards
+    intNetwork.clear();
+    EXPECT_EQ(0, intNetwork.size());
+    EXPECT_EQ(0, intNetwork.getNodes().size());
+    EXPECT_EQ(nullptr, intNetwork.getNode(intArray.at(0)));
+
+    // a network with a node limit rejects all nodes exceeding the limit
+    intNetwork.setMaxNodes(3);
+    for (unsigned int index = 0; index < intArray.size(); index++) {
+      EXPECT_EQ(index < 3, intNetwork.addNode(intArray.at(index), intArray.at(index)));
+    }
+    EXPECT_TRUE(intNetwork.isFull());
+    EXPECT_EQ(3, intNetwork.size());
+    EXPECT_FALSE(intNetwork.isNodeInNetwork(intArray.at(3)));
+    EXPECT_FALSE(intNetwork.linkNodes(intArray.at(2), intArray.at(3)));
+    EXPECT_TRUE(intNetwork.linkNodes(intArray.at(1), intArray.at(2)));
+    // the network is finalized again by the accessor itself
+    EXPECT_EQ(1, intNetwork.getInnerNodeIndices(1).size());
+    EXPECT_TRUE(intNetwork.getInnerNodeIndices(2).empty());
+  }
+
+
   /** testing full functionality of the DirectedNodeNetwork when filled with a complex type (including storing on the storeArray).
    * This is stored in the DirectedNetworkContainer, which will actually be used by some modules.
    *  This test is intended as a usage example to find out how to use this network. */
@@ -17,6 +17,8 @@
 
 #include <TVector3.h>
 
+#include <map>
+#include <memory>
 #include <utility>
 
 namespace genfit {
@@ -65,6 +67,9 @@ namespace Belle2 {
     /// Get track hypotheses for a given v0 hypothesis.
     std::pair<Const::ParticleType, Const::ParticleType> getTrackHypotheses(const Const::ParticleType& v0Hypothesis) const;
 
+    /// Release the copies of the genfit::Tracks made for the vertex fits; to be called at the beginning of each event.
+    void clearGenfitTrackCopies();
+
   private:
 
     /** fit V0 vertex using RecoTrack's as inputs.
@@ -87,6 +92,15 @@ namespace Belle2 {
                                  unsigned int& hasInnerHitStatus, TVector3& vertexPos,
                                  const bool forceStore);
 
+    /** Get a copy of the genfit::Track of a RecoTrack with the cardinal representation of the given hypothesis.
+     * The copy is used in the vertex fit, so that the genfit::Track of the RecoTrack is not altered.
+     * The copies are made once per event and shared by all pairs and V0 hypotheses.
+     * @param recoTrack RecoTrack of the daughter
+     * @param pdg PDG code (positive number) of the cardinal representation
+     * @return copy of the genfit::Track, owned by the V0Fitter
+     */
+    genfit::Track& getGenfitTrackCopy(RecoTrack* recoTrack, const int pdg);
+
     /** Create a copy of RecoTrack. Track fit should be executed in removeInnerHits function.
      * @param origRecoTrack original RecoTrack
      * @return copied RecoTrack stored in the m_copiedRecoTracks, nullptr if track fit fails (this should not happen)
@@ -166,6 +180,8 @@ namespace Belle2 {
     int    m_v0FitterMode;  ///< 0: store V0 at the first vertex fit, regardless of inner hits, 1: remove hits inside the V0 vertex position, 2: mode 1 +  don't use SVD hits if there is only one available SVD hit-pair (default)
     bool   m_forcestore;///< true only if the V0Fitter mode is 1
     bool   m_useOnlyOneSVDHitPair;///< false only if the V0Fitter mode is 3
+    /// Copies of the genfit::Tracks used in the vertex fits by RecoTrack and PDG code of the cardinal representation.
+    std::map<std::pair<const RecoTrack*, int>, std::unique_ptr<genfit::Track>> m_genfitTrackCopies;
   };
 
 }
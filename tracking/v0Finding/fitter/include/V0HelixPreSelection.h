@@ -0,0 +1,57 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#pragma once
+
+#include <framework/dataobjects/Helix.h>
+
+#include <TVector3.h>
+
+namespace Belle2 {
+
+  /** Fast pre-selection of V0 candidates from the ideal helices of the two daughter tracks.
+   *
+   *  The candidate vertex positions are the intersections of the two circles in the xy projection,
+   *  or the point of closest approach of the circles if they do not intersect.
+   *  Both helices are moved to these points analytically, so no extrapolation through the detector is needed.
+   *  A pair is accepted if at one of the candidate vertices the two helices are closer than the maximal distance
+   *  and the vertex is not closer to the z axis than the minimal radius.
+   *
+   *  As the helices ignore material effects and inhomogeneities of the magnetic field, the cuts should be chosen loosely.
+   */
+  class V0HelixPreSelection {
+
+  public:
+    /** Maximal number of candidate vertices of a helix pair */
+    static constexpr int c_maxNVertices = 2;
+
+    /** Constructor taking the cuts.
+     *  @param maxDistance maximal three dimensional distance of the helices at the vertex in cm
+     *  @param minRadius minimal cylindrical radius of the vertex in cm
+     */
+    explicit V0HelixPreSelection(double maxDistance = 10., double minRadius = 0.5);
+
+    /** Returns true if the pair of helices is compatible with a V0 decay. */
+    bool accept(const Helix& helixPlus, const Helix& helixMinus) const;
+
+    /** Calculate the candidate vertices of two helices.
+     *
+     *  @param helixPlus helix of the first daughter
+     *  @param helixMinus helix of the second daughter
+     *  @param[out] vertices the candidate vertices, i.e. the midpoints between the two helices
+     *  @param[out] distances the three dimensional distances of the helices at the candidate vertices
+     *  @return number of candidate vertices, 0 if none could be determined (straight or concentric tracks)
+     */
+    static int calculateVertices(const Helix& helixPlus, const Helix& helixMinus,
+                                 TVector3 vertices[c_maxNVertices], double distances[c_maxNVertices]);
+
+  private:
+    double m_maxDistance; ///< maximal three dimensional distance of the helices at the vertex
+    double m_minRadius;   ///< minimal cylindrical radius of the vertex
+  };
+
+}
@@ -354,8 +354,6 @@ bool V0Fitter::vertexFitWithRecoTracks(const Track* trackPlus, const Track* trac
 {
   const auto trackHypotheses = getTrackHypotheses(v0Hypothesis);
 
-  genfit::Track gfTrackPlus = RecoTrackGenfitAccess::getGenfitTrack(
-                                *recoTrackPlus);/// make a clone, not use the reference so that the genfit::Track and its TrackReps will not be altered.
   const int pdgTrackPlus = trackPlus->getTrackFitResultWithClosestMass(trackHypotheses.first)->getParticleType().getPDGCode();
   genfit::AbsTrackRep* plusRepresentation = recoTrackPlus->getTrackRepresentationForPDG(pdgTrackPlus);
   if ((plusRepresentation == nullptr) or (not recoTrackPlus->wasFitSuccessful(plusRepresentation))) {
@@ -363,8 +361,6 @@ bool V0Fitter::vertexFitWithRecoTracks(const Track* trackPlus, const Track* trac
     return false;
   }
 
-  genfit::Track gfTrackMinus = RecoTrackGenfitAccess::getGenfitTrack(
-                                 *recoTrackMinus);/// make a clone, not use the reference so that the genfit::Track and its TrackReps will not be altered.
   const int pdgTrackMinus = trackMinus->getTrackFitResultWithClosestMass(trackHypotheses.second)->getParticleType().getPDGCode();
   genfit::AbsTrackRep* minusRepresentation = recoTrackMinus->getTrackRepresentationForPDG(pdgTrackMinus);
   if ((minusRepresentation == nullptr) or (not recoTrackMinus->wasFitSuccessful(minusRepresentation))) {
@@ -372,28 +368,9 @@ bool V0Fitter::vertexFitWithRecoTracks(const Track* trackPlus, const Track* trac
     return false;
   }
 
-  /// If existing, pass to the genfit::Track the correct cardinal representation
-  std::vector<genfit::AbsTrackRep*> repsPlus = gfTrackPlus.getTrackReps();
-  std::vector<genfit::AbsTrackRep*> repsMinus = gfTrackMinus.getTrackReps();
-  if (repsPlus.size() == repsMinus.size()) {
-    for (unsigned int id = 0; id < repsPlus.size(); id++) {
-      if (abs(repsPlus[id]->getPDG()) == pdgTrackPlus)
-        gfTrackPlus.setCardinalRep(id);
-      if (abs(repsMinus[id]->getPDG()) == pdgTrackMinus)
-        gfTrackMinus.setCardinalRep(id);
-    }
-  }
-  /// The two vectors should always have the same size, and this never happen
-  else {
-    for (unsigned int id = 0; id < repsPlus.size(); id++) {
-      if (abs(repsPlus[id]->getPDG()) == pdgTrackPlus)
-        gfTrackPlus.setCardinalRep(id);
-    }
-    for (unsigned int id = 0; id < repsMinus.size(); id++) {
-      if (abs(repsMinus[id]->getPDG()) == pdgTrackMinus)
-        gfTrackMinus.setCardinalRep(id);
-    }
-  }
+  /// use copies with the correct cardinal representation, so that the genfit::Tracks of the RecoTracks will not be altered.
+  genfit::Track& gfTrackPlus = getGenfitTrackCopy(recoTrackPlus, pdgTrackPlus);
+  genfit::Track& gfTrackMinus = getGenfitTrackCopy(recoTrackMinus, pdgTrackMinus);
 
   /// make a clone, not use the reference so that the genfit::MeasuredStateOnPlane and its TrackReps will not be altered.
   genfit::MeasuredStateOnPlane stPlus  = recoTrackPlus->getMeasuredStateOnPlaneFromFirstHit(plusRepresentation);
@@ -486,6 +463,29 @@ bool V0Fitter::vertexFitWithRecoTracks(const Track* trackPlus, const Track* trac
   return true;
 }
 
+genfit::Track& V0Fitter::getGenfitTrackCopy(RecoTrack* recoTrack, const int pdg)
+{
+  /// RecoTracks are not refitted after their first vertex fit (refits are done on new copies), so the copies stay valid.
+  std::unique_ptr<genfit::Track>& gfTrack = m_genfitTrackCopies[std::make_pair(recoTrack, pdg)];
+  if (gfTrack) return *gfTrack;
+
+  /// make a clone, not use the reference so that the genfit::Track and its TrackReps will not be altered.
+  gfTrack = std::make_unique<genfit::Track>(RecoTrackGenfitAccess::getGenfitTrack(*recoTrack));
+
+  /// If existing, pass to the genfit::Track the correct cardinal representation
+  const std::vector<genfit::AbsTrackRep*>& reps = gfTrack->getTrackReps();
+  for (unsigned int id = 0; id < reps.size(); id++) {
+    if (abs(reps[id]->getPDG()) == pdg)
+      gfTrack->setCardinalRep(id);
+  }
+  return *gfTrack;
+}
+
+void V0Fitter::clearGenfitTrackCopies()
+{
+  m_genfitTrackCopies.clear();
+}
+
 RecoTrack* V0Fitter::copyRecoTrack(RecoTrack* origRecoTrack)
 {
   RecoTrack* newRecoTrack = origRecoTrack->copyToStoreArray(m_copiedRecoTracks);
@@ -0,0 +1,101 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <tracking/v0Finding/fitter/V0HelixPreSelection.h>
+
+#include <cmath>
+
+using namespace Belle2;
+
+V0HelixPreSelection::V0HelixPreSelection(double maxDistance, double minRadius)
+  : m_maxDistance(maxDistance), m_minRadius(minRadius)
+{
+}
+
+bool V0HelixPreSelection::accept(const Helix& helixPlus, const Helix& helixMinus) const
+{
+  TVector3 vertices[c_maxNVertices];
+  double distances[c_maxNVertices];
+  const int nVertices = calculateVertices(helixPlus, helixMinus, vertices, distances);
+
+  /// without a candidate vertex the helices cannot judge the pair, leave it to the vertex fit
+  if (nVertices == 0) return true;
+
+  for (int i = 0; i < nVertices; ++i) {
+    if (distances[i] < m_maxDistance and vertices[i].Perp() >= m_minRadius) return true;
+  }
+  return false;
+}
+
+int V0HelixPreSelection::calculateVertices(const Helix& helixPlus, const Helix& helixMinus,
+                                           TVector3 vertices[c_maxNVertices], double distances[c_maxNVertices])
+{
+  const double omegaPlus = helixPlus.getOmega();
+  const double omegaMinus = helixMinus.getOmega();
+  if (omegaPlus == 0 or omegaMinus == 0) return 0;
+
+  /// centers and radii of the circles in the xy projection
+  const double rPlus = 1 / std::fabs(omegaPlus);
+  const double centerPlusFactor = 1 / omegaPlus + helixPlus.getD0();
+  const double xPlus = centerPlusFactor * helixPlus.getSinPhi0();
+  const double yPlus = -centerPlusFactor * helixPlus.getCosPhi0();
+
+  const double rMinus = 1 / std::fabs(omegaMinus);
+  const double centerMinusFactor = 1 / omegaMinus + helixMinus.getD0();
+  const double xMinus = centerMinusFactor * helixMinus.getSinPhi0();
+  const double yMinus = -centerMinusFactor * helixMinus.getCosPhi0();
+
+  const double dx = xMinus - xPlus;
+  const double dy = yMinus - yPlus;
+  const double d = std::hypot(dx, dy);
+  if (d == 0) return 0;
+
+  /// unit vector from the center of the first to the center of the second circle and its normal
+  const double ux = dx / d;
+  const double uy = dy / d;
+
+  double pointsX[c_maxNVertices];
+  double pointsY[c_maxNVertices];
+  int nPoints = 0;
+
+  if (d <= rPlus + rMinus and d >= std::fabs(rPlus - rMinus)) {
+    /// the circles intersect
+    const double a = (d * d + rPlus * rPlus - rMinus * rMinus) / (2 * d);
+    const double h = std::sqrt(std::fmax(rPlus * rPlus - a * a, 0.));
+    const double baseX = xPlus + a * ux;
+    const double baseY = yPlus + a * uy;
+    pointsX[0] = baseX - h * uy;
+    pointsY[0] = baseY + h * ux;
+    pointsX[1] = baseX + h * uy;
+    pointsY[1] = baseY - h * ux;
+    nPoints = h > 0 ? 2 : 1;
+  } else {
+    /// the circles are separated or one lies inside the other, take the midpoint of the closest points
+    double closestPlusX = xPlus + rPlus * ux;
+    double closestPlusY = yPlus + rPlus * uy;
+    double closestMinusX = xMinus - rMinus * ux;
+    double closestMinusY = yMinus - rMinus * uy;
+    if (d < rPlus - rMinus) {
+      closestMinusX = xMinus + rMinus * ux;
+      closestMinusY = yMinus + rMinus * uy;
+    } else if (d < rMinus - rPlus) {
+      closestPlusX = xPlus - rPlus * ux;
+      closestPlusY = yPlus - rPlus * uy;
+    }
+    pointsX[0] = (closestPlusX + closestMinusX) / 2;
+    pointsY[0] = (closestPlusY + closestMinusY) / 2;
+    nPoints = 1;
+  }
+
+  for (int i = 0; i < nPoints; ++i) {
+    const TVector3 positionPlus = helixPlus.getPositionAtArcLength2D(helixPlus.getArcLength2DAtXY(pointsX[i], pointsY[i]));
+    const TVector3 positionMinus = helixMinus.getPositionAtArcLength2D(helixMinus.getArcLength2DAtXY(pointsX[i], pointsY[i]));
+    vertices[i] = 0.5 * (positionPlus + positionMinus);
+    distances[i] = (positionPlus - positionMinus).Mag();
+  }
+  return nPoints;
+}
@@ -0,0 +1,60 @@
+/**************************************************************************
+ * basf2 (Belle II Analysis Software Framework)                           *
+ * Author: The Belle II Collaboration                                     *
+ *                                                                        *
+ * See git log for contributors and copyright holders.                    *
+ * This file is licensed under LGPL-3.0, see LICENSE.md.                  *
+ **************************************************************************/
+#include <tracking/v0Finding/fitter/V0HelixPreSelection.h>
+
+#include <framework/dataobjects/Helix.h>
+
+#include <TVector3.h>
+
+#include <gtest/gtest.h>
+
+namespace Belle2 {
+
+  /// Test the candidate vertices of two tracks from a displaced vertex.
+  TEST(V0HelixPreSelectionTest, DisplacedVertex)
+  {
+    const double bZ = 1.5;
+    const TVector3 vertex(5, 3, 2);
+    const Helix helixPlus(vertex, TVector3(0.3, 0.1, 0.2), 1, bZ);
+    const Helix helixMinus(vertex, TVector3(0.05, -0.25, -0.1), -1, bZ);
+
+    TVector3 vertices[V0HelixPreSelection::c_maxNVertices];
+    double distances[V0HelixPreSelection::c_maxNVertices];
+    const int nVertices = V0HelixPreSelection::calculateVertices(helixPlus, helixMinus, vertices, distances);
+    ASSERT_EQ(2, nVertices);
+
+    const int iBest = distances[0] < distances[1] ? 0 : 1;
+    EXPECT_NEAR(0, distances[iBest], 1e-6);
+    EXPECT_NEAR(vertex.X(), vertices[iBest].X(), 1e-6);
+    EXPECT_NEAR(vertex.Y(), vertices[iBest].Y(), 1e-6);
+    EXPECT_NEAR(vertex.Z(), vertices[iBest].Z(), 1e-6);
+
+    EXPECT_TRUE(V0HelixPreSelection(10, 0.5).accept(helixPlus, helixMinus));
+    EXPECT_FALSE(V0HelixPreSelection(10, 10).accept(helixPlus, helixMinus));
+  }
+
+  /// Test the rejection of tracks from the origin and of tracks that never come close.
+  TEST(V0HelixPreSelectionTest, Rejection)
+  {
+    const double bZ = 1.5;
+    const V0HelixPreSelection preSelection(10, 0.5);
+
+    const TVector3 origin(0, 0, 0);
+    const Helix promptPlus(origin, TVector3(0.3, 0.1, 0.2), 1, bZ);
+    const Helix promptMinus(origin, TVector3(0.05, -0.25, -0.1), -1, bZ);
+    EXPECT_FALSE(preSelection.accept(promptPlus, promptMinus));
+
+    const Helix farPlus(TVector3(-60, 0, 0), TVector3(0, -0.1, 0), 1, bZ);
+    const Helix farMinus(TVector3(60, 0, 0), TVector3(0, 0.1, 0), -1, bZ);
+    TVector3 vertices[V0HelixPreSelection::c_maxNVertices];
+    double distances[V0HelixPreSelection::c_maxNVertices];
+    EXPECT_EQ(1, V0HelixPreSelection::calculateVertices(farPlus, farMinus, vertices, distances));
+    EXPECT_GT(distances[0], 10);
+    EXPECT_FALSE(preSelection.accept(farPlus, farMinus));
+  }
+}